@@ -31,6 +31,8 @@
  *      120405    K. Kumar          Ensured no interference between unit tests by placing them in
  *                                  local scope.
  *      121020    D. Dirkx          Update to new acceleration model architecture.
+ *      140221    S. Vermeer        Added unit test for acceleration model class with automatic
+ *                                  differentiation scalars.
  *
  *    References
  *
@@ -67,6 +69,7 @@
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamicCoefficientInterface.h"
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamicAcceleration.h"
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamicRotationalAcceleration.h"
+#include "Tudat/Mathematics/BasicMathematics/automaticDifferentiation.h"
 
 BOOST_AUTO_TEST_SUITE( test_aerodynamic_acceleration_force_moment_models )
 
@@ -216,6 +219,44 @@ BOOST_AUTO_TEST_CASE( testAerodynamicForceAndAcceleration )
         // Check if computed force matches expected.
         TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedForce, force, tolerance );
     }
+
+    // Test 7: Test the acceleration model class with automatic differentiation scalars, computing
+    //         the partial derivatives w.r.t. density, airspeed and mass.
+    {
+        using tudat::basic_mathematics::AutoDiffScalar3d;
+        typedef Eigen::Matrix< AutoDiffScalar3d, 3, 1 > AutoDiffVector3d;
+
+        // Create aerodynamic acceleration model class, with density, airspeed and mass as
+        // independent variables.
+        AerodynamicAccelerationTemplate< AutoDiffVector3d > accelerationClass(
+                    boost::lambda::constant(
+                        AutoDiffVector3d( forceCoefficients.cast< AutoDiffScalar3d >( ) ) ),
+                    boost::lambda::constant( AutoDiffScalar3d( density, 3, 0 ) ),
+                    boost::lambda::constant( AutoDiffScalar3d( airSpeed, 3, 1 ) ),
+                    AutoDiffScalar3d( mass, 3, 2 ), AutoDiffScalar3d( referenceArea ), false );
+        accelerationClass.updateMembers( );
+        const AutoDiffVector3d acceleration = accelerationClass.getAcceleration( );
+
+        // Check if computed force and its partial derivatives match expected values; the force
+        // is linear in density and quadratic in airspeed, and the acceleration is inversely
+        // proportional to mass.
+        const Eigen::Vector3d expectedAcceleration = expectedForce / mass;
+        const Eigen::Matrix3d partialDerivatives
+                = tudat::basic_mathematics::getPartialDerivatives( acceleration );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedForce,
+                                           Eigen::Vector3d(
+                                               tudat::basic_mathematics::getValues( acceleration )
+                                               * mass ), tolerance );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( expectedAcceleration / density ),
+                                           Eigen::Vector3d( partialDerivatives.col( 0 ) ),
+                                           10.0 * tolerance );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    Eigen::Vector3d( 2.0 * expectedAcceleration / airSpeed ),
+                    Eigen::Vector3d( partialDerivatives.col( 1 ) ), 10.0 * tolerance );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( -expectedAcceleration / mass ),
+                                           Eigen::Vector3d( partialDerivatives.col( 2 ) ),
+                                           10.0 * tolerance );
+    }
 }
 
 //! Test implementation of aerodynamic moment and rotational acceleration models.
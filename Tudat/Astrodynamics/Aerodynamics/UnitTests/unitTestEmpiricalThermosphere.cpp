@@ -0,0 +1,270 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140331    S. Vermeer        File created.
+ *
+ *    References
+ *      US Standard Atmosphere 1976,
+ *          http://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19770009539_1977009539.pdf.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
+
+#include "Tudat/Astrodynamics/Aerodynamics/empiricalThermosphere.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using basic_astrodynamics::unit_conversions::convertDegreesToRadians;
+
+//! Solar activity function that counts its evaluations.
+aerodynamics::SolarActivity getCountedSolarActivity( int* numberOfEvaluations )
+{
+    ( *numberOfEvaluations )++;
+    return aerodynamics::SolarActivity( 120.0, 140.0, 12.0 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_empirical_thermosphere )
+
+// Summary of tests.
+// Test 1: Test altitude profile against US Standard Atmosphere 1976.
+// Test 2: Test variation of density with altitude, local time and solar activity.
+// Test 3: Test if the time-dependent terms are cached and reused.
+// Test 4: Test if the queries at multiple points work.
+// Test 5: Test if invalid solar activity is rejected.
+
+//! Test altitude profile against US Standard Atmosphere 1976.
+// With an exospheric temperature of 1000 K, the temperature profile is that of the US Standard
+// Atmosphere 1976 above 120 km. The densities differ slightly, since the standard atmosphere
+// includes hydrogen and the departures from diffusive equilibrium of atomic oxygen and helium.
+BOOST_AUTO_TEST_CASE( testEmpiricalThermosphereAltitudeProfile )
+{
+    using aerodynamics::AtmosphericProperties;
+    using aerodynamics::EmpiricalThermosphere;
+
+    const AtmosphericProperties propertiesAt150km
+            = EmpiricalThermosphere::computeDiffusiveEquilibriumProperties( 150.0e3, 1000.0 );
+    BOOST_CHECK_SMALL( propertiesAt150km.temperature - 634.39, 1.0e-2 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt150km.density, 2.0757e-9, 0.01 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt150km.pressure, 4.5425e-4, 0.01 );
+
+    const AtmosphericProperties propertiesAt200km
+            = EmpiricalThermosphere::computeDiffusiveEquilibriumProperties( 200.0e3, 1000.0 );
+    BOOST_CHECK_SMALL( propertiesAt200km.temperature - 854.56, 1.0e-2 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt200km.density, 2.5408e-10, 0.01 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt200km.pressure, 8.4743e-5, 0.01 );
+
+    const AtmosphericProperties propertiesAt400km
+            = EmpiricalThermosphere::computeDiffusiveEquilibriumProperties( 400.0e3, 1000.0 );
+    BOOST_CHECK_SMALL( propertiesAt400km.temperature - 995.83, 1.0e-2 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt400km.density, 2.803e-12, 0.02 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt400km.pressure, 1.452e-6, 0.02 );
+
+    const AtmosphericProperties propertiesAt800km
+            = EmpiricalThermosphere::computeDiffusiveEquilibriumProperties( 800.0e3, 1000.0 );
+    BOOST_CHECK_SMALL( propertiesAt800km.temperature - 999.99, 1.0e-2 );
+    BOOST_CHECK_CLOSE_FRACTION( propertiesAt800km.density, 1.1361e-14, 0.1 );
+
+    // Check that exospheric temperature below temperature at 120 km is rejected.
+    BOOST_CHECK_THROW( EmpiricalThermosphere::computeDiffusiveEquilibriumProperties( 400.0e3,
+                                                                                    300.0 ),
+                       std::runtime_error );
+}
+
+//! Test variation of density with altitude, local time and solar activity.
+BOOST_AUTO_TEST_CASE( testEmpiricalThermosphereVariations )
+{
+    using aerodynamics::EmpiricalThermosphere;
+    using aerodynamics::SolarActivity;
+
+    // At J2000, 1 January 2000 12:00 UTC, the Sun is close to the Greenwich meridian.
+    const double time = 0.0;
+    const double latitude = convertDegreesToRadians( -20.0 );
+    EmpiricalThermosphere empiricalThermosphere;
+
+    // Check that density decreases and temperature increases with altitude.
+    for ( int i = 1; i < 100; i++ )
+    {
+        const double altitude = 100.0e3 + static_cast< double >( i ) * 9.0e3;
+        BOOST_CHECK_LT( empiricalThermosphere.getDensity( altitude, 0.0, latitude, time ),
+                        empiricalThermosphere.getDensity( altitude - 9.0e3, 0.0, latitude,
+                                                          time ) );
+        BOOST_CHECK_GE( empiricalThermosphere.getTemperature( altitude, 0.0, latitude, time ),
+                        empiricalThermosphere.getTemperature( altitude - 9.0e3, 0.0, latitude,
+                                                              time ) );
+    }
+
+    // Check that density at 400 km is higher in the afternoon (longitude 30 degrees, about
+    // 14:00 local time) than before sunrise (longitude -120 degrees, about 4:00 local time).
+    const double dayTimeDensity = empiricalThermosphere.getDensity(
+                400.0e3, convertDegreesToRadians( 30.0 ), latitude, time );
+    const double nightTimeDensity = empiricalThermosphere.getDensity(
+                400.0e3, convertDegreesToRadians( -120.0 ), latitude, time );
+    BOOST_CHECK_GT( dayTimeDensity, 1.3 * nightTimeDensity );
+    BOOST_CHECK_LT( dayTimeDensity, 3.0 * nightTimeDensity );
+    BOOST_CHECK_GT( empiricalThermosphere.getDensity( 400.0e3, 0.0, 0.0, time ), 1.0e-12 );
+    BOOST_CHECK_LT( empiricalThermosphere.getDensity( 400.0e3, 0.0, 0.0, time ), 1.0e-11 );
+
+    // Check that density at 400 km increases with solar flux and geomagnetic activity.
+    EmpiricalThermosphere quietThermosphere( SolarActivity( 70.0, 70.0, 4.0 ) );
+    EmpiricalThermosphere activeSunThermosphere( SolarActivity( 250.0, 250.0, 4.0 ) );
+    EmpiricalThermosphere geomagneticStormThermosphere( SolarActivity( 70.0, 70.0, 200.0 ) );
+    const double quietDensity = quietThermosphere.getDensity( 400.0e3, 0.0, latitude, time );
+    BOOST_CHECK_GT( activeSunThermosphere.getDensity( 400.0e3, 0.0, latitude, time ),
+                    3.0 * quietDensity );
+    BOOST_CHECK_GT( geomagneticStormThermosphere.getDensity( 400.0e3, 0.0, latitude, time ),
+                    2.0 * quietDensity );
+}
+
+//! Test if the time-dependent terms are cached and reused.
+BOOST_AUTO_TEST_CASE( testEmpiricalThermosphereCaching )
+{
+    using aerodynamics::AtmosphericProperties;
+    using aerodynamics::EmpiricalThermosphere;
+
+    // Create thermosphere with solar activity function that counts its evaluations.
+    int numberOfEvaluations = 0;
+    const aerodynamics::SolarActivityFunction solarActivityFunction
+            = boost::bind( &getCountedSolarActivity, &numberOfEvaluations );
+    EmpiricalThermosphere empiricalThermosphere( solarActivityFunction );
+
+    // Check that queries at the same time evaluate the time-dependent terms once, and give the
+    // same results as queries with terms computed by the caller.
+    const double time = 4.3e8;
+    const aerodynamics::ThermosphereEpochTerms epochTerms
+            = empiricalThermosphere.computeEpochTerms( time );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 1 );
+    for ( int i = 0; i < 20; i++ )
+    {
+        const double altitude = 150.0e3 + static_cast< double >( i ) * 37.0e3;
+        const double longitude = 0.3 * static_cast< double >( i );
+        const double latitude = 1.2 - 0.12 * static_cast< double >( i );
+        const AtmosphericProperties expectedProperties
+                = empiricalThermosphere.getAtmosphericProperties( altitude, longitude, latitude,
+                                                                  epochTerms );
+        BOOST_CHECK_EQUAL( empiricalThermosphere.getDensity( altitude, longitude, latitude, time ),
+                           expectedProperties.density );
+        BOOST_CHECK_EQUAL( empiricalThermosphere.getPressure( altitude, longitude, latitude,
+                                                              time ),
+                           expectedProperties.pressure );
+        BOOST_CHECK_EQUAL( empiricalThermosphere.getTemperature( altitude, longitude, latitude,
+                                                                 time ),
+                           expectedProperties.temperature );
+    }
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 2 );
+
+    // Check that a query at another time recomputes the terms, and gives the same result as a
+    // new thermosphere.
+    const double density = empiricalThermosphere.getDensity( 400.0e3, 0.5, 0.2, time + 60.0 );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 3 );
+    EmpiricalThermosphere newEmpiricalThermosphere( solarActivityFunction );
+    BOOST_CHECK_EQUAL( newEmpiricalThermosphere.getDensity( 400.0e3, 0.5, 0.2, time + 60.0 ),
+                       density );
+    BOOST_CHECK_NE( empiricalThermosphere.getDensity( 400.0e3, 0.5, 0.2, time ), density );
+    BOOST_CHECK_EQUAL( numberOfEvaluations, 5 );
+}
+
+//! Test if the queries at multiple points work.
+BOOST_AUTO_TEST_CASE( testEmpiricalThermosphereMultiplePoints )
+{
+    aerodynamics::EmpiricalThermosphere empiricalThermosphere;
+
+    // Set points at which atmosphere is to be evaluated, in groups at equal times.
+    std::vector< double > altitudes, longitudes, latitudes, times;
+    for ( int i = 0; i < 300; i++ )
+    {
+        altitudes.push_back( 110.0e3 + static_cast< double >( i ) * 3.113e3 );
+        longitudes.push_back( 0.1 * static_cast< double >( i ) );
+        latitudes.push_back( 1.5 - 0.01 * static_cast< double >( i ) );
+        times.push_back( 3600.0 * static_cast< double >( i / 10 ) );
+    }
+
+    // Evaluate atmosphere at all points, through base class.
+    aerodynamics::AtmosphereModel& atmosphereModel = empiricalThermosphere;
+    std::vector< double > densities, pressures, temperatures;
+    atmosphereModel.getAtmosphericProperties( altitudes, longitudes, latitudes, times,
+                                              densities, pressures, temperatures );
+    std::vector< double > separateDensities;
+    atmosphereModel.getDensities( altitudes, longitudes, latitudes, times, separateDensities );
+
+    // Check results against queries at single points.
+    BOOST_REQUIRE_EQUAL( densities.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( pressures.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( temperatures.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( separateDensities.size( ), altitudes.size( ) );
+    for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( densities[ i ], empiricalThermosphere.getDensity(
+                               altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] ) );
+        BOOST_CHECK_EQUAL( pressures[ i ], empiricalThermosphere.getPressure(
+                               altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] ) );
+        BOOST_CHECK_EQUAL( temperatures[ i ], empiricalThermosphere.getTemperature(
+                               altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] ) );
+        BOOST_CHECK_EQUAL( separateDensities[ i ], densities[ i ] );
+    }
+
+    // Check that inputs of different size are rejected.
+    times.pop_back( );
+    BOOST_CHECK_THROW( atmosphereModel.getDensities( altitudes, longitudes, latitudes, times,
+                                                     densities ), std::runtime_error );
+}
+
+//! Test if invalid solar activity is rejected.
+BOOST_AUTO_TEST_CASE( testEmpiricalThermosphereInvalidSolarActivity )
+{
+    using aerodynamics::EmpiricalThermosphere;
+    using aerodynamics::SolarActivity;
+
+    EmpiricalThermosphere negativeFluxThermosphere( SolarActivity( -10.0, 150.0, 15.0 ) );
+    BOOST_CHECK_THROW( negativeFluxThermosphere.getDensity( 400.0e3, 0.0, 0.0, 0.0 ),
+                       std::runtime_error );
+
+    EmpiricalThermosphere negativeIndexThermosphere( SolarActivity( 150.0, 150.0, -1.0 ) );
+    BOOST_CHECK_THROW( negativeIndexThermosphere.getDensity( 400.0e3, 0.0, 0.0, 0.0 ),
+                       std::runtime_error );
+
+    BOOST_CHECK_THROW( EmpiricalThermosphere( aerodynamics::SolarActivityFunction( ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -33,6 +33,8 @@
  *      111211    K. Kumar          Minor corrections to location-independent function test.
  *      120618    A. Ronse          Boostified unit test.
  *      120627    P. Musegaas       Changed scope of some variable + minor corrections.
+ *      140319    S. Vermeer        Added check of combined query of atmospheric properties.
+ *      140326    S. Vermeer        Added test of queries at multiple points.
  *
  *    References
  *      US Standard Atmosphere 1976,
@@ -45,6 +47,8 @@
 #define BOOST_TEST_MAIN
 
 #include <limits>
+#include <stdexcept>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -64,6 +68,7 @@ BOOST_AUTO_TEST_SUITE( test_exponential_atmosphere )
 // Test 2: Test exponential atmosphere at sea level.
 // Test 3: Test exponential atmosphere at 10 km altitude.
 // Test 4: Test if the position-independent functions work.
+// Test 5: Test if the queries at multiple points work.
 
 //! Test set- and get-functions of constants.
 BOOST_AUTO_TEST_CASE( testExponentialAtmosphereGetSet )
@@ -202,6 +207,59 @@ BOOST_AUTO_TEST_CASE( testExponentialAtmospherePositionIndependentFunctions )
     BOOST_CHECK_EQUAL( density1, density2 );
     BOOST_CHECK_EQUAL( pressure1, pressure2 );
     BOOST_CHECK_EQUAL( temperature1, temperature2 );
+
+    // Check combined query of atmospheric properties.
+    const tudat::aerodynamics::AtmosphericProperties atmosphericProperties =
+            exponentialAtmosphere.getAtmosphericProperties( altitude );
+    BOOST_CHECK_EQUAL( density1, atmosphericProperties.density );
+    BOOST_CHECK_EQUAL( pressure1, atmosphericProperties.pressure );
+    BOOST_CHECK_EQUAL( temperature1, atmosphericProperties.temperature );
+}
+
+//! Test if the queries at multiple points work.
+BOOST_AUTO_TEST_CASE( testExponentialAtmosphereMultiplePoints )
+{
+    // Create and initialize an exponential atmosphere object.
+    tudat::aerodynamics::ExponentialAtmosphere exponentialAtmosphere;
+    exponentialAtmosphere.setPredefinedExponentialAtmosphere(
+                tudat::aerodynamics::ExponentialAtmosphere::earth );
+
+    // Set points at which atmosphere is to be evaluated.
+    std::vector< double > altitudes, longitudes, latitudes, times;
+    for ( int i = 0; i < 50; i++ )
+    {
+        altitudes.push_back( -1.0e3 + static_cast< double >( i ) * 3.7e3 );
+        longitudes.push_back( 0.1 * static_cast< double >( i ) );
+        latitudes.push_back( -0.05 * static_cast< double >( i ) );
+        times.push_back( 60.0 * static_cast< double >( i ) );
+    }
+
+    // Evaluate atmosphere at all points, through base class.
+    tudat::aerodynamics::AtmosphereModel& atmosphereModel = exponentialAtmosphere;
+    std::vector< double > densities, pressures, temperatures;
+    atmosphereModel.getAtmosphericProperties( altitudes, longitudes, latitudes, times,
+                                              densities, pressures, temperatures );
+    std::vector< double > separateDensities;
+    atmosphereModel.getDensities( altitudes, longitudes, latitudes, times, separateDensities );
+
+    // Check results against queries at single points.
+    BOOST_REQUIRE_EQUAL( densities.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( pressures.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( temperatures.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( separateDensities.size( ), altitudes.size( ) );
+    for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( densities[ i ], exponentialAtmosphere.getDensity( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( pressures[ i ], exponentialAtmosphere.getPressure( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( temperatures[ i ],
+                           exponentialAtmosphere.getTemperature( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( separateDensities[ i ], densities[ i ] );
+    }
+
+    // Check that inputs of different size are rejected.
+    times.pop_back( );
+    BOOST_CHECK_THROW( atmosphereModel.getDensities( altitudes, longitudes, latitudes, times,
+                                                     densities ), std::runtime_error );
 }
 
 BOOST_AUTO_TEST_SUITE_END( )
@@ -32,6 +32,9 @@
  *  	120618    A. Ronse          Boostified unit test
  *      120627    P. Musegaas       Changed scope of some variable + minor corrections, removed
  *                                  superfluous test.
+ *      140312    S. Vermeer        Added test of queries with caller-owned look-up cursor.
+ *      140319    S. Vermeer        Added test of combined query of atmospheric properties.
+ *      140326    S. Vermeer        Added test of queries at multiple points.
  *
  *    References
  *      Introduction to Flight, Fifth edition, Appendix A, John D. Anderson Jr., McGraw Hill, 2005.
@@ -44,10 +47,18 @@
 
 #define BOOST_TEST_MAIN
 
+#include <cmath>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include <Eigen/Core>
+
+#include <TudatCore/InputOutput/matrixTextFileReader.h>
+
 #include "Tudat/Astrodynamics/Aerodynamics/tabulatedAtmosphere.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
 
@@ -66,6 +77,9 @@ BOOST_AUTO_TEST_SUITE( test_tabulated_atmosphere )
 // Test 4: Test tabulated atmosphere at 1000 km altitude with table.
 // Test 5: Test if the atmosphere file can be read multiple times.
 // Test 6: Test if the position-independent functions work.
+// Test 7: Test if the queries with caller-owned look-up cursor work.
+// Test 8: Test if the combined query of atmospheric properties works.
+// Test 9: Test if the queries at multiple points work.
 
 //! Check if the atmosphere is calculated correctly at sea level.
 // Values from (US Standard Atmosphere, 1976).
@@ -206,6 +220,136 @@ BOOST_AUTO_TEST_CASE( testTabulatedAtmospherePositionIndependentFunctions)
     BOOST_CHECK_EQUAL( temperature1, temperature2 );
 }
 
+//! Test if the queries with caller-owned look-up cursor work.
+BOOST_AUTO_TEST_CASE( testTabulatedAtmosphereLookUpCursor )
+{
+    // Create a tabulated atmosphere object.
+    aerodynamics::TabulatedAtmosphere tabulatedAtmosphere;
+
+    // Initialize atmosphere with the desired file.
+    tabulatedAtmosphere.initialize( input_output::getTudatRootPath( ) +
+                                    "/External/AtmosphereTables/" +
+                                    "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" );
+
+    // Query atmosphere through constant reference, using a single cursor for all properties, for
+    // ascending and descending altitudes.
+    const aerodynamics::TabulatedAtmosphere& constantTabulatedAtmosphere = tabulatedAtmosphere;
+    interpolators::LookUpCursor lookUpCursor;
+    for ( int i = -100; i <= 100; i++ )
+    {
+        const double altitude = 5.0e5 - std::fabs( static_cast< double >( i ) ) * 5.025e3;
+
+        BOOST_CHECK_EQUAL( tabulatedAtmosphere.getDensity( altitude ),
+                           constantTabulatedAtmosphere.getDensity( altitude, lookUpCursor ) );
+        BOOST_CHECK_EQUAL( tabulatedAtmosphere.getPressure( altitude ),
+                           constantTabulatedAtmosphere.getPressure( altitude, lookUpCursor ) );
+        BOOST_CHECK_EQUAL( tabulatedAtmosphere.getTemperature( altitude ),
+                           constantTabulatedAtmosphere.getTemperature( altitude, lookUpCursor ) );
+    }
+}
+
+//! Test if the combined query of atmospheric properties works.
+BOOST_AUTO_TEST_CASE( testTabulatedAtmosphereAtmosphericProperties )
+{
+    // Create a tabulated atmosphere object.
+    aerodynamics::TabulatedAtmosphere tabulatedAtmosphere;
+
+    // Initialize atmosphere with the desired file.
+    const std::string atmosphereTableFile = input_output::getTudatRootPath( ) +
+            "/External/AtmosphereTables/" + "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat";
+    tabulatedAtmosphere.initialize( atmosphereTableFile );
+
+    // Create separate cubic spline for density, as used before introduction of vector-valued
+    // spline.
+    const Eigen::MatrixXd atmosphereTable =
+            input_output::readMatrixFromFile( atmosphereTableFile, " \t", "%" );
+    std::vector< double > altitudes;
+    std::vector< double > densities;
+    for ( int i = 0; i < atmosphereTable.rows( ); i++ )
+    {
+        altitudes.push_back( atmosphereTable( i, 0 ) );
+        densities.push_back( atmosphereTable( i, 1 ) );
+    }
+    interpolators::CubicSplineInterpolatorDouble densityInterpolator( altitudes, densities );
+
+    // Check combined query, through base class, against individual queries and separate spline.
+    aerodynamics::AtmosphereModel& atmosphereModel = tabulatedAtmosphere;
+    interpolators::LookUpCursor lookUpCursor;
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double altitude = -4.0e3 + static_cast< double >( i ) * 5.017e3;
+        const aerodynamics::AtmosphericProperties atmosphericProperties =
+                atmosphereModel.getAtmosphericProperties( altitude, 0.0, 0.0, 0.0 );
+
+        BOOST_CHECK_EQUAL( atmosphericProperties.density,
+                           tabulatedAtmosphere.getDensity( altitude ) );
+        BOOST_CHECK_EQUAL( atmosphericProperties.pressure,
+                           tabulatedAtmosphere.getPressure( altitude ) );
+        BOOST_CHECK_EQUAL( atmosphericProperties.temperature,
+                           tabulatedAtmosphere.getTemperature( altitude ) );
+        BOOST_CHECK_CLOSE_FRACTION( atmosphericProperties.density,
+                                    densityInterpolator.interpolate( altitude ), 1.0e-14 );
+
+        const aerodynamics::AtmosphericProperties cursorAtmosphericProperties =
+                tabulatedAtmosphere.getAtmosphericProperties( altitude, lookUpCursor );
+        BOOST_CHECK_EQUAL( cursorAtmosphericProperties.density, atmosphericProperties.density );
+        BOOST_CHECK_EQUAL( cursorAtmosphericProperties.pressure, atmosphericProperties.pressure );
+        BOOST_CHECK_EQUAL( cursorAtmosphericProperties.temperature,
+                           atmosphericProperties.temperature );
+    }
+}
+
+//! Check if the queries at multiple points work.
+BOOST_AUTO_TEST_CASE( testTabulatedAtmosphereMultiplePoints )
+{
+    // Create a tabulated atmosphere object.
+    aerodynamics::TabulatedAtmosphere tabulatedAtmosphere;
+
+    // Initialize atmosphere with the desired file.
+    tabulatedAtmosphere.initialize( input_output::getTudatRootPath( ) +
+                                    "/External/AtmosphereTables/" +
+                                    "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" );
+
+    // Set points at which atmosphere is to be evaluated, alternately ascending and descending.
+    std::vector< double > altitudes, longitudes, latitudes, times;
+    for ( int i = 0; i < 300; i++ )
+    {
+        altitudes.push_back( 2.0e3 + static_cast< double >( i ) * 3.113e3
+                             - static_cast< double >( i % 2 ) * 4.0e3 );
+        longitudes.push_back( 0.1 * static_cast< double >( i ) );
+        latitudes.push_back( -0.05 * static_cast< double >( i ) );
+        times.push_back( 60.0 * static_cast< double >( i ) );
+    }
+
+    // Evaluate atmosphere at all points, through base class.
+    aerodynamics::AtmosphereModel& atmosphereModel = tabulatedAtmosphere;
+    std::vector< double > densities, pressures, temperatures;
+    atmosphereModel.getAtmosphericProperties( altitudes, longitudes, latitudes, times,
+                                              densities, pressures, temperatures );
+    std::vector< double > separateDensities;
+    atmosphereModel.getDensities( altitudes, longitudes, latitudes, times, separateDensities );
+
+    // Check results against queries at single points.
+    BOOST_REQUIRE_EQUAL( densities.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( pressures.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( temperatures.size( ), altitudes.size( ) );
+    BOOST_REQUIRE_EQUAL( separateDensities.size( ), altitudes.size( ) );
+    for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( densities[ i ], tabulatedAtmosphere.getDensity( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( pressures[ i ], tabulatedAtmosphere.getPressure( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( temperatures[ i ],
+                           tabulatedAtmosphere.getTemperature( altitudes[ i ] ) );
+        BOOST_CHECK_EQUAL( separateDensities[ i ], densities[ i ] );
+    }
+
+    // Check that inputs of different size are rejected.
+    latitudes.pop_back( );
+    BOOST_CHECK_THROW( atmosphereModel.getAtmosphericProperties(
+                           altitudes, longitudes, latitudes, times,
+                           densities, pressures, temperatures ), std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
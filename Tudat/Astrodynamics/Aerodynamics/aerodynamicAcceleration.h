@@ -30,8 +30,17 @@
  *      121020    D. Dirkx          Update to new acceleration model architecture.
  *      130120    K. Kumar          Added shared pointer to AerodynamicAcceleration object.
  *      140129    D. Dirkx          Changed Doxygen descriptions
+ *      140221    S. Vermeer        Added scalar-type template of acceleration; made class a
+ *                                  template on acceleration data type, to allow automatic
+ *                                  differentiation scalars.
+ *      140401    S. Vermeer        Renamed class template and scalar-type template of acceleration;
+ *                                  restored AerodynamicAcceleration as typedef of double-precision
+ *                                  model, so that existing code is unaffected.
  *
  *    References
+ *      Eigen. Structures having Eigen members,
+ *          http://eigen.tuxfamily.org/dox/TopicStructHavingEigenMembers.html, last accessed: 5th
+ *          March, 2013.
  *
  *    Notes
  *
@@ -55,6 +64,31 @@ namespace tudat
 namespace aerodynamics
 {
 
+//! Compute the aerodynamic acceleration in same reference frame as input coefficients, for
+//! arbitrary scalar type.
+/*!
+ * This function computes the aerodynamic acceleration, as described for the double-precision
+ * computeAerodynamicAcceleration() function, for an arbitrary scalar type (for instance an
+ * automatic differentiation scalar).
+ * \tparam ScalarType Scalar type used for all input parameters and the acceleration.
+ * \param dynamicPressure Dynamic pressure at which the body undergoing the acceleration flies.
+ * \param referenceArea Reference area of the aerodynamic coefficients.
+ * \param aerodynamicCoefficients Aerodynamic coefficients in right-handed reference frame.
+ * \param vehicleMass Mass of vehicle undergoing acceleration.
+ * \return Resultant aerodynamic acceleration, given in reference frame in which the
+ *          aerodynamic coefficients were given (assuming coefficients in positive direction).
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeAerodynamicAccelerationTemplate(
+        const ScalarType& dynamicPressure,
+        const ScalarType& referenceArea,
+        const Eigen::Matrix< ScalarType, 3, 1 >& aerodynamicCoefficients,
+        const ScalarType& vehicleMass )
+{
+    return computeAerodynamicForceTemplate( dynamicPressure, referenceArea,
+                                            aerodynamicCoefficients ) / vehicleMass;
+}
+
 //! Compute the aerodynamic acceleration in same reference frame as input coefficients.
 /*!
  * This function computes the aerodynamic acceleration. It takes primitive types as arguments to
@@ -72,8 +106,9 @@ Eigen::Vector3d computeAerodynamicAcceleration( const double dynamicPressure,
                                                 const Eigen::Vector3d& aerodynamicCoefficients,
                                                 const double vehicleMass )
 {
-    return computeAerodynamicForce( dynamicPressure, referenceArea, aerodynamicCoefficients )
-            / vehicleMass;
+    return computeAerodynamicAccelerationTemplate< double >( dynamicPressure, referenceArea,
+                                                             aerodynamicCoefficients,
+                                                             vehicleMass );
 }
 
 //! Compute the aerodynamic acceleration in same reference frame as input coefficients.
@@ -97,23 +132,36 @@ Eigen::Vector3d computeAerodynamicAcceleration(
     return computeAerodynamicForce( dynamicPressure, coefficientInterface ) / vehicleMass;
 }
 
-//! Class for calculation of aerodynamic accelerations.
+//! Class template for calculation of aerodynamic accelerations.
 /*!
- * Class for calculation of aerodynamic accelerations.
+ * Class template for calculation of aerodynamic accelerations, for an arbitrary acceleration data
+ * type (for instance one with automatic differentiation scalars). The double-precision model is
+ * available as AerodynamicAcceleration.
+ * \tparam AccelerationDataType Data type used to represent coefficients and accelerations
+ *          (default = Eigen::Vector3d). Its scalar type is also used for the density, airspeed,
+ *          mass and reference area.
  * \sa AccelerationModel.
  */
-class AerodynamicAcceleration : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >
+template< typename AccelerationDataType = Eigen::Vector3d >
+class AerodynamicAccelerationTemplate
+        : public basic_astrodynamics::AccelerationModel< AccelerationDataType >
 {
 private:
 
-    //! Typedef for double-returning function.
-    typedef boost::function< double ( ) > DoubleReturningFunction;
+    //! Typedef for scalar type of acceleration data type.
+    typedef typename AccelerationDataType::Scalar ScalarType;
+
+    //! Typedef for scalar-returning function.
+    typedef boost::function< ScalarType( ) > ScalarReturningFunction;
 
     //! Typedef for coefficient-returning function.
-    typedef boost::function< Eigen::Vector3d( ) > CoefficientReturningFunction;
+    typedef boost::function< AccelerationDataType( ) > CoefficientReturningFunction;
 
 public:
 
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     //! Acceleration model constructor, taking constant values of mass and reference area.
     /*!
      * Acceleration model constructor, taking constant values of mass and reference area.
@@ -128,12 +176,12 @@ public:
      *          direction of aerodynamic coefficients. This is typically done for lift, drag and
      *          side force coefficients that point in negative direction in the local frame.
      */
-    AerodynamicAcceleration( const CoefficientReturningFunction coefficientFunction,
-                             const DoubleReturningFunction densityFunction,
-                             const DoubleReturningFunction airSpeedFunction,
-                             const double constantMass,
-                             const double constantReferenceArea,
-                             const bool areCoefficientsInNegativeDirection = true ):
+    AerodynamicAccelerationTemplate( const CoefficientReturningFunction coefficientFunction,
+                                     const ScalarReturningFunction densityFunction,
+                                     const ScalarReturningFunction airSpeedFunction,
+                                     const ScalarType constantMass,
+                                     const ScalarType constantReferenceArea,
+                                     const bool areCoefficientsInNegativeDirection = true ):
         coefficientFunction_( coefficientFunction ),
         densityFunction_( densityFunction ),
         airSpeedFunction_( airSpeedFunction ),
@@ -157,12 +205,12 @@ public:
      *          direction of aerodynamic coefficients. This is typically done for lift, drag and
      *          side force coefficients that point in negative direction in the local frame.
      */
-    AerodynamicAcceleration( const CoefficientReturningFunction coefficientFunction,
-                             const DoubleReturningFunction densityFunction,
-                             const DoubleReturningFunction airSpeedFunction,
-                             const DoubleReturningFunction massFunction,
-                             const DoubleReturningFunction referenceAreaFunction,
-                             const bool areCoefficientsInNegativeDirection = true ):
+    AerodynamicAccelerationTemplate( const CoefficientReturningFunction coefficientFunction,
+                                     const ScalarReturningFunction densityFunction,
+                                     const ScalarReturningFunction airSpeedFunction,
+                                     const ScalarReturningFunction massFunction,
+                                     const ScalarReturningFunction referenceAreaFunction,
+                                     const bool areCoefficientsInNegativeDirection = true ):
         coefficientFunction_( coefficientFunction ),
         densityFunction_( densityFunction ),
         airSpeedFunction_( airSpeedFunction ),
@@ -182,10 +230,10 @@ public:
      * \return Acceleration.
      * \sa updateMembers().
      */
-    Eigen::Vector3d getAcceleration( )
+    AccelerationDataType getAcceleration( )
     {
-        return computeAerodynamicAcceleration(
-                    0.5 * currentDensity_ * currentAirspeed_ * currentAirspeed_,
+        return computeAerodynamicAccelerationTemplate(
+                    ScalarType( 0.5 * currentDensity_ * currentAirspeed_ * currentAirspeed_ ),
                     currentReferenceArea_, currentForceCoefficients_, currentMass_ );
     }
 
@@ -217,55 +265,55 @@ private:
     /*!
      *  Function to retrieve the current density.
      */
-    const DoubleReturningFunction densityFunction_;
+    const ScalarReturningFunction densityFunction_;
 
     //! Function to retrieve the current airspeed.
     /*!
      *  Function to retrieve the current airspeed.
      */
-    const DoubleReturningFunction airSpeedFunction_;
+    const ScalarReturningFunction airSpeedFunction_;
 
     //! Function to retrieve the current mass.
     /*!
      *  Function to retrieve the current mass.
      */
-    const DoubleReturningFunction massFunction_;
+    const ScalarReturningFunction massFunction_;
 
     //! Function to retrieve the current reference area.
     /*!
      *  Function to retrieve the current reference area.
      */
-    const DoubleReturningFunction referenceAreaFunction_;
+    const ScalarReturningFunction referenceAreaFunction_;
 
     //! Current aerodynamic force coefficients.
     /*!
      *  Current aerodynamic force coefficients, as set by coefficientFunction_.
      */
-    Eigen::Vector3d currentForceCoefficients_;
+    AccelerationDataType currentForceCoefficients_;
 
     //! Current density.
     /*!
      *  Current density, as set by densityFunction_.
      */
-    double currentDensity_;
+    ScalarType currentDensity_;
 
     //! Current airspeed.
     /*!
      *  Current airspeed, as set by airspeedFunction_.
      */
-    double currentAirspeed_;
+    ScalarType currentAirspeed_;
 
     //! Current mass.
     /*!
      *  Current mass, as set by massFunction_.
      */
-    double currentMass_;
+    ScalarType currentMass_;
 
     //! Current reference area.
     /*!
      *  Current reference area, as set by referenceAreaFunction_.
      */
-    double currentReferenceArea_;
+    ScalarType currentReferenceArea_;
 
     //! Multiplier to reverse direction of coefficients.
     /*!
@@ -274,6 +322,9 @@ private:
     double coefficientMultiplier_;
 };
 
+//! Typedef for double-precision aerodynamic acceleration model.
+typedef AerodynamicAccelerationTemplate< Eigen::Vector3d > AerodynamicAcceleration;
+
 //! Typedef for shared-pointer to AerodynamicAcceleration object.
 typedef boost::shared_ptr< AerodynamicAcceleration > AerodynamicAccelerationPointer;
 
@@ -31,6 +31,10 @@
  *                                  corrections in Doxygen comments; updated input parameters for
  *                                  free functions; added astrodynamics namespace layer.
  *      121020    D. Dirkx          Update to new acceleration model architecture.
+ *      140221    S. Vermeer        Added scalar-type template of force, to allow automatic
+ *                                  differentiation scalars.
+ *      140401    S. Vermeer        Renamed scalar-type template of force, so that it does not
+ *                                  overload the double-precision function.
  *
  *    References
  *
@@ -55,6 +59,28 @@ namespace tudat
 namespace aerodynamics
 {
 
+//! Compute the aerodynamic force in same reference frame as input coefficients, for arbitrary
+//! scalar type.
+/*!
+ * This function calculates the aerodynamic force, as described for the double-precision
+ * computeAerodynamicForce() function, for an arbitrary scalar type (for instance an automatic
+ * differentiation scalar).
+ * \tparam ScalarType Scalar type used for all input parameters and the force.
+ * \param dynamicPressure Dynamic pressure at which the body undergoing the force flies.
+ * \param referenceArea Reference area of the aerodynamic coefficients.
+ * \param aerodynamicCoefficients Aerodynamic coefficients in right-handed reference frame.
+ * \return Resultant aerodynamic force, given in reference frame in which the
+ *          aerodynamic coefficients were given.
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeAerodynamicForceTemplate(
+        const ScalarType& dynamicPressure,
+        const ScalarType& referenceArea,
+        const Eigen::Matrix< ScalarType, 3, 1 >& aerodynamicCoefficients )
+{
+    return dynamicPressure * referenceArea * aerodynamicCoefficients;
+}
+
 //! Compute the aerodynamic force in same reference frame as input coefficients.
 /*!
  * This function calculates the aerodynamic force. It takes primitive types as arguments to
@@ -70,7 +96,8 @@ Eigen::Vector3d computeAerodynamicForce( const double dynamicPressure,
                                          const double referenceArea,
                                          const Eigen::Vector3d& aerodynamicCoefficients )
 {
-    return dynamicPressure * referenceArea * aerodynamicCoefficients;
+    return computeAerodynamicForceTemplate< double >( dynamicPressure, referenceArea,
+                                                      aerodynamicCoefficients );
 }
 
 //! Compute the aerodynamic force in same reference frame as input coefficients.
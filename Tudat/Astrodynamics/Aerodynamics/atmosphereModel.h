@@ -31,16 +31,25 @@
  *      110705    F.M. Engelen      Changed to passing by reference.
  *      130120    K. Kumar          Made function calls const-correct; added shared-pointer
  *                                  typedef.
+ *      140319    S. Vermeer        Added combined query of density, pressure and temperature.
+ *      140326    S. Vermeer        Added queries at multiple points.
  *
  *    References
  *
  *    Notes
+ *      The queries at multiple points (getDensities and the overload of getAtmosphericProperties
+ *      taking vectors) require a single virtual function call for all points, instead of one per
+ *      point, and allow derived classes to process the points in a single loop.
  *
  */
 
 #ifndef TUDAT_ATMOSPHERE_MODEL_H
 #define TUDAT_ATMOSPHERE_MODEL_H
 
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
 #include <boost/shared_ptr.hpp>
 
 namespace tudat
@@ -48,6 +57,37 @@ namespace tudat
 namespace aerodynamics
 {
 
+//! Atmospheric properties at a single location and time.
+/*!
+ * Atmospheric properties at a single location and time, as returned by a combined query of an
+ * atmosphere model.
+ */
+struct AtmosphericProperties
+{
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param aDensity Atmospheric density in kg per meter^3.
+     * \param aPressure Atmospheric pressure in Newton per meter^2.
+     * \param aTemperature Atmospheric temperature in Kelvin.
+     */
+    AtmosphericProperties( const double aDensity = 0.0, const double aPressure = 0.0,
+                           const double aTemperature = 0.0 )
+        : density( aDensity ),
+          pressure( aPressure ),
+          temperature( aTemperature )
+    { }
+
+    //! Atmospheric density in kg per meter^3.
+    double density;
+
+    //! Atmospheric pressure in Newton per meter^2.
+    double pressure;
+
+    //! Atmospheric temperature in Kelvin.
+    double temperature;
+};
+
 //! Atmosphere model class.
 /*!
  * Base class for all atmosphere models.
@@ -100,8 +140,119 @@ public:
     virtual double getTemperature( const double altitude, const double longitude,
                                    const double latitude, const double time ) = 0;
 
+    //! Get local density, pressure and temperature.
+    /*!
+    * Returns the local density, pressure and temperature of the atmosphere in a single call.
+    * The default implementation calls the individual get functions; derived classes that can
+    * compute the properties together at lower cost (e.g., with a single table look-up) should
+    * override this function.
+    * \param altitude Altitude.
+    * \param longitude Longitude.
+    * \param latitude Latitude.
+    * \param time Time.
+    * \return Atmospheric density, pressure and temperature.
+    */
+    virtual AtmosphericProperties getAtmosphericProperties( const double altitude,
+                                                            const double longitude,
+                                                            const double latitude,
+                                                            const double time )
+    {
+        return AtmosphericProperties( getDensity( altitude, longitude, latitude, time ),
+                                      getPressure( altitude, longitude, latitude, time ),
+                                      getTemperature( altitude, longitude, latitude, time ) );
+    }
+
+    //! Get local densities at multiple points.
+    /*!
+    * Computes the local density of the atmosphere in kg per meter^3 at each of a number of
+    * points, given by the entries of the input vectors, which must be of equal size. The default
+    * implementation calls getDensity for each point; derived classes should override this
+    * function to avoid a virtual function call per point. The points are best ordered such that
+    * subsequent points are close together.
+    * \param altitudes Altitudes.
+    * \param longitudes Longitudes.
+    * \param latitudes Latitudes.
+    * \param times Times.
+    * \param densities Atmospheric densities, one per point (returned by reference). No memory is
+    *          allocated if the vector already has the correct size.
+    */
+    virtual void getDensities( const std::vector< double >& altitudes,
+                               const std::vector< double >& longitudes,
+                               const std::vector< double >& latitudes,
+                               const std::vector< double >& times,
+                               std::vector< double >& densities )
+    {
+        checkInputSizes( altitudes, longitudes, latitudes, times );
+        densities.resize( altitudes.size( ) );
+        for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+        {
+            densities[ i ] = getDensity( altitudes[ i ], longitudes[ i ], latitudes[ i ],
+                                         times[ i ] );
+        }
+    }
+
+    //! Get local density, pressure and temperature at multiple points.
+    /*!
+    * Computes the local density, pressure and temperature of the atmosphere at each of a number
+    * of points, given by the entries of the input vectors, which must be of equal size. The
+    * default implementation calls getAtmosphericProperties for each point; derived classes should
+    * override this function to avoid a virtual function call per point. The points are best
+    * ordered such that subsequent points are close together.
+    * \param altitudes Altitudes.
+    * \param longitudes Longitudes.
+    * \param latitudes Latitudes.
+    * \param times Times.
+    * \param densities Atmospheric densities, one per point (returned by reference).
+    * \param pressures Atmospheric pressures, one per point (returned by reference).
+    * \param temperatures Atmospheric temperatures, one per point (returned by reference).
+    */
+    virtual void getAtmosphericProperties( const std::vector< double >& altitudes,
+                                           const std::vector< double >& longitudes,
+                                           const std::vector< double >& latitudes,
+                                           const std::vector< double >& times,
+                                           std::vector< double >& densities,
+                                           std::vector< double >& pressures,
+                                           std::vector< double >& temperatures )
+    {
+        checkInputSizes( altitudes, longitudes, latitudes, times );
+        densities.resize( altitudes.size( ) );
+        pressures.resize( altitudes.size( ) );
+        temperatures.resize( altitudes.size( ) );
+        for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+        {
+            const AtmosphericProperties atmosphericProperties = getAtmosphericProperties(
+                        altitudes[ i ], longitudes[ i ], latitudes[ i ], times[ i ] );
+            densities[ i ] = atmosphericProperties.density;
+            pressures[ i ] = atmosphericProperties.pressure;
+            temperatures[ i ] = atmosphericProperties.temperature;
+        }
+    }
+
 protected:
 
+    //! Check sizes of input vectors of queries at multiple points.
+    /*!
+    * Checks whether the input vectors of a query at multiple points are of equal size, throws an
+    * exception if they are not.
+    * \param altitudes Altitudes.
+    * \param longitudes Longitudes.
+    * \param latitudes Latitudes.
+    * \param times Times.
+    */
+    static void checkInputSizes( const std::vector< double >& altitudes,
+                                 const std::vector< double >& longitudes,
+                                 const std::vector< double >& latitudes,
+                                 const std::vector< double >& times )
+    {
+        if ( longitudes.size( ) != altitudes.size( ) || latitudes.size( ) != altitudes.size( )
+             || times.size( ) != altitudes.size( ) )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                    "Error, altitudes, longitudes, latitudes and times of atmosphere query are "
+                    "not of equal size." ) ) );
+        }
+    }
+
 private:
 };
 
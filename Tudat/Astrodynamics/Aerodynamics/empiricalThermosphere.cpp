@@ -0,0 +1,407 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140331    S. Vermeer        File created.
+ *
+ *    References
+ *      Jacchia, L.G. New static models of the thermosphere and exosphere with empirical
+ *          temperature profiles, SAO Special Report 313, 1970.
+ *      Jacchia, L.G. Revised static models of the thermosphere and exosphere with empirical
+ *          temperature profiles, SAO Special Report 332, 1971.
+ *      US Standard Atmosphere 1976,
+ *          http://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19770009539_1977009539.pdf.
+ *      The Astronomical Almanac, Low precision formulas for the Sun, U.S. Naval Observatory,
+ *          2014.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/unitConversions.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/Aerodynamics/empiricalThermosphere.h"
+#include "Tudat/Basics/tracing.h"
+
+namespace tudat
+{
+namespace aerodynamics
+{
+
+namespace
+{
+
+using basic_astrodynamics::unit_conversions::convertDegreesToRadians;
+using basic_mathematics::mathematical_constants::PI;
+
+//! Altitude of lower boundary of diffusive equilibrium, in meters.
+const double boundaryAltitude = 120.0e3;
+
+//! Temperature at lower boundary, in Kelvin (US Standard Atmosphere 1976).
+const double boundaryTemperature = 360.0;
+
+//! Temperature gradient at lower boundary, in Kelvin per meter (US Standard Atmosphere 1976).
+const double boundaryTemperatureGradient = 12.0e-3;
+
+//! Effective Earth radius for geopotential altitude, in meters (US Standard Atmosphere 1976).
+const double effectiveEarthRadius = 6356.766e3;
+
+//! Scale height below lower boundary, in meters.
+/*!
+ * Scale height below lower boundary, in meters, from the densities of the US Standard Atmosphere
+ * 1976 at 100 km and 120 km.
+ */
+const double lowerThermosphereScaleHeight = 6.197e3;
+
+//! Number of species in diffusive equilibrium.
+const int numberOfSpecies = 5;
+
+//! Index of helium in species arrays.
+const int heliumIndex = 4;
+
+//! Molar masses of N2, O2, O, Ar and He, in kg per mole.
+const double molarMasses[ numberOfSpecies ] =
+{ 28.0134e-3, 31.9988e-3, 15.9994e-3, 39.948e-3, 4.0026e-3 };
+
+//! Number densities of N2, O2, O, Ar and He at lower boundary, in per meter^3.
+/*!
+ * Number densities of N2, O2, O, Ar and He at lower boundary, in per meter^3 (US Standard
+ * Atmosphere 1976).
+ */
+const double boundaryNumberDensities[ numberOfSpecies ] =
+{ 3.726e17, 4.398e16, 9.275e16, 1.130e15, 3.461e13 };
+
+//! Thermal diffusion coefficients of N2, O2, O, Ar and He.
+const double thermalDiffusionCoefficients[ numberOfSpecies ] = { 0.0, 0.0, 0.0, 0.0, -0.40 };
+
+//! Julian day of J2000.
+const double julianDayAtJ2000 = 2451545.0;
+
+//! Amplitude of diurnal variation of exospheric temperature (Jacchia, 1970).
+const double diurnalAmplitude = 0.3;
+
+//! Exponent of latitude terms of diurnal variation (Jacchia, 1970).
+const double diurnalLatitudeExponent = 2.2;
+
+//! Phase of diurnal variation, in radians (Jacchia, 1970).
+const double diurnalPhase = convertDegreesToRadians( -37.0 );
+
+//! Amplitude of asymmetry of diurnal variation, in radians (Jacchia, 1970).
+const double diurnalAsymmetryAmplitude = convertDegreesToRadians( 6.0 );
+
+//! Phase of asymmetry of diurnal variation, in radians (Jacchia, 1970).
+const double diurnalAsymmetryPhase = convertDegreesToRadians( 43.0 );
+
+//! Obliquity of the ecliptic at J2000, in radians.
+const double obliquityAtJ2000 = convertDegreesToRadians( 23.439 );
+
+//! Gravitational acceleration at lower boundary, in meters per second^2.
+const double boundaryGravitationalAcceleration =
+        physical_constants::SEA_LEVEL_GRAVITATIONAL_ACCELERATION
+        * ( effectiveEarthRadius / ( effectiveEarthRadius + boundaryAltitude ) )
+        * ( effectiveEarthRadius / ( effectiveEarthRadius + boundaryAltitude ) );
+
+//! Avogadro constant, in per mole.
+const double avogadroConstant = physical_constants::MOLAR_GAS_CONSTANT
+        / physical_constants::BOLTZMANN_CONSTANT;
+
+//! Return constant solar activity.
+/*!
+ * Returns the given solar activity, used as solar activity function for constant activity.
+ * \param solarActivity Solar and geomagnetic activity.
+ * \return Solar and geomagnetic activity.
+ */
+SolarActivity returnConstantSolarActivity( const SolarActivity solarActivity )
+{
+    return solarActivity;
+}
+
+} // namespace
+
+//! Constructor with constant solar activity.
+EmpiricalThermosphere::EmpiricalThermosphere( const SolarActivity& solarActivity )
+    : solarActivityFunction_( boost::bind( &returnConstantSolarActivity, solarActivity ) ),
+      areEpochTermsCached_( false )
+{ }
+
+//! Constructor with time-dependent solar activity.
+EmpiricalThermosphere::EmpiricalThermosphere( const SolarActivityFunction& solarActivityFunction )
+    : solarActivityFunction_( solarActivityFunction ),
+      areEpochTermsCached_( false )
+{
+    if ( solarActivityFunction_.empty( ) )
+    {
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                "Error, solar activity function of empirical thermosphere is empty." ) ) );
+    }
+}
+
+//! Get local densities at multiple points.
+void EmpiricalThermosphere::getDensities( const std::vector< double >& altitudes,
+                                          const std::vector< double >& longitudes,
+                                          const std::vector< double >& latitudes,
+                                          const std::vector< double >& times,
+                                          std::vector< double >& densities )
+{
+    TUDAT_TRACE_SCOPE( "Aerodynamics", "EmpiricalThermosphere::getDensities" );
+
+    checkInputSizes( altitudes, longitudes, latitudes, times );
+
+    const int numberOfPoints = static_cast< int >( altitudes.size( ) );
+    densities.resize( numberOfPoints );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        densities[ i ] = getAtmosphericProperties( altitudes[ i ], longitudes[ i ], latitudes[ i ],
+                                                   getEpochTerms( times[ i ] ) ).density;
+    }
+}
+
+//! Get local density, pressure and temperature at multiple points.
+void EmpiricalThermosphere::getAtmosphericProperties( const std::vector< double >& altitudes,
+                                                      const std::vector< double >& longitudes,
+                                                      const std::vector< double >& latitudes,
+                                                      const std::vector< double >& times,
+                                                      std::vector< double >& densities,
+                                                      std::vector< double >& pressures,
+                                                      std::vector< double >& temperatures )
+{
+    TUDAT_TRACE_SCOPE( "Aerodynamics", "EmpiricalThermosphere::getAtmosphericProperties" );
+
+    checkInputSizes( altitudes, longitudes, latitudes, times );
+
+    const int numberOfPoints = static_cast< int >( altitudes.size( ) );
+    densities.resize( numberOfPoints );
+    pressures.resize( numberOfPoints );
+    temperatures.resize( numberOfPoints );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        const AtmosphericProperties atmosphericProperties = getAtmosphericProperties(
+                    altitudes[ i ], longitudes[ i ], latitudes[ i ], getEpochTerms( times[ i ] ) );
+        densities[ i ] = atmosphericProperties.density;
+        pressures[ i ] = atmosphericProperties.pressure;
+        temperatures[ i ] = atmosphericProperties.temperature;
+    }
+}
+
+//! Get local density, pressure and temperature with given time-dependent terms.
+AtmosphericProperties EmpiricalThermosphere::getAtmosphericProperties(
+        const double altitude, const double longitude, const double latitude,
+        const ThermosphereEpochTerms& epochTerms ) const
+{
+    // Compute seasonal-latitudinal variation of helium density (Jacchia, 1971).
+    double heliumDensityFactor = 1.0;
+    if ( epochTerms.heliumVariationAmplitude > 0.0 )
+    {
+        const double signOfSolarDeclination = ( epochTerms.solarDeclination > 0.0 ) ? 1.0 : -1.0;
+        const double heliumLatitudeTerm = std::sin(
+                    0.25 * PI - 0.5 * latitude * signOfSolarDeclination );
+        heliumDensityFactor = std::pow(
+                    10.0, epochTerms.heliumVariationAmplitude
+                    * ( heliumLatitudeTerm * heliumLatitudeTerm * heliumLatitudeTerm - 0.35355 ) );
+    }
+
+    AtmosphericProperties atmosphericProperties = computeDiffusiveEquilibriumProperties(
+                altitude, computeExosphericTemperature( longitude, latitude, epochTerms ),
+                heliumDensityFactor );
+
+    // Compute semi-annual variation and seasonal-latitudinal variation of the lower thermosphere
+    // of log10 of the density (Jacchia, 1971), with the altitude in km, evaluated at the lower
+    // boundary for altitudes below it.
+    const double altitudeInKilometers = std::max( altitude, boundaryAltitude ) / 1.0e3;
+    const double sineLatitude = std::sin( latitude );
+    const double logarithmDensityVariation =
+            ( 5.876e-7 * std::pow( altitudeInKilometers, 2.331 ) + 0.06328 )
+            * std::exp( -2.868e-3 * altitudeInKilometers ) * epochTerms.semiAnnualVariation
+            + 0.014 * ( altitudeInKilometers - 90.0 )
+            * std::exp( -0.0013 * ( altitudeInKilometers - 90.0 )
+                        * ( altitudeInKilometers - 90.0 ) )
+            * epochTerms.seasonalLatitudinalVariation * sineLatitude * std::fabs( sineLatitude );
+
+    // The variations change the number densities of all species by the same factor, so that the
+    // density and pressure are scaled, and the temperature is unchanged.
+    const double densityVariationFactor = std::pow( 10.0, logarithmDensityVariation );
+    atmosphericProperties.density *= densityVariationFactor;
+    atmosphericProperties.pressure *= densityVariationFactor;
+
+    return atmosphericProperties;
+}
+
+//! Compute time-dependent terms.
+ThermosphereEpochTerms EmpiricalThermosphere::computeEpochTerms( const double time ) const
+{
+    const SolarActivity solarActivity = solarActivityFunction_( time );
+    if ( !( solarActivity.solarFlux > 0.0 ) || !( solarActivity.averageSolarFlux > 0.0 )
+         || !( solarActivity.geomagneticIndex >= 0.0 ) )
+    {
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                "Error, solar activity of empirical thermosphere is invalid; solar fluxes must be "
+                "positive and geomagnetic index must be non-negative." ) ) );
+    }
+
+    ThermosphereEpochTerms epochTerms;
+    epochTerms.time = time;
+
+    // Compute declination and hour angle of the Sun, with the low precision formulas of the
+    // Astronomical Almanac (accurate to 0.01 degrees between 1950 and 2050).
+    const double daysSinceJ2000 = time / physical_constants::JULIAN_DAY;
+    const double meanAnomaly = convertDegreesToRadians(
+                std::fmod( 357.529 + 0.98560028 * daysSinceJ2000, 360.0 ) );
+    const double eclipticLongitude = convertDegreesToRadians(
+                std::fmod( 280.459 + 0.98564736 * daysSinceJ2000, 360.0 )
+                + 1.915 * std::sin( meanAnomaly ) + 0.020 * std::sin( 2.0 * meanAnomaly ) );
+    const double obliquity = obliquityAtJ2000
+            - convertDegreesToRadians( 3.6e-7 ) * daysSinceJ2000;
+    epochTerms.solarDeclination = std::asin( std::sin( obliquity )
+                                             * std::sin( eclipticLongitude ) );
+    const double solarRightAscension = std::atan2(
+                std::cos( obliquity ) * std::sin( eclipticLongitude ),
+                std::cos( eclipticLongitude ) );
+    const double greenwichMeanSiderealTime = convertDegreesToRadians(
+                std::fmod( 280.46061837 + 360.98564736629 * daysSinceJ2000, 360.0 ) );
+    epochTerms.solarHourAngleAtZeroLongitude = greenwichMeanSiderealTime - solarRightAscension;
+
+    // Compute exospheric temperature terms of solar flux (Jacchia, 1971) and geomagnetic activity
+    // (Jacchia, 1970).
+    epochTerms.nightTimeExosphericTemperature = 379.0 + 3.24 * solarActivity.averageSolarFlux
+            + 1.3 * ( solarActivity.solarFlux - solarActivity.averageSolarFlux );
+    epochTerms.geomagneticTemperatureIncrement = solarActivity.geomagneticIndex
+            + 125.0 * ( 1.0 - std::exp( -0.08 * solarActivity.geomagneticIndex ) );
+
+    // Compute semi-annual and seasonal terms (Jacchia, 1971), from the number of tropical years
+    // since 1 January 1958.
+    const double tropicalYearsSince1958 =
+            ( daysSinceJ2000 + julianDayAtJ2000 - 2436204.5 ) / 365.2422;
+    const double yearPhase = 2.0 * PI * tropicalYearsSince1958;
+    const double semiAnnualPhase = 2.0 * PI * (
+                tropicalYearsSince1958 + 0.09544 * (
+                    std::pow( 0.5 + 0.5 * std::sin( yearPhase + 6.035 ), 1.65 ) - 0.5 ) );
+    epochTerms.semiAnnualVariation = 0.02835 + 0.3817
+            * ( 1.0 + 0.4671 * std::sin( semiAnnualPhase + 4.137 ) )
+            * std::sin( 2.0 * semiAnnualPhase + 4.259 );
+    epochTerms.seasonalLatitudinalVariation = std::sin( yearPhase + 1.72 );
+    epochTerms.heliumVariationAmplitude = 0.65 * std::fabs( epochTerms.solarDeclination )
+            / obliquity;
+
+    return epochTerms;
+}
+
+//! Compute exospheric temperature.
+double EmpiricalThermosphere::computeExosphericTemperature(
+        const double longitude, const double latitude,
+        const ThermosphereEpochTerms& epochTerms ) const
+{
+    // Compute diurnal variation (Jacchia, 1970). The absolute value of the cosine of half the
+    // diurnal angle equals that of the diurnal angle reduced to the interval [-pi, pi].
+    const double solarHourAngle = epochTerms.solarHourAngleAtZeroLongitude + longitude;
+    const double diurnalAngle = solarHourAngle + diurnalPhase
+            + diurnalAsymmetryAmplitude * std::sin( solarHourAngle + diurnalAsymmetryPhase );
+    const double cosineHalfDiurnalAngle = std::fabs( std::cos( 0.5 * diurnalAngle ) );
+    const double sineTerm = std::pow(
+                std::sin( 0.5 * std::fabs( latitude + epochTerms.solarDeclination ) ),
+                diurnalLatitudeExponent );
+    const double cosineTerm = std::pow(
+                std::cos( 0.5 * std::fabs( latitude - epochTerms.solarDeclination ) ),
+                diurnalLatitudeExponent );
+
+    return epochTerms.nightTimeExosphericTemperature
+            * ( 1.0 + diurnalAmplitude * sineTerm + diurnalAmplitude * ( cosineTerm - sineTerm )
+                * cosineHalfDiurnalAngle * cosineHalfDiurnalAngle * cosineHalfDiurnalAngle )
+            + epochTerms.geomagneticTemperatureIncrement;
+}
+
+//! Compute atmospheric properties in diffusive equilibrium.
+AtmosphericProperties EmpiricalThermosphere::computeDiffusiveEquilibriumProperties(
+        const double altitude, const double exosphericTemperature,
+        const double heliumDensityFactor )
+{
+    if ( !( exosphericTemperature > boundaryTemperature ) )
+    {
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                "Error, exospheric temperature of empirical thermosphere must exceed the "
+                "temperature at 120 km." ) ) );
+    }
+
+    // Compute geopotential altitude above lower boundary, and temperature of Bates profile.
+    const double boundedAltitude = std::max( altitude, boundaryAltitude );
+    const double shapeParameter = boundaryTemperatureGradient
+            / ( exosphericTemperature - boundaryTemperature );
+    const double geopotentialAltitude = ( boundedAltitude - boundaryAltitude )
+            * ( effectiveEarthRadius + boundaryAltitude )
+            / ( effectiveEarthRadius + boundedAltitude );
+    const double temperature = exosphericTemperature
+            - ( exosphericTemperature - boundaryTemperature )
+            * std::exp( -shapeParameter * geopotentialAltitude );
+    const double logarithmOfTemperatureRatio = std::log( boundaryTemperature / temperature );
+
+    // Compute number density of each species in diffusive equilibrium, which for the Bates
+    // profile is n = n_0 ( T_0 / T )^( 1 + alpha + gamma ) exp( -sigma gamma z ), with z the
+    // geopotential altitude, sigma the shape parameter and gamma = M g_0 / ( sigma R T_inf ).
+    const double inverseScaleHeightPerMolarMass = boundaryGravitationalAcceleration
+            / ( physical_constants::MOLAR_GAS_CONSTANT * exosphericTemperature );
+    double numberDensity = 0.0;
+    double molarMassDensity = 0.0;
+    for ( int i = 0; i < numberOfSpecies; i++ )
+    {
+        const double inverseScaleHeight = molarMasses[ i ] * inverseScaleHeightPerMolarMass;
+        const double temperatureExponent = 1.0 + thermalDiffusionCoefficients[ i ]
+                + inverseScaleHeight / shapeParameter;
+        double speciesNumberDensity = boundaryNumberDensities[ i ] * std::exp(
+                    temperatureExponent * logarithmOfTemperatureRatio
+                    - inverseScaleHeight * geopotentialAltitude );
+        if ( i == heliumIndex )
+        {
+            speciesNumberDensity *= heliumDensityFactor;
+        }
+
+        numberDensity += speciesNumberDensity;
+        molarMassDensity += molarMasses[ i ] * speciesNumberDensity;
+    }
+
+    // Extrapolate density and pressure exponentially below lower boundary.
+    double extrapolationFactor = 1.0;
+    if ( altitude < boundaryAltitude )
+    {
+        extrapolationFactor = std::exp( ( boundaryAltitude - altitude )
+                                        / lowerThermosphereScaleHeight );
+    }
+
+    return AtmosphericProperties(
+                extrapolationFactor * molarMassDensity / avogadroConstant,
+                extrapolationFactor * numberDensity * physical_constants::BOLTZMANN_CONSTANT
+                * temperature, temperature );
+}
+
+} // namespace aerodynamics
+} // namespace tudat
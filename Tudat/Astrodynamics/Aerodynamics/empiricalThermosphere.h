@@ -0,0 +1,382 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140331    S. Vermeer        File created.
+ *
+ *    References
+ *      Jacchia, L.G. New static models of the thermosphere and exosphere with empirical
+ *          temperature profiles, SAO Special Report 313, 1970.
+ *      Jacchia, L.G. Revised static models of the thermosphere and exosphere with empirical
+ *          temperature profiles, SAO Special Report 332, 1971.
+ *      Picone, J.M., Hedin, A.E., Drob, D.P., Aikin, A.C. NRLMSISE-00 empirical model of the
+ *          atmosphere: Statistical comparisons and scientific issues, Journal of Geophysical
+ *          Research, 107(A12), 1468, 2002.
+ *      US Standard Atmosphere 1976,
+ *          http://ntrs.nasa.gov/archive/nasa/casi.ntrs.nasa.gov/19770009539_1977009539.pdf.
+ *
+ *    Notes
+ *      The model follows the structure of the thermospheric part of the MSIS models
+ *      (NRLMSISE-00): a Bates temperature profile above 120 km, and the number density of each
+ *      species in diffusive equilibrium, integrated analytically. The exospheric temperature and
+ *      the density variations are the empirical relations of Jacchia (1970, 1971), instead of the
+ *      spherical harmonic expansions of NRLMSISE-00, so that the model has only a few dozen
+ *      coefficients. With an exospheric temperature of 1000 K it reproduces the US Standard
+ *      Atmosphere 1976 within 1 percent up to 400 km, and within 15 percent up to 1000 km,
+ *      where the neglected hydrogen becomes significant.
+ *
+ *      All terms that depend only on time (solar position, sidereal time, solar and geomagnetic
+ *      activity and the semi-annual and seasonal harmonics) are collected in
+ *      ThermosphereEpochTerms. These are computed once per epoch and reused for all queries at
+ *      the same time, such as the evaluation of a drag model for several bodies, or the points
+ *      of a density map.
+ *
+ */
+
+#ifndef TUDAT_EMPIRICAL_THERMOSPHERE_H
+#define TUDAT_EMPIRICAL_THERMOSPHERE_H
+
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Astrodynamics/Aerodynamics/atmosphereModel.h"
+
+namespace tudat
+{
+namespace aerodynamics
+{
+
+//! Solar and geomagnetic activity.
+/*!
+ * Solar and geomagnetic activity indices that drive the exospheric temperature of the empirical
+ * thermosphere.
+ */
+struct SolarActivity
+{
+    //! Constructor.
+    /*!
+     * Constructor, the default values correspond to moderate solar and geomagnetic activity.
+     * \param aSolarFlux Daily 10.7 cm solar radio flux, in solar flux units (10^-22 W/(m^2 Hz)).
+     * \param anAverageSolarFlux 81-day average of 10.7 cm solar radio flux, centered on the day
+     *          of the daily flux, in solar flux units.
+     * \param aGeomagneticIndex Daily planetary geomagnetic index Ap.
+     */
+    SolarActivity( const double aSolarFlux = 150.0, const double anAverageSolarFlux = 150.0,
+                   const double aGeomagneticIndex = 15.0 )
+        : solarFlux( aSolarFlux ),
+          averageSolarFlux( anAverageSolarFlux ),
+          geomagneticIndex( aGeomagneticIndex )
+    { }
+
+    //! Daily 10.7 cm solar radio flux, in solar flux units.
+    double solarFlux;
+
+    //! 81-day average of 10.7 cm solar radio flux, in solar flux units.
+    double averageSolarFlux;
+
+    //! Daily planetary geomagnetic index Ap.
+    double geomagneticIndex;
+};
+
+//! Typedef for function returning the solar and geomagnetic activity at a given time.
+/*!
+ * Typedef for function returning the solar and geomagnetic activity at a given time, in seconds
+ * since J2000. The function is responsible for any time lag of the indices; Jacchia (1971)
+ * recommends the solar flux of the previous day and the geomagnetic index of 6.7 hours before.
+ */
+typedef boost::function< SolarActivity( const double ) > SolarActivityFunction;
+
+//! Time-dependent terms of the empirical thermosphere.
+/*!
+ * Terms of the empirical thermosphere that depend only on time, computed once per epoch by
+ * EmpiricalThermosphere::computeEpochTerms.
+ */
+struct ThermosphereEpochTerms
+{
+    //! Time at which the terms are computed, in seconds since J2000.
+    double time;
+
+    //! Declination of the Sun.
+    double solarDeclination;
+
+    //! Hour angle of the Sun at zero longitude.
+    double solarHourAngleAtZeroLongitude;
+
+    //! Night-time minimum of the global exospheric temperature, including solar flux terms.
+    double nightTimeExosphericTemperature;
+
+    //! Increase of the exospheric temperature due to geomagnetic activity.
+    double geomagneticTemperatureIncrement;
+
+    //! Time-dependent factor of the semi-annual variation of log10 of the density.
+    double semiAnnualVariation;
+
+    //! Time-dependent factor of the seasonal-latitudinal variation of the lower thermosphere.
+    double seasonalLatitudinalVariation;
+
+    //! Amplitude of the seasonal-latitudinal variation of log10 of the helium density.
+    double heliumVariationAmplitude;
+};
+
+//! Empirical thermosphere class.
+/*!
+ * Empirical model of the Earth's thermosphere, of which the density depends on altitude,
+ * longitude, latitude and time, through the local solar time, the solar and geomagnetic
+ * activity, and the day of the year. The exospheric temperature is computed from the relations
+ * of Jacchia (1970, 1971), the temperature profile above 120 km is a Bates profile, and the
+ * densities of molecular nitrogen, molecular oxygen, atomic oxygen, argon and helium follow from
+ * diffusive equilibrium, as in the MSIS models. Below 120 km, the density and pressure decrease
+ * exponentially with the scale height of the US Standard Atmosphere 1976 between 100 and 120 km,
+ * and the temperature and composition are those at 120 km; the model is not intended for use
+ * below 120 km. Longitude and latitude are geocentric, in radians, and time is in seconds since
+ * J2000. The terms that depend only on time are cached, and reused for subsequent queries at the
+ * same time.
+ */
+class EmpiricalThermosphere : public AtmosphereModel
+{
+public:
+
+    //! Constructor with constant solar activity.
+    /*!
+     * Constructor with constant solar and geomagnetic activity.
+     * \param solarActivity Solar and geomagnetic activity.
+     */
+    explicit EmpiricalThermosphere( const SolarActivity& solarActivity = SolarActivity( ) );
+
+    //! Constructor with time-dependent solar activity.
+    /*!
+     * Constructor with time-dependent solar and geomagnetic activity.
+     * \param solarActivityFunction Function returning the solar and geomagnetic activity at a
+     *          given time, in seconds since J2000.
+     */
+    explicit EmpiricalThermosphere( const SolarActivityFunction& solarActivityFunction );
+
+    //! Get local density.
+    /*!
+     * Returns the local density of the atmosphere in kg per meter^3.
+     * \param altitude Altitude at which density is to be computed.
+     * \param longitude Longitude at which density is to be computed.
+     * \param latitude Latitude at which density is to be computed.
+     * \param time Time at which density is to be computed.
+     * \return Atmospheric density at specified location and time.
+     */
+    double getDensity( const double altitude, const double longitude, const double latitude,
+                       const double time )
+    {
+        return getAtmosphericProperties( altitude, longitude, latitude,
+                                         getEpochTerms( time ) ).density;
+    }
+
+    //! Get local pressure.
+    /*!
+     * Returns the local pressure of the atmosphere in Newton per meter^2.
+     * \param altitude Altitude at which pressure is to be computed.
+     * \param longitude Longitude at which pressure is to be computed.
+     * \param latitude Latitude at which pressure is to be computed.
+     * \param time Time at which pressure is to be computed.
+     * \return Atmospheric pressure at specified location and time.
+     */
+    double getPressure( const double altitude, const double longitude, const double latitude,
+                        const double time )
+    {
+        return getAtmosphericProperties( altitude, longitude, latitude,
+                                         getEpochTerms( time ) ).pressure;
+    }
+
+    //! Get local temperature.
+    /*!
+     * Returns the local temperature of the atmosphere in Kelvin.
+     * \param altitude Altitude at which temperature is to be computed.
+     * \param longitude Longitude at which temperature is to be computed.
+     * \param latitude Latitude at which temperature is to be computed.
+     * \param time Time at which temperature is to be computed.
+     * \return Atmospheric temperature at specified location and time.
+     */
+    double getTemperature( const double altitude, const double longitude, const double latitude,
+                           const double time )
+    {
+        return getAtmosphericProperties( altitude, longitude, latitude,
+                                         getEpochTerms( time ) ).temperature;
+    }
+
+    //! Get local density, pressure and temperature.
+    /*!
+     * Returns the local density, pressure and temperature of the atmosphere, which are computed
+     * together.
+     * \param altitude Altitude at which properties are to be computed.
+     * \param longitude Longitude at which properties are to be computed.
+     * \param latitude Latitude at which properties are to be computed.
+     * \param time Time at which properties are to be computed.
+     * \return Atmospheric density, pressure and temperature at specified location and time.
+     */
+    AtmosphericProperties getAtmosphericProperties( const double altitude,
+                                                    const double longitude,
+                                                    const double latitude,
+                                                    const double time )
+    {
+        return getAtmosphericProperties( altitude, longitude, latitude, getEpochTerms( time ) );
+    }
+
+    //! Get local densities at multiple points.
+    /*!
+     * Computes the local density of the atmosphere in kg per meter^3 at each of a number of
+     * points. The time-dependent terms are computed only when the time differs from that of the
+     * previous point, so points at equal times are best grouped together.
+     * \param altitudes Altitudes at which density is to be computed.
+     * \param longitudes Longitudes at which density is to be computed.
+     * \param latitudes Latitudes at which density is to be computed.
+     * \param times Times at which density is to be computed.
+     * \param densities Atmospheric densities at specified points (returned by reference).
+     */
+    void getDensities( const std::vector< double >& altitudes,
+                       const std::vector< double >& longitudes,
+                       const std::vector< double >& latitudes,
+                       const std::vector< double >& times,
+                       std::vector< double >& densities );
+
+    //! Get local density, pressure and temperature at multiple points.
+    /*!
+     * Computes the local density, pressure and temperature of the atmosphere at each of a number
+     * of points. The time-dependent terms are computed only when the time differs from that of
+     * the previous point, so points at equal times are best grouped together.
+     * \param altitudes Altitudes at which properties are to be computed.
+     * \param longitudes Longitudes at which properties are to be computed.
+     * \param latitudes Latitudes at which properties are to be computed.
+     * \param times Times at which properties are to be computed.
+     * \param densities Atmospheric densities at specified points (returned by reference).
+     * \param pressures Atmospheric pressures at specified points (returned by reference).
+     * \param temperatures Atmospheric temperatures at specified points (returned by reference).
+     */
+    void getAtmosphericProperties( const std::vector< double >& altitudes,
+                                   const std::vector< double >& longitudes,
+                                   const std::vector< double >& latitudes,
+                                   const std::vector< double >& times,
+                                   std::vector< double >& densities,
+                                   std::vector< double >& pressures,
+                                   std::vector< double >& temperatures );
+
+    //! Get local density, pressure and temperature with given time-dependent terms.
+    /*!
+     * Returns the local density, pressure and temperature of the atmosphere at the epoch of the
+     * given time-dependent terms. This function does not use the cache of the object, and can be
+     * called concurrently, with terms owned by the caller.
+     * \param altitude Altitude at which properties are to be computed.
+     * \param longitude Longitude at which properties are to be computed.
+     * \param latitude Latitude at which properties are to be computed.
+     * \param epochTerms Time-dependent terms, as computed by computeEpochTerms.
+     * \return Atmospheric density, pressure and temperature at specified location and epoch.
+     */
+    AtmosphericProperties getAtmosphericProperties( const double altitude,
+                                                    const double longitude,
+                                                    const double latitude,
+                                                    const ThermosphereEpochTerms& epochTerms )
+    const;
+
+    //! Compute time-dependent terms.
+    /*!
+     * Computes the terms of the model that depend only on time, including the evaluation of the
+     * solar activity function. Throws an exception if the solar activity is invalid.
+     * \param time Time at which terms are to be computed, in seconds since J2000.
+     * \return Time-dependent terms.
+     */
+    ThermosphereEpochTerms computeEpochTerms( const double time ) const;
+
+    //! Compute exospheric temperature.
+    /*!
+     * Computes the local exospheric temperature, from the global night-time temperature and the
+     * diurnal variation of Jacchia (1970), plus the geomagnetic temperature increment.
+     * \param longitude Longitude at which temperature is to be computed.
+     * \param latitude Latitude at which temperature is to be computed.
+     * \param epochTerms Time-dependent terms, as computed by computeEpochTerms.
+     * \return Exospheric temperature in Kelvin.
+     */
+    double computeExosphericTemperature( const double longitude, const double latitude,
+                                         const ThermosphereEpochTerms& epochTerms ) const;
+
+    //! Compute atmospheric properties in diffusive equilibrium.
+    /*!
+     * Computes the density, pressure and temperature at a given altitude of the Bates
+     * temperature profile with a given exospheric temperature, with each species in diffusive
+     * equilibrium above 120 km. This is the altitude profile of the model without the semi-annual
+     * and seasonal-latitudinal variations.
+     * \param altitude Altitude at which properties are to be computed.
+     * \param exosphericTemperature Exospheric temperature in Kelvin, larger than 360 K.
+     * \param heliumDensityFactor Factor by which the helium density is multiplied.
+     * \return Atmospheric density, pressure and temperature at specified altitude.
+     */
+    static AtmosphericProperties computeDiffusiveEquilibriumProperties(
+            const double altitude, const double exosphericTemperature,
+            const double heliumDensityFactor = 1.0 );
+
+protected:
+
+private:
+
+    //! Get time-dependent terms.
+    /*!
+     * Returns the time-dependent terms at the given time, which are only computed if the time
+     * differs from that of the previous call.
+     * \param time Time at which terms are to be returned, in seconds since J2000.
+     * \return Time-dependent terms.
+     */
+    const ThermosphereEpochTerms& getEpochTerms( const double time )
+    {
+        if ( !areEpochTermsCached_ || time != cachedEpochTerms_.time )
+        {
+            cachedEpochTerms_ = computeEpochTerms( time );
+            areEpochTermsCached_ = true;
+        }
+        return cachedEpochTerms_;
+    }
+
+    //! Function returning the solar and geomagnetic activity.
+    /*!
+     * Function returning the solar and geomagnetic activity at a given time, in seconds since
+     * J2000.
+     */
+    SolarActivityFunction solarActivityFunction_;
+
+    //! Time-dependent terms of the most recent query.
+    /*!
+     * Time-dependent terms of the most recent query, reused for queries at the same time.
+     */
+    ThermosphereEpochTerms cachedEpochTerms_;
+
+    //! Boolean denoting whether time-dependent terms are cached.
+    /*!
+     * Boolean denoting whether time-dependent terms are cached, false before the first query.
+     */
+    bool areEpochTermsCached_;
+};
+
+//! Typedef for shared-pointer to EmpiricalThermosphere object.
+typedef boost::shared_ptr< EmpiricalThermosphere > EmpiricalThermospherePointer;
+
+} // namespace aerodynamics
+} // namespace tudat
+
+#endif // TUDAT_EMPIRICAL_THERMOSPHERE_H
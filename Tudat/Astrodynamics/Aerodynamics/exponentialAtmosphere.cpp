@@ -29,6 +29,7 @@
  *      110427    F.M. Engelen      Changed input parameter to altitude, longitude and latitude.
  *      110629    F.M. Engelen      Added predefined feature.
  *      110705    F.M. Engelen      Changed to passing by reference. Changed reference values.
+ *      140326    S. Vermeer        Added queries at multiple points.
  *
  *    References
  *
@@ -39,6 +40,7 @@
  *
  */
 
+#include <cmath>
 #include <iostream>
 
 #include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
@@ -81,5 +83,42 @@ void ExponentialAtmosphere::setPredefinedExponentialAtmosphere(
     }
 }
 
+//! Get local densities at multiple points.
+void ExponentialAtmosphere::getDensities( const std::vector< double >& altitudes,
+                                          const std::vector< double >& longitudes,
+                                          const std::vector< double >& latitudes,
+                                          const std::vector< double >& times,
+                                          std::vector< double >& densities )
+{
+    checkInputSizes( altitudes, longitudes, latitudes, times );
+
+    const int numberOfPoints = static_cast< int >( altitudes.size( ) );
+    densities.resize( numberOfPoints );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        densities[ i ] = densityAtZeroAltitude_ * std::exp( -altitudes[ i ] / scaleHeight_ );
+    }
+}
+
+//! Get local density, pressure and temperature at multiple points.
+void ExponentialAtmosphere::getAtmosphericProperties( const std::vector< double >& altitudes,
+                                                      const std::vector< double >& longitudes,
+                                                      const std::vector< double >& latitudes,
+                                                      const std::vector< double >& times,
+                                                      std::vector< double >& densities,
+                                                      std::vector< double >& pressures,
+                                                      std::vector< double >& temperatures )
+{
+    getDensities( altitudes, longitudes, latitudes, times, densities );
+
+    const int numberOfPoints = static_cast< int >( altitudes.size( ) );
+    pressures.resize( numberOfPoints );
+    temperatures.assign( numberOfPoints, constantTemperature_ );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        pressures[ i ] = densities[ i ] * specificGasConstant_ * constantTemperature_;
+    }
+}
+
 } // namespace aerodynamics
 } // namespace tudat
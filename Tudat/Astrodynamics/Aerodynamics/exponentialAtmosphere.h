@@ -34,6 +34,8 @@
  *                                  typedef.
  *      140129    D. Dirkx          Changed Doxygen descriptions
  *      140130    T. Roegiers       Changed Doxygen descriptions
+ *      140319    S. Vermeer        Added combined query of density, pressure and temperature.
+ *      140326    S. Vermeer        Added queries at multiple points.
  *
  *    References
  *
@@ -47,6 +49,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <cmath>
+#include <vector>
 
 #include <TudatCore/Basics/utilityMacros.h>
 
@@ -228,6 +231,76 @@ public:
         return constantTemperature_;
     }
 
+    //! Get local density, pressure and temperature.
+    /*!
+     * Returns the local density, pressure and temperature of the atmosphere, evaluating the
+     * exponential function only once.
+     * \param altitude Altitude at which properties are to be computed.
+     * \param longitude Longitude at which properties are to be computed (not used but included
+     * for consistency with base class interface).
+     * \param latitude Latitude at which properties are to be computed (not used but included for
+     * consistency with base class interface).
+     * \param time Time at which properties are to be computed (not used but included for
+     * consistency with base class interface).
+     * \return Atmospheric density, pressure and temperature at specified altitude.
+     */
+    AtmosphericProperties getAtmosphericProperties( const double altitude,
+                                                    const double longitude = 0.0,
+                                                    const double latitude = 0.0,
+                                                    const double time = 0.0 )
+    {
+        TUDAT_UNUSED_PARAMETER( longitude );
+        TUDAT_UNUSED_PARAMETER( latitude );
+        TUDAT_UNUSED_PARAMETER( time );
+        const double density = getDensity( altitude );
+        return AtmosphericProperties( density,
+                                      density * specificGasConstant_ * constantTemperature_,
+                                      constantTemperature_ );
+    }
+
+    //! Get local densities at multiple points.
+    /*!
+     * Computes the local density of the atmosphere in kg per meter^3 at each of a number of
+     * points, in a single loop without function calls.
+     * \param altitudes Altitudes at which density is to be computed.
+     * \param longitudes Longitudes at which density is to be computed (not used but included for
+     * consistency with base class interface).
+     * \param latitudes Latitudes at which density is to be computed (not used but included for
+     * consistency with base class interface).
+     * \param times Times at which density is to be computed (not used but included for
+     * consistency with base class interface).
+     * \param densities Atmospheric densities at specified altitudes (returned by reference).
+     */
+    void getDensities( const std::vector< double >& altitudes,
+                       const std::vector< double >& longitudes,
+                       const std::vector< double >& latitudes,
+                       const std::vector< double >& times,
+                       std::vector< double >& densities );
+
+    //! Get local density, pressure and temperature at multiple points.
+    /*!
+     * Computes the local density, pressure and temperature of the atmosphere at each of a number
+     * of points, in a single loop without function calls.
+     * \param altitudes Altitudes at which properties are to be computed.
+     * \param longitudes Longitudes at which properties are to be computed (not used but included
+     * for consistency with base class interface).
+     * \param latitudes Latitudes at which properties are to be computed (not used but included
+     * for consistency with base class interface).
+     * \param times Times at which properties are to be computed (not used but included for
+     * consistency with base class interface).
+     * \param densities Atmospheric densities at specified altitudes (returned by reference).
+     * \param pressures Atmospheric pressures at specified altitudes (returned by reference).
+     * \param temperatures Atmospheric temperatures at specified altitudes (returned by
+     * reference).
+     */
+    void getAtmosphericProperties( const std::vector< double >& altitudes,
+                                   const std::vector< double >& longitudes,
+                                   const std::vector< double >& latitudes,
+                                   const std::vector< double >& times,
+                                   std::vector< double >& densities,
+                                   std::vector< double >& pressures,
+                                   std::vector< double >& temperatures );
+
 protected:
 
 private:
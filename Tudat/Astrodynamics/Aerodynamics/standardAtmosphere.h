@@ -28,16 +28,23 @@
  *      111211    K. Kumar          Minor corrections; corrected const-reference to by-value.
  *      130120    K. Kumar          Made function calls const-correct; added shared-pointer
  *                                  typedef.
+ *      140326    S. Vermeer        Added return type of getDensity; added queries at multiple
+ *                                  altitudes.
  *
  *    References
  *
  *    Notes
+ *      Since standard atmospheres only depend on altitude, the queries at multiple points only
+ *      require the altitudes. Derived classes can provide an efficient implementation of these
+ *      queries by overriding the altitude-only functions.
  *
  */
 
 #ifndef TUDAT_STANDARD_ATMOSPHERE_H
 #define TUDAT_STANDARD_ATMOSPHERE_H
 
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Astrodynamics/Aerodynamics/atmosphereModel.h"
@@ -66,8 +73,8 @@ public:
     * \param time Time.
     * \return Atmospheric density.
     */
-    virtual getDensity( const double altitude, const double longitude = 0.0,
-                        const double latitude = 0.0, const double time = 0.0 ) = 0;
+    virtual double getDensity( const double altitude, const double longitude = 0.0,
+                               const double latitude = 0.0, const double time = 0.0 ) = 0;
 
     //! Get local pressure.
     /*!
@@ -92,6 +99,100 @@ public:
     */
     virtual double getTemperature( const double altitude, const double longitude = 0.0,
                                    const double latitude = 0.0, const double time = 0.0 ) = 0;
+
+    //! Get local densities at multiple altitudes.
+    /*!
+    * Computes the local density of the atmosphere in kg-per-meter^3 at each of a number of
+    * altitudes. The default implementation calls getDensity for each altitude; derived classes
+    * should override this function to avoid a virtual function call per altitude.
+    * \param altitudes Altitudes.
+    * \param densities Atmospheric densities, one per altitude (returned by reference).
+    */
+    virtual void getDensities( const std::vector< double >& altitudes,
+                               std::vector< double >& densities )
+    {
+        densities.resize( altitudes.size( ) );
+        for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+        {
+            densities[ i ] = getDensity( altitudes[ i ] );
+        }
+    }
+
+    //! Get local densities at multiple points.
+    /*!
+    * Computes the local density of the atmosphere in kg-per-meter^3 at each of a number of
+    * points. Since the density only depends on altitude, the longitudes, latitudes and times are
+    * only checked for consistency, after which the altitude-only function is called.
+    * \param altitudes Altitudes.
+    * \param longitudes Longitudes.
+    * \param latitudes Latitudes.
+    * \param times Times.
+    * \param densities Atmospheric densities, one per point (returned by reference).
+    */
+    void getDensities( const std::vector< double >& altitudes,
+                       const std::vector< double >& longitudes,
+                       const std::vector< double >& latitudes,
+                       const std::vector< double >& times,
+                       std::vector< double >& densities )
+    {
+        checkInputSizes( altitudes, longitudes, latitudes, times );
+        getDensities( altitudes, densities );
+    }
+
+    //! Get local density, pressure and temperature at multiple altitudes.
+    /*!
+    * Computes the local density, pressure and temperature of the atmosphere at each of a number
+    * of altitudes. The default implementation calls the individual get functions for each
+    * altitude; derived classes should override this function to avoid virtual function calls
+    * per altitude.
+    * \param altitudes Altitudes.
+    * \param densities Atmospheric densities, one per altitude (returned by reference).
+    * \param pressures Atmospheric pressures, one per altitude (returned by reference).
+    * \param temperatures Atmospheric temperatures, one per altitude (returned by reference).
+    */
+    virtual void getAtmosphericProperties( const std::vector< double >& altitudes,
+                                           std::vector< double >& densities,
+                                           std::vector< double >& pressures,
+                                           std::vector< double >& temperatures )
+    {
+        densities.resize( altitudes.size( ) );
+        pressures.resize( altitudes.size( ) );
+        temperatures.resize( altitudes.size( ) );
+        for ( unsigned int i = 0; i < altitudes.size( ); i++ )
+        {
+            densities[ i ] = getDensity( altitudes[ i ] );
+            pressures[ i ] = getPressure( altitudes[ i ] );
+            temperatures[ i ] = getTemperature( altitudes[ i ] );
+        }
+    }
+
+    //! Get local density, pressure and temperature at multiple points.
+    /*!
+    * Computes the local density, pressure and temperature of the atmosphere at each of a number
+    * of points. Since the properties only depend on altitude, the longitudes, latitudes and
+    * times are only checked for consistency, after which the altitude-only function is called.
+    * \param altitudes Altitudes.
+    * \param longitudes Longitudes.
+    * \param latitudes Latitudes.
+    * \param times Times.
+    * \param densities Atmospheric densities, one per point (returned by reference).
+    * \param pressures Atmospheric pressures, one per point (returned by reference).
+    * \param temperatures Atmospheric temperatures, one per point (returned by reference).
+    */
+    void getAtmosphericProperties( const std::vector< double >& altitudes,
+                                   const std::vector< double >& longitudes,
+                                   const std::vector< double >& latitudes,
+                                   const std::vector< double >& times,
+                                   std::vector< double >& densities,
+                                   std::vector< double >& pressures,
+                                   std::vector< double >& temperatures )
+    {
+        checkInputSizes( altitudes, longitudes, latitudes, times );
+        getAtmosphericProperties( altitudes, densities, pressures, temperatures );
+    }
+
+    // Statement required to prevent hiding of base class function.
+    using AtmosphereModel::getAtmosphericProperties;
 };
 
 //! Typedef for shared-pointer to StandardAtmosphere object.
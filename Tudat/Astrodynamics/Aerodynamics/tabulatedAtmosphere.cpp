@@ -27,6 +27,11 @@
  *      110620    F.M. Engelen      File created.
  *      110721    J. Melman         Comments, variable names, and consistency modified.
  *      110722    F.M. Engelen      Removed setRelativePath function.
+ *      140307    S. Vermeer        Added tracing of atmosphere table parsing.
+ *      140319    S. Vermeer        Replaced separate splines by single vector-valued spline.
+ *      140326    S. Vermeer        Added queries at multiple points.
+ *      140415    S. Vermeer        Precomputed polynomial coefficients of spline.
+ *      140415    S. Vermeer        Wrote queries at multiple points directly to output vectors.
  *
  *    References
  *
@@ -41,15 +46,87 @@
 #include <TudatCore/InputOutput/matrixTextFileReader.h>
 
 #include "Tudat/Astrodynamics/Aerodynamics/tabulatedAtmosphere.h"
+#include "Tudat/Basics/tracing.h"
 
 namespace tudat
 {
 namespace aerodynamics
 {
 
+namespace
+{
+
+//! Writer of interpolated densities.
+/*!
+ * Writer of interpolated atmospheric properties to (correctly sized) vector of densities, used
+ * for batch interpolation of the atmosphere table.
+ */
+class DensityWriter
+{
+public:
+
+    //! Constructor.
+    explicit DensityWriter( std::vector< double >* someDensities )
+        : densities( someDensities )
+    { }
+
+    //! Write density of interpolated atmospheric properties at given index.
+    void operator( )( const int index, const Eigen::Vector3d& properties ) const
+    {
+        ( *densities )[ index ] = properties( 0 );
+    }
+
+private:
+
+    //! Vector of densities.
+    std::vector< double >* densities;
+};
+
+//! Writer of interpolated densities, pressures and temperatures.
+/*!
+ * Writer of interpolated atmospheric properties to (correctly sized) vectors of densities,
+ * pressures and temperatures, used for batch interpolation of the atmosphere table.
+ */
+class AtmosphericPropertiesWriter
+{
+public:
+
+    //! Constructor.
+    AtmosphericPropertiesWriter( std::vector< double >* someDensities,
+                                 std::vector< double >* somePressures,
+                                 std::vector< double >* someTemperatures )
+        : densities( someDensities ),
+          pressures( somePressures ),
+          temperatures( someTemperatures )
+    { }
+
+    //! Write interpolated atmospheric properties at given index.
+    void operator( )( const int index, const Eigen::Vector3d& properties ) const
+    {
+        ( *densities )[ index ] = properties( 0 );
+        ( *pressures )[ index ] = properties( 1 );
+        ( *temperatures )[ index ] = properties( 2 );
+    }
+
+private:
+
+    //! Vector of densities.
+    std::vector< double >* densities;
+
+    //! Vector of pressures.
+    std::vector< double >* pressures;
+
+    //! Vector of temperatures.
+    std::vector< double >* temperatures;
+};
+
+} // namespace
+
 //! Initialize atmosphere table reader.
 void TabulatedAtmosphere::initialize( std::string atmosphereTableFile )
 {
+    TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::initialize" );
+
     // Locally store the atmosphere table file name.
     atmosphereTableFile_ = atmosphereTableFile;
 
@@ -66,29 +143,59 @@ void TabulatedAtmosphere::initialize( std::string atmosphereTableFile )
 
     // Initialize vectors.
     altitudeData_.resize( containerOfAtmosphereTableFileData.rows( ) );
-    densityData_.resize( containerOfAtmosphereTableFileData.rows( ) );
-    pressureData_.resize( containerOfAtmosphereTableFileData.rows( ) );
-    temperatureData_.resize( containerOfAtmosphereTableFileData.rows( ) );
+    atmosphericPropertiesData_.resize( containerOfAtmosphereTableFileData.rows( ) );
 
     // Loop through all the strings stored in the container and store the data
     // in the right Eigen::VectorXd.
     for ( int i = 0; i < containerOfAtmosphereTableFileData.rows( ); i++  )
     {
         altitudeData_[ i ] = containerOfAtmosphereTableFileData( i, 0 );
-        densityData_[ i ] = containerOfAtmosphereTableFileData( i, 1 );
-        pressureData_[ i ] = containerOfAtmosphereTableFileData( i, 2 );
-        temperatureData_[ i ] = containerOfAtmosphereTableFileData( i, 3 );
+        atmosphericPropertiesData_[ i ] =
+                containerOfAtmosphereTableFileData.block( i, 1, 1, 3 ).transpose( );
     }
 
-    using namespace interpolators;
+    // Create single spline for density, pressure and temperature, sharing one look-up scheme,
+    // with precomputed polynomial coefficients.
+    cubicSplineInterpolationForProperties_
+            = boost::make_shared< interpolators::CubicSplineInterpolator< double,
+            Eigen::Vector3d > >( altitudeData_, atmosphericPropertiesData_,
+                                 interpolators::huntingAlgorithm, true );
+}
+
+//! Get local densities at multiple points.
+void TabulatedAtmosphere::getDensities( const std::vector< double >& altitudes,
+                                        const std::vector< double >& longitudes,
+                                        const std::vector< double >& latitudes,
+                                        const std::vector< double >& times,
+                                        std::vector< double >& densities )
+{
+    TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getDensities" );
+    checkInputSizes( altitudes, longitudes, latitudes, times );
+
+    // Interpolate all properties at once, and write density directly to output vector.
+    densities.resize( altitudes.size( ) );
+    cubicSplineInterpolationForProperties_->interpolateBatchAndWrite(
+                altitudes, DensityWriter( &densities ) );
+}
+
+//! Get local density, pressure and temperature at multiple points.
+void TabulatedAtmosphere::getAtmosphericProperties( const std::vector< double >& altitudes,
+                                                    const std::vector< double >& longitudes,
+                                                    const std::vector< double >& latitudes,
+                                                    const std::vector< double >& times,
+                                                    std::vector< double >& densities,
+                                                    std::vector< double >& pressures,
+                                                    std::vector< double >& temperatures )
+{
+    TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getAtmosphericProperties" );
+    checkInputSizes( altitudes, longitudes, latitudes, times );
 
-    cubicSplineInterpolationForDensity_
-            = boost::make_shared< CubicSplineInterpolatorDouble >( altitudeData_, densityData_ );
-    cubicSplineInterpolationForPressure_
-            = boost::make_shared< CubicSplineInterpolatorDouble >( altitudeData_, pressureData_ );
-    cubicSplineInterpolationForTemperature_
-            = boost::make_shared< CubicSplineInterpolatorDouble >(
-                altitudeData_, temperatureData_ );
+    // Interpolate all properties at once, and write them directly to output vectors.
+    densities.resize( altitudes.size( ) );
+    pressures.resize( altitudes.size( ) );
+    temperatures.resize( altitudes.size( ) );
+    cubicSplineInterpolationForProperties_->interpolateBatchAndWrite(
+                altitudes, AtmosphericPropertiesWriter( &densities, &pressures, &temperatures ) );
 }
 
 } // namespace aerodynamics
@@ -28,6 +28,12 @@
  *      110721    J. Melman         Comments, file names, and consistency modified.
  *      130120    K. Kumar          Made function calls const-correct; added shared-pointer
  *                                  typedef.
+ *      140307    S. Vermeer        Added tracing of atmosphere queries.
+ *      140312    S. Vermeer        Added thread-safe queries with caller-owned look-up cursor.
+ *      140319    S. Vermeer        Replaced separate splines by single vector-valued spline; added
+ *                                  combined query of density, pressure and temperature.
+ *      140326    S. Vermeer        Added queries at multiple points.
+ *      140415    S. Vermeer        Precomputed polynomial coefficients of spline.
  *
  *    References
  *
@@ -35,6 +41,16 @@
  *      The provided USSA1976 table file, generated with the pascal file, has a small error which
  *      can be observed at the pressure at sea level. This in 101320 in the file but should be
  *      101325. If this error is not acceptable, another table file should be used.
+ *      The queries taking a look-up cursor do not modify the atmosphere, so that a single
+ *      (initialized) atmosphere can be shared between threads, each of which uses its own cursor.
+ *      Since all properties are tabulated at the same altitudes, density, pressure and
+ *      temperature are interpolated with a single vector-valued cubic spline, such that one
+ *      look-up per query suffices. The polynomial coefficients of the spline are precomputed, so
+ *      that a query only evaluates the cubic polynomial of its interval. Each of the component
+ *      splines is identical to the cubic spline of that property alone. The
+ *      getAtmosphericProperties functions return all three properties from a single
+ *      interpolation. The queries at multiple points interpolate all points in a single batch
+ *      interpolation, which gives results identical to those of the single-point queries.
  *
  */
 
@@ -42,6 +58,7 @@
 #define TUDAT_TABULATED_ATMOSPHERE_H
 
 #include <string>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 
@@ -50,6 +67,7 @@
 #include <TudatCore/Basics/utilityMacros.h>
 
 #include "Tudat/Astrodynamics/Aerodynamics/atmosphereModel.h"
+#include "Tudat/Basics/tracing.h"
 #include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
 
 namespace tudat
@@ -113,7 +131,24 @@ public:
         TUDAT_UNUSED_PARAMETER( longitude );
         TUDAT_UNUSED_PARAMETER( latitude );
         TUDAT_UNUSED_PARAMETER( time );
-        return cubicSplineInterpolationForDensity_->interpolate( altitude );
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getDensity" );
+        return cubicSplineInterpolationForProperties_->interpolate( altitude )( 0 );
+    }
+
+    //! Get local density using caller-owned look-up cursor.
+    /*!
+     * Returns the local density of the atmosphere, using and updating the state of previous
+     * look-ups stored in the given cursor. This function may be called concurrently from multiple
+     * threads with distinct cursors.
+     * \param altitude Altitude.
+     * \param lookUpCursor State of previous look-ups in altitude table, updated by this function.
+     * \return Atmospheric density.
+     */
+    double getDensity( const double altitude, interpolators::LookUpCursor& lookUpCursor ) const
+    {
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getDensity" );
+        return cubicSplineInterpolationForProperties_->interpolate( altitude, lookUpCursor )(
+                    0 );
     }
 
     //! Get local pressure.
@@ -131,7 +166,24 @@ public:
         TUDAT_UNUSED_PARAMETER( longitude );
         TUDAT_UNUSED_PARAMETER( latitude );
         TUDAT_UNUSED_PARAMETER( time );
-        return cubicSplineInterpolationForPressure_->interpolate( altitude );
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getPressure" );
+        return cubicSplineInterpolationForProperties_->interpolate( altitude )( 1 );
+    }
+
+    //! Get local pressure using caller-owned look-up cursor.
+    /*!
+     * Returns the local pressure of the atmosphere, using and updating the state of previous
+     * look-ups stored in the given cursor. This function may be called concurrently from multiple
+     * threads with distinct cursors.
+     * \param altitude Altitude.
+     * \param lookUpCursor State of previous look-ups in altitude table, updated by this function.
+     * \return Atmospheric pressure.
+     */
+    double getPressure( const double altitude, interpolators::LookUpCursor& lookUpCursor ) const
+    {
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getPressure" );
+        return cubicSplineInterpolationForProperties_->interpolate( altitude, lookUpCursor )(
+                    1 );
     }
 
     //! Get local temperature.
@@ -149,66 +201,141 @@ public:
         TUDAT_UNUSED_PARAMETER( longitude );
         TUDAT_UNUSED_PARAMETER( latitude );
         TUDAT_UNUSED_PARAMETER( time );
-        return cubicSplineInterpolationForTemperature_->interpolate( altitude );
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getTemperature" );
+        return cubicSplineInterpolationForProperties_->interpolate( altitude )( 2 );
     }
 
-protected:
-
-private:
+    //! Get local temperature using caller-owned look-up cursor.
+    /*!
+     * Returns the local temperature of the atmosphere, using and updating the state of previous
+     * look-ups stored in the given cursor. This function may be called concurrently from multiple
+     * threads with distinct cursors.
+     * \param altitude Altitude.
+     * \param lookUpCursor State of previous look-ups in altitude table, updated by this function.
+     * \return Atmospheric temperature.
+     */
+    double getTemperature( const double altitude, interpolators::LookUpCursor& lookUpCursor ) const
+    {
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getTemperature" );
+        return cubicSplineInterpolationForProperties_->interpolate( altitude, lookUpCursor )(
+                    2 );
+    }
 
-    //! The relative directory path.
+    //! Get local density, pressure and temperature.
     /*!
-     *  The relative path directory path.
+     * Returns the local density, pressure and temperature of the atmosphere, using a single
+     * look-up in the altitude table.
+     * \param altitude Altitude.
+     * \param longitude Longitude.
+     * \param latitude Latitude.
+     * \param time Time.
+     * \return Atmospheric density, pressure and temperature.
      */
-    std::string relativeDirectoryPath_;
+    AtmosphericProperties getAtmosphericProperties( const double altitude,
+                                                    const double longitude = 0.0,
+                                                    const double latitude = 0.0,
+                                                    const double time = 0.0 )
+    {
+        TUDAT_UNUSED_PARAMETER( longitude );
+        TUDAT_UNUSED_PARAMETER( latitude );
+        TUDAT_UNUSED_PARAMETER( time );
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getAtmosphericProperties" );
+        const Eigen::Vector3d properties =
+                cubicSplineInterpolationForProperties_->interpolate( altitude );
+        return AtmosphericProperties( properties( 0 ), properties( 1 ), properties( 2 ) );
+    }
 
-    //! The file name of the atmosphere table.
+    //! Get local density, pressure and temperature using caller-owned look-up cursor.
     /*!
-     *  The file name of the atmosphere table.
+     * Returns the local density, pressure and temperature of the atmosphere, using a single
+     * look-up in the altitude table, and using and updating the state of previous look-ups stored
+     * in the given cursor. This function may be called concurrently from multiple threads with
+     * distinct cursors.
+     * \param altitude Altitude.
+     * \param lookUpCursor State of previous look-ups in altitude table, updated by this function.
+     * \return Atmospheric density, pressure and temperature.
      */
-    std::string atmosphereTableFile_;
+    AtmosphericProperties getAtmosphericProperties(
+            const double altitude, interpolators::LookUpCursor& lookUpCursor ) const
+    {
+        TUDAT_TRACE_SCOPE( "Aerodynamics", "TabulatedAtmosphere::getAtmosphericProperties" );
+        const Eigen::Vector3d properties =
+                cubicSplineInterpolationForProperties_->interpolate( altitude, lookUpCursor );
+        return AtmosphericProperties( properties( 0 ), properties( 1 ), properties( 2 ) );
+    }
 
-    //! Vector containing the altitude.
+    //! Get local densities at multiple points.
     /*!
-     *  Vector containing the altitude.
+     * Computes the local density of the atmosphere at each of a number of points, using a single
+     * batch interpolation in the altitude table. This function does not modify the atmosphere,
+     * and may be called concurrently from multiple threads.
+     * \param altitudes Altitudes.
+     * \param longitudes Longitudes (not used).
+     * \param latitudes Latitudes (not used).
+     * \param times Times (not used).
+     * \param densities Atmospheric densities, one per point (returned by reference).
      */
-    std::vector< double > altitudeData_;
+    void getDensities( const std::vector< double >& altitudes,
+                       const std::vector< double >& longitudes,
+                       const std::vector< double >& latitudes,
+                       const std::vector< double >& times,
+                       std::vector< double >& densities );
 
-    //! Vector containing the density data as a function of the altitude.
+    //! Get local density, pressure and temperature at multiple points.
     /*!
-     *  Vector containing the density data as a function of the altitude.
+     * Computes the local density, pressure and temperature of the atmosphere at each of a number
+     * of points, using a single batch interpolation in the altitude table. This function does not
+     * modify the atmosphere, and may be called concurrently from multiple threads.
+     * \param altitudes Altitudes.
+     * \param longitudes Longitudes (not used).
+     * \param latitudes Latitudes (not used).
+     * \param times Times (not used).
+     * \param densities Atmospheric densities, one per point (returned by reference).
+     * \param pressures Atmospheric pressures, one per point (returned by reference).
+     * \param temperatures Atmospheric temperatures, one per point (returned by reference).
      */
-    std::vector< double > densityData_;
+    void getAtmosphericProperties( const std::vector< double >& altitudes,
+                                   const std::vector< double >& longitudes,
+                                   const std::vector< double >& latitudes,
+                                   const std::vector< double >& times,
+                                   std::vector< double >& densities,
+                                   std::vector< double >& pressures,
+                                   std::vector< double >& temperatures );
+
+protected:
 
-    //! Vector containing the pressure data as a function of the altitude.
+private:
+
+    //! The relative directory path.
     /*!
-     *  Vector containing the pressure data as a function of the altitude.
+     *  The relative path directory path.
      */
-    std::vector< double > pressureData_;
+    std::string relativeDirectoryPath_;
 
-    //! Vector containing the temperature data as a function of the altitude.
+    //! The file name of the atmosphere table.
     /*!
-     *  Vector containing the temperature data as a function of the altitude.
+     *  The file name of the atmosphere table.
      */
-    std::vector< double > temperatureData_;
+    std::string atmosphereTableFile_;
 
-    //! Cubic spline interpolation for density.
+    //! Vector containing the altitude.
     /*!
-     *  Cubic spline interpolation for density.
+     *  Vector containing the altitude.
      */
-    interpolators::CubicSplineInterpolatorDoublePointer cubicSplineInterpolationForDensity_;
+    std::vector< double > altitudeData_;
 
-    //! Cubic spline interpolation for pressure.
+    //! Vector containing the density, pressure and temperature as a function of the altitude.
     /*!
-     *  Cubic spline interpolation for pressure.
+     *  Vector containing the density, pressure and temperature as a function of the altitude.
      */
-    interpolators::CubicSplineInterpolatorDoublePointer cubicSplineInterpolationForPressure_;
+    std::vector< Eigen::Vector3d > atmosphericPropertiesData_;
 
-    //! Cubic spline interpolation for temperature.
+    //! Cubic spline interpolation for density, pressure and temperature.
     /*!
-     *  Cubic spline interpolation for temperature.
+     *  Cubic spline interpolation for density, pressure and temperature (in that order).
      */
-    interpolators::CubicSplineInterpolatorDoublePointer cubicSplineInterpolationForTemperature_;
+    boost::shared_ptr< interpolators::CubicSplineInterpolator< double, Eigen::Vector3d > >
+    cubicSplineInterpolationForProperties_;
 };
 
 //! Typedef for shared-pointer to TabulatedAtmosphere object.
@@ -41,6 +41,7 @@
  *      120903    P. Musegaas       Removed modulo option, due to errors with it. Kepler propagator
  *                                  now simply return true anomaly in -PI to PI spectrum.
  *      121205    P. Musegaas       Updated code to final version of rootfinders.
+ *      140228    S. Vermeer        Replaced dynamic-size final state by fixed-size state.
  *
  *    References
  *
@@ -94,7 +95,7 @@ basic_mathematics::Vector6d propagateKeplerOrbit(
     using tudat::orbital_element_conversions::trueAnomalyIndex;
 
     // Create final state in Keplerian elements.
-    Eigen::VectorXd finalStateInKeplerianElements = initialStateInKeplerianElements;
+    basic_mathematics::Vector6d finalStateInKeplerianElements = initialStateInKeplerianElements;
 
     // Check if eccentricity is valid.
     if ( initialStateInKeplerianElements( eccentricityIndex ) < 0.0 )
@@ -30,6 +30,8 @@
  *      131106    J. Geul           Code-check, fixed typos.
  *      131109    K. Kumar          Updated unit test tolerances, added unit tests for class 
  *                                  implementation of acceleration model.
+ *      140221    S. Vermeer        Added unit test for partial derivatives computed using
+ *                                  automatic differentiation.
  *
  *    References
  *      Ganeff, M.I. Solar radiation pressure benchmark data script,
@@ -54,6 +56,7 @@
 #include <cmath>
 #include <limits>
 
+#include <boost/lambda/lambda.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
@@ -64,6 +67,7 @@
 
 #include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureForce.h"
 #include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
+#include "Tudat/Mathematics/BasicMathematics/automaticDifferentiation.h"
 
 namespace tudat
 {
@@ -522,6 +526,75 @@ BOOST_AUTO_TEST_CASE( testRadiationPressureAccelerationModelClassUpdateMembers )
                                        1.0e-14 );      
 }
 
+//! Test radiation pressure acceleration model partial derivatives using automatic
+//! differentiation.
+BOOST_AUTO_TEST_CASE( testRadiationPressureAccelerationModelClassPartialDerivatives )
+{
+    using basic_mathematics::AutoDiffScalar3d;
+    using basic_mathematics::getPartialDerivatives;
+    using basic_mathematics::getValues;
+    using electro_magnetism::CannonBallRadiationPressureTemplate;
+
+    // Typedef for vector of automatic differentiation scalars.
+    typedef Eigen::Matrix< AutoDiffScalar3d, 3, 1 > AutoDiffVector3d;
+
+    // Set radiation pressure coefficient, area [m^2] and mass [kg].
+    const double radiationPressureCoefficient = 1.2;
+    const double area = 2.0;
+    const double mass = 4.0;
+
+    // Set positions of source and accelerated body [m].
+    const Eigen::Vector3d sourcePosition = Eigen::Vector3d::Zero( );
+    const Eigen::Vector3d acceleratedBodyPosition( astronomicalUnitInMeters, 0.0, 0.0 );
+
+    // Declare and initialize cannon-ball radiation pressure acceleration model, with radiation
+    // pressure coefficient, area and mass as independent variables.
+    CannonBallRadiationPressureTemplate< AutoDiffVector3d > radiationPressureModel(
+        boost::lambda::constant( AutoDiffVector3d( sourcePosition.cast< AutoDiffScalar3d >( ) ) ),
+        boost::lambda::constant(
+            AutoDiffVector3d( acceleratedBodyPosition.cast< AutoDiffScalar3d >( ) ) ),
+        boost::lambda::constant( AutoDiffScalar3d( radiationPressureAtOneAU ) ),
+        AutoDiffScalar3d( radiationPressureCoefficient, 3, 0 ),
+        AutoDiffScalar3d( area, 3, 1 ),
+        AutoDiffScalar3d( mass, 3, 2 ) );
+
+    // Compute radiation pressure acceleration [m/s^2].
+    radiationPressureModel.updateMembers( );
+    const AutoDiffVector3d computedRadiationPressureAcceleration
+        = radiationPressureModel.getAcceleration( );
+
+    // Compute expected radiation pressure acceleration [m/s^2].
+    const Eigen::Vector3d expectedRadiationPressureAcceleration
+        = electro_magnetism::computeCannonBallRadiationPressureAcceleration(
+            radiationPressureAtOneAU, Eigen::Vector3d( -1.0, 0.0, 0.0 ), area,
+            radiationPressureCoefficient, mass );
+
+    // Set expected partial derivatives w.r.t. radiation pressure coefficient, area and mass; the
+    // acceleration is linear in the first two and inversely proportional to the latter.
+    Eigen::Matrix3d expectedPartialDerivatives;
+    expectedPartialDerivatives.col( 0 )
+        = expectedRadiationPressureAcceleration / radiationPressureCoefficient;
+    expectedPartialDerivatives.col( 1 ) = expectedRadiationPressureAcceleration / area;
+    expectedPartialDerivatives.col( 2 ) = -expectedRadiationPressureAcceleration / mass;
+
+    // Compare computed and expected values and partial derivatives.
+    const Eigen::Matrix3d computedPartialDerivatives
+        = getPartialDerivatives( computedRadiationPressureAcceleration );
+    BOOST_CHECK_CLOSE_FRACTION( getValues( computedRadiationPressureAcceleration ).x( ),
+                                expectedRadiationPressureAcceleration.x( ),
+                                std::numeric_limits< double >::epsilon( ) );
+    for ( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( computedPartialDerivatives( 0, i ),
+                                    expectedPartialDerivatives( 0, i ),
+                                    std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_SMALL( computedPartialDerivatives( 1, i ),
+                           std::numeric_limits< double >::min( ) );
+        BOOST_CHECK_SMALL( computedPartialDerivatives( 2, i ),
+                           std::numeric_limits< double >::min( ) );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
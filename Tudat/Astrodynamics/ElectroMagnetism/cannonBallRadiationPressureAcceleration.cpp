@@ -28,6 +28,8 @@
  *      130124    K. Kumar          Added missing file header; updated layout; migrated force
  *                                  free function to separate file; added acceleration free
  *                                  function.
+ *      140221    S. Vermeer        Acceleration now uses scalar-type template; moved class
+ *                                  function implementations to header file.
  *
  *    References
  *
@@ -53,27 +55,8 @@ Eigen::Vector3d computeCannonBallRadiationPressureAcceleration(
         const double radiationPressureCoefficient,
         const double mass )
 {
-    return computeCannonBallRadiationPressureForce(
-                radiationPressure, vectorToSource, area, radiationPressureCoefficient ) / mass;
-}
-
-//! Get radiation pressure acceleration.
-Eigen::Vector3d CannonBallRadiationPressure::getAcceleration( )
-{
-    return computeCannonBallRadiationPressureAcceleration(
-                currentRadiationPressure_, currentVectorToSource_, currentArea_,
-                currentRadiationPressureCoefficient_, currentMass_ );
-}
-
-//! Update member variables used by the radiation pressure acceleration model.
-void CannonBallRadiationPressure::updateMembers( )
-{
-    currentVectorToSource_ = ( sourcePositionFunction_( )
-                               - acceleratedBodyPositionFunction_( ) ).normalized( );
-    currentRadiationPressure_ = radiationPressureFunction_( );
-    currentRadiationPressureCoefficient_ = radiationPressureCoefficientFunction_( );
-    currentArea_ = areaFunction_( );
-    currentMass_ = massFunction_( );
+    return computeCannonBallRadiationPressureAccelerationTemplate< double >(
+                radiationPressure, vectorToSource, area, radiationPressureCoefficient, mass );
 }
 
 } // namespace electro_magnetism
@@ -28,6 +28,12 @@
  *      130124    K. Kumar          Added missing file header; updated layout; migrated force
  *                                  free function to separate file; added acceleration free
  *                                  function; added missing Doxygen comments.
+ *      140221    S. Vermeer        Added scalar-type template of acceleration; made class a
+ *                                  template on acceleration data type, to allow automatic
+ *                                  differentiation scalars.
+ *      140401    S. Vermeer        Renamed class template and scalar-type template of acceleration;
+ *                                  restored CannonBallRadiationPressure as typedef of
+ *                                  double-precision model, so that existing code is unaffected.
  *
  *    References
  *      Eigen. Structures having Eigen members,
@@ -83,20 +89,55 @@ Eigen::Vector3d computeCannonBallRadiationPressureAcceleration(
         const double radiationPressureCoefficient,
         const double mass );
 
-//! Cannon-ball Radiation pressure acceleration model class.
+//! Compute radiation pressure acceleration using a cannon-ball model for arbitrary scalar type.
 /*!
- * Class that can be used to compute the radiation pressure using a cannon-ball model, i.e.,
- * assuming force to be in opposite direction of the vector to the source.
+ * Computes radiation pressure acceleration using a cannon-ball model, as described for the
+ * double-precision computeCannonBallRadiationPressureAcceleration() function, for an arbitrary
+ * scalar type (for instance an automatic differentiation scalar).
+ * \tparam ScalarType Scalar type used for all input parameters and the acceleration.
+ * \param radiationPressure Radiation pressure at target.                                  [N/m^2]
+ * \param vectorToSource Unit vector pointing from target to source.                           [-]
+ * \param area Area on which radiation pressure is assumed to act.                            [m^2]
+ * \param radiationPressureCoefficient Coefficient to scale effective force.                    [-]
+ * \param mass Mass of accelerated body.                                                       [kg]
+ * \return Acceleration due to radiation pressure.                                          [m/s^2]
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeCannonBallRadiationPressureAccelerationTemplate(
+        const ScalarType& radiationPressure,
+        const Eigen::Matrix< ScalarType, 3, 1 >& vectorToSource,
+        const ScalarType& area,
+        const ScalarType& radiationPressureCoefficient,
+        const ScalarType& mass )
+{
+    return computeCannonBallRadiationPressureForceTemplate(
+                radiationPressure, vectorToSource, area, radiationPressureCoefficient ) / mass;
+}
+
+//! Cannon-ball Radiation pressure acceleration model class template.
+/*!
+ * Class template that can be used to compute the radiation pressure using a cannon-ball model,
+ * i.e., assuming force to be in opposite direction of the vector to the source, for an arbitrary
+ * acceleration data type (for instance one with automatic differentiation scalars). The
+ * double-precision model is available as CannonBallRadiationPressure.
+ * \tparam AccelerationDataType Data type used to represent positions and accelerations
+ *          (default = Eigen::Vector3d). Its scalar type is also used for the radiation pressure,
+ *          radiation pressure coefficient, area and mass.
  */
-class CannonBallRadiationPressure : public basic_astrodynamics::AccelerationModel3d
+template< typename AccelerationDataType = Eigen::Vector3d >
+class CannonBallRadiationPressureTemplate
+        : public basic_astrodynamics::AccelerationModel< AccelerationDataType >
 {
 private:
 
-    //! Typedef for double-returning function.
-    typedef boost::function< double( ) > DoubleReturningFunction;
+    //! Typedef for scalar type of acceleration data type.
+    typedef typename AccelerationDataType::Scalar ScalarType;
 
-    //! Typedef for Eigen::Vector3d-returning function.
-    typedef boost::function< Eigen::Vector3d( ) > Vector3dReturningFunction;
+    //! Typedef for scalar-returning function.
+    typedef boost::function< ScalarType( ) > ScalarReturningFunction;
+
+    //! Typedef for vector-returning function.
+    typedef boost::function< AccelerationDataType( ) > VectorReturningFunction;
 
 public:
 
@@ -115,13 +156,13 @@ public:
      * \param areaFunction Function returning current area assumed to undergo radiation pressure.
      * \param massFunction Function returning current mass of body undergoing acceleration.
      */
-    CannonBallRadiationPressure(
-            Vector3dReturningFunction sourcePositionFunction,
-            Vector3dReturningFunction acceleratedBodyPositionFunction,
-            DoubleReturningFunction radiationPressureFunction,
-            DoubleReturningFunction radiationPressureCoefficientFunction,
-            DoubleReturningFunction areaFunction,
-            DoubleReturningFunction massFunction )
+    CannonBallRadiationPressureTemplate(
+            VectorReturningFunction sourcePositionFunction,
+            VectorReturningFunction acceleratedBodyPositionFunction,
+            ScalarReturningFunction radiationPressureFunction,
+            ScalarReturningFunction radiationPressureCoefficientFunction,
+            ScalarReturningFunction areaFunction,
+            ScalarReturningFunction massFunction )
         : sourcePositionFunction_( sourcePositionFunction ),
           acceleratedBodyPositionFunction_( acceleratedBodyPositionFunction ),
           radiationPressureFunction_( radiationPressureFunction ),
@@ -144,13 +185,13 @@ public:
      * \param area Constant area assumed to undergo radiation pressure.
      * \param mass Constant mass of body undergoing acceleration.
      */
-    CannonBallRadiationPressure(
-            Vector3dReturningFunction sourcePositionFunction,
-            Vector3dReturningFunction acceleratedBodyPositionFunction,
-            DoubleReturningFunction radiationPressureFunction,
-            const double radiationPressureCoefficient,
-            const double area,
-            const double mass )
+    CannonBallRadiationPressureTemplate(
+            VectorReturningFunction sourcePositionFunction,
+            VectorReturningFunction acceleratedBodyPositionFunction,
+            ScalarReturningFunction radiationPressureFunction,
+            const ScalarType radiationPressureCoefficient,
+            const ScalarType area,
+            const ScalarType mass )
         : sourcePositionFunction_( sourcePositionFunction ),
           acceleratedBodyPositionFunction_( acceleratedBodyPositionFunction ),
           radiationPressureFunction_( radiationPressureFunction ),
@@ -170,9 +211,9 @@ public:
      * updateMembers() function below. This function is essentially a wrapper for the free
      * function that computes the radiation pressure acceleration.
      * \return Radiation pressure acceleration.
-     * \sa computeCannonBallRadiationPressureAcceleration().
+     * \sa computeCannonBallRadiationPressureAccelerationTemplate().
      */
-    Eigen::Vector3d getAcceleration( );
+    AccelerationDataType getAcceleration( );
 
     //! Update member variables used by the radiation pressure acceleration model.
     /*!
@@ -188,72 +229,100 @@ private:
     /*!
      * Function pointer returning position of source (3D vector).
      */
-    const Vector3dReturningFunction sourcePositionFunction_;
+    const VectorReturningFunction sourcePositionFunction_;
 
     //! Function pointer returning position of accelerated body.
     /*!
      * Function pointer returning position of accelerated body (3D vector).
      */
-    const Vector3dReturningFunction acceleratedBodyPositionFunction_;
+    const VectorReturningFunction acceleratedBodyPositionFunction_;
 
     //! Function pointer returning radiation pressure.
     /*!
      * Function pointer returning radiation pressure [N/m^{2}].
      */
-    const DoubleReturningFunction radiationPressureFunction_;
+    const ScalarReturningFunction radiationPressureFunction_;
 
     //! Function pointer returning radiation pressure coefficient.
     /*!
      * Function pointer returning radiation pressure coefficient [-].
      */
-    const DoubleReturningFunction radiationPressureCoefficientFunction_;
+    const ScalarReturningFunction radiationPressureCoefficientFunction_;
 
     //! Function pointer returning area on which radiation pressure is acting.
     /*!
      * Function pointer returning area on which radiation pressure is acting [m^{2}].
      */
-    const DoubleReturningFunction areaFunction_;
+    const ScalarReturningFunction areaFunction_;
 
     //! Function pointer returning mass of accelerated body.
     /*!
      * Function pointer returning mass of accelerated body [kg].
      */
-    const DoubleReturningFunction massFunction_;
+    const ScalarReturningFunction massFunction_;
 
     //! Current vector from accelerated body to source.
     /*!
      * Current vector from accelerated body to source (3D vector).
      */
-    Eigen::Vector3d currentVectorToSource_;
+    AccelerationDataType currentVectorToSource_;
 
     //! Current radiation pressure.
     /*!
      * Current radiation pressure [N/m^{2}].
      */
-    double currentRadiationPressure_;
+    ScalarType currentRadiationPressure_;
 
     //! Current radiation pressure coefficient.
     /*!
      *  Current radiation pressure coefficient [-].
      */
-    double currentRadiationPressureCoefficient_;
+    ScalarType currentRadiationPressureCoefficient_;
 
     //! Current area on which radiation pressure is acting.
     /*!
      * Current area on which radiation pressure is acting [m^{2}].
      */
-    double currentArea_;
+    ScalarType currentArea_;
 
     //! Current mass of accelerated body.
     /*!
      * Current mass of accelerated body [kg].
      */
-    double currentMass_;
+    ScalarType currentMass_;
 };
 
+//! Typedef for double-precision cannon-ball radiation pressure acceleration model.
+typedef CannonBallRadiationPressureTemplate< Eigen::Vector3d > CannonBallRadiationPressure;
+
 //! Typedef for shared-pointer to CannonBallRadiationPressure.
 typedef boost::shared_ptr< CannonBallRadiationPressure > CannonBallRadiationPressurePointer;
 
+// Template class source.
+// The code given below is effectively the ".cpp file" for the template class definition, so you
+// only need to look at the code below if you are interested in the source implementation.
+
+//! Get radiation pressure acceleration.
+template< typename AccelerationDataType >
+AccelerationDataType CannonBallRadiationPressureTemplate< AccelerationDataType >::getAcceleration( )
+{
+    return computeCannonBallRadiationPressureAccelerationTemplate(
+                currentRadiationPressure_, currentVectorToSource_, currentArea_,
+                currentRadiationPressureCoefficient_, currentMass_ );
+}
+
+//! Update member variables used by the radiation pressure acceleration model.
+template< typename AccelerationDataType >
+void CannonBallRadiationPressureTemplate< AccelerationDataType >::updateMembers( )
+{
+    currentVectorToSource_ = ( sourcePositionFunction_( )
+                               - acceleratedBodyPositionFunction_( ) ).normalized( );
+    currentRadiationPressure_ = radiationPressureFunction_( );
+    currentRadiationPressureCoefficient_ = radiationPressureCoefficientFunction_( );
+    currentArea_ = areaFunction_( );
+    currentMass_ = massFunction_( );
+}
+
 } // namespace electro_magnetism
 } // namespace tudat
 
@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      130124    K. Kumar          Migrated force free function to new file.
+ *      140221    S. Vermeer        Force now uses scalar-type template.
  *
  *    References
  *
@@ -46,7 +47,8 @@ Eigen::Vector3d computeCannonBallRadiationPressureForce(
         const double area,
         const double radiationPressureCoefficient )
 {
-    return -radiationPressure * radiationPressureCoefficient * area * vectorToSource;
+    return computeCannonBallRadiationPressureForceTemplate< double >(
+                radiationPressure, vectorToSource, area, radiationPressureCoefficient );
 }
 
 } // namespace electro_magnetism
@@ -25,6 +25,10 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      130124    K. Kumar          Migrated force free function to new file.
+ *      140221    S. Vermeer        Added scalar-type template of force, to allow automatic
+ *                                  differentiation scalars.
+ *      140401    S. Vermeer        Renamed scalar-type template of force, so that it does not
+ *                                  overload the double-precision function.
  *
  *    References
  *
@@ -64,6 +68,28 @@ Eigen::Vector3d computeCannonBallRadiationPressureForce(
         const double area,
         const double radiationPressureCoefficient );
 
+//! Compute radiation pressure force using a cannon-ball model for arbitrary scalar type.
+/*!
+ * Computes radiation pressure force using a cannon-ball model, as described for the
+ * double-precision computeCannonBallRadiationPressureForce() function, for an arbitrary scalar
+ * type (for instance an automatic differentiation scalar).
+ * \tparam ScalarType Scalar type used for all input parameters and the force.
+ * \param radiationPressure Radiation pressure at target.                                  [N/m^2]
+ * \param vectorToSource Unit vector pointing from target to source.                           [-]
+ * \param area Area on which radiation pressure is assumed to act.                            [m^2]
+ * \param radiationPressureCoefficient Coefficient to scale effective force.                    [-]
+ * \return Force due to radiation pressure.                                                     [N]
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeCannonBallRadiationPressureForceTemplate(
+        const ScalarType& radiationPressure,
+        const Eigen::Matrix< ScalarType, 3, 1 >& vectorToSource,
+        const ScalarType& area,
+        const ScalarType& radiationPressureCoefficient )
+{
+    return -radiationPressure * radiationPressureCoefficient * area * vectorToSource;
+}
+
 } // namespace electro_magnetism
 } // namespace tudat
 
@@ -0,0 +1,277 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140321    S. Vermeer        File created.
+ *      140401    S. Vermeer        Added checks for truncated and corrupt files, and number of
+ *                                  segments reported.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositions.h"
+#include "Tudat/Astrodynamics/Ephemerides/chebyshevEphemeris.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Ephemeris with polynomial position, used to test exact reproduction by Chebyshev ephemeris.
+class PolynomialTestEphemeris : public ephemerides::Ephemeris
+{
+public:
+
+    //! Constructor.
+    PolynomialTestEphemeris( ) : Ephemeris( "Earth", "J2000" ) { }
+
+    //! Get cartesian state from ephemeris, of which position is a cubic polynomial in time.
+    basic_mathematics::Vector6d getCartesianStateFromEphemeris(
+            const double secondsSinceEpoch, const double julianDayAtEpoch )
+    {
+        const double time = secondsSinceEpoch + ( julianDayAtEpoch
+                                                  - basic_astrodynamics::JULIAN_DAY_ON_J2000 )
+                * physical_constants::JULIAN_DAY;
+
+        basic_mathematics::Vector6d cartesianState;
+        cartesianState << 7.0E6 + 3.0 * time - 2.0E-4 * time * time,
+                -1.0E6 + 2.0E-9 * time * time * time,
+                5.0E5 - 1.5 * time + 1.0E-4 * time * time - 1.0E-9 * time * time * time,
+                3.0 - 4.0E-4 * time,
+                6.0E-9 * time * time,
+                -1.5 + 2.0E-4 * time - 3.0E-9 * time * time;
+        return cartesianState;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( test_chebyshev_ephemeris )
+
+//! Test if a polynomial ephemeris is reproduced by a single segment of sufficient degree.
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisPolynomialReproduction )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    const EphemerisPointer polynomialEphemeris = boost::make_shared< PolynomialTestEphemeris >( );
+
+    // Fit cubic polynomials, which requires 4 coefficients per component.
+    const ChebyshevEphemerisPointer chebyshevEphemeris = createChebyshevEphemeris(
+                polynomialEphemeris, -500.0, 1500.0, referenceJulianDay, 1.0E-6, 1.0E-9, 4 );
+
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getNumberOfSegments( ), 1 );
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getNumberOfCoefficients( ), 4 );
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getCoefficients( ).size( ), 24 );
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getReferenceFrameOrigin( ), "Earth" );
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getReferenceFrameOrientation( ), "J2000" );
+
+    // Check state, including start and end of interval.
+    for ( int i = 0; i <= 20; i++ )
+    {
+        const double time = -500.0 + 100.0 * static_cast< double >( i );
+        const basic_mathematics::Vector6d expectedState =
+                polynomialEphemeris->getCartesianStateFromEphemeris( time, referenceJulianDay );
+        const basic_mathematics::Vector6d computedState =
+                chebyshevEphemeris->getCartesianStateFromEphemeris( time, referenceJulianDay );
+
+        BOOST_CHECK_SMALL( ( computedState - expectedState ).segment( 0, 3 ).norm( ), 1.0E-8 );
+        BOOST_CHECK_SMALL( ( computedState - expectedState ).segment( 3, 3 ).norm( ), 1.0E-10 );
+    }
+}
+
+//! Test fit of approximate planet positions to requested tolerances.
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisFitOfApproximatePlanetPositions )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    const double positionTolerance = 10.0;
+    const double velocityTolerance = 1.0E-5;
+    const double startTime = 0.0;
+    const double endTime = 365.25 * physical_constants::JULIAN_DAY;
+
+    // Fit approximate ephemeris of Mars over one year.
+    const EphemerisPointer marsEphemeris = boost::make_shared< ApproximatePlanetPositions >(
+                ApproximatePlanetPositionsBase::mars );
+    const ChebyshevEphemerisPointer chebyshevEphemeris = createChebyshevEphemeris(
+                marsEphemeris, startTime, endTime, referenceJulianDay,
+                positionTolerance, velocityTolerance );
+
+    BOOST_CHECK_GT( chebyshevEphemeris->getNumberOfSegments( ), 1 );
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getReferenceFrameOrigin( ), "Sun" );
+    BOOST_CHECK_EQUAL( chebyshevEphemeris->getReferenceFrameOrientation( ), "J2000" );
+
+    // Check errors at times that do not coincide with fit or check points. Since the fit is only
+    // checked at a finite number of points, a small margin on the tolerances is allowed.
+    for ( int i = 0; i < 997; i++ )
+    {
+        const double time = startTime + ( endTime - startTime )
+                * static_cast< double >( i ) / 996.0;
+        const basic_mathematics::Vector6d stateError =
+                chebyshevEphemeris->getCartesianStateFromEphemeris( time, referenceJulianDay )
+                - marsEphemeris->getCartesianStateFromEphemeris( time, referenceJulianDay );
+
+        BOOST_CHECK_SMALL( stateError.segment( 0, 3 ).norm( ), 1.5 * positionTolerance );
+        BOOST_CHECK_SMALL( stateError.segment( 3, 3 ).norm( ), 1.5 * velocityTolerance );
+    }
+
+    // Check that state is independent of reference epoch of input time.
+    const double time = 1.0E7;
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                chebyshevEphemeris->getCartesianStateFromEphemeris( time, referenceJulianDay ),
+                chebyshevEphemeris->getCartesianStateFromEphemeris(
+                    time - 10.0 * physical_constants::JULIAN_DAY,
+                    referenceJulianDay + 10.0 ),
+                1.0E-12 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                chebyshevEphemeris->getCartesianStateFromEphemeris( time, referenceJulianDay ),
+                chebyshevEphemeris->getCartesianState( time ),
+                std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test writing Chebyshev ephemeris to file and reading it back.
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisFileRoundTrip )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    const double endTime = 30.0 * physical_constants::JULIAN_DAY;
+    const std::string filePath = input_output::getTudatRootPath( )
+            + "/chebyshevEphemerisTestFile.bin";
+
+    const ChebyshevEphemerisPointer chebyshevEphemeris = createChebyshevEphemeris(
+                boost::make_shared< ApproximatePlanetPositions >(
+                    ApproximatePlanetPositionsBase::venus ),
+                0.0, endTime, referenceJulianDay, 1.0, 1.0E-6, 10 );
+
+    // Write to file and read back.
+    writeChebyshevEphemerisToFile( chebyshevEphemeris, filePath );
+    const ChebyshevEphemerisPointer readEphemeris = readChebyshevEphemerisFromFile( filePath );
+
+    // Check that reading a truncated file fails.
+    const boost::uintmax_t fileSize = boost::filesystem::file_size( filePath );
+    boost::filesystem::resize_file( filePath, fileSize - sizeof( double ) );
+    BOOST_CHECK_THROW( readChebyshevEphemerisFromFile( filePath ), std::runtime_error );
+
+    // Check that reading a file with a corrupt number of segments in the header fails, without
+    // attempting to allocate memory for the coefficients. The number of segments is stored after
+    // the 8-character identifier, the file version, three doubles and the number of coefficients.
+    {
+        std::fstream file( filePath.c_str( ),
+                           std::ios::in | std::ios::out | std::ios::binary );
+        file.seekp( 8 + 2 * sizeof( boost::int32_t ) + 3 * sizeof( double ) );
+        const boost::int32_t corruptNumberOfSegments
+                = std::numeric_limits< boost::int32_t >::max( );
+        file.write( reinterpret_cast< const char* >( &corruptNumberOfSegments ),
+                    sizeof( boost::int32_t ) );
+    }
+    BOOST_CHECK_THROW( readChebyshevEphemerisFromFile( filePath ), std::runtime_error );
+    boost::filesystem::remove( filePath );
+
+    // Check that all properties are restored exactly.
+    BOOST_CHECK_EQUAL( readEphemeris->getStartSecondsSinceEpoch( ),
+                       chebyshevEphemeris->getStartSecondsSinceEpoch( ) );
+    BOOST_CHECK_EQUAL( readEphemeris->getEndSecondsSinceEpoch( ),
+                       chebyshevEphemeris->getEndSecondsSinceEpoch( ) );
+    BOOST_CHECK_EQUAL( readEphemeris->getReferenceJulianDay( ),
+                       chebyshevEphemeris->getReferenceJulianDay( ) );
+    BOOST_CHECK_EQUAL( readEphemeris->getNumberOfSegments( ),
+                       chebyshevEphemeris->getNumberOfSegments( ) );
+    BOOST_CHECK_EQUAL( readEphemeris->getNumberOfCoefficients( ), 10 );
+    BOOST_CHECK_EQUAL( readEphemeris->getReferenceFrameOrigin( ), "Sun" );
+    BOOST_CHECK_EQUAL( readEphemeris->getReferenceFrameOrientation( ), "J2000" );
+    BOOST_CHECK_EQUAL_COLLECTIONS( readEphemeris->getCoefficients( ).begin( ),
+                                   readEphemeris->getCoefficients( ).end( ),
+                                   chebyshevEphemeris->getCoefficients( ).begin( ),
+                                   chebyshevEphemeris->getCoefficients( ).end( ) );
+
+    // Check that reading a file of a different format fails.
+    BOOST_CHECK_THROW( readChebyshevEphemerisFromFile(
+                           input_output::getTudatRootPath( )
+                           + "External/EphemerisData/p_elem_t2.txt" ), std::runtime_error );
+}
+
+//! Test errors for requests outside interval of validity and unreachable tolerances.
+BOOST_AUTO_TEST_CASE( testChebyshevEphemerisErrors )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    const EphemerisPointer marsEphemeris = boost::make_shared< ApproximatePlanetPositions >(
+                ApproximatePlanetPositionsBase::mars );
+
+    // Check that a request outside the interval of validity throws an exception.
+    const ChebyshevEphemerisPointer chebyshevEphemeris = createChebyshevEphemeris(
+                marsEphemeris, 0.0, 1.0E6, referenceJulianDay, 100.0, 1.0E-4 );
+    BOOST_CHECK_NO_THROW( chebyshevEphemeris->getCartesianState( 1.0E6 ) );
+    BOOST_CHECK_THROW( chebyshevEphemeris->getCartesianState( -1.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( chebyshevEphemeris->getCartesianStateFromEphemeris(
+                           0.0, referenceJulianDay + 12.0 ), std::runtime_error );
+
+    // Check that tolerances that cannot be met with the maximum number of segments throw an
+    // exception.
+    BOOST_CHECK_THROW( createChebyshevEphemeris(
+                           marsEphemeris, 0.0, 1.0E8, referenceJulianDay, 1.0E-3, 1.0E-9, 4, 4 ),
+                       std::runtime_error );
+
+    // Check that the number of segments reported is the largest power of two that is tried.
+    try
+    {
+        createChebyshevEphemeris(
+                    marsEphemeris, 0.0, 1.0E8, referenceJulianDay, 1.0E-3, 1.0E-9, 4, 7 );
+        BOOST_ERROR( "Expected exception for tolerances that cannot be met." );
+    }
+    catch ( std::runtime_error& error )
+    {
+        BOOST_CHECK( std::string( error.what( ) ).find( "using 4 segments" )
+                     != std::string::npos );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
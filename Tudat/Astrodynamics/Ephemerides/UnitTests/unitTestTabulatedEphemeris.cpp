@@ -0,0 +1,206 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      The tabulated ephemeris is tested using an analytical circular orbit, which allows the
+ *      interpolation errors to be determined exactly.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/chebyshevEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Compute state on inclined circular orbit around the Earth.
+/*!
+ * Computes state on an inclined circular orbit with a radius of 7000 km around the Earth.
+ * \param time Time since reference epoch [s].
+ * \return Cartesian state [m, m/s].
+ */
+basic_mathematics::Vector6d computeCircularOrbitState( const double time )
+{
+    const double radius = 7.0E6;
+    const double meanMotion = std::sqrt( 3.986004418E14 / ( radius * radius * radius ) );
+    const double inclination = 0.9;
+    const double angle = meanMotion * time;
+
+    basic_mathematics::Vector6d state;
+    state << radius * std::cos( angle ),
+            radius * std::sin( angle ) * std::cos( inclination ),
+            radius * std::sin( angle ) * std::sin( inclination ),
+            -radius * meanMotion * std::sin( angle ),
+            radius * meanMotion * std::cos( angle ) * std::cos( inclination ),
+            radius * meanMotion * std::cos( angle ) * std::sin( inclination );
+    return state;
+}
+
+//! Create state history of circular orbit.
+/*!
+ * Creates state history of circular orbit, covering approximately two orbits.
+ * \param timeStep Time step between states [s].
+ * \return State history.
+ */
+std::map< double, basic_mathematics::Vector6d > createCircularOrbitStateHistory(
+        const double timeStep )
+{
+    std::map< double, basic_mathematics::Vector6d > stateHistory;
+    for ( double time = 0.0; time <= 12000.0; time += timeStep )
+    {
+        stateHistory[ time ] = computeCircularOrbitState( time );
+    }
+    return stateHistory;
+}
+
+BOOST_AUTO_TEST_SUITE( test_tabulated_ephemeris )
+
+//! Test Lagrange and Hermite interpolation of tabulated circular orbit.
+BOOST_AUTO_TEST_CASE( testTabulatedEphemerisInterpolation )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    const std::map< double, basic_mathematics::Vector6d > stateHistory =
+            createCircularOrbitStateHistory( 60.0 );
+
+    TabulatedEphemeris lagrangeEphemeris( stateHistory, referenceJulianDay,
+                                          TabulatedEphemeris::lagrangeInterpolation, 8,
+                                          interpolators::uniformGrid, "Earth", "J2000" );
+    TabulatedEphemeris hermiteEphemeris( stateHistory, referenceJulianDay,
+                                         TabulatedEphemeris::hermiteInterpolation, 4 );
+
+    BOOST_CHECK_EQUAL( lagrangeEphemeris.getReferenceFrameOrigin( ), "Earth" );
+    BOOST_CHECK_EQUAL( lagrangeEphemeris.getReferenceFrameOrientation( ), "J2000" );
+    BOOST_CHECK_EQUAL( lagrangeEphemeris.getStartSecondsSinceEpoch( ), 0.0 );
+    BOOST_CHECK_EQUAL( lagrangeEphemeris.getEndSecondsSinceEpoch( ), 12000.0 );
+    BOOST_CHECK( hermiteEphemeris.getInterpolationType( )
+                 == TabulatedEphemeris::hermiteInterpolation );
+
+    // Check states in between tabulated states, including the ends of the state history.
+    interpolators::LookUpCursor lookUpCursor;
+    for ( int i = 0; i <= 1200; i++ )
+    {
+        const double time = std::min( 10.0 * static_cast< double >( i ) + 0.37, 12000.0 );
+        const basic_mathematics::Vector6d expectedState = computeCircularOrbitState( time );
+
+        const basic_mathematics::Vector6d lagrangeError =
+                lagrangeEphemeris.getCartesianStateFromEphemeris( time, referenceJulianDay )
+                - expectedState;
+        const basic_mathematics::Vector6d hermiteError =
+                hermiteEphemeris.getCartesianState( time, lookUpCursor ) - expectedState;
+
+        BOOST_CHECK_SMALL( lagrangeError.segment( 0, 3 ).norm( ), 1.0E-4 );
+        BOOST_CHECK_SMALL( lagrangeError.segment( 3, 3 ).norm( ), 1.0E-7 );
+        BOOST_CHECK_SMALL( hermiteError.segment( 0, 3 ).norm( ), 1.0E-4 );
+        BOOST_CHECK_SMALL( hermiteError.segment( 3, 3 ).norm( ), 1.0E-6 );
+    }
+
+    // Check that tabulated states are returned exactly.
+    for ( std::map< double, basic_mathematics::Vector6d >::const_iterator stateIterator =
+          stateHistory.begin( ); stateIterator != stateHistory.end( ); stateIterator++ )
+    {
+        const basic_mathematics::Vector6d lagrangeState =
+                lagrangeEphemeris.getCartesianState( stateIterator->first );
+        const basic_mathematics::Vector6d hermiteState =
+                hermiteEphemeris.getCartesianState( stateIterator->first );
+        for ( int i = 0; i < 6; i++ )
+        {
+            BOOST_CHECK_EQUAL( lagrangeState( i ), stateIterator->second( i ) );
+            BOOST_CHECK_EQUAL( hermiteState( i ), stateIterator->second( i ) );
+        }
+    }
+
+    // Check that state is independent of reference epoch of input time.
+    const basic_mathematics::Vector6d stateDifference =
+            lagrangeEphemeris.getCartesianStateFromEphemeris( 5000.0, referenceJulianDay )
+            - lagrangeEphemeris.getCartesianStateFromEphemeris(
+                5000.0 + 0.5 * physical_constants::JULIAN_DAY, referenceJulianDay - 0.5 );
+    BOOST_CHECK_SMALL( stateDifference.norm( ), 1.0E-6 );
+}
+
+//! Test reuse of tabulated ephemeris as input of Chebyshev ephemeris.
+BOOST_AUTO_TEST_CASE( testTabulatedEphemerisAsChebyshevInput )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    const EphemerisPointer tabulatedEphemeris = boost::make_shared< TabulatedEphemeris >(
+                createCircularOrbitStateHistory( 30.0 ), referenceJulianDay );
+
+    // Compress tabulated ephemeris, and compare to analytical orbit.
+    const ChebyshevEphemerisPointer chebyshevEphemeris = createChebyshevEphemeris(
+                tabulatedEphemeris, 0.0, 12000.0, referenceJulianDay, 1.0E-3, 1.0E-6 );
+    for ( int i = 0; i <= 100; i++ )
+    {
+        const double time = 120.0 * static_cast< double >( i );
+        const basic_mathematics::Vector6d stateError =
+                chebyshevEphemeris->getCartesianState( time ) - computeCircularOrbitState( time );
+        BOOST_CHECK_SMALL( stateError.segment( 0, 3 ).norm( ), 2.0E-3 );
+        BOOST_CHECK_SMALL( stateError.segment( 3, 3 ).norm( ), 2.0E-6 );
+    }
+}
+
+//! Test exceptions for invalid input and requests outside state history.
+BOOST_AUTO_TEST_CASE( testTabulatedEphemerisExceptions )
+{
+    using namespace ephemerides;
+
+    const double referenceJulianDay = basic_astrodynamics::JULIAN_DAY_ON_J2000;
+    TabulatedEphemeris tabulatedEphemeris( createCircularOrbitStateHistory( 60.0 ),
+                                           referenceJulianDay );
+
+    BOOST_CHECK_THROW( tabulatedEphemeris.getCartesianState( -1.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( tabulatedEphemeris.getCartesianState( 12000.5 ), std::runtime_error );
+    BOOST_CHECK_THROW( TabulatedEphemeris( std::map< double, basic_mathematics::Vector6d >( ),
+                                           referenceJulianDay ), std::runtime_error );
+    BOOST_CHECK_THROW( TabulatedEphemeris( createCircularOrbitStateHistory( 3000.0 ),
+                                           referenceJulianDay ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -31,6 +31,7 @@
  *      120322    D. Dirkx          Modified to new Ephemeris interfaces.
  *      120522    P. Musegaas       Fixed bug for coordinates of outer planets.
  *      130120    D. Dirkx          Updated with new Julian day + seconds since Julian day input.
+ *      140307    S. Vermeer        Added tracing of ephemeris queries.
  *
  *    References
  *      Standish, E.M. Keplerian Elements for Approximate Positions of the Major Planets,
@@ -48,6 +49,7 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
 #include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositions.h"
+#include "Tudat/Basics/tracing.h"
 
 namespace tudat
 {
@@ -58,6 +60,9 @@ namespace ephemerides
 basic_mathematics::Vector6d ApproximatePlanetPositions::getCartesianStateFromEphemeris(
         const double secondsSinceEpoch, const double julianDayAtEpoch )
 {
+    TUDAT_TRACE_SCOPE( "Ephemerides",
+                       "ApproximatePlanetPositions::getCartesianStateFromEphemeris" );
+
     // Convert planet elements in Keplerian elements to Cartesian elements.
     return tudat::basic_astrodynamics::orbital_element_conversions::
             convertKeplerianToCartesianElements(
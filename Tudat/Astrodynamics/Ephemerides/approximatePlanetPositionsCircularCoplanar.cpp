@@ -28,6 +28,7 @@
  *      110803    L. van der Ham    Seperated this code from approximatePlanetPositions.
  *      120322    D. Dirkx          Modified to new Ephemeris interfaces.
  *      130120    D. Dirkx          Updated with new Julian day + seconds since Julian day input.
+ *      140307    S. Vermeer        Added tracing of ephemeris queries.
  *
  *    References
  *      Standish, E.M. Keplerian Elements for Approximate Positions of the Major Planets,
@@ -45,6 +46,7 @@
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
 #include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositionsCircularCoplanar.h"
+#include "Tudat/Basics/tracing.h"
 
 namespace tudat
 {
@@ -55,6 +57,10 @@ namespace ephemerides
 basic_mathematics::Vector6d ApproximatePlanetPositionsCircularCoplanar::
 getCartesianStateFromEphemeris( const double secondsSinceEpoch, const double julianDayAtEpoch )
 {
+    TUDAT_TRACE_SCOPE(
+                "Ephemerides",
+                "ApproximatePlanetPositionsCircularCoplanar::getCartesianStateFromEphemeris" );
+
     // Set Julian date.
     julianDate_ = basic_astrodynamics::convertSecondsSinceEpochToJulianDay(
                 secondsSinceEpoch, julianDayAtEpoch );
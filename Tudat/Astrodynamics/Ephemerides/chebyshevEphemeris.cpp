@@ -0,0 +1,556 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140321    S. Vermeer        File created.
+ *      140401    S. Vermeer        Checked number of coefficients in file header against file size
+ *                                  before allocating; corrected number of segments reported if
+ *                                  tolerances are not met.
+ *
+ *    References
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, 2002.
+ *      Newhall, X.X. Numerical Representation of Planetary Ephemerides, Celestial Mechanics,
+ *          45, 305-310, 1989.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/Ephemerides/chebyshevEphemeris.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+namespace
+{
+
+//! Identifier at start of Chebyshev ephemeris files.
+const char chebyshevEphemerisFileIdentifier[ ] = "TUDATCHB";
+
+//! Version of Chebyshev ephemeris file format.
+const boost::int32_t chebyshevEphemerisFileVersion = 1;
+
+//! Evaluate Chebyshev series of Cartesian state.
+/*!
+ * Evaluates the Chebyshev series of the six Cartesian state components of a single segment at a
+ * given normalized time. The Chebyshev polynomials are computed once using their recurrence
+ * relation, T_k = 2 tau T_k-1 - T_k-2, and shared by all components.
+ * \param segmentCoefficients Pointer to first coefficient of segment.
+ * \param numberOfCoefficients Number of coefficients per component.
+ * \param normalizedTime Normalized time in segment, in interval [-1, 1].
+ * \return Cartesian state at given time.
+ */
+basic_mathematics::Vector6d evaluateChebyshevSeries( const double* segmentCoefficients,
+                                                     const int numberOfCoefficients,
+                                                     const double normalizedTime )
+{
+    // Add contributions of zeroth and first order polynomials, T_0 = 1 and T_1 = tau.
+    basic_mathematics::Vector6d cartesianState;
+    for ( int i = 0; i < 6; i++ )
+    {
+        cartesianState( i ) = segmentCoefficients[ i * numberOfCoefficients ]
+                + segmentCoefficients[ i * numberOfCoefficients + 1 ] * normalizedTime;
+    }
+
+    // Add higher order contributions.
+    double previousPolynomial = 1.0;
+    double currentPolynomial = normalizedTime;
+    for ( int k = 2; k < numberOfCoefficients; k++ )
+    {
+        const double nextPolynomial = 2.0 * normalizedTime * currentPolynomial
+                - previousPolynomial;
+        for ( int i = 0; i < 6; i++ )
+        {
+            cartesianState( i ) += segmentCoefficients[ i * numberOfCoefficients + k ]
+                    * nextPolynomial;
+        }
+
+        previousPolynomial = currentPolynomial;
+        currentPolynomial = nextPolynomial;
+    }
+
+    return cartesianState;
+}
+
+//! Fit Chebyshev coefficients of a single segment.
+/*!
+ * Computes the Chebyshev coefficients of the Cartesian state on a single segment, such that the
+ * polynomials interpolate the state at the Chebyshev nodes of the segment (Press et al.,
+ * 2002), and checks the resulting position and velocity errors at a number of equally spaced
+ * points in the segment, including its end points.
+ * \param ephemeris Ephemeris that is fitted.
+ * \param segmentStartTime Start of segment, in seconds since reference epoch.
+ * \param segmentDuration Duration of segment [s].
+ * \param referenceJulianDay Reference epoch in Julian days.
+ * \param numberOfCoefficients Number of coefficients per component.
+ * \param segmentCoefficients Pointer to first coefficient of segment (returned by reference).
+ * \param maximumPositionError Maximum position error in segment (returned by reference).
+ * \param maximumVelocityError Maximum velocity error in segment (returned by reference).
+ */
+void fitChebyshevSegment( const EphemerisPointer ephemeris,
+                          const double segmentStartTime,
+                          const double segmentDuration,
+                          const double referenceJulianDay,
+                          const int numberOfCoefficients,
+                          double* segmentCoefficients,
+                          double& maximumPositionError,
+                          double& maximumVelocityError )
+{
+    using basic_mathematics::mathematical_constants::PI;
+
+    std::fill( segmentCoefficients, segmentCoefficients + 6 * numberOfCoefficients, 0.0 );
+
+    // Sample state at Chebyshev nodes, and accumulate discrete Chebyshev transform.
+    for ( int j = 0; j < numberOfCoefficients; j++ )
+    {
+        const double nodeAngle = PI * ( static_cast< double >( j ) + 0.5 )
+                / static_cast< double >( numberOfCoefficients );
+        const double nodeTime = segmentStartTime
+                + 0.5 * ( std::cos( nodeAngle ) + 1.0 ) * segmentDuration;
+        const basic_mathematics::Vector6d stateAtNode =
+                ephemeris->getCartesianStateFromEphemeris( nodeTime, referenceJulianDay );
+
+        for ( int k = 0; k < numberOfCoefficients; k++ )
+        {
+            const double polynomialAtNode = std::cos( static_cast< double >( k ) * nodeAngle );
+            for ( int i = 0; i < 6; i++ )
+            {
+                segmentCoefficients[ i * numberOfCoefficients + k ] +=
+                        stateAtNode( i ) * polynomialAtNode;
+            }
+        }
+    }
+
+    // Normalize coefficients; the zeroth order coefficient has half the weight of the others.
+    const double normalizationFactor = 2.0 / static_cast< double >( numberOfCoefficients );
+    for ( int i = 0; i < 6; i++ )
+    {
+        for ( int k = 0; k < numberOfCoefficients; k++ )
+        {
+            segmentCoefficients[ i * numberOfCoefficients + k ] *= normalizationFactor;
+        }
+        segmentCoefficients[ i * numberOfCoefficients ] *= 0.5;
+    }
+
+    // Check errors at equally spaced points, which lie in between the nodes.
+    const int numberOfCheckIntervals = 2 * numberOfCoefficients;
+    maximumPositionError = 0.0;
+    maximumVelocityError = 0.0;
+    for ( int m = 0; m <= numberOfCheckIntervals; m++ )
+    {
+        const double normalizedTime = -1.0 + 2.0 * static_cast< double >( m )
+                / static_cast< double >( numberOfCheckIntervals );
+        const basic_mathematics::Vector6d fittedState = evaluateChebyshevSeries(
+                    segmentCoefficients, numberOfCoefficients, normalizedTime );
+        const basic_mathematics::Vector6d stateError = fittedState -
+                ephemeris->getCartesianStateFromEphemeris(
+                    segmentStartTime + 0.5 * ( normalizedTime + 1.0 ) * segmentDuration,
+                    referenceJulianDay );
+
+        maximumPositionError = std::max( maximumPositionError,
+                                         stateError.segment( 0, 3 ).norm( ) );
+        maximumVelocityError = std::max( maximumVelocityError,
+                                         stateError.segment( 3, 3 ).norm( ) );
+    }
+}
+
+//! Throw exception for Chebyshev ephemeris file that cannot be read.
+void throwChebyshevEphemerisFileReadError( const std::string& filePath,
+                                           const std::string& reason )
+{
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error(
+                        boost::str( boost::format(
+                                        "Chebyshev ephemeris file '%s' could not be read: %s." )
+                                    % filePath % reason ) ) )
+                << boost::errinfo_file_name( filePath )
+                << boost::errinfo_api_function( "std::ifstream::read" ) );
+}
+
+//! Write binary value to stream.
+template< typename ValueType >
+void writeBinaryValue( std::ofstream& outputStream, const ValueType value )
+{
+    outputStream.write( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+}
+
+//! Read binary value from stream.
+template< typename ValueType >
+ValueType readBinaryValue( std::ifstream& inputStream )
+{
+    ValueType value = ValueType( );
+    inputStream.read( reinterpret_cast< char* >( &value ), sizeof( ValueType ) );
+    return value;
+}
+
+//! Write length-prefixed string to binary stream.
+void writeBinaryString( std::ofstream& outputStream, const std::string& string )
+{
+    writeBinaryValue( outputStream, static_cast< boost::int32_t >( string.size( ) ) );
+    outputStream.write( string.data( ), string.size( ) );
+}
+
+//! Read length-prefixed string from binary stream.
+std::string readBinaryString( std::ifstream& inputStream, const std::string& filePath )
+{
+    const boost::int32_t stringLength = readBinaryValue< boost::int32_t >( inputStream );
+    if ( inputStream.fail( ) || stringLength < 0 || stringLength > 1024 )
+    {
+        throwChebyshevEphemerisFileReadError( filePath, "invalid reference frame identifier" );
+    }
+
+    std::string string( stringLength, ' ' );
+    if ( stringLength > 0 )
+    {
+        inputStream.read( &string[ 0 ], stringLength );
+    }
+    return string;
+}
+
+} // namespace
+
+//! Constructor.
+ChebyshevEphemeris::ChebyshevEphemeris( const double startSecondsSinceEpoch,
+                                        const double endSecondsSinceEpoch,
+                                        const double referenceJulianDay,
+                                        const int numberOfCoefficients,
+                                        const std::vector< double >& coefficients,
+                                        const std::string& referenceFrameOrigin,
+                                        const std::string& referenceFrameOrientation )
+    : Ephemeris( referenceFrameOrigin, referenceFrameOrientation ),
+      startSecondsSinceEpoch_( startSecondsSinceEpoch ),
+      endSecondsSinceEpoch_( endSecondsSinceEpoch ),
+      referenceJulianDay_( referenceJulianDay ),
+      numberOfCoefficients_( numberOfCoefficients ),
+      numberOfSegments_( 0 ),
+      segmentDuration_( 0.0 ),
+      inverseSegmentDuration_( 0.0 ),
+      coefficients_( coefficients )
+{
+    // Check input consistency.
+    if ( !( endSecondsSinceEpoch_ > startSecondsSinceEpoch_ ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "End of Chebyshev ephemeris interval must be after its start." ) ) );
+    }
+
+    if ( numberOfCoefficients_ < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Chebyshev ephemeris requires at least 2 coefficients per "
+                            "component." ) ) );
+    }
+
+    const int numberOfCoefficientsPerSegment = 6 * numberOfCoefficients_;
+    if ( coefficients_.size( ) == 0 ||
+         coefficients_.size( ) % numberOfCoefficientsPerSegment != 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format(
+                                            "Number of Chebyshev coefficients (%d) is not a "
+                                            "positive multiple of %d." )
+                                        % coefficients_.size( )
+                                        % numberOfCoefficientsPerSegment ) ) ) );
+    }
+
+    // Set segment properties.
+    numberOfSegments_ = static_cast< int >( coefficients_.size( ) )
+            / numberOfCoefficientsPerSegment;
+    segmentDuration_ = ( endSecondsSinceEpoch_ - startSecondsSinceEpoch_ )
+            / static_cast< double >( numberOfSegments_ );
+    inverseSegmentDuration_ = 1.0 / segmentDuration_;
+}
+
+//! Get cartesian state from ephemeris.
+basic_mathematics::Vector6d ChebyshevEphemeris::getCartesianStateFromEphemeris(
+        const double secondsSinceEpoch, const double julianDayAtEpoch )
+{
+    // Determine number of seconds since reference epoch of this object.
+    double secondsSinceReferenceEpoch = secondsSinceEpoch;
+    if ( julianDayAtEpoch != referenceJulianDay_ )
+    {
+        secondsSinceReferenceEpoch -= ( referenceJulianDay_ - julianDayAtEpoch )
+                * physical_constants::JULIAN_DAY;
+    }
+
+    return getCartesianState( secondsSinceReferenceEpoch );
+}
+
+//! Get cartesian state at given time since reference epoch.
+basic_mathematics::Vector6d ChebyshevEphemeris::getCartesianState(
+        const double secondsSinceReferenceEpoch ) const
+{
+    // Check if requested time is inside interval of validity.
+    if ( secondsSinceReferenceEpoch < startSecondsSinceEpoch_ ||
+         secondsSinceReferenceEpoch > endSecondsSinceEpoch_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format(
+                                            "Requested time %.17g s is outside interval of "
+                                            "validity [%.17g, %.17g] s of Chebyshev "
+                                            "ephemeris." )
+                                        % secondsSinceReferenceEpoch
+                                        % startSecondsSinceEpoch_
+                                        % endSecondsSinceEpoch_ ) ) ) );
+    }
+
+    // Determine segment directly from time, limiting the index to account for the end of the
+    // interval and round-off errors.
+    int segmentIndex = static_cast< int >(
+                ( secondsSinceReferenceEpoch - startSecondsSinceEpoch_ )
+                * inverseSegmentDuration_ );
+    if ( segmentIndex >= numberOfSegments_ )
+    {
+        segmentIndex = numberOfSegments_ - 1;
+    }
+
+    // Evaluate Chebyshev series of segment at normalized time.
+    const double segmentStartTime = startSecondsSinceEpoch_
+            + static_cast< double >( segmentIndex ) * segmentDuration_;
+    return evaluateChebyshevSeries(
+                &coefficients_[ 6 * segmentIndex * numberOfCoefficients_ ],
+                numberOfCoefficients_,
+                2.0 * ( secondsSinceReferenceEpoch - segmentStartTime ) * inverseSegmentDuration_
+                - 1.0 );
+}
+
+//! Create Chebyshev ephemeris by fitting an existing ephemeris.
+ChebyshevEphemerisPointer createChebyshevEphemeris( const EphemerisPointer ephemeris,
+                                                    const double startSecondsSinceEpoch,
+                                                    const double endSecondsSinceEpoch,
+                                                    const double referenceJulianDay,
+                                                    const double positionTolerance,
+                                                    const double velocityTolerance,
+                                                    const int numberOfCoefficients,
+                                                    const int maximumNumberOfSegments )
+{
+    if ( !( endSecondsSinceEpoch > startSecondsSinceEpoch ) || numberOfCoefficients < 2
+         || maximumNumberOfSegments < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Chebyshev ephemeris requires a non-empty interval, at least 2 "
+                            "coefficients per component and at least 1 segment." ) ) );
+    }
+
+    std::vector< double > coefficients;
+    double maximumPositionError = 0.0;
+    double maximumVelocityError = 0.0;
+
+    // Double the number of segments until the tolerances are met on all segments. The largest
+    // number of segments that is tried is the largest power of two not exceeding the maximum.
+    int largestNumberOfSegments = 1;
+    while ( largestNumberOfSegments <= maximumNumberOfSegments / 2 )
+    {
+        largestNumberOfSegments *= 2;
+    }
+
+    for ( int numberOfSegments = 1; numberOfSegments <= largestNumberOfSegments;
+          numberOfSegments *= 2 )
+    {
+        const double segmentDuration = ( endSecondsSinceEpoch - startSecondsSinceEpoch )
+                / static_cast< double >( numberOfSegments );
+        coefficients.resize( 6 * numberOfCoefficients * numberOfSegments );
+
+        bool areTolerancesMet = true;
+        for ( int j = 0; j < numberOfSegments && areTolerancesMet; j++ )
+        {
+            fitChebyshevSegment( ephemeris,
+                                 startSecondsSinceEpoch
+                                 + static_cast< double >( j ) * segmentDuration,
+                                 segmentDuration, referenceJulianDay, numberOfCoefficients,
+                                 &coefficients[ 6 * j * numberOfCoefficients ],
+                                 maximumPositionError, maximumVelocityError );
+            areTolerancesMet = ( maximumPositionError <= positionTolerance &&
+                                 maximumVelocityError <= velocityTolerance );
+        }
+
+        if ( areTolerancesMet )
+        {
+            return boost::make_shared< ChebyshevEphemeris >(
+                        startSecondsSinceEpoch, endSecondsSinceEpoch, referenceJulianDay,
+                        numberOfCoefficients, coefficients,
+                        ephemeris->getReferenceFrameOrigin( ),
+                        ephemeris->getReferenceFrameOrientation( ) );
+        }
+
+        // Stop before doubling would overflow the number of segments.
+        if ( numberOfSegments == largestNumberOfSegments )
+        {
+            break;
+        }
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error(
+                        boost::str( boost::format(
+                                        "Chebyshev ephemeris did not meet tolerances using %d "
+                                        "segments (position error %g m, velocity error "
+                                        "%g m/s)." )
+                                    % largestNumberOfSegments % maximumPositionError
+                                    % maximumVelocityError ) ) ) );
+}
+
+//! Write Chebyshev ephemeris to file.
+void writeChebyshevEphemerisToFile( const ChebyshevEphemerisPointer chebyshevEphemeris,
+                                    const std::string& filePath )
+{
+    std::ofstream outputFile( filePath.c_str( ), std::ios::binary );
+    if ( outputFile.fail( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Data file '%s' could not be opened." )
+                                        % filePath ) ) )
+                << boost::errinfo_file_name( filePath )
+                << boost::errinfo_file_open_mode( "std::ios::binary" )
+                << boost::errinfo_api_function( "std::ofstream::open" ) );
+    }
+
+    // Write header, followed by coefficients.
+    outputFile.write( chebyshevEphemerisFileIdentifier,
+                      std::strlen( chebyshevEphemerisFileIdentifier ) );
+    writeBinaryValue( outputFile, chebyshevEphemerisFileVersion );
+    writeBinaryValue( outputFile, chebyshevEphemeris->getStartSecondsSinceEpoch( ) );
+    writeBinaryValue( outputFile, chebyshevEphemeris->getEndSecondsSinceEpoch( ) );
+    writeBinaryValue( outputFile, chebyshevEphemeris->getReferenceJulianDay( ) );
+    writeBinaryValue( outputFile, static_cast< boost::int32_t >(
+                          chebyshevEphemeris->getNumberOfCoefficients( ) ) );
+    writeBinaryValue( outputFile, static_cast< boost::int32_t >(
+                          chebyshevEphemeris->getNumberOfSegments( ) ) );
+    writeBinaryString( outputFile, chebyshevEphemeris->getReferenceFrameOrigin( ) );
+    writeBinaryString( outputFile, chebyshevEphemeris->getReferenceFrameOrientation( ) );
+
+    const std::vector< double >& coefficients = chebyshevEphemeris->getCoefficients( );
+    outputFile.write( reinterpret_cast< const char* >( &coefficients[ 0 ] ),
+                      coefficients.size( ) * sizeof( double ) );
+}
+
+//! Read Chebyshev ephemeris from file.
+ChebyshevEphemerisPointer readChebyshevEphemerisFromFile( const std::string& filePath )
+{
+    std::ifstream inputFile( filePath.c_str( ), std::ios::binary );
+    if ( inputFile.fail( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format( "Data file '%s' could not be opened." )
+                                        % filePath ) ) )
+                << boost::errinfo_file_name( filePath )
+                << boost::errinfo_file_open_mode( "std::ios::binary" )
+                << boost::errinfo_api_function( "std::ifstream::open" ) );
+    }
+
+    // Read and check header.
+    const std::size_t identifierLength = std::strlen( chebyshevEphemerisFileIdentifier );
+    std::string identifier( identifierLength, ' ' );
+    inputFile.read( &identifier[ 0 ], identifierLength );
+    if ( inputFile.fail( ) || identifier != chebyshevEphemerisFileIdentifier )
+    {
+        throwChebyshevEphemerisFileReadError( filePath, "not a Chebyshev ephemeris file" );
+    }
+
+    if ( readBinaryValue< boost::int32_t >( inputFile ) != chebyshevEphemerisFileVersion )
+    {
+        throwChebyshevEphemerisFileReadError( filePath, "unsupported file version" );
+    }
+
+    const double startSecondsSinceEpoch = readBinaryValue< double >( inputFile );
+    const double endSecondsSinceEpoch = readBinaryValue< double >( inputFile );
+    const double referenceJulianDay = readBinaryValue< double >( inputFile );
+    const boost::int32_t numberOfCoefficients = readBinaryValue< boost::int32_t >( inputFile );
+    const boost::int32_t numberOfSegments = readBinaryValue< boost::int32_t >( inputFile );
+    if ( inputFile.fail( ) || numberOfCoefficients < 2 || numberOfSegments < 1 )
+    {
+        throwChebyshevEphemerisFileReadError( filePath, "invalid header" );
+    }
+
+    const std::string referenceFrameOrigin = readBinaryString( inputFile, filePath );
+    const std::string referenceFrameOrientation = readBinaryString( inputFile, filePath );
+
+    // Check that the file contains the number of coefficients given in the header, before
+    // allocating memory for them. The check is done by division, since the number of
+    // coefficients can overflow for a corrupt header.
+    const std::streampos coefficientsPosition = inputFile.tellg( );
+    inputFile.seekg( 0, std::ios::end );
+    const std::streamoff numberOfRemainingBytes = inputFile.tellg( ) - coefficientsPosition;
+    inputFile.seekg( coefficientsPosition );
+    if ( inputFile.fail( ) || numberOfRemainingBytes < 0
+         || static_cast< boost::uint64_t >( numberOfRemainingBytes ) / sizeof( double )
+         / ( 6 * static_cast< boost::uint64_t >( numberOfCoefficients ) )
+         < static_cast< boost::uint64_t >( numberOfSegments ) )
+    {
+        throwChebyshevEphemerisFileReadError( filePath, "unexpected end of file" );
+    }
+
+    // Read coefficients.
+    std::vector< double > coefficients(
+                6 * static_cast< std::size_t >( numberOfCoefficients ) * numberOfSegments );
+    inputFile.read( reinterpret_cast< char* >( &coefficients[ 0 ] ),
+                    coefficients.size( ) * sizeof( double ) );
+    if ( inputFile.fail( ) )
+    {
+        throwChebyshevEphemerisFileReadError( filePath, "unexpected end of file" );
+    }
+
+    return boost::make_shared< ChebyshevEphemeris >(
+                startSecondsSinceEpoch, endSecondsSinceEpoch, referenceJulianDay,
+                numberOfCoefficients, coefficients, referenceFrameOrigin,
+                referenceFrameOrientation );
+}
+
+} // namespace ephemerides
+} // namespace tudat
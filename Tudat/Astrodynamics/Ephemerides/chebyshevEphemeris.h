@@ -0,0 +1,276 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140321    S. Vermeer        File created.
+ *      140401    S. Vermeer        Documented number of segments tried when fitting.
+ *
+ *    References
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, 2002.
+ *      Newhall, X.X. Numerical Representation of Planetary Ephemerides, Celestial Mechanics,
+ *          45, 305-310, 1989.
+ *
+ *    Notes
+ *      Contrary to the JPL DE ephemerides (Newhall, 1989), the velocity is fitted separately
+ *      instead of being obtained by differentiating the position polynomials. This doubles the
+ *      number of coefficients, but ensures that the requested velocity tolerance can be met for
+ *      any fitted ephemeris, also those of which the velocity is not exactly the time derivative
+ *      of the position (such as ApproximatePlanetPositions).
+ *
+ *      All segments of a ChebyshevEphemeris have the same duration, so that the segment
+ *      containing a requested time is found by a single division, instead of a search.
+ *
+ *      The binary file format written by writeChebyshevEphemerisToFile( ) uses the native byte
+ *      order of the machine, and is therefore not portable between machines of different
+ *      endianness.
+ *
+ */
+
+#ifndef TUDAT_CHEBYSHEV_EPHEMERIS_H
+#define TUDAT_CHEBYSHEV_EPHEMERIS_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Ephemeris class using piecewise Chebyshev polynomials.
+/*!
+ * Ephemeris class using piecewise Chebyshev polynomials of the Cartesian state, on equal-length
+ * segments covering the interval of validity. Objects of this class are typically created by
+ * fitting an existing ephemeris using the createChebyshevEphemeris( ) function, or read from file
+ * using readChebyshevEphemerisFromFile( ).
+ */
+class ChebyshevEphemeris : public Ephemeris
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the Chebyshev coefficients of all segments and the time interval on which
+     * they are valid.
+     * \param startSecondsSinceEpoch Start of the interval of validity, in seconds since the
+     *          reference epoch.
+     * \param endSecondsSinceEpoch End of the interval of validity, in seconds since the reference
+     *          epoch.
+     * \param referenceJulianDay Reference epoch in Julian days, from which all times in this
+     *          object are counted.
+     * \param numberOfCoefficients Number of Chebyshev coefficients per state component per
+     *          segment (i.e., polynomial degree plus one). Must be at least 2.
+     * \param coefficients Chebyshev coefficients of all segments. For each segment, the
+     *          coefficients of the six Cartesian state components are stored consecutively, so
+     *          that the k-th coefficient of component i in segment j is stored at index
+     *          ( 6 * j + i ) * numberOfCoefficients + k. The number of segments is derived from
+     *          the size of this vector.
+     * \param referenceFrameOrigin Origin of reference frame (string identifier).
+     * \param referenceFrameOrientation Orientation of reference frame (string identifier).
+     */
+    ChebyshevEphemeris( const double startSecondsSinceEpoch,
+                        const double endSecondsSinceEpoch,
+                        const double referenceJulianDay,
+                        const int numberOfCoefficients,
+                        const std::vector< double >& coefficients,
+                        const std::string& referenceFrameOrigin = "",
+                        const std::string& referenceFrameOrientation = "" );
+
+    //! Get cartesian state from ephemeris.
+    /*!
+     * Returns cartesian state from ephemeris, by evaluating the Chebyshev polynomials of the
+     * segment containing the requested time. The segment is found in constant time. An exception
+     * is thrown if the requested time is outside the interval of validity.
+     * \param secondsSinceEpoch Seconds since epoch.
+     * \param julianDayAtEpoch Reference epoch in Julian day.
+     * \return State in Cartesian elements from ephemeris.
+     */
+    basic_mathematics::Vector6d getCartesianStateFromEphemeris(
+            const double secondsSinceEpoch, const double julianDayAtEpoch );
+
+    //! Get cartesian state at given time since reference epoch.
+    /*!
+     * Returns cartesian state at given time since the reference epoch of this object, which
+     * avoids the conversion between reference epochs.
+     * \param secondsSinceReferenceEpoch Seconds since reference epoch of this object.
+     * \return State in Cartesian elements from ephemeris.
+     */
+    basic_mathematics::Vector6d getCartesianState( const double secondsSinceReferenceEpoch ) const;
+
+    //! Get start of interval of validity.
+    /*!
+     * Returns start of interval of validity.
+     * \return Start of interval of validity, in seconds since reference epoch.
+     */
+    double getStartSecondsSinceEpoch( ) const { return startSecondsSinceEpoch_; }
+
+    //! Get end of interval of validity.
+    /*!
+     * Returns end of interval of validity.
+     * \return End of interval of validity, in seconds since reference epoch.
+     */
+    double getEndSecondsSinceEpoch( ) const { return endSecondsSinceEpoch_; }
+
+    //! Get reference epoch.
+    /*!
+     * Returns reference epoch from which all times in this object are counted.
+     * \return Reference epoch in Julian days.
+     */
+    double getReferenceJulianDay( ) const { return referenceJulianDay_; }
+
+    //! Get number of segments.
+    /*!
+     * Returns number of segments.
+     * \return Number of segments.
+     */
+    int getNumberOfSegments( ) const { return numberOfSegments_; }
+
+    //! Get number of coefficients per component per segment.
+    /*!
+     * Returns number of Chebyshev coefficients per state component per segment.
+     * \return Number of coefficients.
+     */
+    int getNumberOfCoefficients( ) const { return numberOfCoefficients_; }
+
+    //! Get Chebyshev coefficients.
+    /*!
+     * Returns Chebyshev coefficients of all segments, stored as described in the constructor.
+     * \return Chebyshev coefficients.
+     */
+    const std::vector< double >& getCoefficients( ) const { return coefficients_; }
+
+private:
+
+    //! Start of interval of validity.
+    /*!
+     * Start of interval of validity, in seconds since reference epoch.
+     */
+    double startSecondsSinceEpoch_;
+
+    //! End of interval of validity.
+    /*!
+     * End of interval of validity, in seconds since reference epoch.
+     */
+    double endSecondsSinceEpoch_;
+
+    //! Reference epoch.
+    /*!
+     * Reference epoch in Julian days, from which all times in this object are counted.
+     */
+    double referenceJulianDay_;
+
+    //! Number of coefficients per component per segment.
+    /*!
+     * Number of Chebyshev coefficients per state component per segment.
+     */
+    int numberOfCoefficients_;
+
+    //! Number of segments.
+    /*!
+     * Number of segments.
+     */
+    int numberOfSegments_;
+
+    //! Duration of each segment.
+    /*!
+     * Duration of each segment [s].
+     */
+    double segmentDuration_;
+
+    //! Inverse of duration of each segment.
+    /*!
+     * Inverse of duration of each segment [1/s], used to find the segment of a requested time.
+     */
+    double inverseSegmentDuration_;
+
+    //! Chebyshev coefficients.
+    /*!
+     * Chebyshev coefficients of all segments, stored as described in the constructor.
+     */
+    std::vector< double > coefficients_;
+};
+
+//! Typedef for shared-pointer to ChebyshevEphemeris object.
+typedef boost::shared_ptr< ChebyshevEphemeris > ChebyshevEphemerisPointer;
+
+//! Create Chebyshev ephemeris by fitting an existing ephemeris.
+/*!
+ * Creates a Chebyshev ephemeris by fitting the Cartesian state of an existing ephemeris with
+ * piecewise Chebyshev polynomials. The polynomials on each segment interpolate the state at the
+ * Chebyshev nodes of that segment (Press et al., 2002). Starting from a single segment, the
+ * number of segments is doubled until the position and velocity errors, checked at a set of
+ * points in between the nodes of each segment, are below the requested tolerances. The
+ * reference frame of the created ephemeris is copied from the fitted ephemeris.
+ * \param ephemeris Ephemeris that is to be fitted.
+ * \param startSecondsSinceEpoch Start of the interval to fit, in seconds since the reference
+ *          epoch.
+ * \param endSecondsSinceEpoch End of the interval to fit, in seconds since the reference epoch.
+ * \param referenceJulianDay Reference epoch in Julian days.
+ * \param positionTolerance Maximum position error that is allowed [m].
+ * \param velocityTolerance Maximum velocity error that is allowed [m/s].
+ * \param numberOfCoefficients Number of Chebyshev coefficients per state component per
+ *          segment (default 12).
+ * \param maximumNumberOfSegments Maximum number of segments (at least 1); an exception is thrown
+ *          if the tolerances are not met using the largest power of two not exceeding this
+ *          number of segments (default 65536).
+ * \return Chebyshev ephemeris.
+ */
+ChebyshevEphemerisPointer createChebyshevEphemeris( const EphemerisPointer ephemeris,
+                                                    const double startSecondsSinceEpoch,
+                                                    const double endSecondsSinceEpoch,
+                                                    const double referenceJulianDay,
+                                                    const double positionTolerance,
+                                                    const double velocityTolerance,
+                                                    const int numberOfCoefficients = 12,
+                                                    const int maximumNumberOfSegments = 65536 );
+
+//! Write Chebyshev ephemeris to file.
+/*!
+ * Writes Chebyshev ephemeris to a binary file, which can be read by
+ * readChebyshevEphemerisFromFile( ).
+ * \param chebyshevEphemeris Chebyshev ephemeris that is to be written.
+ * \param filePath Path of file that is to be written.
+ */
+void writeChebyshevEphemerisToFile( const ChebyshevEphemerisPointer chebyshevEphemeris,
+                                    const std::string& filePath );
+
+//! Read Chebyshev ephemeris from file.
+/*!
+ * Reads Chebyshev ephemeris from a binary file written by writeChebyshevEphemerisToFile( ).
+ * \param filePath Path of file that is to be read.
+ * \return Chebyshev ephemeris.
+ */
+ChebyshevEphemerisPointer readChebyshevEphemerisFromFile( const std::string& filePath );
+
+} // namespace ephemerides
+} // namespace tudat
+
+#endif // TUDAT_CHEBYSHEV_EPHEMERIS_H
@@ -0,0 +1,184 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Constructor.
+TabulatedEphemeris::TabulatedEphemeris(
+        const std::map< double, basic_mathematics::Vector6d >& stateHistory,
+        const double referenceJulianDay,
+        const InterpolationType interpolationType,
+        const int numberOfPoints,
+        const interpolators::AvailableLookupScheme selectedLookupScheme,
+        const std::string& referenceFrameOrigin,
+        const std::string& referenceFrameOrientation )
+    : Ephemeris( referenceFrameOrigin, referenceFrameOrientation ),
+      referenceJulianDay_( referenceJulianDay ),
+      interpolationType_( interpolationType ),
+      startSecondsSinceEpoch_( 0.0 ),
+      endSecondsSinceEpoch_( 0.0 )
+{
+    if ( stateHistory.size( ) == 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "State history of tabulated ephemeris is empty." ) ) );
+    }
+
+    startSecondsSinceEpoch_ = stateHistory.begin( )->first;
+    endSecondsSinceEpoch_ = stateHistory.rbegin( )->first;
+
+    // Split state history in vectors for interpolator.
+    std::vector< double > times;
+    times.reserve( stateHistory.size( ) );
+    for ( std::map< double, basic_mathematics::Vector6d >::const_iterator stateIterator =
+          stateHistory.begin( ); stateIterator != stateHistory.end( ); stateIterator++ )
+    {
+        times.push_back( stateIterator->first );
+    }
+
+    switch ( interpolationType_ )
+    {
+    case lagrangeInterpolation:
+    {
+        std::vector< UnalignedVector6d > states;
+        states.reserve( stateHistory.size( ) );
+        for ( std::map< double, basic_mathematics::Vector6d >::const_iterator stateIterator =
+              stateHistory.begin( ); stateIterator != stateHistory.end( ); stateIterator++ )
+        {
+            states.push_back( stateIterator->second );
+        }
+
+        stateInterpolator_ = boost::make_shared<
+                interpolators::LagrangeInterpolator< double, UnalignedVector6d > >(
+                    times, states, numberOfPoints, selectedLookupScheme );
+        break;
+    }
+    case hermiteInterpolation:
+    {
+        std::vector< Eigen::Vector3d > positions;
+        std::vector< Eigen::Vector3d > velocities;
+        positions.reserve( stateHistory.size( ) );
+        velocities.reserve( stateHistory.size( ) );
+        for ( std::map< double, basic_mathematics::Vector6d >::const_iterator stateIterator =
+              stateHistory.begin( ); stateIterator != stateHistory.end( ); stateIterator++ )
+        {
+            positions.push_back( stateIterator->second.segment( 0, 3 ) );
+            velocities.push_back( stateIterator->second.segment( 3, 3 ) );
+        }
+
+        positionInterpolator_ = boost::make_shared<
+                interpolators::HermiteInterpolator< double, Eigen::Vector3d > >(
+                    times, positions, velocities, numberOfPoints, selectedLookupScheme );
+        break;
+    }
+    default:
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Interpolation type of tabulated ephemeris not recognized." ) ) );
+    }
+}
+
+//! Get cartesian state from ephemeris.
+basic_mathematics::Vector6d TabulatedEphemeris::getCartesianStateFromEphemeris(
+        const double secondsSinceEpoch, const double julianDayAtEpoch )
+{
+    // Determine number of seconds since reference epoch of this object.
+    double secondsSinceReferenceEpoch = secondsSinceEpoch;
+    if ( julianDayAtEpoch != referenceJulianDay_ )
+    {
+        secondsSinceReferenceEpoch -= ( referenceJulianDay_ - julianDayAtEpoch )
+                * physical_constants::JULIAN_DAY;
+    }
+
+    return getCartesianState( secondsSinceReferenceEpoch, lookUpCursor_ );
+}
+
+//! Get cartesian state at given time since reference epoch using caller-owned cursor.
+basic_mathematics::Vector6d TabulatedEphemeris::getCartesianState(
+        const double secondsSinceReferenceEpoch, interpolators::LookUpCursor& lookUpCursor ) const
+{
+    // Check if requested time is inside state history, since the interpolating polynomials
+    // diverge rapidly outside it.
+    if ( secondsSinceReferenceEpoch < startSecondsSinceEpoch_ ||
+         secondsSinceReferenceEpoch > endSecondsSinceEpoch_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            boost::str( boost::format(
+                                            "Requested time %.17g s is outside state history "
+                                            "[%.17g, %.17g] s of tabulated ephemeris." )
+                                        % secondsSinceReferenceEpoch
+                                        % startSecondsSinceEpoch_
+                                        % endSecondsSinceEpoch_ ) ) ) );
+    }
+
+    basic_mathematics::Vector6d cartesianState;
+    if ( interpolationType_ == lagrangeInterpolation )
+    {
+        cartesianState = stateInterpolator_->interpolate( secondsSinceReferenceEpoch,
+                                                          lookUpCursor );
+    }
+    else
+    {
+        // Interpolate position and velocity from the same window; the look-up of the second call
+        // starts from the interval found by the first, through the shared cursor.
+        cartesianState.segment( 0, 3 ) = positionInterpolator_->interpolate(
+                    secondsSinceReferenceEpoch, lookUpCursor );
+        cartesianState.segment( 3, 3 ) = positionInterpolator_->interpolateFirstDerivative(
+                    secondsSinceReferenceEpoch, lookUpCursor );
+    }
+
+    return cartesianState;
+}
+
+} // namespace ephemerides
+} // namespace tudat
@@ -0,0 +1,223 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      The full state is interpolated by a single Lagrange interpolator, so that position and
+ *      velocity share one look-up. The state is stored as a 6-vector without alignment
+ *      requirements (UnalignedVector6d), since the interpolators store their data in standard
+ *      vectors with the default allocator.
+ *
+ */
+
+#ifndef TUDAT_TABULATED_EPHEMERIS_H
+#define TUDAT_TABULATED_EPHEMERIS_H
+
+#include <map>
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+#include "Tudat/Mathematics/Interpolators/hermiteInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+
+namespace tudat
+{
+namespace ephemerides
+{
+
+//! Ephemeris class interpolating a tabulated state history.
+/*!
+ * Ephemeris class interpolating a tabulated Cartesian state history, such as a numerically
+ * propagated trajectory, so that it can be used as ephemeris of a body. The state history is
+ * interpolated using either Lagrange interpolation of the full state, or Hermite interpolation
+ * of the position, using the velocity as its derivative. In the latter case, the velocity is
+ * obtained from the derivative of the Hermite polynomial, so that it is consistent with the
+ * position.
+ */
+class TabulatedEphemeris : public Ephemeris
+{
+public:
+
+    //! Types of interpolation of state history.
+    enum InterpolationType
+    {
+        lagrangeInterpolation, hermiteInterpolation
+    };
+
+    //! Typedef for Cartesian state without alignment requirements.
+    typedef Eigen::Matrix< double, 6, 1, Eigen::DontAlign > UnalignedVector6d;
+
+    //! Constructor.
+    /*!
+     * Constructor, creating the interpolator of the state history.
+     * \param stateHistory Map of Cartesian states, with the number of seconds since the reference
+     *          epoch as keys.
+     * \param referenceJulianDay Reference epoch in Julian days, from which the times in the state
+     *          history are counted.
+     * \param interpolationType Type of interpolation (default Lagrange interpolation).
+     * \param numberOfPoints Number of points in sliding window of interpolator, must be even
+     *          (default 8).
+     * \param selectedLookupScheme Look-up scheme that is to be used by interpolator (default
+     *          hunting algorithm; use uniform grid for fixed-step state histories).
+     * \param referenceFrameOrigin Origin of reference frame (string identifier).
+     * \param referenceFrameOrientation Orientation of reference frame (string identifier).
+     */
+    TabulatedEphemeris( const std::map< double, basic_mathematics::Vector6d >& stateHistory,
+                        const double referenceJulianDay,
+                        const InterpolationType interpolationType = lagrangeInterpolation,
+                        const int numberOfPoints = 8,
+                        const interpolators::AvailableLookupScheme selectedLookupScheme
+                        = interpolators::huntingAlgorithm,
+                        const std::string& referenceFrameOrigin = "",
+                        const std::string& referenceFrameOrientation = "" );
+
+    //! Get cartesian state from ephemeris.
+    /*!
+     * Returns cartesian state from ephemeris, by interpolating the state history. An exception is
+     * thrown if the requested time is outside the state history.
+     * \param secondsSinceEpoch Seconds since epoch.
+     * \param julianDayAtEpoch Reference epoch in Julian day.
+     * \return State in Cartesian elements from ephemeris.
+     */
+    basic_mathematics::Vector6d getCartesianStateFromEphemeris(
+            const double secondsSinceEpoch, const double julianDayAtEpoch );
+
+    //! Get cartesian state at given time since reference epoch.
+    /*!
+     * Returns cartesian state at given time since the reference epoch of this object, using the
+     * look-up cursor owned by this object.
+     * \param secondsSinceReferenceEpoch Seconds since reference epoch of this object.
+     * \return State in Cartesian elements from ephemeris.
+     */
+    basic_mathematics::Vector6d getCartesianState( const double secondsSinceReferenceEpoch )
+    {
+        return getCartesianState( secondsSinceReferenceEpoch, lookUpCursor_ );
+    }
+
+    //! Get cartesian state at given time since reference epoch using caller-owned cursor.
+    /*!
+     * Returns cartesian state at given time since the reference epoch of this object. This
+     * function does not modify the ephemeris, and may be called concurrently from multiple
+     * threads with distinct cursors.
+     * \param secondsSinceReferenceEpoch Seconds since reference epoch of this object.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return State in Cartesian elements from ephemeris.
+     */
+    basic_mathematics::Vector6d getCartesianState(
+            const double secondsSinceReferenceEpoch,
+            interpolators::LookUpCursor& lookUpCursor ) const;
+
+    //! Get start of state history.
+    /*!
+     * Returns time of first state in state history.
+     * \return Start of state history, in seconds since reference epoch.
+     */
+    double getStartSecondsSinceEpoch( ) const { return startSecondsSinceEpoch_; }
+
+    //! Get end of state history.
+    /*!
+     * Returns time of last state in state history.
+     * \return End of state history, in seconds since reference epoch.
+     */
+    double getEndSecondsSinceEpoch( ) const { return endSecondsSinceEpoch_; }
+
+    //! Get reference epoch.
+    /*!
+     * Returns reference epoch from which all times in this object are counted.
+     * \return Reference epoch in Julian days.
+     */
+    double getReferenceJulianDay( ) const { return referenceJulianDay_; }
+
+    //! Get type of interpolation.
+    /*!
+     * Returns type of interpolation of state history.
+     * \return Type of interpolation.
+     */
+    InterpolationType getInterpolationType( ) const { return interpolationType_; }
+
+private:
+
+    //! Reference epoch.
+    /*!
+     * Reference epoch in Julian days, from which all times in this object are counted.
+     */
+    double referenceJulianDay_;
+
+    //! Type of interpolation.
+    /*!
+     * Type of interpolation of state history.
+     */
+    InterpolationType interpolationType_;
+
+    //! Start of state history.
+    /*!
+     * Time of first state in state history, in seconds since reference epoch.
+     */
+    double startSecondsSinceEpoch_;
+
+    //! End of state history.
+    /*!
+     * Time of last state in state history, in seconds since reference epoch.
+     */
+    double endSecondsSinceEpoch_;
+
+    //! Lagrange interpolator of state, used for Lagrange interpolation.
+    /*!
+     * Lagrange interpolator of state, used for Lagrange interpolation.
+     */
+    boost::shared_ptr< interpolators::LagrangeInterpolator< double, UnalignedVector6d > >
+    stateInterpolator_;
+
+    //! Hermite interpolator of position, used for Hermite interpolation.
+    /*!
+     * Hermite interpolator of position, with the velocity as derivative, used for Hermite
+     * interpolation.
+     */
+    boost::shared_ptr< interpolators::HermiteInterpolator< double, Eigen::Vector3d > >
+    positionInterpolator_;
+
+    //! Look-up cursor used when no cursor is provided.
+    /*!
+     * Look-up cursor used when no cursor is provided.
+     */
+    interpolators::LookUpCursor lookUpCursor_;
+};
+
+//! Typedef for shared-pointer to TabulatedEphemeris object.
+typedef boost::shared_ptr< TabulatedEphemeris > TabulatedEphemerisPointer;
+
+} // namespace ephemerides
+} // namespace tudat
+
+#endif // TUDAT_TABULATED_EPHEMERIS_H
@@ -31,6 +31,9 @@
  *                                  (Melman, 2012) and (Ronse, 2012).
  *      121023    K. Kumar          Added unit tests for wrapper class (only MATLAB-based test).
  *      121210    D. Dirkx          Updated gravitational acceleration model references.
+ *      140203    S. Vermeer        Added unit tests for general central + zonal gravity model.
+ *      140221    S. Vermeer        Added unit tests for partial derivatives of accelerations
+ *                                  computed using automatic differentiation.
  *
  *    References
  *      Easy calculation. Gravitational Acceleration Tutorial,
@@ -68,7 +71,10 @@
 #include "Tudat/Astrodynamics/Gravitation/centralJ2GravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/centralJ2J3GravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/centralJ2J3J4GravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/centralZonalGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/UnitTests/planetTestData.h"
+#include "Tudat/Mathematics/BasicMathematics/automaticDifferentiation.h"
 
 namespace tudat
 {
@@ -475,6 +481,249 @@ BOOST_AUTO_TEST_CASE( testGravitationalAccelarationZonalRonse )
     }
 }
 
+//! Test if general zonal gravity model computes gravitational acceleration correctly using MATLAB.
+BOOST_AUTO_TEST_CASE( testGravitationalAccelerationGeneralZonalModelMatlab )
+{
+    // These tests check if total acceleration due to zonal terms is computed correctly by the
+    // general central + zonal wrapper class, by comparing to output generated using
+    // gravityzonal() function in MATLAB (Mathworks, 2012).
+
+    // Get planet test data.
+    std::vector< PlanetTestData > planetData = getPlanetMatlabTestData( );
+
+    // Loop over all planet test data and recompute the results using Tudat code. Check that the
+    // values computed match MATLAB's output (Mathworks, 2012).
+    for ( unsigned int planet = 0; planet < planetData.size( ); planet++ )
+    {
+        for ( unsigned int body1 = 0; body1 < planetData.at( planet ).body1Positions.size( );
+              body1++ )
+        {
+            for ( unsigned int body2 = 0; body2 < planetData.at( planet ).body2Positions.size( );
+                  body2++ )
+            {
+                // Declare zonal coefficients used.
+                KeyIntValueDoubleMap zonalCoefficients;
+
+                // Loop over all available zonal gravity field coefficients.
+                for ( KeyIntValueDoubleMap::iterator zonalCoefficientIterator
+                      = planetData.at( planet ).zonalCoefficients.begin( );
+                      zonalCoefficientIterator
+                      != planetData.at( planet ).zonalCoefficients.end( );
+                      zonalCoefficientIterator++ )
+                {
+                    // Add current zonal coefficient to local list.
+                    zonalCoefficients[ zonalCoefficientIterator->first ]
+                            = zonalCoefficientIterator->second;
+
+                    // Declare central + zonal acceleration wrapper class object.
+                    CentralZonalGravitationalAccelerationModelPointer centralZonalGravity
+                            = boost::make_shared< CentralZonalGravitationalAccelerationModel >(
+                                boost::lambda::constant(
+                                    planetData.at( planet ).body2Positions.at( body2 ) ),
+                                planetData.at( planet ).gravitationalParameter,
+                                planetData.at( planet ).equatorialRadius,
+                                convertZonalCoefficientMapToVector( zonalCoefficients ),
+                                boost::lambda::constant(
+                                    planetData.at( planet ).body1Positions.at( body1 ) ) );
+
+                    // Check that highest degree is set correctly.
+                    BOOST_CHECK_EQUAL( centralZonalGravity->getHighestDegree( ),
+                                       zonalCoefficientIterator->first );
+
+                    // Compute gravitational acceleration sum [m s^-2].
+                    const Eigen::Vector3d computedAccelerationSum
+                            = centralZonalGravity->getAcceleration( );
+
+                    // Check that computed gravitational acceleration sum matches expected values.
+                    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                                planetData.at( planet ).expectedAcceleration[ body1 ][ body2 ][
+                                zonalCoefficientIterator->first ],
+                            computedAccelerationSum,
+                            1.0e-14 );
+                }
+            }
+        }
+    }
+}
+
+//! Test if general zonal gravity model matches spherical harmonics model for high degrees.
+BOOST_AUTO_TEST_CASE( testGravitationalAccelerationGeneralZonalModelHighDegree )
+{
+    // These tests check if the acceleration due to zonal terms up to J20 matches the acceleration
+    // computed with the general spherical harmonics model, for which the geodesy-normalized
+    // zonal cosine coefficients are given by -J_n / sqrt( 2n + 1 ) (Heiskanen & Moritz, 1967).
+
+    // Set gravitational parameter of Earth [m^3 s^-2].
+    const double gravitationalParameter = 3.986004418e14;
+
+    // Set equatorial radius of Earth [m].
+    const double equatorialRadius = 6378137.0;
+
+    // Set highest degree.
+    const int highestDegree = 20;
+
+    // Set unnormalized zonal coefficients. The coefficients are of realistic magnitude, but
+    // their values are not of importance for this test.
+    Eigen::VectorXd zonalCoefficients = Eigen::VectorXd::Zero( highestDegree + 1 );
+    zonalCoefficients( 2 ) = 1.082626683e-3;
+    for ( int degree = 3; degree <= highestDegree; degree++ )
+    {
+        zonalCoefficients( degree ) = ( ( degree % 2 == 0 ) ? 1.0 : -1.0 )
+                * 2.5e-6 / static_cast< double >( degree * degree );
+    }
+
+    // Set corresponding geodesy-normalized cosine and sine coefficients (order 0 only).
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( highestDegree + 1, 1 );
+    const Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( highestDegree + 1, 1 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for ( int degree = 2; degree <= highestDegree; degree++ )
+    {
+        cosineCoefficients( degree, 0 ) = -zonalCoefficients( degree )
+                / std::sqrt( static_cast< double >( 2 * degree + 1 ) );
+    }
+
+    // Set positions at which acceleration is tested [m].
+    std::vector< Eigen::Vector3d > positions;
+    positions.push_back( Eigen::Vector3d( 7.0e6, 8.0e6, 9.0e6 ) );
+    positions.push_back( Eigen::Vector3d( -6.8e6, 1.2e5, -3.0e5 ) );
+    positions.push_back( Eigen::Vector3d( 1.0e6, -2.0e6, 6.9e6 ) );
+    positions.push_back( Eigen::Vector3d( 4.2e7, 1.0e5, 2.0e6 ) );
+
+    for ( unsigned int i = 0; i < positions.size( ); i++ )
+    {
+        // Compute acceleration using general central + zonal model [m s^-2].
+        CentralZonalGravitationalAccelerationModel centralZonalGravity(
+                    boost::lambda::constant( positions.at( i ) ),
+                    gravitationalParameter, equatorialRadius, zonalCoefficients );
+
+        const Eigen::Vector3d computedAcceleration = centralZonalGravity.getAcceleration( );
+
+        // Compute acceleration using spherical harmonics model [m s^-2].
+        const Eigen::Vector3d expectedAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    positions.at( i ), gravitationalParameter, equatorialRadius,
+                    cosineCoefficients, sineCoefficients );
+
+        // Check that computed acceleration matches expected values.
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, computedAcceleration, 1.0e-12 );
+    }
+}
+
+//! Test if partial derivatives of central and zonal accelerations are computed correctly using
+//! automatic differentiation.
+BOOST_AUTO_TEST_CASE( testGravitationalAccelerationPartialDerivatives )
+{
+    // These tests check if the partial derivatives of the central and central + J2 accelerations
+    // w.r.t. the position and gravitational parameter, as computed by evaluating the models with
+    // automatic differentiation scalars, match the analytical (central) and central difference
+    // (J2) partial derivatives.
+
+    using basic_mathematics::AutoDiffScalarXd;
+    using basic_mathematics::createIndependentVariables;
+    using basic_mathematics::getPartialDerivatives;
+    using basic_mathematics::getValues;
+
+    // Typedef for position vector of automatic differentiation scalars.
+    typedef Eigen::Matrix< AutoDiffScalarXd, 3, 1 > AutoDiffVector3d;
+
+    // Set gravitational parameter of Earth [m^3 s^-2].
+    const double gravitationalParameter = 3.986004418e14;
+
+    // Set equatorial radius of Earth [m].
+    const double equatorialRadius = 6378137.0;
+
+    // Set unnormalized J2 coefficient of Earth [-].
+    const double j2Coefficient = 1.082626683e-3;
+
+    // Set position of body subject to acceleration [m].
+    const Eigen::Vector3d position( 7.0e6, -2.0e6, 3.5e6 );
+
+    // Set position and gravitational parameter as independent variables; the gravitational
+    // parameter is the fourth independent variable.
+    const AutoDiffVector3d automaticDifferentiationPosition
+            = createIndependentVariables< Eigen::VectorXd >( position, 4 );
+    const AutoDiffScalarXd automaticDifferentiationGravitationalParameter(
+                gravitationalParameter, 4, 3 );
+
+    // Compute central acceleration and partial derivatives using model class.
+    CentralGravitationalAccelerationModel< AutoDiffVector3d > centralGravity(
+                boost::lambda::constant( automaticDifferentiationPosition ),
+                automaticDifferentiationGravitationalParameter );
+    centralGravity.updateMembers( );
+    const AutoDiffVector3d centralAcceleration = centralGravity.getAcceleration( );
+
+    // Check that value of acceleration matches double-precision computation.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                computeGravitationalAcceleration( position, gravitationalParameter,
+                                              Eigen::Vector3d::Zero( ) ),
+                getValues( centralAcceleration ), std::numeric_limits< double >::epsilon( ) );
+
+    // Compute expected partial derivatives: -mu / r^3 ( I - 3 r r^T / r^2 ) w.r.t. position and
+    // a / mu w.r.t. gravitational parameter.
+    const double radius = position.norm( );
+    Eigen::Matrix< double, 3, 4 > expectedCentralPartials;
+    expectedCentralPartials.leftCols( 3 ) = -gravitationalParameter / std::pow( radius, 3.0 )
+            * ( Eigen::Matrix3d::Identity( )
+                - 3.0 * position * position.transpose( ) / ( radius * radius ) );
+    expectedCentralPartials.col( 3 )
+            = computeGravitationalAcceleration( position, gravitationalParameter,
+                                              Eigen::Vector3d::Zero( ) )
+            / gravitationalParameter;
+
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedCentralPartials,
+                                       getPartialDerivatives( centralAcceleration ), 1.0e-14 );
+
+    // Compute central + J2 acceleration and partial derivatives using model class.
+    CentralJ2GravitationalAccelerationModelTemplate< AutoDiffVector3d > centralJ2Gravity(
+                boost::lambda::constant( automaticDifferentiationPosition ),
+                automaticDifferentiationGravitationalParameter, equatorialRadius,
+                AutoDiffScalarXd( j2Coefficient ) );
+    centralJ2Gravity.updateMembers( );
+    const AutoDiffVector3d centralJ2Acceleration = centralJ2Gravity.getAcceleration( );
+    const Eigen::Matrix< double, 3, 4 > centralJ2Partials
+            = getPartialDerivatives( centralJ2Acceleration );
+
+    // Check that value of acceleration matches double-precision computation.
+    const Eigen::Vector3d expectedCentralJ2Acceleration
+            = computeGravitationalAcceleration( position, gravitationalParameter,
+                                              Eigen::Vector3d::Zero( ) )
+            + computeGravitationalAccelerationDueToJ2(
+                position, gravitationalParameter, equatorialRadius, j2Coefficient,
+                Eigen::Vector3d::Zero( ) );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedCentralJ2Acceleration,
+                                       getValues( centralJ2Acceleration ), 1.0e-15 );
+
+    // Check partial derivatives w.r.t. position against central differences.
+    const double positionStepSize = 1.0;
+    for ( int i = 0; i < 3; i++ )
+    {
+        Eigen::Vector3d perturbation = Eigen::Vector3d::Zero( );
+        perturbation( i ) = positionStepSize;
+
+        CentralJ2GravitationalAccelerationModel upperCentralJ2Gravity(
+                    boost::lambda::constant( Eigen::Vector3d( position + perturbation ) ),
+                    gravitationalParameter, equatorialRadius, j2Coefficient );
+        upperCentralJ2Gravity.updateMembers( );
+        CentralJ2GravitationalAccelerationModel lowerCentralJ2Gravity(
+                    boost::lambda::constant( Eigen::Vector3d( position - perturbation ) ),
+                    gravitationalParameter, equatorialRadius, j2Coefficient );
+        lowerCentralJ2Gravity.updateMembers( );
+
+        const Eigen::Vector3d numericalPartial
+                = ( upperCentralJ2Gravity.getAcceleration( )
+                    - lowerCentralJ2Gravity.getAcceleration( ) ) / ( 2.0 * positionStepSize );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( numericalPartial,
+                                           Eigen::Vector3d( centralJ2Partials.col( i ) ), 1.0e-8 );
+    }
+
+    // Check partial derivative w.r.t. gravitational parameter, w.r.t. which the acceleration is
+    // linear.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( Eigen::Vector3d( expectedCentralJ2Acceleration
+                                                        / gravitationalParameter ),
+                                       Eigen::Vector3d( centralJ2Partials.col( 3 ) ), 1.0e-14 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,255 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140205    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravitationalAccelerations.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace gravitation;
+
+//! Generate random cloud of bodies.
+void generateRandomBodies( const int numberOfBodies,
+                           CartesianVectorBlock& positionsOfBodies,
+                           Eigen::VectorXd& gravitationalParametersOfBodies )
+{
+    // Use fixed seed, so that the test is repeatable.
+    boost::mt19937 randomNumbergenerator( 42 );
+    boost::random::uniform_real_distribution< > distributionPositions( -1.0e7, 1.0e7 );
+    boost::variate_generator< boost::mt19937&, boost::random::uniform_real_distribution < > >
+            generateRandomPosition( randomNumbergenerator, distributionPositions );
+    boost::random::uniform_real_distribution< > distributionGravitationalParameters( 1.0, 1.0e3 );
+    boost::variate_generator< boost::mt19937&, boost::random::uniform_real_distribution < > >
+            generateRandomGravitationalParameter( randomNumbergenerator,
+                                                  distributionGravitationalParameters );
+
+    positionsOfBodies.resize( numberOfBodies, 3 );
+    gravitationalParametersOfBodies.resize( numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        positionsOfBodies( i, 0 ) = generateRandomPosition( );
+        positionsOfBodies( i, 1 ) = generateRandomPosition( );
+        positionsOfBodies( i, 2 ) = 0.1 * generateRandomPosition( );
+        gravitationalParametersOfBodies( i ) = generateRandomGravitationalParameter( );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_n_body_gravitational_accelerations )
+
+//! Test if direct summation matches pairwise evaluation of central gravity.
+BOOST_AUTO_TEST_CASE( testDirectSummationAgainstPairwiseEvaluation )
+{
+    // Set positions [m] and gravitational parameters [m^3 s^-2] of Sun, Earth, Moon, Mars and
+    // Jupiter (approximate values; only consistency is tested).
+    CartesianVectorBlock positionsOfBodies( 5, 3 );
+    positionsOfBodies << 0.0, 0.0, 0.0,
+            1.496e11, 0.0, 0.0,
+            1.496e11 + 3.844e8, 1.0e7, 3.0e7,
+            -2.0e11, 1.2e11, 5.0e9,
+            3.0e11, -7.2e11, -1.0e10;
+
+    Eigen::VectorXd gravitationalParametersOfBodies( 5 );
+    gravitationalParametersOfBodies << 1.32712440018e20, 3.986004418e14, 4.9048695e12,
+            4.282837e13, 1.26686534e17;
+
+    // Compute accelerations by direct summation.
+    const CartesianVectorBlock computedAccelerations = computeMutualGravitationalAccelerations(
+                positionsOfBodies, gravitationalParametersOfBodies );
+
+    // Compute expected accelerations by summing central gravitational accelerations pairwise.
+    for ( int i = 0; i < positionsOfBodies.rows( ); i++ )
+    {
+        Eigen::Vector3d expectedAcceleration = Eigen::Vector3d::Zero( );
+        for ( int j = 0; j < positionsOfBodies.rows( ); j++ )
+        {
+            if ( j != i )
+            {
+                expectedAcceleration += computeGravitationalAcceleration(
+                            positionsOfBodies.row( i ).transpose( ),
+                            gravitationalParametersOfBodies( j ),
+                            positionsOfBodies.row( j ).transpose( ) );
+            }
+        }
+
+        const Eigen::Vector3d computedAcceleration = computedAccelerations.row( i ).transpose( );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, computedAcceleration, 1.0e-14 );
+    }
+}
+
+//! Test if direct summation conserves linear momentum.
+BOOST_AUTO_TEST_CASE( testDirectSummationMomentumConservation )
+{
+    // Generate random bodies.
+    CartesianVectorBlock positionsOfBodies;
+    Eigen::VectorXd gravitationalParametersOfBodies;
+    generateRandomBodies( 500, positionsOfBodies, gravitationalParametersOfBodies );
+
+    // Compute accelerations by direct summation.
+    const CartesianVectorBlock computedAccelerations = computeMutualGravitationalAccelerations(
+                positionsOfBodies, gravitationalParametersOfBodies );
+
+    // Check that the sum of all mass-weighted accelerations is zero (Newton's third law), relative
+    // to the magnitude of the individual mass-weighted accelerations.
+    const Eigen::Vector3d totalWeightedAcceleration
+            = ( computedAccelerations.array( ).colwise( )
+                * gravitationalParametersOfBodies.array( ) ).colwise( ).sum( ).transpose( );
+    const double maximumWeightedAcceleration
+            = ( computedAccelerations.rowwise( ).norm( ).array( )
+                * gravitationalParametersOfBodies.array( ) ).maxCoeff( );
+
+    BOOST_CHECK_SMALL( totalWeightedAcceleration.norm( ) / maximumWeightedAcceleration,
+                       1.0e-12 );
+}
+
+//! Test if softening length is applied correctly.
+BOOST_AUTO_TEST_CASE( testDirectSummationSoftening )
+{
+    // Set two bodies.
+    CartesianVectorBlock positionsOfBodies( 2, 3 );
+    positionsOfBodies << 0.0, 0.0, 0.0,
+            3.0, 4.0, 0.0;
+    Eigen::VectorXd gravitationalParametersOfBodies( 2 );
+    gravitationalParametersOfBodies << 2.0, 5.0;
+
+    // Set softening length [m].
+    const double softeningLength = 1.0;
+
+    // Compute accelerations by direct summation, and using Barnes-Hut algorithm.
+    const CartesianVectorBlock computedAccelerations = computeMutualGravitationalAccelerations(
+                positionsOfBodies, gravitationalParametersOfBodies, softeningLength );
+    const CartesianVectorBlock computedAccelerationsBarnesHut
+            = computeMutualGravitationalAccelerationsBarnesHut(
+                positionsOfBodies, gravitationalParametersOfBodies, 0.5, softeningLength );
+
+    // Set expected accelerations: distance is 5 m, so that softened distance cubed is 26^1.5.
+    CartesianVectorBlock expectedAccelerations( 2, 3 );
+    expectedAccelerations << 5.0 * 3.0, 5.0 * 4.0, 0.0,
+            -2.0 * 3.0, -2.0 * 4.0, 0.0;
+    expectedAccelerations /= std::pow( 26.0, 1.5 );
+
+    BOOST_CHECK_SMALL( ( computedAccelerations - expectedAccelerations ).norm( ), 1.0e-15 );
+    BOOST_CHECK_SMALL( ( computedAccelerationsBarnesHut - expectedAccelerations ).norm( ),
+                       1.0e-15 );
+}
+
+//! Test if Barnes-Hut algorithm with zero opening angle matches direct summation.
+BOOST_AUTO_TEST_CASE( testBarnesHutZeroOpeningAngle )
+{
+    // Generate random bodies.
+    CartesianVectorBlock positionsOfBodies;
+    Eigen::VectorXd gravitationalParametersOfBodies;
+    generateRandomBodies( 300, positionsOfBodies, gravitationalParametersOfBodies );
+
+    // Compute accelerations by direct summation, and using Barnes-Hut algorithm with zero opening
+    // angle (i.e., all cells are opened).
+    const CartesianVectorBlock expectedAccelerations = computeMutualGravitationalAccelerations(
+                positionsOfBodies, gravitationalParametersOfBodies );
+    const CartesianVectorBlock computedAccelerations
+            = computeMutualGravitationalAccelerationsBarnesHut(
+                positionsOfBodies, gravitationalParametersOfBodies, 0.0 );
+
+    // Check that results match (only difference is summation order).
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAccelerations, computedAccelerations, 1.0e-10 );
+}
+
+//! Test if Barnes-Hut algorithm approximates direct summation for large number of bodies.
+BOOST_AUTO_TEST_CASE( testBarnesHutApproximation )
+{
+    // Generate random bodies.
+    CartesianVectorBlock positionsOfBodies;
+    Eigen::VectorXd gravitationalParametersOfBodies;
+    generateRandomBodies( 2000, positionsOfBodies, gravitationalParametersOfBodies );
+
+    // Compute accelerations by direct summation, and using Barnes-Hut algorithm.
+    const CartesianVectorBlock expectedAccelerations = computeMutualGravitationalAccelerations(
+                positionsOfBodies, gravitationalParametersOfBodies );
+
+    const BarnesHutOctree octree( positionsOfBodies, gravitationalParametersOfBodies );
+    BOOST_CHECK_GT( octree.getNumberOfCells( ), 1 );
+
+    // Check that relative error of each acceleration is within expected bounds for an opening
+    // angle of 0.3, and that the root-mean-square relative error is well below that. Note that
+    // the relative errors are relatively large for bodies near the center of the cloud, for which
+    // the contributions of the surrounding bodies largely cancel.
+    double sumOfSquaredRelativeErrors = 0.0;
+    for ( int i = 0; i < positionsOfBodies.rows( ); i++ )
+    {
+        const Eigen::Vector3d expectedAcceleration = expectedAccelerations.row( i ).transpose( );
+        const double relativeError
+                = ( octree.computeAccelerationOfBody( i, 0.3 ) - expectedAcceleration ).norm( )
+                / expectedAcceleration.norm( );
+        BOOST_CHECK_SMALL( relativeError, 2.0e-2 );
+        sumOfSquaredRelativeErrors += relativeError * relativeError;
+    }
+
+    BOOST_CHECK_SMALL( std::sqrt( sumOfSquaredRelativeErrors / positionsOfBodies.rows( ) ),
+                       5.0e-3 );
+
+    // Check that acceleration at an arbitrary position far outside the cloud matches the
+    // acceleration of a single point mass with the total gravitational parameter at the center
+    // of mass.
+    const Eigen::Vector3d farAwayPosition( 1.0e10, -2.0e10, 5.0e9 );
+    const Eigen::Vector3d centerOfMass
+            = ( positionsOfBodies.transpose( ) * gravitationalParametersOfBodies )
+            / gravitationalParametersOfBodies.sum( );
+    const Eigen::Vector3d expectedFarAwayAcceleration = computeGravitationalAcceleration(
+                farAwayPosition, gravitationalParametersOfBodies.sum( ), centerOfMass );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                expectedFarAwayAcceleration,
+                octree.computeAccelerationAtPosition( farAwayPosition, 0.5 ), 1.0e-12 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,279 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140226    S. Vermeer        File created.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'Halo' orbits, Celestial Mechanics, 32. 53-71,
+ *          1984.
+ *      Richardson, D.L. Analytic construction of periodic orbits about the collinear points,
+ *          Celestial Mechanics, 22(3), 241-253, 1980.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergy.h"
+#include "Tudat/Astrodynamics/Gravitation/periodicOrbitsCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Astrodynamics/Gravitation/propagationCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_periodic_orbits_circular_restricted_three_body_problem )
+
+using namespace gravitation::circular_restricted_three_body_problem;
+
+//! Mass parameter of Earth-Moon system.
+const double earthMoonMassParameter = 0.012150581623434;
+
+//! Get linear approximation of planar Lyapunov orbit around Earth-Moon L1.
+/*!
+ * Returns the free variables of the linear approximation of a planar Lyapunov orbit around the L1
+ * point of the Earth-Moon system, with given amplitude along the x-axis (Richardson, 1980). The
+ * x-location of L1 is 0.836915, the in-plane frequency is 2.334386 and the ratio of the y- and
+ * x-amplitudes is 3.586499.
+ * \param xAmplitude Amplitude along x-axis.
+ * \return Linear approximation of free variables ( x0, z0, vy0, T/2 ).
+ */
+Eigen::Vector4d getLinearLyapunovOrbitFreeVariables( const double xAmplitude )
+{
+    const double inPlaneFrequency = 2.3343858539843283;
+    return Eigen::Vector4d( 0.8369151453865002 - xAmplitude, 0.0,
+                            3.5864992227534436 * xAmplitude * inPlaneFrequency,
+                            3.141592653589793 / inPlaneFrequency );
+}
+
+//! Check that free variables describe a periodic orbit.
+/*!
+ * Checks that the free variables describe a periodic orbit, by propagating the initial state over
+ * one period.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param freeVariables Free variables of periodic orbit.
+ */
+void checkPeriodicOrbit( const double massParameter, const Eigen::Vector4d& freeVariables )
+{
+    const basic_mathematics::Vector6d initialState
+            = getPeriodicOrbitInitialState( freeVariables );
+    const basic_mathematics::Vector6d finalState
+            = propagateCircularRestrictedThreeBodyProblemState(
+                massParameter, initialState,
+                2.0 * freeVariables( halfPeriodFreeVariableIndex ) );
+
+    BOOST_CHECK_SMALL( ( finalState - initialState ).norm( ), 1.0e-9 );
+}
+
+//! Test differential correction of planar Lyapunov and Halo orbits.
+BOOST_AUTO_TEST_CASE( testPeriodicOrbitCorrection )
+{
+    // Correct planar Lyapunov orbit around Earth-Moon L1 from linear approximation, with fixed
+    // x-position.
+    {
+        const PeriodicOrbitContinuation periodicOrbitContinuation( earthMoonMassParameter );
+        const Eigen::Vector4d initialGuess = getLinearLyapunovOrbitFreeVariables( 0.01 );
+        const Eigen::Vector4d lyapunovOrbit = periodicOrbitContinuation.correctPeriodicOrbit(
+                    initialGuess, xPositionFreeVariableIndex );
+
+        BOOST_CHECK_EQUAL( lyapunovOrbit( xPositionFreeVariableIndex ),
+                           initialGuess( xPositionFreeVariableIndex ) );
+        BOOST_CHECK_EQUAL( lyapunovOrbit( zPositionFreeVariableIndex ), 0.0 );
+        BOOST_CHECK_CLOSE_FRACTION( lyapunovOrbit( yVelocityFreeVariableIndex ),
+                                    initialGuess( yVelocityFreeVariableIndex ), 1.0e-1 );
+        BOOST_CHECK_CLOSE_FRACTION( lyapunovOrbit( halfPeriodFreeVariableIndex ),
+                                    initialGuess( halfPeriodFreeVariableIndex ), 2.0e-2 );
+        checkPeriodicOrbit( earthMoonMassParameter, lyapunovOrbit );
+    }
+
+    // Correct Halo orbit around L1, with fixed z-position, and compare with (Howell, 1984).
+    {
+        const double massParameter = 0.04;
+        const PeriodicOrbitContinuation periodicOrbitContinuation( massParameter );
+        const Eigen::Vector4d initialGuess( 0.72, 0.04, 0.2, 1.3 );
+        const Eigen::Vector4d haloOrbit = periodicOrbitContinuation.correctPeriodicOrbit(
+                    initialGuess, zPositionFreeVariableIndex );
+
+        BOOST_CHECK_SMALL( haloOrbit( xPositionFreeVariableIndex ) - 0.723268, 1.0e-6 );
+        BOOST_CHECK_EQUAL( haloOrbit( zPositionFreeVariableIndex ), 0.04 );
+        BOOST_CHECK_SMALL( haloOrbit( yVelocityFreeVariableIndex ) - 0.198019, 1.0e-6 );
+        BOOST_CHECK_SMALL( haloOrbit( halfPeriodFreeVariableIndex ) - 1.300177, 1.0e-6 );
+        checkPeriodicOrbit( massParameter, haloOrbit );
+
+        // Correct same initial guess with minimum-norm update.
+        checkPeriodicOrbit( massParameter,
+                            periodicOrbitContinuation.correctPeriodicOrbit( initialGuess ) );
+    }
+
+    // Check that invalid input throws an exception.
+    const PeriodicOrbitContinuation periodicOrbitContinuation( earthMoonMassParameter );
+    bool isExceptionThrown = false;
+    try
+    {
+        periodicOrbitContinuation.correctPeriodicOrbit( getLinearLyapunovOrbitFreeVariables( 0.01 ),
+                                                        4 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Check that non-converging correction throws an exception.
+    isExceptionThrown = false;
+    try
+    {
+        periodicOrbitContinuation.correctPeriodicOrbit( Eigen::Vector4d( 0.5, 0.0, 0.1, -1.0 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+//! Test correction of shooting grid of initial guesses, with and without parallel task pool.
+BOOST_AUTO_TEST_CASE( testShootingGridCorrection )
+{
+    // Set shooting grid of initial guesses from linear approximation, including one guess that
+    // cannot converge (negative half-period).
+    PeriodicOrbitFreeVariablesList initialGuesses;
+    for ( unsigned int i = 0; i < 8; i++ )
+    {
+        initialGuesses.push_back( getLinearLyapunovOrbitFreeVariables( 0.002 + 0.002 * i ) );
+    }
+    initialGuesses.push_back( Eigen::Vector4d( 0.8, 0.0, 0.1, -1.0 ) );
+
+    // Correct initial guesses serially and concurrently.
+    const PeriodicOrbitContinuation serialContinuation( earthMoonMassParameter );
+    const PeriodicOrbitContinuation concurrentContinuation(
+                earthMoonMassParameter,
+                boost::make_shared< basics::ParallelTaskPool >( 4 ) );
+
+    std::vector< bool > serialConvergenceFlags, concurrentConvergenceFlags;
+    const PeriodicOrbitFreeVariablesList serialOrbits
+            = serialContinuation.correctPeriodicOrbits(
+                initialGuesses, serialConvergenceFlags, xPositionFreeVariableIndex );
+    const PeriodicOrbitFreeVariablesList concurrentOrbits
+            = concurrentContinuation.correctPeriodicOrbits(
+                initialGuesses, concurrentConvergenceFlags, xPositionFreeVariableIndex );
+
+    // Check that results are identical, and that all but the last guess have converged.
+    BOOST_REQUIRE_EQUAL( serialOrbits.size( ), initialGuesses.size( ) );
+    BOOST_REQUIRE_EQUAL( concurrentOrbits.size( ), initialGuesses.size( ) );
+    BOOST_REQUIRE_EQUAL( serialConvergenceFlags.size( ), initialGuesses.size( ) );
+    BOOST_REQUIRE_EQUAL( concurrentConvergenceFlags.size( ), initialGuesses.size( ) );
+    for ( unsigned int i = 0; i < initialGuesses.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( serialConvergenceFlags[ i ], i + 1 < initialGuesses.size( ) );
+        BOOST_CHECK_EQUAL( concurrentConvergenceFlags[ i ], serialConvergenceFlags[ i ] );
+        for ( int j = 0; j < 4; j++ )
+        {
+            BOOST_CHECK_EQUAL( concurrentOrbits[ i ]( j ), serialOrbits[ i ]( j ) );
+        }
+    }
+
+    // Check that converged orbits are periodic, and that non-converged guess is unchanged.
+    for ( unsigned int i = 0; i + 1 < initialGuesses.size( ); i++ )
+    {
+        checkPeriodicOrbit( earthMoonMassParameter, serialOrbits[ i ] );
+    }
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( serialOrbits.back( ), initialGuesses.back( ),
+                                       std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test pseudo-arclength continuation of planar Lyapunov family, with and without parallel task
+//! pool.
+BOOST_AUTO_TEST_CASE( testPeriodicOrbitFamilyContinuation )
+{
+    const double stepLength = 5.0e-3;
+    const unsigned int numberOfMembers = 12;
+
+    const PeriodicOrbitContinuation serialContinuation( earthMoonMassParameter );
+    const PeriodicOrbitContinuation concurrentContinuation(
+                earthMoonMassParameter,
+                boost::make_shared< basics::ParallelTaskPool >( 3 ) );
+
+    // Correct first member, and continue family towards larger amplitudes (decreasing x0).
+    const Eigen::Vector4d firstMember = serialContinuation.correctPeriodicOrbit(
+                getLinearLyapunovOrbitFreeVariables( 0.002 ), xPositionFreeVariableIndex );
+    const Eigen::Vector4d direction( -1.0, 0.0, 0.0, 0.0 );
+
+    for ( unsigned int test = 0; test < 2; test++ )
+    {
+        const PeriodicOrbitFreeVariablesList familyMembers = ( test == 0 )
+                ? serialContinuation.continuePeriodicOrbitFamily(
+                      firstMember, direction, stepLength, numberOfMembers )
+                : concurrentContinuation.continuePeriodicOrbitFamily(
+                      firstMember, direction, stepLength, numberOfMembers );
+
+        BOOST_REQUIRE_EQUAL( familyMembers.size( ), numberOfMembers );
+        BOOST_CHECK_EQUAL( familyMembers.front( ), firstMember );
+
+        for ( unsigned int i = 1; i < numberOfMembers; i++ )
+        {
+            // Check that members are periodic and planar.
+            checkPeriodicOrbit( earthMoonMassParameter, familyMembers[ i ] );
+            BOOST_CHECK_SMALL( familyMembers[ i ]( zPositionFreeVariableIndex ), 1.0e-12 );
+
+            // Check that members are spaced by (approximately) the step length, and that the
+            // amplitude increases and the Jacobi energy decreases monotonically along the family.
+            BOOST_CHECK_CLOSE_FRACTION(
+                        ( familyMembers[ i ] - familyMembers[ i - 1 ] ).norm( ), stepLength,
+                        1.0e-2 );
+            BOOST_CHECK_LT( familyMembers[ i ]( xPositionFreeVariableIndex ),
+                            familyMembers[ i - 1 ]( xPositionFreeVariableIndex ) );
+            BOOST_CHECK_LT( computeJacobiEnergy(
+                                earthMoonMassParameter,
+                                getPeriodicOrbitInitialState( familyMembers[ i ] ) ),
+                            computeJacobiEnergy(
+                                earthMoonMassParameter,
+                                getPeriodicOrbitInitialState( familyMembers[ i - 1 ] ) ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,259 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140226    S. Vermeer        File created.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'Halo' orbits, Celestial Mechanics, 32. 53-71,
+ *          1984.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergy.h"
+#include "Tudat/Astrodynamics/Gravitation/propagationCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_propagation_circular_restricted_three_body_problem )
+
+using namespace gravitation::circular_restricted_three_body_problem;
+
+//! Get initial state on Halo orbit around L1 (Howell, 1984).
+basic_mathematics::Vector6d getInitialStateOnHaloOrbit( )
+{
+    basic_mathematics::Vector6d initialStateOnHaloOrbit = basic_mathematics::Vector6d::Zero( );
+    initialStateOnHaloOrbit( xPositionIndex ) = 0.723268;
+    initialStateOnHaloOrbit( zPositionIndex ) = 0.04;
+    initialStateOnHaloOrbit( yVelocityIndex ) = 0.198019;
+    return initialStateOnHaloOrbit;
+}
+
+//! Test derivative of state transition matrix against numerical differentiation.
+BOOST_AUTO_TEST_CASE( testStateTransitionMatrixDerivative )
+{
+    const double massParameter = 0.04;
+
+    // Set state and arbitrary (non-identity) state transition matrix.
+    basic_mathematics::Vector6d state;
+    state << 0.5, 0.3, -0.1, 0.2, -0.4, 0.05;
+    const basic_mathematics::Matrix6d stateTransitionMatrix
+            = basic_mathematics::Matrix6d::Identity( )
+            + 0.1 * basic_mathematics::Matrix6d::Random( );
+
+    Vector42d stateAndStateTransitionMatrix;
+    stateAndStateTransitionMatrix.segment( 0, 6 ) = state;
+    for ( int column = 0; column < 6; column++ )
+    {
+        stateAndStateTransitionMatrix.segment( 6 + 6 * column, 6 )
+                = stateTransitionMatrix.col( column );
+    }
+
+    const Vector42d stateAndStateTransitionMatrixDerivative
+            = computeCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrixDerivative(
+                massParameter, stateAndStateTransitionMatrix );
+
+    // Compute Jacobian of state derivative by central differences.
+    basic_mathematics::Matrix6d stateDerivativeJacobian;
+    const double statePerturbation = 1.0e-6;
+    for ( int i = 0; i < 6; i++ )
+    {
+        basic_mathematics::Vector6d perturbedState = state;
+        perturbedState( i ) += statePerturbation;
+        const basic_mathematics::Vector6d upperStateDerivative
+                = computeCircularRestrictedThreeBodyProblemStateDerivative( massParameter,
+                                                                            perturbedState );
+        perturbedState( i ) -= 2.0 * statePerturbation;
+        const basic_mathematics::Vector6d lowerStateDerivative
+                = computeCircularRestrictedThreeBodyProblemStateDerivative( massParameter,
+                                                                            perturbedState );
+        stateDerivativeJacobian.col( i ) = ( upperStateDerivative - lowerStateDerivative )
+                / ( 2.0 * statePerturbation );
+    }
+
+    // Check state derivative and derivative of state transition matrix.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                basic_mathematics::Vector6d(
+                    stateAndStateTransitionMatrixDerivative.segment( 0, 6 ) ),
+                computeCircularRestrictedThreeBodyProblemStateDerivative( massParameter, state ),
+                1.0e-15 );
+
+    const basic_mathematics::Matrix6d expectedStateTransitionMatrixDerivative
+            = stateDerivativeJacobian * stateTransitionMatrix;
+    for ( int column = 0; column < 6; column++ )
+    {
+        for ( int row = 0; row < 6; row++ )
+        {
+            BOOST_CHECK_SMALL( stateAndStateTransitionMatrixDerivative( 6 + 6 * column + row )
+                               - expectedStateTransitionMatrixDerivative( row, column ), 1.0e-8 );
+        }
+    }
+}
+
+//! Test propagation of state and state transition matrix on Halo orbit.
+BOOST_AUTO_TEST_CASE( testPropagationOfStateAndStateTransitionMatrix )
+{
+    // Set mass parameter and half-period of Halo orbit (Howell, 1984).
+    const double massParameter = 0.04;
+    const double halfPeriod = 1.300177;
+    const basic_mathematics::Vector6d initialState = getInitialStateOnHaloOrbit( );
+
+    // Propagate state over one period, and check that orbit is closed and Jacobi energy is
+    // conserved. The tolerance on closure is limited by the precision of the initial state.
+    const basic_mathematics::Vector6d finalState
+            = propagateCircularRestrictedThreeBodyProblemState(
+                massParameter, initialState, 2.0 * halfPeriod );
+
+    BOOST_CHECK_SMALL( ( finalState - initialState ).segment( 0, 3 ).norm( ), 1.0e-3 );
+    BOOST_CHECK_CLOSE_FRACTION( computeJacobiEnergy( massParameter, finalState ),
+                                computeJacobiEnergy( massParameter, initialState ), 1.0e-13 );
+
+    // Propagate backwards, and check that initial state is recovered.
+    BOOST_CHECK_SMALL( ( propagateCircularRestrictedThreeBodyProblemState(
+                             massParameter, finalState, -2.0 * halfPeriod )
+                         - initialState ).norm( ), 1.0e-11 );
+
+    // Propagate state and state transition matrix over half a period.
+    const std::pair< basic_mathematics::Vector6d, basic_mathematics::Matrix6d >
+            stateAndStateTransitionMatrix
+            = propagateCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrix(
+                massParameter, initialState, halfPeriod );
+
+    // Check that state agrees with state propagated without state transition matrix.
+    BOOST_CHECK_SMALL( ( stateAndStateTransitionMatrix.first
+                         - propagateCircularRestrictedThreeBodyProblemState(
+                             massParameter, initialState, halfPeriod ) ).norm( ), 1.0e-13 );
+
+    // Check that state transition matrix has unit determinant (Liouville's theorem).
+    BOOST_CHECK_CLOSE_FRACTION( stateAndStateTransitionMatrix.second.determinant( ), 1.0,
+                                1.0e-10 );
+
+    // Check state transition matrix against central differences of propagated states.
+    const double statePerturbation = 1.0e-7;
+    for ( int i = 0; i < 6; i++ )
+    {
+        basic_mathematics::Vector6d perturbedInitialState = initialState;
+        perturbedInitialState( i ) += statePerturbation;
+        const basic_mathematics::Vector6d upperFinalState
+                = propagateCircularRestrictedThreeBodyProblemState(
+                    massParameter, perturbedInitialState, halfPeriod );
+        perturbedInitialState( i ) -= 2.0 * statePerturbation;
+        const basic_mathematics::Vector6d lowerFinalState
+                = propagateCircularRestrictedThreeBodyProblemState(
+                    massParameter, perturbedInitialState, halfPeriod );
+
+        const basic_mathematics::Vector6d numericalStateTransitionMatrixColumn
+                = ( upperFinalState - lowerFinalState ) / ( 2.0 * statePerturbation );
+
+        for ( int row = 0; row < 6; row++ )
+        {
+            BOOST_CHECK_SMALL( stateAndStateTransitionMatrix.second( row, i )
+                               - numericalStateTransitionMatrixColumn( row ), 1.0e-6 );
+        }
+    }
+}
+
+//! Test batch propagation, with and without parallel task pool.
+BOOST_AUTO_TEST_CASE( testBatchPropagation )
+{
+    const double massParameter = 0.04;
+
+    // Set list of perturbed initial states on Halo orbit, with different propagation times.
+    CartesianStatesList initialStates;
+    std::vector< double > propagationTimes;
+    for ( unsigned int i = 0; i < 16; i++ )
+    {
+        basic_mathematics::Vector6d initialState = getInitialStateOnHaloOrbit( );
+        initialState( xPositionIndex ) += 1.0e-3 * i;
+        initialStates.push_back( initialState );
+        propagationTimes.push_back( 0.5 + 0.1 * i );
+    }
+
+    // Propagate serially and concurrently.
+    const CartesianStatesList serialFinalStates
+            = propagateCircularRestrictedThreeBodyProblemStates(
+                massParameter, initialStates, propagationTimes );
+    const CartesianStatesList concurrentFinalStates
+            = propagateCircularRestrictedThreeBodyProblemStates(
+                massParameter, initialStates, propagationTimes, 1.0e-14,
+                boost::make_shared< basics::ParallelTaskPool >( 4 ) );
+
+    // Check that results are identical to single propagations.
+    BOOST_REQUIRE_EQUAL( serialFinalStates.size( ), initialStates.size( ) );
+    BOOST_REQUIRE_EQUAL( concurrentFinalStates.size( ), initialStates.size( ) );
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        const basic_mathematics::Vector6d expectedFinalState
+                = propagateCircularRestrictedThreeBodyProblemState(
+                    massParameter, initialStates[ i ], propagationTimes[ i ] );
+        for ( int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_EQUAL( serialFinalStates[ i ]( j ), expectedFinalState( j ) );
+            BOOST_CHECK_EQUAL( concurrentFinalStates[ i ]( j ), expectedFinalState( j ) );
+        }
+    }
+
+    // Check that inconsistent input throws an exception.
+    propagationTimes.pop_back( );
+    bool isExceptionThrown = false;
+    try
+    {
+        propagateCircularRestrictedThreeBodyProblemStates(
+                    massParameter, initialStates, propagationTimes );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -26,6 +26,10 @@
  *      YYMMDD    Author            Comment
  *      121017    E. Dekens         Created file.
  *      121022    K. Kumar          Added unit test for wrapper class.
+ *      140221    S. Vermeer        Added unit test for partial derivatives computed using
+ *                                  automatic differentiation.
+ *      140415    S. Vermeer        Added check that wrapper class reproduces double-precision
+ *                                  function exactly.
  *
  *    References
  *      Mathworks. gravitysphericalharmonic, Implement spherical harmonic representation of
@@ -57,6 +61,7 @@
 #include <TudatCore/Basics/testMacros.h>
 
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Mathematics/BasicMathematics/automaticDifferentiation.h"
 
 namespace tudat
 {
@@ -309,6 +314,94 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationWrapperCla
 
     // Check if expected result matches computed result.
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, acceleration, 1.0e-15 );
+
+    // Check that the class computes exactly the result of the double-precision function.
+    const Eigen::Vector3d functionAcceleration
+            = computeGeodesyNormalizedGravitationalAccelerationSum(
+                position, gravitationalParameter, planetaryRadius,
+                cosineCoefficients, sineCoefficients );
+    TUDAT_CHECK_MATRIX_BASE( functionAcceleration, acceleration )
+            BOOST_CHECK_EQUAL( functionAcceleration.coeff( row, col ),
+                               acceleration.coeff( row, col ) );
+}
+
+// Check the partial derivatives of the sum of all harmonics terms up to degree = 3 and order = 3,
+// computed using automatic differentiation, against central differences.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationPartialDerivatives )
+{
+    // Short-cuts.
+    using namespace gravitation;
+    using basic_mathematics::AutoDiffScalar3d;
+    using basic_mathematics::createIndependentVariables;
+    using basic_mathematics::getPartialDerivatives;
+    using basic_mathematics::getValues;
+
+    // Typedef for position vector of automatic differentiation scalars.
+    typedef Eigen::Matrix< AutoDiffScalar3d, 3, 1 > AutoDiffVector3d;
+
+    // Define gravitational parameter of Earth [m^3 s^-2].
+    const double gravitationalParameter = 3.986004418e14;
+
+    // Define radius of Earth [m].
+    const double planetaryRadius = 6378137.0;
+
+    // Define geodesy-normalized coefficients up to degree 3 and order 3 (Mathworks, 2012).
+    const Eigen::MatrixXd cosineCoefficients =
+            ( Eigen::MatrixXd( 4, 4 ) <<
+              1.0, 0.0, 0.0, 0.0,
+              0.0, 0.0, 0.0, 0.0,
+              -4.841651437908150e-4, -2.066155090741760e-10, 2.439383573283130e-6, 0.0,
+              9.571612070934730e-7, 2.030462010478640e-6, 9.047878948095281e-7,
+              7.213217571215680e-7 ).finished( );
+
+    const Eigen::MatrixXd sineCoefficients =
+            ( Eigen::MatrixXd( 4, 4 ) <<
+              0.0, 0.0, 0.0, 0.0,
+              0.0, 0.0, 0.0, 0.0,
+              0.0, 1.384413891379790e-9, -1.400273703859340e-6, 0.0,
+              0.0, 2.482004158568720e-7, -6.190054751776180e-7, 1.414349261929410e-6
+              ).finished( );
+
+    // Define arbitrary Cartesian position [m].
+    const Eigen::Vector3d position( 7.0e6, 8.0e6, 9.0e6 );
+
+    // Compute acceleration and partial derivatives w.r.t. position using wrapper class.
+    SphericalHarmonicsGravitationalAccelerationModel< Eigen::MatrixXd, AutoDiffVector3d >
+            earthGravity( boost::lambda::constant(
+                              createIndependentVariables< Eigen::Vector3d >( position, 3 ) ),
+                          AutoDiffScalar3d( gravitationalParameter ), planetaryRadius,
+                          cosineCoefficients, sineCoefficients );
+    earthGravity.updateMembers( );
+    const AutoDiffVector3d acceleration = earthGravity.getAcceleration( );
+
+    // Check that value of acceleration matches double-precision computation.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                computeGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients ),
+                getValues( acceleration ), 1.0e-15 );
+
+    // Check partial derivatives against central differences.
+    const double stepSize = 1.0;
+    const Eigen::Matrix3d partialDerivatives = getPartialDerivatives( acceleration );
+    for ( int i = 0; i < 3; i++ )
+    {
+        Eigen::Vector3d perturbation = Eigen::Vector3d::Zero( );
+        perturbation( i ) = stepSize;
+
+        const Eigen::Vector3d numericalPartialDerivative
+                = ( computeGeodesyNormalizedGravitationalAccelerationSum(
+                        Eigen::Vector3d( position + perturbation ), gravitationalParameter,
+                        planetaryRadius, cosineCoefficients, sineCoefficients )
+                    - computeGeodesyNormalizedGravitationalAccelerationSum(
+                        Eigen::Vector3d( position - perturbation ), gravitationalParameter,
+                        planetaryRadius, cosineCoefficients, sineCoefficients ) )
+                / ( 2.0 * stepSize );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                    numericalPartialDerivative,
+                    Eigen::Vector3d( partialDerivatives.col( i ) ), 1.0e-7 );
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END( )
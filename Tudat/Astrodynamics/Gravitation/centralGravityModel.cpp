@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      121105    K. Kumar          File created from code in gravitationalAccelerationModel.cpp.
+ *      140221    S. Vermeer        Gravitational acceleration now uses scalar-type template.
  *
  *    References
  *
@@ -60,10 +61,10 @@ Eigen::Vector3d computeGravitationalAcceleration(
         const double gravitationalParameterOfBodyExertingAcceleration,
         const Eigen::Vector3d& positionOfBodyExertingAcceleration )
 {
-    return -gravitationalParameterOfBodyExertingAcceleration
-            * ( positionOfBodySubjectToAcceleration - positionOfBodyExertingAcceleration )
-            / std::pow( ( positionOfBodySubjectToAcceleration
-                          - positionOfBodyExertingAcceleration ).norm( ), 3.0 );
+    return computeGravitationalAccelerationTemplate< double >(
+                positionOfBodySubjectToAcceleration,
+                gravitationalParameterOfBodyExertingAcceleration,
+                positionOfBodyExertingAcceleration );
 }
 
 //! Compute gravitational force.
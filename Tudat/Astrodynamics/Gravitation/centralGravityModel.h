@@ -32,6 +32,10 @@
  *      130224    K. Kumar          Updated include guard name.
  *      130225    K. Kumar          Fixed bug with constructor calling virtual function function;
  *                                  added override of updateMembers() function.
+ *      140221    S. Vermeer        Added scalar-type template of gravitational acceleration, to
+ *                                  allow automatic differentiation scalars.
+ *      140401    S. Vermeer        Renamed scalar-type template of gravitational acceleration, so
+ *                                  that it does not overload the double-precision function.
  *
  *    References
  *
@@ -42,6 +46,8 @@
 #ifndef TUDAT_CENTRAL_GRAVITY_MODEL_H
 #define TUDAT_CENTRAL_GRAVITY_MODEL_H
 
+#include <cmath>
+
 #include <boost/lambda/lambda.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -106,6 +112,35 @@ Eigen::Vector3d computeGravitationalAcceleration(
         const double gravitationalParameterOfBodyExertingAcceleration,
         const Eigen::Vector3d& positionOfBodyExertingAcceleration );
 
+//! Compute gravitational acceleration for arbitrary scalar type.
+/*!
+ * Computes gravitational acceleration experienced by body1, due to its interaction with body2, as
+ * described for the double-precision computeGravitationalAcceleration() function, for an
+ * arbitrary scalar type (for instance an automatic differentiation scalar, in which case the
+ * partial derivatives of the acceleration are obtained along with the acceleration).
+ * \tparam ScalarType Scalar type used for positions, gravitational parameter and acceleration.
+ * \param positionOfBodySubjectToAcceleration Position vector of body subject to acceleration
+ *          (body1) [m].
+ * \param gravitationalParameterOfBodyExertingAcceleration Gravitational parameter of body exerting
+ *          acceleration (body2) [m^3 s^-2].
+ * \param positionOfBodyExertingAcceleration Position vector of body exerting acceleration
+ *          (body2) [m].
+ * \return Gravitational acceleration exerted on body1 [m s^-2].
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeGravitationalAccelerationTemplate(
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfBodySubjectToAcceleration,
+        const ScalarType& gravitationalParameterOfBodyExertingAcceleration,
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfBodyExertingAcceleration )
+{
+    using std::pow;
+
+    const Eigen::Matrix< ScalarType, 3, 1 > relativePosition
+            = positionOfBodySubjectToAcceleration - positionOfBodyExertingAcceleration;
+    const ScalarType distanceCubed = pow( relativePosition.norm( ), 3.0 );
+    return -gravitationalParameterOfBodyExertingAcceleration * relativePosition / distanceCubed;
+}
+
 //! Compute gravitational force.
 /*!
  * Computes gravitational force experienced by body1, due to its interaction with body2.
@@ -192,7 +227,7 @@ public:
      */
     CentralGravitationalAccelerationModel(
             const typename Base::StateFunction positionOfBodySubjectToAccelerationFunction,
-            const double aGravitationalParameter,
+            const typename Base::ScalarType aGravitationalParameter,
             const typename Base::StateFunction positionOfBodyExertingAccelerationFunction
             = boost::lambda::constant( StateMatrix::Zero( ) ) )
         : Base( positionOfBodySubjectToAccelerationFunction,
@@ -205,13 +240,13 @@ public:
     //! Get gravitational acceleration.
     /*!
      * Returns the gravitational acceleration computed using the input parameters provided to the
-     * class. This function serves as a wrapper for the computeGravitationalAcceleration()
+     * class. This function serves as a wrapper for the computeGravitationalAccelerationTemplate()
      * function.
      * \return Computed gravitational acceleration vector.
      */
     StateMatrix getAcceleration( )
     {
-        return computeGravitationalAcceleration(
+        return computeGravitationalAccelerationTemplate(
                     this->positionOfBodySubjectToAcceleration,
                     this->gravitationalParameter,
                     this->positionOfBodyExertingAcceleration );
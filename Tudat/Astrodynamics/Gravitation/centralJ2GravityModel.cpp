@@ -26,6 +26,8 @@
  *      YYMMDD    Author            Comment
  *      121105    K. Kumar          File created from content in other files.
  *      121210    D. Dirkx          Added function implementations for class.
+ *      140221    S. Vermeer        J2 acceleration now uses scalar-type template; moved class
+ *                                  function implementation to header file.
  *
  *    References
  *
@@ -33,9 +35,6 @@
  *
  */
 
-#include <cmath>
-
-#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
 #include "Tudat/Astrodynamics/Gravitation/centralJ2GravityModel.h"
 
 namespace tudat
@@ -51,55 +50,12 @@ Eigen::Vector3d computeGravitationalAccelerationDueToJ2(
         const double j2CoefficientOfGravityField,
         const Eigen::Vector3d& positionOfBodyExertingAcceleration )
 {
-    // Set constant values reused for optimal computation of acceleration components.
-    const double distanceBetweenBodies = ( positionOfBodySubjectToAcceleration
-                                           - positionOfBodyExertingAcceleration ).norm( );
-
-    const double preMultiplier = -gravitationalParameterOfBodyExertingAcceleration
-            / std::pow( distanceBetweenBodies, 4.0 ) * 1.5 * j2CoefficientOfGravityField
-            * equatorialRadiusOfBodyExertingAcceleration
-            * equatorialRadiusOfBodyExertingAcceleration;
-
-    const double scaledZCoordinate = ( positionOfBodySubjectToAcceleration.z( )
-                                       - positionOfBodyExertingAcceleration.z( ) )
-            / distanceBetweenBodies;
-
-    const double scaledZCoordinateSquared = scaledZCoordinate * scaledZCoordinate;
-
-    const double factorForXAndYDirections = ( 1.0 - 5.0 * scaledZCoordinateSquared )
-            / distanceBetweenBodies;
-
-    // Compute components of acceleration due to J2-effect.
-    Eigen::Vector3d gravitationalAccelerationDueToJ2 = Eigen::Vector3d::Constant( preMultiplier );
-
-    gravitationalAccelerationDueToJ2( basic_astrodynamics::xCartesianPositionIndex )
-            *= ( positionOfBodySubjectToAcceleration.x( )
-                 - positionOfBodyExertingAcceleration.x( ) ) * factorForXAndYDirections;
-
-    gravitationalAccelerationDueToJ2( basic_astrodynamics::yCartesianPositionIndex )
-            *= ( positionOfBodySubjectToAcceleration.y( )
-                 - positionOfBodyExertingAcceleration.y( ) ) * factorForXAndYDirections;
-
-    gravitationalAccelerationDueToJ2( basic_astrodynamics::zCartesianPositionIndex )
-            *= ( 3.0 - 5.0 * scaledZCoordinateSquared ) * scaledZCoordinate;
-
-    return gravitationalAccelerationDueToJ2;
-}
-
-//! Get gravitational acceleration.
-Eigen::Vector3d CentralJ2GravitationalAccelerationModel::getAcceleration( )
-{
-    // Sum and return constituent acceleration terms.
-    return computeGravitationalAcceleration(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->positionOfBodyExertingAcceleration )
-            + computeGravitationalAccelerationDueToJ2(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->equatorialRadius,
-                this->j2GravityCoefficient,
-                this->positionOfBodyExertingAcceleration );
+    return computeGravitationalAccelerationDueToJ2Template< double >(
+                positionOfBodySubjectToAcceleration,
+                gravitationalParameterOfBodyExertingAcceleration,
+                equatorialRadiusOfBodyExertingAcceleration,
+                j2CoefficientOfGravityField,
+                positionOfBodyExertingAcceleration );
 }
 
 } // namespace gravitation
@@ -34,6 +34,13 @@
  *      130225    K. Kumar          Fixed bug with constructor calling virtual function function;
  *                                  updated free function order of arguments to match clss
  *                                  constructor; added override of updateMembers() function.
+ *      140221    S. Vermeer        Added scalar-type template of J2 acceleration; made class a
+ *                                  template on state matrix type, to allow automatic
+ *                                  differentiation scalars.
+ *      140401    S. Vermeer        Renamed class template and scalar-type template of J2
+ *                                  acceleration; restored CentralJ2GravitationalAccelerationModel
+ *                                  as typedef of double-precision model, so that existing code is
+ *                                  unaffected.
  *
  *    References
  *
@@ -44,10 +51,15 @@
 #ifndef TUDAT_CENTRAL_J2_GRAVITY_MODEL_H
 #define TUDAT_CENTRAL_J2_GRAVITY_MODEL_H
 
+#include <cmath>
+
 #include <boost/lambda/lambda.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <Eigen/Core>
+
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
 
@@ -93,19 +105,90 @@ Eigen::Vector3d computeGravitationalAccelerationDueToJ2(
         const double j2CoefficientOfGravityField,
         const Eigen::Vector3d& positionOfBodyExertingAcceleration );
 
-//! Central + J2 gravitational acceleration model class.
+//! Compute gravitational acceleration due to J2 for arbitrary scalar type.
+/*!
+ * Computes gravitational acceleration experienced by body1, due to the J2-coefficient of the
+ * gravity field of body2, as described for the double-precision
+ * computeGravitationalAccelerationDueToJ2() function, for an arbitrary scalar type (for instance
+ * an automatic differentiation scalar).
+ * \tparam ScalarType Scalar type used for positions, gravitational parameter, J2-coefficient and
+ *          acceleration.
+ * \param positionOfBodySubjectToAcceleration Position vector of body subject to J2-acceleration
+ *          (body1) [m].
+ * \param gravitationalParameterOfBodyExertingAcceleration Gravitational parameter of body exerting
+ *          acceleration (body2) [m^3 s^-2].
+ * \param equatorialRadiusOfBodyExertingAcceleration Equatorial radius of body exerting
+ *          acceleration (body2), in formulation of spherical harmonics expansion [m].
+ * \param j2CoefficientOfGravityField J2-coefficient, describing irregularity of the gravity field
+ *          of body2 [-].
+ * \param positionOfBodyExertingAcceleration Position vector of body exerting acceleration
+ *          (body2) [m].
+ * \return Gravitational acceleration exerted on body1 due to J2-effect [m s^-2].
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeGravitationalAccelerationDueToJ2Template(
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfBodySubjectToAcceleration,
+        const ScalarType& gravitationalParameterOfBodyExertingAcceleration,
+        const double equatorialRadiusOfBodyExertingAcceleration,
+        const ScalarType& j2CoefficientOfGravityField,
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfBodyExertingAcceleration )
+{
+    using std::pow;
+
+    // Set constant values reused for optimal computation of acceleration components.
+    const ScalarType distanceBetweenBodies = ( positionOfBodySubjectToAcceleration
+                                               - positionOfBodyExertingAcceleration ).norm( );
+
+    const ScalarType preMultiplier = -gravitationalParameterOfBodyExertingAcceleration
+            / pow( distanceBetweenBodies, 4.0 ) * 1.5 * j2CoefficientOfGravityField
+            * equatorialRadiusOfBodyExertingAcceleration
+            * equatorialRadiusOfBodyExertingAcceleration;
+
+    const ScalarType scaledZCoordinate = ( positionOfBodySubjectToAcceleration.z( )
+                                           - positionOfBodyExertingAcceleration.z( ) )
+            / distanceBetweenBodies;
+
+    const ScalarType scaledZCoordinateSquared = scaledZCoordinate * scaledZCoordinate;
+
+    const ScalarType factorForXAndYDirections = ( 1.0 - 5.0 * scaledZCoordinateSquared )
+            / distanceBetweenBodies;
+
+    // Compute components of acceleration due to J2-effect.
+    Eigen::Matrix< ScalarType, 3, 1 > gravitationalAccelerationDueToJ2
+            = Eigen::Matrix< ScalarType, 3, 1 >::Constant( preMultiplier );
+
+    gravitationalAccelerationDueToJ2( basic_astrodynamics::xCartesianPositionIndex )
+            *= ( positionOfBodySubjectToAcceleration.x( )
+                 - positionOfBodyExertingAcceleration.x( ) ) * factorForXAndYDirections;
+
+    gravitationalAccelerationDueToJ2( basic_astrodynamics::yCartesianPositionIndex )
+            *= ( positionOfBodySubjectToAcceleration.y( )
+                 - positionOfBodyExertingAcceleration.y( ) ) * factorForXAndYDirections;
+
+    gravitationalAccelerationDueToJ2( basic_astrodynamics::zCartesianPositionIndex )
+            *= ( 3.0 - 5.0 * scaledZCoordinateSquared ) * scaledZCoordinate;
+
+    return gravitationalAccelerationDueToJ2;
+}
+
+//! Central + J2 gravitational acceleration model class template.
 /*!
- * This class implements a gravitational acceleration model that includes the central and J2
- * (unnormalized coefficient of general spherical harmonics expansion) terms.
+ * This class template implements a gravitational acceleration model that includes the central and
+ * J2 (unnormalized coefficient of general spherical harmonics expansion) terms, for an arbitrary
+ * state matrix type (for instance one with automatic differentiation scalars). The
+ * double-precision model is available as CentralJ2GravitationalAccelerationModel.
+ * \tparam StateMatrix Data type for state matrix (default = Eigen::Vector3d). Its scalar type is
+ *          also used for the gravitational parameter and J2-coefficient.
  */
-class CentralJ2GravitationalAccelerationModel
-        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
-        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+template< typename StateMatrix = Eigen::Vector3d >
+class CentralJ2GravitationalAccelerationModelTemplate
+        : public basic_astrodynamics::AccelerationModel< StateMatrix >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< StateMatrix >
 {
 private:
 
     //! Typedef for base class.
-    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< StateMatrix > Base;
 
 public:
 
@@ -128,13 +211,13 @@ public:
      * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
      *          body exerting gravitational acceleration (default = (0,0,0)).
      */
-    CentralJ2GravitationalAccelerationModel(
-            const Base::StateFunction positionOfBodySubjectToAccelerationFunction,
-            const double aGravitationalParameter,
+    CentralJ2GravitationalAccelerationModelTemplate(
+            const typename Base::StateFunction positionOfBodySubjectToAccelerationFunction,
+            const typename Base::ScalarType aGravitationalParameter,
             const double anEquatorialRadius,
-            const double aJ2GravityCoefficient,
-            const Base::StateFunction positionOfBodyExertingAccelerationFunction
-            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+            const typename Base::ScalarType aJ2GravityCoefficient,
+            const typename Base::StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( StateMatrix::Zero( ) ) )
         : Base( positionOfBodySubjectToAccelerationFunction,
                 aGravitationalParameter,
                 positionOfBodyExertingAccelerationFunction ),
@@ -147,11 +230,11 @@ public:
     //! Get gravitational acceleration.
     /*!
      * Returns the gravitational acceleration computed using the input parameters provided to the
-     * class. This function serves as a wrapper for the computeGravitationalAcceleration() and
-     * computeGravitationalAccelerationDueToJ2() functions.
+     * class. This function serves as a wrapper for the computeGravitationalAccelerationTemplate()
+     * and computeGravitationalAccelerationDueToJ2Template() functions.
      * \return Computed gravitational acceleration vector.
      */
-    Eigen::Vector3d getAcceleration( );
+    StateMatrix getAcceleration( );
 
     //! Update members.
     /*!
@@ -174,15 +257,40 @@ protected:
     /*!
      * J2 coefficient of unnormalized spherical harmonics gravity field representation.
      */
-    const double j2GravityCoefficient;
+    const typename Base::ScalarType j2GravityCoefficient;
 
 private:
 };
 
+//! Typedef for double-precision central + J2 gravitational acceleration model.
+typedef CentralJ2GravitationalAccelerationModelTemplate< Eigen::Vector3d >
+CentralJ2GravitationalAccelerationModel;
+
 //! Typedef for shared-pointer to CentralJ2GravitationalAccelerationModel.
 typedef boost::shared_ptr< CentralJ2GravitationalAccelerationModel >
 CentralJ2GravitationalAccelerationModelPointer;
 
+// Template class source.
+// The code given below is effectively the ".cpp file" for the template class definition, so you
+// only need to look at the code below if you are interested in the source implementation.
+
+//! Get gravitational acceleration.
+template< typename StateMatrix >
+StateMatrix CentralJ2GravitationalAccelerationModelTemplate< StateMatrix >::getAcceleration( )
+{
+    // Sum and return constituent acceleration terms.
+    return computeGravitationalAccelerationTemplate(
+                this->positionOfBodySubjectToAcceleration,
+                this->gravitationalParameter,
+                this->positionOfBodyExertingAcceleration )
+            + computeGravitationalAccelerationDueToJ2Template(
+                this->positionOfBodySubjectToAcceleration,
+                this->gravitationalParameter,
+                this->equatorialRadius,
+                this->j2GravityCoefficient,
+                this->positionOfBodyExertingAcceleration );
+}
+
 } // namespace gravitation
 } // namespace tudat
 
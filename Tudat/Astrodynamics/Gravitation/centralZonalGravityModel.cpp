@@ -0,0 +1,193 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140203    S. Vermeer        File created.
+ *
+ *    References
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2000.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/Astrodynamics/Gravitation/centralZonalGravityModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Compute gravitational acceleration due to an arbitrary number of zonal terms.
+Eigen::Vector3d computeGravitationalAccelerationDueToZonalTerms(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameterOfBodyExertingAcceleration,
+        const double equatorialRadiusOfBodyExertingAcceleration,
+        const Eigen::VectorXd& zonalCoefficientsOfGravityField,
+        const Eigen::Vector3d& positionOfBodyExertingAcceleration )
+{
+    // Set highest degree of zonal terms.
+    const int highestDegree = zonalCoefficientsOfGravityField.rows( ) - 1;
+
+    // Set constant values reused for optimal computation of acceleration components.
+    const Eigen::Vector3d relativePosition = positionOfBodySubjectToAcceleration
+            - positionOfBodyExertingAcceleration;
+
+    const double distanceBetweenBodies = relativePosition.norm( );
+
+    const double scaledZCoordinate = relativePosition.z( ) / distanceBetweenBodies;
+
+    const double radiusRatio = equatorialRadiusOfBodyExertingAcceleration / distanceBetweenBodies;
+
+    // Initialize Legendre polynomials and their derivatives of degree 0 and 1, which are used to
+    // start the recursion.
+    double previousLegendrePolynomial = 1.0;
+    double legendrePolynomial = scaledZCoordinate;
+    double previousLegendrePolynomialDerivative = 0.0;
+    double legendrePolynomialDerivative = 1.0;
+
+    // Initialize radius ratio raised to the power of the current degree.
+    double radiusRatioToPowerOfDegree = radiusRatio;
+
+    // Declare sums of zonal contributions to horizontal and vertical acceleration components.
+    double sumForXAndYDirections = 0.0;
+    double sumForZDirection = 0.0;
+
+    // Loop over all degrees, updating the Legendre polynomials using the three-term recursion
+    // relation. At the start of each iteration, the polynomial of the current degree (and its
+    // derivative) is known; the next degree is computed, as it is required to evaluate the
+    // acceleration components.
+    for ( int degree = 1; degree <= highestDegree; degree++ )
+    {
+        // Compute Legendre polynomial derivative of degree + 1.
+        const double nextLegendrePolynomialDerivative
+                = previousLegendrePolynomialDerivative
+                + static_cast< double >( 2 * degree + 1 ) * legendrePolynomial;
+
+        // Add contribution of current degree (no zonal terms for degree 1).
+        if ( degree > 1 )
+        {
+            const double scaledZonalCoefficient
+                    = zonalCoefficientsOfGravityField( degree ) * radiusRatioToPowerOfDegree;
+
+            sumForXAndYDirections += scaledZonalCoefficient * nextLegendrePolynomialDerivative;
+            sumForZDirection += scaledZonalCoefficient
+                    * ( scaledZCoordinate * nextLegendrePolynomialDerivative
+                        - legendrePolynomialDerivative );
+        }
+
+        // Compute Legendre polynomial of degree + 1.
+        const double nextLegendrePolynomial
+                = ( static_cast< double >( 2 * degree + 1 ) * scaledZCoordinate
+                    * legendrePolynomial
+                    - static_cast< double >( degree ) * previousLegendrePolynomial )
+                / static_cast< double >( degree + 1 );
+
+        // Shift recursion variables to next degree.
+        previousLegendrePolynomial = legendrePolynomial;
+        legendrePolynomial = nextLegendrePolynomial;
+        previousLegendrePolynomialDerivative = legendrePolynomialDerivative;
+        legendrePolynomialDerivative = nextLegendrePolynomialDerivative;
+        radiusRatioToPowerOfDegree *= radiusRatio;
+    }
+
+    // Compute components of acceleration due to zonal terms.
+    const double preMultiplier = gravitationalParameterOfBodyExertingAcceleration
+            / ( distanceBetweenBodies * distanceBetweenBodies );
+
+    const double factorForXAndYDirections = preMultiplier * sumForXAndYDirections
+            / distanceBetweenBodies;
+
+    Eigen::Vector3d gravitationalAccelerationDueToZonalTerms;
+
+    gravitationalAccelerationDueToZonalTerms( basic_astrodynamics::xCartesianPositionIndex )
+            = relativePosition.x( ) * factorForXAndYDirections;
+
+    gravitationalAccelerationDueToZonalTerms( basic_astrodynamics::yCartesianPositionIndex )
+            = relativePosition.y( ) * factorForXAndYDirections;
+
+    gravitationalAccelerationDueToZonalTerms( basic_astrodynamics::zCartesianPositionIndex )
+            = preMultiplier * sumForZDirection;
+
+    return gravitationalAccelerationDueToZonalTerms;
+}
+
+//! Convert map of zonal coefficients to vector indexed by degree.
+Eigen::VectorXd convertZonalCoefficientMapToVector(
+        const std::map< int, double >& zonalCoefficientsOfGravityField )
+{
+    // Return vector without zonal terms if no coefficients are provided.
+    if ( zonalCoefficientsOfGravityField.empty( ) )
+    {
+        return Eigen::VectorXd::Zero( 2 );
+    }
+
+    // Check that lowest degree is at least 2, else throw an error.
+    if ( zonalCoefficientsOfGravityField.begin( )->first < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Degree of zonal coefficients must be 2 or higher." ) ) );
+    }
+
+    // Set vector of coefficients, with size determined by highest degree in map.
+    Eigen::VectorXd zonalCoefficients
+            = Eigen::VectorXd::Zero( zonalCoefficientsOfGravityField.rbegin( )->first + 1 );
+
+    for ( std::map< int, double >::const_iterator mapIterator
+          = zonalCoefficientsOfGravityField.begin( );
+          mapIterator != zonalCoefficientsOfGravityField.end( ); mapIterator++ )
+    {
+        zonalCoefficients( mapIterator->first ) = mapIterator->second;
+    }
+
+    return zonalCoefficients;
+}
+
+//! Get gravitational acceleration.
+Eigen::Vector3d CentralZonalGravitationalAccelerationModel::getAcceleration( )
+{
+    // Sum and return constituent acceleration terms.
+    return computeGravitationalAcceleration(
+                this->positionOfBodySubjectToAcceleration,
+                this->gravitationalParameter,
+                this->positionOfBodyExertingAcceleration )
+            + computeGravitationalAccelerationDueToZonalTerms(
+                this->positionOfBodySubjectToAcceleration,
+                this->gravitationalParameter,
+                this->equatorialRadius,
+                this->zonalCoefficients,
+                this->positionOfBodyExertingAcceleration );
+}
+
+} // namespace gravitation
+} // namespace tudat
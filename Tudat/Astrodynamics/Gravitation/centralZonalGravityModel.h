@@ -0,0 +1,220 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140203    S. Vermeer        File created.
+ *
+ *    References
+ *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2000.
+ *
+ *    Notes
+ *      The zonal terms are evaluated directly in Cartesian coordinates, using the standard
+ *      three-term recursion for the (unnormalized) Legendre polynomials and their derivatives.
+ *      No conversion to spherical coordinates or evaluation of tesseral terms is required, which
+ *      makes this model considerably cheaper than the general spherical harmonics model for
+ *      axially symmetric gravity fields.
+ *
+ */
+
+#ifndef TUDAT_CENTRAL_ZONAL_GRAVITY_MODEL_H
+#define TUDAT_CENTRAL_ZONAL_GRAVITY_MODEL_H
+
+#include <map>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Compute gravitational acceleration due to an arbitrary number of zonal terms.
+/*!
+ * Computes gravitational acceleration experienced by body1, due to its interaction with another
+ * body (body2) with an axially symmetric gravity field, described by unnormalized zonal
+ * coefficients \f$J_{n}\f$ up to arbitrary degree. The acceleration is evaluated in Cartesian
+ * coordinates as (Montenbruck & Gill, 2000):
+ * \f{eqnarray*}{
+ *      {a}_{gravity,x} &=& \frac{\mu_{2}}{r^{2}}\frac{x}{r}\sum\limits_{n=2}^{N} J_{n}
+ *                          \left(\frac{R}{r}\right)^{n} P'_{n+1}(\hat{z}) \\
+ *      {a}_{gravity,y} &=& \frac{\mu_{2}}{r^{2}}\frac{y}{r}\sum\limits_{n=2}^{N} J_{n}
+ *                          \left(\frac{R}{r}\right)^{n} P'_{n+1}(\hat{z}) \\
+ *      {a}_{gravity,z} &=& \frac{\mu_{2}}{r^{2}}\sum\limits_{n=2}^{N} J_{n}
+ *                          \left(\frac{R}{r}\right)^{n}
+ *                          \left( \hat{z} P'_{n+1}(\hat{z}) - P'_{n}(\hat{z}) \right) \\
+ * \f}
+ * where \f$\mu_{2}\f$ is the gravitational parameter of the body exerting acceleration,
+ * \f$\hat{z} = \frac{z}{r}\f$, \f$x\f$, \f$y\f$ and \f$z\f$ are the Cartesian position components
+ * relative to body2, \f$r\f$ is the radial position, \f$R\f$ is the equatorial radius, and
+ * \f$P'_{n}\f$ is the derivative of the Legendre polynomial of degree \f$n\f$. The Legendre
+ * polynomials and their derivatives are computed by recursion, so that the cost of this function
+ * scales linearly with the highest degree. The central term is NOT included. The positions and
+ * accelerations are given with respect to an inertial (barycentric) reference frame, the
+ * z-axis of which is aligned with the symmetry axis of the gravity field of body2.
+ * \param positionOfBodySubjectToAcceleration Position vector of body subject to acceleration
+ *          (body1) [m].
+ * \param gravitationalParameterOfBodyExertingAcceleration Gravitational parameter of body exerting
+ *          acceleration (body2) [m^3 s^-2].
+ * \param equatorialRadiusOfBodyExertingAcceleration Equatorial radius of body exerting
+ *          acceleration (body2), in formulation of spherical harmonics expansion [m].
+ * \param zonalCoefficientsOfGravityField Unnormalized zonal coefficients of the gravity field of
+ *          body2 [-]. The vector index indicates the degree, i.e., entry n contains \f$J_{n}\f$.
+ *          The entries for degree 0 and 1 are ignored.
+ * \param positionOfBodyExertingAcceleration Position vector of body exerting acceleration
+ *          (body2) [m].
+ * \return Gravitational acceleration exerted on body1 due to the zonal terms [m s^-2].
+ */
+Eigen::Vector3d computeGravitationalAccelerationDueToZonalTerms(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameterOfBodyExertingAcceleration,
+        const double equatorialRadiusOfBodyExertingAcceleration,
+        const Eigen::VectorXd& zonalCoefficientsOfGravityField,
+        const Eigen::Vector3d& positionOfBodyExertingAcceleration );
+
+//! Convert map of zonal coefficients to vector indexed by degree.
+/*!
+ * Converts a map of zonal coefficients, as used by computeGravitationalAccelerationZonalSum(), to
+ * a vector that is indexed by degree, as used by
+ * computeGravitationalAccelerationDueToZonalTerms(). Degrees not present in the map are set to
+ * zero. An error is thrown if the map contains a degree lower than 2.
+ * \param zonalCoefficientsOfGravityField Map of zonal coefficients; the map key contains the
+ *          degree, and the map value contains the coefficient value [-].
+ * \return Vector of zonal coefficients, with the vector index indicating the degree [-].
+ */
+Eigen::VectorXd convertZonalCoefficientMapToVector(
+        const std::map< int, double >& zonalCoefficientsOfGravityField );
+
+//! Central + zonal gravitational acceleration model class.
+/*!
+ * This class implements a gravitational acceleration model that includes the central term and
+ * an arbitrary number of zonal terms (unnormalized coefficients of general spherical harmonics
+ * expansion). It generalizes the CentralJ2GravitationalAccelerationModel,
+ * CentralJ2J3GravitationalAccelerationModel and CentralJ2J3J4GravitationalAccelerationModel
+ * classes to any highest degree, at a cost that is linear in the highest degree.
+ */
+class CentralZonalGravitationalAccelerationModel
+        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+{
+private:
+
+    //! Typedef for base class.
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+
+public:
+
+    //! Constructor taking position-functions for bodies, and constant parameters of spherical
+    //! harmonics expansion.
+    /*!
+     * Constructor taking a pointer to a function returning the position of the body subject to
+     * gravitational acceleration, constant gravitational parameter, zonal coefficients and
+     * equatorial radius of the body exerting the acceleration, and a pointer to a function
+     * returning the position of the body exerting the gravitational acceleration (typically the
+     * central body). The constructor also updates all the internal members. The position of the
+     * body exerting the gravitational acceleration is an optional parameter; the default position
+     * is the origin.
+     * \param positionOfBodySubjectToAccelerationFunction Pointer to function returning position of
+     *          body subject to gravitational acceleration.
+     * \param aGravitationalParameter A (constant) gravitational parameter [m^2 s^-3].
+     * \param anEquatorialRadius A (constant) equatorial radius [m].
+     * \param someZonalCoefficients (Constant) unnormalized zonal coefficients. The vector index
+     *          indicates the degree; entries for degree 0 and 1 are ignored.
+     * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
+     *          body exerting gravitational acceleration (default = (0,0,0)).
+     */
+    CentralZonalGravitationalAccelerationModel(
+            const StateFunction positionOfBodySubjectToAccelerationFunction,
+            const double aGravitationalParameter,
+            const double anEquatorialRadius,
+            const Eigen::VectorXd& someZonalCoefficients,
+            const StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+        : Base( positionOfBodySubjectToAccelerationFunction,
+                aGravitationalParameter,
+                positionOfBodyExertingAccelerationFunction ),
+          equatorialRadius( anEquatorialRadius ),
+          zonalCoefficients( someZonalCoefficients )
+    {
+        this->updateMembers( );
+    }
+
+    //! Get gravitational acceleration.
+    /*!
+     * Returns the gravitational acceleration computed using the input parameters provided to the
+     * class. This function serves as a wrapper for the computeGravitationalAcceleration() and
+     * computeGravitationalAccelerationDueToZonalTerms() functions.
+     * \return Computed gravitational acceleration vector.
+     */
+    Eigen::Vector3d getAcceleration( );
+
+    //! Update members.
+    /*!
+     * Updates class members relevant for computing the central gravitational acceleration. In this
+     * case the function simply updates the members in the base class.
+     * \sa SphericalHarmonicsGravitationalAccelerationModelBase.
+     */
+    void updateMembers( ) { this->updateBaseMembers( ); }
+
+    //! Get highest degree of zonal terms.
+    /*!
+     * Returns the highest degree of the zonal terms included in the model.
+     * \return Highest degree of zonal terms.
+     */
+    int getHighestDegree( ) { return zonalCoefficients.rows( ) - 1; }
+
+protected:
+
+    //! Equatorial radius [m].
+    /*!
+     * Equatorial radius of unnormalized spherical harmonics gravity field representation [m].
+     */
+    const double equatorialRadius;
+
+    //! Zonal gravity coefficients.
+    /*!
+     * Zonal coefficients of unnormalized spherical harmonics gravity field representation. The
+     * vector index indicates the degree.
+     */
+    const Eigen::VectorXd zonalCoefficients;
+
+private:
+};
+
+//! Typedef for shared-pointer to CentralZonalGravitationalAccelerationModel.
+typedef boost::shared_ptr< CentralZonalGravitationalAccelerationModel >
+CentralZonalGravitationalAccelerationModelPointer;
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_CENTRAL_ZONAL_GRAVITY_MODEL_H
@@ -0,0 +1,403 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140205    S. Vermeer        File created.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravitationalAccelerations.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+namespace
+{
+
+//! Maximum depth of Barnes-Hut octree.
+/*!
+ * Maximum depth of Barnes-Hut octree. Cells at this depth are not subdivided further,
+ * irrespective of the number of bodies they contain, which prevents infinite recursion for
+ * (nearly) coincident bodies.
+ */
+const int maximumOctreeDepth = 32;
+
+//! Check consistency of input block sizes.
+void checkInputBlockSizes( const CartesianVectorBlock& positionsOfBodies,
+                           const Eigen::VectorXd& gravitationalParametersOfBodies )
+{
+    if ( positionsOfBodies.rows( ) != gravitationalParametersOfBodies.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Number of positions and gravitational parameters are not equal." )
+                        ) );
+    }
+}
+
+} // namespace
+
+//! Compute mutual gravitational accelerations of N point masses by direct summation.
+CartesianVectorBlock computeMutualGravitationalAccelerations(
+        const CartesianVectorBlock& positionsOfBodies,
+        const Eigen::VectorXd& gravitationalParametersOfBodies,
+        const double softeningLength )
+{
+    checkInputBlockSizes( positionsOfBodies, gravitationalParametersOfBodies );
+
+    const int numberOfBodies = positionsOfBodies.rows( );
+    const double softeningLengthSquared = softeningLength * softeningLength;
+
+    // Initialize accelerations to zero.
+    CartesianVectorBlock accelerations = CartesianVectorBlock::Zero( numberOfBodies, 3 );
+
+    // Declare work arrays for relative positions and (scaled) inverse cubed distances. These are
+    // allocated once and reused for all bodies.
+    Eigen::ArrayXd relativeXPositions( numberOfBodies );
+    Eigen::ArrayXd relativeYPositions( numberOfBodies );
+    Eigen::ArrayXd relativeZPositions( numberOfBodies );
+    Eigen::ArrayXd inverseCubedDistances( numberOfBodies );
+    Eigen::ArrayXd scaledInverseCubedDistances( numberOfBodies );
+
+    // Loop over all bodies, and compute the interaction with all bodies with a higher index. The
+    // contribution of each pair is added to both bodies, so that each pair is evaluated once.
+    for ( int i = 0; i < numberOfBodies - 1; i++ )
+    {
+        const int numberOfRemainingBodies = numberOfBodies - i - 1;
+
+        // Compute positions of remaining bodies relative to current body.
+        relativeXPositions.head( numberOfRemainingBodies )
+                = positionsOfBodies.col( 0 ).segment( i + 1, numberOfRemainingBodies ).array( )
+                - positionsOfBodies( i, 0 );
+        relativeYPositions.head( numberOfRemainingBodies )
+                = positionsOfBodies.col( 1 ).segment( i + 1, numberOfRemainingBodies ).array( )
+                - positionsOfBodies( i, 1 );
+        relativeZPositions.head( numberOfRemainingBodies )
+                = positionsOfBodies.col( 2 ).segment( i + 1, numberOfRemainingBodies ).array( )
+                - positionsOfBodies( i, 2 );
+
+        // Compute squared distances (stored temporarily in inverse cubed distance array), and
+        // subsequently the inverse cubed distances.
+        inverseCubedDistances.head( numberOfRemainingBodies )
+                = relativeXPositions.head( numberOfRemainingBodies ).square( )
+                + relativeYPositions.head( numberOfRemainingBodies ).square( )
+                + relativeZPositions.head( numberOfRemainingBodies ).square( )
+                + softeningLengthSquared;
+        inverseCubedDistances.head( numberOfRemainingBodies )
+                = ( inverseCubedDistances.head( numberOfRemainingBodies )
+                    * inverseCubedDistances.head( numberOfRemainingBodies ).sqrt( ) ).inverse( );
+
+        // Add acceleration exerted by remaining bodies on current body.
+        scaledInverseCubedDistances.head( numberOfRemainingBodies )
+                = gravitationalParametersOfBodies.segment(
+                    i + 1, numberOfRemainingBodies ).array( )
+                * inverseCubedDistances.head( numberOfRemainingBodies );
+
+        accelerations( i, 0 ) += ( scaledInverseCubedDistances.head( numberOfRemainingBodies )
+                                   * relativeXPositions.head( numberOfRemainingBodies ) ).sum( );
+        accelerations( i, 1 ) += ( scaledInverseCubedDistances.head( numberOfRemainingBodies )
+                                   * relativeYPositions.head( numberOfRemainingBodies ) ).sum( );
+        accelerations( i, 2 ) += ( scaledInverseCubedDistances.head( numberOfRemainingBodies )
+                                   * relativeZPositions.head( numberOfRemainingBodies ) ).sum( );
+
+        // Add acceleration exerted by current body on remaining bodies.
+        const double gravitationalParameterOfCurrentBody = gravitationalParametersOfBodies( i );
+
+        accelerations.col( 0 ).segment( i + 1, numberOfRemainingBodies ).array( )
+                -= gravitationalParameterOfCurrentBody
+                * inverseCubedDistances.head( numberOfRemainingBodies )
+                * relativeXPositions.head( numberOfRemainingBodies );
+        accelerations.col( 1 ).segment( i + 1, numberOfRemainingBodies ).array( )
+                -= gravitationalParameterOfCurrentBody
+                * inverseCubedDistances.head( numberOfRemainingBodies )
+                * relativeYPositions.head( numberOfRemainingBodies );
+        accelerations.col( 2 ).segment( i + 1, numberOfRemainingBodies ).array( )
+                -= gravitationalParameterOfCurrentBody
+                * inverseCubedDistances.head( numberOfRemainingBodies )
+                * relativeZPositions.head( numberOfRemainingBodies );
+    }
+
+    return accelerations;
+}
+
+//! Constructor.
+BarnesHutOctree::BarnesHutOctree( const CartesianVectorBlock& positionsOfBodies,
+                                  const Eigen::VectorXd& gravitationalParametersOfBodies,
+                                  const int maximumNumberOfBodiesPerLeaf )
+    : positionsOfBodies_( positionsOfBodies ),
+      gravitationalParametersOfBodies_( gravitationalParametersOfBodies ),
+      maximumNumberOfBodiesPerLeaf_( std::max( maximumNumberOfBodiesPerLeaf, 1 ) )
+{
+    checkInputBlockSizes( positionsOfBodies, gravitationalParametersOfBodies );
+
+    const int numberOfBodies = positionsOfBodies_.rows( );
+
+    if ( numberOfBodies == 0 )
+    {
+        return;
+    }
+
+    // Set initial (unsorted) body indices.
+    sortedBodyIndices_.resize( numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        sortedBodyIndices_[ i ] = i;
+    }
+
+    // Determine cubic bounding box of all bodies, which is used as the root cell.
+    const Eigen::Vector3d minimumPosition = positionsOfBodies_.colwise( ).minCoeff( ).transpose( );
+    const Eigen::Vector3d maximumPosition = positionsOfBodies_.colwise( ).maxCoeff( ).transpose( );
+
+    // Reserve memory for (approximate) number of cells, to limit reallocations.
+    cells_.reserve( 2 * numberOfBodies / maximumNumberOfBodiesPerLeaf_ + 1 );
+
+    buildCell( 0.5 * ( minimumPosition + maximumPosition ),
+               0.5 * ( maximumPosition - minimumPosition ).maxCoeff( ),
+               0, numberOfBodies, 0 );
+}
+
+//! Recursively build cell of octree.
+int BarnesHutOctree::buildCell( const Eigen::Vector3d& center, const double halfWidth,
+                                const int firstBody, const int numberOfBodies, const int depth )
+{
+    // Add new cell. NB: the cell is accessed by index, since the recursive calls below may
+    // reallocate the vector of cells.
+    const int cellIndex = static_cast< int >( cells_.size( ) );
+    cells_.push_back( Cell( ) );
+
+    cells_[ cellIndex ].center = center;
+    cells_[ cellIndex ].halfWidth = halfWidth;
+    cells_[ cellIndex ].firstBody = firstBody;
+    cells_[ cellIndex ].numberOfBodies = numberOfBodies;
+
+    // Compute mass properties of cell.
+    double gravitationalParameter = 0.0;
+    Eigen::Vector3d weightedPositionSum = Eigen::Vector3d::Zero( );
+    for ( int i = firstBody; i < firstBody + numberOfBodies; i++ )
+    {
+        const int bodyIndex = sortedBodyIndices_[ i ];
+        gravitationalParameter += gravitationalParametersOfBodies_( bodyIndex );
+        weightedPositionSum += gravitationalParametersOfBodies_( bodyIndex )
+                * positionsOfBodies_.row( bodyIndex ).transpose( );
+    }
+
+    cells_[ cellIndex ].gravitationalParameter = gravitationalParameter;
+    cells_[ cellIndex ].centerOfMass = ( gravitationalParameter > 0.0 )
+            ? Eigen::Vector3d( weightedPositionSum / gravitationalParameter ) : center;
+
+    // Check if cell is a leaf cell.
+    cells_[ cellIndex ].isLeaf = ( numberOfBodies <= maximumNumberOfBodiesPerLeaf_
+                                   || depth >= maximumOctreeDepth );
+    if ( cells_[ cellIndex ].isLeaf )
+    {
+        return cellIndex;
+    }
+
+    // Determine octant of each body in cell, and count number of bodies per octant.
+    std::vector< int > octantsOfBodies( numberOfBodies );
+    int numberOfBodiesPerOctant[ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const int bodyIndex = sortedBodyIndices_[ firstBody + i ];
+        octantsOfBodies[ i ] = ( positionsOfBodies_( bodyIndex, 0 ) >= center.x( ) ? 1 : 0 )
+                + ( positionsOfBodies_( bodyIndex, 1 ) >= center.y( ) ? 2 : 0 )
+                + ( positionsOfBodies_( bodyIndex, 2 ) >= center.z( ) ? 4 : 0 );
+        numberOfBodiesPerOctant[ octantsOfBodies[ i ] ]++;
+    }
+
+    // Sort bodies of cell by octant (counting sort).
+    int firstBodyOfOctant[ 8 ];
+    firstBodyOfOctant[ 0 ] = 0;
+    for ( int octant = 1; octant < 8; octant++ )
+    {
+        firstBodyOfOctant[ octant ] = firstBodyOfOctant[ octant - 1 ]
+                + numberOfBodiesPerOctant[ octant - 1 ];
+    }
+
+    std::vector< int > bodyIndicesOfCell( sortedBodyIndices_.begin( ) + firstBody,
+                                          sortedBodyIndices_.begin( ) + firstBody
+                                          + numberOfBodies );
+    int nextBodyOfOctant[ 8 ];
+    std::copy( firstBodyOfOctant, firstBodyOfOctant + 8, nextBodyOfOctant );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        sortedBodyIndices_[ firstBody + nextBodyOfOctant[ octantsOfBodies[ i ] ]++ ]
+                = bodyIndicesOfCell[ i ];
+    }
+
+    // Recursively build child cells for all non-empty octants.
+    const double childHalfWidth = 0.5 * halfWidth;
+    for ( int octant = 0; octant < 8; octant++ )
+    {
+        if ( numberOfBodiesPerOctant[ octant ] > 0 )
+        {
+            const Eigen::Vector3d childCenter
+                    = center + childHalfWidth * Eigen::Vector3d( ( octant & 1 ) ? 1.0 : -1.0,
+                                                                 ( octant & 2 ) ? 1.0 : -1.0,
+                                                                 ( octant & 4 ) ? 1.0 : -1.0 );
+            const int childIndex = buildCell( childCenter, childHalfWidth,
+                                              firstBody + firstBodyOfOctant[ octant ],
+                                              numberOfBodiesPerOctant[ octant ], depth + 1 );
+            cells_[ cellIndex ].children[ octant ] = childIndex;
+        }
+    }
+
+    return cellIndex;
+}
+
+//! Compute gravitational acceleration at given body.
+Eigen::Vector3d BarnesHutOctree::computeAccelerationOfBody( const int bodyIndex,
+                                                            const double openingAngle,
+                                                            const double softeningLength ) const
+{
+    return computeAcceleration( positionsOfBodies_.row( bodyIndex ).transpose( ), bodyIndex,
+                                openingAngle, softeningLength );
+}
+
+//! Compute gravitational acceleration at given position.
+Eigen::Vector3d BarnesHutOctree::computeAccelerationAtPosition(
+        const Eigen::Vector3d& position, const double openingAngle,
+        const double softeningLength ) const
+{
+    return computeAcceleration( position, -1, openingAngle, softeningLength );
+}
+
+//! Compute acceleration at position, excluding given body.
+Eigen::Vector3d BarnesHutOctree::computeAcceleration( const Eigen::Vector3d& position,
+                                                      const int excludedBody,
+                                                      const double openingAngle,
+                                                      const double softeningLength ) const
+{
+    Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+
+    if ( cells_.empty( ) )
+    {
+        return acceleration;
+    }
+
+    const double softeningLengthSquared = softeningLength * softeningLength;
+    const double openingAngleSquared = openingAngle * openingAngle;
+
+    // Traverse octree using an explicit stack of cell indices. The stack size is bounded by the
+    // maximum depth of the octree, since at most 7 siblings are pushed per level.
+    int cellStack[ 8 * ( maximumOctreeDepth + 1 ) ];
+    int stackSize = 0;
+    cellStack[ stackSize++ ] = 0;
+
+    while ( stackSize > 0 )
+    {
+        const Cell& cell = cells_[ cellStack[ --stackSize ] ];
+
+        // Directly sum contributions of bodies in leaf cell.
+        if ( cell.isLeaf )
+        {
+            for ( int i = cell.firstBody; i < cell.firstBody + cell.numberOfBodies; i++ )
+            {
+                const int bodyIndex = sortedBodyIndices_[ i ];
+                if ( bodyIndex != excludedBody )
+                {
+                    const Eigen::Vector3d relativePosition
+                            = positionsOfBodies_.row( bodyIndex ).transpose( ) - position;
+                    const double distanceSquared = relativePosition.squaredNorm( )
+                            + softeningLengthSquared;
+                    acceleration += gravitationalParametersOfBodies_( bodyIndex )
+                            / ( distanceSquared * std::sqrt( distanceSquared ) )
+                            * relativePosition;
+                }
+            }
+            continue;
+        }
+
+        // Check if position lies inside cell, in which case the cell must be opened.
+        const bool isPositionInCell
+                = ( ( position - cell.center ).cwiseAbs( ).maxCoeff( ) <= cell.halfWidth );
+
+        // Approximate cell by point mass at its center of mass if it is sufficiently far away.
+        const Eigen::Vector3d relativePosition = cell.centerOfMass - position;
+        const double distanceSquared = relativePosition.squaredNorm( );
+        const double cellSize = 2.0 * cell.halfWidth;
+
+        if ( !isPositionInCell && cellSize * cellSize < openingAngleSquared * distanceSquared )
+        {
+            const double softenedDistanceSquared = distanceSquared + softeningLengthSquared;
+            acceleration += cell.gravitationalParameter
+                    / ( softenedDistanceSquared * std::sqrt( softenedDistanceSquared ) )
+                    * relativePosition;
+        }
+
+        // Else, open cell.
+        else
+        {
+            for ( int octant = 0; octant < 8; octant++ )
+            {
+                if ( cell.children[ octant ] >= 0 )
+                {
+                    cellStack[ stackSize++ ] = cell.children[ octant ];
+                }
+            }
+        }
+    }
+
+    return acceleration;
+}
+
+//! Compute mutual gravitational accelerations of N point masses using Barnes-Hut algorithm.
+CartesianVectorBlock computeMutualGravitationalAccelerationsBarnesHut(
+        const CartesianVectorBlock& positionsOfBodies,
+        const Eigen::VectorXd& gravitationalParametersOfBodies,
+        const double openingAngle,
+        const double softeningLength )
+{
+    // Build octree of bodies.
+    const BarnesHutOctree octree( positionsOfBodies, gravitationalParametersOfBodies );
+
+    // Compute acceleration of each body by traversing octree.
+    CartesianVectorBlock accelerations( positionsOfBodies.rows( ), 3 );
+    for ( int i = 0; i < positionsOfBodies.rows( ); i++ )
+    {
+        accelerations.row( i ) = octree.computeAccelerationOfBody(
+                    i, openingAngle, softeningLength ).transpose( );
+    }
+
+    return accelerations;
+}
+
+} // namespace gravitation
+} // namespace tudat
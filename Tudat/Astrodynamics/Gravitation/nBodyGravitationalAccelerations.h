@@ -0,0 +1,284 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140205    S. Vermeer        File created.
+ *      140401    S. Vermeer        Added constructor of octree cell that initializes all members.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *      Aarseth, S.J. Gravitational N-body simulations, Cambridge University Press, 2003.
+ *
+ *    Notes
+ *      The positions and gravitational parameters of all bodies are passed as a single block in
+ *      structure-of-arrays layout (one column per Cartesian component). This allows the direct
+ *      summation kernel to be written in terms of Eigen array expressions, which are vectorized
+ *      by Eigen (SSE/AVX, depending on the compiler flags), and avoids the construction of
+ *      O(N^2) individual acceleration model objects for large numbers of bodies.
+ *
+ */
+
+#ifndef TUDAT_N_BODY_GRAVITATIONAL_ACCELERATIONS_H
+#define TUDAT_N_BODY_GRAVITATIONAL_ACCELERATIONS_H
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Typedef for block of Cartesian vectors of N bodies, in structure-of-arrays layout.
+/*!
+ * Typedef for a block of Cartesian vectors (positions or accelerations) of N bodies. Each row
+ * contains the vector of a single body; since Eigen uses column-major storage, the x-, y- and
+ * z-components of all bodies are each stored contiguously (structure-of-arrays layout).
+ */
+typedef Eigen::Matrix< double, Eigen::Dynamic, 3 > CartesianVectorBlock;
+
+//! Compute mutual gravitational accelerations of N point masses by direct summation.
+/*!
+ * Computes the gravitational acceleration experienced by each of N point masses, due to the
+ * gravitational attraction of all other point masses, by direct summation over all pairs:
+ * \f[
+ *      \mathbf{a}_{i} = \sum\limits_{j \neq i} \mu_{j}
+ *                       \frac{\mathbf{r}_{j}-\mathbf{r}_{i}}
+ *                       {\left( |\mathbf{r}_{j}-\mathbf{r}_{i}|^{2} + \epsilon^{2} \right)^{3/2}}
+ * \f]
+ * where \f$\mu_{j}\f$ is the gravitational parameter of body j, \f$\mathbf{r}\f$ denotes the
+ * position vector and \f$\epsilon\f$ is an (optional) softening length (Aarseth, 2003). Each pair
+ * is evaluated only once, with the contribution to both bodies added at the same time, and the
+ * summation for each body is performed with vectorized Eigen array expressions. The cost of this
+ * function scales with \f$N^{2}\f$.
+ * \param positionsOfBodies Block of position vectors of all bodies, one row per body [m].
+ * \param gravitationalParametersOfBodies Gravitational parameters of all bodies, in the same
+ *          order as the rows of positionsOfBodies [m^3 s^-2].
+ * \param softeningLength Softening length used to regularize close encounters (default = 0.0)
+ *          [m].
+ * \return Block of gravitational acceleration vectors of all bodies, one row per body [m s^-2].
+ */
+CartesianVectorBlock computeMutualGravitationalAccelerations(
+        const CartesianVectorBlock& positionsOfBodies,
+        const Eigen::VectorXd& gravitationalParametersOfBodies,
+        const double softeningLength = 0.0 );
+
+//! Barnes-Hut octree of point masses.
+/*!
+ * Octree of point masses, used to approximate the gravitational acceleration due to a large
+ * number of point masses using the hierarchical algorithm of (Barnes & Hut, 1986). The octree is
+ * built once for a given set of positions and gravitational parameters; the acceleration at any
+ * point can subsequently be computed at a cost that scales with \f$\log N\f$. Cells are replaced
+ * by a point mass at their center of mass if the ratio of the cell size to the distance between
+ * the cell's center of mass and the evaluation point is smaller than a user-defined opening
+ * angle. Cells containing the evaluation point are always opened, so that the contribution of a
+ * body to its own acceleration is always excluded explicitly. An opening angle of zero results in
+ * (a reordered) direct summation.
+ */
+class BarnesHutOctree
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, builds the octree for the given point masses.
+     * \param positionsOfBodies Block of position vectors of all bodies, one row per body [m].
+     * \param gravitationalParametersOfBodies Gravitational parameters of all bodies, in the same
+     *          order as the rows of positionsOfBodies [m^3 s^-2].
+     * \param maximumNumberOfBodiesPerLeaf Maximum number of bodies stored in a leaf cell of the
+     *          octree (default = 8).
+     */
+    BarnesHutOctree( const CartesianVectorBlock& positionsOfBodies,
+                     const Eigen::VectorXd& gravitationalParametersOfBodies,
+                     const int maximumNumberOfBodiesPerLeaf = 8 );
+
+    //! Compute gravitational acceleration at given body.
+    /*!
+     * Computes the gravitational acceleration experienced by one of the bodies from which the
+     * octree was built, due to all other bodies.
+     * \param bodyIndex Index (row in positionsOfBodies) of body for which acceleration is to be
+     *          computed.
+     * \param openingAngle Opening angle used to decide whether cells are to be opened [-].
+     * \param softeningLength Softening length used to regularize close encounters
+     *          (default = 0.0) [m].
+     * \return Gravitational acceleration of body [m s^-2].
+     */
+    Eigen::Vector3d computeAccelerationOfBody( const int bodyIndex,
+                                               const double openingAngle,
+                                               const double softeningLength = 0.0 ) const;
+
+    //! Compute gravitational acceleration at given position.
+    /*!
+     * Computes the gravitational acceleration at an arbitrary position, due to all bodies from
+     * which the octree was built.
+     * \param position Position at which the acceleration is to be evaluated [m].
+     * \param openingAngle Opening angle used to decide whether cells are to be opened [-].
+     * \param softeningLength Softening length used to regularize close encounters
+     *          (default = 0.0) [m].
+     * \return Gravitational acceleration at given position [m s^-2].
+     */
+    Eigen::Vector3d computeAccelerationAtPosition( const Eigen::Vector3d& position,
+                                                   const double openingAngle,
+                                                   const double softeningLength = 0.0 ) const;
+
+    //! Get number of cells in octree.
+    /*!
+     * Returns the total number of cells (internal and leaf) in the octree.
+     * \return Number of cells.
+     */
+    int getNumberOfCells( ) const { return static_cast< int >( cells_.size( ) ); }
+
+protected:
+
+private:
+
+    //! Cell of the octree.
+    /*!
+     * Cell of the octree, containing its geometry, mass properties, and either the indices of
+     * its child cells (internal cell) or the range of bodies it contains (leaf cell).
+     */
+    struct Cell
+    {
+        //! Default constructor.
+        /*!
+         * Default constructor, initializes all geometry and mass properties to zero, and the
+         * cell to an empty internal cell without children.
+         */
+        Cell( )
+            : center( Eigen::Vector3d::Zero( ) ),
+              halfWidth( 0.0 ),
+              gravitationalParameter( 0.0 ),
+              centerOfMass( Eigen::Vector3d::Zero( ) ),
+              firstBody( 0 ),
+              numberOfBodies( 0 ),
+              isLeaf( false )
+        {
+            std::fill( children, children + 8, -1 );
+        }
+
+        //! Geometric center of cell [m].
+        Eigen::Vector3d center;
+
+        //! Half of the edge length of the (cubic) cell [m].
+        double halfWidth;
+
+        //! Sum of gravitational parameters of bodies in cell [m^3 s^-2].
+        double gravitationalParameter;
+
+        //! Center of mass of bodies in cell [m].
+        Eigen::Vector3d centerOfMass;
+
+        //! Index of first body in cell, in sorted body index list.
+        int firstBody;
+
+        //! Number of bodies in cell.
+        int numberOfBodies;
+
+        //! Indices of child cells (-1 if no child in octant).
+        int children[ 8 ];
+
+        //! Flag indicating whether cell is a leaf cell.
+        bool isLeaf;
+    };
+
+    //! Recursively build cell of octree.
+    /*!
+     * Builds a cell containing the bodies in the given range of the sorted body index list, and
+     * recursively builds its children.
+     * \param center Geometric center of cell [m].
+     * \param halfWidth Half of the edge length of the cell [m].
+     * \param firstBody Index of first body in cell, in sorted body index list.
+     * \param numberOfBodies Number of bodies in cell.
+     * \param depth Depth of cell in octree.
+     * \return Index of cell that was built.
+     */
+    int buildCell( const Eigen::Vector3d& center, const double halfWidth,
+                   const int firstBody, const int numberOfBodies, const int depth );
+
+    //! Compute acceleration at position, excluding given body.
+    /*!
+     * Computes acceleration at given position by traversing the octree, excluding the
+     * contribution of the body with given index (-1 to include all bodies).
+     * \param position Position at which the acceleration is to be evaluated [m].
+     * \param excludedBody Index of body excluded from computation.
+     * \param openingAngle Opening angle used to decide whether cells are to be opened [-].
+     * \param softeningLength Softening length used to regularize close encounters [m].
+     * \return Gravitational acceleration at position [m s^-2].
+     */
+    Eigen::Vector3d computeAcceleration( const Eigen::Vector3d& position,
+                                         const int excludedBody,
+                                         const double openingAngle,
+                                         const double softeningLength ) const;
+
+    //! Positions of bodies.
+    CartesianVectorBlock positionsOfBodies_;
+
+    //! Gravitational parameters of bodies.
+    Eigen::VectorXd gravitationalParametersOfBodies_;
+
+    //! Maximum number of bodies per leaf cell.
+    int maximumNumberOfBodiesPerLeaf_;
+
+    //! Body indices, sorted such that the bodies of each cell are stored contiguously.
+    std::vector< int > sortedBodyIndices_;
+
+    //! Cells of octree; the first cell is the root cell.
+    std::vector< Cell > cells_;
+};
+
+//! Typedef for shared-pointer to BarnesHutOctree.
+typedef boost::shared_ptr< BarnesHutOctree > BarnesHutOctreePointer;
+
+//! Compute mutual gravitational accelerations of N point masses using Barnes-Hut algorithm.
+/*!
+ * Computes the gravitational acceleration experienced by each of N point masses, due to the
+ * gravitational attraction of all other point masses, using the Barnes-Hut algorithm (Barnes &
+ * Hut, 1986). The cost of this function scales with \f$N \log N\f$, so that it is preferred over
+ * computeMutualGravitationalAccelerations() for large numbers of bodies (typically several
+ * thousands), at the expense of an approximation error that is controlled by the opening angle.
+ * \param positionsOfBodies Block of position vectors of all bodies, one row per body [m].
+ * \param gravitationalParametersOfBodies Gravitational parameters of all bodies, in the same
+ *          order as the rows of positionsOfBodies [m^3 s^-2].
+ * \param openingAngle Opening angle used to decide whether cells are to be opened; typical values
+ *          are between 0.3 and 1.0 (default = 0.5) [-].
+ * \param softeningLength Softening length used to regularize close encounters (default = 0.0)
+ *          [m].
+ * \return Block of gravitational acceleration vectors of all bodies, one row per body [m s^-2].
+ */
+CartesianVectorBlock computeMutualGravitationalAccelerationsBarnesHut(
+        const CartesianVectorBlock& positionsOfBodies,
+        const Eigen::VectorXd& gravitationalParametersOfBodies,
+        const double openingAngle = 0.5,
+        const double softeningLength = 0.0 );
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_N_BODY_GRAVITATIONAL_ACCELERATIONS_H
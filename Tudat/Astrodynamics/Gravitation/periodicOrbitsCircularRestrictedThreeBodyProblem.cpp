@@ -0,0 +1,409 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140226    S. Vermeer        File created.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'halo' orbits, Celestial Mechanics, 32(1), 53-71,
+ *          1984.
+ *      Doedel, E.J., Romanov, V.A., Paffenroth, R.C., Keller, H.B., Dichmann, D.J.,
+ *          Galan-Vioque, J., Vanderbauwhede, A. Elemental periodic orbits associated with the
+ *          libration points in the circular restricted 3-body problem, International Journal of
+ *          Bifurcation and Chaos, 17(8), 2625-2677, 2007.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+
+#include <Eigen/LU>
+#include <Eigen/SVD>
+
+#include "Tudat/Astrodynamics/Gravitation/periodicOrbitsCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Astrodynamics/Gravitation/propagationCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+namespace
+{
+
+//! Compute null vector of constraint Jacobian.
+/*!
+ * Computes the unit null vector of the Jacobian of the constraints w.r.t. the free variables,
+ * using a singular value decomposition, with its sign chosen such that the inner product with
+ * the given direction is non-negative.
+ * \param constraintJacobian Jacobian of constraints w.r.t. free variables.
+ * \param direction Direction that determines the sign of the null vector.
+ * \return Unit null vector.
+ */
+Eigen::Vector4d computeNullVector( const Eigen::Matrix< double, 3, 4 >& constraintJacobian,
+                                   const Eigen::Vector4d& direction )
+{
+    const Eigen::JacobiSVD< Eigen::Matrix< double, 3, 4 > > singularValueDecomposition(
+                constraintJacobian, Eigen::ComputeFullV );
+    const Eigen::Vector4d nullVector = singularValueDecomposition.matrixV( ).col( 3 );
+
+    return ( nullVector.dot( direction ) < 0.0 ) ? Eigen::Vector4d( -nullVector ) : nullVector;
+}
+
+} // namespace
+
+//! Get initial state of symmetric periodic orbit.
+basic_mathematics::Vector6d getPeriodicOrbitInitialState( const Eigen::Vector4d& freeVariables )
+{
+    basic_mathematics::Vector6d initialState = basic_mathematics::Vector6d::Zero( );
+    initialState( xPositionIndex ) = freeVariables( xPositionFreeVariableIndex );
+    initialState( zPositionIndex ) = freeVariables( zPositionFreeVariableIndex );
+    initialState( yVelocityIndex ) = freeVariables( yVelocityFreeVariableIndex );
+    return initialState;
+}
+
+//! Compute constraints and their Jacobian.
+void PeriodicOrbitContinuation::computeConstraintsAndJacobian(
+        const Eigen::Vector4d& freeVariables, Eigen::Vector3d& constraints,
+        Eigen::Matrix< double, 3, 4 >& constraintJacobian ) const
+{
+    // Propagate state and state transition matrix over half a period.
+    const std::pair< basic_mathematics::Vector6d, basic_mathematics::Matrix6d >
+            stateAndStateTransitionMatrix
+            = propagateCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrix(
+                massParameter, getPeriodicOrbitInitialState( freeVariables ),
+                freeVariables( halfPeriodFreeVariableIndex ), integrationErrorTolerance );
+    const basic_mathematics::Vector6d stateDerivative
+            = computeCircularRestrictedThreeBodyProblemStateDerivative(
+                massParameter, stateAndStateTransitionMatrix.first );
+
+    // Set constraints and their partial derivatives w.r.t. the free variables; the partial
+    // derivatives w.r.t. the half-period are given by the state derivative.
+    const int constraintIndices[ 3 ] = { yPositionIndex, xVelocityIndex, zVelocityIndex };
+    for ( int i = 0; i < 3; i++ )
+    {
+        constraints( i ) = stateAndStateTransitionMatrix.first( constraintIndices[ i ] );
+
+        constraintJacobian( i, xPositionFreeVariableIndex )
+                = stateAndStateTransitionMatrix.second( constraintIndices[ i ], xPositionIndex );
+        constraintJacobian( i, zPositionFreeVariableIndex )
+                = stateAndStateTransitionMatrix.second( constraintIndices[ i ], zPositionIndex );
+        constraintJacobian( i, yVelocityFreeVariableIndex )
+                = stateAndStateTransitionMatrix.second( constraintIndices[ i ], yVelocityIndex );
+        constraintJacobian( i, halfPeriodFreeVariableIndex )
+                = stateDerivative( constraintIndices[ i ] );
+    }
+}
+
+//! Correct periodic orbit.
+Eigen::Vector4d PeriodicOrbitContinuation::correctPeriodicOrbit(
+        const Eigen::Vector4d& initialGuess, const int fixedFreeVariableIndex ) const
+{
+    if ( fixedFreeVariableIndex < -1 || fixedFreeVariableIndex > halfPeriodFreeVariableIndex )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Index of fixed free variable is invalid." ) ) );
+    }
+
+    // Set additional constraint that keeps the fixed free variable at its initial value.
+    Eigen::Vector4d additionalConstraintGradient = Eigen::Vector4d::Zero( );
+    double additionalConstraintValue = 0.0;
+    if ( fixedFreeVariableIndex >= 0 )
+    {
+        additionalConstraintGradient( fixedFreeVariableIndex ) = 1.0;
+        additionalConstraintValue = initialGuess( fixedFreeVariableIndex );
+    }
+
+    Eigen::Matrix< double, 3, 4 > constraintJacobian;
+    return correctFreeVariables( initialGuess, additionalConstraintGradient,
+                                 additionalConstraintValue, constraintJacobian );
+}
+
+//! Correct list of periodic orbits.
+PeriodicOrbitFreeVariablesList PeriodicOrbitContinuation::correctPeriodicOrbits(
+        const PeriodicOrbitFreeVariablesList& initialGuesses,
+        std::vector< bool >& convergenceFlags, const int fixedFreeVariableIndex ) const
+{
+    const unsigned int numberOfOrbits = initialGuesses.size( );
+
+    // Set additional constraint gradients and values, which keep the fixed free variable (if any)
+    // at its initial value.
+    PeriodicOrbitFreeVariablesList additionalConstraintGradients(
+                numberOfOrbits, Eigen::Vector4d::Zero( ) );
+    std::vector< double > additionalConstraintValues( numberOfOrbits, 0.0 );
+    if ( fixedFreeVariableIndex >= 0 && fixedFreeVariableIndex <= halfPeriodFreeVariableIndex )
+    {
+        for ( unsigned int i = 0; i < numberOfOrbits; i++ )
+        {
+            additionalConstraintGradients[ i ]( fixedFreeVariableIndex ) = 1.0;
+            additionalConstraintValues[ i ] = initialGuesses[ i ]( fixedFreeVariableIndex );
+        }
+    }
+    else if ( fixedFreeVariableIndex != -1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Index of fixed free variable is invalid." ) ) );
+    }
+
+    // Create one correction task per orbit, each of which stores its result separately. Since
+    // elements of std::vector< bool > cannot be written concurrently, flags are stored as ints.
+    PeriodicOrbitFreeVariablesList correctedFreeVariables( initialGuesses );
+    std::vector< Eigen::Matrix< double, 3, 4 >,
+            Eigen::aligned_allocator< Eigen::Matrix< double, 3, 4 > > >
+            constraintJacobians( numberOfOrbits );
+    std::vector< int > integerConvergenceFlags( numberOfOrbits, 0 );
+
+    std::vector< basics::ParallelTaskPool::Task > correctionTasks;
+    correctionTasks.reserve( numberOfOrbits );
+    for ( unsigned int i = 0; i < numberOfOrbits; i++ )
+    {
+        correctionTasks.push_back(
+                    boost::bind( &PeriodicOrbitContinuation::correctAndStoreFreeVariables, this,
+                                 &initialGuesses[ i ], &additionalConstraintGradients[ i ],
+                                 additionalConstraintValues[ i ], &correctedFreeVariables[ i ],
+                                 &constraintJacobians[ i ], &integerConvergenceFlags[ i ] ) );
+    }
+
+    executeTasks( correctionTasks );
+
+    convergenceFlags.assign( integerConvergenceFlags.begin( ), integerConvergenceFlags.end( ) );
+    return correctedFreeVariables;
+}
+
+//! Compute tangent to family of periodic orbits.
+Eigen::Vector4d PeriodicOrbitContinuation::computeFamilyTangent(
+        const Eigen::Vector4d& freeVariables, const Eigen::Vector4d& direction ) const
+{
+    Eigen::Vector3d constraints;
+    Eigen::Matrix< double, 3, 4 > constraintJacobian;
+    computeConstraintsAndJacobian( freeVariables, constraints, constraintJacobian );
+    return computeNullVector( constraintJacobian, direction );
+}
+
+//! Continue family of periodic orbits.
+PeriodicOrbitFreeVariablesList PeriodicOrbitContinuation::continuePeriodicOrbitFamily(
+        const Eigen::Vector4d& firstMember, const Eigen::Vector4d& direction,
+        const double stepLength, const unsigned int numberOfMembers ) const
+{
+    PeriodicOrbitFreeVariablesList familyMembers;
+    familyMembers.reserve( numberOfMembers );
+    familyMembers.push_back( firstMember );
+
+    // Determine number of members that is predicted and corrected concurrently.
+    const unsigned int batchSize = parallelTaskPool ? parallelTaskPool->getNumberOfThreads( ) : 1;
+
+    // Compute tangent to family at first member.
+    Eigen::Vector4d tangent = computeFamilyTangent( firstMember, direction );
+    double currentStepLength = stepLength;
+
+    PeriodicOrbitFreeVariablesList predictedMembers( batchSize );
+    PeriodicOrbitFreeVariablesList correctedMembers( batchSize );
+    std::vector< Eigen::Matrix< double, 3, 4 >,
+            Eigen::aligned_allocator< Eigen::Matrix< double, 3, 4 > > >
+            constraintJacobians( batchSize );
+    std::vector< int > convergenceFlags( batchSize );
+
+    while ( familyMembers.size( ) < numberOfMembers )
+    {
+        const Eigen::Vector4d lastMember = familyMembers.back( );
+        const unsigned int currentBatchSize
+                = std::min( batchSize, numberOfMembers
+                            - static_cast< unsigned int >( familyMembers.size( ) ) );
+
+        // Predict members along tangent, at multiples of the step length, and correct them
+        // subject to the pseudo-arclength constraint.
+        std::vector< basics::ParallelTaskPool::Task > correctionTasks;
+        for ( unsigned int i = 0; i < currentBatchSize; i++ )
+        {
+            const double arclength = static_cast< double >( i + 1 ) * currentStepLength;
+            predictedMembers[ i ] = lastMember + arclength * tangent;
+            convergenceFlags[ i ] = 0;
+
+            correctionTasks.push_back(
+                        boost::bind( &PeriodicOrbitContinuation::correctAndStoreFreeVariables,
+                                     this, &predictedMembers[ i ], &tangent,
+                                     tangent.dot( lastMember ) + arclength,
+                                     &correctedMembers[ i ], &constraintJacobians[ i ],
+                                     &convergenceFlags[ i ] ) );
+        }
+
+        executeTasks( correctionTasks );
+
+        // Accept leading sequence of converged members.
+        unsigned int numberOfAcceptedMembers = 0;
+        while ( numberOfAcceptedMembers < currentBatchSize
+                && convergenceFlags[ numberOfAcceptedMembers ] )
+        {
+            familyMembers.push_back( correctedMembers[ numberOfAcceptedMembers ] );
+            numberOfAcceptedMembers++;
+        }
+
+        // Adapt step length, or update tangent at last accepted member.
+        if ( numberOfAcceptedMembers == 0 )
+        {
+            currentStepLength *= 0.5;
+            if ( currentStepLength < stepLength / 1024.0 )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error( "Continuation of periodic orbit family "
+                                                    "failed: step length too small." ) ) );
+            }
+        }
+        else
+        {
+            tangent = computeNullVector( constraintJacobians[ numberOfAcceptedMembers - 1 ],
+                                         tangent );
+
+            if ( numberOfAcceptedMembers == currentBatchSize )
+            {
+                currentStepLength = std::min( 2.0 * currentStepLength, stepLength );
+            }
+        }
+    }
+
+    return familyMembers;
+}
+
+//! Correct free variables, subject to additional linear constraint.
+Eigen::Vector4d PeriodicOrbitContinuation::correctFreeVariables(
+        const Eigen::Vector4d& initialGuess, const Eigen::Vector4d& additionalConstraintGradient,
+        const double additionalConstraintValue,
+        Eigen::Matrix< double, 3, 4 >& constraintJacobian ) const
+{
+    const bool isAdditionalConstraintSet = !additionalConstraintGradient.isZero( );
+
+    Eigen::Vector4d freeVariables = initialGuess;
+    Eigen::Vector3d constraints;
+    bool isConverged = false;
+
+    for ( unsigned int iteration = 0; iteration <= maximumNumberOfIterations; iteration++ )
+    {
+        // Stop if the free variables are not finite, or the half-period is not positive.
+        if ( !( freeVariables.squaredNorm( ) < std::numeric_limits< double >::infinity( ) )
+             || !( freeVariables( halfPeriodFreeVariableIndex ) > 0.0 ) )
+        {
+            break;
+        }
+
+        computeConstraintsAndJacobian( freeVariables, constraints, constraintJacobian );
+
+        const double additionalConstraint = isAdditionalConstraintSet
+                ? additionalConstraintGradient.dot( freeVariables ) - additionalConstraintValue
+                : 0.0;
+
+        // Check convergence.
+        if ( constraints.cwiseAbs( ).maxCoeff( ) < constraintTolerance
+             && std::fabs( additionalConstraint ) < constraintTolerance )
+        {
+            isConverged = true;
+            break;
+        }
+
+        // Compute Newton update: minimum-norm update for the underdetermined system, or regular
+        // update for the system augmented with the additional constraint.
+        if ( isAdditionalConstraintSet )
+        {
+            Eigen::Matrix4d augmentedJacobian;
+            augmentedJacobian.topRows< 3 >( ) = constraintJacobian;
+            augmentedJacobian.row( 3 ) = additionalConstraintGradient.transpose( );
+
+            Eigen::Vector4d augmentedConstraints;
+            augmentedConstraints << constraints, additionalConstraint;
+
+            freeVariables -= augmentedJacobian.fullPivLu( ).solve( augmentedConstraints );
+        }
+        else
+        {
+            freeVariables -= constraintJacobian.transpose( )
+                    * ( constraintJacobian * constraintJacobian.transpose( ) ).fullPivLu( )
+                    .solve( constraints );
+        }
+    }
+
+    if ( !isConverged )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Differential correction of periodic orbit did not "
+                                            "converge." ) ) );
+    }
+
+    return freeVariables;
+}
+
+//! Correct free variables, and store result.
+void PeriodicOrbitContinuation::correctAndStoreFreeVariables(
+        const Eigen::Vector4d* initialGuess, const Eigen::Vector4d* additionalConstraintGradient,
+        const double additionalConstraintValue, Eigen::Vector4d* correctedFreeVariables,
+        Eigen::Matrix< double, 3, 4 >* constraintJacobian, int* isConverged ) const
+{
+    try
+    {
+        *correctedFreeVariables = correctFreeVariables(
+                    *initialGuess, *additionalConstraintGradient, additionalConstraintValue,
+                    *constraintJacobian );
+        *isConverged = 1;
+    }
+    catch( std::runtime_error& )
+    {
+        *correctedFreeVariables = *initialGuess;
+        *isConverged = 0;
+    }
+}
+
+//! Execute tasks.
+void PeriodicOrbitContinuation::executeTasks(
+        const std::vector< basics::ParallelTaskPool::Task >& tasks ) const
+{
+    if ( parallelTaskPool )
+    {
+        parallelTaskPool->executeTasks( tasks );
+    }
+    else
+    {
+        for ( unsigned int i = 0; i < tasks.size( ); i++ )
+        {
+            tasks[ i ]( );
+        }
+    }
+}
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
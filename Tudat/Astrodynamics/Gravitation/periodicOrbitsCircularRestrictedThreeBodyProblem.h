@@ -0,0 +1,311 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140226    S. Vermeer        File created.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'halo' orbits, Celestial Mechanics, 32(1), 53-71,
+ *          1984.
+ *      Doedel, E.J., Romanov, V.A., Paffenroth, R.C., Keller, H.B., Dichmann, D.J.,
+ *          Galan-Vioque, J., Vanderbauwhede, A. Elemental periodic orbits associated with the
+ *          libration points in the circular restricted 3-body problem, International Journal of
+ *          Bifurcation and Chaos, 17(8), 2625-2677, 2007.
+ *
+ *    Notes
+ *      Only periodic orbits that are symmetric w.r.t. the xz-plane, and cross it perpendicularly,
+ *      are considered. This includes the planar Lyapunov orbits, the halo orbits and the distant
+ *      retrograde orbits (DROs). Such an orbit is described by the four free variables
+ *      ( x0, z0, vy0, T/2 ), where the initial state is ( x0, 0, z0, 0, vy0, 0 ) and T is the
+ *      period. The orbit is periodic if, after half a period, y, vx and vz are zero (Howell, 1984).
+ *
+ *      The three constraints in four free variables define a one-parameter family of orbits,
+ *      which is followed using pseudo-arclength continuation (Doedel et al., 2007). To use
+ *      multiple threads, several family members are predicted along the tangent to the family at
+ *      once, at multiples of the step length, and corrected concurrently. The longest sequence
+ *      of converged members is accepted, after which the continuation proceeds from the last of
+ *      these.
+ *
+ */
+
+#ifndef TUDAT_PERIODIC_ORBITS_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
+#define TUDAT_PERIODIC_ORBITS_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+//! Free variable indices of symmetric periodic orbits in CRTBP.
+/*!
+ * Indices of the free variables that describe a periodic orbit that is symmetric w.r.t. the
+ * xz-plane, i.e., the x- and z-position and y-velocity at the perpendicular crossing of the
+ * xz-plane, and the half-period.
+ */
+enum PeriodicOrbitFreeVariableIndices
+{
+    xPositionFreeVariableIndex,
+    zPositionFreeVariableIndex,
+    yVelocityFreeVariableIndex,
+    halfPeriodFreeVariableIndex
+};
+
+//! Typedef for list of free variables of periodic orbits.
+typedef std::vector< Eigen::Vector4d, Eigen::aligned_allocator< Eigen::Vector4d > >
+PeriodicOrbitFreeVariablesList;
+
+//! Get initial state of symmetric periodic orbit.
+/*!
+ * Returns the initial state of a symmetric periodic orbit, i.e., the state at the perpendicular
+ * crossing of the xz-plane.
+ * \param freeVariables Free variables of periodic orbit ( x0, z0, vy0, T/2 ).
+ * \return Initial Cartesian state, in normalized units.
+ */
+basic_mathematics::Vector6d getPeriodicOrbitInitialState( const Eigen::Vector4d& freeVariables );
+
+//! Symmetric periodic orbit differential corrector and continuation class.
+/*!
+ * Class that corrects initial guesses of periodic orbits in the CRTBP that are symmetric w.r.t.
+ * the xz-plane, using a Newton method based on the state transition matrix over half a period
+ * (differential correction), and that generates families of such orbits by pseudo-arclength
+ * continuation. Initial guesses of a shooting grid, as well as batches of family members, can be
+ * corrected concurrently, by providing a parallel task pool.
+ */
+class PeriodicOrbitContinuation
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the CRTBP and settings of the differential corrector.
+     * \param aMassParameter Mass parameter of CRTBP.
+     * \param aParallelTaskPool Parallel task pool used to correct orbits concurrently (default
+     *          is serial correction).
+     * \param aConstraintTolerance Tolerance on the infinity norm of the constraints ( y, vx, vz )
+     *          after half a period, at which the correction is converged (default 1.0e-11).
+     * \param aMaximumNumberOfIterations Maximum number of Newton iterations per correction
+     *          (default 20).
+     * \param anIntegrationErrorTolerance Error tolerance of the Taylor series integrator used to
+     *          propagate the state and state transition matrix (default 1.0e-14).
+     */
+    PeriodicOrbitContinuation( const double aMassParameter,
+                               const basics::ParallelTaskPoolPointer
+                               aParallelTaskPool
+                               = basics::ParallelTaskPoolPointer( ),
+                               const double aConstraintTolerance = 1.0e-11,
+                               const unsigned int aMaximumNumberOfIterations = 20,
+                               const double anIntegrationErrorTolerance = 1.0e-14 )
+        : massParameter( aMassParameter ),
+          parallelTaskPool( aParallelTaskPool ),
+          constraintTolerance( aConstraintTolerance ),
+          maximumNumberOfIterations( aMaximumNumberOfIterations ),
+          integrationErrorTolerance( anIntegrationErrorTolerance )
+    { }
+
+    //! Compute constraints and their Jacobian.
+    /*!
+     * Computes the constraints ( y, vx, vz ) after half a period, and their Jacobian w.r.t. the
+     * free variables, from the state transition matrix and the state derivative at half a period.
+     * \param freeVariables Free variables of periodic orbit ( x0, z0, vy0, T/2 ).
+     * \param constraints Constraints ( y, vx, vz ) after half a period (returned by reference).
+     * \param constraintJacobian Jacobian of constraints w.r.t. free variables (returned by
+     *          reference).
+     */
+    void computeConstraintsAndJacobian( const Eigen::Vector4d& freeVariables,
+                                        Eigen::Vector3d& constraints,
+                                        Eigen::Matrix< double, 3, 4 >& constraintJacobian ) const;
+
+    //! Correct periodic orbit.
+    /*!
+     * Corrects an initial guess of a symmetric periodic orbit by differential correction. If no
+     * free variable is fixed, the minimum-norm Newton update is used in each iteration; otherwise,
+     * the given free variable is kept at its initial value. An exception is thrown if the
+     * correction does not converge within the maximum number of iterations.
+     * \param initialGuess Initial guess of free variables ( x0, z0, vy0, T/2 ).
+     * \param fixedFreeVariableIndex Index of free variable that is kept fixed (default -1, for no
+     *          fixed free variable).
+     * \return Corrected free variables.
+     */
+    Eigen::Vector4d correctPeriodicOrbit( const Eigen::Vector4d& initialGuess,
+                                          const int fixedFreeVariableIndex = -1 ) const;
+
+    //! Correct list of periodic orbits.
+    /*!
+     * Corrects a list of initial guesses of symmetric periodic orbits (e.g., a shooting grid), as
+     * in correctPeriodicOrbit(). The corrections are executed concurrently if a parallel task
+     * pool is set. Initial guesses for which the correction does not converge are flagged,
+     * instead of throwing an exception.
+     * \param initialGuesses List of initial guesses of free variables.
+     * \param convergenceFlags Flags indicating whether the correction of each initial guess has
+     *          converged (returned by reference).
+     * \param fixedFreeVariableIndex Index of free variable that is kept fixed (default -1, for no
+     *          fixed free variable).
+     * \return Corrected free variables (equal to initial guess if not converged).
+     */
+    PeriodicOrbitFreeVariablesList correctPeriodicOrbits(
+            const PeriodicOrbitFreeVariablesList& initialGuesses,
+            std::vector< bool >& convergenceFlags,
+            const int fixedFreeVariableIndex = -1 ) const;
+
+    //! Compute tangent to family of periodic orbits.
+    /*!
+     * Computes the unit tangent to the family of periodic orbits, i.e., the null vector of the
+     * Jacobian of the constraints w.r.t. the free variables.
+     * \param freeVariables Free variables of (corrected) periodic orbit.
+     * \param direction Direction that determines the sign of the tangent, such that the inner
+     *          product of the tangent and this direction is non-negative.
+     * \return Unit tangent to family of periodic orbits.
+     */
+    Eigen::Vector4d computeFamilyTangent( const Eigen::Vector4d& freeVariables,
+                                          const Eigen::Vector4d& direction ) const;
+
+    //! Continue family of periodic orbits.
+    /*!
+     * Generates members of a family of periodic orbits by pseudo-arclength continuation, starting
+     * from a corrected periodic orbit. The number of members that is predicted and corrected
+     * concurrently is equal to the number of threads of the parallel task pool (or one, if no
+     * pool is set). If none of the members of a batch converges, the step length is halved; once
+     * it drops below 1/1024 of the initial step length, an exception is thrown. If all members of
+     * a batch converge, the step length is doubled, up to the initial step length.
+     * \param firstMember Free variables of corrected periodic orbit from which continuation
+     *          starts.
+     * \param direction Direction of continuation, such that the inner product of the family
+     *          tangent and this direction is positive for the first step.
+     * \param stepLength Initial (and maximum) pseudo-arclength step length between members.
+     * \param numberOfMembers Number of family members to generate, including the first member.
+     * \return Free variables of family members.
+     */
+    PeriodicOrbitFreeVariablesList continuePeriodicOrbitFamily(
+            const Eigen::Vector4d& firstMember, const Eigen::Vector4d& direction,
+            const double stepLength, const unsigned int numberOfMembers ) const;
+
+    //! Get mass parameter.
+    /*!
+     * Returns the mass parameter of the CRTBP.
+     * \return Mass parameter.
+     */
+    double getMassParameter( ) const { return massParameter; }
+
+protected:
+
+private:
+
+    //! Correct free variables, subject to additional linear constraint.
+    /*!
+     * Corrects free variables by Newton iterations. If the gradient of the additional linear
+     * constraint is zero, the minimum-norm update is used; otherwise, the additional constraint
+     * gradient * freeVariables = additionalConstraintValue is imposed.
+     * \param initialGuess Initial guess of free variables.
+     * \param additionalConstraintGradient Gradient of additional linear constraint.
+     * \param additionalConstraintValue Value of additional linear constraint.
+     * \param constraintJacobian Jacobian of constraints w.r.t. free variables at the corrected
+     *          free variables (returned by reference).
+     * \return Corrected free variables.
+     */
+    Eigen::Vector4d correctFreeVariables( const Eigen::Vector4d& initialGuess,
+                                          const Eigen::Vector4d& additionalConstraintGradient,
+                                          const double additionalConstraintValue,
+                                          Eigen::Matrix< double, 3, 4 >& constraintJacobian ) const;
+
+    //! Correct free variables, and store result.
+    /*!
+     * Corrects free variables as in correctFreeVariables(), and stores the result and a
+     * convergence flag at the given locations, instead of throwing an exception if the
+     * correction does not converge. This function is used as task for the parallel task pool.
+     * \param initialGuess Pointer to initial guess of free variables.
+     * \param additionalConstraintGradient Pointer to gradient of additional linear constraint.
+     * \param additionalConstraintValue Value of additional linear constraint.
+     * \param correctedFreeVariables Pointer to location where corrected free variables are
+     *          stored.
+     * \param constraintJacobian Pointer to location where Jacobian of constraints at corrected
+     *          free variables is stored.
+     * \param isConverged Pointer to location where convergence flag is stored.
+     */
+    void correctAndStoreFreeVariables( const Eigen::Vector4d* initialGuess,
+                                       const Eigen::Vector4d* additionalConstraintGradient,
+                                       const double additionalConstraintValue,
+                                       Eigen::Vector4d* correctedFreeVariables,
+                                       Eigen::Matrix< double, 3, 4 >* constraintJacobian,
+                                       int* isConverged ) const;
+
+    //! Execute tasks.
+    /*!
+     * Executes tasks using the parallel task pool, or serially if no pool is set.
+     * \param tasks List of tasks.
+     */
+    void executeTasks( const std::vector< basics::ParallelTaskPool::Task >&
+                       tasks ) const;
+
+    //! Mass parameter.
+    /*!
+     * Mass parameter of the CRTBP.
+     */
+    const double massParameter;
+
+    //! Parallel task pool.
+    /*!
+     * Parallel task pool used to correct orbits concurrently (NULL for serial correction).
+     */
+    const basics::ParallelTaskPoolPointer parallelTaskPool;
+
+    //! Constraint tolerance.
+    /*!
+     * Tolerance on the infinity norm of the constraints, at which the correction is converged.
+     */
+    const double constraintTolerance;
+
+    //! Maximum number of iterations.
+    /*!
+     * Maximum number of Newton iterations per correction.
+     */
+    const unsigned int maximumNumberOfIterations;
+
+    //! Integration error tolerance.
+    /*!
+     * Error tolerance of the Taylor series integrator.
+     */
+    const double integrationErrorTolerance;
+};
+
+//! Typedef for shared-pointer to PeriodicOrbitContinuation object.
+typedef boost::shared_ptr< PeriodicOrbitContinuation > PeriodicOrbitContinuationPointer;
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_PERIODIC_ORBITS_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
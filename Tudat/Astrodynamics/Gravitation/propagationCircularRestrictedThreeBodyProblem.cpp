@@ -0,0 +1,237 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140226    S. Vermeer        File created.
+ *      140415    S. Vermeer        Used list of Cartesian states with aligned allocator.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+
+#include <TudatCore/Basics/utilityMacros.h>
+
+#include "Tudat/Astrodynamics/Gravitation/propagationCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Mathematics/NumericalIntegrators/taylorSeriesExpressionGraph.h"
+#include "Tudat/Mathematics/NumericalIntegrators/taylorSeriesIntegrator.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+namespace
+{
+
+using numerical_integrators::TaylorSeriesVariable;
+
+//! Compute state derivative of CRTBP, with Taylor series variables.
+/*!
+ * Computes state derivative of CRTBP, with Taylor series variables, in the form required by the
+ * Taylor series integrator.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param time Time (unused, since the CRTBP is autonomous).
+ * \param cartesianState Cartesian state.
+ * \return State derivative.
+ */
+Eigen::Matrix< TaylorSeriesVariable, 6, 1 > computeTaylorSeriesStateDerivative(
+        const double massParameter, const TaylorSeriesVariable time,
+        const Eigen::Matrix< TaylorSeriesVariable, 6, 1 >& cartesianState )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+    return computeCircularRestrictedThreeBodyProblemStateDerivative(
+                massParameter, cartesianState );
+}
+
+//! Compute derivative of state and state transition matrix of CRTBP, with Taylor series
+//! variables.
+/*!
+ * Computes derivative of state and state transition matrix of CRTBP, with Taylor series
+ * variables, in the form required by the Taylor series integrator.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param time Time (unused, since the CRTBP is autonomous).
+ * \param stateAndStateTransitionMatrix Cartesian state and state transition matrix.
+ * \return Derivative of state and state transition matrix.
+ */
+Eigen::Matrix< TaylorSeriesVariable, 42, 1 >
+computeTaylorSeriesStateAndStateTransitionMatrixDerivative(
+        const double massParameter, const TaylorSeriesVariable time,
+        const Eigen::Matrix< TaylorSeriesVariable, 42, 1 >& stateAndStateTransitionMatrix )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+    return computeCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrixDerivative(
+                massParameter, stateAndStateTransitionMatrix );
+}
+
+//! Propagate state using Taylor series integrator.
+/*!
+ * Propagates a state over a given time using the Taylor series integrator.
+ * \tparam StateType Type of state.
+ * \param stateDerivativeFunction State derivative function, with Taylor series variables.
+ * \param initialState Initial state.
+ * \param propagationTime Propagation time (may be negative).
+ * \param errorTolerance Relative and absolute error tolerance.
+ * \return Propagated state.
+ */
+template< typename StateType >
+StateType propagateUsingTaylorSeriesIntegrator(
+        const typename numerical_integrators::TaylorSeriesIntegrator< double, StateType >::
+        TaylorSeriesStateDerivativeFunction& stateDerivativeFunction,
+        const StateType& initialState, const double propagationTime, const double errorTolerance )
+{
+    if ( propagationTime == 0.0 )
+    {
+        return initialState;
+    }
+
+    numerical_integrators::TaylorSeriesIntegrator< double, StateType > integrator(
+                stateDerivativeFunction, 0.0, initialState, errorTolerance, errorTolerance );
+
+    return integrator.integrateTo( propagationTime, ( propagationTime < 0.0 )
+                                   ? -integrator.getNextStepSize( )
+                                   : integrator.getNextStepSize( ) );
+}
+
+//! Propagate state in CRTBP, and store result.
+/*!
+ * Propagates a state in the CRTBP, and stores the result at the given location. This function is
+ * used as task for the parallel task pool.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param initialState Pointer to initial Cartesian state.
+ * \param propagationTime Propagation time.
+ * \param errorTolerance Relative and absolute error tolerance.
+ * \param propagatedState Pointer to location where propagated state is stored.
+ */
+void propagateAndStoreState( const double massParameter,
+                             const basic_mathematics::Vector6d* initialState,
+                             const double propagationTime, const double errorTolerance,
+                             basic_mathematics::Vector6d* propagatedState )
+{
+    *propagatedState = propagateCircularRestrictedThreeBodyProblemState(
+                massParameter, *initialState, propagationTime, errorTolerance );
+}
+
+} // namespace
+
+//! Propagate state in CRTBP.
+basic_mathematics::Vector6d propagateCircularRestrictedThreeBodyProblemState(
+        const double massParameter, const basic_mathematics::Vector6d& initialState,
+        const double propagationTime, const double errorTolerance )
+{
+    return propagateUsingTaylorSeriesIntegrator< basic_mathematics::Vector6d >(
+                boost::bind( &computeTaylorSeriesStateDerivative, massParameter, _1, _2 ),
+                initialState, propagationTime, errorTolerance );
+}
+
+//! Propagate state and state transition matrix in CRTBP.
+std::pair< basic_mathematics::Vector6d, basic_mathematics::Matrix6d >
+propagateCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrix(
+        const double massParameter, const basic_mathematics::Vector6d& initialState,
+        const double propagationTime, const double errorTolerance )
+{
+    // Set initial state and identity state transition matrix.
+    Vector42d initialStateAndStateTransitionMatrix;
+    initialStateAndStateTransitionMatrix.segment< 6 >( 0 ) = initialState;
+    for ( int column = 0; column < 6; column++ )
+    {
+        initialStateAndStateTransitionMatrix.segment< 6 >( 6 + 6 * column )
+                = basic_mathematics::Vector6d::Unit( column );
+    }
+
+    // Propagate state and state transition matrix.
+    const Vector42d propagatedStateAndStateTransitionMatrix
+            = propagateUsingTaylorSeriesIntegrator< Vector42d >(
+                boost::bind( &computeTaylorSeriesStateAndStateTransitionMatrixDerivative,
+                             massParameter, _1, _2 ),
+                initialStateAndStateTransitionMatrix, propagationTime, errorTolerance );
+
+    // Unpack state and state transition matrix.
+    basic_mathematics::Matrix6d stateTransitionMatrix;
+    for ( int column = 0; column < 6; column++ )
+    {
+        stateTransitionMatrix.col( column )
+                = propagatedStateAndStateTransitionMatrix.segment< 6 >( 6 + 6 * column );
+    }
+
+    return std::make_pair( basic_mathematics::Vector6d(
+                               propagatedStateAndStateTransitionMatrix.segment< 6 >( 0 ) ),
+                           stateTransitionMatrix );
+}
+
+//! Propagate batch of states in CRTBP.
+CartesianStatesList propagateCircularRestrictedThreeBodyProblemStates(
+        const double massParameter, const CartesianStatesList& initialStates,
+        const std::vector< double >& propagationTimes, const double errorTolerance,
+        const basics::ParallelTaskPoolPointer parallelTaskPool )
+{
+    if ( initialStates.size( ) != propagationTimes.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Number of initial states and propagation times "
+                                            "are not equal." ) ) );
+    }
+
+    CartesianStatesList propagatedStates( initialStates.size( ) );
+
+    // Create one propagation task per state, each of which stores its result separately.
+    std::vector< basics::ParallelTaskPool::Task > propagationTasks;
+    propagationTasks.reserve( initialStates.size( ) );
+    for ( unsigned int i = 0; i < initialStates.size( ); i++ )
+    {
+        propagationTasks.push_back(
+                    boost::bind( &propagateAndStoreState, massParameter, &initialStates[ i ],
+                                 propagationTimes[ i ], errorTolerance,
+                                 &propagatedStates[ i ] ) );
+    }
+
+    // Execute tasks, concurrently if a task pool is given.
+    if ( parallelTaskPool )
+    {
+        parallelTaskPool->executeTasks( propagationTasks );
+    }
+    else
+    {
+        for ( unsigned int i = 0; i < propagationTasks.size( ); i++ )
+        {
+            propagationTasks[ i ]( );
+        }
+    }
+
+    return propagatedStates;
+}
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,224 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140226    S. Vermeer        File created.
+ *      140415    S. Vermeer        Added typedef for list of Cartesian states, using aligned
+ *                                  allocator.
+ *
+ *    References
+ *      Wakker, K.F., "Astrodynamics I, AE4-874", Delft University of Technology, 2007.
+ *      Jorba, A., Zou, M. A software package for the numerical integration of ODEs by means of
+ *          high-order Taylor methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *
+ *    Notes
+ *      The functions in this file propagate states in the CRTBP (and their state transition
+ *      matrices) using the Taylor series integrator, which is created for each propagation.
+ *      Since no data is shared between propagations, the batch propagation function can
+ *      distribute the propagations over the threads of a parallel task pool.
+ *
+ */
+
+#ifndef TUDAT_PROPAGATION_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
+#define TUDAT_PROPAGATION_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+//! Typedef for list of Cartesian states.
+typedef std::vector< basic_mathematics::Vector6d,
+                     Eigen::aligned_allocator< basic_mathematics::Vector6d > > CartesianStatesList;
+
+//! Typedef for combined state and state transition matrix in CRTBP.
+/*!
+ * Typedef for combined state and state transition matrix in CRTBP. The first six elements contain
+ * the Cartesian state, the remaining 36 elements contain the state transition matrix, stored
+ * column by column.
+ */
+typedef Eigen::Matrix< double, 42, 1 > Vector42d;
+
+//! Compute derivative of state and state transition matrix in CRTBP.
+/*!
+ * Computes the derivative of the state and state transition matrix in the CRTBP, i.e., the
+ * equations of motion augmented with the variational equations \f$\dot{\Phi} = A \Phi\f$, where
+ * \f$A\f$ is the Jacobian of the state derivative w.r.t. the state. This function is templated on
+ * the scalar type of the state, so that it can be recorded by the TaylorSeriesIntegrator.
+ * \tparam ScalarType Scalar type of state.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param stateAndStateTransitionMatrix Cartesian state, followed by the state transition matrix
+ *          (column by column), in normalized units.
+ * \return Derivative of state and state transition matrix, in normalized units.
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 42, 1 >
+computeCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrixDerivative(
+        const double massParameter,
+        const Eigen::Matrix< ScalarType, 42, 1 >& stateAndStateTransitionMatrix )
+{
+    using std::pow;
+
+    // Compute state derivative.
+    const Eigen::Matrix< ScalarType, 6, 1 > cartesianState
+            = stateAndStateTransitionMatrix.template segment< 6 >( 0 );
+    Eigen::Matrix< ScalarType, 42, 1 > stateAndStateTransitionMatrixDerivative;
+    stateAndStateTransitionMatrixDerivative.template segment< 6 >( 0 )
+            = computeCircularRestrictedThreeBodyProblemStateDerivative(
+                massParameter, cartesianState );
+
+    // Compute positions w.r.t. primary and secondary bodies, and associated inverse powers of
+    // distances.
+    Eigen::Matrix< ScalarType, 3, 1 > positionWrtPrimaryBody
+            = cartesianState.template segment< 3 >( xPositionIndex );
+    positionWrtPrimaryBody( xPositionIndex ) += massParameter;
+    Eigen::Matrix< ScalarType, 3, 1 > positionWrtSecondaryBody
+            = cartesianState.template segment< 3 >( xPositionIndex );
+    positionWrtSecondaryBody( xPositionIndex ) -= ( 1.0 - massParameter );
+
+    const ScalarType distanceToPrimaryBodySquared = positionWrtPrimaryBody.squaredNorm( );
+    const ScalarType distanceToSecondaryBodySquared = positionWrtSecondaryBody.squaredNorm( );
+
+    const ScalarType scaledInverseDistanceToPrimaryBodyCubed
+            = ( 1.0 - massParameter ) * pow( distanceToPrimaryBodySquared, -1.5 );
+    const ScalarType scaledInverseDistanceToSecondaryBodyCubed
+            = massParameter * pow( distanceToSecondaryBodySquared, -1.5 );
+    const ScalarType scaledInverseDistanceToPrimaryBodyFifth
+            = 3.0 * ( 1.0 - massParameter ) * pow( distanceToPrimaryBodySquared, -2.5 );
+    const ScalarType scaledInverseDistanceToSecondaryBodyFifth
+            = 3.0 * massParameter * pow( distanceToSecondaryBodySquared, -2.5 );
+
+    // Compute Hessian of effective potential w.r.t. position (Wakker, 2007).
+    Eigen::Matrix< ScalarType, 3, 3 > potentialHessian;
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j <= i; j++ )
+        {
+            potentialHessian( i, j )
+                    = scaledInverseDistanceToPrimaryBodyFifth
+                    * positionWrtPrimaryBody( i ) * positionWrtPrimaryBody( j )
+                    + scaledInverseDistanceToSecondaryBodyFifth
+                    * positionWrtSecondaryBody( i ) * positionWrtSecondaryBody( j );
+            potentialHessian( j, i ) = potentialHessian( i, j );
+        }
+
+        potentialHessian( i, i ) -= scaledInverseDistanceToPrimaryBodyCubed
+                + scaledInverseDistanceToSecondaryBodyCubed;
+    }
+    potentialHessian( xPositionIndex, xPositionIndex ) += 1.0;
+    potentialHessian( yPositionIndex, yPositionIndex ) += 1.0;
+
+    // Compute derivative of state transition matrix, column by column, exploiting the structure
+    // of the Jacobian of the state derivative.
+    for ( int column = 0; column < 6; column++ )
+    {
+        const Eigen::Matrix< ScalarType, 6, 1 > stateTransitionMatrixColumn
+                = stateAndStateTransitionMatrix.template segment< 6 >( 6 + 6 * column );
+
+        Eigen::Matrix< ScalarType, 6, 1 > stateTransitionMatrixColumnDerivative;
+        stateTransitionMatrixColumnDerivative.template segment< 3 >( xPositionIndex )
+                = stateTransitionMatrixColumn.template segment< 3 >( xVelocityIndex );
+        stateTransitionMatrixColumnDerivative.template segment< 3 >( xAccelerationIndex )
+                = potentialHessian
+                * stateTransitionMatrixColumn.template segment< 3 >( xPositionIndex );
+        stateTransitionMatrixColumnDerivative( xAccelerationIndex )
+                += 2.0 * stateTransitionMatrixColumn( yVelocityIndex );
+        stateTransitionMatrixColumnDerivative( yAccelerationIndex )
+                -= 2.0 * stateTransitionMatrixColumn( xVelocityIndex );
+
+        stateAndStateTransitionMatrixDerivative.template segment< 6 >( 6 + 6 * column )
+                = stateTransitionMatrixColumnDerivative;
+    }
+
+    return stateAndStateTransitionMatrixDerivative;
+}
+
+//! Propagate state in CRTBP.
+/*!
+ * Propagates a state in the CRTBP over a given time, using the Taylor series integrator.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param initialState Initial Cartesian state, in normalized units.
+ * \param propagationTime Propagation time, in normalized units (may be negative).
+ * \param errorTolerance Relative and absolute error tolerance of the Taylor series integrator.
+ * \return Propagated Cartesian state, in normalized units.
+ */
+basic_mathematics::Vector6d propagateCircularRestrictedThreeBodyProblemState(
+        const double massParameter, const basic_mathematics::Vector6d& initialState,
+        const double propagationTime, const double errorTolerance = 1.0e-14 );
+
+//! Propagate state and state transition matrix in CRTBP.
+/*!
+ * Propagates a state and its state transition matrix in the CRTBP over a given time, using the
+ * Taylor series integrator. The state transition matrix is initialized to the identity matrix.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param initialState Initial Cartesian state, in normalized units.
+ * \param propagationTime Propagation time, in normalized units (may be negative).
+ * \param errorTolerance Relative and absolute error tolerance of the Taylor series integrator,
+ *          which applies to both the state and the state transition matrix.
+ * \return Pair of propagated Cartesian state and state transition matrix, in normalized units.
+ */
+std::pair< basic_mathematics::Vector6d, basic_mathematics::Matrix6d >
+propagateCircularRestrictedThreeBodyProblemStateAndStateTransitionMatrix(
+        const double massParameter, const basic_mathematics::Vector6d& initialState,
+        const double propagationTime, const double errorTolerance = 1.0e-14 );
+
+//! Propagate batch of states in CRTBP.
+/*!
+ * Propagates a batch of states in the CRTBP, each over its own propagation time, using the
+ * Taylor series integrator. If a parallel task pool is given, the propagations are distributed
+ * over its threads; the results do not depend on the number of threads.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param initialStates Initial Cartesian states, in normalized units.
+ * \param propagationTimes Propagation times, in normalized units, of the same size as the list
+ *          of initial states.
+ * \param errorTolerance Relative and absolute error tolerance of the Taylor series integrator.
+ * \param parallelTaskPool Parallel task pool used to propagate the states concurrently (default
+ *          is serial propagation).
+ * \return Propagated Cartesian states, in normalized units.
+ */
+CartesianStatesList propagateCircularRestrictedThreeBodyProblemStates(
+        const double massParameter, const CartesianStatesList& initialStates,
+        const std::vector< double >& propagationTimes, const double errorTolerance = 1.0e-14,
+        const basics::ParallelTaskPoolPointer parallelTaskPool
+        = basics::ParallelTaskPoolPointer( ) );
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_PROPAGATION_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
@@ -30,6 +30,13 @@
  *                                  renamed file, and merged content from other files.
  *      121210    D. Dirkx          Simplified class by removing template parameters.
  *      130224    K. Kumar          Updated include guard name; corrected Doxygen errors.
+ *      140221    S. Vermeer        Added scalar-type template of acceleration sum; added state
+ *                                  matrix template parameter to class, to allow automatic
+ *                                  differentiation scalars.
+ *      140401    S. Vermeer        Renamed scalar-type template of acceleration sum, so that it
+ *                                  does not overload the double-precision function.
+ *      140415    S. Vermeer        Used double-precision acceleration sum in class for double
+ *                                  states, such that results are unchanged.
  *
  *    References
  *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
@@ -44,8 +51,10 @@
 #ifndef TUDAT_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
 #define TUDAT_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
 
+#include <cmath>
 #include <stdexcept>
 
+#include <boost/exception/all.hpp>
 #include <boost/function.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/shared_ptr.hpp>
@@ -54,6 +63,10 @@
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+#include "Tudat/Mathematics/BasicMathematics/automaticDifferentiation.h"
+#include "Tudat/Mathematics/BasicMathematics/coordinateConversions.h"
+#include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
 
 namespace tudat
 {
@@ -109,6 +122,123 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
         const Eigen::MatrixXd& cosineHarmonicCoefficients,
         const Eigen::MatrixXd& sineHarmonicCoefficients );
 
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, defined using
+//! geodesy-normalization, for arbitrary scalar type.
+/*!
+ * Computes the acceleration caused by gravitational spherical harmonics, as described for the
+ * double-precision computeGeodesyNormalizedGravitationalAccelerationSum() function, for an
+ * arbitrary scalar type of the position and gravitational parameter (for instance an automatic
+ * differentiation scalar). The spherical coordinates are computed using atan2, such that no
+ * special treatment of positions on the z-axis is required for the latitude. For automatic
+ * differentiation scalars, the Legendre polynomials are evaluated by the overload of
+ * computeGeodesyLegendrePolynomialTemplate() in automaticDifferentiation.h.
+ * \tparam ScalarType Scalar type used for position, gravitational parameter and acceleration.
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients [m].
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients <B>Geodesy-normalized</B> coefficients of cosine terms.
+ * \param sineHarmonicCoefficients <B>Geodesy-normalized</B> coefficients of sine terms.
+ * \return Cartesian acceleration vector resulting from the summation of all harmonic terms
+ *          [m s^-2].
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeGeodesyNormalizedGravitationalAccelerationSumTemplate(
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfBodySubjectToAcceleration,
+        const ScalarType& gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients )
+{
+    using std::atan2;
+    using std::sin;
+    using std::sqrt;
+    using basic_mathematics::radiusIndex;
+    using basic_mathematics::latitudeIndex;
+    using basic_mathematics::longitudeIndex;
+
+    // Set highest degree and order.
+    const int highestDegree = cosineHarmonicCoefficients.rows( );
+    const int highestOrder = cosineHarmonicCoefficients.cols( );
+
+    // Compute distance within xy-plane.
+    const ScalarType xyDistance = sqrt(
+                positionOfBodySubjectToAcceleration( 0 ) * positionOfBodySubjectToAcceleration( 0 )
+                + positionOfBodySubjectToAcceleration( 1 )
+                * positionOfBodySubjectToAcceleration( 1 ) );
+
+    // Compute spherical position vector.
+    Eigen::Matrix< ScalarType, 3, 1 > sphericalPositionOfBodySubjectToAcceleration;
+    sphericalPositionOfBodySubjectToAcceleration( radiusIndex )
+            = positionOfBodySubjectToAcceleration.norm( );
+    sphericalPositionOfBodySubjectToAcceleration( latitudeIndex )
+            = atan2( positionOfBodySubjectToAcceleration( 2 ), xyDistance );
+    sphericalPositionOfBodySubjectToAcceleration( longitudeIndex )
+            = atan2( positionOfBodySubjectToAcceleration( 1 ),
+                     positionOfBodySubjectToAcceleration( 0 ) );
+
+    // If radius coordinate is smaller than planetary radius...
+    if ( sphericalPositionOfBodySubjectToAcceleration( radiusIndex ) < equatorialRadius )
+    {
+        // ...throw runtime error.
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Distance to origin is smaller than the size of the main body." ) ) );
+    }
+
+    // Compute gradient premultiplier.
+    const ScalarType preMultiplier = gravitationalParameter / equatorialRadius;
+
+    // Compute sine of latitude, which is the parameter of the Legendre polynomials.
+    const ScalarType sineOfLatitude
+            = sin( sphericalPositionOfBodySubjectToAcceleration( latitudeIndex ) );
+
+    // Initialize gradient vector.
+    Eigen::Matrix< ScalarType, 3, 1 > sphericalGradient
+            = Eigen::Matrix< ScalarType, 3, 1 >::Zero( );
+
+    // Loop through all degrees.
+    for ( int degree = 0; degree < highestDegree; degree++ )
+    {
+        // Loop through all orders.
+        for ( int order = 0; order <= degree && order < highestOrder; order++ )
+        {
+            // Compute geodesy-normalized Legendre polynomials.
+            const ScalarType legendrePolynomial
+                    = basic_mathematics::computeGeodesyLegendrePolynomialTemplate(
+                        degree, order, sineOfLatitude );
+            const ScalarType incrementedLegendrePolynomial
+                    = basic_mathematics::computeGeodesyLegendrePolynomialTemplate(
+                        degree, order + 1, sineOfLatitude );
+
+            // Compute geodesy-normalized Legendre polynomial derivative.
+            const ScalarType legendrePolynomialDerivative
+                    = basic_mathematics::computeGeodesyLegendrePolynomialDerivativeTemplate(
+                        degree, order, sineOfLatitude,
+                        legendrePolynomial, incrementedLegendrePolynomial );
+
+            // Compute the potential gradient of a single spherical harmonic term.
+            sphericalGradient += basic_mathematics::computePotentialGradientTemplate(
+                        sphericalPositionOfBodySubjectToAcceleration,
+                        equatorialRadius,
+                        preMultiplier,
+                        degree,
+                        order,
+                        cosineHarmonicCoefficients( degree, order ),
+                        sineHarmonicCoefficients( degree, order ),
+                        legendrePolynomial,
+                        legendrePolynomialDerivative );
+        }
+    }
+
+    // Convert from spherical gradient to Cartesian gradient (which equals acceleration vector) and
+    // return the resulting acceleration vector.
+    return basic_mathematics::coordinate_conversions::convertSphericalToCartesianGradientTemplate(
+                sphericalGradient, positionOfBodySubjectToAcceleration );
+}
+
 //! Compute gravitational acceleration due to single spherical harmonics term.
 /*!
  * This function computes the acceleration caused by a single gravitational spherical harmonics
@@ -166,16 +296,19 @@ Eigen::Vector3d computeSingleGeodesyNormalizedGravitationalAcceleration(
  * sum, based on the matrix of coefficients of the model provided.
  * \tparam CoefficientMatrixType Data type for cosine and sine coefficients in spherical harmonics
  *         expansion; may be used for compile-time definition of maximum degree and order.
+ * \tparam StateMatrix Data type for state matrix (default = Eigen::Vector3d). Its scalar type is
+ *         also used for the gravitational parameter.
  */
-template< typename CoefficientMatrixType = Eigen::MatrixXd >
+template< typename CoefficientMatrixType = Eigen::MatrixXd,
+          typename StateMatrix = Eigen::Vector3d >
 class SphericalHarmonicsGravitationalAccelerationModel
-        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
-        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+        : public basic_astrodynamics::AccelerationModel< StateMatrix >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< StateMatrix >
 {
 private:
 
     //! Typedef for base class.
-    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< StateMatrix > Base;
 
     //! Typedef for coefficient-matrix-returning function.
     typedef boost::function< CoefficientMatrixType( ) > CoefficientMatrixReturningFunction;
@@ -204,13 +337,13 @@ public:
      *          body exerting gravitational acceleration (default = (0,0,0)).
      */
     SphericalHarmonicsGravitationalAccelerationModel(
-            const StateFunction positionOfBodySubjectToAccelerationFunction,
-            const double aGravitationalParameter,
+            const typename Base::StateFunction positionOfBodySubjectToAccelerationFunction,
+            const typename Base::ScalarType aGravitationalParameter,
             const double anEquatorialRadius,
             const CoefficientMatrixType aCosineHarmonicCoefficientMatrix,
             const CoefficientMatrixType aSineHarmonicCoefficientMatrix,
-            const StateFunction positionOfBodyExertingAccelerationFunction
-            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+            const typename Base::StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( StateMatrix::Zero( ) ) )
         : Base( positionOfBodySubjectToAccelerationFunction,
                 aGravitationalParameter,
                 positionOfBodyExertingAccelerationFunction ),
@@ -243,13 +376,13 @@ public:
      *          body exerting gravitational acceleration (default = (0,0,0)).
      */
     SphericalHarmonicsGravitationalAccelerationModel(
-            const StateFunction positionOfBodySubjectToAccelerationFunction,
-            const double aGravitationalParameter,
+            const typename Base::StateFunction positionOfBodySubjectToAccelerationFunction,
+            const typename Base::ScalarType aGravitationalParameter,
             const double anEquatorialRadius,
             const CoefficientMatrixReturningFunction cosineHarmonicCoefficientsFunction,
             const CoefficientMatrixReturningFunction sineHarmonicCoefficientsFunction,
-            const StateFunction positionOfBodyExertingAccelerationFunction
-            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+            const typename Base::StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( StateMatrix::Zero( ) ) )
         : Base( positionOfBodySubjectToAccelerationFunction,
                 aGravitationalParameter,
                 positionOfBodyExertingAccelerationFunction ),
@@ -264,10 +397,12 @@ public:
     /*!
      * Returns the gravitational acceleration computed using the input parameters provided to the
      * class. This function serves as a wrapper for the
-     * computeGeodesyNormalizedGravitationalAccelerationSum() function.
+     * computeGeodesyNormalizedGravitationalAccelerationSum() function for double states, and for
+     * the computeGeodesyNormalizedGravitationalAccelerationSumTemplate() function for other
+     * scalar types.
      * \return Computed gravitational acceleration vector.
      */
-    Eigen::Vector3d getAcceleration( );
+    StateMatrix getAcceleration( );
 
     //! Update class members.
     /*!
@@ -285,6 +420,41 @@ protected:
 
 private:
 
+    //! Compute gravitational acceleration sum for double state.
+    /*!
+     * Computes the gravitational acceleration sum using the double-precision
+     * computeGeodesyNormalizedGravitationalAccelerationSum() function.
+     * \param relativePosition Position of body subject to acceleration w.r.t. body exerting it.
+     * \param aGravitationalParameter Gravitational parameter [m^3 s^-2].
+     * \return Computed gravitational acceleration vector.
+     */
+    Eigen::Vector3d computeAccelerationSum( const Eigen::Vector3d& relativePosition,
+                                            const double aGravitationalParameter ) const
+    {
+        return computeGeodesyNormalizedGravitationalAccelerationSum(
+                    relativePosition, aGravitationalParameter, equatorialRadius,
+                    cosineHarmonicCoefficients, sineHarmonicCoefficients );
+    }
+
+    //! Compute gravitational acceleration sum for state of arbitrary scalar type.
+    /*!
+     * Computes the gravitational acceleration sum using the
+     * computeGeodesyNormalizedGravitationalAccelerationSumTemplate() function.
+     * \tparam ScalarType Scalar type of state and gravitational parameter.
+     * \param relativePosition Position of body subject to acceleration w.r.t. body exerting it.
+     * \param aGravitationalParameter Gravitational parameter [m^3 s^-2].
+     * \return Computed gravitational acceleration vector.
+     */
+    template< typename ScalarType >
+    Eigen::Matrix< ScalarType, 3, 1 > computeAccelerationSum(
+            const Eigen::Matrix< ScalarType, 3, 1 >& relativePosition,
+            const ScalarType& aGravitationalParameter ) const
+    {
+        return computeGeodesyNormalizedGravitationalAccelerationSumTemplate(
+                    relativePosition, aGravitationalParameter, equatorialRadius,
+                    cosineHarmonicCoefficients, sineHarmonicCoefficients );
+    }
+
     //! Equatorial radius [m].
     /*!
      * Current value of equatorial (planetary) radius used for spherical harmonics expansion [m].
@@ -331,17 +501,13 @@ SphericalHarmonicsGravitationalAccelerationModelXdPointer;
 // only need to look at the code below if you are interested in the source implementation.
 
 //! Get gravitational acceleration.
-template< typename CoefficientMatrixType >
-Eigen::Vector3d SphericalHarmonicsGravitationalAccelerationModel< CoefficientMatrixType >
+template< typename CoefficientMatrixType, typename StateMatrix >
+StateMatrix SphericalHarmonicsGravitationalAccelerationModel< CoefficientMatrixType, StateMatrix >
 ::getAcceleration( )
 {
-    return computeGeodesyNormalizedGravitationalAccelerationSum(
-                this->positionOfBodySubjectToAcceleration
-                - this->positionOfBodyExertingAcceleration,
-                gravitationalParameter,
-                equatorialRadius,
-                cosineHarmonicCoefficients,
-                sineHarmonicCoefficients );
+    return computeAccelerationSum( StateMatrix( this->positionOfBodySubjectToAcceleration
+                                                - this->positionOfBodyExertingAcceleration ),
+                                   this->gravitationalParameter );
 }
 
 } // namespace gravitation
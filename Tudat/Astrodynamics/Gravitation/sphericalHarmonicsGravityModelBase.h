@@ -27,8 +27,12 @@
  *      120827    K. Kumar          File created.
  *      121105    K. Kumar          Simplified base class definition.
  *      121210    D. Dirkx          Simplified class by removing template parameters.
+ *      140221    S. Vermeer        Gravitational parameter now uses scalar type of state matrix.
  *
  *    References
+ *      Eigen. Structures having Eigen members,
+ *          http://eigen.tuxfamily.org/dox/TopicStructHavingEigenMembers.html, last accessed: 5th
+ *          March, 2013.
  *
  *    Notes
  *
@@ -39,6 +43,8 @@
 
 #include <boost/function.hpp>
 
+#include <Eigen/Core>
+
 namespace tudat
 {
 namespace gravitation
@@ -48,9 +54,13 @@ namespace gravitation
 /*!
  * This template class serves as the base class for the
  * SphericalHarmonicsGravitationalAccelerationModel, CentralGravitationalAccelerationModel,
- * CentralJ2GravitationalAccelerationModel, CentralJ2J3GravitationalAccelerationModel, and
- * CentralJ2J3J4GravitationalAccelerationModel classes.
- * \tparam StateMatrix Type used to store a state matrix.
+ * CentralJ2GravitationalAccelerationModel, CentralJ2J3GravitationalAccelerationModel,
+ * CentralJ2J3J4GravitationalAccelerationModel, and CentralZonalGravitationalAccelerationModel
+ * classes.
+ * \tparam StateMatrix Type used to store a state matrix. Its scalar type is also used for the
+ *          gravitational parameter, such that automatic differentiation scalars can be used to
+ *          obtain partial derivatives with respect to both the position and the gravitational
+ *          parameter.
  */
 template< typename StateMatrix >
 class SphericalHarmonicsGravitationalAccelerationModelBase
@@ -60,8 +70,14 @@ protected:
     //! Typedef for a position-returning function.
     typedef boost::function< StateMatrix( ) > StateFunction;
 
+    //! Typedef for scalar type of state matrix.
+    typedef typename StateMatrix::Scalar ScalarType;
+
 public:
 
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     //! Default constructor taking position of body subject to acceleration, variable
     //! gravitational parameter, and position of body exerting acceleration.
     /*!
@@ -79,7 +95,7 @@ public:
      */
     SphericalHarmonicsGravitationalAccelerationModelBase(
             const StateFunction positionOfBodySubjectToAccelerationFunction,
-            const double aGravitationalParameter,
+            const ScalarType aGravitationalParameter,
             const StateFunction positionOfBodyExertingAccelerationFunction )
         : subjectPositionFunction( positionOfBodySubjectToAccelerationFunction ),
           gravitationalParameter( aGravitationalParameter ),
@@ -126,7 +142,7 @@ protected:
     /*!
      * Current gravitational parameter of body exerting acceleration [m^3 s^-2].
      */
-    const double gravitationalParameter;
+    const ScalarType gravitationalParameter;
 
     //! Position of body exerting acceleration.
     /*!
@@ -33,6 +33,7 @@
  *      120309    K. Kumar          Updated code to latest Tudat standards; updated
  *                                  computeStateDerivative() function.
  *      120426    K. Kumar          Updated code to compute state derivative more efficiently.
+ *      140224    S. Vermeer        Moved computation to function templated on scalar type.
  *
  *    References
  *        Wakker, K.F., "Astrodynamics I, AE4-874", Delft University of Technology, 2007.
@@ -41,8 +42,6 @@
  *
  */
 
-#include <cmath>
-
 #include <TudatCore/Basics/utilityMacros.h>
 
 #include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
@@ -60,49 +59,8 @@ basic_mathematics::Vector6d StateDerivativeCircularRestrictedThreeBodyProblem::c
 {
     TUDAT_UNUSED_PARAMETER( time );
 
-    // Compute distance to primary body.
-    const double xCoordinateToPrimaryBodySquared =
-            ( cartesianState( xPositionIndex ) + massParameter )
-            * ( cartesianState( xPositionIndex ) + massParameter );
-
-    const double yCoordinateSquared = cartesianState( yPositionIndex )
-            * cartesianState( yPositionIndex );
-
-    const double zCoordinateSquared = cartesianState( zPositionIndex )
-            * cartesianState( zPositionIndex );
-
-    const double normDistanceToPrimaryBodyCubed = pow(
-                xCoordinateToPrimaryBodySquared + yCoordinateSquared + zCoordinateSquared, 1.5 );
-
-    // Compute distance to secondary body.
-    const double xCoordinateSecondaryBodySquared =
-            ( cartesianState( xPositionIndex ) - ( 1.0 - massParameter ) )
-            * ( cartesianState( xPositionIndex ) - ( 1.0 - massParameter ) );
-
-    double normDistanceToSecondaryBodyCubed = pow(
-                xCoordinateSecondaryBodySquared + yCoordinateSquared + zCoordinateSquared, 1.5 );
-
-    // Compute derivative of state.
-    Eigen::VectorXd stateDerivative( 6 );
-
-    stateDerivative.segment( xPositionIndex, 3 ) = cartesianState.segment( xVelocityIndex, 3 );
-
-    stateDerivative( xAccelerationIndex ) = cartesianState( xPositionIndex )
-            - ( ( 1.0 - massParameter ) / normDistanceToPrimaryBodyCubed )
-            * ( cartesianState( xPositionIndex ) + massParameter )
-            - ( massParameter / normDistanceToSecondaryBodyCubed )
-            * ( cartesianState( xPositionIndex ) - ( 1.0 - massParameter ) )
-            + 2.0 * cartesianState( yVelocityIndex );
-    stateDerivative( yAccelerationIndex ) = cartesianState( yPositionIndex )
-            * ( 1.0 - ( ( 1.0 - massParameter ) / normDistanceToPrimaryBodyCubed )
-                - ( massParameter / normDistanceToSecondaryBodyCubed ) )
-            - 2.0 * cartesianState( xVelocityIndex );
-    stateDerivative( zAccelerationIndex ) = -cartesianState( zPositionIndex )
-            * ( ( ( 1.0 - massParameter ) / normDistanceToPrimaryBodyCubed )
-                + ( massParameter / normDistanceToSecondaryBodyCubed ) );
-
-    // Return computed state derivative.
-    return stateDerivative;
+    return computeCircularRestrictedThreeBodyProblemStateDerivative( massParameter,
+                                                                     cartesianState );
 }
 
 } // namespace circular_restricted_three_body_problem
@@ -34,6 +34,8 @@
  *                                  file.
  *      120426    K. Kumar          Added enum for state derivative acceleration elements.
  *      130121    K. Kumar          Added shared-ptr typedef; updated VectorXd to Vector6d.
+ *      140224    S. Vermeer        Added function to compute state derivative templated on scalar
+ *                                  type.
  *
  *    References
  *        Wakker, K.F., "Astrodynamics I, AE4-874", Delft University of Technology, 2007.
@@ -45,6 +47,8 @@
 #ifndef TUDAT_STATE_DERIVATIVE_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
 #define TUDAT_STATE_DERIVATIVE_CIRCULAR_RESTRICTED_THREE_BODY_PROBLEM_H
 
+#include <cmath>
+
 #include <boost/shared_ptr.hpp>
 
 #include <Eigen/Core>
@@ -85,6 +89,67 @@ enum StateDerivativeElementIndices
     zAccelerationIndex = 5
 };
 
+//! Compute state derivative of CRTBP.
+/*!
+ * Computes the state derivative of CRTBP. This function is templated on the scalar type of the
+ * state, so that it can be evaluated for types other than double, such as automatic
+ * differentiation scalars, or the Taylor series variables used by the TaylorSeriesIntegrator.
+ * \tparam ScalarType Scalar type of state.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param cartesianState Cartesian state, in normalized units.
+ * \return State derivative, in normalized units.
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 6, 1 > computeCircularRestrictedThreeBodyProblemStateDerivative(
+        const double massParameter, const Eigen::Matrix< ScalarType, 6, 1 >& cartesianState )
+{
+    using std::pow;
+
+    // Compute distance to primary body.
+    const ScalarType xCoordinateToPrimaryBodySquared =
+            ( cartesianState( xPositionIndex ) + massParameter )
+            * ( cartesianState( xPositionIndex ) + massParameter );
+
+    const ScalarType yCoordinateSquared = cartesianState( yPositionIndex )
+            * cartesianState( yPositionIndex );
+
+    const ScalarType zCoordinateSquared = cartesianState( zPositionIndex )
+            * cartesianState( zPositionIndex );
+
+    const ScalarType normDistanceToPrimaryBodyCubed = pow(
+                xCoordinateToPrimaryBodySquared + yCoordinateSquared + zCoordinateSquared, 1.5 );
+
+    // Compute distance to secondary body.
+    const ScalarType xCoordinateSecondaryBodySquared =
+            ( cartesianState( xPositionIndex ) - ( 1.0 - massParameter ) )
+            * ( cartesianState( xPositionIndex ) - ( 1.0 - massParameter ) );
+
+    const ScalarType normDistanceToSecondaryBodyCubed = pow(
+                xCoordinateSecondaryBodySquared + yCoordinateSquared + zCoordinateSquared, 1.5 );
+
+    // Compute derivative of state.
+    Eigen::Matrix< ScalarType, 6, 1 > stateDerivative;
+
+    stateDerivative.segment( xPositionIndex, 3 ) = cartesianState.segment( xVelocityIndex, 3 );
+
+    stateDerivative( xAccelerationIndex ) = cartesianState( xPositionIndex )
+            - ( ( 1.0 - massParameter ) / normDistanceToPrimaryBodyCubed )
+            * ( cartesianState( xPositionIndex ) + massParameter )
+            - ( massParameter / normDistanceToSecondaryBodyCubed )
+            * ( cartesianState( xPositionIndex ) - ( 1.0 - massParameter ) )
+            + 2.0 * cartesianState( yVelocityIndex );
+    stateDerivative( yAccelerationIndex ) = cartesianState( yPositionIndex )
+            * ( 1.0 - ( ( 1.0 - massParameter ) / normDistanceToPrimaryBodyCubed )
+                - ( massParameter / normDistanceToSecondaryBodyCubed ) )
+            - 2.0 * cartesianState( xVelocityIndex );
+    stateDerivative( zAccelerationIndex ) = -cartesianState( zPositionIndex )
+            * ( ( ( 1.0 - massParameter ) / normDistanceToPrimaryBodyCubed )
+                + ( massParameter / normDistanceToSecondaryBodyCubed ) );
+
+    // Return computed state derivative.
+    return stateDerivative;
+}
+
 //! State derivative model class for CRTBP.
 /*!
  * Class that contains the state derivative model for the CRTBP.
@@ -112,6 +177,13 @@ public:
     basic_mathematics::Vector6d computeStateDerivative(
             const double time, const basic_mathematics::Vector6d& cartesianState );
 
+    //! Get mass parameter.
+    /*!
+     * Returns the mass parameter of the CRTBP.
+     * \return Mass parameter.
+     */
+    double getMassParameter( ) const { return massParameter; }
+
 protected:
 
 private:
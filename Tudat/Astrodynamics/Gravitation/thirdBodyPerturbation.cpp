@@ -26,6 +26,7 @@
  *      YYMMDD    Author            Comment
  *      130307    R.C.A. Boon       File created.
  *      130308    D. Dirkx          Modified to add variable central body position.
+ *      140221    S. Vermeer        Third-body perturbation now uses scalar-type template.
  *
  *    References
  *      Wakker, K.F. Astrodynamics I, Delft University of Technology, 2010.
@@ -51,13 +52,9 @@ Eigen::Vector3d computeThirdBodyPerturbingAcceleration(
         const Eigen::Vector3d& positionOfCentralBody )
 // Using chapter 4 of (Wakker, 2010).
 {
-    // Return acceleration.
-    return computeGravitationalAcceleration( positionOfAffectedBody,
-                                             gravitationalParameterOfPerturbingBody,
-                                             positionOfPerturbingBody ) -
-            computeGravitationalAcceleration( positionOfCentralBody,
-                                              gravitationalParameterOfPerturbingBody,
-                                              positionOfPerturbingBody );
+    return computeThirdBodyPerturbingAccelerationTemplate< double >(
+                gravitationalParameterOfPerturbingBody, positionOfPerturbingBody,
+                positionOfAffectedBody, positionOfCentralBody );
 }
 
 } // namespace gravitation
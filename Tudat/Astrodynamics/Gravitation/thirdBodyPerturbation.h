@@ -26,6 +26,10 @@
  *      YYMMDD    Author            Comment
  *      130307    R.C.A. Boon       File created.
  *      130308    D. Dirkx          Modified to add variable central body position.
+ *      140221    S. Vermeer        Added scalar-type template of third-body perturbation, to
+ *                                  allow automatic differentiation scalars.
+ *      140401    S. Vermeer        Renamed scalar-type template of perturbing acceleration, so that
+ *                                  it does not overload the double-precision function.
  *
  *    References
  *      Wakker, K.F. Astrodynamics I, Delft University of Technology, 2010.
@@ -40,6 +44,8 @@
 
 #include <Eigen/Core>
 
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+
 namespace tudat
 {
 namespace gravitation
@@ -82,6 +88,39 @@ Eigen::Vector3d computeThirdBodyPerturbingAcceleration(
         const Eigen::Vector3d& positionOfAffectedBody,
         const Eigen::Vector3d& positionOfCentralBody = Eigen::Vector3d::Zero( ) );
 
+//! Compute perturbing acceleration by third body for arbitrary scalar type.
+/*!
+ * Computes the perturbing acceleration on a point mass in orbit about a central body (point mass),
+ * caused by a third body (point mass), as described for the double-precision
+ * computeThirdBodyPerturbingAcceleration() function, for an arbitrary scalar type (for instance an
+ * automatic differentiation scalar).
+ * \tparam ScalarType Scalar type used for positions, gravitational parameter and acceleration.
+ * \param gravitationalParameterOfPerturbingBody The gravitational parameter of the perturbing
+ *          body, i.e., the third body [m^3/s^2].
+ * \param positionOfPerturbingBody The position of the third body, in Cartesian coordinates [m].
+ * \param positionOfAffectedBody The position of the body that experiences the perturbation, in
+ *          Cartesian coordinates [m].
+ * \param positionOfCentralBody The position of the central body, in Cartesian coordinates
+ *          (default=origin) [m].
+ * \return The perturbing acceleration in Cartesian components [m/s^2].
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computeThirdBodyPerturbingAccelerationTemplate(
+        const ScalarType& gravitationalParameterOfPerturbingBody,
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfPerturbingBody,
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfAffectedBody,
+        const Eigen::Matrix< ScalarType, 3, 1 >& positionOfCentralBody
+        = Eigen::Matrix< ScalarType, 3, 1 >::Zero( ) )
+{
+    // Return acceleration.
+    return computeGravitationalAccelerationTemplate( positionOfAffectedBody,
+                                                     gravitationalParameterOfPerturbingBody,
+                                                     positionOfPerturbingBody ) -
+            computeGravitationalAccelerationTemplate( positionOfCentralBody,
+                                                      gravitationalParameterOfPerturbingBody,
+                                                      positionOfPerturbingBody );
+}
+
 } // namespace gravitation
 } // namespace tudat
 
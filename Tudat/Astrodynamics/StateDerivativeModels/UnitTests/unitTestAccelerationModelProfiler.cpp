@@ -0,0 +1,221 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140219    S. Vermeer        Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testAccelerationModels.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testBody.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/accelerationModelProfiler.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateDerivativeModel.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using boost::assign::list_of;
+using basic_mathematics::Vector6d;
+using state_derivative_models::AccelerationModelProfiler;
+using state_derivative_models::ExecutionTimeStatistics;
+
+BOOST_AUTO_TEST_SUITE( test_acceleration_model_profiler )
+
+//! Test whether execution time statistics are computed correctly.
+BOOST_AUTO_TEST_CASE( testExecutionTimeStatistics )
+{
+    ExecutionTimeStatistics executionTimeStatistics;
+
+    // Check statistics without samples.
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getNumberOfSamples( ), 0 );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getMeanTime( ), 0.0 );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getPercentile( 50.0 ), 0.0 );
+
+    // Add samples of 1, 2, ..., 100 microseconds, in reverse order.
+    for ( unsigned int i = 100; i > 0; i-- )
+    {
+        executionTimeStatistics.addSample( 1.0e-6 * i );
+    }
+
+    // Check exact statistics.
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getNumberOfSamples( ), 100 );
+    BOOST_CHECK_CLOSE_FRACTION( executionTimeStatistics.getCumulativeTime( ), 5050.0e-6,
+                                1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( executionTimeStatistics.getMeanTime( ), 50.5e-6, 1.0e-14 );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getMinimumTime( ), 1.0e-6 );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getMaximumTime( ), 1.0e-6 * 100 );
+
+    // Check approximate percentiles (limited by histogram bin width of 1/20 decade), and that
+    // extreme percentiles are limited to range of samples.
+    BOOST_CHECK_CLOSE_FRACTION( executionTimeStatistics.getPercentile( 50.0 ), 50.0e-6, 0.06 );
+    BOOST_CHECK_CLOSE_FRACTION( executionTimeStatistics.getPercentile( 90.0 ), 90.0e-6, 0.06 );
+    BOOST_CHECK_CLOSE_FRACTION( executionTimeStatistics.getPercentile( 0.0 ), 1.0e-6, 0.06 );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getPercentile( 100.0 ), 1.0e-6 * 100 );
+
+    // Check that reset removes all samples.
+    executionTimeStatistics.reset( );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getNumberOfSamples( ), 0 );
+    BOOST_CHECK_EQUAL( executionTimeStatistics.getCumulativeTime( ), 0.0 );
+}
+
+//! Test whether acceleration models in Cartesian state derivative model are profiled correctly.
+BOOST_AUTO_TEST_CASE( testAccelerationModelProfilerWithCartesianStateDerivativeModel )
+{
+    using basic_astrodynamics::AccelerationModel3dPointer;
+    using state_derivative_models::AccelerationModelProfilerPointer;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+
+    // Shortcuts.
+    typedef TestBody< 3, double > TestBody3d;
+    typedef boost::shared_ptr< TestBody3d > TestBody3dPointer;
+    typedef DerivedAccelerationModel< > DerivedAccelerationModel3d;
+    typedef AnotherDerivedAccelerationModel< > AnotherDerivedAccelerationModel3d;
+
+    // Create body with zombie time and state.
+    TestBody3dPointer body = boost::make_shared< TestBody3d >( Eigen::VectorXd::Zero( 6 ), 0.0 );
+
+    // Create acceleration models.
+    AccelerationModel3dPointer firstAccelerationModel3d
+            = boost::make_shared< DerivedAccelerationModel3d >(
+                boost::bind( &TestBody3d::getCurrentPosition, body ),
+                boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+    AccelerationModel3dPointer secondAccelerationModel3d
+            = boost::make_shared< AnotherDerivedAccelerationModel3d >(
+                boost::bind( &TestBody3d::getCurrentPosition, body ),
+                boost::bind( &TestBody3d::getCurrentVelocity, body ),
+                boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+    // Create list of acceleration models to provide to state derivative model.
+    CartesianStateDerivativeModel6d::AccelerationModelPointerVector listOfAccelerations
+            = list_of( firstAccelerationModel3d )( secondAccelerationModel3d );
+
+    // Declare Cartesian state derivative model.
+    CartesianStateDerivativeModel6d stateDerivativeModel(
+                listOfAccelerations,
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    // Check that profiler with inconsistent number of acceleration models is rejected.
+    BOOST_CHECK_THROW( stateDerivativeModel.setAccelerationModelProfiler(
+                           boost::make_shared< AccelerationModelProfiler >( 3 ) ),
+                       std::runtime_error );
+
+    // Set profiler.
+    const std::vector< std::string > accelerationModelNames
+            = list_of( "First model" )( "Second model" );
+    AccelerationModelProfilerPointer profiler
+            = boost::make_shared< AccelerationModelProfiler >( accelerationModelNames );
+    stateDerivativeModel.setAccelerationModelProfiler( profiler );
+
+    // Evaluate state derivative model a number of times, and compute expected acceleration
+    // magnitudes.
+    const unsigned int numberOfEvaluations = 10;
+    std::vector< double > firstAccelerationMagnitudes;
+    std::vector< double > secondAccelerationMagnitudes;
+    for ( unsigned int i = 0; i < numberOfEvaluations; i++ )
+    {
+        const double currentTime = 1.0 + 0.5 * i;
+        const Vector6d currentState = ( Eigen::VectorXd( 6 )
+                                        << Eigen::Vector3d( -1.1, 2.2, -3.3 ) * currentTime,
+                                        Eigen::Vector3d( 0.23, 1.67, -0.11 ) ).finished( );
+
+        stateDerivativeModel.computeStateDerivative( currentTime, currentState );
+
+        firstAccelerationMagnitudes.push_back(
+                    firstAccelerationModel3d->getAcceleration( ).norm( ) );
+        secondAccelerationMagnitudes.push_back(
+                    secondAccelerationModel3d->getAcceleration( ).norm( ) );
+    }
+
+    // Check number of calls and execution times.
+    BOOST_CHECK_EQUAL( profiler->getNumberOfAccelerationModels( ), 2 );
+    for ( unsigned int i = 0; i < 2; i++ )
+    {
+        BOOST_CHECK_EQUAL( profiler->getAccelerationModelName( i ), accelerationModelNames[ i ] );
+        BOOST_CHECK_EQUAL( profiler->getNumberOfCalls( i ), numberOfEvaluations );
+        BOOST_CHECK_EQUAL( profiler->getUpdateTimeStatistics( i ).getNumberOfSamples( ),
+                           numberOfEvaluations );
+        BOOST_CHECK_EQUAL( profiler->getAccelerationTimeStatistics( i ).getNumberOfSamples( ),
+                           numberOfEvaluations );
+        BOOST_CHECK( profiler->getUpdateTimeStatistics( i ).getCumulativeTime( ) >= 0.0 );
+        BOOST_CHECK( profiler->getAccelerationTimeStatistics( i ).getMaximumTime( ) >= 0.0 );
+    }
+
+    // Check acceleration magnitude statistics.
+    BOOST_CHECK_EQUAL( profiler->getMinimumAccelerationMagnitude( 0 ),
+                       *std::min_element( firstAccelerationMagnitudes.begin( ),
+                                          firstAccelerationMagnitudes.end( ) ) );
+    BOOST_CHECK_EQUAL( profiler->getMaximumAccelerationMagnitude( 1 ),
+                       *std::max_element( secondAccelerationMagnitudes.begin( ),
+                                          secondAccelerationMagnitudes.end( ) ) );
+    double sumOfFirstAccelerationMagnitudes = 0.0;
+    for ( unsigned int i = 0; i < numberOfEvaluations; i++ )
+    {
+        sumOfFirstAccelerationMagnitudes += firstAccelerationMagnitudes[ i ];
+    }
+    BOOST_CHECK_CLOSE_FRACTION( profiler->getMeanAccelerationMagnitude( 0 ),
+                                sumOfFirstAccelerationMagnitudes / numberOfEvaluations,
+                                1.0e-14 );
+
+    // Check that report contains names of acceleration models.
+    std::ostringstream report;
+    profiler->printReport( report );
+    BOOST_CHECK( report.str( ).find( "First model" ) != std::string::npos );
+    BOOST_CHECK( report.str( ).find( "Second model" ) != std::string::npos );
+
+    // Check that reset removes all samples.
+    profiler->reset( );
+    BOOST_CHECK_EQUAL( profiler->getNumberOfCalls( 0 ), 0 );
+    BOOST_CHECK_EQUAL( profiler->getMeanAccelerationMagnitude( 1 ), 0.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
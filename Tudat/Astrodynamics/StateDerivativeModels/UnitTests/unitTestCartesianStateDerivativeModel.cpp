@@ -27,6 +27,10 @@
  *      120820    K. Kumar          Unit test created.
  *      120911    K. Kumar          Added unit test to demonstrate frame transformation
  *                                  functionality.
+ *      140212    S. Vermeer        Added unit test for concurrent evaluation of acceleration
+ *                                  models.
+ *      140401    S. Vermeer        Added check of concurrent evaluation by copied state derivative
+ *                                  model.
  *
  *    References
  *
@@ -55,6 +59,7 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testAccelerationModels.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testBody.h"
 #include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateDerivativeModel.h"
+#include "Tudat/Basics/parallelTaskPool.h"
 #include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 
 namespace tudat
@@ -348,6 +353,99 @@ BOOST_AUTO_TEST_CASE( test_CartesianStateDerivativeModel4D )
                                         5.0e-15 );
 }
 
+//! Test whether concurrent evaluation of acceleration models gives identical results.
+BOOST_AUTO_TEST_CASE( test_CartesianStateDerivativeModel6DWithParallelTaskPool )
+{
+    using basic_astrodynamics::AccelerationModel3dPointer;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+    using basics::ParallelTaskPool;
+    using basics::ParallelTaskPoolPointer;
+
+    // Shortcuts.
+    typedef TestBody< 3, double > TestBody3d;
+    typedef boost::shared_ptr< TestBody3d > TestBody3dPointer;
+    typedef DerivedAccelerationModel< > DerivedAccelerationModel3d;
+    typedef AnotherDerivedAccelerationModel< > AnotherDerivedAccelerationModel3d;
+
+    // Create body with zombie time and state.
+    TestBody3dPointer body = boost::make_shared< TestBody3d >( Eigen::VectorXd::Zero( 6 ), 0.0 );
+
+    // Create list of acceleration models, with frame transformations for every other model.
+    CartesianStateDerivativeModel6d::ListOfReferenceFrameTransformations listOfFrameTransformations
+            = list_of( &rotateOverArbitraryAngles )( &rotateOverOtherArbitraryAngles );
+    CartesianStateDerivativeModel6d::ListOfAccelerationFrameTransformationPairs
+            listOfAccelerationFrameTransformations;
+    for ( unsigned int i = 0; i < 5; i++ )
+    {
+        AccelerationModel3dPointer firstAccelerationModel3d
+                = boost::make_shared< DerivedAccelerationModel3d >(
+                    boost::bind( &TestBody3d::getCurrentPosition, body ),
+                    boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+        AccelerationModel3dPointer secondAccelerationModel3d
+                = boost::make_shared< AnotherDerivedAccelerationModel3d >(
+                    boost::bind( &TestBody3d::getCurrentPosition, body ),
+                    boost::bind( &TestBody3d::getCurrentVelocity, body ),
+                    boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+        listOfAccelerationFrameTransformations.push_back(
+                    std::make_pair( firstAccelerationModel3d, listOfFrameTransformations ) );
+        listOfAccelerationFrameTransformations.push_back(
+                    std::make_pair( secondAccelerationModel3d,
+                                    CartesianStateDerivativeModel6d::
+                                    ListOfReferenceFrameTransformations( ) ) );
+    }
+
+    // Declare serial and concurrent Cartesian state derivative models.
+    CartesianStateDerivativeModel6d serialStateDerivativeModel(
+                listOfAccelerationFrameTransformations,
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    CartesianStateDerivativeModel6d parallelStateDerivativeModel(
+                listOfAccelerationFrameTransformations,
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+    ParallelTaskPoolPointer taskPool = boost::make_shared< ParallelTaskPool >( 4 );
+    parallelStateDerivativeModel.setParallelTaskPool( taskPool );
+
+    // Compute Cartesian state derivatives at a number of times and states, and check that they
+    // are identical (bit-for-bit, since the accelerations are summed in the same order).
+    for ( unsigned int i = 0; i < 20; i++ )
+    {
+        const double currentTime = 1.3 + 0.7 * i;
+        const Vector6d currentState = ( Eigen::VectorXd( 6 )
+                                        << Eigen::Vector3d( -1.1, 2.2, -3.3 ) * currentTime,
+                                        Eigen::Vector3d( 0.23, 1.67, -0.11 ) ).finished( );
+
+        const Vector6d expectedCartesianStateDerivative
+                = serialStateDerivativeModel.computeStateDerivative( currentTime, currentState );
+        const Vector6d computedCartesianStateDerivative
+                = parallelStateDerivativeModel.computeStateDerivative( currentTime, currentState );
+
+        TUDAT_CHECK_MATRIX_BASE( computedCartesianStateDerivative,
+                                 expectedCartesianStateDerivative )
+                BOOST_CHECK_EQUAL( computedCartesianStateDerivative.coeff( row, col ),
+                                   expectedCartesianStateDerivative.coeff( row, col ) );
+    }
+
+    // Check that a copy of the concurrent state derivative model computes its own accelerations,
+    // rather than those of the model it was copied from, by evaluating it at a different time and
+    // state than the last evaluation of the original model.
+    CartesianStateDerivativeModel6d copiedStateDerivativeModel( parallelStateDerivativeModel );
+    const double copyTime = 31.4;
+    const Vector6d copyState = ( Eigen::VectorXd( 6 ) << 4.4, -5.5, 6.6, -0.7, 0.8, -0.9 )
+            .finished( );
+
+    const Vector6d expectedCartesianStateDerivative
+            = serialStateDerivativeModel.computeStateDerivative( copyTime, copyState );
+    const Vector6d computedCartesianStateDerivative
+            = copiedStateDerivativeModel.computeStateDerivative( copyTime, copyState );
+
+    TUDAT_CHECK_MATRIX_BASE( computedCartesianStateDerivative,
+                             expectedCartesianStateDerivative )
+            BOOST_CHECK_EQUAL( computedCartesianStateDerivative.coeff( row, col ),
+                               expectedCartesianStateDerivative.coeff( row, col ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -29,6 +29,10 @@
  *      120913    K. Kumar          Rewrote unit test to use test state derivative models;
  *                                  implemented matrix-based and vector-based composite state
  *                                  tests.
+ *      140217    S. Vermeer        Added test of repeated evaluation of dynamically sized
+ *                                  composite state derivative, written to given state derivative.
+ *      140415    S. Vermeer        Added test of part state derivative functions writing to given
+ *                                  part state derivatives, and of copied composite models.
  *
  *    References
  *
@@ -172,6 +176,181 @@ BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelWithVectors )
                                expectedCompositeStateDerivative.coeff( row, col ) );
 }
 
+//! Perform no update of dynamically sized composite state.
+/*!
+ * Performs no update; empty function body.
+ * \param independentVariable Independent variable (time).
+ * \param compositeState Composite state.
+ */
+void updateNothingVectorXd( const double independentVariable,
+                            const Eigen::VectorXd& compositeState )
+{ }
+
+//! Test whether composite state derivative model works correctly with dynamically sized vectors.
+BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelWithDynamicVectors )
+{
+    // Shortcuts.
+    typedef state_derivative_models::CompositeStateDerivativeModel<
+            double, Eigen::VectorXd, Eigen::VectorXd > CompositeStateDerivativeModel;
+
+    // Create state derivative model map ([Vector3d 0 Vector2d 0] composite state structure), in
+    // which the fourth and seventh elements of the composite state are not part of any part
+    // state, so that their state derivative should be zero.
+    CompositeStateDerivativeModel::VectorStateDerivativeModelMap stateDerivativeModelMap;
+    stateDerivativeModelMap[ std::make_pair( 4, 2 ) ] = &computeVector2dStateDerivative;
+    stateDerivativeModelMap[ std::make_pair( 0, 3 ) ] = &computeVector3dStateDerivative;
+
+    // Create composite state derivative model.
+    CompositeStateDerivativeModel compositeStateDerivativeModel(
+                stateDerivativeModelMap, &updateNothingVectorXd );
+
+    // Declare composite state derivative, with incorrect size.
+    Eigen::VectorXd computedCompositeStateDerivative = Eigen::VectorXd::Constant( 3, 1.0 );
+
+    // Evaluate composite state derivative repeatedly for different times and states.
+    for ( unsigned int i = 0; i < 5; i++ )
+    {
+        const double currentTime = 1.1 + 0.3 * i;
+        const Eigen::Vector3d currentVector3dState
+                = Eigen::Vector3d( 6.6, -1.13, 4.78 ) * ( 1.0 + i );
+        const Eigen::Vector2d currentVector2dState = Eigen::Vector2d( 1.3, -0.45 ) * ( 1.0 - i );
+
+        Eigen::VectorXd currentCompositeState( 7 );
+        currentCompositeState << currentVector3dState, 9.9, currentVector2dState, -9.9;
+
+        // Set expected composite state derivative.
+        Eigen::VectorXd expectedCompositeStateDerivative = Eigen::VectorXd::Zero( 7 );
+        expectedCompositeStateDerivative.segment( 0, 3 )
+                = computeVector3dStateDerivative( currentTime, currentVector3dState );
+        expectedCompositeStateDerivative.segment( 4, 2 )
+                = computeVector2dStateDerivative( currentTime, currentVector2dState );
+
+        // Compute composite state derivative, both returned by value and written to given
+        // state derivative.
+        const Eigen::VectorXd returnedCompositeStateDerivative
+                = compositeStateDerivativeModel.computeStateDerivative(
+                    currentTime, currentCompositeState );
+        compositeStateDerivativeModel.computeStateDerivative(
+                    currentTime, currentCompositeState, computedCompositeStateDerivative );
+
+        // Check that computed composite state derivatives match expected values.
+        BOOST_REQUIRE_EQUAL( computedCompositeStateDerivative.rows( ), 7 );
+        TUDAT_CHECK_MATRIX_BASE( computedCompositeStateDerivative,
+                                 expectedCompositeStateDerivative )
+                BOOST_CHECK_EQUAL( computedCompositeStateDerivative.coeff( row, col ),
+                                   expectedCompositeStateDerivative.coeff( row, col ) );
+        TUDAT_CHECK_MATRIX_BASE( returnedCompositeStateDerivative,
+                                 expectedCompositeStateDerivative )
+                BOOST_CHECK_EQUAL( returnedCompositeStateDerivative.coeff( row, col ),
+                                   expectedCompositeStateDerivative.coeff( row, col ) );
+    }
+}
+
+//! Compute Vector2d state derivative, writing to given state derivative.
+/*!
+ * Computes the state derivative of the Vector2d state using the test function
+ * computeVector2dStateDerivative(), and writes it to the given (dynamically sized) state
+ * derivative.
+ * \param independentVariable Independent variable (time).
+ * \param state Vector2d state.
+ * \param stateDerivative State derivative of the Vector2d state (returned by reference).
+ */
+void computeVector2dStateDerivativeInPlace( const double independentVariable,
+                                            const Eigen::VectorXd& state,
+                                            Eigen::VectorXd& stateDerivative )
+{
+    stateDerivative( 0 ) = state( 0 ) * state( 0 ) - independentVariable;
+    stateDerivative( 1 ) = std::sqrt( std::fabs( state( 1 ) ) )
+            - independentVariable * independentVariable;
+}
+
+//! Compute Vector3d state derivative, writing to given state derivative.
+/*!
+ * Computes the state derivative of the Vector3d state using the test function
+ * computeVector3dStateDerivative(), and writes it to the given (dynamically sized) state
+ * derivative.
+ * \param independentVariable Independent variable (time).
+ * \param state Vector3d state.
+ * \param stateDerivative State derivative of the Vector3d state (returned by reference).
+ */
+void computeVector3dStateDerivativeInPlace( const double independentVariable,
+                                            const Eigen::VectorXd& state,
+                                            Eigen::VectorXd& stateDerivative )
+{
+    stateDerivative( 0 ) = state( 0 ) * state( 1 );
+    stateDerivative( 1 ) = state( 2 ) /  independentVariable;
+    stateDerivative( 2 ) = state( 2 ) * state( 2 );
+}
+
+//! Test whether composite state derivative model works correctly with in-place part functions.
+BOOST_AUTO_TEST_CASE( test_CompositeStateDerivativeModelWithInPlacePartFunctions )
+{
+    // Shortcuts.
+    typedef state_derivative_models::CompositeStateDerivativeModel<
+            double, Eigen::VectorXd, Eigen::VectorXd > CompositeStateDerivativeModel;
+
+    // Create in-place state derivative model map ([Vector3d 0 Vector2d] composite state
+    // structure).
+    CompositeStateDerivativeModel::InPlaceVectorStateDerivativeModelMap stateDerivativeModelMap;
+    stateDerivativeModelMap[ std::make_pair( 0, 3 ) ] = &computeVector3dStateDerivativeInPlace;
+    stateDerivativeModelMap[ std::make_pair( 4, 2 ) ] = &computeVector2dStateDerivativeInPlace;
+
+    // Create composite state derivative model.
+    CompositeStateDerivativeModel compositeStateDerivativeModel(
+                stateDerivativeModelMap, &updateNothingVectorXd );
+
+    // Set states and expected composite state derivatives at two different times.
+    const double firstTime = 1.7;
+    const Eigen::Vector3d firstVector3dState( 6.6, -1.13, 4.78 );
+    const Eigen::Vector2d firstVector2dState( 1.3, -0.45 );
+    Eigen::VectorXd firstCompositeState( 6 );
+    firstCompositeState << firstVector3dState, 9.9, firstVector2dState;
+    Eigen::VectorXd firstExpectedCompositeStateDerivative = Eigen::VectorXd::Zero( 6 );
+    firstExpectedCompositeStateDerivative.segment( 0, 3 )
+            = computeVector3dStateDerivative( firstTime, firstVector3dState );
+    firstExpectedCompositeStateDerivative.segment( 4, 2 )
+            = computeVector2dStateDerivative( firstTime, firstVector2dState );
+
+    const double secondTime = 3.1;
+    const Eigen::Vector3d secondVector3dState( -2.2, 0.37, 1.05 );
+    const Eigen::Vector2d secondVector2dState( -0.8, 2.15 );
+    Eigen::VectorXd secondCompositeState( 6 );
+    secondCompositeState << secondVector3dState, -9.9, secondVector2dState;
+    Eigen::VectorXd secondExpectedCompositeStateDerivative = Eigen::VectorXd::Zero( 6 );
+    secondExpectedCompositeStateDerivative.segment( 0, 3 )
+            = computeVector3dStateDerivative( secondTime, secondVector3dState );
+    secondExpectedCompositeStateDerivative.segment( 4, 2 )
+            = computeVector2dStateDerivative( secondTime, secondVector2dState );
+
+    // Compute composite state derivatives using the model and a copy of it, evaluated at different
+    // times and states.
+    CompositeStateDerivativeModel copiedCompositeStateDerivativeModel(
+                compositeStateDerivativeModel );
+    const Eigen::VectorXd computedCompositeStateDerivative
+            = compositeStateDerivativeModel.computeStateDerivative(
+                firstTime, firstCompositeState );
+    const Eigen::VectorXd copiedCompositeStateDerivative
+            = copiedCompositeStateDerivativeModel.computeStateDerivative(
+                secondTime, secondCompositeState );
+    Eigen::VectorXd writtenCompositeStateDerivative;
+    compositeStateDerivativeModel.computeStateDerivative(
+                firstTime, firstCompositeState, writtenCompositeStateDerivative );
+
+    // Check that computed composite state derivatives match expected values.
+    TUDAT_CHECK_MATRIX_BASE( computedCompositeStateDerivative,
+                             firstExpectedCompositeStateDerivative )
+            BOOST_CHECK_EQUAL( computedCompositeStateDerivative.coeff( row, col ),
+                               firstExpectedCompositeStateDerivative.coeff( row, col ) );
+    TUDAT_CHECK_MATRIX_BASE( writtenCompositeStateDerivative,
+                             firstExpectedCompositeStateDerivative )
+            BOOST_CHECK_EQUAL( writtenCompositeStateDerivative.coeff( row, col ),
+                               firstExpectedCompositeStateDerivative.coeff( row, col ) );
+    TUDAT_CHECK_MATRIX_BASE( copiedCompositeStateDerivative,
+                             secondExpectedCompositeStateDerivative )
+            BOOST_CHECK_EQUAL( copiedCompositeStateDerivative.coeff( row, col ),
+                               secondExpectedCompositeStateDerivative.coeff( row, col ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,319 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140207    S. Vermeer        Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testAccelerationModels.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateDerivativeModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/environmentUpdateGraph.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using boost::assign::list_of;
+using basic_mathematics::Vector6d;
+using state_derivative_models::EnvironmentUpdateGraph6d;
+
+//! Counter of number of perturbing body position evaluations.
+static unsigned int numberOfPositionEvaluations = 0;
+
+//! Counter of number of relative position evaluations.
+static unsigned int numberOfRelativePositionEvaluations = 0;
+
+//! Compute position of perturbing body.
+/*!
+ * Computes an (arbitrary) position of a perturbing body as a function of time, emulating an
+ * ephemeris, and increments the associated evaluation counter.
+ * \param time Current time.
+ * \return Position of perturbing body.
+ */
+Eigen::Vector3d computePerturbingBodyPosition( const double time )
+{
+    numberOfPositionEvaluations++;
+    return Eigen::Vector3d( 1.0, -2.0, 0.5 ) * time;
+}
+
+//! Compute position of perturbing body w.r.t. current position.
+/*!
+ * Computes position of perturbing body w.r.t. the position in the current state, and increments
+ * the associated evaluation counter.
+ * \param state Current state.
+ * \param perturbingBodyPosition Function returning position of perturbing body.
+ * \return Relative position of perturbing body.
+ */
+Eigen::Vector3d computeRelativePosition(
+        const Vector6d& state, const boost::function< Eigen::Vector3d( ) > perturbingBodyPosition )
+{
+    numberOfRelativePositionEvaluations++;
+    return perturbingBodyPosition( ) - state.segment( 0, 3 );
+}
+
+//! Compute norm of vector.
+/*!
+ * Computes norm of vector returned by given function.
+ * \param vectorFunction Function returning vector.
+ * \return Norm of vector.
+ */
+double computeNorm( const boost::function< Eigen::Vector3d( ) > vectorFunction )
+{
+    return vectorFunction( ).norm( );
+}
+
+BOOST_AUTO_TEST_SUITE( test_environment_update_graph )
+
+//! Test whether environment variables are updated once, in dependency order.
+BOOST_AUTO_TEST_CASE( testEnvironmentUpdateGraphUpdateOrderAndCaching )
+{
+    numberOfPositionEvaluations = 0;
+    numberOfRelativePositionEvaluations = 0;
+
+    EnvironmentUpdateGraph6d environmentUpdateGraph;
+
+    // Add variables in reverse dependency order (names are also in reverse alphabetical order).
+    const boost::function< double( ) > distance
+            = environmentUpdateGraph.addStateDependentVariable< double >(
+                "a_distance",
+                boost::bind( &computeNorm,
+                             environmentUpdateGraph.getVariableFunction< Eigen::Vector3d >(
+                                 "b_relative_position" ) ),
+                list_of( "b_relative_position" ) );
+    const boost::function< Eigen::Vector3d( ) > relativePosition
+            = environmentUpdateGraph.addStateDependentVariable< Eigen::Vector3d >(
+                "b_relative_position",
+                boost::bind( &computeRelativePosition, _2,
+                             environmentUpdateGraph.getVariableFunction< Eigen::Vector3d >(
+                                 "c_body_position" ) ),
+                list_of( "c_body_position" ) );
+    const boost::function< Eigen::Vector3d( ) > bodyPosition
+            = environmentUpdateGraph.addTimeDependentVariable< Eigen::Vector3d >(
+                "c_body_position", &computePerturbingBodyPosition );
+
+    BOOST_CHECK_EQUAL( environmentUpdateGraph.getNumberOfVariables( ), 3 );
+
+    // Check update order.
+    const std::vector< std::string > expectedUpdateOrder
+            = list_of( "c_body_position" )( "b_relative_position" )( "a_distance" );
+    const std::vector< std::string > updateOrder = environmentUpdateGraph.getUpdateOrder( );
+    BOOST_CHECK_EQUAL_COLLECTIONS( updateOrder.begin( ), updateOrder.end( ),
+                                   expectedUpdateOrder.begin( ), expectedUpdateOrder.end( ) );
+
+    // Update environment and check computed variables.
+    Vector6d state;
+    state << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+    environmentUpdateGraph.updateEnvironment( 2.0, state );
+
+    const Eigen::Vector3d expectedRelativePosition = Eigen::Vector3d( 1.0, -6.0, -2.0 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( bodyPosition( ), Eigen::Vector3d( 2.0, -4.0, 1.0 ),
+                                       1.0e-15 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( relativePosition( ), expectedRelativePosition, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( distance( ), expectedRelativePosition.norm( ), 1.0e-15 );
+
+    // Check that reading the variables (any number of times) does not re-evaluate them.
+    for ( unsigned int i = 0; i < 5; i++ )
+    {
+        bodyPosition( );
+        relativePosition( );
+    }
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 1 );
+    BOOST_CHECK_EQUAL( numberOfRelativePositionEvaluations, 1 );
+
+    // Check that nothing is re-evaluated for same time and state.
+    environmentUpdateGraph.updateEnvironment( 2.0, state );
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 1 );
+    BOOST_CHECK_EQUAL( numberOfRelativePositionEvaluations, 1 );
+
+    // Check that only state-dependent variables are re-evaluated for same time and new state.
+    state( 0 ) = 0.0;
+    environmentUpdateGraph.updateEnvironment( 2.0, state );
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 1 );
+    BOOST_CHECK_EQUAL( numberOfRelativePositionEvaluations, 2 );
+    BOOST_CHECK_CLOSE_FRACTION( distance( ), Eigen::Vector3d( 2.0, -6.0, -2.0 ).norm( ),
+                                1.0e-15 );
+
+    // Check that all variables are re-evaluated for new time.
+    environmentUpdateGraph.updateEnvironment( 3.0, state );
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 2 );
+    BOOST_CHECK_EQUAL( numberOfRelativePositionEvaluations, 3 );
+
+    // Check that all variables are re-evaluated after resetting cache.
+    environmentUpdateGraph.resetCache( );
+    environmentUpdateGraph.updateEnvironment( 3.0, state );
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 3 );
+    BOOST_CHECK_EQUAL( numberOfRelativePositionEvaluations, 4 );
+}
+
+//! Test whether inconsistent environment update graphs are detected.
+BOOST_AUTO_TEST_CASE( testEnvironmentUpdateGraphErrorHandling )
+{
+    // Check that circular dependencies are detected.
+    {
+        EnvironmentUpdateGraph6d environmentUpdateGraph;
+        environmentUpdateGraph.addStateDependentVariable< double >(
+                    "first", boost::bind( &computeNorm,
+                                          environmentUpdateGraph.getVariableFunction<
+                                          Eigen::Vector3d >( "second" ) ),
+                    list_of( "second" ) );
+        environmentUpdateGraph.addStateDependentVariable< Eigen::Vector3d >(
+                    "second", boost::bind( &computeRelativePosition, _2,
+                                           environmentUpdateGraph.getVariableFunction<
+                                           Eigen::Vector3d >( "third" ) ),
+                    list_of( "third" ) );
+        environmentUpdateGraph.addTimeDependentVariable< Eigen::Vector3d >(
+                    "third", &computePerturbingBodyPosition, list_of( "first" ) );
+
+        BOOST_CHECK_THROW( environmentUpdateGraph.updateEnvironment( 0.0, Vector6d::Zero( ) ),
+                           std::runtime_error );
+    }
+
+    // Check that undefined dependencies are detected.
+    {
+        EnvironmentUpdateGraph6d environmentUpdateGraph;
+        environmentUpdateGraph.addStateDependentVariable< double >(
+                    "first", boost::bind( &computeNorm,
+                                          environmentUpdateGraph.getVariableFunction<
+                                          Eigen::Vector3d >( "second" ) ),
+                    list_of( "second" ) );
+
+        BOOST_CHECK_THROW( environmentUpdateGraph.updateEnvironment( 0.0, Vector6d::Zero( ) ),
+                           std::runtime_error );
+    }
+
+    // Check that duplicate variables and type mismatches are detected.
+    {
+        EnvironmentUpdateGraph6d environmentUpdateGraph;
+        environmentUpdateGraph.addTimeDependentVariable< Eigen::Vector3d >(
+                    "first", &computePerturbingBodyPosition );
+
+        BOOST_CHECK_THROW( environmentUpdateGraph.addTimeDependentVariable< Eigen::Vector3d >(
+                               "first", &computePerturbingBodyPosition ),
+                           std::runtime_error );
+        BOOST_CHECK_THROW( environmentUpdateGraph.getVariableFunction< double >( "first" ),
+                           std::runtime_error );
+    }
+}
+
+//! Test whether environment update graph works with Cartesian state derivative model.
+BOOST_AUTO_TEST_CASE( testEnvironmentUpdateGraphWithCartesianStateDerivativeModel )
+{
+    using basic_astrodynamics::AccelerationModel3dPointer;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+
+    typedef DerivedAccelerationModel< > DerivedAccelerationModel3d;
+
+    numberOfPositionEvaluations = 0;
+    numberOfRelativePositionEvaluations = 0;
+
+    // Set current time and state.
+    const double currentTime = 5.6;
+    const Vector6d currentState = ( Eigen::VectorXd( 6 )
+                                    << Eigen::Vector3d( -1.1, 2.2, -3.3 ),
+                                    Eigen::Vector3d( 0.23, 1.67, -0.11 ) ).finished( );
+
+    // Create environment, in which the perturbing body position is shared by all accelerations.
+    EnvironmentUpdateGraph6d environmentUpdateGraph;
+    environmentUpdateGraph.addTimeDependentVariable< Eigen::Vector3d >(
+                "perturbing_body_position", &computePerturbingBodyPosition );
+    const boost::function< Eigen::Vector3d( ) > relativePosition
+            = environmentUpdateGraph.addStateDependentVariable< Eigen::Vector3d >(
+                "relative_position",
+                boost::bind( &computeRelativePosition, _2,
+                             environmentUpdateGraph.getVariableFunction< Eigen::Vector3d >(
+                                 "perturbing_body_position" ) ),
+                list_of( "perturbing_body_position" ) );
+    const boost::function< double( ) > time
+            = environmentUpdateGraph.addTimeDependentVariable< double >(
+                "time", boost::lambda::_1 );
+
+    // Create a number of acceleration models using the same environment variables.
+    const unsigned int numberOfAccelerationModels = 8;
+    CartesianStateDerivativeModel6d::AccelerationModelPointerVector listOfAccelerations;
+    for ( unsigned int i = 0; i < numberOfAccelerationModels; i++ )
+    {
+        listOfAccelerations.push_back( boost::make_shared< DerivedAccelerationModel3d >(
+                                           relativePosition, time ) );
+    }
+
+    // Create state derivative model, with environment update as update function.
+    CartesianStateDerivativeModel6d stateDerivativeModel(
+                listOfAccelerations,
+                boost::bind( &EnvironmentUpdateGraph6d::updateEnvironment,
+                             &environmentUpdateGraph, _1, _2 ) );
+
+    // Set expected state derivative.
+    const Eigen::Vector3d expectedRelativePosition
+            = Eigen::Vector3d( 1.0, -2.0, 0.5 ) * currentTime - currentState.segment( 0, 3 );
+    const Vector6d expectedStateDerivative
+            = ( Eigen::VectorXd( 6 ) << currentState.segment( 3, 3 ),
+                numberOfAccelerationModels * expectedRelativePosition
+                / ( currentTime * currentTime ) ).finished( );
+
+    // Compute state derivative twice, as done by e.g. Runge-Kutta-Fehlberg integrators that
+    // evaluate different stages at the same time.
+    Vector6d computedStateDerivative
+            = stateDerivativeModel.computeStateDerivative( currentTime, currentState );
+    computedStateDerivative
+            = stateDerivativeModel.computeStateDerivative( currentTime, currentState );
+
+    // Check computed state derivative.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedStateDerivative, expectedStateDerivative,
+                                       1.0e-14 );
+
+    // Check that each environment variable was evaluated only once for all acceleration models.
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 1 );
+    BOOST_CHECK_EQUAL( numberOfRelativePositionEvaluations, 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
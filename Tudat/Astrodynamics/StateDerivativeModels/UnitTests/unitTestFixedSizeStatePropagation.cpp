@@ -0,0 +1,332 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140228    S. Vermeer        Unit test created.
+ *      140401    S. Vermeer        Heap allocations are counted by replacing malloc, calloc and
+ *                                  realloc if glibc is used, instead of operator new and delete.
+ *
+ *    References
+ *
+ *    Notes
+ *      This unit test verifies that propagation of fixed-size states does not allocate any memory
+ *      on the heap after the first integration step. With glibc, heap allocations are counted by
+ *      replacing malloc, calloc and realloc in this test executable with functions that count the
+ *      calls and forward to the glibc implementations, which also covers the global operator new
+ *      (as in the benchmark tools). With other C libraries, the global operator new is replaced
+ *      instead, and allocations by Eigen (which uses malloc directly) are counted by forbidding
+ *      them through EIGEN_RUNTIME_NO_MALLOC, and redefining the Eigen assertion macro such that a
+ *      failed assertion (i.e., a forbidden allocation) is counted instead of aborting the program.
+ *      This also makes the test independent of NDEBUG.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Register failed Eigen assertion (defined below).
+void registerFailedEigenAssertion( );
+
+} // namespace unit_tests
+} // namespace tudat
+
+// Count memory allocations by Eigen (see Notes).
+#define EIGEN_RUNTIME_NO_MALLOC
+#define eigen_assert( condition ) \
+    ( ( condition ) ? static_cast< void >( 0 ) \
+                    : tudat::unit_tests::registerFailedEigenAssertion( ) )
+
+#include <cmath>
+#include <limits>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testBody.h"
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateDerivativeModel.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace
+{
+
+//! Number of heap allocations.
+std::size_t numberOfHeapAllocations = 0;
+
+//! Number of forbidden allocations by Eigen.
+std::size_t numberOfEigenAllocations = 0;
+
+} // namespace
+
+// Replace the global allocation functions to count heap allocations (see Notes).
+#if defined( __GLIBC__ )
+
+extern "C"
+{
+
+void* __libc_malloc( std::size_t size );
+void* __libc_calloc( std::size_t numberOfElements, std::size_t elementSize );
+void* __libc_realloc( void* memory, std::size_t size );
+
+void* malloc( std::size_t size ) __THROW
+{
+    numberOfHeapAllocations++;
+    return __libc_malloc( size );
+}
+
+void* calloc( std::size_t numberOfElements, std::size_t elementSize ) __THROW
+{
+    numberOfHeapAllocations++;
+    return __libc_calloc( numberOfElements, elementSize );
+}
+
+void* realloc( void* memory, std::size_t size ) __THROW
+{
+    numberOfHeapAllocations++;
+    return __libc_realloc( memory, size );
+}
+
+} // extern "C"
+
+#else
+
+void* operator new( std::size_t size )
+{
+    numberOfHeapAllocations++;
+    void* memory = std::malloc( size == 0 ? 1 : size );
+    if ( memory == 0 )
+    {
+        throw std::bad_alloc( );
+    }
+    return memory;
+}
+
+void operator delete( void* memory ) throw( )
+{
+    std::free( memory );
+}
+
+#endif
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Register failed Eigen assertion.
+void registerFailedEigenAssertion( )
+{
+    numberOfEigenAllocations++;
+}
+
+using basic_mathematics::Vector6d;
+
+//! Typedef for variable step size Runge-Kutta integrator with fixed-size state.
+typedef numerical_integrators::RungeKuttaVariableStepSizeIntegrator< double, Vector6d >
+RungeKuttaVariableStepSizeIntegrator6d;
+
+//! Start counting heap allocations.
+void startCountingAllocations( )
+{
+    numberOfHeapAllocations = 0;
+    numberOfEigenAllocations = 0;
+
+    // Forbid allocations by Eigen, such that these are counted, if malloc is not replaced.
+#if !defined( __GLIBC__ )
+    Eigen::internal::set_is_malloc_allowed( false );
+#endif
+}
+
+//! Stop counting heap allocations, and return number of allocations since start.
+std::size_t stopCountingAllocations( )
+{
+    Eigen::internal::set_is_malloc_allowed( true );
+    return numberOfHeapAllocations + numberOfEigenAllocations;
+}
+
+//! Compute specific orbital energy of Cartesian state.
+double computeSpecificOrbitalEnergy( const Vector6d& cartesianState,
+                                     const double gravitationalParameter )
+{
+    return 0.5 * cartesianState.segment( 3, 3 ).squaredNorm( )
+            - gravitationalParameter / cartesianState.segment( 0, 3 ).norm( );
+}
+
+//! Compute specific angular momentum of Cartesian state.
+Eigen::Vector3d computeSpecificAngularMomentum( const Vector6d& cartesianState )
+{
+    return Eigen::Vector3d( cartesianState.segment( 0, 3 ) ).cross(
+                Eigen::Vector3d( cartesianState.segment( 3, 3 ) ) );
+}
+
+//! Compute state derivative of dynamic-size state using fixed-size state derivative model.
+Eigen::VectorXd computeDynamicSizeStateDerivative(
+        state_derivative_models::CartesianStateDerivativeModel6d& stateDerivativeModel,
+        const double time, const Eigen::VectorXd& state )
+{
+    return stateDerivativeModel.computeStateDerivative( time, Vector6d( state ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_fixed_size_state_propagation )
+
+//! Test whether heap allocations are detected by instrumentation of this unit test.
+BOOST_AUTO_TEST_CASE( testAllocationCounting )
+{
+    // Check that allocation through operator new is counted.
+    startCountingAllocations( );
+    boost::shared_ptr< double > dynamicDouble = boost::make_shared< double >( 1.0 );
+    BOOST_CHECK_EQUAL( stopCountingAllocations( ), 1 );
+
+    // Check that allocation by Eigen is counted.
+    startCountingAllocations( );
+    Eigen::VectorXd dynamicSizeVector = Eigen::VectorXd::Ones( 6 );
+    BOOST_CHECK_EQUAL( stopCountingAllocations( ), 1 );
+
+    // Check that fixed-size state does not allocate.
+    startCountingAllocations( );
+    Vector6d fixedSizeVector = dynamicSizeVector;
+    BOOST_CHECK_EQUAL( stopCountingAllocations( ), 0 );
+
+    BOOST_CHECK_EQUAL( fixedSizeVector.sum( ), 6.0 );
+}
+
+//! Test whether fixed-size state propagation does not allocate memory per integration step.
+BOOST_AUTO_TEST_CASE( testZeroAllocationsPerStepWithCartesianStateDerivativeModel )
+{
+    using gravitation::CentralGravitationalAccelerationModel3d;
+    using numerical_integrators::RungeKuttaCoefficients;
+    using numerical_integrators::RungeKuttaVariableStepSizeIntegratorXd;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+
+    // Shortcuts.
+    typedef TestBody< 3, double > TestBody3d;
+    typedef boost::shared_ptr< TestBody3d > TestBody3dPointer;
+
+    // Set gravitational parameter of Earth [m^3 s^-2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set initial state of eccentric orbit around Earth [m, m/s].
+    Vector6d initialState;
+    initialState << 7000.0e3, 0.0, 0.0, 0.0, 8.0e3, 1.5e3;
+
+    // Set number of integration steps to check.
+    const unsigned int numberOfSteps = 1000;
+
+    // Test both a lower and a higher order integrator.
+    const RungeKuttaCoefficients::CoefficientSets coefficientSets[ 2 ] =
+    { RungeKuttaCoefficients::rungeKuttaFehlberg45,
+      RungeKuttaCoefficients::rungeKuttaFehlberg78 };
+
+    for ( unsigned int i = 0; i < 2; i++ )
+    {
+        // Create body with zombie time and state, and central gravity acceleration model.
+        TestBody3dPointer body = boost::make_shared< TestBody3d >( initialState, 0.0 );
+        CartesianStateDerivativeModel6d::AccelerationModelPointerVector listOfAccelerations(
+                    1, boost::make_shared< CentralGravitationalAccelerationModel3d >(
+                        boost::bind( &TestBody3d::getCurrentPosition, body ),
+                        earthGravitationalParameter ) );
+
+        // Declare Cartesian state derivative model.
+        CartesianStateDerivativeModel6d stateDerivativeModel(
+                    listOfAccelerations,
+                    boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+        // Declare integrators of fixed-size and dynamic-size state, using the same state
+        // derivative model.
+        RungeKuttaVariableStepSizeIntegrator6d integrator(
+                    RungeKuttaCoefficients::get( coefficientSets[ i ] ),
+                    boost::bind( &CartesianStateDerivativeModel6d::computeStateDerivative,
+                                 &stateDerivativeModel, _1, _2 ),
+                    0.0, initialState, 1.0e-3, 1.0e4, 1.0e-12, 1.0e-12 );
+
+        RungeKuttaVariableStepSizeIntegratorXd dynamicSizeIntegrator(
+                    RungeKuttaCoefficients::get( coefficientSets[ i ] ),
+                    boost::bind( &computeDynamicSizeStateDerivative,
+                                 boost::ref( stateDerivativeModel ), _1, _2 ),
+                    0.0, Eigen::VectorXd( initialState ), 1.0e-3, 1.0e4, 1.0e-12, 1.0e-12 );
+
+        // Perform first step, which is allowed to allocate memory.
+        integrator.performIntegrationStep( 10.0 );
+        dynamicSizeIntegrator.performIntegrationStep( 10.0 );
+
+        // Perform integration steps of fixed-size state, and count heap allocations.
+        startCountingAllocations( );
+        for ( unsigned int j = 0; j < numberOfSteps; j++ )
+        {
+            integrator.performIntegrationStep( integrator.getNextStepSize( ) );
+        }
+        const std::size_t numberOfAllocations = stopCountingAllocations( );
+
+        // Check that no memory was allocated.
+        BOOST_CHECK_EQUAL( numberOfAllocations, 0 );
+
+        // Perform same integration steps of dynamic-size state, and check that result is
+        // identical.
+        for ( unsigned int j = 0; j < numberOfSteps; j++ )
+        {
+            dynamicSizeIntegrator.performIntegrationStep(
+                        dynamicSizeIntegrator.getNextStepSize( ) );
+        }
+
+        const Vector6d finalState = integrator.getCurrentState( );
+        BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ),
+                           dynamicSizeIntegrator.getCurrentIndependentVariable( ) );
+        for ( int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( finalState( j ),
+                                        dynamicSizeIntegrator.getCurrentState( )( j ),
+                                        std::numeric_limits< double >::epsilon( ) );
+        }
+
+        // Check that energy and angular momentum are conserved.
+        BOOST_CHECK_CLOSE_FRACTION(
+                    computeSpecificOrbitalEnergy( finalState, earthGravitationalParameter ),
+                    computeSpecificOrbitalEnergy( initialState, earthGravitationalParameter ),
+                    1.0e-9 );
+        BOOST_CHECK_SMALL( ( computeSpecificAngularMomentum( finalState )
+                             - computeSpecificAngularMomentum( initialState ) ).norm( )
+                           / computeSpecificAngularMomentum( initialState ).norm( ), 1.0e-9 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
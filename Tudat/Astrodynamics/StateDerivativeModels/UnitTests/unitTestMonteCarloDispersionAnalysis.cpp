@@ -0,0 +1,423 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140303    S. Vermeer        Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/utilityMacros.h>
+
+#include "Tudat/Astrodynamics/Aerodynamics/exponentialAtmosphere.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/monteCarloDispersionAnalysis.h"
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using basic_mathematics::Matrix6d;
+using basic_mathematics::Vector6d;
+using state_derivative_models::DispersedInputs;
+using state_derivative_models::DispersedInputsList;
+using state_derivative_models::DispersedPropagationModel;
+using state_derivative_models::DispersedPropagationModelPointer;
+using state_derivative_models::DispersionPropagationSettings;
+using state_derivative_models::DispersionSampleResult;
+using state_derivative_models::MonteCarloDispersionAnalysis;
+using basics::ParallelTaskPool;
+
+//! Propagation model of satellite in low Earth orbit, subject to drag and radiation pressure.
+/*!
+ * Propagation model of a satellite in low Earth orbit, subject to central gravity, aerodynamic
+ * drag in an (owned) exponential atmosphere, and radiation pressure from a source in a fixed
+ * direction. The number of created models is counted.
+ */
+class DragAndRadiationPressurePropagationModel : public DispersedPropagationModel
+{
+public:
+
+    //! Constructor.
+    DragAndRadiationPressurePropagationModel( )
+        : dragArea( 0.0 ),
+          radiationPressureCoefficient( 0.0 ),
+          atmosphericDensityScalingFactor( 1.0 )
+    {
+        atmosphere.setPredefinedExponentialAtmosphere(
+                    aerodynamics::ExponentialAtmosphere::earth );
+        numberOfCreatedModels++;
+    }
+
+    //! Set dispersed inputs; negative areas are rejected.
+    void setDispersedInputs( const DispersedInputs& dispersedInputs )
+    {
+        if ( dispersedInputs.dragArea < 0.0 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Drag area is negative." ) ) );
+        }
+
+        dragArea = dispersedInputs.dragArea;
+        radiationPressureCoefficient = dispersedInputs.radiationPressureCoefficient;
+        atmosphericDensityScalingFactor = dispersedInputs.atmosphericDensityScalingFactor;
+    }
+
+    //! Compute state derivative.
+    Vector6d computeStateDerivative( const double time, const Vector6d& cartesianState )
+    {
+        TUDAT_UNUSED_PARAMETER( time );
+
+        const Eigen::Vector3d position = cartesianState.segment( 0, 3 );
+        const Eigen::Vector3d velocity = cartesianState.segment( 3, 3 );
+
+        // Compute atmospheric density at current altitude.
+        const double density = atmosphericDensityScalingFactor
+                * atmosphere.getDensity( position.norm( ) - earthEquatorialRadius );
+
+        Vector6d stateDerivative;
+        stateDerivative << velocity,
+                gravitation::computeGravitationalAcceleration(
+                    position, earthGravitationalParameter, Eigen::Vector3d::Zero( ) )
+                - 0.5 * density * dragCoefficient * dragArea / satelliteMass
+                * velocity.norm( ) * velocity
+                + electro_magnetism::computeCannonBallRadiationPressureAcceleration(
+                    radiationPressure, Eigen::Vector3d::UnitX( ), dragArea,
+                    radiationPressureCoefficient, satelliteMass );
+        return stateDerivative;
+    }
+
+    //! Number of created models.
+    static unsigned int numberOfCreatedModels;
+
+    //! Gravitational parameter of Earth [m^3 s^-2].
+    static const double earthGravitationalParameter;
+
+    //! Equatorial radius of Earth [m].
+    static const double earthEquatorialRadius;
+
+private:
+
+    //! Drag coefficient [-].
+    static const double dragCoefficient;
+
+    //! Satellite mass [kg].
+    static const double satelliteMass;
+
+    //! Radiation pressure at 1 AU [N/m^2].
+    static const double radiationPressure;
+
+    //! Exponential atmosphere, owned by this model.
+    aerodynamics::ExponentialAtmosphere atmosphere;
+
+    //! Current drag area [m^2].
+    double dragArea;
+
+    //! Current radiation pressure coefficient [-].
+    double radiationPressureCoefficient;
+
+    //! Current atmospheric density scaling factor [-].
+    double atmosphericDensityScalingFactor;
+};
+
+unsigned int DragAndRadiationPressurePropagationModel::numberOfCreatedModels = 0;
+const double DragAndRadiationPressurePropagationModel::earthGravitationalParameter = 3.986004418e14;
+const double DragAndRadiationPressurePropagationModel::earthEquatorialRadius = 6378.1363e3;
+const double DragAndRadiationPressurePropagationModel::dragCoefficient = 2.2;
+const double DragAndRadiationPressurePropagationModel::satelliteMass = 100.0;
+const double DragAndRadiationPressurePropagationModel::radiationPressure = 4.56e-6;
+
+//! Create propagation model (used as factory function).
+DispersedPropagationModelPointer createPropagationModel( )
+{
+    return boost::make_shared< DragAndRadiationPressurePropagationModel >( );
+}
+
+//! Get nominal inputs of satellite in circular orbit at 250 km altitude.
+DispersedInputs getNominalInputs( )
+{
+    const double semiMajorAxis = DragAndRadiationPressurePropagationModel::earthEquatorialRadius
+            + 250.0e3;
+    const double circularVelocity = std::sqrt(
+                DragAndRadiationPressurePropagationModel::earthGravitationalParameter
+                / semiMajorAxis );
+
+    Vector6d initialState;
+    initialState << semiMajorAxis, 0.0, 0.0,
+            0.0, circularVelocity * std::cos( 0.9 ), circularVelocity * std::sin( 0.9 );
+
+    return DispersedInputs( initialState, 2.0, 1.3, 1.0 );
+}
+
+//! Get standard deviations of dispersed inputs.
+DispersedInputs getStandardDeviations( )
+{
+    Vector6d initialStateStandardDeviations;
+    initialStateStandardDeviations << 100.0, 100.0, 100.0, 0.1, 0.1, 0.1;
+
+    return DispersedInputs( initialStateStandardDeviations, 0.2, 0.1, 0.3 );
+}
+
+//! Get propagation settings for (approximately) half an orbit.
+DispersionPropagationSettings getPropagationSettings( )
+{
+    return DispersionPropagationSettings( 0.0, 2700.0, 10.0, 1.0e-3, 300.0, 1.0e-10, 1.0e-10 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_monte_carlo_dispersion_analysis )
+
+//! Test whether normally distributed dispersed inputs are generated correctly.
+BOOST_AUTO_TEST_CASE( testGenerateNormallyDispersedInputs )
+{
+    using state_derivative_models::generateNormallyDispersedInputs;
+
+    const DispersedInputs nominalInputs = getNominalInputs( );
+    const DispersedInputs standardDeviations = getStandardDeviations( );
+
+    // Check that generated inputs depend only on seed.
+    const DispersedInputsList firstInputsList = generateNormallyDispersedInputs(
+                nominalInputs, standardDeviations, 10, 42 );
+    const DispersedInputsList secondInputsList = generateNormallyDispersedInputs(
+                nominalInputs, standardDeviations, 10, 42 );
+    const DispersedInputsList thirdInputsList = generateNormallyDispersedInputs(
+                nominalInputs, standardDeviations, 10, 43 );
+
+    BOOST_CHECK_EQUAL( firstInputsList.size( ), 10 );
+    for ( unsigned int i = 0; i < firstInputsList.size( ); i++ )
+    {
+        BOOST_CHECK( firstInputsList[ i ].initialState == secondInputsList[ i ].initialState );
+        BOOST_CHECK_EQUAL( firstInputsList[ i ].dragArea, secondInputsList[ i ].dragArea );
+        BOOST_CHECK( firstInputsList[ i ].dragArea != thirdInputsList[ i ].dragArea );
+    }
+
+    // Check that zero standard deviations result in nominal inputs.
+    const DispersedInputsList nominalInputsList = generateNormallyDispersedInputs(
+                nominalInputs, DispersedInputs( Vector6d::Zero( ), 0.0, 0.0, 0.0 ), 3, 42 );
+    for ( unsigned int i = 0; i < nominalInputsList.size( ); i++ )
+    {
+        BOOST_CHECK( nominalInputsList[ i ].initialState == nominalInputs.initialState );
+        BOOST_CHECK_EQUAL( nominalInputsList[ i ].radiationPressureCoefficient,
+                           nominalInputs.radiationPressureCoefficient );
+        BOOST_CHECK_EQUAL( nominalInputsList[ i ].atmosphericDensityScalingFactor,
+                           nominalInputs.atmosphericDensityScalingFactor );
+    }
+
+    // Check sample mean and standard deviation of large number of samples (within five standard
+    // deviations of the estimators).
+    const unsigned int numberOfSamples = 10000;
+    const DispersedInputsList largeInputsList = generateNormallyDispersedInputs(
+                nominalInputs, standardDeviations, numberOfSamples, 1 );
+
+    double sumOfScalingFactors = 0.0, sumOfSquaredScalingFactorDeviations = 0.0;
+    for ( unsigned int i = 0; i < numberOfSamples; i++ )
+    {
+        sumOfScalingFactors += largeInputsList[ i ].atmosphericDensityScalingFactor;
+        sumOfSquaredScalingFactorDeviations += std::pow(
+                    largeInputsList[ i ].atmosphericDensityScalingFactor
+                    - nominalInputs.atmosphericDensityScalingFactor, 2.0 );
+    }
+
+    BOOST_CHECK_SMALL( sumOfScalingFactors / numberOfSamples
+                       - nominalInputs.atmosphericDensityScalingFactor,
+                       5.0 * standardDeviations.atmosphericDensityScalingFactor
+                       / std::sqrt( static_cast< double >( numberOfSamples ) ) );
+    BOOST_CHECK_CLOSE_FRACTION( std::sqrt( sumOfSquaredScalingFactorDeviations / numberOfSamples ),
+                                standardDeviations.atmosphericDensityScalingFactor,
+                                5.0 / std::sqrt( 2.0 * numberOfSamples ) );
+}
+
+//! Test whether Monte Carlo dispersion analysis results are independent of number of threads.
+BOOST_AUTO_TEST_CASE( testMonteCarloDispersionAnalysisConcurrency )
+{
+    const DispersedInputsList dispersedInputsList
+            = state_derivative_models::generateNormallyDispersedInputs(
+                getNominalInputs( ), getStandardDeviations( ), 24, 7 );
+
+    // Perform analysis serially.
+    DragAndRadiationPressurePropagationModel::numberOfCreatedModels = 0;
+    MonteCarloDispersionAnalysis serialAnalysis( &createPropagationModel,
+                                                 getPropagationSettings( ) );
+    std::ostringstream serialOutputStream;
+    serialAnalysis.performAnalysis( dispersedInputsList, &serialOutputStream );
+
+    BOOST_CHECK_EQUAL( serialAnalysis.getNumberOfWorkers( ), 1 );
+    BOOST_CHECK_EQUAL( DragAndRadiationPressurePropagationModel::numberOfCreatedModels, 1 );
+
+    // Perform analysis concurrently, twice, and check that models are only created once.
+    MonteCarloDispersionAnalysis concurrentAnalysis(
+                &createPropagationModel, getPropagationSettings( ),
+                boost::make_shared< ParallelTaskPool >( 4 ) );
+    std::ostringstream firstConcurrentOutputStream, secondConcurrentOutputStream;
+    concurrentAnalysis.performAnalysis( dispersedInputsList, &firstConcurrentOutputStream );
+    concurrentAnalysis.performAnalysis( dispersedInputsList, &secondConcurrentOutputStream );
+
+    BOOST_CHECK_EQUAL( concurrentAnalysis.getNumberOfWorkers( ), 4 );
+    BOOST_CHECK_EQUAL( DragAndRadiationPressurePropagationModel::numberOfCreatedModels, 5 );
+
+    // Check that output and statistics are identical.
+    BOOST_CHECK_EQUAL( serialOutputStream.str( ), firstConcurrentOutputStream.str( ) );
+    BOOST_CHECK_EQUAL( serialOutputStream.str( ), secondConcurrentOutputStream.str( ) );
+    BOOST_CHECK_EQUAL( concurrentAnalysis.getNumberOfSamples( ), 24 );
+    BOOST_CHECK_EQUAL( concurrentAnalysis.getNumberOfFailedSamples( ), 0 );
+    BOOST_CHECK( serialAnalysis.getMeanFinalState( ) == concurrentAnalysis.getMeanFinalState( ) );
+    BOOST_CHECK( serialAnalysis.getFinalStateCovariance( )
+                 == concurrentAnalysis.getFinalStateCovariance( ) );
+
+    // Check that output contains one line per sample, in order of sample index.
+    std::istringstream outputLines( serialOutputStream.str( ) );
+    std::string outputLine;
+    unsigned int numberOfLines = 0;
+    while ( std::getline( outputLines, outputLine ) )
+    {
+        std::istringstream outputLineStream( outputLine );
+        unsigned int sampleIndex;
+        bool isPropagationSuccessful;
+        double finalTime;
+        outputLineStream >> sampleIndex >> isPropagationSuccessful >> finalTime;
+        BOOST_CHECK_EQUAL( sampleIndex, numberOfLines );
+        BOOST_CHECK( isPropagationSuccessful );
+        BOOST_CHECK_EQUAL( finalTime, getPropagationSettings( ).finalTime );
+        numberOfLines++;
+    }
+    BOOST_CHECK_EQUAL( numberOfLines, 24 );
+
+    // Compute statistics of final states of individually propagated samples.
+    const DispersedPropagationModelPointer propagationModel = createPropagationModel( );
+    std::vector< Vector6d, Eigen::aligned_allocator< Vector6d > > finalStates;
+    Vector6d meanFinalState = Vector6d::Zero( );
+    for ( unsigned int i = 0; i < dispersedInputsList.size( ); i++ )
+    {
+        const DispersionSampleResult sampleResult = serialAnalysis.propagateSample(
+                    propagationModel, dispersedInputsList[ i ] );
+        finalStates.push_back( sampleResult.finalState );
+        meanFinalState += sampleResult.finalState / dispersedInputsList.size( );
+    }
+
+    Matrix6d finalStateCovariance = Matrix6d::Zero( );
+    for ( unsigned int i = 0; i < finalStates.size( ); i++ )
+    {
+        finalStateCovariance += ( finalStates[ i ] - meanFinalState )
+                * ( finalStates[ i ] - meanFinalState ).transpose( )
+                / ( finalStates.size( ) - 1 );
+    }
+
+    // Check online statistics against statistics of individually propagated samples.
+    for ( int i = 0; i < 6; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( concurrentAnalysis.getMeanFinalState( )( i ),
+                                    meanFinalState( i ), 1.0e-12 );
+        BOOST_CHECK_CLOSE_FRACTION( concurrentAnalysis.getFinalStateCovariance( )( i, i ),
+                                    finalStateCovariance( i, i ), 1.0e-10 );
+    }
+    BOOST_CHECK_SMALL( ( concurrentAnalysis.getFinalStateCovariance( )
+                         - finalStateCovariance ).norm( ) / finalStateCovariance.norm( ),
+                       1.0e-10 );
+
+    // Check that drag has lowered the mean orbit.
+    BOOST_CHECK( meanFinalState.segment( 0, 3 ).norm( )
+                 < getNominalInputs( ).initialState.segment( 0, 3 ).norm( ) );
+}
+
+//! Test whether failed samples are handled correctly by Monte Carlo dispersion analysis.
+BOOST_AUTO_TEST_CASE( testMonteCarloDispersionAnalysisFailedSamples )
+{
+    DispersedInputsList dispersedInputsList
+            = state_derivative_models::generateNormallyDispersedInputs(
+                getNominalInputs( ), getStandardDeviations( ), 8, 11 );
+
+    // Invalidate two samples.
+    dispersedInputsList[ 2 ].dragArea = -1.0;
+    dispersedInputsList[ 5 ].dragArea = -1.0;
+
+    MonteCarloDispersionAnalysis analysis( &createPropagationModel, getPropagationSettings( ),
+                                           boost::make_shared< ParallelTaskPool >( 3 ) );
+    std::ostringstream outputStream;
+    analysis.performAnalysis( dispersedInputsList, &outputStream );
+
+    BOOST_CHECK_EQUAL( analysis.getNumberOfSamples( ), 8 );
+    BOOST_CHECK_EQUAL( analysis.getNumberOfFailedSamples( ), 2 );
+
+    // Check success flags in output.
+    std::istringstream outputLines( outputStream.str( ) );
+    std::string outputLine;
+    for ( unsigned int i = 0; i < dispersedInputsList.size( ); i++ )
+    {
+        std::getline( outputLines, outputLine );
+        std::istringstream outputLineStream( outputLine );
+        unsigned int sampleIndex;
+        bool isPropagationSuccessful;
+        outputLineStream >> sampleIndex >> isPropagationSuccessful;
+        BOOST_CHECK_EQUAL( sampleIndex, i );
+        BOOST_CHECK_EQUAL( isPropagationSuccessful, ( i != 2 && i != 5 ) );
+    }
+
+    // Check that statistics only include successful samples.
+    DispersedInputsList successfulInputsList;
+    for ( unsigned int i = 0; i < dispersedInputsList.size( ); i++ )
+    {
+        if ( i != 2 && i != 5 )
+        {
+            successfulInputsList.push_back( dispersedInputsList[ i ] );
+        }
+    }
+
+    MonteCarloDispersionAnalysis successfulAnalysis( &createPropagationModel,
+                                                     getPropagationSettings( ) );
+    successfulAnalysis.performAnalysis( successfulInputsList );
+
+    BOOST_CHECK( analysis.getMeanFinalState( ) == successfulAnalysis.getMeanFinalState( ) );
+    BOOST_CHECK( analysis.getFinalStateCovariance( )
+                 == successfulAnalysis.getFinalStateCovariance( ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
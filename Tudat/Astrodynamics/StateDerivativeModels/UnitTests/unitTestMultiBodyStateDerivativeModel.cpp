@@ -0,0 +1,237 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140214    S. Vermeer        Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testAccelerationModels.h"
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravitationalAccelerations.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/environmentUpdateGraph.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/multiBodyStateDerivativeModel.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using boost::assign::list_of;
+using state_derivative_models::MultiBodyStateDerivativeModel;
+
+//! Counter of number of perturbing body position evaluations.
+static unsigned int numberOfPositionEvaluations = 0;
+
+//! Compute position of perturbing body.
+/*!
+ * Computes an (arbitrary) position of a perturbing body as a function of time, emulating an
+ * ephemeris, and increments the evaluation counter.
+ * \param time Current time.
+ * \return Position of perturbing body.
+ */
+Eigen::Vector3d computePerturbingBodyPosition( const double time )
+{
+    numberOfPositionEvaluations++;
+    return Eigen::Vector3d( 1.0e3, -2.0e3, 0.5e3 ) * time;
+}
+
+//! Compute position w.r.t. perturbing body.
+/*!
+ * Computes position of a body w.r.t. the perturbing body.
+ * \param bodyPosition Function returning position of body.
+ * \param perturbingBodyPosition Function returning position of perturbing body.
+ * \return Position of body w.r.t. perturbing body.
+ */
+Eigen::Vector3d computePositionWithRespectToPerturbingBody(
+        const boost::function< Eigen::Vector3d( ) > bodyPosition,
+        const boost::function< Eigen::Vector3d( ) > perturbingBodyPosition )
+{
+    return bodyPosition( ) - perturbingBodyPosition( );
+}
+
+BOOST_AUTO_TEST_SUITE( test_multi_body_state_derivative_model )
+
+//! Test whether multi-body state derivative model correctly combines all accelerations.
+BOOST_AUTO_TEST_CASE( testMultiBodyStateDerivativeModel )
+{
+    using basic_astrodynamics::AccelerationModel3dPointer;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+    using state_derivative_models::EnvironmentUpdateGraph;
+
+    typedef DerivedAccelerationModel< > DerivedAccelerationModel3d;
+    typedef EnvironmentUpdateGraph< double, Eigen::VectorXd > StackedEnvironmentUpdateGraph;
+
+    const unsigned int numberOfBodies = 3;
+    numberOfPositionEvaluations = 0;
+
+    // Create environment, containing the position of a perturbing body shared by all bodies.
+    StackedEnvironmentUpdateGraph environmentUpdateGraph;
+    const boost::function< Eigen::Vector3d( ) > perturbingBodyPosition
+            = environmentUpdateGraph.addTimeDependentVariable< Eigen::Vector3d >(
+                "perturbing_body_position", &computePerturbingBodyPosition );
+
+    // Create multi-body state derivative model.
+    MultiBodyStateDerivativeModel stateDerivativeModel(
+                numberOfBodies, boost::bind( &StackedEnvironmentUpdateGraph::updateEnvironment,
+                                             &environmentUpdateGraph, _1, _2 ) );
+    BOOST_CHECK_EQUAL( stateDerivativeModel.getNumberOfBodies( ), numberOfBodies );
+
+    // Set uncoupled acceleration models of first two bodies (none for third body), which depend
+    // on the position of the body w.r.t. the perturbing body.
+    const boost::function< double( ) > currentTime
+            = boost::bind( &MultiBodyStateDerivativeModel::getCurrentTime,
+                           &stateDerivativeModel );
+    for ( unsigned int i = 0; i < numberOfBodies - 1; i++ )
+    {
+        CartesianStateDerivativeModel6d::AccelerationModelPointerVector listOfAccelerations
+                = list_of< AccelerationModel3dPointer >(
+                    boost::make_shared< DerivedAccelerationModel3d >(
+                        boost::bind( &computePositionWithRespectToPerturbingBody,
+                                     boost::function< Eigen::Vector3d( ) >(
+                                         boost::bind( &MultiBodyStateDerivativeModel::
+                                                      getCurrentPositionOfBody,
+                                                      &stateDerivativeModel, i ) ),
+                                     perturbingBodyPosition ), currentTime ) );
+        stateDerivativeModel.setUncoupledAccelerationModels( i, listOfAccelerations );
+    }
+
+    // Add mutual gravitational accelerations as coupled accelerations.
+    const Eigen::Vector3d gravitationalParameters( 3.0e2, 2.0e2, 1.0e2 );
+    stateDerivativeModel.addCoupledAccelerationFunction(
+                boost::bind( &gravitation::computeMutualGravitationalAccelerations,
+                             _2, Eigen::VectorXd( gravitationalParameters ), 0.0 ) );
+
+    // Set stacked state.
+    Eigen::VectorXd stackedState( 6 * numberOfBodies );
+    stackedState << 10.0, 0.0, 0.0, 0.0, 1.0, 0.0,
+            0.0, 20.0, 0.0, -0.5, 0.0, 0.1,
+            3.0, -4.0, 12.0, 0.2, 0.3, -0.4;
+    const double time = 2.5;
+
+    // Compute expected state derivative.
+    Eigen::VectorXd expectedStateDerivative( 6 * numberOfBodies );
+    const Eigen::Vector3d expectedPerturbingBodyPosition
+            = Eigen::Vector3d( 1.0e3, -2.0e3, 0.5e3 ) * time;
+    for ( unsigned int i = 0; i < numberOfBodies; i++ )
+    {
+        const Eigen::Vector3d position = stackedState.segment< 3 >( 6 * i );
+
+        Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+        if ( i < numberOfBodies - 1 )
+        {
+            acceleration += ( position - expectedPerturbingBodyPosition ) / ( time * time );
+        }
+
+        for ( unsigned int j = 0; j < numberOfBodies; j++ )
+        {
+            if ( j != i )
+            {
+                const Eigen::Vector3d relativePosition
+                        = Eigen::Vector3d( stackedState.segment< 3 >( 6 * j ) ) - position;
+                acceleration += gravitationalParameters( j ) * relativePosition
+                        / std::pow( relativePosition.norm( ), 3.0 );
+            }
+        }
+
+        expectedStateDerivative.segment< 3 >( 6 * i ) = stackedState.segment< 3 >( 6 * i + 3 );
+        expectedStateDerivative.segment< 3 >( 6 * i + 3 ) = acceleration;
+    }
+
+    // Compute state derivative.
+    const Eigen::VectorXd computedStateDerivative
+            = stateDerivativeModel.computeStateDerivative( time, stackedState );
+
+    // Check computed state derivative.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedStateDerivative, expectedStateDerivative,
+                                       1.0e-14 );
+
+    // Check that current states are available to acceleration models.
+    BOOST_CHECK_EQUAL( stateDerivativeModel.getCurrentTime( ), time );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( stateDerivativeModel.getCurrentStateOfBody( 1 ),
+                                       basic_mathematics::Vector6d(
+                                           stackedState.segment< 6 >( 6 ) ),
+                                       1.0e-15 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( stateDerivativeModel.getCurrentVelocityOfBody( 2 ),
+                                       Eigen::Vector3d( 0.2, 0.3, -0.4 ), 1.0e-15 );
+
+    // Check that the shared environment was updated only once for all bodies.
+    BOOST_CHECK_EQUAL( numberOfPositionEvaluations, 1 );
+}
+
+//! Test whether inconsistent input is detected.
+BOOST_AUTO_TEST_CASE( testMultiBodyStateDerivativeModelErrorHandling )
+{
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+
+    MultiBodyStateDerivativeModel stateDerivativeModel( 2 );
+
+    // Check that invalid body index is detected.
+    BOOST_CHECK_THROW( stateDerivativeModel.setUncoupledAccelerationModels(
+                           2, CartesianStateDerivativeModel6d::AccelerationModelPointerVector( ) ),
+                       std::runtime_error );
+
+    // Check that inconsistent state size is detected.
+    BOOST_CHECK_THROW( stateDerivativeModel.computeStateDerivative(
+                           0.0, Eigen::VectorXd::Zero( 6 ) ), std::runtime_error );
+
+    // Check that state derivative of bodies without accelerations is equal to velocity.
+    Eigen::VectorXd stackedState( 12 );
+    stackedState << 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0;
+    Eigen::VectorXd expectedStateDerivative = Eigen::VectorXd::Zero( 12 );
+    expectedStateDerivative.segment< 3 >( 0 ) = stackedState.segment< 3 >( 3 );
+    expectedStateDerivative.segment< 3 >( 6 ) = stackedState.segment< 3 >( 9 );
+
+    const Eigen::VectorXd computedStateDerivative
+            = stateDerivativeModel.computeStateDerivative( 0.0, stackedState );
+    TUDAT_CHECK_MATRIX_BASE( computedStateDerivative, expectedStateDerivative )
+            BOOST_CHECK_EQUAL( computedStateDerivative.coeff( row, col ),
+                               expectedStateDerivative.coeff( row, col ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,270 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140210    S. Vermeer        Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *      The statically dispatched state derivative models are compared to the
+ *      CartesianStateDerivativeModel class, for which the expected values are verified in
+ *      unitTestCartesianStateDerivativeModel.cpp.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <utility>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/tuple/tuple.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testAccelerationModels.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/UnitTests/testBody.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateDerivativeModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/staticCartesianStateDerivativeModel.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using boost::assign::list_of;
+using basic_mathematics::Vector6d;
+
+// Shortcuts.
+typedef TestBody< 3, double > TestBody3d;
+typedef boost::shared_ptr< TestBody3d > TestBody3dPointer;
+typedef DerivedAccelerationModel< > DerivedAccelerationModel3d;
+typedef AnotherDerivedAccelerationModel< > AnotherDerivedAccelerationModel3d;
+
+//! Rotate vector over arbitrary angles.
+/*!
+ * This function computes a composite rotation of the input vector over arbitrary angles about the
+ * unit x-, y-, and z-axes.
+ * \param inputVector Input vector before rotation.
+ * \return Rotated vector.
+ */
+Eigen::Vector3d rotateOverArbitraryAngles( const Eigen::Vector3d& inputVector )
+{
+    // Declare rotation matrix.
+    Eigen::Matrix3d rotationMatrix;
+    rotationMatrix = Eigen::AngleAxisd( -1.15, Eigen::Vector3d::UnitX( ) )
+            * Eigen::AngleAxisd( 0.23, Eigen::Vector3d::UnitY( ) )
+            * Eigen::AngleAxisd( 2.56, Eigen::Vector3d::UnitZ( ) );
+
+    // Compute rotated matrix and return.
+    return  rotationMatrix * inputVector;
+}
+
+//! Rotate vector over other arbitrary angles.
+/*!
+ * This function computes another composite rotation of the input vector over different arbitrary
+ * angles (compared to the rotateOverArbitraryAngles() function) about the unit x-, y-, and z-axes.
+ * \param inputVector Input vector before rotation.
+ * \return Rotated vector.
+ */
+Eigen::Vector3d rotateOverOtherArbitraryAngles( const Eigen::Vector3d& inputVector )
+{
+    // Declare rotation matrix.
+    Eigen::Matrix3d rotationMatrix;
+    rotationMatrix = Eigen::AngleAxisd( 0.24, Eigen::Vector3d::UnitX( ) )
+            * Eigen::AngleAxisd( -1.55, Eigen::Vector3d::UnitY( ) )
+            * Eigen::AngleAxisd( 2.13, Eigen::Vector3d::UnitZ( ) );
+
+    // Compute rotated matrix and return.
+    return  rotationMatrix * inputVector;
+}
+
+//! Function object applying both arbitrary rotations.
+/*!
+ * Function object applying rotateOverArbitraryAngles(), followed by
+ * rotateOverOtherArbitraryAngles(), used as static frame transformation.
+ */
+struct RotateOverBothArbitraryAngles
+{
+    //! Apply both arbitrary rotations.
+    Eigen::Vector3d operator( )( const Eigen::Vector3d& inputVector ) const
+    {
+        return rotateOverOtherArbitraryAngles( rotateOverArbitraryAngles( inputVector ) );
+    }
+};
+
+BOOST_AUTO_TEST_SUITE( test_static_cartesian_state_derivative_model )
+
+//! Test whether static state derivative model reproduces dynamic model without transformations.
+BOOST_AUTO_TEST_CASE( test_StaticCartesianStateDerivativeModelWithoutFrameTransformations )
+{
+    using basic_astrodynamics::AccelerationModel3dPointer;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+    using state_derivative_models::StaticCartesianStateDerivativeModel;
+
+    // Set current state and time.
+    const Vector6d currentState = ( Eigen::VectorXd( 6 )
+                                    << Eigen::Vector3d( -1.1, 2.2, -3.3 ),
+                                    Eigen::Vector3d( 0.23, 1.67, -0.11 ) ).finished( );
+    const double currentTime = 5.6;
+
+    // Create body with zombie time and state.
+    TestBody3dPointer body = boost::make_shared< TestBody3d >( Eigen::VectorXd::Zero( 6 ), 0.0 );
+
+    // Create acceleration models of concrete types.
+    boost::shared_ptr< DerivedAccelerationModel3d > firstAccelerationModel3d
+            = boost::make_shared< DerivedAccelerationModel3d >(
+                boost::bind( &TestBody3d::getCurrentPosition, body ),
+                boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+    boost::shared_ptr< AnotherDerivedAccelerationModel3d > secondAccelerationModel3d
+            = boost::make_shared< AnotherDerivedAccelerationModel3d >(
+                boost::bind( &TestBody3d::getCurrentPosition, body ),
+                boost::bind( &TestBody3d::getCurrentVelocity, body ),
+                boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+    // Declare dynamic Cartesian state derivative model.
+    CartesianStateDerivativeModel6d::AccelerationModelPointerVector listOfAccelerations
+            = list_of< AccelerationModel3dPointer >( firstAccelerationModel3d )
+            ( secondAccelerationModel3d );
+    CartesianStateDerivativeModel6d dynamicStateDerivativeModel(
+                listOfAccelerations,
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    // Declare static Cartesian state derivative model, with the same models given by concrete
+    // type, and, for the second list, by abstract type (called through virtual dispatch).
+    typedef boost::tuple< boost::shared_ptr< DerivedAccelerationModel3d >,
+            boost::shared_ptr< AnotherDerivedAccelerationModel3d > > ConcreteAccelerationList;
+    StaticCartesianStateDerivativeModel< ConcreteAccelerationList > staticStateDerivativeModel(
+                boost::make_tuple( firstAccelerationModel3d, secondAccelerationModel3d ),
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    typedef boost::tuple< AccelerationModel3dPointer, AccelerationModel3dPointer >
+            AbstractAccelerationList;
+    StaticCartesianStateDerivativeModel< AbstractAccelerationList >
+            abstractStaticStateDerivativeModel(
+                AbstractAccelerationList( firstAccelerationModel3d, secondAccelerationModel3d ),
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    // Compute Cartesian state derivatives.
+    const Vector6d expectedCartesianStateDerivative
+            = dynamicStateDerivativeModel.computeStateDerivative( currentTime, currentState );
+    const Vector6d computedCartesianStateDerivative
+            = staticStateDerivativeModel.computeStateDerivative( currentTime, currentState );
+    const Vector6d computedAbstractCartesianStateDerivative
+            = abstractStaticStateDerivativeModel.computeStateDerivative(
+                currentTime, currentState );
+
+    // Check that computed Cartesian state derivatives match dynamic model.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedCartesianStateDerivative,
+                                       expectedCartesianStateDerivative,
+                                       std::numeric_limits< double >::epsilon( ) );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedAbstractCartesianStateDerivative,
+                                       expectedCartesianStateDerivative,
+                                       std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test whether static state derivative model reproduces dynamic model with transformations.
+BOOST_AUTO_TEST_CASE( test_StaticCartesianStateDerivativeModelWithFrameTransformations )
+{
+    using basic_astrodynamics::AccelerationModel3dPointer;
+    using state_derivative_models::CartesianStateDerivativeModel6d;
+    using state_derivative_models::StaticCartesianStateDerivativeModel;
+    using state_derivative_models::StaticAccelerationFrameTransformationPair;
+    using state_derivative_models::makeStaticAccelerationFrameTransformationPair;
+
+    // Set current state and time.
+    const Vector6d currentState = ( Eigen::VectorXd( 6 )
+                                    << Eigen::Vector3d( -1.1, 2.2, -3.3 ),
+                                    Eigen::Vector3d( 0.23, 1.67, -0.11 ) ).finished( );
+    const double currentTime = 5.6;
+
+    // Create body with zombie time and state.
+    TestBody3dPointer body = boost::make_shared< TestBody3d >( Eigen::VectorXd::Zero( 6 ), 0.0 );
+
+    // Create acceleration models of concrete types.
+    boost::shared_ptr< DerivedAccelerationModel3d > firstAccelerationModel3d
+            = boost::make_shared< DerivedAccelerationModel3d >(
+                boost::bind( &TestBody3d::getCurrentPosition, body ),
+                boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+    boost::shared_ptr< AnotherDerivedAccelerationModel3d > secondAccelerationModel3d
+            = boost::make_shared< AnotherDerivedAccelerationModel3d >(
+                boost::bind( &TestBody3d::getCurrentPosition, body ),
+                boost::bind( &TestBody3d::getCurrentVelocity, body ),
+                boost::bind( &TestBody3d::getCurrentTime, body ) );
+
+    // Declare dynamic Cartesian state derivative model, with two frame transformations for the
+    // first acceleration model, and none for the second.
+    CartesianStateDerivativeModel6d::ListOfReferenceFrameTransformations listOfFrameTransformations
+            = list_of( &rotateOverArbitraryAngles )( &rotateOverOtherArbitraryAngles );
+    CartesianStateDerivativeModel6d::ListOfAccelerationFrameTransformationPairs
+            listOfAccelerationFrameTransformations
+            = list_of( std::make_pair( AccelerationModel3dPointer( firstAccelerationModel3d ),
+                                       listOfFrameTransformations ) )
+            ( std::make_pair( AccelerationModel3dPointer( secondAccelerationModel3d ),
+                              CartesianStateDerivativeModel6d::
+                              ListOfReferenceFrameTransformations( ) ) );
+    CartesianStateDerivativeModel6d dynamicStateDerivativeModel(
+                listOfAccelerationFrameTransformations,
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    // Declare static Cartesian state derivative model, with the composed frame transformation.
+    typedef boost::tuple< StaticAccelerationFrameTransformationPair<
+            DerivedAccelerationModel3d, RotateOverBothArbitraryAngles >,
+            boost::shared_ptr< AnotherDerivedAccelerationModel3d > > AccelerationList;
+    StaticCartesianStateDerivativeModel< AccelerationList > staticStateDerivativeModel(
+                AccelerationList( makeStaticAccelerationFrameTransformationPair(
+                                      firstAccelerationModel3d,
+                                      RotateOverBothArbitraryAngles( ) ),
+                                  secondAccelerationModel3d ),
+                boost::bind( &TestBody3d::setCurrentTimeAndState, body, _1, _2 ) );
+
+    // Compute Cartesian state derivatives.
+    const Vector6d expectedCartesianStateDerivative
+            = dynamicStateDerivativeModel.computeStateDerivative( currentTime, currentState );
+    const Vector6d computedCartesianStateDerivative
+            = staticStateDerivativeModel.computeStateDerivative( currentTime, currentState );
+
+    // Check that computed Cartesian state derivative matches dynamic model.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedCartesianStateDerivative,
+                                       expectedCartesianStateDerivative,
+                                       std::numeric_limits< double >::epsilon( ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,277 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140219    S. Vermeer        File created.
+ *      140415    S. Vermeer        Added clock function.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <boost/chrono.hpp>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/accelerationModelProfiler.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+namespace
+{
+
+//! Base-10 logarithm of lower bound of execution time histogram [s].
+const double LOWER_BOUND_EXPONENT = -9.0;
+
+//! Number of histogram bins per decade of execution time.
+const double NUMBER_OF_BINS_PER_DECADE = 20.0;
+
+//! Number of histogram bins (12 decades, from 1 ns to 1000 s).
+const unsigned int NUMBER_OF_HISTOGRAM_BINS = 240;
+
+//! Reference time of clock, such that current times are small and retain their resolution.
+const boost::chrono::high_resolution_clock::time_point REFERENCE_TIME
+        = boost::chrono::high_resolution_clock::now( );
+
+} // namespace
+
+//! Default constructor.
+ExecutionTimeStatistics::ExecutionTimeStatistics( )
+    : histogram( NUMBER_OF_HISTOGRAM_BINS, 0 )
+{
+    reset( );
+}
+
+//! Add sample.
+void ExecutionTimeStatistics::addSample( const double executionTime )
+{
+    numberOfSamples++;
+    cumulativeTime += executionTime;
+    minimumTime = std::min( minimumTime, executionTime );
+    maximumTime = std::max( maximumTime, executionTime );
+
+    // Determine histogram bin, clamping times outside histogram range to outer bins.
+    int binIndex = 0;
+    if ( executionTime > 0.0 )
+    {
+        binIndex = static_cast< int >( std::floor(
+                    ( std::log10( executionTime ) - LOWER_BOUND_EXPONENT )
+                    * NUMBER_OF_BINS_PER_DECADE ) );
+        binIndex = std::max( 0, std::min( binIndex,
+                                          static_cast< int >( NUMBER_OF_HISTOGRAM_BINS ) - 1 ) );
+    }
+    histogram[ binIndex ]++;
+}
+
+//! Get mean execution time.
+double ExecutionTimeStatistics::getMeanTime( ) const
+{
+    return ( numberOfSamples > 0 ) ? cumulativeTime / static_cast< double >( numberOfSamples )
+                                   : 0.0;
+}
+
+//! Get minimum execution time.
+double ExecutionTimeStatistics::getMinimumTime( ) const
+{
+    return ( numberOfSamples > 0 ) ? minimumTime : 0.0;
+}
+
+//! Get percentile of execution time.
+double ExecutionTimeStatistics::getPercentile( const double percentage ) const
+{
+    if ( numberOfSamples == 0 )
+    {
+        return 0.0;
+    }
+
+    // Determine rank of sample corresponding to percentile (at least the first sample).
+    const unsigned long rank = std::max(
+                1UL, static_cast< unsigned long >( std::ceil(
+                                                       percentage / 100.0
+                                                       * static_cast< double >(
+                                                           numberOfSamples ) ) ) );
+
+    // Find bin containing sample of given rank.
+    unsigned long cumulativeNumberOfSamples = 0;
+    unsigned int binIndex = 0;
+    for ( ; binIndex < NUMBER_OF_HISTOGRAM_BINS - 1; binIndex++ )
+    {
+        cumulativeNumberOfSamples += histogram[ binIndex ];
+        if ( cumulativeNumberOfSamples >= rank )
+        {
+            break;
+        }
+    }
+
+    // Return (logarithmic) center of bin, limited to range of samples.
+    const double binCenter = std::pow(
+                10.0, LOWER_BOUND_EXPONENT
+                + ( static_cast< double >( binIndex ) + 0.5 ) / NUMBER_OF_BINS_PER_DECADE );
+    return std::max( minimumTime, std::min( maximumTime, binCenter ) );
+}
+
+//! Reset statistics.
+void ExecutionTimeStatistics::reset( )
+{
+    numberOfSamples = 0;
+    cumulativeTime = 0.0;
+    minimumTime = std::numeric_limits< double >::max( );
+    maximumTime = 0.0;
+    std::fill( histogram.begin( ), histogram.end( ), 0 );
+}
+
+//! Constructor taking number of acceleration models.
+AccelerationModelProfiler::AccelerationModelProfiler(
+        const unsigned int numberOfAccelerationModels )
+{
+    for ( unsigned int i = 0; i < numberOfAccelerationModels; i++ )
+    {
+        std::ostringstream accelerationModelName;
+        accelerationModelName << "Acceleration model " << i;
+        accelerationModelNames.push_back( accelerationModelName.str( ) );
+    }
+
+    reset( );
+}
+
+//! Constructor taking names of acceleration models.
+AccelerationModelProfiler::AccelerationModelProfiler(
+        const std::vector< std::string >& someAccelerationModelNames )
+    : accelerationModelNames( someAccelerationModelNames )
+{
+    reset( );
+}
+
+//! Get current time.
+double AccelerationModelProfiler::getCurrentTime( ) const
+{
+    return boost::chrono::duration< double >(
+                boost::chrono::high_resolution_clock::now( ) - REFERENCE_TIME ).count( );
+}
+
+//! Add sample.
+void AccelerationModelProfiler::addSample( const unsigned int accelerationModelIndex,
+                                           const double updateTime,
+                                           const double accelerationTime,
+                                           const double accelerationMagnitude )
+{
+    updateTimeStatistics[ accelerationModelIndex ].addSample( updateTime );
+    accelerationTimeStatistics[ accelerationModelIndex ].addSample( accelerationTime );
+
+    minimumAccelerationMagnitudes[ accelerationModelIndex ] = std::min(
+                minimumAccelerationMagnitudes[ accelerationModelIndex ], accelerationMagnitude );
+    maximumAccelerationMagnitudes[ accelerationModelIndex ] = std::max(
+                maximumAccelerationMagnitudes[ accelerationModelIndex ], accelerationMagnitude );
+    sumsOfAccelerationMagnitudes[ accelerationModelIndex ] += accelerationMagnitude;
+}
+
+//! Get minimum acceleration magnitude of acceleration model.
+double AccelerationModelProfiler::getMinimumAccelerationMagnitude(
+        const unsigned int accelerationModelIndex ) const
+{
+    return ( getNumberOfCalls( accelerationModelIndex ) > 0 )
+            ? minimumAccelerationMagnitudes.at( accelerationModelIndex ) : 0.0;
+}
+
+//! Get mean acceleration magnitude of acceleration model.
+double AccelerationModelProfiler::getMeanAccelerationMagnitude(
+        const unsigned int accelerationModelIndex ) const
+{
+    const unsigned long numberOfCalls = getNumberOfCalls( accelerationModelIndex );
+    return ( numberOfCalls > 0 )
+            ? sumsOfAccelerationMagnitudes.at( accelerationModelIndex )
+              / static_cast< double >( numberOfCalls ) : 0.0;
+}
+
+//! Print report.
+void AccelerationModelProfiler::printReport( std::ostream& outputStream ) const
+{
+    // Determine width of name column.
+    unsigned int nameWidth = 5;
+    for ( unsigned int i = 0; i < accelerationModelNames.size( ); i++ )
+    {
+        nameWidth = std::max( nameWidth,
+                              static_cast< unsigned int >( accelerationModelNames[ i ].size( ) ) );
+    }
+
+    // Save stream format, and print header.
+    const std::ios_base::fmtflags originalFlags = outputStream.flags( );
+    const std::streamsize originalPrecision = outputStream.precision( );
+
+    outputStream << std::left << std::setw( nameWidth ) << "Model" << std::right
+                 << std::setw( 12 ) << "Calls"
+                 << std::setw( 12 ) << "Update [s]" << std::setw( 12 ) << "p50 [s]"
+                 << std::setw( 12 ) << "p99 [s]"
+                 << std::setw( 12 ) << "GetAcc [s]" << std::setw( 12 ) << "p50 [s]"
+                 << std::setw( 12 ) << "p99 [s]"
+                 << std::setw( 12 ) << "Min |a|" << std::setw( 12 ) << "Mean |a|"
+                 << std::setw( 12 ) << "Max |a|" << std::endl;
+
+    // Print profiling data per acceleration model.
+    outputStream << std::scientific << std::setprecision( 3 );
+    for ( unsigned int i = 0; i < accelerationModelNames.size( ); i++ )
+    {
+        outputStream << std::left << std::setw( nameWidth ) << accelerationModelNames[ i ]
+                     << std::right << std::setw( 12 ) << getNumberOfCalls( i )
+                     << std::setw( 12 ) << updateTimeStatistics[ i ].getCumulativeTime( )
+                     << std::setw( 12 ) << updateTimeStatistics[ i ].getPercentile( 50.0 )
+                     << std::setw( 12 ) << updateTimeStatistics[ i ].getPercentile( 99.0 )
+                     << std::setw( 12 ) << accelerationTimeStatistics[ i ].getCumulativeTime( )
+                     << std::setw( 12 ) << accelerationTimeStatistics[ i ].getPercentile( 50.0 )
+                     << std::setw( 12 ) << accelerationTimeStatistics[ i ].getPercentile( 99.0 )
+                     << std::setw( 12 ) << getMinimumAccelerationMagnitude( i )
+                     << std::setw( 12 ) << getMeanAccelerationMagnitude( i )
+                     << std::setw( 12 ) << getMaximumAccelerationMagnitude( i ) << std::endl;
+    }
+
+    // Restore stream format.
+    outputStream.flags( originalFlags );
+    outputStream.precision( originalPrecision );
+}
+
+//! Reset profiling data.
+void AccelerationModelProfiler::reset( )
+{
+    const unsigned int numberOfAccelerationModels = accelerationModelNames.size( );
+
+    updateTimeStatistics.assign( numberOfAccelerationModels, ExecutionTimeStatistics( ) );
+    accelerationTimeStatistics.assign( numberOfAccelerationModels, ExecutionTimeStatistics( ) );
+    minimumAccelerationMagnitudes.assign( numberOfAccelerationModels,
+                                          std::numeric_limits< double >::max( ) );
+    maximumAccelerationMagnitudes.assign( numberOfAccelerationModels, 0.0 );
+    sumsOfAccelerationMagnitudes.assign( numberOfAccelerationModels, 0.0 );
+}
+
+} // namespace state_derivative_models
+} // namespace tudat
@@ -0,0 +1,342 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140219    S. Vermeer        File created.
+ *      140415    S. Vermeer        Added clock function; made functions called by state derivative
+ *                                  model virtual.
+ *
+ *    References
+ *
+ *    Notes
+ *      Percentiles of the execution times are determined from a histogram with logarithmically
+ *      spaced bins (20 per decade, from 1 ns to 1000 s), such that the memory use is independent of
+ *      the number of calls. The relative error of the percentiles is therefore at most ~6%, which
+ *      is well below the typical variation of execution times between calls.
+ *
+ *      The statistics of different acceleration models are stored separately, so that samples of
+ *      different acceleration models can be added concurrently (as is done when the acceleration
+ *      models are evaluated on a ParallelTaskPool); samples of the same acceleration model must
+ *      not be added concurrently.
+ *
+ *      The functions called by a state derivative model (getCurrentTime() and addSample()) are
+ *      virtual, such that the state derivative models do not refer to the profiler library, which
+ *      is only built if the Boost chrono library is found. The profiler library is therefore only
+ *      required if a profiler is actually created.
+ *
+ */
+
+#ifndef TUDAT_ACCELERATION_MODEL_PROFILER_H
+#define TUDAT_ACCELERATION_MODEL_PROFILER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Execution time statistics class.
+/*!
+ * Class that accumulates statistics (number of samples, cumulative time, extreme values and
+ * approximate percentiles) of execution times.
+ */
+class ExecutionTimeStatistics
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, creates statistics without samples.
+     */
+    ExecutionTimeStatistics( );
+
+    //! Add sample.
+    /*!
+     * Adds an execution time sample to the statistics.
+     * \param executionTime Execution time [s].
+     */
+    void addSample( const double executionTime );
+
+    //! Get number of samples.
+    /*!
+     * Returns number of samples.
+     * \return Number of samples.
+     */
+    unsigned long getNumberOfSamples( ) const { return numberOfSamples; }
+
+    //! Get cumulative execution time.
+    /*!
+     * Returns cumulative execution time of all samples.
+     * \return Cumulative execution time [s].
+     */
+    double getCumulativeTime( ) const { return cumulativeTime; }
+
+    //! Get mean execution time.
+    /*!
+     * Returns mean execution time (zero if there are no samples).
+     * \return Mean execution time [s].
+     */
+    double getMeanTime( ) const;
+
+    //! Get minimum execution time.
+    /*!
+     * Returns minimum execution time (zero if there are no samples).
+     * \return Minimum execution time [s].
+     */
+    double getMinimumTime( ) const;
+
+    //! Get maximum execution time.
+    /*!
+     * Returns maximum execution time (zero if there are no samples).
+     * \return Maximum execution time [s].
+     */
+    double getMaximumTime( ) const { return maximumTime; }
+
+    //! Get percentile of execution time.
+    /*!
+     * Returns (approximate) percentile of execution time, i.e., the execution time below which
+     * the given percentage of samples lies (zero if there are no samples).
+     * \param percentage Percentage, in range [0, 100].
+     * \return Percentile of execution time [s].
+     */
+    double getPercentile( const double percentage ) const;
+
+    //! Reset statistics.
+    /*!
+     * Removes all samples from the statistics.
+     */
+    void reset( );
+
+protected:
+
+private:
+
+    //! Number of samples.
+    unsigned long numberOfSamples;
+
+    //! Cumulative execution time of all samples [s].
+    double cumulativeTime;
+
+    //! Minimum execution time [s].
+    double minimumTime;
+
+    //! Maximum execution time [s].
+    double maximumTime;
+
+    //! Number of samples per (logarithmically spaced) histogram bin.
+    std::vector< unsigned long > histogram;
+};
+
+//! Acceleration model profiler class.
+/*!
+ * Class that collects profiling data of the acceleration models in a state derivative model:
+ * the number of calls, execution time statistics of the updateMembers() and getAcceleration()
+ * functions, and statistics of the magnitude of the computed accelerations. This information can
+ * be used to identify acceleration models that are negligible (e.g., third-body perturbations
+ * that never exceed a given magnitude), or that dominate the computational cost. The profiler is
+ * set on a CartesianStateDerivativeModel, which adds a sample for each acceleration model at
+ * each evaluation.
+ */
+class AccelerationModelProfiler
+{
+public:
+
+    //! Constructor taking number of acceleration models.
+    /*!
+     * Constructor taking number of acceleration models, which are named by their index in the
+     * list of acceleration models.
+     * \param numberOfAccelerationModels Number of acceleration models.
+     */
+    explicit AccelerationModelProfiler( const unsigned int numberOfAccelerationModels );
+
+    //! Constructor taking names of acceleration models.
+    /*!
+     * Constructor taking names of acceleration models, in the order of the list of acceleration
+     * models of the state derivative model.
+     * \param someAccelerationModelNames Names of acceleration models.
+     */
+    explicit AccelerationModelProfiler(
+            const std::vector< std::string >& someAccelerationModelNames );
+
+    //! Default destructor.
+    virtual ~AccelerationModelProfiler( ) { }
+
+    //! Get current time.
+    /*!
+     * Returns the current time of a high-resolution clock, from which execution times are
+     * computed as differences.
+     * eturn Current time [s].
+     */
+    virtual double getCurrentTime( ) const;
+
+    //! Add sample.
+    /*!
+     * Adds a sample of the execution times and acceleration magnitude of an acceleration model.
+     * \param accelerationModelIndex Index of acceleration model.
+     * \param updateTime Execution time of updateMembers() [s].
+     * \param accelerationTime Execution time of getAcceleration() (including frame
+     *          transformations) [s].
+     * \param accelerationMagnitude Magnitude of computed acceleration.
+     */
+    virtual void addSample( const unsigned int accelerationModelIndex, const double updateTime,
+                            const double accelerationTime, const double accelerationMagnitude );
+
+    //! Get number of acceleration models.
+    /*!
+     * Returns number of acceleration models.
+     * \return Number of acceleration models.
+     */
+    unsigned int getNumberOfAccelerationModels( ) const
+    {
+        return accelerationModelNames.size( );
+    }
+
+    //! Get name of acceleration model.
+    /*!
+     * Returns name of acceleration model.
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Name of acceleration model.
+     */
+    const std::string& getAccelerationModelName( const unsigned int accelerationModelIndex ) const
+    {
+        return accelerationModelNames.at( accelerationModelIndex );
+    }
+
+    //! Get number of calls of acceleration model.
+    /*!
+     * Returns number of calls (samples) of acceleration model.
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Number of calls.
+     */
+    unsigned long getNumberOfCalls( const unsigned int accelerationModelIndex ) const
+    {
+        return updateTimeStatistics.at( accelerationModelIndex ).getNumberOfSamples( );
+    }
+
+    //! Get execution time statistics of updateMembers() of acceleration model.
+    /*!
+     * Returns execution time statistics of updateMembers() of acceleration model.
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Execution time statistics of updateMembers().
+     */
+    const ExecutionTimeStatistics& getUpdateTimeStatistics(
+            const unsigned int accelerationModelIndex ) const
+    {
+        return updateTimeStatistics.at( accelerationModelIndex );
+    }
+
+    //! Get execution time statistics of getAcceleration() of acceleration model.
+    /*!
+     * Returns execution time statistics of getAcceleration() (including frame transformations)
+     * of acceleration model.
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Execution time statistics of getAcceleration().
+     */
+    const ExecutionTimeStatistics& getAccelerationTimeStatistics(
+            const unsigned int accelerationModelIndex ) const
+    {
+        return accelerationTimeStatistics.at( accelerationModelIndex );
+    }
+
+    //! Get minimum acceleration magnitude of acceleration model.
+    /*!
+     * Returns minimum magnitude of accelerations computed by acceleration model (zero if there
+     * are no samples).
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Minimum acceleration magnitude.
+     */
+    double getMinimumAccelerationMagnitude( const unsigned int accelerationModelIndex ) const;
+
+    //! Get maximum acceleration magnitude of acceleration model.
+    /*!
+     * Returns maximum magnitude of accelerations computed by acceleration model (zero if there
+     * are no samples).
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Maximum acceleration magnitude.
+     */
+    double getMaximumAccelerationMagnitude( const unsigned int accelerationModelIndex ) const
+    {
+        return maximumAccelerationMagnitudes.at( accelerationModelIndex );
+    }
+
+    //! Get mean acceleration magnitude of acceleration model.
+    /*!
+     * Returns mean magnitude of accelerations computed by acceleration model (zero if there are
+     * no samples).
+     * \param accelerationModelIndex Index of acceleration model.
+     * \return Mean acceleration magnitude.
+     */
+    double getMeanAccelerationMagnitude( const unsigned int accelerationModelIndex ) const;
+
+    //! Print report.
+    /*!
+     * Prints a table with the profiling data of all acceleration models: number of calls,
+     * cumulative, median and 99th percentile execution times of updateMembers() and
+     * getAcceleration(), and minimum, mean and maximum acceleration magnitude.
+     * \param outputStream Output stream to print report to (default is std::cout).
+     */
+    void printReport( std::ostream& outputStream = std::cout ) const;
+
+    //! Reset profiling data.
+    /*!
+     * Removes all samples of all acceleration models.
+     */
+    void reset( );
+
+protected:
+
+private:
+
+    //! Names of acceleration models.
+    std::vector< std::string > accelerationModelNames;
+
+    //! Execution time statistics of updateMembers() per acceleration model.
+    std::vector< ExecutionTimeStatistics > updateTimeStatistics;
+
+    //! Execution time statistics of getAcceleration() per acceleration model.
+    std::vector< ExecutionTimeStatistics > accelerationTimeStatistics;
+
+    //! Minimum acceleration magnitude per acceleration model.
+    std::vector< double > minimumAccelerationMagnitudes;
+
+    //! Maximum acceleration magnitude per acceleration model.
+    std::vector< double > maximumAccelerationMagnitudes;
+
+    //! Sum of acceleration magnitudes per acceleration model.
+    std::vector< double > sumsOfAccelerationMagnitudes;
+};
+
+//! Typedef for shared-pointer to AccelerationModelProfiler object.
+typedef boost::shared_ptr< AccelerationModelProfiler > AccelerationModelProfilerPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_ACCELERATION_MODEL_PROFILER_H
@@ -35,6 +35,16 @@
  *                                  CompositeStateDerivativeModel; added frame transformation
  *                                  functionality.
  *      140128    E. Brandon        Corrected doxygen documentation.
+ *      140212    S. Vermeer        Added optional concurrent evaluation of acceleration models.
+ *      140219    S. Vermeer        Added optional profiling of acceleration models.
+ *      140307    S. Vermeer        Added tracing of state derivative evaluations and acceleration
+ *                                  updates.
+ *      140401    S. Vermeer        Rebuilt tasks for task pool if bound to a different object, such
+ *                                  that copies are evaluated correctly.
+ *      140401    S. Vermeer        Made profiling of acceleration models optional, since it
+ *                                  requires Boost.Chrono.
+ *      140415    S. Vermeer        Declared profiler independent of build options; profiling is
+ *                                  enabled by setting a profiler.
  *
  *    References
  *
@@ -50,22 +60,44 @@
  *      functions so that there are not function table lookups performed. This can be improved in
  *      future perhaps by making use of the Boost::Lambda library.
  *
+ *      If a ParallelTaskPool is set, the acceleration models (including their frame
+ *      transformations) are evaluated concurrently. This requires that the updateMembers() and
+ *      getAcceleration() functions of different acceleration models can be safely called
+ *      concurrently, i.e., that the acceleration models only read shared data (such as the data
+ *      repository updated by the update function, which is called before the concurrent
+ *      evaluation). The accelerations are summed in the order of the list after all models have
+ *      been evaluated, so that the computed state derivative is identical to that computed
+ *      without a task pool. The tasks executed on the task pool are bound to the object that
+ *      creates them; a copy of a state derivative model therefore rebuilds its tasks upon its
+ *      first concurrent evaluation.
+ *
+ *      Profiling of the acceleration models is only performed if a profiler is set. The
+ *      AccelerationModelProfiler class requires Boost.Chrono, and is therefore only built if the
+ *      CMake option TUDAT_ENABLE_ACCELERATION_MODEL_PROFILER is set and the Boost chrono
+ *      component is found. The declaration of this class does not depend on this option.
+ *
  */
 
 #ifndef TUDAT_CARTESIAN_STATE_DERIVATIVE_MODEL_H
 #define TUDAT_CARTESIAN_STATE_DERIVATIVE_MODEL_H
 
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <Eigen/Core>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/accelerationModelProfiler.h"
 #include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Basics/tracing.h"
 #include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 
 namespace tudat
@@ -197,7 +229,8 @@ public:
                                    anIndependentVariableAndStateUpdateFunction )
         : listOfAccelerationFrameTransformationPairs(
               aListOfAccelerationFrameTransformationPairs ),
-          updateIndependentVariableAndState( anIndependentVariableAndStateUpdateFunction )
+          updateIndependentVariableAndState( anIndependentVariableAndStateUpdateFunction ),
+          accelerationTasksObject( NULL )
     { }
 
     //! Compute Cartesian state derivative.
@@ -212,10 +245,69 @@ public:
             const IndependentVariableType independentVariable,
             const CartesianStateType& cartesianState );
 
+    //! Set task pool for concurrent evaluation of acceleration models.
+    /*!
+     * Sets the task pool on which the acceleration models are evaluated concurrently by
+     * computeStateDerivative(). The same task pool can be shared by multiple state derivative
+     * models, as long as these are not evaluated concurrently. Setting a NULL pointer (default)
+     * results in serial evaluation of the acceleration models.
+     * \param aTaskPool Shared-pointer to task pool.
+     */
+    void setParallelTaskPool( const basics::ParallelTaskPoolPointer aTaskPool )
+    {
+        taskPool = aTaskPool;
+    }
+
+    //! Set profiler of acceleration models.
+    /*!
+     * Sets the profiler to which the execution times of updateMembers() and getAcceleration()
+     * (including frame transformations), and the magnitude of the (transformed) acceleration, of
+     * each acceleration model are added at each evaluation. Setting a NULL pointer (default)
+     * disables profiling. An exception is thrown if the number of acceleration models of the
+     * profiler differs from that of this state derivative model.
+     * \param aProfiler Shared-pointer to acceleration model profiler.
+     */
+    void setAccelerationModelProfiler( const AccelerationModelProfilerPointer aProfiler )
+    {
+        if ( aProfiler && aProfiler->getNumberOfAccelerationModels( )
+             != listOfAccelerationFrameTransformationPairs.size( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Number of acceleration models of profiler is "
+                                                "inconsistent with state derivative model." ) ) );
+        }
+
+        profiler = aProfiler;
+    }
+
 protected:
 
 private:
 
+    //! Compute transformed acceleration of single acceleration model.
+    /*!
+     * Updates the members of the acceleration model with given index, computes its acceleration
+     * and applies the associated frame transformations. If a profiler is set, the execution
+     * times and acceleration magnitude are added to it.
+     * \param accelerationIndex Index of acceleration model in list of acceleration models.
+     * \return Transformed acceleration.
+     */
+    AccelerationType computeTransformedAcceleration( const unsigned int accelerationIndex );
+
+    //! Compute and store transformed acceleration of single acceleration model.
+    /*!
+     * Computes the transformed acceleration of the acceleration model with given index, and stores
+     * the result in the list of current accelerations. This function is executed as task on the
+     * task pool.
+     * \param accelerationIndex Index of acceleration model in list of acceleration models.
+     */
+    void storeTransformedAcceleration( const unsigned int accelerationIndex )
+    {
+        currentAccelerations[ accelerationIndex ]
+                = computeTransformedAcceleration( accelerationIndex );
+    }
+
     //! List of acceleration model/frame transformation pairs.
     /*!
      * List of pairs of shared-pointers to acceleration model and associated lists of reference
@@ -231,6 +323,38 @@ private:
      * variable and state data to the current values.
      */
     const IndependentVariableAndStateUpdateFunction updateIndependentVariableAndState;
+
+    //! Shared-pointer to task pool for concurrent evaluation of acceleration models.
+    /*!
+     * Shared-pointer to task pool for concurrent evaluation of acceleration models. If NULL, the
+     * acceleration models are evaluated serially.
+     */
+    basics::ParallelTaskPoolPointer taskPool;
+
+    //! List of tasks computing the transformed accelerations, for execution on task pool.
+    /*!
+     * List of tasks computing the transformed accelerations, for execution on task pool. The
+     * tasks are bound to the object given by accelerationTasksObject.
+     */
+    std::vector< basics::ParallelTaskPool::Task > accelerationTasks;
+
+    //! Object to which the tasks computing the transformed accelerations are bound.
+    /*!
+     * Object to which the tasks computing the transformed accelerations are bound. If this differs
+     * from this object (e.g., because this object is a copy), the tasks are rebuilt before they
+     * are executed.
+     */
+    const CartesianStateDerivativeModel* accelerationTasksObject;
+
+    //! List of transformed accelerations computed by the tasks on the task pool.
+    std::vector< AccelerationType, Eigen::aligned_allocator< AccelerationType > >
+    currentAccelerations;
+
+    //! Shared-pointer to profiler of acceleration models.
+    /*!
+     * Shared-pointer to profiler of acceleration models. If NULL, no profiling is performed.
+     */
+    AccelerationModelProfilerPointer profiler;
 };
 
 //! Constructor taking list of acceleration models, and pointer to a function to update independent
@@ -242,7 +366,8 @@ AccelerationType, AccelerationModelType >::CartesianStateDerivativeModel(
         const AccelerationModelPointerVector& aListOfAccelerations,
         const IndependentVariableAndStateUpdateFunction
         anIndependentVariableAndStateUpdateFunction )
-    : updateIndependentVariableAndState( anIndependentVariableAndStateUpdateFunction )
+    : updateIndependentVariableAndState( anIndependentVariableAndStateUpdateFunction ),
+      accelerationTasksObject( NULL )
 {
     // Loop through list of acceleration models.
     for ( unsigned int i = 0; i < aListOfAccelerations.size( ); i++ )
@@ -267,6 +392,9 @@ AccelerationType, AccelerationModelType >::computeStateDerivative(
         const IndependentVariableType independentVariable,
         const CartesianStateType& cartesianState )
 {
+    TUDAT_TRACE_SCOPE( "StateDerivativeModels",
+                       "CartesianStateDerivativeModel::computeStateDerivative" );
+
     // Update data.
     updateIndependentVariableAndState( independentVariable, cartesianState );
 
@@ -281,33 +409,91 @@ AccelerationType, AccelerationModelType >::computeStateDerivative(
     cartesianStateDerivative.segment( 0, stateDerivativeSize / 2 )
             = cartesianState.segment( stateDerivativeSize / 2, stateDerivativeSize / 2 );
 
-    // Loop through list of acceleration/frame transformation pairs.
-    for ( unsigned int i = 0; i < listOfAccelerationFrameTransformationPairs.size( ); i++ )
+    // Evaluate acceleration models concurrently, if task pool is set.
+    if ( taskPool )
     {
-        // Update class members for current acceleration model.
-        listOfAccelerationFrameTransformationPairs.at( i ).first->updateMembers( );
+        // Create tasks upon first concurrent evaluation, or if the tasks are bound to a different
+        // object (i.e., the object from which this object is copied).
+        if ( accelerationTasksObject != this
+             || accelerationTasks.size( ) != listOfAccelerationFrameTransformationPairs.size( ) )
+        {
+            accelerationTasks.clear( );
+            for ( unsigned int i = 0; i < listOfAccelerationFrameTransformationPairs.size( );
+                  i++ )
+            {
+                accelerationTasks.push_back(
+                            boost::bind( &CartesianStateDerivativeModel::
+                                         storeTransformedAcceleration, this, i ) );
+            }
+            currentAccelerations.resize( listOfAccelerationFrameTransformationPairs.size( ) );
+            accelerationTasksObject = this;
+        }
 
-        // Get acceleration for current acceleration model.
-        AccelerationType acceleration = listOfAccelerationFrameTransformationPairs.at( i )
-                .first->getAcceleration( );
+        taskPool->executeTasks( accelerationTasks );
 
-        // Loop througb list of frame transformations and apply to computed acceleration.
-        for ( unsigned j = 0;
-              j < listOfAccelerationFrameTransformationPairs.at( i ).second.size( ); j++ )
+        // Add transformed accelerations to state derivative, in order of list.
+        for ( unsigned int i = 0; i < currentAccelerations.size( ); i++ )
         {
-            acceleration = listOfAccelerationFrameTransformationPairs.at( i ).second.at( j )(
-                        acceleration );
+            cartesianStateDerivative.segment( stateDerivativeSize / 2, stateDerivativeSize / 2 )
+                    += currentAccelerations[ i ];
         }
 
-        // Add transformed acceleration to state derivative.
+        return cartesianStateDerivative;
+    }
+
+    // Loop through list of acceleration/frame transformation pairs, and add transformed
+    // accelerations to state derivative.
+    for ( unsigned int i = 0; i < listOfAccelerationFrameTransformationPairs.size( ); i++ )
+    {
         cartesianStateDerivative.segment( stateDerivativeSize / 2, stateDerivativeSize / 2 )
-                += acceleration;
+                += computeTransformedAcceleration( i );
     }
 
     // Return assembled state derivative.
     return cartesianStateDerivative;
 }
 
+//! Compute transformed acceleration of single acceleration model.
+template< typename IndependentVariableType, typename CartesianStateType, typename AccelerationType,
+          typename AccelerationModelType >
+AccelerationType CartesianStateDerivativeModel< IndependentVariableType, CartesianStateType,
+AccelerationType, AccelerationModelType >::computeTransformedAcceleration(
+        const unsigned int accelerationIndex )
+{
+    TUDAT_TRACE_SCOPE( "StateDerivativeModels",
+                       "CartesianStateDerivativeModel::computeTransformedAcceleration" );
+
+    const AccelerationFrameTransformationPair& accelerationFrameTransformationPair
+            = listOfAccelerationFrameTransformationPairs[ accelerationIndex ];
+
+    // Update class members for acceleration model.
+    const double startTime = profiler ? profiler->getCurrentTime( ) : 0.0;
+    {
+        TUDAT_TRACE_SCOPE( "StateDerivativeModels", "AccelerationModel::updateMembers" );
+        accelerationFrameTransformationPair.first->updateMembers( );
+    }
+    const double updateEndTime = profiler ? profiler->getCurrentTime( ) : 0.0;
+
+    // Get acceleration for acceleration model.
+    AccelerationType acceleration = accelerationFrameTransformationPair.first->getAcceleration( );
+
+    // Loop through list of frame transformations and apply to computed acceleration.
+    for ( unsigned j = 0; j < accelerationFrameTransformationPair.second.size( ); j++ )
+    {
+        acceleration = accelerationFrameTransformationPair.second[ j ]( acceleration );
+    }
+
+    // Add execution times and acceleration magnitude to profiler.
+    if ( profiler )
+    {
+        const double endTime = profiler->getCurrentTime( );
+        profiler->addSample( accelerationIndex, updateEndTime - startTime, endTime - updateEndTime,
+                             acceleration.norm( ) );
+    }
+
+    return acceleration;
+}
+
 //! Typedef for a 6D Cartesian state derivative model.
 typedef CartesianStateDerivativeModel< > CartesianStateDerivativeModel6d;
 
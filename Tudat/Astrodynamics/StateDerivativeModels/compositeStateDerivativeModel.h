@@ -28,6 +28,15 @@
  *      120817    K. Kumar          Completed Doxygen documentation.
  *      120913    K. Kumar          Rewrote class to work with generic matrices.
  *      140127    E. Brandon        Corrected doxygen documentation.
+ *      140217    S. Vermeer        Replaced map traversal by flattened list of part state
+ *                                  derivative models, built at construction; added preallocated
+ *                                  part states and state derivative.
+ *      140307    S. Vermeer        Added tracing of state derivative evaluations.
+ *      140401    S. Vermeer        Documented that computeStateDerivative() is not re-entrant and
+ *                                  that part state derivatives are still returned by value.
+ *      140415    S. Vermeer        Added part state derivative functions writing to preallocated
+ *                                  part state derivatives; stored composite state derivative as
+ *                                  member, such that copies do not share it.
  *
  *    References
  *
@@ -37,6 +46,19 @@
  *      are Eigen-specific. At present, these functions must be available in any other data types
  *      used.
  *
+ *      The state-derivative model map is converted to a flat list of part state derivative models
+ *      upon construction, which is traversed in the order of the map (i.e., sorted by block
+ *      indices). The part states and part state derivatives passed to the part state derivative
+ *      functions, and the composite state derivative, are stored in preallocated members, such
+ *      that this class does not allocate memory for them after the first evaluation. Part state
+ *      derivative functions can be given in two forms: functions that write the part state
+ *      derivative to a given (preallocated) part state derivative, which create no temporaries,
+ *      and functions that return the part state derivative by value, which create a temporary
+ *      (allocated on the heap for dynamically sized types) for each part at each evaluation. For
+ *      dynamically sized types, returning the composite state derivative by value also allocates
+ *      memory; this can be avoided by using the overload of computeStateDerivative() that writes
+ *      to a given state derivative.
+ *
  */
 
 #ifndef TUDAT_COMPOSITE_STATE_DERIVATIVE_MODEL_H
@@ -44,7 +66,9 @@
 
 #include <map>
 #include <utility>
+#include <vector>
 
+#include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
@@ -54,6 +78,7 @@
 #include <Eigen/Core>
 
 #include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
+#include "Tudat/Basics/tracing.h"
 
 namespace tudat
 {
@@ -68,7 +93,10 @@ namespace state_derivative_models
  * for instance, to numerically integrate the state of multiple satellites around a central body,
  * each subject to their own state-derivative model, or the state of a satellite and the associated
  * State Transition Matrix. The class has been set up in a general fashion such that it can be used
- * in many other simulation scenarios too.
+ * in many other simulation scenarios too. Since the part states and the composite state
+ * derivative are stored in members of this class, computeStateDerivative() is not re-entrant: it
+ * must not be called concurrently (e.g., from different threads) on the same object, nor from
+ * within the update function or a part state derivative function of the same object.
  * \tparam IndependentVariableType Data type for independent variable, e.g., time, (default is
  *          double).
  * \tparam CompositeStateType Data type for composite state (default is Eigen::MatrixXd).
@@ -107,8 +135,16 @@ private:
     typedef boost::function< PartStateDerivativeType(
             const IndependentVariableType, const PartStateType& ) > PartStateDerivativeFunction;
 
+    //! Typedef for a pointer to a function that evaluates the state derivative corresponding to a
+    //! part of the composite state derivative, and writes it to a given part state derivative.
+    typedef boost::function< void( const IndependentVariableType, const PartStateType&,
+                                   PartStateDerivativeType& ) > InPlacePartStateDerivativeFunction;
+
 public:
 
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     //! Typedef for state-derivative model map for matrix composite state.
     /*!
      * Typedef for state-derivative model map, that maps part states (matrices) in the composite
@@ -124,6 +160,26 @@ public:
     typedef std::map< StateSegmentIndices, PartStateDerivativeFunction >
     VectorStateDerivativeModelMap;
 
+    //! Typedef for in-place state-derivative model map for matrix composite state.
+    /*!
+     * Typedef for state-derivative model map, that maps part states (matrices) in the composite
+     * state matrix to the associated state derivative functions, which write the part state
+     * derivative to a given part state derivative. The given part state derivative is
+     * preallocated with the size of the part state.
+     */
+    typedef std::map< StateBlockIndices, InPlacePartStateDerivativeFunction >
+    InPlaceStateDerivativeModelMap;
+
+    //! Typedef for in-place state-derivative model map for vector composite state.
+    /*!
+     * Typedef for state-derivative model map, that maps part states (vectors) in the composite
+     * state vector to the associated state derivative functions, which write the part state
+     * derivative to a given part state derivative. The given part state derivative is
+     * preallocated with the size of the part state.
+     */
+    typedef std::map< StateSegmentIndices, InPlacePartStateDerivativeFunction >
+    InPlaceVectorStateDerivativeModelMap;
+
     //! Constructor taking a state-derivative model map (matrix) and an update function.
     /*!
      * Constructor taking a state-derivative model map, that maps part states (matrices) in the
@@ -139,9 +195,11 @@ public:
     CompositeStateDerivativeModel( const StateDerivativeModelMap& aStateDerivativeModelMap,
                                    const IndependentVariableAndStateUpdateFunction
                                    anUpdateIndependentVariableAndStateFunction )
-        : stateDerivativeModelMap( aStateDerivativeModelMap ),
-          updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
-    { }
+        : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
+    {
+        setPartStateDerivativeModels( convertToInPlaceStateDerivativeModelMap(
+                                          aStateDerivativeModelMap ) );
+    }
 
     //! Constructor taking a state-derivative model map (vector) and an update function.
     /*!
@@ -158,7 +216,56 @@ public:
     CompositeStateDerivativeModel( const VectorStateDerivativeModelMap&
                                    aVectorStateDerivativeModelMap,
                                    const IndependentVariableAndStateUpdateFunction
-                                   anUpdateIndependentVariableAndStateFunction );
+                                   anUpdateIndependentVariableAndStateFunction )
+        : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
+    {
+        setPartStateDerivativeModels( convertToInPlaceStateDerivativeModelMap(
+                                          convertToBlockIndices(
+                                              aVectorStateDerivativeModelMap ) ) );
+    }
+
+    //! Constructor taking an in-place state-derivative model map (matrix) and an update function.
+    /*!
+     * Constructor taking a state-derivative model map, that maps part states (matrices) in the
+     * composite state matrix with associated state derivative functions, which write the part
+     * state derivative to a given part state derivative, and an update function that updates the
+     * values of the independent variable and the composite state, as well as any dependent
+     * variables not included in the state, in the data repository created externally by the user.
+     * \param anInPlaceStateDerivativeModelMap An in-place state derivative model map for
+     *          matrix-based composite states.
+     * \param anUpdateIndependentVariableAndStateFunction A function to update the independent
+     *          variable and composite state in the user's data repository.
+     */
+    CompositeStateDerivativeModel( const InPlaceStateDerivativeModelMap&
+                                   anInPlaceStateDerivativeModelMap,
+                                   const IndependentVariableAndStateUpdateFunction
+                                   anUpdateIndependentVariableAndStateFunction )
+        : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
+    {
+        setPartStateDerivativeModels( anInPlaceStateDerivativeModelMap );
+    }
+
+    //! Constructor taking an in-place state-derivative model map (vector) and an update function.
+    /*!
+     * Constructor taking a state-derivative model map, that maps part states (vectors) in the
+     * composite state vector with associated state derivative functions, which write the part
+     * state derivative to a given part state derivative, and an update function that updates the
+     * values of the independent variable and the composite state, as well as any dependent
+     * variables not included in the state, in the data repository created externally by the user.
+     * \param anInPlaceVectorStateDerivativeModelMap An in-place state derivative model map for
+     *          vector-based composite states.
+     * \param anUpdateIndependentVariableAndStateFunction A function to update the independent
+     *          variable and composite state in the user's data repository.
+     */
+    CompositeStateDerivativeModel( const InPlaceVectorStateDerivativeModelMap&
+                                   anInPlaceVectorStateDerivativeModelMap,
+                                   const IndependentVariableAndStateUpdateFunction
+                                   anUpdateIndependentVariableAndStateFunction )
+        : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
+    {
+        setPartStateDerivativeModels( convertToBlockIndices(
+                                          anInPlaceVectorStateDerivativeModelMap ) );
+    }
 
     //! Compute state derivative.
     /*!
@@ -173,16 +280,128 @@ public:
             const IndependentVariableType independentVariable,
             const CompositeStateType& compositeState );
 
+    //! Compute state derivative, writing to given state derivative.
+    /*!
+     * Computes the state derivative based on the state-derivative model map provided through the
+     * constructor, and writes it to the given composite state derivative, which is only resized
+     * if its size differs from that of the composite state.
+     * \param independentVariable Current independent variable value.
+     * \param compositeState Current composite state.
+     * \param compositeStateDerivative Composite state derivative (returned by reference).
+     */
+    void computeStateDerivative( const IndependentVariableType independentVariable,
+                                 const CompositeStateType& compositeState,
+                                 CompositeStateDerivativeType& compositeStateDerivative );
+
 protected:
 
 private:
 
-    //! State-derivative model map.
+    //! Part state derivative model.
     /*!
-     * State-derivative model map that maps part states in the composite state with associated
-     * state derivative models.
+     * Part state derivative model, holding the block indices of the part state in the composite
+     * state and the associated state derivative function.
      */
-    StateDerivativeModelMap stateDerivativeModelMap;
+    struct PartStateDerivativeModel
+    {
+        //! Start row of part state in composite state.
+        unsigned int startRow;
+
+        //! Start column of part state in composite state.
+        unsigned int startColumn;
+
+        //! Number of rows of part state.
+        unsigned int numberOfRows;
+
+        //! Number of columns of part state.
+        unsigned int numberOfColumns;
+
+        //! Function computing the part state derivative, writing it to given part state
+        //! derivative.
+        InPlacePartStateDerivativeFunction computePartStateDerivative;
+    };
+
+    //! Convert state-derivative model map from segment indices to block indices.
+    /*!
+     * Converts a state-derivative model map for vector-based composite states, indexed by segment
+     * indices, to one for matrix-based composite states, indexed by block indices.
+     * \tparam FunctionType Type of part state derivative function.
+     * \param aVectorStateDerivativeModelMap A state derivative model map for vector-based
+     *          composite states.
+     * \return State derivative model map for matrix-based composite states.
+     */
+    template< typename FunctionType >
+    static std::map< StateBlockIndices, FunctionType > convertToBlockIndices(
+            const std::map< StateSegmentIndices, FunctionType >& aVectorStateDerivativeModelMap );
+
+    //! Convert state-derivative model map to in-place state-derivative model map.
+    /*!
+     * Converts a state-derivative model map with part state derivative functions that return
+     * their part state derivatives by value to one with functions that write them to a given
+     * part state derivative.
+     * \param aStateDerivativeModelMap A state derivative model map for matrix-based composite
+     *          states.
+     * \return In-place state derivative model map for matrix-based composite states.
+     */
+    static InPlaceStateDerivativeModelMap convertToInPlaceStateDerivativeModelMap(
+            const StateDerivativeModelMap& aStateDerivativeModelMap );
+
+    //! Assign part state derivative returned by value to given part state derivative.
+    /*!
+     * Evaluates a part state derivative function that returns its part state derivative by
+     * value, and assigns the result to the given part state derivative.
+     * \param computePartStateDerivative Function computing the part state derivative.
+     * \param independentVariable Current independent variable value.
+     * \param partState Current part state.
+     * \param partStateDerivative Part state derivative (returned by reference).
+     */
+    static void assignPartStateDerivative(
+            const PartStateDerivativeFunction& computePartStateDerivative,
+            const IndependentVariableType independentVariable, const PartStateType& partState,
+            PartStateDerivativeType& partStateDerivative )
+    {
+        partStateDerivative = computePartStateDerivative( independentVariable, partState );
+    }
+
+    //! Set part state derivative models.
+    /*!
+     * Converts the in-place state-derivative model map to the flat list of part state derivative
+     * models, and preallocates the associated part states and part state derivatives.
+     * \param anInPlaceStateDerivativeModelMap An in-place state derivative model map for
+     *          matrix-based composite states.
+     */
+    void setPartStateDerivativeModels(
+            const InPlaceStateDerivativeModelMap& anInPlaceStateDerivativeModelMap );
+
+    //! List of part state derivative models.
+    /*!
+     * List of part state derivative models, in the order of the state-derivative model map
+     * provided through the constructor.
+     */
+    std::vector< PartStateDerivativeModel > partStateDerivativeModels;
+
+    //! Preallocated part states.
+    /*!
+     * Part states passed to the part state derivative functions, preallocated to avoid memory
+     * allocation for dynamically sized part states at each evaluation.
+     */
+    std::vector< PartStateType, Eigen::aligned_allocator< PartStateType > > partStates;
+
+    //! Preallocated part state derivatives.
+    /*!
+     * Part state derivatives written by the part state derivative functions, preallocated to
+     * avoid memory allocation for dynamically sized part states at each evaluation.
+     */
+    std::vector< PartStateDerivativeType, Eigen::aligned_allocator< PartStateDerivativeType > >
+    partStateDerivatives;
+
+    //! Preallocated composite state derivative.
+    /*!
+     * Composite state derivative, preallocated to avoid memory allocation for dynamically sized
+     * composite states at each evaluation. Since it is held by value, copies of this object
+     * each have their own composite state derivative.
+     */
+    CompositeStateDerivativeType currentCompositeStateDerivative;
 
     //! Pointer to update function.
     /*!
@@ -192,17 +411,19 @@ private:
     const IndependentVariableAndStateUpdateFunction updateIndependentVariableAndState;
 };
 
-//! Constructor taking a state-derivative model map (vector) and an update function.
+//! Convert state-derivative model map from segment indices to block indices.
 template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
-CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, PartStateType >::
-CompositeStateDerivativeModel( const VectorStateDerivativeModelMap& aVectorStateDerivativeModelMap,
-                               const IndependentVariableAndStateUpdateFunction
-                               anUpdateIndependentVariableAndStateFunction )
-    : updateIndependentVariableAndState( anUpdateIndependentVariableAndStateFunction )
+template< typename FunctionType >
+std::map< typename CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType,
+PartStateType >::StateBlockIndices, FunctionType > CompositeStateDerivativeModel<
+IndependentVariableType, CompositeStateType, PartStateType >::convertToBlockIndices(
+        const std::map< StateSegmentIndices, FunctionType >& aVectorStateDerivativeModelMap )
 {
+    std::map< StateBlockIndices, FunctionType > stateDerivativeModelMap;
+
     // Loop through vector state derivative model map and copy to matrix state derivative model
     // map.
-    for ( typename VectorStateDerivativeModelMap::const_iterator
+    for ( typename std::map< StateSegmentIndices, FunctionType >::const_iterator
           iteratorVectorStateDerivativeModelMap = aVectorStateDerivativeModelMap.begin( );
           iteratorVectorStateDerivativeModelMap != aVectorStateDerivativeModelMap.end( );
           iteratorVectorStateDerivativeModelMap++ )
@@ -213,6 +434,32 @@ CompositeStateDerivativeModel( const VectorStateDerivativeModelMap& aVectorState
                     iteratorVectorStateDerivativeModelMap->first.second, 1 ) ]
                 = iteratorVectorStateDerivativeModelMap->second;
     }
+
+    return stateDerivativeModelMap;
+}
+
+//! Convert state-derivative model map to in-place state-derivative model map.
+template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
+typename CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType,
+PartStateType >::InPlaceStateDerivativeModelMap CompositeStateDerivativeModel<
+IndependentVariableType, CompositeStateType, PartStateType >::
+convertToInPlaceStateDerivativeModelMap( const StateDerivativeModelMap& aStateDerivativeModelMap )
+{
+    InPlaceStateDerivativeModelMap inPlaceStateDerivativeModelMap;
+
+    // Loop through state derivative model map and wrap each part state derivative function in a
+    // function that assigns its result to the given part state derivative.
+    for ( typename StateDerivativeModelMap::const_iterator iteratorStateDerivativeModels
+          = aStateDerivativeModelMap.begin( );
+          iteratorStateDerivativeModels != aStateDerivativeModelMap.end( );
+          iteratorStateDerivativeModels++ )
+    {
+        inPlaceStateDerivativeModelMap[ iteratorStateDerivativeModels->first ]
+                = boost::bind( &CompositeStateDerivativeModel::assignPartStateDerivative,
+                               iteratorStateDerivativeModels->second, _1, _2, _3 );
+    }
+
+    return inPlaceStateDerivativeModelMap;
 }
 
 //! Compute state derivative.
@@ -221,37 +468,82 @@ CompositeStateType CompositeStateDerivativeModel< IndependentVariableType, Compo
 PartStateType >::computeStateDerivative( const IndependentVariableType independentVariable,
                                          const CompositeStateType& compositeState )
 {
+    // Compute composite state derivative in preallocated member and return it.
+    computeStateDerivative( independentVariable, compositeState,
+                            currentCompositeStateDerivative );
+    return currentCompositeStateDerivative;
+}
+
+//! Compute state derivative, writing to given state derivative.
+template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
+void CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, PartStateType >::
+computeStateDerivative( const IndependentVariableType independentVariable,
+                        const CompositeStateType& compositeState,
+                        CompositeStateDerivativeType& compositeStateDerivative )
+{
+    TUDAT_TRACE_SCOPE( "StateDerivativeModels",
+                       "CompositeStateDerivativeModel::computeStateDerivative" );
+
     // Update to current data.
     updateIndependentVariableAndState( independentVariable, compositeState );
 
-    // Declare composite state derivative to be the same size as the composite state.
-    CompositeStateType compositeStateDerivative
-            = CompositeStateType::Zero( compositeState.rows( ), compositeState.cols( ) );
+    // Set composite state derivative to zero, resizing it only if its size differs from that of
+    // the composite state.
+    if ( compositeStateDerivative.rows( ) != compositeState.rows( )
+         || compositeStateDerivative.cols( ) != compositeState.cols( ) )
+    {
+        compositeStateDerivative.resize( compositeState.rows( ), compositeState.cols( ) );
+    }
+    compositeStateDerivative.setZero( );
 
-    // Loop through the state-derivative model map and compute the elements of the composite
-    // state derivative.
-    for ( typename StateDerivativeModelMap::const_iterator iteratorStateDerivativeModels
-          = stateDerivativeModelMap.begin( );
-          iteratorStateDerivativeModels != stateDerivativeModelMap.end( );
-          iteratorStateDerivativeModels++ )
+    // Loop through the list of part state derivative models and compute the elements of the
+    // composite state derivative.
+    for ( unsigned int i = 0; i < partStateDerivativeModels.size( ); i++ )
     {
-        // Set block indices for part state derivative.
-        unsigned int startRow = boost::get< 0 >( iteratorStateDerivativeModels->first );
-        unsigned int startColumn = boost::get< 1 >( iteratorStateDerivativeModels->first );
-        unsigned int numberOfRows = boost::get< 2 >( iteratorStateDerivativeModels->first );
-        unsigned int numberOfColumns = boost::get< 3 >( iteratorStateDerivativeModels->first );
-
-        // Compute the associated part in the composite state derivative based on the mapping
-        // provided.
-        compositeStateDerivative.block( startRow, startColumn, numberOfRows, numberOfColumns )
-                = iteratorStateDerivativeModels->second( independentVariable,
-                                                         compositeState.block(
-                                                             startRow, startColumn,
-                                                             numberOfRows, numberOfColumns ) );
+        const PartStateDerivativeModel& partModel = partStateDerivativeModels[ i ];
+
+        // Copy part state to preallocated part state.
+        partStates[ i ] = compositeState.block( partModel.startRow, partModel.startColumn,
+                                                partModel.numberOfRows,
+                                                partModel.numberOfColumns );
+
+        // Compute part state derivative in preallocated part state derivative, and copy it to the
+        // associated part in the composite state derivative.
+        partModel.computePartStateDerivative( independentVariable, partStates[ i ],
+                                              partStateDerivatives[ i ] );
+        compositeStateDerivative.block( partModel.startRow, partModel.startColumn,
+                                        partModel.numberOfRows, partModel.numberOfColumns )
+                = partStateDerivatives[ i ];
     }
+}
 
-    // Return the composite state derivative computed.
-    return compositeStateDerivative;
+//! Set part state derivative models.
+template< typename IndependentVariableType, typename CompositeStateType, typename PartStateType >
+void CompositeStateDerivativeModel< IndependentVariableType, CompositeStateType, PartStateType >::
+setPartStateDerivativeModels(
+        const InPlaceStateDerivativeModelMap& anInPlaceStateDerivativeModelMap )
+{
+    // Loop through the state-derivative model map and add the part state derivative models to
+    // the list, in the order of the map.
+    for ( typename InPlaceStateDerivativeModelMap::const_iterator iteratorStateDerivativeModels
+          = anInPlaceStateDerivativeModelMap.begin( );
+          iteratorStateDerivativeModels != anInPlaceStateDerivativeModelMap.end( );
+          iteratorStateDerivativeModels++ )
+    {
+        PartStateDerivativeModel partModel;
+        partModel.startRow = boost::get< 0 >( iteratorStateDerivativeModels->first );
+        partModel.startColumn = boost::get< 1 >( iteratorStateDerivativeModels->first );
+        partModel.numberOfRows = boost::get< 2 >( iteratorStateDerivativeModels->first );
+        partModel.numberOfColumns = boost::get< 3 >( iteratorStateDerivativeModels->first );
+        partModel.computePartStateDerivative = iteratorStateDerivativeModels->second;
+        partStateDerivativeModels.push_back( partModel );
+
+        // Preallocate part state and part state derivative of the required size.
+        PartStateType partState;
+        partState.resize( partModel.numberOfRows, partModel.numberOfColumns );
+        partStates.push_back( partState );
+        partStateDerivatives.push_back( partState );
+    }
 }
 
 //! Typedef for a composite state derivative model with independent-variable-type = double,
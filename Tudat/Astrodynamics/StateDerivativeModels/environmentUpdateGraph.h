@@ -0,0 +1,595 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140207    S. Vermeer        File created.
+ *      140307    S. Vermeer        Added tracing of environment updates.
+ *
+ *    References
+ *
+ *    Notes
+ *      The environment update graph is intended to be passed (through boost::bind) as the update
+ *      function of the CartesianStateDerivativeModel or CompositeStateDerivativeModel classes.
+ *      Acceleration models then retrieve body states, rotations, atmospheric properties etc.
+ *      through the functions returned by the graph, instead of each evaluating the (possibly
+ *      expensive, e.g., SPICE) underlying functions themselves. Each environment variable is
+ *      evaluated at most once per call to updateEnvironment(), and variables that depend only on
+ *      the independent variable are not re-evaluated when the integrator calls the state
+ *      derivative model multiple times at the same independent variable value.
+ *
+ *      Dependencies between environment variables are given by name when a variable is added.
+ *      The function returning a variable can be retrieved before the variable itself is added
+ *      (e.g., to bind it into the update function of a variable that depends on it), so that
+ *      variables can be added in any order. The update order is determined (and checked for
+ *      undefined variables and circular dependencies) on the first call to updateEnvironment()
+ *      after a variable has been added.
+ *
+ */
+
+#ifndef TUDAT_ENVIRONMENT_UPDATE_GRAPH_H
+#define TUDAT_ENVIRONMENT_UPDATE_GRAPH_H
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Basics/tracing.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Environment update graph class.
+/*!
+ * Templated class that holds a set of named environment variables (e.g., body states, rotations,
+ * atmospheric properties), which are computed from the current independent variable and state,
+ * and possibly from other environment variables. The variables are updated in dependency order,
+ * once per call to updateEnvironment(), and cached in between, such that any number of
+ * acceleration models can read them without re-evaluating the functions that compute them.
+ * Variables that are only a function of the independent variable (time-dependent variables) are
+ * only recomputed when the independent variable changes; variables that are a function of the
+ * state, or depend (directly or indirectly) on such a variable, are recomputed whenever the state
+ * changes.
+ * \tparam IndependentVariableType Data type for independent variable, e.g., time, (default is
+ *          double).
+ * \tparam StateType Data type for state (default is Eigen::Vector6d). This type must provide an
+ *          equality operator.
+ */
+template< typename IndependentVariableType = double,
+          typename StateType = basic_mathematics::Vector6d >
+class EnvironmentUpdateGraph
+{
+public:
+
+    //! Typedef for list of names of environment variables.
+    typedef std::vector< std::string > ListOfVariableNames;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, creates an empty graph.
+     */
+    EnvironmentUpdateGraph( )
+        : isUpdateOrderCurrent( true ),
+          isCacheValid( false )
+    { }
+
+    //! Add time-dependent environment variable.
+    /*!
+     * Adds an environment variable that is a function of the independent variable only (and
+     * possibly of other environment variables), such as the state of a body retrieved from an
+     * ephemeris.
+     * \param variableName Unique name of environment variable.
+     * \param updateFunction Function computing the environment variable from the independent
+     *          variable.
+     * \param dependencies Names of environment variables that are used by the update function,
+     *          which are updated before this variable (default empty).
+     * \return Function returning the current (cached) value of the environment variable.
+     */
+    template< typename VariableType >
+    boost::function< VariableType( ) > addTimeDependentVariable(
+            const std::string& variableName,
+            const boost::function< VariableType( const IndependentVariableType ) > updateFunction,
+            const ListOfVariableNames& dependencies = ListOfVariableNames( ) )
+    {
+        return addVariable< VariableType >(
+                    variableName, boost::bind( updateFunction, _1 ), dependencies, false );
+    }
+
+    //! Add state-dependent environment variable.
+    /*!
+     * Adds an environment variable that is a function of the independent variable and the state
+     * (and possibly of other environment variables), such as the atmospheric density at the
+     * current position.
+     * \param variableName Unique name of environment variable.
+     * \param updateFunction Function computing the environment variable from the independent
+     *          variable and state.
+     * \param dependencies Names of environment variables that are used by the update function,
+     *          which are updated before this variable (default empty).
+     * \return Function returning the current (cached) value of the environment variable.
+     */
+    template< typename VariableType >
+    boost::function< VariableType( ) > addStateDependentVariable(
+            const std::string& variableName,
+            const boost::function< VariableType( const IndependentVariableType,
+                                                 const StateType& ) > updateFunction,
+            const ListOfVariableNames& dependencies = ListOfVariableNames( ) )
+    {
+        return addVariable< VariableType >( variableName, updateFunction, dependencies, true );
+    }
+
+    //! Get function returning environment variable.
+    /*!
+     * Returns a function that returns the current (cached) value of the environment variable with
+     * the given name. If no variable of this name exists yet, a placeholder is created, which must
+     * be defined by addTimeDependentVariable() or addStateDependentVariable() before the next
+     * call to updateEnvironment(). An exception is thrown if the variable exists, but is not of
+     * the requested type.
+     * \param variableName Name of environment variable.
+     * \return Function returning the current (cached) value of the environment variable.
+     */
+    template< typename VariableType >
+    boost::function< VariableType( ) > getVariableFunction( const std::string& variableName )
+    {
+        return boost::bind( &EnvironmentVariable< VariableType >::getCurrentValue,
+                            getVariable< VariableType >( variableName ) );
+    }
+
+    //! Update environment.
+    /*!
+     * Updates all environment variables to the given independent variable and state, in
+     * dependency order. If the independent variable is equal to that of the previous update, only
+     * the state-dependent variables are updated, and only if the state has changed. This function
+     * can be passed (through boost::bind) as update function of a state derivative model.
+     * \param independentVariable Current independent variable value.
+     * \param state Current state.
+     */
+    void updateEnvironment( const IndependentVariableType independentVariable,
+                            const StateType& state )
+    {
+        TUDAT_TRACE_SCOPE( "StateDerivativeModels", "EnvironmentUpdateGraph::updateEnvironment" );
+
+        // Determine update order, if variables have been added since last update.
+        if ( !isUpdateOrderCurrent )
+        {
+            determineUpdateOrder( );
+        }
+
+        // Determine whether time-dependent variables need to be updated.
+        const bool updateTimeDependentVariables
+                = !isCacheValid || !( independentVariable == currentIndependentVariable );
+
+        // Return directly if nothing has changed since last update.
+        if ( !updateTimeDependentVariables && state == currentState )
+        {
+            return;
+        }
+
+        // Set current independent variable and state.
+        currentIndependentVariable = independentVariable;
+        currentState = state;
+
+        // Update variables in dependency order.
+        for ( unsigned int i = 0; i < updateOrder.size( ); i++ )
+        {
+            if ( updateTimeDependentVariables || updateOrder[ i ]->isStateDependent( ) )
+            {
+                updateOrder[ i ]->update( currentIndependentVariable, currentState );
+            }
+        }
+
+        isCacheValid = true;
+    }
+
+    //! Reset cache.
+    /*!
+     * Resets the cache, such that all environment variables are updated upon the next call to
+     * updateEnvironment(). This should be called when any of the update functions changes its
+     * output for an unchanged input, e.g., when an ephemeris is replaced.
+     */
+    void resetCache( ) { isCacheValid = false; }
+
+    //! Get current independent variable.
+    /*!
+     * Returns the independent variable value of the last update.
+     * \return Current independent variable.
+     */
+    IndependentVariableType getCurrentIndependentVariable( ) const
+    {
+        return currentIndependentVariable;
+    }
+
+    //! Get current state.
+    /*!
+     * Returns the state of the last update.
+     * \return Current state.
+     */
+    StateType getCurrentState( ) const { return currentState; }
+
+    //! Get number of environment variables.
+    /*!
+     * Returns the number of environment variables in the graph.
+     * \return Number of environment variables.
+     */
+    unsigned int getNumberOfVariables( ) const { return environmentVariables.size( ); }
+
+    //! Get update order.
+    /*!
+     * Returns the names of the environment variables in the order in which they are updated.
+     * \return Names of environment variables in update order.
+     */
+    ListOfVariableNames getUpdateOrder( )
+    {
+        if ( !isUpdateOrderCurrent )
+        {
+            determineUpdateOrder( );
+        }
+
+        ListOfVariableNames updateOrderNames;
+        for ( unsigned int i = 0; i < updateOrder.size( ); i++ )
+        {
+            updateOrderNames.push_back( updateOrder[ i ]->getName( ) );
+        }
+        return updateOrderNames;
+    }
+
+protected:
+
+private:
+
+    //! Base class for environment variable.
+    /*!
+     * Base class for (type-erased) environment variable, holding its name, dependencies and
+     * whether it is (directly or indirectly) state-dependent.
+     */
+    class EnvironmentVariableBase
+    {
+    public:
+
+        //! Constructor.
+        /*!
+         * Constructor, creates an undefined environment variable.
+         * \param aName Name of environment variable.
+         */
+        EnvironmentVariableBase( const std::string& aName )
+            : name( aName ),
+              defined( false ),
+              stateDependent( false )
+        { }
+
+        //! Default destructor.
+        virtual ~EnvironmentVariableBase( ) { }
+
+        //! Update environment variable.
+        /*!
+         * Recomputes the value of the environment variable.
+         * \param independentVariable Current independent variable value.
+         * \param state Current state.
+         */
+        virtual void update( const IndependentVariableType independentVariable,
+                             const StateType& state ) = 0;
+
+        //! Get name of environment variable.
+        const std::string& getName( ) const { return name; }
+
+        //! Get whether update function of environment variable has been set.
+        bool isDefined( ) const { return defined; }
+
+        //! Get names of environment variables this variable depends on.
+        const ListOfVariableNames& getDependencies( ) const { return dependencies; }
+
+        //! Get whether variable needs to be updated when the state changes.
+        bool isStateDependent( ) const { return stateDependent; }
+
+        //! Set that variable needs to be updated when the state changes.
+        void setStateDependent( ) { stateDependent = true; }
+
+    private:
+
+        //! Name of environment variable.
+        const std::string name;
+
+    protected:
+
+        //! Flag indicating whether update function of environment variable has been set.
+        bool defined;
+
+        //! Names of environment variables this variable depends on.
+        ListOfVariableNames dependencies;
+
+    private:
+
+        //! Flag indicating whether variable needs to be updated when the state changes.
+        bool stateDependent;
+    };
+
+    //! Environment variable of a given type.
+    /*!
+     * Environment variable of a given type, holding the update function and cached value.
+     * \tparam VariableType Data type of environment variable.
+     */
+    template< typename VariableType >
+    class EnvironmentVariable : public EnvironmentVariableBase
+    {
+    public:
+
+        //! Typedef for function computing the environment variable.
+        typedef boost::function< VariableType( const IndependentVariableType,
+                                               const StateType& ) > UpdateFunction;
+
+        //! Constructor.
+        /*!
+         * Constructor, creates an undefined environment variable.
+         * \param aName Name of environment variable.
+         */
+        EnvironmentVariable( const std::string& aName )
+            : EnvironmentVariableBase( aName ),
+              currentValue( )
+        { }
+
+        //! Define environment variable.
+        /*!
+         * Sets the function computing the environment variable and its dependencies.
+         * \param anUpdateFunction Function computing the environment variable.
+         * \param someDependencies Names of environment variables this variable depends on.
+         * \param isDirectlyStateDependent Flag indicating whether the variable is a function of
+         *          the state.
+         */
+        void define( const UpdateFunction anUpdateFunction,
+                     const ListOfVariableNames& someDependencies,
+                     const bool isDirectlyStateDependent )
+        {
+            updateFunction = anUpdateFunction;
+            this->dependencies = someDependencies;
+            this->defined = true;
+            if ( isDirectlyStateDependent )
+            {
+                this->setStateDependent( );
+            }
+        }
+
+        //! Update environment variable.
+        /*!
+         * Recomputes and caches the value of the environment variable.
+         * \param independentVariable Current independent variable value.
+         * \param state Current state.
+         */
+        void update( const IndependentVariableType independentVariable, const StateType& state )
+        {
+            currentValue = updateFunction( independentVariable, state );
+        }
+
+        //! Get current (cached) value of environment variable.
+        VariableType getCurrentValue( ) const { return currentValue; }
+
+    private:
+
+        //! Function computing the environment variable.
+        UpdateFunction updateFunction;
+
+        //! Current (cached) value of environment variable.
+        VariableType currentValue;
+    };
+
+    //! Typedef for shared-pointer to environment variable.
+    typedef boost::shared_ptr< EnvironmentVariableBase > EnvironmentVariablePointer;
+
+    //! Get environment variable.
+    /*!
+     * Returns environment variable of given name and type, creating an undefined variable if it
+     * does not exist yet. An exception is thrown if the variable is not of the requested type.
+     * \param variableName Name of environment variable.
+     * \return Environment variable.
+     */
+    template< typename VariableType >
+    boost::shared_ptr< EnvironmentVariable< VariableType > > getVariable(
+            const std::string& variableName )
+    {
+        typename std::map< std::string, EnvironmentVariablePointer >::const_iterator
+                variableIterator = environmentVariables.find( variableName );
+
+        // Create undefined variable if it does not exist yet.
+        if ( variableIterator == environmentVariables.end( ) )
+        {
+            boost::shared_ptr< EnvironmentVariable< VariableType > > newVariable
+                    = boost::make_shared< EnvironmentVariable< VariableType > >( variableName );
+            environmentVariables[ variableName ] = newVariable;
+            isUpdateOrderCurrent = false;
+            return newVariable;
+        }
+
+        // Check if variable is of requested type.
+        boost::shared_ptr< EnvironmentVariable< VariableType > > typedVariable
+                = boost::dynamic_pointer_cast< EnvironmentVariable< VariableType > >(
+                    variableIterator->second );
+        if ( !typedVariable )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Environment variable " + variableName
+                                                + " is not of requested type." ) ) );
+        }
+
+        return typedVariable;
+    }
+
+    //! Add environment variable.
+    /*!
+     * Adds environment variable to graph (or defines the placeholder created by
+     * getVariableFunction()), and flags that the update order needs to be redetermined. An
+     * exception is thrown if a variable of the same name has already been added.
+     * \param variableName Unique name of environment variable.
+     * \param updateFunction Function computing the environment variable.
+     * \param dependencies Names of environment variables this variable depends on.
+     * \param isStateDependent Flag indicating whether the variable is a function of the state.
+     * \return Function returning the current (cached) value of the environment variable.
+     */
+    template< typename VariableType >
+    boost::function< VariableType( ) > addVariable(
+            const std::string& variableName,
+            const typename EnvironmentVariable< VariableType >::UpdateFunction updateFunction,
+            const ListOfVariableNames& dependencies, const bool isStateDependent )
+    {
+        boost::shared_ptr< EnvironmentVariable< VariableType > > variable
+                = getVariable< VariableType >( variableName );
+
+        // Check if variable name is unique.
+        if ( variable->isDefined( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Environment variable " + variableName
+                                                + " already exists." ) ) );
+        }
+
+        variable->define( updateFunction, dependencies, isStateDependent );
+
+        isUpdateOrderCurrent = false;
+        isCacheValid = false;
+
+        return boost::bind( &EnvironmentVariable< VariableType >::getCurrentValue, variable );
+    }
+
+    //! Determine update order.
+    /*!
+     * Determines the order in which the environment variables are updated, such that each
+     * variable is updated after all variables it depends on (depth-first topological sort), and
+     * flags all variables that depend indirectly on the state as state-dependent. An exception is
+     * thrown if a variable (or dependency) has not been defined, or if a circular dependency is
+     * found.
+     */
+    void determineUpdateOrder( )
+    {
+        updateOrder.clear( );
+
+        // Set visiting status of all variables to unvisited (0); variables currently on the
+        // depth-first search stack are set to 1, and finished variables to 2.
+        std::map< std::string, int > visitingStatus;
+        for ( typename std::map< std::string, EnvironmentVariablePointer >::const_iterator
+              variableIterator = environmentVariables.begin( );
+              variableIterator != environmentVariables.end( ); variableIterator++ )
+        {
+            visitingStatus[ variableIterator->first ] = 0;
+        }
+
+        for ( typename std::map< std::string, EnvironmentVariablePointer >::const_iterator
+              variableIterator = environmentVariables.begin( );
+              variableIterator != environmentVariables.end( ); variableIterator++ )
+        {
+            addToUpdateOrder( variableIterator->first, visitingStatus );
+        }
+
+        isUpdateOrderCurrent = true;
+    }
+
+    //! Add variable and its dependencies to update order.
+    /*!
+     * Recursively adds all dependencies of given environment variable to the update order,
+     * followed by the variable itself.
+     * \param variableName Name of environment variable.
+     * \param visitingStatus Depth-first search status of each environment variable.
+     */
+    void addToUpdateOrder( const std::string& variableName,
+                           std::map< std::string, int >& visitingStatus )
+    {
+        if ( visitingStatus[ variableName ] == 2 )
+        {
+            return;
+        }
+        else if ( visitingStatus[ variableName ] == 1 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Circular dependency of environment variable "
+                                                + variableName + "." ) ) );
+        }
+
+        // Check if variable exists and has been defined.
+        if ( environmentVariables.count( variableName ) == 0
+             || !environmentVariables[ variableName ]->isDefined( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Environment variable " + variableName
+                                                + " is used, but has not been defined." ) ) );
+        }
+
+        visitingStatus[ variableName ] = 1;
+
+        const EnvironmentVariablePointer variable = environmentVariables[ variableName ];
+        const ListOfVariableNames& dependencies = variable->getDependencies( );
+        for ( unsigned int i = 0; i < dependencies.size( ); i++ )
+        {
+
+            addToUpdateOrder( dependencies[ i ], visitingStatus );
+
+            // Variable must be updated with the state if any of its dependencies is.
+            if ( environmentVariables[ dependencies[ i ] ]->isStateDependent( ) )
+            {
+                variable->setStateDependent( );
+            }
+        }
+
+        visitingStatus[ variableName ] = 2;
+        updateOrder.push_back( variable );
+    }
+
+    //! Map of environment variables, with their names as keys.
+    std::map< std::string, EnvironmentVariablePointer > environmentVariables;
+
+    //! List of environment variables in update order.
+    std::vector< EnvironmentVariablePointer > updateOrder;
+
+    //! Flag indicating whether update order is consistent with current environment variables.
+    bool isUpdateOrderCurrent;
+
+    //! Flag indicating whether cached environment variables are valid.
+    bool isCacheValid;
+
+    //! Independent variable value of last update.
+    IndependentVariableType currentIndependentVariable;
+
+    //! State of last update.
+    StateType currentState;
+};
+
+//! Typedef for environment update graph for 6D Cartesian state.
+typedef EnvironmentUpdateGraph< > EnvironmentUpdateGraph6d;
+
+//! Typedef for shared-pointer to EnvironmentUpdateGraph6d object.
+typedef boost::shared_ptr< EnvironmentUpdateGraph6d > EnvironmentUpdateGraph6dPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_ENVIRONMENT_UPDATE_GRAPH_H
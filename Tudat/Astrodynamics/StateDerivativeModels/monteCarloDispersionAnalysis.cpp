@@ -0,0 +1,288 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140303    S. Vermeer        File created.
+ *
+ *    References
+ *      Welford, B.P. Note on a method for calculating corrected sums of squares and products,
+ *          Technometrics, 4(3), 419-420, 1962.
+ *
+ *    Notes
+ *
+ */
+
+#include <exception>
+#include <iomanip>
+#include <limits>
+
+#include <boost/bind.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/monteCarloDispersionAnalysis.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Generate normally distributed dispersed inputs.
+DispersedInputsList generateNormallyDispersedInputs( const DispersedInputs& nominalInputs,
+                                                     const DispersedInputs& standardDeviations,
+                                                     const unsigned int numberOfSamples,
+                                                     const unsigned int seed )
+{
+    // Create generator of standard normally distributed numbers.
+    boost::mt19937 randomNumberGenerator( seed );
+    boost::variate_generator< boost::mt19937&, boost::normal_distribution< > >
+            generateStandardNormalNumber( randomNumberGenerator,
+                                          boost::normal_distribution< >( 0.0, 1.0 ) );
+
+    // Draw dispersed inputs, in fixed order of the elements.
+    DispersedInputsList dispersedInputsList;
+    dispersedInputsList.reserve( numberOfSamples );
+    for ( unsigned int i = 0; i < numberOfSamples; i++ )
+    {
+        DispersedInputs dispersedInputs = nominalInputs;
+        for ( int j = 0; j < 6; j++ )
+        {
+            dispersedInputs.initialState( j ) += standardDeviations.initialState( j )
+                    * generateStandardNormalNumber( );
+        }
+        dispersedInputs.dragArea += standardDeviations.dragArea * generateStandardNormalNumber( );
+        dispersedInputs.radiationPressureCoefficient +=
+                standardDeviations.radiationPressureCoefficient * generateStandardNormalNumber( );
+        dispersedInputs.atmosphericDensityScalingFactor +=
+                standardDeviations.atmosphericDensityScalingFactor
+                * generateStandardNormalNumber( );
+
+        dispersedInputsList.push_back( dispersedInputs );
+    }
+
+    return dispersedInputsList;
+}
+
+//! Constructor.
+MonteCarloDispersionAnalysis::MonteCarloDispersionAnalysis(
+        const DispersedPropagationModelFactory& aPropagationModelFactory,
+        const DispersionPropagationSettings& somePropagationSettings,
+        const basics::ParallelTaskPoolPointer aTaskPool )
+    : propagationModelFactory( aPropagationModelFactory ),
+      propagationSettings( somePropagationSettings ),
+      taskPool( aTaskPool ),
+      currentDispersedInputsList( NULL ),
+      currentOutputStream( NULL ),
+      nextSampleIndex( 0 ),
+      numberOfSamples( 0 ),
+      numberOfFailedSamples( 0 ),
+      meanFinalState( basic_mathematics::Vector6d::Zero( ) ),
+      sumOfFinalStateDeviationProducts( basic_mathematics::Matrix6d::Zero( ) )
+{ }
+
+//! Perform analysis.
+void MonteCarloDispersionAnalysis::performAnalysis(
+        const DispersedInputsList& dispersedInputsList, std::ostream* outputStream )
+{
+    // Create propagation models of workers upon first analysis.
+    if ( workerPropagationModels.size( ) != getNumberOfWorkers( ) )
+    {
+        workerPropagationModels.clear( );
+        for ( unsigned int i = 0; i < getNumberOfWorkers( ); i++ )
+        {
+            workerPropagationModels.push_back( propagationModelFactory( ) );
+        }
+    }
+
+    // Reset analysis.
+    currentDispersedInputsList = &dispersedInputsList;
+    currentOutputStream = outputStream;
+    nextSampleIndex = 0;
+    bufferedSampleResults.clear( );
+    numberOfSamples = 0;
+    numberOfFailedSamples = 0;
+    meanFinalState.setZero( );
+    sumOfFinalStateDeviationProducts.setZero( );
+
+    if ( currentOutputStream != NULL )
+    {
+        *currentOutputStream << std::setprecision( std::numeric_limits< double >::digits10 + 2 );
+    }
+
+    // Run workers, concurrently if task pool is set.
+    if ( taskPool )
+    {
+        std::vector< basics::ParallelTaskPool::Task > workerTasks;
+        for ( unsigned int i = 0; i < getNumberOfWorkers( ); i++ )
+        {
+            workerTasks.push_back( boost::bind( &MonteCarloDispersionAnalysis::runWorker,
+                                                this, i ) );
+        }
+        taskPool->executeTasks( workerTasks );
+    }
+
+    else
+    {
+        runWorker( 0 );
+    }
+
+    currentDispersedInputsList = NULL;
+    currentOutputStream = NULL;
+}
+
+//! Propagate single sample.
+DispersionSampleResult MonteCarloDispersionAnalysis::propagateSample(
+        const DispersedPropagationModelPointer propagationModel,
+        const DispersedInputs& dispersedInputs ) const
+{
+    using numerical_integrators::RungeKuttaCoefficients;
+    using numerical_integrators::RungeKuttaVariableStepSizeIntegrator;
+
+    DispersionSampleResult sampleResult;
+
+    // Create integrator.
+    RungeKuttaVariableStepSizeIntegrator< double, basic_mathematics::Vector6d > integrator(
+                RungeKuttaCoefficients::get( propagationSettings.coefficientSet ),
+                boost::bind( &DispersedPropagationModel::computeStateDerivative,
+                             propagationModel, _1, _2 ),
+                propagationSettings.initialTime, dispersedInputs.initialState,
+                propagationSettings.minimumStepSize, propagationSettings.maximumStepSize,
+                propagationSettings.relativeErrorTolerance,
+                propagationSettings.absoluteErrorTolerance );
+
+    // Set dispersed inputs to propagation model, and propagate to final time; a failed
+    // propagation is recorded with the state at which it failed.
+    try
+    {
+        propagationModel->setDispersedInputs( dispersedInputs );
+        integrator.integrateTo( propagationSettings.finalTime,
+                                propagationSettings.initialStepSize );
+        sampleResult.isPropagationSuccessful = true;
+    }
+
+    catch ( std::exception& )
+    {
+        sampleResult.isPropagationSuccessful = false;
+    }
+
+    sampleResult.finalTime = integrator.getCurrentIndependentVariable( );
+    sampleResult.finalState = integrator.getCurrentState( );
+
+    return sampleResult;
+}
+
+//! Get sample covariance of final state.
+basic_mathematics::Matrix6d MonteCarloDispersionAnalysis::getFinalStateCovariance( ) const
+{
+    const unsigned int numberOfSuccessfulSamples = numberOfSamples - numberOfFailedSamples;
+    if ( numberOfSuccessfulSamples < 2 )
+    {
+        return basic_mathematics::Matrix6d::Zero( );
+    }
+
+    return sumOfFinalStateDeviationProducts / ( numberOfSuccessfulSamples - 1 );
+}
+
+//! Run worker.
+void MonteCarloDispersionAnalysis::runWorker( const unsigned int workerIndex )
+{
+    const DispersedPropagationModelPointer propagationModel
+            = workerPropagationModels[ workerIndex ];
+
+    while ( true )
+    {
+        // Claim next sample.
+        unsigned int sampleIndex;
+        {
+            boost::mutex::scoped_lock lock( sampleMutex );
+            if ( nextSampleIndex >= currentDispersedInputsList->size( ) )
+            {
+                return;
+            }
+            sampleIndex = nextSampleIndex++;
+        }
+
+        // Propagate sample.
+        DispersionSampleResult sampleResult = propagateSample(
+                    propagationModel, ( *currentDispersedInputsList )[ sampleIndex ] );
+        sampleResult.sampleIndex = sampleIndex;
+
+        processSampleResult( sampleResult );
+    }
+}
+
+//! Process result of sample.
+void MonteCarloDispersionAnalysis::processSampleResult(
+        const DispersionSampleResult& sampleResult )
+{
+    boost::mutex::scoped_lock lock( resultMutex );
+
+    bufferedSampleResults.insert( std::make_pair( sampleResult.sampleIndex, sampleResult ) );
+
+    // Process buffered results directly succeeding the last processed result.
+    SampleResultMap::iterator resultIterator = bufferedSampleResults.begin( );
+    while ( resultIterator != bufferedSampleResults.end( )
+            && resultIterator->first == numberOfSamples )
+    {
+        const DispersionSampleResult& currentResult = resultIterator->second;
+
+        // Write result.
+        if ( currentOutputStream != NULL )
+        {
+            *currentOutputStream << currentResult.sampleIndex << "\t"
+                                 << currentResult.isPropagationSuccessful << "\t"
+                                 << currentResult.finalTime;
+            for ( int i = 0; i < 6; i++ )
+            {
+                *currentOutputStream << "\t" << currentResult.finalState( i );
+            }
+            *currentOutputStream << "\n";
+        }
+
+        // Update statistics (Welford, 1962).
+        numberOfSamples++;
+        if ( currentResult.isPropagationSuccessful )
+        {
+            const unsigned int numberOfSuccessfulSamples = numberOfSamples - numberOfFailedSamples;
+            const basic_mathematics::Vector6d deviationFromPreviousMean
+                    = currentResult.finalState - meanFinalState;
+            meanFinalState += deviationFromPreviousMean / numberOfSuccessfulSamples;
+            sumOfFinalStateDeviationProducts += deviationFromPreviousMean
+                    * ( currentResult.finalState - meanFinalState ).transpose( );
+        }
+
+        else
+        {
+            numberOfFailedSamples++;
+        }
+
+        bufferedSampleResults.erase( resultIterator++ );
+    }
+}
+
+} // namespace state_derivative_models
+} // namespace tudat
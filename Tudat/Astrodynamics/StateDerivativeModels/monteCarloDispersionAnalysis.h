@@ -0,0 +1,430 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140303    S. Vermeer        File created.
+ *
+ *    References
+ *      Welford, B.P. Note on a method for calculating corrected sums of squares and products,
+ *          Technometrics, 4(3), 419-420, 1962.
+ *
+ *    Notes
+ *      The samples of a Monte Carlo dispersion analysis are propagated by a number of workers,
+ *      equal to the number of threads of the task pool. Each worker owns a propagation model,
+ *      created by the user-provided factory upon the first analysis, and reused for all samples
+ *      (and subsequent analyses) propagated by that worker. No mutable data should therefore be
+ *      shared between the propagation models created by the factory (e.g., atmosphere models with
+ *      cached look-up data, or spherical harmonics caches). The workers claim the samples one at a
+ *      time, so that the load is balanced dynamically between the workers regardless of the
+ *      propagation time of individual samples.
+ *
+ *      The results are written to the output stream, and added to the statistics, in order of the
+ *      sample index, as soon as all preceding samples have been completed. Only results that
+ *      cannot be written yet are buffered, and the output and statistics are identical regardless
+ *      of the number of threads used.
+ *
+ */
+
+#ifndef TUDAT_MONTE_CARLO_DISPERSION_ANALYSIS_H
+#define TUDAT_MONTE_CARLO_DISPERSION_ANALYSIS_H
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/parallelTaskPool.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Dispersed inputs of a single propagation.
+/*!
+ * Inputs of a single propagation that are dispersed in a Monte Carlo dispersion analysis.
+ */
+struct DispersedInputs
+{
+public:
+
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Constructor.
+    /*!
+     * Constructor taking the dispersed inputs.
+     * \param anInitialState Initial Cartesian state [m, m/s].
+     * \param aDragArea Reference area for aerodynamic drag [m^2].
+     * \param aRadiationPressureCoefficient Radiation pressure coefficient [-].
+     * \param anAtmosphericDensityScalingFactor Factor by which the atmospheric density is scaled
+     *          [-].
+     */
+    explicit DispersedInputs(
+            const basic_mathematics::Vector6d& anInitialState
+            = basic_mathematics::Vector6d::Zero( ),
+            const double aDragArea = 0.0,
+            const double aRadiationPressureCoefficient = 0.0,
+            const double anAtmosphericDensityScalingFactor = 1.0 )
+        : initialState( anInitialState ),
+          dragArea( aDragArea ),
+          radiationPressureCoefficient( aRadiationPressureCoefficient ),
+          atmosphericDensityScalingFactor( anAtmosphericDensityScalingFactor )
+    { }
+
+    //! Initial Cartesian state [m, m/s].
+    basic_mathematics::Vector6d initialState;
+
+    //! Reference area for aerodynamic drag [m^2].
+    double dragArea;
+
+    //! Radiation pressure coefficient [-].
+    double radiationPressureCoefficient;
+
+    //! Factor by which the atmospheric density is scaled [-].
+    double atmosphericDensityScalingFactor;
+};
+
+//! Typedef for list of dispersed inputs.
+typedef std::vector< DispersedInputs, Eigen::aligned_allocator< DispersedInputs > >
+DispersedInputsList;
+
+//! Generate normally distributed dispersed inputs.
+/*!
+ * Generates a list of dispersed inputs, of which each element (i.e., each initial state
+ * component, drag area, radiation pressure coefficient and atmospheric density scaling factor)
+ * is drawn independently from a normal distribution, with the given mean and standard deviation.
+ * The generated list depends only on the given seed.
+ * \param nominalInputs Nominal inputs (mean of distribution).
+ * \param standardDeviations Standard deviations of inputs.
+ * \param numberOfSamples Number of dispersed inputs to generate.
+ * \param seed Seed of random number generator.
+ * \return List of dispersed inputs.
+ */
+DispersedInputsList generateNormallyDispersedInputs( const DispersedInputs& nominalInputs,
+                                                     const DispersedInputs& standardDeviations,
+                                                     const unsigned int numberOfSamples,
+                                                     const unsigned int seed );
+
+//! Base class for propagation model of Monte Carlo dispersion analysis.
+/*!
+ * Base class for the propagation model used in a Monte Carlo dispersion analysis, consisting of
+ * a Cartesian state derivative model (with all associated acceleration and environment models),
+ * of which the dispersed inputs can be reset for each sample.
+ */
+class DispersedPropagationModel
+{
+public:
+
+    //! Default destructor.
+    virtual ~DispersedPropagationModel( ) { }
+
+    //! Set dispersed inputs.
+    /*!
+     * Sets the dispersed inputs of the sample to be propagated next. The initial state is set to
+     * the integrator by the analysis, but is provided here as well for completeness. If an
+     * exception is thrown (e.g., for invalid inputs), the sample is counted as failed.
+     * \param dispersedInputs Dispersed inputs of sample.
+     */
+    virtual void setDispersedInputs( const DispersedInputs& dispersedInputs ) = 0;
+
+    //! Compute state derivative.
+    /*!
+     * Computes the Cartesian state derivative, using the dispersed inputs set last.
+     * \param time Current time [s].
+     * \param cartesianState Current Cartesian state [m, m/s].
+     * \return Cartesian state derivative [m/s, m/s^2].
+     */
+    virtual basic_mathematics::Vector6d computeStateDerivative(
+            const double time, const basic_mathematics::Vector6d& cartesianState ) = 0;
+
+protected:
+
+private:
+};
+
+//! Typedef for shared-pointer to DispersedPropagationModel object.
+typedef boost::shared_ptr< DispersedPropagationModel > DispersedPropagationModelPointer;
+
+//! Typedef for factory function creating a propagation model for a single worker.
+typedef boost::function< DispersedPropagationModelPointer( ) > DispersedPropagationModelFactory;
+
+//! Propagation settings of Monte Carlo dispersion analysis.
+/*!
+ * Settings of the (variable step size Runge-Kutta) integrator with which each sample of a Monte
+ * Carlo dispersion analysis is propagated.
+ */
+struct DispersionPropagationSettings
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor taking the propagation settings.
+     * \param anInitialTime Initial time of propagation [s].
+     * \param aFinalTime Final time of propagation [s].
+     * \param anInitialStepSize Initial step size [s].
+     * \param aMinimumStepSize Minimum step size [s]; a sample for which this step size is
+     *          exceeded fails.
+     * \param aMaximumStepSize Maximum step size [s].
+     * \param aRelativeErrorTolerance Relative error tolerance.
+     * \param anAbsoluteErrorTolerance Absolute error tolerance.
+     * \param aCoefficientSet Runge-Kutta coefficient set (default is RKF78).
+     */
+    DispersionPropagationSettings(
+            const double anInitialTime, const double aFinalTime, const double anInitialStepSize,
+            const double aMinimumStepSize, const double aMaximumStepSize,
+            const double aRelativeErrorTolerance, const double anAbsoluteErrorTolerance,
+            const numerical_integrators::RungeKuttaCoefficients::CoefficientSets aCoefficientSet
+            = numerical_integrators::RungeKuttaCoefficients::rungeKuttaFehlberg78 )
+        : initialTime( anInitialTime ),
+          finalTime( aFinalTime ),
+          initialStepSize( anInitialStepSize ),
+          minimumStepSize( aMinimumStepSize ),
+          maximumStepSize( aMaximumStepSize ),
+          relativeErrorTolerance( aRelativeErrorTolerance ),
+          absoluteErrorTolerance( anAbsoluteErrorTolerance ),
+          coefficientSet( aCoefficientSet )
+    { }
+
+    //! Initial time of propagation [s].
+    double initialTime;
+
+    //! Final time of propagation [s].
+    double finalTime;
+
+    //! Initial step size [s].
+    double initialStepSize;
+
+    //! Minimum step size [s].
+    double minimumStepSize;
+
+    //! Maximum step size [s].
+    double maximumStepSize;
+
+    //! Relative error tolerance.
+    double relativeErrorTolerance;
+
+    //! Absolute error tolerance.
+    double absoluteErrorTolerance;
+
+    //! Runge-Kutta coefficient set.
+    numerical_integrators::RungeKuttaCoefficients::CoefficientSets coefficientSet;
+};
+
+//! Result of single sample of Monte Carlo dispersion analysis.
+struct DispersionSampleResult
+{
+public:
+
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Default constructor.
+    DispersionSampleResult( )
+        : sampleIndex( 0 ),
+          isPropagationSuccessful( false ),
+          finalTime( 0.0 ),
+          finalState( basic_mathematics::Vector6d::Zero( ) )
+    { }
+
+    //! Index of sample in list of dispersed inputs.
+    unsigned int sampleIndex;
+
+    //! Flag indicating whether the propagation was successful (i.e., did not throw an exception).
+    bool isPropagationSuccessful;
+
+    //! Time at which propagation ended [s].
+    double finalTime;
+
+    //! Cartesian state at which propagation ended [m, m/s].
+    basic_mathematics::Vector6d finalState;
+};
+
+//! Monte Carlo dispersion analysis class.
+/*!
+ * Class that propagates a list of dispersed inputs concurrently, using a separate propagation
+ * model per worker, streams the results of the individual samples to an output stream, and
+ * computes the statistics of the final states online (Welford, 1962). Samples for which the
+ * propagation throws an exception (e.g., because the minimum step size is exceeded) are counted
+ * as failed, and are excluded from the statistics.
+ */
+class MonteCarloDispersionAnalysis : boost::noncopyable
+{
+public:
+
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Constructor.
+    /*!
+     * Constructor taking the propagation model factory, propagation settings and task pool.
+     * \param aPropagationModelFactory Factory function creating a propagation model; called once
+     *          per worker, upon the first analysis.
+     * \param somePropagationSettings Propagation settings.
+     * \param aTaskPool Shared-pointer to task pool on which the samples are propagated (default
+     *          is NULL, in which case the samples are propagated serially by a single worker).
+     */
+    MonteCarloDispersionAnalysis(
+            const DispersedPropagationModelFactory& aPropagationModelFactory,
+            const DispersionPropagationSettings& somePropagationSettings,
+            const basics::ParallelTaskPoolPointer aTaskPool = basics::ParallelTaskPoolPointer( ) );
+
+    //! Perform analysis.
+    /*!
+     * Propagates all dispersed inputs, and computes the statistics of the final states. If an
+     * output stream is given, a line is written to it per sample (in order of sample index), with
+     * the tab-separated sample index, propagation success flag (0 or 1), final time and final
+     * state. Statistics of a previous analysis are discarded.
+     * \param dispersedInputsList List of dispersed inputs to propagate.
+     * \param outputStream Pointer to output stream to which the results are written (default is
+     *          NULL, in which case no results are written).
+     */
+    void performAnalysis( const DispersedInputsList& dispersedInputsList,
+                          std::ostream* outputStream = NULL );
+
+    //! Propagate single sample.
+    /*!
+     * Propagates the given dispersed inputs with the given propagation model.
+     * \param propagationModel Propagation model.
+     * \param dispersedInputs Dispersed inputs to propagate.
+     * \return Result of propagation (with a sample index of zero).
+     */
+    DispersionSampleResult propagateSample( const DispersedPropagationModelPointer propagationModel,
+                                            const DispersedInputs& dispersedInputs ) const;
+
+    //! Get number of workers.
+    /*!
+     * Returns the number of workers, i.e., the number of threads of the task pool.
+     * \return Number of workers.
+     */
+    unsigned int getNumberOfWorkers( ) const
+    {
+        return taskPool ? taskPool->getNumberOfThreads( ) : 1;
+    }
+
+    //! Get number of samples of last analysis.
+    unsigned int getNumberOfSamples( ) const { return numberOfSamples; }
+
+    //! Get number of failed samples of last analysis.
+    unsigned int getNumberOfFailedSamples( ) const { return numberOfFailedSamples; }
+
+    //! Get mean final state of successful samples of last analysis.
+    basic_mathematics::Vector6d getMeanFinalState( ) const { return meanFinalState; }
+
+    //! Get (unbiased) sample covariance of final state of successful samples of last analysis.
+    /*!
+     * Returns the unbiased sample covariance matrix of the final state of the successful samples
+     * of the last analysis. If less than two samples were successful, a zero matrix is returned.
+     * \return Sample covariance of final state.
+     */
+    basic_mathematics::Matrix6d getFinalStateCovariance( ) const;
+
+protected:
+
+private:
+
+    //! Typedef for map of buffered sample results.
+    typedef std::map< unsigned int, DispersionSampleResult, std::less< unsigned int >,
+    Eigen::aligned_allocator< std::pair< const unsigned int, DispersionSampleResult > > >
+    SampleResultMap;
+
+    //! Run worker.
+    /*!
+     * Claims samples from the current list of dispersed inputs, propagates them using the
+     * propagation model of the worker, and passes the results on, until all samples are claimed.
+     * This function is executed as task on the task pool.
+     * \param workerIndex Index of the worker.
+     */
+    void runWorker( const unsigned int workerIndex );
+
+    //! Process result of sample.
+    /*!
+     * Buffers the given result, and writes all buffered results (in order of sample index) that
+     * directly succeed the previously processed result, and adds these to the statistics.
+     * \param sampleResult Result of sample.
+     */
+    void processSampleResult( const DispersionSampleResult& sampleResult );
+
+    //! Factory function creating a propagation model.
+    const DispersedPropagationModelFactory propagationModelFactory;
+
+    //! Propagation settings.
+    const DispersionPropagationSettings propagationSettings;
+
+    //! Shared-pointer to task pool.
+    const basics::ParallelTaskPoolPointer taskPool;
+
+    //! Propagation models owned by the workers.
+    std::vector< DispersedPropagationModelPointer > workerPropagationModels;
+
+    //! Pointer to list of dispersed inputs of current analysis.
+    const DispersedInputsList* currentDispersedInputsList;
+
+    //! Pointer to output stream of current analysis (NULL if no output is written).
+    std::ostream* currentOutputStream;
+
+    //! Mutex protecting index of next sample to claim.
+    boost::mutex sampleMutex;
+
+    //! Index of next sample to claim.
+    unsigned int nextSampleIndex;
+
+    //! Mutex protecting result buffer and statistics.
+    boost::mutex resultMutex;
+
+    //! Results that cannot be processed yet, because preceding samples have not been completed.
+    SampleResultMap bufferedSampleResults;
+
+    //! Number of processed samples.
+    unsigned int numberOfSamples;
+
+    //! Number of processed samples of which propagation failed.
+    unsigned int numberOfFailedSamples;
+
+    //! Running mean of final state of successful samples.
+    basic_mathematics::Vector6d meanFinalState;
+
+    //! Running sum of products of deviations from mean of final state of successful samples.
+    basic_mathematics::Matrix6d sumOfFinalStateDeviationProducts;
+};
+
+//! Typedef for shared-pointer to MonteCarloDispersionAnalysis object.
+typedef boost::shared_ptr< MonteCarloDispersionAnalysis > MonteCarloDispersionAnalysisPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_MONTE_CARLO_DISPERSION_ANALYSIS_H
@@ -0,0 +1,181 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140214    S. Vermeer        File created.
+ *      140307    S. Vermeer        Added tracing of state derivative evaluations.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/multiBodyStateDerivativeModel.h"
+#include "Tudat/Basics/tracing.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Constructor.
+MultiBodyStateDerivativeModel::MultiBodyStateDerivativeModel(
+        const unsigned int aNumberOfBodies,
+        const EnvironmentUpdateFunction anEnvironmentUpdateFunction )
+    : numberOfBodies( aNumberOfBodies ),
+      updateEnvironment( anEnvironmentUpdateFunction ),
+      currentTime( 0.0 ),
+      currentStackedState( Eigen::VectorXd::Zero( 6 * aNumberOfBodies ) ),
+      currentPositions( CartesianVectorBlock::Zero( aNumberOfBodies, 3 ) ),
+      currentVelocities( CartesianVectorBlock::Zero( aNumberOfBodies, 3 ) )
+{
+    // Create (empty) uncoupled state derivative model per body, and map each to the associated
+    // segment of the stacked state. The environment is updated once by the composite model, so
+    // the models of the individual bodies perform no update.
+    CompositeStateDerivativeModelVectorXd::VectorStateDerivativeModelMap stateDerivativeModelMap;
+    for ( unsigned int i = 0; i < numberOfBodies; i++ )
+    {
+        uncoupledStateDerivativeModels.push_back(
+                    boost::make_shared< CartesianStateDerivativeModel6d >(
+                        CartesianStateDerivativeModel6d::AccelerationModelPointerVector( ),
+                        &updateNothing< double, basic_mathematics::Vector6d > ) );
+
+        stateDerivativeModelMap[ std::make_pair( 6 * i, 6 ) ]
+                = boost::bind( &MultiBodyStateDerivativeModel::
+                               computeUncoupledStateDerivativeOfBody, this, i, _1, _2 );
+    }
+
+    compositeStateDerivativeModel = boost::make_shared< CompositeStateDerivativeModelVectorXd >(
+                stateDerivativeModelMap,
+                boost::bind( &MultiBodyStateDerivativeModel::updateCurrentStatesAndEnvironment,
+                             this, _1, _2 ) );
+}
+
+//! Set uncoupled acceleration models of body (with frame transformations).
+void MultiBodyStateDerivativeModel::setUncoupledAccelerationModels(
+        const unsigned int bodyIndex,
+        const CartesianStateDerivativeModel6d::ListOfAccelerationFrameTransformationPairs&
+        listOfAccelerationFrameTransformationPairs )
+{
+    if ( bodyIndex >= numberOfBodies )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Body index exceeds number of bodies." ) ) );
+    }
+
+    uncoupledStateDerivativeModels[ bodyIndex ]
+            = boost::make_shared< CartesianStateDerivativeModel6d >(
+                listOfAccelerationFrameTransformationPairs,
+                &updateNothing< double, basic_mathematics::Vector6d > );
+}
+
+//! Set uncoupled acceleration models of body (without frame transformations).
+void MultiBodyStateDerivativeModel::setUncoupledAccelerationModels(
+        const unsigned int bodyIndex,
+        const CartesianStateDerivativeModel6d::AccelerationModelPointerVector&
+        listOfAccelerations )
+{
+    if ( bodyIndex >= numberOfBodies )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Body index exceeds number of bodies." ) ) );
+    }
+
+    uncoupledStateDerivativeModels[ bodyIndex ]
+            = boost::make_shared< CartesianStateDerivativeModel6d >(
+                listOfAccelerations, &updateNothing< double, basic_mathematics::Vector6d > );
+}
+
+//! Compute state derivative.
+Eigen::VectorXd MultiBodyStateDerivativeModel::computeStateDerivative(
+        const double time, const Eigen::VectorXd& stackedState )
+{
+    TUDAT_TRACE_SCOPE( "StateDerivativeModels",
+                       "MultiBodyStateDerivativeModel::computeStateDerivative" );
+
+    if ( stackedState.rows( ) != static_cast< int >( 6 * numberOfBodies ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Size of stacked state is inconsistent with number "
+                                            "of bodies." ) ) );
+    }
+
+    // Compute state derivative due to uncoupled accelerations (this also updates the current
+    // states and environment).
+    Eigen::VectorXd stackedStateDerivative
+            = compositeStateDerivativeModel->computeStateDerivative( time, stackedState );
+
+    // Add coupled accelerations.
+    for ( unsigned int i = 0; i < coupledAccelerationFunctions.size( ); i++ )
+    {
+        const CartesianVectorBlock coupledAccelerations = coupledAccelerationFunctions[ i ](
+                    currentTime, currentPositions, currentVelocities );
+
+        for ( unsigned int j = 0; j < numberOfBodies; j++ )
+        {
+            stackedStateDerivative.segment< 3 >( 6 * j + 3 )
+                    += coupledAccelerations.row( j ).transpose( );
+        }
+    }
+
+    return stackedStateDerivative;
+}
+
+//! Update current time, body states and environment.
+void MultiBodyStateDerivativeModel::updateCurrentStatesAndEnvironment(
+        const double time, const Eigen::VectorXd& stackedState )
+{
+    currentTime = time;
+    currentStackedState = stackedState;
+
+    for ( unsigned int i = 0; i < numberOfBodies; i++ )
+    {
+        currentPositions.row( i ) = stackedState.segment< 3 >( 6 * i ).transpose( );
+        currentVelocities.row( i ) = stackedState.segment< 3 >( 6 * i + 3 ).transpose( );
+    }
+
+    updateEnvironment( time, stackedState );
+}
+
+//! Compute state derivative of single body due to uncoupled accelerations.
+Eigen::VectorXd MultiBodyStateDerivativeModel::computeUncoupledStateDerivativeOfBody(
+        const unsigned int bodyIndex, const double time, const Eigen::VectorXd& bodyState )
+{
+    return uncoupledStateDerivativeModels[ bodyIndex ]->computeStateDerivative(
+                time, bodyState );
+}
+
+} // namespace state_derivative_models
+} // namespace tudat
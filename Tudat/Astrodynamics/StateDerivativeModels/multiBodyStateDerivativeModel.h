@@ -0,0 +1,280 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140214    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      The states of all bodies are stacked in a single (composite) state vector, which can be
+ *      propagated by any of the numerical integrators in Tudat. The environment update function
+ *      is called once per state derivative evaluation for all bodies, so that quantities shared by
+ *      the bodies (e.g., Sun and Moon ephemerides, stored in an EnvironmentUpdateGraph) are not
+ *      recomputed per body.
+ *
+ */
+
+#ifndef TUDAT_MULTI_BODY_STATE_DERIVATIVE_MODEL_H
+#define TUDAT_MULTI_BODY_STATE_DERIVATIVE_MODEL_H
+
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateDerivativeModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/compositeStateDerivativeModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Multi-body Cartesian state derivative model class.
+/*!
+ * Class that generates the state derivative model of N bodies, of which the 6D Cartesian states
+ * are stacked in a single state vector (elements 6i to 6i+5 are the state of body i). The
+ * accelerations of each body are composed of uncoupled accelerations, which act on a single body
+ * and are given as a list of acceleration models per body (evaluated through a
+ * CartesianStateDerivativeModel per body, combined in a CompositeStateDerivativeModel), and
+ * coupled accelerations, which are functions of the positions and velocities of all bodies (e.g.,
+ * mutual gravitational attraction or relative dynamics of a formation). Before any acceleration
+ * is evaluated, the current time and body states are stored in this object, and a single
+ * environment update function is called for all bodies. Acceleration models can retrieve the
+ * current states of the bodies through the get-functions of this object.
+ */
+class MultiBodyStateDerivativeModel
+        : public StateDerivativeModel< double, Eigen::VectorXd >, private boost::noncopyable
+{
+public:
+
+    //! Typedef for block of Cartesian vectors (row i is the vector of body i).
+    typedef Eigen::Matrix< double, Eigen::Dynamic, 3 > CartesianVectorBlock;
+
+    //! Typedef for pointer to a function that updates the environment.
+    typedef boost::function< void( const double, const Eigen::VectorXd& ) >
+    EnvironmentUpdateFunction;
+
+    //! Typedef for pointer to a function that computes coupled accelerations.
+    /*!
+     * Typedef for pointer to a function that computes accelerations of all bodies (row i is the
+     * acceleration of body i), as a function of time, and the positions and velocities of all
+     * bodies (row i is the position/velocity of body i).
+     */
+    typedef boost::function< CartesianVectorBlock( const double, const CartesianVectorBlock&,
+                                                   const CartesianVectorBlock& ) >
+    CoupledAccelerationFunction;
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the number of bodies and the environment update function. Initially, no
+     * accelerations act on the bodies.
+     * \param aNumberOfBodies Number of bodies.
+     * \param anEnvironmentUpdateFunction Function to update the environment, which is called
+     *          once per state derivative evaluation, after the current time and body states have
+     *          been set (default performs no update).
+     */
+    MultiBodyStateDerivativeModel(
+            const unsigned int aNumberOfBodies,
+            const EnvironmentUpdateFunction anEnvironmentUpdateFunction
+            = &updateNothing< double, Eigen::VectorXd > );
+
+    //! Set uncoupled acceleration models of body.
+    /*!
+     * Sets the list of acceleration models (with associated frame transformations) acting on a
+     * single body, replacing any previously set list.
+     * \param bodyIndex Index of body.
+     * \param listOfAccelerationFrameTransformationPairs List of acceleration models with
+     *          associated frame transformations.
+     */
+    void setUncoupledAccelerationModels(
+            const unsigned int bodyIndex,
+            const CartesianStateDerivativeModel6d::ListOfAccelerationFrameTransformationPairs&
+            listOfAccelerationFrameTransformationPairs );
+
+    //! Set uncoupled acceleration models of body.
+    /*!
+     * Sets the list of acceleration models acting on a single body (without frame
+     * transformations), replacing any previously set list.
+     * \param bodyIndex Index of body.
+     * \param listOfAccelerations List of acceleration models.
+     */
+    void setUncoupledAccelerationModels(
+            const unsigned int bodyIndex,
+            const CartesianStateDerivativeModel6d::AccelerationModelPointerVector&
+            listOfAccelerations );
+
+    //! Add coupled acceleration function.
+    /*!
+     * Adds a function computing accelerations that depend on the states of multiple bodies.
+     * \param coupledAccelerationFunction Function computing coupled accelerations of all bodies.
+     */
+    void addCoupledAccelerationFunction(
+            const CoupledAccelerationFunction coupledAccelerationFunction )
+    {
+        coupledAccelerationFunctions.push_back( coupledAccelerationFunction );
+    }
+
+    //! Compute state derivative.
+    /*!
+     * Computes the stacked state derivative of all bodies, from the uncoupled acceleration models
+     * of each body and the coupled acceleration functions.
+     * \param time Current time.
+     * \param stackedState Current stacked state of all bodies.
+     * \return Stacked state derivative of all bodies.
+     */
+    Eigen::VectorXd computeStateDerivative( const double time,
+                                            const Eigen::VectorXd& stackedState );
+
+    //! Get number of bodies.
+    /*!
+     * Returns number of bodies.
+     * \return Number of bodies.
+     */
+    unsigned int getNumberOfBodies( ) const { return numberOfBodies; }
+
+    //! Get current time.
+    /*!
+     * Returns the time of the current state derivative evaluation.
+     * \return Current time.
+     */
+    double getCurrentTime( ) const { return currentTime; }
+
+    //! Get current position of body.
+    /*!
+     * Returns the position of the given body in the current state derivative evaluation.
+     * \param bodyIndex Index of body.
+     * \return Current position of body.
+     */
+    Eigen::Vector3d getCurrentPositionOfBody( const unsigned int bodyIndex ) const
+    {
+        return currentPositions.row( bodyIndex ).transpose( );
+    }
+
+    //! Get current velocity of body.
+    /*!
+     * Returns the velocity of the given body in the current state derivative evaluation.
+     * \param bodyIndex Index of body.
+     * \return Current velocity of body.
+     */
+    Eigen::Vector3d getCurrentVelocityOfBody( const unsigned int bodyIndex ) const
+    {
+        return currentVelocities.row( bodyIndex ).transpose( );
+    }
+
+    //! Get current state of body.
+    /*!
+     * Returns the Cartesian state of the given body in the current state derivative evaluation.
+     * \param bodyIndex Index of body.
+     * \return Current state of body.
+     */
+    basic_mathematics::Vector6d getCurrentStateOfBody( const unsigned int bodyIndex ) const
+    {
+        return currentStackedState.segment< 6 >( 6 * bodyIndex );
+    }
+
+    //! Get current positions of all bodies.
+    /*!
+     * Returns the positions of all bodies in the current state derivative evaluation (row i is
+     * the position of body i).
+     * \return Current positions of all bodies.
+     */
+    const CartesianVectorBlock& getCurrentPositions( ) const { return currentPositions; }
+
+    //! Get current velocities of all bodies.
+    /*!
+     * Returns the velocities of all bodies in the current state derivative evaluation (row i is
+     * the velocity of body i).
+     * \return Current velocities of all bodies.
+     */
+    const CartesianVectorBlock& getCurrentVelocities( ) const { return currentVelocities; }
+
+protected:
+
+private:
+
+    //! Update current time, body states and environment.
+    /*!
+     * Sets the current time and body states, and calls the environment update function. This
+     * function is the update function of the composite state derivative model.
+     * \param time Current time.
+     * \param stackedState Current stacked state of all bodies.
+     */
+    void updateCurrentStatesAndEnvironment( const double time,
+                                            const Eigen::VectorXd& stackedState );
+
+    //! Compute state derivative of single body due to uncoupled accelerations.
+    /*!
+     * Computes the state derivative of a single body due to its uncoupled acceleration models.
+     * \param bodyIndex Index of body.
+     * \param time Current time.
+     * \param bodyState Current state of body.
+     * \return State derivative of body.
+     */
+    Eigen::VectorXd computeUncoupledStateDerivativeOfBody( const unsigned int bodyIndex,
+                                                           const double time,
+                                                           const Eigen::VectorXd& bodyState );
+
+    //! Number of bodies.
+    const unsigned int numberOfBodies;
+
+    //! Pointer to function to update the environment.
+    const EnvironmentUpdateFunction updateEnvironment;
+
+    //! State derivative models of bodies due to uncoupled accelerations.
+    std::vector< CartesianStateDerivativeModel6dPointer > uncoupledStateDerivativeModels;
+
+    //! Composite state derivative model combining uncoupled state derivative models of bodies.
+    CompositeStateDerivativeModelVectorXdPointer compositeStateDerivativeModel;
+
+    //! List of coupled acceleration functions.
+    std::vector< CoupledAccelerationFunction > coupledAccelerationFunctions;
+
+    //! Current time.
+    double currentTime;
+
+    //! Current stacked state of all bodies.
+    Eigen::VectorXd currentStackedState;
+
+    //! Current positions of all bodies (row i is position of body i).
+    CartesianVectorBlock currentPositions;
+
+    //! Current velocities of all bodies (row i is velocity of body i).
+    CartesianVectorBlock currentVelocities;
+};
+
+//! Typedef for shared-pointer to MultiBodyStateDerivativeModel object.
+typedef boost::shared_ptr< MultiBodyStateDerivativeModel > MultiBodyStateDerivativeModelPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_MULTI_BODY_STATE_DERIVATIVE_MODEL_H
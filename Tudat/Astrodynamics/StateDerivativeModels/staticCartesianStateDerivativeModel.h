@@ -0,0 +1,353 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140210    S. Vermeer        File created.
+ *      140307    S. Vermeer        Added tracing of state derivative evaluations.
+ *
+ *    References
+ *
+ *    Notes
+ *      This class provides the same functionality as the CartesianStateDerivativeModel class,
+ *      but the list of acceleration models (and associated frame transformations) is composed at
+ *      compile-time as a boost::tuple of shared-pointers to the concrete acceleration model
+ *      types. As a result, no virtual function calls, boost::function calls or bounds-checked
+ *      vector accesses are performed in the loop over the acceleration models, which allows the
+ *      compiler to inline cheap acceleration models (e.g., point-mass and J2 gravity). The price
+ *      is that the set of acceleration models can not be changed at run-time.
+ *
+ *      The updateMembers() and getAcceleration() functions of the acceleration models are
+ *      called explicitly for the type given in the tuple (thereby bypassing virtual dispatch).
+ *      The tuple must therefore contain the most-derived type of each acceleration model. If an
+ *      abstract type is given, the functions are called virtually, as in
+ *      CartesianStateDerivativeModel.
+ *
+ *      Even though this class is templatized to work with generic data types for the Cartesian
+ *      state (derivative), the use of the Zero(), rows(), and segment() functions are
+ *      Eigen-specific.
+ *
+ */
+
+#ifndef TUDAT_STATIC_CARTESIAN_STATE_DERIVATIVE_MODEL_H
+#define TUDAT_STATIC_CARTESIAN_STATE_DERIVATIVE_MODEL_H
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_abstract.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
+#include "Tudat/Basics/tracing.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Frame transformation that performs no transformation.
+/*!
+ * Function object that returns the input acceleration without performing any frame
+ * transformation. This is the static counterpart of the transformNothing() function.
+ * \sa StaticAccelerationFrameTransformationPair, transformNothing().
+ */
+struct NoFrameTransformation
+{
+    //! Perform no frame transformation.
+    /*!
+     * Returns the input acceleration without performing any frame transformation.
+     * \param acceleration Input acceleration.
+     * \return Output acceleration (same as input).
+     */
+    template< typename AccelerationType >
+    AccelerationType operator( )( const AccelerationType& acceleration ) const
+    {
+        return acceleration;
+    }
+};
+
+//! Acceleration model/frame transformation pair for static acceleration model lists.
+/*!
+ * Pair of shared-pointer to an acceleration model of a concrete type and a frame transformation
+ * of a concrete type, to be used as element of the acceleration model list of the
+ * StaticCartesianStateDerivativeModel class. The frame transformation can be any function object
+ * (or boost::function) that takes and returns an acceleration; multiple transformations should be
+ * composed into a single function object.
+ * \tparam AccelerationModelType Type of acceleration model.
+ * \tparam FrameTransformationType Type of frame transformation function object.
+ * \sa StaticCartesianStateDerivativeModel, makeStaticAccelerationFrameTransformationPair().
+ */
+template< typename AccelerationModelType, typename FrameTransformationType >
+struct StaticAccelerationFrameTransformationPair
+{
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param anAccelerationModel Shared-pointer to acceleration model.
+     * \param aFrameTransformation Frame transformation applied to acceleration.
+     */
+    StaticAccelerationFrameTransformationPair(
+            const boost::shared_ptr< AccelerationModelType >& anAccelerationModel,
+            const FrameTransformationType& aFrameTransformation )
+        : accelerationModel( anAccelerationModel ),
+          frameTransformation( aFrameTransformation )
+    { }
+
+    //! Shared-pointer to acceleration model.
+    boost::shared_ptr< AccelerationModelType > accelerationModel;
+
+    //! Frame transformation applied to acceleration.
+    FrameTransformationType frameTransformation;
+};
+
+//! Make acceleration model/frame transformation pair for static acceleration model lists.
+/*!
+ * Makes acceleration model/frame transformation pair, deducing the types from the arguments
+ * (analogous to std::make_pair).
+ * \param accelerationModel Shared-pointer to acceleration model.
+ * \param frameTransformation Frame transformation applied to acceleration.
+ * \return Acceleration model/frame transformation pair.
+ */
+template< typename AccelerationModelType, typename FrameTransformationType >
+StaticAccelerationFrameTransformationPair< AccelerationModelType, FrameTransformationType >
+makeStaticAccelerationFrameTransformationPair(
+        const boost::shared_ptr< AccelerationModelType >& accelerationModel,
+        const FrameTransformationType& frameTransformation )
+{
+    return StaticAccelerationFrameTransformationPair< AccelerationModelType,
+            FrameTransformationType >( accelerationModel, frameTransformation );
+}
+
+//! Update members of acceleration model and get acceleration, using virtual dispatch.
+/*!
+ * Updates members of acceleration model and returns acceleration, for an abstract acceleration
+ * model type (for which the functions can only be called virtually).
+ * \param accelerationModel Acceleration model.
+ * \return Acceleration.
+ */
+template< typename AccelerationType, typename AccelerationModelType >
+inline AccelerationType updateAndGetStaticAcceleration( AccelerationModelType& accelerationModel,
+                                                        boost::true_type )
+{
+    accelerationModel.updateMembers( );
+    return accelerationModel.getAcceleration( );
+}
+
+//! Update members of acceleration model and get acceleration, bypassing virtual dispatch.
+/*!
+ * Updates members of acceleration model and returns acceleration, for a concrete acceleration
+ * model type. The functions of the given type are called explicitly, so that they can be inlined.
+ * \param accelerationModel Acceleration model.
+ * \return Acceleration.
+ */
+template< typename AccelerationType, typename AccelerationModelType >
+inline AccelerationType updateAndGetStaticAcceleration( AccelerationModelType& accelerationModel,
+                                                        boost::false_type )
+{
+    accelerationModel.AccelerationModelType::updateMembers( );
+    return accelerationModel.AccelerationModelType::getAcceleration( );
+}
+
+//! Add acceleration of acceleration model without frame transformation.
+/*!
+ * Updates members of acceleration model, and adds its acceleration to the total acceleration.
+ * \param accelerationModel Shared-pointer to acceleration model.
+ * \param totalAcceleration Total acceleration, to which acceleration is added (returned by
+ *          reference).
+ */
+template< typename AccelerationType, typename AccelerationModelType >
+inline void addStaticAcceleration(
+        const boost::shared_ptr< AccelerationModelType >& accelerationModel,
+        AccelerationType& totalAcceleration )
+{
+    totalAcceleration += updateAndGetStaticAcceleration< AccelerationType >(
+                *accelerationModel, typename boost::is_abstract< AccelerationModelType >::type( ) );
+}
+
+//! Add acceleration of acceleration model with frame transformation.
+/*!
+ * Updates members of acceleration model, and adds its transformed acceleration to the total
+ * acceleration.
+ * \param accelerationFrameTransformationPair Acceleration model/frame transformation pair.
+ * \param totalAcceleration Total acceleration, to which acceleration is added (returned by
+ *          reference).
+ */
+template< typename AccelerationType, typename AccelerationModelType,
+          typename FrameTransformationType >
+inline void addStaticAcceleration(
+        const StaticAccelerationFrameTransformationPair< AccelerationModelType,
+        FrameTransformationType >& accelerationFrameTransformationPair,
+        AccelerationType& totalAcceleration )
+{
+    totalAcceleration += accelerationFrameTransformationPair.frameTransformation(
+                updateAndGetStaticAcceleration< AccelerationType >(
+                    *accelerationFrameTransformationPair.accelerationModel,
+                    typename boost::is_abstract< AccelerationModelType >::type( ) ) );
+}
+
+//! Add accelerations of empty acceleration model list.
+/*!
+ * Terminates the compile-time recursion over the acceleration model list.
+ */
+template< typename AccelerationType >
+inline void addStaticAccelerations( const boost::tuples::null_type&, AccelerationType& )
+{ }
+
+//! Add accelerations of acceleration model list.
+/*!
+ * Adds the accelerations of all acceleration models in the list to the total acceleration, in
+ * the order in which they appear in the list (compile-time recursion).
+ * \param listOfAccelerations List of acceleration models (or acceleration model/frame
+ *          transformation pairs).
+ * \param totalAcceleration Total acceleration, to which accelerations are added (returned by
+ *          reference).
+ */
+template< typename AccelerationType, typename HeadType, typename TailType >
+inline void addStaticAccelerations(
+        const boost::tuples::cons< HeadType, TailType >& listOfAccelerations,
+        AccelerationType& totalAcceleration )
+{
+    addStaticAcceleration( listOfAccelerations.get_head( ), totalAcceleration );
+    addStaticAccelerations( listOfAccelerations.get_tail( ), totalAcceleration );
+}
+
+//! Cartesian state derivative model class with statically composed acceleration model list.
+/*!
+ * Templated class that generates a Cartesian state derivative model based on a list of
+ * acceleration models provided by the user, composed at compile-time as a boost::tuple. Each
+ * element of the tuple is either a shared-pointer to an acceleration model, or a
+ * StaticAccelerationFrameTransformationPair of a shared-pointer to an acceleration model and a
+ * frame transformation. The computed state derivative is the same as that of the
+ * CartesianStateDerivativeModel class for the same acceleration models and frame
+ * transformations, but without run-time dispatch in the loop over acceleration models.
+ * \tparam AccelerationModelList boost::tuple of acceleration models (or acceleration model/frame
+ *          transformation pairs).
+ * \tparam IndependentVariableType Data type for independent variable, e.g., time, (default is
+ *          double).
+ * \tparam CartesianStateType Data type for Cartesian state (default is Eigen::Vector6d).
+ * \tparam AccelerationType Data type for Cartesian acceleration (default is Eigen::Vector3d).
+ * \sa CartesianStateDerivativeModel.
+ */
+template< typename AccelerationModelList, typename IndependentVariableType = double,
+          typename CartesianStateType = basic_mathematics::Vector6d,
+          typename AccelerationType = Eigen::Vector3d >
+class StaticCartesianStateDerivativeModel
+        : public StateDerivativeModel< IndependentVariableType, CartesianStateType >
+{
+private:
+
+    //! Typedef for Cartesian state-derivative type.
+    typedef CartesianStateType CartesianStateDerivativeType;
+
+    //! Typedef for pointer to a set-function that updates independent variable and state data.
+    typedef boost::function< void ( const IndependentVariableType, const CartesianStateType& ) >
+    IndependentVariableAndStateUpdateFunction;
+
+public:
+
+    //! Constructor taking list of acceleration models, and pointer to a function to update
+    //! independent variable and state.
+    /*!
+     * Constructor taking list of acceleration models (with optional frame transformations), and
+     * pointer to a function to update independent variable and state, held externally in
+     * user-defined data repository.
+     * \param aListOfAccelerations List of acceleration models (or acceleration model/frame
+     *          transformation pairs).
+     * \param anIndependentVariableAndStateUpdateFunction Pointer to a function to update
+     *          independent variable and state.
+     */
+    StaticCartesianStateDerivativeModel(
+            const AccelerationModelList& aListOfAccelerations,
+            const IndependentVariableAndStateUpdateFunction
+            anIndependentVariableAndStateUpdateFunction )
+        : listOfAccelerations( aListOfAccelerations ),
+          updateIndependentVariableAndState( anIndependentVariableAndStateUpdateFunction )
+    { }
+
+    //! Compute Cartesian state derivative.
+    /*!
+     * Computes the Cartesian state derivative based on the list of acceleration models and
+     * associated frame transformations provided through the constructor.
+     * \param independentVariable Current independent variable value.
+     * \param cartesianState Current Cartesian state.
+     * \return Computed Cartesian State derivative vector.
+     */
+    CartesianStateDerivativeType computeStateDerivative(
+            const IndependentVariableType independentVariable,
+            const CartesianStateType& cartesianState )
+    {
+        TUDAT_TRACE_SCOPE( "StateDerivativeModels",
+                           "StaticCartesianStateDerivativeModel::computeStateDerivative" );
+
+        // Update data.
+        updateIndependentVariableAndState( independentVariable, cartesianState );
+
+        // Declare Cartesian state derivative size.
+        const unsigned int stateDerivativeSize = cartesianState.rows( );
+
+        // Sum accelerations of all acceleration models, in order of the list.
+        AccelerationType totalAcceleration = AccelerationType::Zero( stateDerivativeSize / 2 );
+        addStaticAccelerations( listOfAccelerations, totalAcceleration );
+
+        // Assemble state derivative from current Cartesian velocity and total acceleration.
+        CartesianStateDerivativeType cartesianStateDerivative( stateDerivativeSize );
+        cartesianStateDerivative.segment( 0, stateDerivativeSize / 2 )
+                = cartesianState.segment( stateDerivativeSize / 2, stateDerivativeSize / 2 );
+        cartesianStateDerivative.segment( stateDerivativeSize / 2, stateDerivativeSize / 2 )
+                = totalAcceleration;
+
+        // Return assembled state derivative.
+        return cartesianStateDerivative;
+    }
+
+    //! Get list of acceleration models.
+    /*!
+     * Returns list of acceleration models (or acceleration model/frame transformation pairs).
+     * \return List of acceleration models.
+     */
+    const AccelerationModelList& getListOfAccelerations( ) { return listOfAccelerations; }
+
+protected:
+
+private:
+
+    //! List of acceleration models (or acceleration model/frame transformation pairs).
+    AccelerationModelList listOfAccelerations;
+
+    //! Pointer to update function to update independent variable and state.
+    /*!
+     * Pointer to a function that updates user-defined data repository containing independent
+     * variable and state data to the current values.
+     */
+    const IndependentVariableAndStateUpdateFunction updateIndependentVariableAndState;
+};
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_STATIC_CARTESIAN_STATE_DERIVATIVE_MODEL_H
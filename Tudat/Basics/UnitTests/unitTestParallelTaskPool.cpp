@@ -0,0 +1,157 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140212    S. Vermeer        Unit test created.
+ *      140401    S. Vermeer        Moved from StateDerivativeModels to Basics, in namespace basics.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/parallelTaskPool.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using basics::ParallelTaskPool;
+
+//! Increment counter.
+/*!
+ * Increments counter, used to check how often a task is executed.
+ * \param counters List of counters.
+ * \param index Index of counter to increment.
+ */
+void incrementCounter( std::vector< int >* counters, const unsigned int index )
+{
+    ( *counters )[ index ]++;
+}
+
+//! Increment counter and throw exception for given index.
+/*!
+ * Increments counter, and throws an exception if the index is equal to the given failing index.
+ * \param counters List of counters.
+ * \param index Index of counter to increment.
+ * \param failingIndex Index for which an exception is thrown.
+ */
+void incrementCounterOrThrow( std::vector< int >* counters, const unsigned int index,
+                              const unsigned int failingIndex )
+{
+    ( *counters )[ index ]++;
+
+    if ( index == failingIndex )
+    {
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( "Task failed." ) ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_parallel_task_pool )
+
+//! Test whether all tasks are executed exactly once.
+BOOST_AUTO_TEST_CASE( testParallelTaskPoolExecution )
+{
+    const unsigned int numberOfTasks = 100;
+    const unsigned int numberOfExecutions = 200;
+
+    // Test with serial execution, and with more threads than (likely) hardware threads.
+    const unsigned int numbersOfThreads[ 3 ] = { 1, 4, 16 };
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        ParallelTaskPool taskPool( numbersOfThreads[ i ] );
+        BOOST_CHECK_EQUAL( taskPool.getNumberOfThreads( ), numbersOfThreads[ i ] );
+
+        // Create tasks.
+        std::vector< int > counters( numberOfTasks, 0 );
+        std::vector< ParallelTaskPool::Task > tasks;
+        for ( unsigned int j = 0; j < numberOfTasks; j++ )
+        {
+            tasks.push_back( boost::bind( &incrementCounter, &counters, j ) );
+        }
+
+        // Execute tasks repeatedly, and check that each execution finishes all tasks.
+        for ( unsigned int j = 0; j < numberOfExecutions; j++ )
+        {
+            taskPool.executeTasks( tasks );
+
+            for ( unsigned int k = 0; k < numberOfTasks; k++ )
+            {
+                BOOST_REQUIRE_EQUAL( counters[ k ], static_cast< int >( j + 1 ) );
+            }
+        }
+
+        // Check that empty list of tasks can be executed.
+        taskPool.executeTasks( std::vector< ParallelTaskPool::Task >( ) );
+    }
+}
+
+//! Test whether exceptions thrown by tasks are propagated.
+BOOST_AUTO_TEST_CASE( testParallelTaskPoolExceptionHandling )
+{
+    const unsigned int numberOfTasks = 20;
+    ParallelTaskPool taskPool( 4 );
+
+    // Create tasks, of which one throws an exception.
+    std::vector< int > counters( numberOfTasks, 0 );
+    std::vector< ParallelTaskPool::Task > tasks;
+    for ( unsigned int i = 0; i < numberOfTasks; i++ )
+    {
+        tasks.push_back( boost::bind( &incrementCounterOrThrow, &counters, i, 7 ) );
+    }
+
+    // Check that exception is rethrown, and that all other tasks have been executed.
+    BOOST_CHECK_THROW( taskPool.executeTasks( tasks ), std::runtime_error );
+    for ( unsigned int i = 0; i < numberOfTasks; i++ )
+    {
+        BOOST_CHECK_EQUAL( counters[ i ], 1 );
+    }
+
+    // Check that pool can be used again after an exception.
+    tasks[ 7 ] = boost::bind( &incrementCounter, &counters, 7 );
+    taskPool.executeTasks( tasks );
+    for ( unsigned int i = 0; i < numberOfTasks; i++ )
+    {
+        BOOST_CHECK_EQUAL( counters[ i ], 2 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,285 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140307    S. Vermeer        Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *      Tracing is enabled in this unit test regardless of the TUDAT_ENABLE_TRACING build option,
+ *      by defining the macro before including any Tudat header.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#ifndef TUDAT_ENABLE_TRACING
+#define TUDAT_ENABLE_TRACING
+#endif
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/utilityMacros.h>
+
+#include "Tudat/Basics/tracing.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using tracing::TraceBuffer;
+using tracing::TraceBufferPointer;
+using tracing::TraceEvent;
+using tracing::TraceRecorder;
+
+//! Get events recorded by the main thread.
+/*!
+ * Returns the events recorded by the main thread, which records the first event in this unit test
+ * and therefore owns the first trace buffer.
+ * \return Events of main thread.
+ */
+std::vector< TraceEvent > getMainThreadEvents( )
+{
+    return TraceRecorder::getInstance( ).getBuffers( ).front( )->getEvents( );
+}
+
+//! Perform some work that can not be optimized away.
+double performWork( const int numberOfIterations )
+{
+    double result = 0.0;
+    for ( int i = 1; i <= numberOfIterations; i++ )
+    {
+        result += std::sqrt( static_cast< double >( i ) );
+    }
+    return result;
+}
+
+//! Record a number of scoped events.
+void recordScopedEvents( const int numberOfEvents )
+{
+    for ( int i = 0; i < numberOfEvents; i++ )
+    {
+        TUDAT_TRACE_SCOPE( "Test", "worker" );
+        performWork( 100 );
+    }
+}
+
+//! Compute state derivative of harmonic oscillator.
+Eigen::Vector2d computeHarmonicOscillatorStateDerivative( const double time,
+                                                         const Eigen::Vector2d& state )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+    return Eigen::Vector2d( state( 1 ), -state( 0 ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_tracing )
+
+//! Test recording of nested scoped events.
+BOOST_AUTO_TEST_CASE( testScopedEventRecording )
+{
+    TraceRecorder::getInstance( ).clear( );
+
+    {
+        TUDAT_TRACE_SCOPE( "Test", "outer" );
+        performWork( 1000 );
+        {
+            TUDAT_TRACE_SCOPE( "Test", "inner" );
+            performWork( 1000 );
+        }
+    }
+
+    // Check that events are stored in order of completion, and that the outer event encloses the
+    // inner event.
+    const std::vector< TraceEvent > events = getMainThreadEvents( );
+    BOOST_REQUIRE_EQUAL( events.size( ), 2 );
+    BOOST_CHECK_EQUAL( std::string( events[ 0 ].name ), "inner" );
+    BOOST_CHECK_EQUAL( std::string( events[ 1 ].name ), "outer" );
+    BOOST_CHECK_EQUAL( std::string( events[ 1 ].category ), "Test" );
+    BOOST_CHECK( events[ 0 ].type == tracing::durationEvent );
+    BOOST_CHECK( events[ 1 ].startTime <= events[ 0 ].startTime );
+    BOOST_CHECK( events[ 1 ].startTime + events[ 1 ].duration
+                 >= events[ 0 ].startTime + events[ 0 ].duration );
+    BOOST_CHECK( events[ 0 ].duration >= 0 );
+}
+
+//! Test recording of counter values.
+BOOST_AUTO_TEST_CASE( testCounterRecording )
+{
+    TraceRecorder::getInstance( ).clear( );
+
+    TUDAT_TRACE_COUNTER( "Test", "counter", 3.5 );
+    TUDAT_TRACE_COUNTER( "Test", "counter", -1.0 );
+
+    const std::vector< TraceEvent > events = getMainThreadEvents( );
+    BOOST_REQUIRE_EQUAL( events.size( ), 2 );
+    BOOST_CHECK( events[ 0 ].type == tracing::counterEvent );
+    BOOST_CHECK_EQUAL( events[ 0 ].value, 3.5 );
+    BOOST_CHECK_EQUAL( events[ 1 ].value, -1.0 );
+    BOOST_CHECK( events[ 0 ].startTime <= events[ 1 ].startTime );
+}
+
+//! Test overwriting of oldest events by ring buffer.
+BOOST_AUTO_TEST_CASE( testRingBuffer )
+{
+    TraceBuffer traceBuffer( 4, 1 );
+
+    TraceEvent traceEvent;
+    traceEvent.category = "Test";
+    traceEvent.name = "event";
+    traceEvent.type = tracing::durationEvent;
+    traceEvent.duration = 0;
+    traceEvent.value = 0.0;
+
+    // Partially fill buffer.
+    for ( int i = 0; i < 3; i++ )
+    {
+        traceEvent.startTime = i;
+        traceBuffer.addEvent( traceEvent );
+    }
+    BOOST_CHECK_EQUAL( traceBuffer.getEvents( ).size( ), 3 );
+    BOOST_CHECK_EQUAL( traceBuffer.getNumberOfDroppedEvents( ), 0 );
+
+    // Overfill buffer, and check that the four most recent events are retained in order.
+    for ( int i = 3; i < 7; i++ )
+    {
+        traceEvent.startTime = i;
+        traceBuffer.addEvent( traceEvent );
+    }
+    const std::vector< TraceEvent > events = traceBuffer.getEvents( );
+    BOOST_REQUIRE_EQUAL( events.size( ), 4 );
+    for ( unsigned int i = 0; i < events.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( events[ i ].startTime, i + 3 );
+    }
+    BOOST_CHECK_EQUAL( traceBuffer.getNumberOfDroppedEvents( ), 3 );
+
+    // Check clearing of buffer.
+    traceBuffer.clear( );
+    BOOST_CHECK( traceBuffer.getEvents( ).empty( ) );
+    BOOST_CHECK_EQUAL( traceBuffer.getNumberOfDroppedEvents( ), 0 );
+}
+
+//! Test that every thread records in its own buffer.
+BOOST_AUTO_TEST_CASE( testPerThreadBuffers )
+{
+    TraceRecorder& traceRecorder = TraceRecorder::getInstance( );
+    traceRecorder.clear( );
+    const unsigned int numberOfBuffersBefore = traceRecorder.getBuffers( ).size( );
+
+    // Record events from a number of threads.
+    const unsigned int numberOfThreads = 3;
+    boost::thread_group threads;
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.create_thread( boost::bind( &recordScopedEvents, 10 ) );
+    }
+    threads.join_all( );
+
+    // Check that every thread has its own buffer, which is retained after the thread finished.
+    const std::vector< TraceBufferPointer > traceBuffers = traceRecorder.getBuffers( );
+    BOOST_REQUIRE_EQUAL( traceBuffers.size( ), numberOfBuffersBefore + numberOfThreads );
+    for ( unsigned int i = numberOfBuffersBefore; i < traceBuffers.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( traceBuffers[ i ]->getEvents( ).size( ), 10 );
+        BOOST_CHECK_EQUAL( traceBuffers[ i ]->getThreadIndex( ), i + 1 );
+    }
+
+    // Check that the main thread did not record any events.
+    BOOST_CHECK( getMainThreadEvents( ).empty( ) );
+}
+
+//! Test export in Chrome trace event format.
+BOOST_AUTO_TEST_CASE( testChromeTraceExport )
+{
+    TraceRecorder& traceRecorder = TraceRecorder::getInstance( );
+    traceRecorder.clear( );
+
+    {
+        TUDAT_TRACE_SCOPE( "Test", "quoted \"scope\"" );
+        TUDAT_TRACE_COUNTER( "Test", "counter", 2.0 );
+    }
+
+    std::stringstream traceStream;
+    traceRecorder.writeChromeTraceEvents( traceStream );
+    const std::string trace = traceStream.str( );
+
+    // Check document structure, thread metadata and events.
+    BOOST_CHECK_EQUAL( trace.find( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" ), 0 );
+    BOOST_CHECK_EQUAL( trace.substr( trace.size( ) - 3 ), "]}\n" );
+    BOOST_CHECK( trace.find( "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1" )
+                 != std::string::npos );
+    BOOST_CHECK( trace.find( "{\"name\":\"quoted \\\"scope\\\"\",\"cat\":\"Test\",\"pid\":1,"
+                             "\"tid\":1" ) != std::string::npos );
+    BOOST_CHECK( trace.find( "\"ph\":\"X\",\"dur\":" ) != std::string::npos );
+    BOOST_CHECK( trace.find( "\"ph\":\"C\",\"args\":{\"value\":2}}" ) != std::string::npos );
+}
+
+//! Test tracing of instrumented integrator.
+BOOST_AUTO_TEST_CASE( testInstrumentedIntegrator )
+{
+    using namespace numerical_integrators;
+
+    TraceRecorder::getInstance( ).clear( );
+
+    // Perform a number of integration steps.
+    RungeKuttaVariableStepSizeIntegrator< double, Eigen::Vector2d > integrator(
+                RungeKuttaCoefficients::get( RungeKuttaCoefficients::rungeKuttaFehlberg45 ),
+                &computeHarmonicOscillatorStateDerivative, 0.0, Eigen::Vector2d( 1.0, 0.0 ),
+                1.0e-6, 1.0, 1.0e-3, 1.0e-3 );
+    const unsigned int numberOfSteps = 5;
+    for ( unsigned int i = 0; i < numberOfSteps; i++ )
+    {
+        integrator.performIntegrationStep( 0.01 );
+    }
+
+    // Check that every step is recorded, together with the accepted step size.
+    const std::vector< TraceEvent > events = getMainThreadEvents( );
+    BOOST_REQUIRE_EQUAL( events.size( ), 2 * numberOfSteps );
+    for ( unsigned int i = 0; i < numberOfSteps; i++ )
+    {
+        BOOST_CHECK_EQUAL( std::string( events[ 2 * i ].name ), "stepSize" );
+        BOOST_CHECK_EQUAL( events[ 2 * i ].value, 0.01 );
+        BOOST_CHECK_EQUAL( std::string( events[ 2 * i + 1 ].name ),
+                           "RungeKuttaVariableStepSizeIntegrator::performIntegrationStep" );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
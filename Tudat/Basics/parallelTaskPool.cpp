@@ -0,0 +1,184 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140212    S. Vermeer        File created.
+ *      140401    S. Vermeer        Moved from StateDerivativeModels to Basics, in namespace basics.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Basics/parallelTaskPool.h"
+
+namespace tudat
+{
+namespace basics
+{
+
+//! Constructor.
+ParallelTaskPool::ParallelTaskPool( const unsigned int aNumberOfThreads )
+    : currentTasks( NULL ),
+      nextTaskIndex( 0 ),
+      numberOfUnfinishedTasks( 0 ),
+      taskListCounter( 0 ),
+      isStopRequested( false )
+{
+    // Start worker threads; the calling thread of executeTasks() is the remaining thread.
+    for ( unsigned int i = 1; i < aNumberOfThreads; i++ )
+    {
+        workerThreads.push_back( boost::make_shared< boost::thread >(
+                                     boost::bind( &ParallelTaskPool::runWorkerThread, this ) ) );
+    }
+}
+
+//! Destructor.
+ParallelTaskPool::~ParallelTaskPool( )
+{
+    // Request worker threads to stop.
+    {
+        boost::unique_lock< boost::mutex > lock( poolMutex );
+        isStopRequested = true;
+    }
+    tasksAvailableCondition.notify_all( );
+
+    // Wait for worker threads to finish.
+    for ( unsigned int i = 0; i < workerThreads.size( ); i++ )
+    {
+        workerThreads[ i ]->join( );
+    }
+}
+
+//! Execute tasks.
+void ParallelTaskPool::executeTasks( const std::vector< Task >& tasks )
+{
+    // Execute tasks serially if there are no worker threads, or only a single task.
+    if ( workerThreads.empty( ) || tasks.size( ) == 1 )
+    {
+        for ( unsigned int i = 0; i < tasks.size( ); i++ )
+        {
+            tasks[ i ]( );
+        }
+        return;
+    }
+
+    boost::unique_lock< boost::mutex > lock( poolMutex );
+
+    // Publish list of tasks and wake up worker threads.
+    currentTasks = &tasks;
+    nextTaskIndex = 0;
+    numberOfUnfinishedTasks = 0;
+    firstException = boost::exception_ptr( );
+    taskListCounter++;
+    tasksAvailableCondition.notify_all( );
+
+    // Participate in executing tasks.
+    executeAvailableTasks( lock );
+
+    // Wait for tasks claimed by worker threads to finish.
+    while ( numberOfUnfinishedTasks > 0 )
+    {
+        tasksFinishedCondition.wait( lock );
+    }
+
+    currentTasks = NULL;
+
+    // Rethrow first exception thrown by tasks, if any.
+    if ( firstException )
+    {
+        const boost::exception_ptr exceptionToRethrow = firstException;
+        firstException = boost::exception_ptr( );
+        lock.unlock( );
+        boost::rethrow_exception( exceptionToRethrow );
+    }
+}
+
+//! Run worker thread.
+void ParallelTaskPool::runWorkerThread( )
+{
+    boost::unique_lock< boost::mutex > lock( poolMutex );
+    unsigned long lastTaskListCounter = taskListCounter;
+
+    while ( true )
+    {
+        // Wait for new list of tasks, or stop request.
+        while ( !isStopRequested && taskListCounter == lastTaskListCounter )
+        {
+            tasksAvailableCondition.wait( lock );
+        }
+
+        if ( isStopRequested )
+        {
+            return;
+        }
+
+        lastTaskListCounter = taskListCounter;
+        executeAvailableTasks( lock );
+    }
+}
+
+//! Execute tasks from current list until it is exhausted.
+void ParallelTaskPool::executeAvailableTasks( boost::unique_lock< boost::mutex >& lock )
+{
+    while ( currentTasks != NULL && nextTaskIndex < currentTasks->size( ) )
+    {
+        // Claim next task.
+        const Task& task = ( *currentTasks )[ nextTaskIndex ];
+        nextTaskIndex++;
+        numberOfUnfinishedTasks++;
+
+        // Execute task without holding lock.
+        lock.unlock( );
+        boost::exception_ptr taskException;
+        try
+        {
+            task( );
+        }
+        catch ( ... )
+        {
+            taskException = boost::current_exception( );
+        }
+        lock.lock( );
+
+        // Store first exception, and signal calling thread if this was the last task.
+        if ( taskException && !firstException )
+        {
+            firstException = taskException;
+        }
+        numberOfUnfinishedTasks--;
+        if ( numberOfUnfinishedTasks == 0 && nextTaskIndex == currentTasks->size( ) )
+        {
+            tasksFinishedCondition.notify_all( );
+        }
+    }
+}
+
+} // namespace basics
+} // namespace tudat
@@ -0,0 +1,174 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140212    S. Vermeer        File created.
+ *      140401    S. Vermeer        Documented that executeTasks() is not re-entrant.
+ *      140401    S. Vermeer        Moved from StateDerivativeModels to Basics, in namespace basics.
+ *
+ *    References
+ *
+ *    Notes
+ *      The task pool is intended for the concurrent evaluation of a small number of relatively
+ *      expensive tasks (e.g., high-degree spherical harmonic gravity, tabulated atmosphere drag
+ *      and third-body accelerations) that are executed many times, such as the acceleration
+ *      models in a single state derivative evaluation. The worker threads are created once and
+ *      persist for the lifetime of the pool, so that no threads are created per execution.
+ *      Nevertheless, waking the worker threads incurs a synchronization overhead (typically of
+ *      the order of microseconds) per execution, so that concurrent evaluation is only
+ *      beneficial if the tasks are sufficiently expensive.
+ *
+ */
+
+#ifndef TUDAT_PARALLEL_TASK_POOL_H
+#define TUDAT_PARALLEL_TASK_POOL_H
+
+#include <vector>
+
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace tudat
+{
+namespace basics
+{
+
+//! Persistent parallel task pool class.
+/*!
+ * Pool of persistent worker threads, which concurrently executes lists of independent tasks. The
+ * thread calling executeTasks() participates in the execution of the tasks, and the function
+ * returns once all tasks have been executed. Tasks are distributed dynamically over the threads,
+ * so no assumption should be made about the thread on which, or order in which, the tasks are
+ * executed; any results should be written by each task to a separate, preallocated location.
+ * Only one list of tasks can be executed at a time; executeTasks() should therefore not be called
+ * concurrently from different threads, or from within a task.
+ */
+class ParallelTaskPool : boost::noncopyable
+{
+public:
+
+    //! Typedef for task function.
+    typedef boost::function< void( ) > Task;
+
+    //! Constructor.
+    /*!
+     * Constructor, starts the worker threads.
+     * \param aNumberOfThreads Total number of threads executing tasks, including the thread
+     *          calling executeTasks() (default is the number of hardware threads). A single thread
+     *          results in serial execution by the calling thread.
+     */
+    explicit ParallelTaskPool(
+            const unsigned int aNumberOfThreads = boost::thread::hardware_concurrency( ) );
+
+    //! Destructor.
+    /*!
+     * Destructor, stops and joins the worker threads.
+     */
+    ~ParallelTaskPool( );
+
+    //! Execute tasks.
+    /*!
+     * Executes the given tasks concurrently, and returns once all tasks have been executed. If
+     * any task throws an exception, the remaining tasks are still executed, after which the first
+     * exception caught is rethrown. If the pool has no worker threads, or only a single task is
+     * given, the tasks are executed serially by the calling thread, and exceptions are propagated
+     * directly. This function is not re-entrant: it must not be called concurrently from
+     * different threads, nor from within a task executed by this pool, since the pool keeps the
+     * state of only a single list of tasks.
+     * \param tasks List of tasks to execute. The list must remain valid until this function
+     *          returns.
+     */
+    void executeTasks( const std::vector< Task >& tasks );
+
+    //! Get number of threads.
+    /*!
+     * Returns the total number of threads executing tasks, including the calling thread.
+     * \return Number of threads.
+     */
+    unsigned int getNumberOfThreads( ) const { return workerThreads.size( ) + 1; }
+
+protected:
+
+private:
+
+    //! Run worker thread.
+    /*!
+     * Main loop of worker threads, which waits for a new list of tasks, and executes tasks from
+     * it until the list is exhausted.
+     */
+    void runWorkerThread( );
+
+    //! Execute tasks from current list until it is exhausted.
+    /*!
+     * Claims and executes tasks from the current list until no more tasks are available. This
+     * function is called by both the worker threads and the thread calling executeTasks().
+     * \param lock Lock on the pool mutex, which is held upon entry and exit, but released while
+     *          executing a task.
+     */
+    void executeAvailableTasks( boost::unique_lock< boost::mutex >& lock );
+
+    //! Worker threads.
+    std::vector< boost::shared_ptr< boost::thread > > workerThreads;
+
+    //! Mutex protecting all members below.
+    boost::mutex poolMutex;
+
+    //! Condition variable signalling worker threads that tasks are available (or to stop).
+    boost::condition_variable tasksAvailableCondition;
+
+    //! Condition variable signalling calling thread that all tasks have been executed.
+    boost::condition_variable tasksFinishedCondition;
+
+    //! Pointer to current list of tasks (NULL if no list is being executed).
+    const std::vector< Task >* currentTasks;
+
+    //! Index of next task to be claimed from current list.
+    unsigned int nextTaskIndex;
+
+    //! Number of tasks from current list that have been claimed but not yet finished.
+    unsigned int numberOfUnfinishedTasks;
+
+    //! Counter of lists of tasks, used by worker threads to detect a new list.
+    unsigned long taskListCounter;
+
+    //! Flag indicating that worker threads should stop.
+    bool isStopRequested;
+
+    //! First exception thrown by a task of the current list.
+    boost::exception_ptr firstException;
+};
+
+//! Typedef for shared-pointer to ParallelTaskPool object.
+typedef boost::shared_ptr< ParallelTaskPool > ParallelTaskPoolPointer;
+
+} // namespace basics
+} // namespace tudat
+
+#endif // TUDAT_PARALLEL_TASK_POOL_H
@@ -0,0 +1,575 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140307    S. Vermeer        File created.
+ *      140401    S. Vermeer        Declared recording classes only if tracing is enabled, such that
+ *                                  Boost.Chrono is optional.
+ *
+ *    References
+ *      Google. Trace Event Format, https://docs.google.com/document/d/
+ *          1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU, last accessed: 7 March, 2014.
+ *
+ *    Notes
+ *      Tracing is switched on at compile time by defining TUDAT_ENABLE_TRACING (CMake option
+ *      TUDAT_ENABLE_TRACING). If it is not defined, the TUDAT_TRACE_SCOPE and
+ *      TUDAT_TRACE_COUNTER macros expand to nothing, such that instrumented code is identical to
+ *      uninstrumented code. The recording classes use Boost.Chrono, and are therefore only
+ *      declared if tracing is enabled; the CMake option requires the Boost chrono component.
+ *
+ *      Every thread records its events in its own fixed-capacity ring buffer, so that recording
+ *      requires neither locking nor heap allocation once the buffer of a thread exists. When a
+ *      buffer is full, the oldest events are overwritten. Event names and categories must be
+ *      string literals (or otherwise outlive the recorder), since only their addresses are
+ *      stored. The recorded events should only be read or exported once the traced work has
+ *      finished, since the buffers of running threads are not locked.
+ *
+ */
+
+#ifndef TUDAT_TRACING_H
+#define TUDAT_TRACING_H
+
+#ifdef TUDAT_ENABLE_TRACING
+
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace tudat
+{
+namespace tracing
+{
+
+//! Types of trace events.
+enum TraceEventTypes
+{
+    durationEvent,
+    counterEvent
+};
+
+//! Trace event.
+/*!
+ * Single trace event, being either the execution of a scope (duration event) or the value of a
+ * counter at a given time (counter event). Times are given in nanoseconds since the start of the
+ * trace recorder.
+ */
+struct TraceEvent
+{
+public:
+
+    //! Category of event.
+    const char* category;
+
+    //! Name of event.
+    const char* name;
+
+    //! Type of event.
+    TraceEventTypes type;
+
+    //! Start time of event [ns].
+    boost::int64_t startTime;
+
+    //! Duration of event (zero for counter events) [ns].
+    boost::int64_t duration;
+
+    //! Value of counter (zero for duration events).
+    double value;
+};
+
+//! Ring buffer of trace events of a single thread.
+/*!
+ * Fixed-capacity ring buffer of trace events, recorded by a single thread. When the buffer is
+ * full, newly added events overwrite the oldest events.
+ */
+class TraceBuffer
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, allocating the storage of the ring buffer.
+     * \param capacity Maximum number of events that is stored.
+     * \param threadIndex Index of thread that records in this buffer.
+     */
+    TraceBuffer( const std::size_t capacity, const unsigned int threadIndex )
+        : events_( capacity ),
+          threadIndex_( threadIndex ),
+          nextEventIndex_( 0 ),
+          numberOfRecordedEvents_( 0 )
+    {
+        if ( capacity == 0 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Capacity of trace buffer must be positive" ) ) );
+        }
+    }
+
+    //! Add event.
+    /*!
+     * Adds an event to the buffer, overwriting the oldest event if the buffer is full.
+     * \param traceEvent Event that is added.
+     */
+    void addEvent( const TraceEvent& traceEvent )
+    {
+        events_[ nextEventIndex_ ] = traceEvent;
+        nextEventIndex_++;
+        if ( nextEventIndex_ == events_.size( ) )
+        {
+            nextEventIndex_ = 0;
+        }
+        numberOfRecordedEvents_++;
+    }
+
+    //! Get events.
+    /*!
+     * Returns the events that are currently stored, in the order in which they were added.
+     * \return Stored events.
+     */
+    std::vector< TraceEvent > getEvents( ) const
+    {
+        if ( numberOfRecordedEvents_ < events_.size( ) )
+        {
+            return std::vector< TraceEvent >( events_.begin( ),
+                                              events_.begin( ) + nextEventIndex_ );
+        }
+
+        std::vector< TraceEvent > events( events_.begin( ) + nextEventIndex_, events_.end( ) );
+        events.insert( events.end( ), events_.begin( ), events_.begin( ) + nextEventIndex_ );
+        return events;
+    }
+
+    //! Get number of events that have been overwritten.
+    /*!
+     * Returns the number of events that have been recorded, but were overwritten by newer events.
+     * \return Number of overwritten events.
+     */
+    std::size_t getNumberOfDroppedEvents( ) const
+    {
+        return numberOfRecordedEvents_ > events_.size( )
+                ? numberOfRecordedEvents_ - events_.size( ) : 0;
+    }
+
+    //! Get index of thread.
+    /*!
+     * Returns the index of the thread that records in this buffer (starting at 1, in order of
+     * first recording).
+     * \return Index of thread.
+     */
+    unsigned int getThreadIndex( ) const { return threadIndex_; }
+
+    //! Clear buffer.
+    /*!
+     * Removes all events from the buffer, retaining its capacity.
+     */
+    void clear( )
+    {
+        nextEventIndex_ = 0;
+        numberOfRecordedEvents_ = 0;
+    }
+
+protected:
+
+private:
+
+    //! Storage of ring buffer.
+    std::vector< TraceEvent > events_;
+
+    //! Index of thread that records in this buffer.
+    unsigned int threadIndex_;
+
+    //! Index at which the next event is stored.
+    std::size_t nextEventIndex_;
+
+    //! Total number of recorded events, including overwritten events.
+    std::size_t numberOfRecordedEvents_;
+};
+
+//! Typedef for shared-pointer to TraceBuffer.
+typedef boost::shared_ptr< TraceBuffer > TraceBufferPointer;
+
+//! Do nothing with a trace buffer.
+/*!
+ * Cleanup function of thread-specific trace buffer pointers. The buffers are owned by the trace
+ * recorder, such that their events remain available after the recording thread has finished.
+ * \param traceBuffer Trace buffer of finished thread.
+ */
+inline void retainTraceBuffer( TraceBuffer* traceBuffer )
+{
+    static_cast< void >( traceBuffer );
+}
+
+//! Trace recorder.
+/*!
+ * Process-wide recorder of trace events, which owns the trace buffers of all threads and exports
+ * their events in the Chrome trace event format, which can be viewed with chrome://tracing or
+ * compatible viewers. The single instance is obtained with getInstance( ).
+ */
+class TraceRecorder
+{
+public:
+
+    //! Typedef of clock used for time stamps.
+    typedef boost::chrono::high_resolution_clock Clock;
+
+    //! Get instance of trace recorder.
+    /*!
+     * Returns the process-wide instance of the trace recorder, which is created on first use.
+     * \return Trace recorder.
+     */
+    static TraceRecorder& getInstance( )
+    {
+        static TraceRecorder traceRecorder;
+        return traceRecorder;
+    }
+
+    //! Get current time.
+    /*!
+     * Returns the time elapsed since the creation of the recorder.
+     * \return Current time [ns].
+     */
+    boost::int64_t getCurrentTime( ) const
+    {
+        return boost::chrono::duration_cast< boost::chrono::nanoseconds >(
+                    Clock::now( ) - startTime_ ).count( );
+    }
+
+    //! Record event.
+    /*!
+     * Adds an event to the trace buffer of the calling thread, creating the buffer if this is
+     * the first event of the thread.
+     * \param traceEvent Event that is recorded.
+     */
+    void recordEvent( const TraceEvent& traceEvent )
+    {
+        TraceBuffer* traceBuffer = currentThreadBuffer_.get( );
+        if ( traceBuffer == NULL )
+        {
+            traceBuffer = createCurrentThreadBuffer( );
+        }
+        traceBuffer->addEvent( traceEvent );
+    }
+
+    //! Set capacity of trace buffers.
+    /*!
+     * Sets the capacity of the trace buffers of threads that have not recorded an event yet.
+     * \param bufferCapacity Maximum number of events stored per thread.
+     */
+    void setBufferCapacity( const std::size_t bufferCapacity )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex_ );
+        bufferCapacity_ = bufferCapacity;
+    }
+
+    //! Get trace buffers.
+    /*!
+     * Returns the trace buffers of all threads that have recorded events, in order of their
+     * first event.
+     * \return Trace buffers.
+     */
+    std::vector< TraceBufferPointer > getBuffers( )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex_ );
+        return traceBuffers_;
+    }
+
+    //! Clear all trace buffers.
+    /*!
+     * Removes all recorded events from the trace buffers of all threads.
+     */
+    void clear( )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex_ );
+        for ( unsigned int bufferIndex = 0; bufferIndex < traceBuffers_.size( ); bufferIndex++ )
+        {
+            traceBuffers_[ bufferIndex ]->clear( );
+        }
+    }
+
+    //! Write trace events in Chrome trace event format.
+    /*!
+     * Writes the events of all trace buffers as a JSON document in the Chrome trace event
+     * format. Duration events are written as complete events and counter events as counter
+     * events, with one thread in the timeline per trace buffer. Times are written in
+     * microseconds.
+     * \param outputStream Stream to which the trace is written.
+     */
+    void writeChromeTraceEvents( std::ostream& outputStream )
+    {
+        const std::vector< TraceBufferPointer > traceBuffers = getBuffers( );
+
+        // Store format of stream, and write times with nanosecond resolution.
+        const std::ios::fmtflags streamFlags = outputStream.flags( );
+        const std::streamsize streamPrecision = outputStream.precision( );
+        outputStream << std::fixed << std::setprecision( 3 );
+
+        outputStream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        bool isFirstEvent = true;
+        for ( unsigned int bufferIndex = 0; bufferIndex < traceBuffers.size( ); bufferIndex++ )
+        {
+            const unsigned int threadIndex = traceBuffers[ bufferIndex ]->getThreadIndex( );
+
+            // Write thread name as metadata event.
+            outputStream << ( isFirstEvent ? "" : "," ) << std::endl
+                         << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                         << threadIndex << ",\"args\":{\"name\":\"Thread " << threadIndex
+                         << "\"}}";
+            isFirstEvent = false;
+
+            const std::vector< TraceEvent > events = traceBuffers[ bufferIndex ]->getEvents( );
+            for ( unsigned int eventIndex = 0; eventIndex < events.size( ); eventIndex++ )
+            {
+                const TraceEvent& traceEvent = events[ eventIndex ];
+
+                outputStream << "," << std::endl << "{\"name\":";
+                writeJsonString( outputStream, traceEvent.name );
+                outputStream << ",\"cat\":";
+                writeJsonString( outputStream, traceEvent.category );
+                outputStream << ",\"pid\":1,\"tid\":" << threadIndex
+                             << ",\"ts\":" << 1.0e-3 * traceEvent.startTime;
+
+                if ( traceEvent.type == durationEvent )
+                {
+                    outputStream << ",\"ph\":\"X\",\"dur\":" << 1.0e-3 * traceEvent.duration
+                                 << "}";
+                }
+
+                else
+                {
+                    outputStream << ",\"ph\":\"C\",\"args\":{\"value\":";
+                    outputStream.unsetf( std::ios::floatfield );
+                    outputStream << std::setprecision( 17 ) << traceEvent.value;
+                    outputStream << std::fixed << std::setprecision( 3 ) << "}}";
+                }
+            }
+        }
+
+        outputStream << std::endl << "]}" << std::endl;
+
+        // Restore format of stream.
+        outputStream.flags( streamFlags );
+        outputStream.precision( streamPrecision );
+    }
+
+    //! Write trace events to file in Chrome trace event format.
+    /*!
+     * Writes the events of all trace buffers to a file, as a JSON document in the Chrome trace
+     * event format. An exception is thrown if the file can not be opened.
+     * \param filePath Path of output file.
+     */
+    void writeChromeTraceEvents( const std::string& filePath )
+    {
+        std::ofstream outputFile( filePath.c_str( ) );
+        if ( !outputFile )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Could not open trace file " + filePath ) ) );
+        }
+        writeChromeTraceEvents( outputFile );
+    }
+
+protected:
+
+private:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, which is private since the recorder is only obtained through
+     * getInstance( ).
+     */
+    TraceRecorder( )
+        : startTime_( Clock::now( ) ),
+          bufferCapacity_( 1 << 16 ),
+          currentThreadBuffer_( &retainTraceBuffer )
+    { }
+
+    //! Create trace buffer of current thread.
+    /*!
+     * Creates the trace buffer of the calling thread and registers it with the recorder.
+     * \return Trace buffer of current thread.
+     */
+    TraceBuffer* createCurrentThreadBuffer( )
+    {
+        boost::lock_guard< boost::mutex > lock( mutex_ );
+        const TraceBufferPointer traceBuffer = boost::make_shared< TraceBuffer >(
+                    bufferCapacity_, static_cast< unsigned int >( traceBuffers_.size( ) + 1 ) );
+        traceBuffers_.push_back( traceBuffer );
+        currentThreadBuffer_.reset( traceBuffer.get( ) );
+        return traceBuffer.get( );
+    }
+
+    //! Write string as JSON string literal.
+    /*!
+     * Writes a string as a JSON string literal, escaping quotes and backslashes.
+     * \param outputStream Stream to which the string is written.
+     * \param value String that is written.
+     */
+    static void writeJsonString( std::ostream& outputStream, const char* value )
+    {
+        outputStream << '"';
+        for ( const char* character = value; *character != '\0'; character++ )
+        {
+            if ( *character == '"' || *character == '\\' )
+            {
+                outputStream << '\\';
+            }
+            outputStream << *character;
+        }
+        outputStream << '"';
+    }
+
+    //! Start time of recorder.
+    const Clock::time_point startTime_;
+
+    //! Capacity of newly created trace buffers.
+    std::size_t bufferCapacity_;
+
+    //! Mutex protecting the registry of trace buffers.
+    boost::mutex mutex_;
+
+    //! Trace buffers of all threads.
+    std::vector< TraceBufferPointer > traceBuffers_;
+
+    //! Trace buffer of current thread (not owned).
+    boost::thread_specific_ptr< TraceBuffer > currentThreadBuffer_;
+};
+
+//! Scoped trace event.
+/*!
+ * Records a duration event spanning the lifetime of the object. Used through the
+ * TUDAT_TRACE_SCOPE macro.
+ */
+class ScopedTraceEvent
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, storing the start time of the event.
+     * \param category Category of event (string literal).
+     * \param name Name of event (string literal).
+     */
+    ScopedTraceEvent( const char* category, const char* name )
+        : category_( category ),
+          name_( name ),
+          startTime_( TraceRecorder::getInstance( ).getCurrentTime( ) )
+    { }
+
+    //! Destructor.
+    /*!
+     * Destructor, recording the event with the elapsed time as duration.
+     */
+    ~ScopedTraceEvent( )
+    {
+        TraceRecorder& traceRecorder = TraceRecorder::getInstance( );
+        TraceEvent traceEvent;
+        traceEvent.category = category_;
+        traceEvent.name = name_;
+        traceEvent.type = durationEvent;
+        traceEvent.startTime = startTime_;
+        traceEvent.duration = traceRecorder.getCurrentTime( ) - startTime_;
+        traceEvent.value = 0.0;
+        traceRecorder.recordEvent( traceEvent );
+    }
+
+protected:
+
+private:
+
+    //! Category of event.
+    const char* category_;
+
+    //! Name of event.
+    const char* name_;
+
+    //! Start time of event [ns].
+    boost::int64_t startTime_;
+};
+
+//! Record counter value.
+/*!
+ * Records the current value of a counter. Used through the TUDAT_TRACE_COUNTER macro.
+ * \param category Category of counter (string literal).
+ * \param name Name of counter (string literal).
+ * \param value Current value of counter.
+ */
+inline void recordCounter( const char* category, const char* name, const double value )
+{
+    TraceRecorder& traceRecorder = TraceRecorder::getInstance( );
+    TraceEvent traceEvent;
+    traceEvent.category = category;
+    traceEvent.name = name;
+    traceEvent.type = counterEvent;
+    traceEvent.startTime = traceRecorder.getCurrentTime( );
+    traceEvent.duration = 0;
+    traceEvent.value = value;
+    traceRecorder.recordEvent( traceEvent );
+}
+
+} // namespace tracing
+} // namespace tudat
+
+#endif // TUDAT_ENABLE_TRACING
+
+//! Concatenate two tokens after macro expansion.
+#define TUDAT_TRACE_CONCATENATE_TOKENS( firstToken, secondToken ) firstToken##secondToken
+#define TUDAT_TRACE_CONCATENATE( firstToken, secondToken ) \
+    TUDAT_TRACE_CONCATENATE_TOKENS( firstToken, secondToken )
+
+#ifdef TUDAT_ENABLE_TRACING
+
+//! Record the execution of the enclosing scope as a trace event.
+#define TUDAT_TRACE_SCOPE( category, name ) \
+    const tudat::tracing::ScopedTraceEvent TUDAT_TRACE_CONCATENATE( tudatTraceScope, __LINE__ )( \
+        category, name )
+
+//! Record the current value of a counter as a trace event.
+#define TUDAT_TRACE_COUNTER( category, name, value ) \
+    tudat::tracing::recordCounter( category, name, value )
+
+#else
+
+#define TUDAT_TRACE_SCOPE( category, name )
+#define TUDAT_TRACE_COUNTER( category, name, value )
+
+#endif
+
+#endif // TUDAT_TRACING_H
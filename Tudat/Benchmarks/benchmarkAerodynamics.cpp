@@ -0,0 +1,275 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140326    S. Vermeer        File created.
+ *      140331    S. Vermeer        Added benchmark of empirical thermosphere.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      The atmospheres are evaluated along a descending trajectory of 1000 points, either with
+ *      one (virtual) query per point, or with a single query for all points. The empirical
+ *      thermosphere is evaluated on a longitude-latitude map of 1000 points at a single time,
+ *      either with the time-dependent terms cached, or recomputed for each point.
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Astrodynamics/Aerodynamics/empiricalThermosphere.h"
+#include "Tudat/Astrodynamics/Aerodynamics/exponentialAtmosphere.h"
+#include "Tudat/Astrodynamics/Aerodynamics/tabulatedAtmosphere.h"
+#include "Tudat/Benchmarks/benchmarkTools.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Benchmark of evaluation of atmosphere along trajectory.
+class AtmosphereTrajectoryBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting the atmosphere model and the points along a descending trajectory at
+     * which it is evaluated.
+     * \param atmosphereModel Atmosphere model that is evaluated.
+     * \param useQueryAtMultiplePoints Boolean denoting whether all points are evaluated with a
+     *          single query (true), or with one query per point (false).
+     */
+    AtmosphereTrajectoryBenchmark( const aerodynamics::AtmosphereModelPointer atmosphereModel,
+                                   const bool useQueryAtMultiplePoints )
+        : atmosphereModel_( atmosphereModel ),
+          useQueryAtMultiplePoints_( useQueryAtMultiplePoints ),
+          densities_( numberOfPoints ),
+          pressures_( numberOfPoints ),
+          temperatures_( numberOfPoints )
+    {
+        for ( int i = 0; i < numberOfPoints; i++ )
+        {
+            altitudes_.push_back( 120.0e3 - 0.11e3 * static_cast< double >( i ) );
+            longitudes_.push_back( 1.0e-3 * static_cast< double >( i ) );
+            latitudes_.push_back( 0.5e-3 * static_cast< double >( i ) );
+            times_.push_back( 1.0 * static_cast< double >( i ) );
+        }
+    }
+
+    //! Evaluate atmosphere at all points.
+    void operator( )( )
+    {
+        if ( useQueryAtMultiplePoints_ )
+        {
+            atmosphereModel_->getAtmosphericProperties( altitudes_, longitudes_, latitudes_,
+                                                        times_, densities_, pressures_,
+                                                        temperatures_ );
+        }
+        else
+        {
+            for ( int i = 0; i < numberOfPoints; i++ )
+            {
+                const aerodynamics::AtmosphericProperties atmosphericProperties =
+                        atmosphereModel_->getAtmosphericProperties(
+                            altitudes_[ i ], longitudes_[ i ], latitudes_[ i ], times_[ i ] );
+                densities_[ i ] = atmosphericProperties.density;
+                pressures_[ i ] = atmosphericProperties.pressure;
+                temperatures_[ i ] = atmosphericProperties.temperature;
+            }
+        }
+        doNotOptimizeAway( densities_[ numberOfPoints - 1 ] );
+    }
+
+private:
+
+    //! Number of points along trajectory.
+    static const int numberOfPoints = 1000;
+
+    //! Atmosphere model that is evaluated.
+    aerodynamics::AtmosphereModelPointer atmosphereModel_;
+
+    //! Boolean denoting whether all points are evaluated with a single query.
+    bool useQueryAtMultiplePoints_;
+
+    //! Altitudes of points along trajectory.
+    std::vector< double > altitudes_;
+
+    //! Longitudes of points along trajectory.
+    std::vector< double > longitudes_;
+
+    //! Latitudes of points along trajectory.
+    std::vector< double > latitudes_;
+
+    //! Times of points along trajectory.
+    std::vector< double > times_;
+
+    //! Densities at points along trajectory.
+    std::vector< double > densities_;
+
+    //! Pressures at points along trajectory.
+    std::vector< double > pressures_;
+
+    //! Temperatures at points along trajectory.
+    std::vector< double > temperatures_;
+};
+
+//! Benchmark of evaluation of empirical thermosphere on density map.
+class EmpiricalThermosphereMapBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting the empirical thermosphere and the points of a longitude-latitude map
+     * at 400 km altitude, at which it is evaluated at a single time.
+     * \param empiricalThermosphere Empirical thermosphere that is evaluated.
+     * \param recomputeEpochTerms Boolean denoting whether the time-dependent terms are recomputed
+     *          for each point (true), or cached by the thermosphere (false).
+     */
+    EmpiricalThermosphereMapBenchmark(
+            const boost::shared_ptr< aerodynamics::EmpiricalThermosphere > empiricalThermosphere,
+            const bool recomputeEpochTerms )
+        : empiricalThermosphere_( empiricalThermosphere ),
+          recomputeEpochTerms_( recomputeEpochTerms ),
+          densities_( numberOfPoints )
+    {
+        for ( int i = 0; i < numberOfPoints; i++ )
+        {
+            longitudes_.push_back( 0.2 * static_cast< double >( i % 40 ) - 4.0 );
+            latitudes_.push_back( 0.05 * static_cast< double >( i / 40 ) - 0.6 );
+        }
+    }
+
+    //! Evaluate empirical thermosphere at all points.
+    void operator( )( )
+    {
+        const double altitude = 400.0e3;
+        const double time = 4.3e8;
+        for ( int i = 0; i < numberOfPoints; i++ )
+        {
+            if ( recomputeEpochTerms_ )
+            {
+                densities_[ i ] = empiricalThermosphere_->getAtmosphericProperties(
+                            altitude, longitudes_[ i ], latitudes_[ i ],
+                            empiricalThermosphere_->computeEpochTerms( time ) ).density;
+            }
+            else
+            {
+                densities_[ i ] = empiricalThermosphere_->getDensity(
+                            altitude, longitudes_[ i ], latitudes_[ i ], time );
+            }
+        }
+        doNotOptimizeAway( densities_[ numberOfPoints - 1 ] );
+    }
+
+private:
+
+    //! Number of points of map.
+    static const int numberOfPoints = 1000;
+
+    //! Empirical thermosphere that is evaluated.
+    boost::shared_ptr< aerodynamics::EmpiricalThermosphere > empiricalThermosphere_;
+
+    //! Boolean denoting whether the time-dependent terms are recomputed for each point.
+    bool recomputeEpochTerms_;
+
+    //! Longitudes of points of map.
+    std::vector< double > longitudes_;
+
+    //! Latitudes of points of map.
+    std::vector< double > latitudes_;
+
+    //! Densities at points of map.
+    std::vector< double > densities_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute aerodynamics benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat;
+    using namespace tudat::benchmarks;
+    using namespace tudat::aerodynamics;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "Aerodynamics" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    const boost::shared_ptr< ExponentialAtmosphere > exponentialAtmosphere =
+            boost::make_shared< ExponentialAtmosphere >( );
+    exponentialAtmosphere->setPredefinedExponentialAtmosphere( ExponentialAtmosphere::earth );
+
+    const boost::shared_ptr< TabulatedAtmosphere > tabulatedAtmosphere =
+            boost::make_shared< TabulatedAtmosphere >( );
+    tabulatedAtmosphere->initialize( input_output::getTudatRootPath( ) +
+                                     "/External/AtmosphereTables/" +
+                                     "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" );
+
+    const boost::shared_ptr< EmpiricalThermosphere > empiricalThermosphere =
+            boost::make_shared< EmpiricalThermosphere >( );
+
+    benchmarkSuite.runBenchmark( "exponentialAtmosphere/trajectory1000/singlePoints",
+                                 AtmosphereTrajectoryBenchmark( exponentialAtmosphere, false ),
+                                 1000 );
+    benchmarkSuite.runBenchmark( "exponentialAtmosphere/trajectory1000/multiplePoints",
+                                 AtmosphereTrajectoryBenchmark( exponentialAtmosphere, true ),
+                                 1000 );
+    benchmarkSuite.runBenchmark( "tabulatedAtmosphere/trajectory1000/singlePoints",
+                                 AtmosphereTrajectoryBenchmark( tabulatedAtmosphere, false ),
+                                 1000 );
+    benchmarkSuite.runBenchmark( "tabulatedAtmosphere/trajectory1000/multiplePoints",
+                                 AtmosphereTrajectoryBenchmark( tabulatedAtmosphere, true ),
+                                 1000 );
+    benchmarkSuite.runBenchmark( "empiricalThermosphere/densityMap1000/cachedEpochTerms",
+                                 EmpiricalThermosphereMapBenchmark( empiricalThermosphere, false ),
+                                 200 );
+    benchmarkSuite.runBenchmark( "empiricalThermosphere/densityMap1000/recomputedEpochTerms",
+                                 EmpiricalThermosphereMapBenchmark( empiricalThermosphere, true ),
+                                 200 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      The conversion is benchmarked both with the default root finder, which is created anew for
+ *      every conversion, and with a root finder that is shared between conversions.
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanAnomalyToEccentricAnomaly.h"
+#include "Tudat/Benchmarks/benchmarkTools.h"
+#include "Tudat/Mathematics/RootFinders/newtonRaphson.h"
+#include "Tudat/Mathematics/RootFinders/terminationConditions.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Benchmark of conversion from mean to eccentric anomaly.
+class MeanToEccentricAnomalyConversionBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a grid of eccentricities and mean anomalies that is cycled through.
+     * \param useSharedRootFinder True to share a single root finder between conversions, false to
+     *          use the default root finder of the conversion class.
+     */
+    MeanToEccentricAnomalyConversionBenchmark( const bool useSharedRootFinder )
+        : eccentricityIndex_( 0 ),
+          meanAnomalyIndex_( 0 )
+    {
+        using namespace root_finders;
+        using namespace root_finders::termination_conditions;
+
+        for ( unsigned int index = 0; index < 10; index++ )
+        {
+            eccentricities_.push_back( 0.095 * index );
+        }
+
+        for ( unsigned int index = 0; index < 37; index++ )
+        {
+            meanAnomalies_.push_back( 0.17 * index );
+        }
+
+        if ( useSharedRootFinder )
+        {
+            // Use the same root finder settings as the conversion class.
+            boost::shared_ptr< RootAbsoluteToleranceTerminationCondition > terminationCondition
+                    = boost::make_shared< RootAbsoluteToleranceTerminationCondition >(
+                        1.0e-13, 1000 );
+            rootFinder_ = boost::make_shared< NewtonRaphson >(
+                        boost::bind( &RootAbsoluteToleranceTerminationCondition::
+                                     checkTerminationCondition,
+                                     terminationCondition, _1, _2, _3, _4, _5 ) );
+        }
+    }
+
+    //! Convert next combination of eccentricity and mean anomaly.
+    void operator( )( )
+    {
+        basic_astrodynamics::orbital_element_conversions::ConvertMeanAnomalyToEccentricAnomaly
+                converter( eccentricities_[ eccentricityIndex_ ],
+                           meanAnomalies_[ meanAnomalyIndex_ ],
+                           true, TUDAT_NAN, rootFinder_ );
+        doNotOptimizeAway( converter.convert( ) );
+
+        eccentricityIndex_ = ( eccentricityIndex_ + 1 ) % eccentricities_.size( );
+        meanAnomalyIndex_ = ( meanAnomalyIndex_ + 1 ) % meanAnomalies_.size( );
+    }
+
+private:
+
+    //! Eccentricities that are cycled through.
+    std::vector< double > eccentricities_;
+
+    //! Mean anomalies that are cycled through [rad].
+    std::vector< double > meanAnomalies_;
+
+    //! Index of next eccentricity.
+    unsigned int eccentricityIndex_;
+
+    //! Index of next mean anomaly.
+    unsigned int meanAnomalyIndex_;
+
+    //! Shared root finder; empty to use the default root finder.
+    root_finders::RootFinderPointer rootFinder_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute basic astrodynamics benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat::benchmarks;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "BasicAstrodynamics" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    benchmarkSuite.runBenchmark( "meanToEccentricAnomaly/defaultRootFinder",
+                                 MeanToEccentricAnomalyConversionBenchmark( false ), 100000 );
+    benchmarkSuite.runBenchmark( "meanToEccentricAnomaly/sharedRootFinder",
+                                 MeanToEccentricAnomalyConversionBenchmark( true ), 100000 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
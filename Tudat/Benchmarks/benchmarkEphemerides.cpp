@@ -0,0 +1,163 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140321    S. Vermeer        File created.
+ *      140324    S. Vermeer        Added tabulated ephemeris benchmark.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      The Chebyshev and tabulated ephemerides are created from the approximate planet positions
+ *      of Mars over one year, so that all benchmarks retrieve (nearly) the same states. The
+ *      tabulated ephemeris uses daily states and 8-point Lagrange interpolation.
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositions.h"
+#include "Tudat/Astrodynamics/Ephemerides/chebyshevEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+#include "Tudat/Benchmarks/benchmarkTools.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Benchmark of state retrieval from ephemeris.
+class EphemerisStateRetrievalBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting the ephemeris and the interval through which the retrieval time is
+     * stepped.
+     * \param ephemeris Ephemeris from which states are retrieved.
+     * \param intervalDuration Duration of interval through which retrieval time is stepped [s].
+     */
+    EphemerisStateRetrievalBenchmark( const ephemerides::EphemerisPointer ephemeris,
+                                      const double intervalDuration )
+        : ephemeris_( ephemeris ),
+          intervalDuration_( intervalDuration ),
+          time_( 0.0 )
+    { }
+
+    //! Retrieve state at next time.
+    void operator( )( )
+    {
+        doNotOptimizeAway( ephemeris_->getCartesianStateFromEphemeris(
+                               time_, basic_astrodynamics::JULIAN_DAY_ON_J2000 )( 0 ) );
+
+        // Step by a duration that is not commensurate with the segments of the ephemeris.
+        time_ += 3917.3;
+        if ( time_ > intervalDuration_ )
+        {
+            time_ -= intervalDuration_;
+        }
+    }
+
+private:
+
+    //! Ephemeris from which states are retrieved.
+    ephemerides::EphemerisPointer ephemeris_;
+
+    //! Duration of interval through which retrieval time is stepped [s].
+    double intervalDuration_;
+
+    //! Time of next retrieval, in seconds since J2000.
+    double time_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute ephemerides benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat;
+    using namespace tudat::benchmarks;
+    using namespace tudat::ephemerides;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "Ephemerides" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    const double intervalDuration = 365.25 * physical_constants::JULIAN_DAY;
+    const EphemerisPointer approximateEphemeris = boost::make_shared< ApproximatePlanetPositions >(
+                ApproximatePlanetPositionsBase::mars );
+    const EphemerisPointer chebyshevEphemeris = createChebyshevEphemeris(
+                approximateEphemeris, 0.0, intervalDuration,
+                basic_astrodynamics::JULIAN_DAY_ON_J2000, 10.0, 1.0E-5 );
+
+    std::map< double, tudat::basic_mathematics::Vector6d > stateHistory;
+    for ( int day = 0; day <= 366; day++ )
+    {
+        const double time = static_cast< double >( day ) * physical_constants::JULIAN_DAY;
+        stateHistory[ time ] = approximateEphemeris->getCartesianStateFromEphemeris(
+                    time, basic_astrodynamics::JULIAN_DAY_ON_J2000 );
+    }
+    const EphemerisPointer tabulatedEphemeris = boost::make_shared< TabulatedEphemeris >(
+                stateHistory, basic_astrodynamics::JULIAN_DAY_ON_J2000,
+                TabulatedEphemeris::lagrangeInterpolation, 8, interpolators::uniformGrid );
+
+    benchmarkSuite.runBenchmark(
+                "marsState/approximatePlanetPositions",
+                EphemerisStateRetrievalBenchmark( approximateEphemeris, intervalDuration ),
+                100000 );
+    benchmarkSuite.runBenchmark(
+                "marsState/chebyshevEphemeris",
+                EphemerisStateRetrievalBenchmark( chebyshevEphemeris, intervalDuration ),
+                100000 );
+
+    benchmarkSuite.runBenchmark(
+                "marsState/tabulatedEphemeris",
+                EphemerisStateRetrievalBenchmark( tabulatedEphemeris, intervalDuration ),
+                100000 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
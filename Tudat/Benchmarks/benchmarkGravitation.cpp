@@ -0,0 +1,152 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      The position of the body subject to the acceleration changes on every call, such that the
+ *      back-end cache of Legendre polynomials does not return results of a previous call, as is
+ *      the case during a numerical propagation.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Benchmarks/benchmarkTools.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Benchmark of spherical harmonics gravitational acceleration up to a given degree.
+class SphericalHarmonicsGravityBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a synthetic, geodesy-normalized gravity field up to given degree and
+     * order.
+     * \param maximumDegree Maximum degree and order of gravity field.
+     */
+    SphericalHarmonicsGravityBenchmark( const int maximumDegree )
+        : cosineCoefficients_( Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 ) ),
+          sineCoefficients_( Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 ) ),
+          angle_( 0.0 )
+    {
+        cosineCoefficients_( 0, 0 ) = 1.0;
+        for ( int degree = 2; degree <= maximumDegree; degree++ )
+        {
+            for ( int order = 0; order <= degree; order++ )
+            {
+                cosineCoefficients_( degree, order ) = 1.0e-6 / ( degree * degree );
+                if ( order > 0 )
+                {
+                    sineCoefficients_( degree, order ) = 0.5e-6 / ( degree * degree );
+                }
+            }
+        }
+    }
+
+    //! Compute acceleration at next position.
+    void operator( )( )
+    {
+        const double earthGravitationalParameter = 3.986004418e14;
+        const double earthEquatorialRadius = 6378137.0;
+        const double orbitalRadius = 7.0e6;
+
+        angle_ += 1.0e-3;
+        const double latitude = 0.9 * std::sin( 0.7 * angle_ );
+        const Eigen::Vector3d position(
+                    orbitalRadius * std::cos( latitude ) * std::cos( angle_ ),
+                    orbitalRadius * std::cos( latitude ) * std::sin( angle_ ),
+                    orbitalRadius * std::sin( latitude ) );
+
+        doNotOptimizeAway( gravitation::computeGeodesyNormalizedGravitationalAccelerationSum(
+                               position, earthGravitationalParameter, earthEquatorialRadius,
+                               cosineCoefficients_, sineCoefficients_ ).sum( ) );
+    }
+
+private:
+
+    //! Geodesy-normalized cosine coefficients.
+    Eigen::MatrixXd cosineCoefficients_;
+
+    //! Geodesy-normalized sine coefficients.
+    Eigen::MatrixXd sineCoefficients_;
+
+    //! Angle that determines current position [rad].
+    double angle_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute gravitation benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat::benchmarks;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "Gravitation" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    // Benchmark acceleration computation for increasing degree and order.
+    const int maximumDegrees[ ] = { 2, 4, 8, 16, 32 };
+    for ( unsigned int index = 0; index < sizeof( maximumDegrees ) / sizeof( int ); index++ )
+    {
+        std::stringstream benchmarkName;
+        benchmarkName << "sphericalHarmonicsGravity/degree" << maximumDegrees[ index ];
+        benchmarkSuite.runBenchmark(
+                    benchmarkName.str( ),
+                    SphericalHarmonicsGravityBenchmark( maximumDegrees[ index ] ),
+                    200000 / ( maximumDegrees[ index ] * maximumDegrees[ index ] ) + 100 );
+    }
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
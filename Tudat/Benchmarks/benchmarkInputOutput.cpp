@@ -0,0 +1,171 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      Every iteration reads and parses a complete file from disk, such that the timings include
+ *      file access. The first (untimed) repetition ensures that the files are in the file system
+ *      cache.
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <TudatCore/InputOutput/matrixTextFileReader.h>
+
+#include "Tudat/Benchmarks/benchmarkTools.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/twoLineElementsTextFileReader.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Benchmark of reading and parsing a file of two-line elements.
+class TwoLineElementsParsingBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, taking the name of the TLE file in the InputOutput unit test directory.
+     * \param fileName Name of TLE file.
+     * \param numberOfLinesPerTwoLineElement Number of lines per TLE (2 or 3).
+     */
+    TwoLineElementsParsingBenchmark( const std::string& fileName,
+                                     const unsigned int numberOfLinesPerTwoLineElement )
+        : fileName_( fileName ),
+          numberOfLinesPerTwoLineElement_( numberOfLinesPerTwoLineElement )
+    { }
+
+    //! Read and parse TLE file.
+    void operator( )( )
+    {
+        using input_output::TwoLineElementsTextFileReader;
+
+        TwoLineElementsTextFileReader twoLineElementsTextFileReader;
+        twoLineElementsTextFileReader.setLineNumberTypeForTwoLineElementInputData(
+                    numberOfLinesPerTwoLineElement_ == 2
+                    ? TwoLineElementsTextFileReader::twoLineType
+                    : TwoLineElementsTextFileReader::threeLineType );
+        twoLineElementsTextFileReader.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+        twoLineElementsTextFileReader.setFileName( fileName_ );
+        twoLineElementsTextFileReader.openFile( );
+        twoLineElementsTextFileReader.readAndStoreData( );
+        twoLineElementsTextFileReader.closeFile( );
+        twoLineElementsTextFileReader.setCurrentYear( 2011 );
+        twoLineElementsTextFileReader.storeTwoLineElementData( );
+
+        doNotOptimizeAway( twoLineElementsTextFileReader.getNumberOfObjects( ) );
+    }
+
+private:
+
+    //! Name of TLE file.
+    std::string fileName_;
+
+    //! Number of lines per TLE.
+    unsigned int numberOfLinesPerTwoLineElement_;
+};
+
+//! Benchmark of reading a matrix from a text file.
+class MatrixTextFileReadingBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, taking the path of the file that is read, relative to the Tudat root path.
+     * \param relativeFilePath Path of the file relative to the Tudat root path.
+     */
+    MatrixTextFileReadingBenchmark( const std::string& relativeFilePath )
+        : absoluteFilePath_( input_output::getTudatRootPath( ) + relativeFilePath )
+    { }
+
+    //! Read matrix from file.
+    void operator( )( )
+    {
+        const Eigen::MatrixXd matrix
+                = input_output::readMatrixFromFile( absoluteFilePath_, " \t", "%" );
+        doNotOptimizeAway( matrix( 0, 0 ) );
+    }
+
+private:
+
+    //! Absolute path of file that is read.
+    std::string absoluteFilePath_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute input/output benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat::benchmarks;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "InputOutput" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    benchmarkSuite.runBenchmark(
+                "twoLineElements/twoLineFile",
+                TwoLineElementsParsingBenchmark( "testTwoLineElementsTextFile2Line.txt", 2 ),
+                200 );
+    benchmarkSuite.runBenchmark(
+                "twoLineElements/threeLineFile",
+                TwoLineElementsParsingBenchmark( "testTwoLineElementsTextFile3Line.txt", 3 ),
+                200 );
+    benchmarkSuite.runBenchmark(
+                "readMatrixFromFile/atmosphereTable",
+                MatrixTextFileReadingBenchmark(
+                    "/External/AtmosphereTables/"
+                    "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat" ), 10 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
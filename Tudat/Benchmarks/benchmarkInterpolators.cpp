@@ -0,0 +1,443 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140310    S. Vermeer        Added uniform grid look-up scheme benchmarks.
+ *      140314    S. Vermeer        Added 5-dimensional multi-linear interpolation benchmark.
+ *      140317    S. Vermeer        Added precomputed-coefficient and batch cubic spline benchmarks.
+ *      140326    S. Vermeer        Added multi-linear interpolator construction benchmarks.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      Interpolation is benchmarked for both sequential target values, as found during a
+ *      numerical propagation, and for uniformly distributed random target values. The random
+ *      target values are generated with a fixed seed, such that all runs use the same sequence.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/multi_array.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Benchmarks/benchmarkTools.h"
+#include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/multiLinearInterpolator.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Number of precomputed random target values.
+const unsigned int numberOfRandomTargetValues = 1024;
+
+//! Number of nodes of cubic spline.
+const unsigned int numberOfCubicSplineNodes = 1000;
+
+//! Generate random target values.
+/*!
+ * Generates a reproducible sequence of uniformly distributed random target values.
+ * \param lowerBound Lower bound of target values.
+ * \param upperBound Upper bound of target values.
+ * \param seed Seed of random number generator.
+ * \return Random target values.
+ */
+std::vector< double > generateRandomTargetValues( const double lowerBound,
+                                                  const double upperBound,
+                                                  const unsigned int seed )
+{
+    boost::random::mt19937 randomNumberGenerator( seed );
+    boost::random::uniform_real_distribution< double > distribution( lowerBound, upperBound );
+
+    std::vector< double > targetValues( numberOfRandomTargetValues );
+    for ( unsigned int index = 0; index < numberOfRandomTargetValues; index++ )
+    {
+        targetValues[ index ] = distribution( randomNumberGenerator );
+    }
+    return targetValues;
+}
+
+//! Benchmark of cubic spline interpolation.
+class CubicSplineInterpolationBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a cubic spline through 1000 samples of a sine function.
+     * \param useRandomAccess True for random target values, false for sequential target values.
+     * \param lookupScheme Look-up scheme used by interpolator.
+     * \param precomputePolynomialCoefficients Flag whether polynomial coefficients are
+     *          precomputed.
+     */
+    CubicSplineInterpolationBenchmark(
+            const bool useRandomAccess,
+            const interpolators::AvailableLookupScheme lookupScheme
+            = interpolators::huntingAlgorithm,
+            const bool precomputePolynomialCoefficients = false )
+        : useRandomAccess_( useRandomAccess ),
+          targetValueIndex_( 0 ),
+          sequentialTargetValue_( 0.0 )
+    {
+        std::vector< double > independentValues( numberOfCubicSplineNodes );
+        std::vector< double > dependentValues( numberOfCubicSplineNodes );
+        for ( unsigned int index = 0; index < numberOfCubicSplineNodes; index++ )
+        {
+            independentValues[ index ] = 0.1 * index;
+            dependentValues[ index ] = std::sin( independentValues[ index ] );
+        }
+
+        interpolator_ = boost::make_shared< interpolators::CubicSplineInterpolatorDouble >(
+                    independentValues, dependentValues, lookupScheme,
+                    precomputePolynomialCoefficients );
+        randomTargetValues_ = generateRandomTargetValues(
+                    0.0, independentValues.back( ), 42 );
+    }
+
+    //! Interpolate at next target value.
+    void operator( )( )
+    {
+        double targetValue;
+        if ( useRandomAccess_ )
+        {
+            targetValue = randomTargetValues_[ targetValueIndex_ ];
+            targetValueIndex_ = ( targetValueIndex_ + 1 ) % numberOfRandomTargetValues;
+        }
+
+        else
+        {
+            sequentialTargetValue_ += 0.01;
+            if ( sequentialTargetValue_ >= 0.1 * ( numberOfCubicSplineNodes - 1 ) )
+            {
+                sequentialTargetValue_ = 0.0;
+            }
+            targetValue = sequentialTargetValue_;
+        }
+
+        doNotOptimizeAway( interpolator_->interpolate( targetValue ) );
+    }
+
+private:
+
+    //! Interpolator.
+    boost::shared_ptr< interpolators::CubicSplineInterpolatorDouble > interpolator_;
+
+    //! Flag whether random target values are used.
+    bool useRandomAccess_;
+
+    //! Random target values.
+    std::vector< double > randomTargetValues_;
+
+    //! Index of next random target value.
+    unsigned int targetValueIndex_;
+
+    //! Current sequential target value.
+    double sequentialTargetValue_;
+};
+
+//! Benchmark of batch cubic spline interpolation.
+class BatchCubicSplineInterpolationBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a cubic spline with precomputed polynomial coefficients through
+     * 1000 samples of a sine function, and a batch of sequential target values.
+     */
+    BatchCubicSplineInterpolationBenchmark( )
+    {
+        std::vector< double > independentValues( numberOfCubicSplineNodes );
+        std::vector< double > dependentValues( numberOfCubicSplineNodes );
+        for ( unsigned int index = 0; index < numberOfCubicSplineNodes; index++ )
+        {
+            independentValues[ index ] = 0.1 * index;
+            dependentValues[ index ] = std::sin( independentValues[ index ] );
+        }
+
+        interpolator_ = boost::make_shared< interpolators::CubicSplineInterpolatorDouble >(
+                    independentValues, dependentValues, interpolators::huntingAlgorithm, true );
+
+        targetValues_.resize( numberOfBatchTargetValues );
+        for ( unsigned int index = 0; index < numberOfBatchTargetValues; index++ )
+        {
+            targetValues_[ index ] = 0.1 * ( numberOfCubicSplineNodes - 1 ) * index
+                    / numberOfBatchTargetValues;
+        }
+        interpolatedValues_.resize( numberOfBatchTargetValues );
+    }
+
+    //! Interpolate at batch of target values.
+    void operator( )( )
+    {
+        interpolator_->interpolateBatch( targetValues_, interpolatedValues_ );
+        doNotOptimizeAway( interpolatedValues_.back( ) );
+    }
+
+    //! Number of target values per batch.
+    static const unsigned int numberOfBatchTargetValues = 10000;
+
+private:
+
+    //! Interpolator.
+    boost::shared_ptr< interpolators::CubicSplineInterpolatorDouble > interpolator_;
+
+    //! Target values.
+    std::vector< double > targetValues_;
+
+    //! Interpolated values.
+    std::vector< double > interpolatedValues_;
+};
+
+//! Benchmark of multi-linear interpolation.
+template< int NumberOfDimensions >
+class MultiLinearInterpolationBenchmark
+{
+public:
+
+    //! Typedef of interpolator.
+    typedef interpolators::MultiLinearInterpolator< double, double, NumberOfDimensions >
+    Interpolator;
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a multi-linear interpolator on a uniform grid of the product of
+     * sine functions, with the given number of points per dimension.
+     * \param numberOfPointsPerDimension Number of grid points per dimension.
+     * \param lookupScheme Look-up scheme used by interpolator.
+     */
+    MultiLinearInterpolationBenchmark(
+            const int numberOfPointsPerDimension,
+            const interpolators::AvailableLookupScheme lookupScheme
+            = interpolators::huntingAlgorithm )
+        : targetValueIndex_( 0 )
+    {
+        // Set grid points.
+        std::vector< double > gridPoints( numberOfPointsPerDimension );
+        for ( int index = 0; index < numberOfPointsPerDimension; index++ )
+        {
+            gridPoints[ index ] = 0.1 * index;
+        }
+        const std::vector< std::vector< double > > independentValues(
+                    NumberOfDimensions, gridPoints );
+
+        // Set dependent data.
+        boost::array< int, NumberOfDimensions > shape;
+        shape.fill( numberOfPointsPerDimension );
+        boost::multi_array< double, NumberOfDimensions > dependentData( shape );
+        for ( unsigned int elementIndex = 0; elementIndex < dependentData.num_elements( );
+              elementIndex++ )
+        {
+            double value = 1.0;
+            unsigned int remainder = elementIndex;
+            for ( int dimension = 0; dimension < NumberOfDimensions; dimension++ )
+            {
+                value *= std::sin( gridPoints[ remainder % numberOfPointsPerDimension ] );
+                remainder /= numberOfPointsPerDimension;
+            }
+            dependentData.data( )[ elementIndex ] = value;
+        }
+
+        interpolator_ = boost::make_shared< Interpolator >(
+                    independentValues, dependentData, lookupScheme );
+
+        // Set random target values.
+        targetValues_.resize( numberOfRandomTargetValues,
+                              std::vector< double >( NumberOfDimensions ) );
+        for ( int dimension = 0; dimension < NumberOfDimensions; dimension++ )
+        {
+            const std::vector< double > randomValues = generateRandomTargetValues(
+                        0.0, gridPoints.back( ), 42 + dimension );
+            for ( unsigned int index = 0; index < numberOfRandomTargetValues; index++ )
+            {
+                targetValues_[ index ][ dimension ] = randomValues[ index ];
+            }
+        }
+    }
+
+    //! Interpolate at next target value.
+    void operator( )( )
+    {
+        doNotOptimizeAway( interpolator_->interpolate( targetValues_[ targetValueIndex_ ] ) );
+        targetValueIndex_ = ( targetValueIndex_ + 1 ) % numberOfRandomTargetValues;
+    }
+
+private:
+
+    //! Interpolator.
+    boost::shared_ptr< Interpolator > interpolator_;
+
+    //! Random target values.
+    std::vector< std::vector< double > > targetValues_;
+
+    //! Index of next target value.
+    unsigned int targetValueIndex_;
+};
+
+//! Benchmark of construction of multi-linear interpolator on large data set.
+class MultiLinearInterpolatorConstructionBenchmark
+{
+public:
+
+    //! Typedef of interpolator.
+    typedef interpolators::MultiLinearInterpolator< double, double, 3 > Interpolator;
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a three-dimensional data set with 100 points per dimension.
+     * \param useSharedData Boolean denoting whether interpolators are constructed from shared
+     *          data (true) or from copied data (false).
+     */
+    MultiLinearInterpolatorConstructionBenchmark( const bool useSharedData )
+        : useSharedData_( useSharedData ),
+          targetValues_( 3, 0.55 )
+    {
+        std::vector< double > gridPoints( numberOfPointsPerDimension );
+        for ( int index = 0; index < numberOfPointsPerDimension; index++ )
+        {
+            gridPoints[ index ] = 0.1 * index;
+        }
+        independentValues_.resize( 3, gridPoints );
+        sharedIndependentValues_.assign( independentValues_.begin( ),
+                                         independentValues_.end( ) );
+
+        boost::shared_ptr< Interpolator::DependentDataArray > dependentData =
+                boost::make_shared< Interpolator::DependentDataArray >(
+                    boost::extents[ numberOfPointsPerDimension ][ numberOfPointsPerDimension ]
+                    [ numberOfPointsPerDimension ] );
+        for ( unsigned int elementIndex = 0; elementIndex < dependentData->num_elements( );
+              elementIndex++ )
+        {
+            dependentData->data( )[ elementIndex ] = std::sin( 0.001 * elementIndex );
+        }
+        dependentData_ = dependentData;
+    }
+
+    //! Construct interpolator, and interpolate once.
+    void operator( )( )
+    {
+        if ( useSharedData_ )
+        {
+            Interpolator interpolator( sharedIndependentValues_, dependentData_ );
+            doNotOptimizeAway( interpolator.interpolate( targetValues_ ) );
+        }
+        else
+        {
+            Interpolator interpolator( independentValues_, *dependentData_ );
+            doNotOptimizeAway( interpolator.interpolate( targetValues_ ) );
+        }
+    }
+
+private:
+
+    //! Number of grid points per dimension.
+    static const int numberOfPointsPerDimension = 100;
+
+    //! Boolean denoting whether interpolators are constructed from shared data.
+    bool useSharedData_;
+
+    //! Independent variable values.
+    std::vector< std::vector< double > > independentValues_;
+
+    //! Shared independent variable values.
+    std::vector< interpolators::SharedImmutableVector< double > > sharedIndependentValues_;
+
+    //! Shared dependent data.
+    boost::shared_ptr< const Interpolator::DependentDataArray > dependentData_;
+
+    //! Target value of interpolation.
+    std::vector< double > targetValues_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute interpolator benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat::benchmarks;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "Interpolators" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    benchmarkSuite.runBenchmark( "cubicSpline/sequentialAccess",
+                                 CubicSplineInterpolationBenchmark( false ), 100000 );
+    benchmarkSuite.runBenchmark( "cubicSpline/randomAccess",
+                                 CubicSplineInterpolationBenchmark( true ), 100000 );
+    benchmarkSuite.runBenchmark( "multiLinear2D/randomAccess",
+                                 MultiLinearInterpolationBenchmark< 2 >( 100 ), 100000 );
+    benchmarkSuite.runBenchmark( "multiLinear3D/randomAccess",
+                                 MultiLinearInterpolationBenchmark< 3 >( 30 ), 100000 );
+    benchmarkSuite.runBenchmark( "multiLinear5D/randomAccess",
+                                 MultiLinearInterpolationBenchmark< 5 >( 10 ), 100000 );
+    benchmarkSuite.runBenchmark( "cubicSpline/randomAccess/uniformGrid",
+                                 CubicSplineInterpolationBenchmark(
+                                     true, tudat::interpolators::uniformGrid ), 100000 );
+    benchmarkSuite.runBenchmark( "cubicSpline/sequentialAccess/polynomialCoefficients",
+                                 CubicSplineInterpolationBenchmark(
+                                     false, tudat::interpolators::huntingAlgorithm, true ),
+                                 100000 );
+    benchmarkSuite.runBenchmark( "cubicSpline/randomAccess/polynomialCoefficients",
+                                 CubicSplineInterpolationBenchmark(
+                                     true, tudat::interpolators::huntingAlgorithm, true ),
+                                 100000 );
+    benchmarkSuite.runBenchmark( "cubicSpline/batch10000/polynomialCoefficients",
+                                 BatchCubicSplineInterpolationBenchmark( ), 100 );
+    benchmarkSuite.runBenchmark( "multiLinear2D/randomAccess/uniformGrid",
+                                 MultiLinearInterpolationBenchmark< 2 >(
+                                     100, tudat::interpolators::uniformGrid ), 100000 );
+    benchmarkSuite.runBenchmark( "multiLinear3D/randomAccess/uniformGrid",
+                                 MultiLinearInterpolationBenchmark< 3 >(
+                                     30, tudat::interpolators::uniformGrid ), 100000 );
+    benchmarkSuite.runBenchmark( "multiLinear3D/construction/copiedData",
+                                 MultiLinearInterpolatorConstructionBenchmark( false ), 100 );
+    benchmarkSuite.runBenchmark( "multiLinear3D/construction/sharedData",
+                                 MultiLinearInterpolatorConstructionBenchmark( true ), 100 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
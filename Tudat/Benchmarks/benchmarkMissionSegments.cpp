@@ -0,0 +1,174 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      Both Lambert routines are benchmarked on the same set of heliocentric transfers, which is
+ *      cycled through.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include <TudatCore/Astrodynamics/BasicAstrodynamics/physicalConstants.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "Tudat/Benchmarks/benchmarkTools.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Available Lambert routines.
+enum LambertRoutines
+{
+    izzo,
+    gooding
+};
+
+//! Benchmark of Lambert routines.
+class LambertRoutineBenchmark
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up a set of single-revolution heliocentric transfers from an orbit at
+     * 1 AU to an orbit at 1.5 AU, with varying transfer angle (up to 165 degrees) and time of
+     * flight.
+     * \param lambertRoutine Lambert routine that is benchmarked.
+     */
+    LambertRoutineBenchmark( const LambertRoutines lambertRoutine )
+        : lambertRoutine_( lambertRoutine ),
+          transferIndex_( 0 )
+    {
+        using basic_mathematics::mathematical_constants::PI;
+        using physical_constants::ASTRONOMICAL_UNIT;
+        using physical_constants::JULIAN_DAY;
+
+        for ( unsigned int index = 0; index < 16; index++ )
+        {
+            const double transferAngle = ( 30.0 + 9.0 * index ) * PI / 180.0;
+            departurePositions_.push_back(
+                        Eigen::Vector3d( ASTRONOMICAL_UNIT, 0.0, 0.0 ) );
+            arrivalPositions_.push_back(
+                        1.5 * ASTRONOMICAL_UNIT * Eigen::Vector3d(
+                            std::cos( transferAngle ), std::sin( transferAngle ),
+                            0.05 * std::sin( transferAngle ) ) );
+            timesOfFlight_.push_back( ( 100.0 + 10.0 * index ) * JULIAN_DAY );
+        }
+    }
+
+    //! Solve next Lambert problem.
+    void operator( )( )
+    {
+        const double sunGravitationalParameter = 1.32712440018e20;
+
+        Eigen::Vector3d departureVelocity, arrivalVelocity;
+        if ( lambertRoutine_ == izzo )
+        {
+            mission_segments::solveLambertProblemIzzo(
+                        departurePositions_[ transferIndex_ ], arrivalPositions_[ transferIndex_ ],
+                        timesOfFlight_[ transferIndex_ ], sunGravitationalParameter,
+                        departureVelocity, arrivalVelocity );
+        }
+
+        else
+        {
+            mission_segments::solveLambertProblemGooding(
+                        departurePositions_[ transferIndex_ ], arrivalPositions_[ transferIndex_ ],
+                        timesOfFlight_[ transferIndex_ ], sunGravitationalParameter,
+                        departureVelocity, arrivalVelocity );
+        }
+        doNotOptimizeAway( departureVelocity( 0 ) + arrivalVelocity( 0 ) );
+
+        transferIndex_ = ( transferIndex_ + 1 ) % timesOfFlight_.size( );
+    }
+
+private:
+
+    //! Typedef of vector of positions.
+    typedef std::vector< Eigen::Vector3d, Eigen::aligned_allocator< Eigen::Vector3d > >
+    PositionList;
+
+    //! Lambert routine that is benchmarked.
+    LambertRoutines lambertRoutine_;
+
+    //! Departure positions [m].
+    PositionList departurePositions_;
+
+    //! Arrival positions [m].
+    PositionList arrivalPositions_;
+
+    //! Times of flight [s].
+    std::vector< double > timesOfFlight_;
+
+    //! Index of next transfer.
+    unsigned int transferIndex_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute mission segments benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat::benchmarks;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "MissionSegments" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    benchmarkSuite.runBenchmark( "lambertTargeter/izzo", LambertRoutineBenchmark( izzo ), 20000 );
+    benchmarkSuite.runBenchmark( "lambertTargeter/gooding", LambertRoutineBenchmark( gooding ),
+                                 20000 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
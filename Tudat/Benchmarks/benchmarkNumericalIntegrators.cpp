@@ -0,0 +1,154 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Printed usage if command-line arguments are invalid.
+ *
+ *    References
+ *
+ *    Notes
+ *      A single Runge-Kutta-Fehlberg 7(8) step is benchmarked for a Keplerian orbit, for both a
+ *      fixed-size and a dynamic-size 6-dimensional state. The error tolerances are chosen such
+ *      that every step is accepted, so that each iteration performs exactly 13 evaluations of the
+ *      state derivative.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/utilityMacros.h>
+
+#include "Tudat/Benchmarks/benchmarkTools.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Compute Keplerian state derivative.
+/*!
+ * Computes the state derivative of a body in a Keplerian orbit around the Earth.
+ * \param time Current time [s].
+ * \param state Current Cartesian state [m, m/s].
+ * \return Cartesian state derivative [m/s, m/s^2].
+ */
+template< typename StateType >
+StateType computeKeplerianStateDerivative( const double time, const StateType& state )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    StateType stateDerivative( 6 );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -earthGravitationalParameter * state.segment( 0, 3 )
+            / std::pow( state.segment( 0, 3 ).norm( ), 3.0 );
+    return stateDerivative;
+}
+
+//! Benchmark of a single Runge-Kutta-Fehlberg 7(8) integration step.
+template< typename StateType >
+class RungeKuttaFehlberg78StepBenchmark
+{
+public:
+
+    //! Typedef of integrator.
+    typedef numerical_integrators::RungeKuttaVariableStepSizeIntegrator< double, StateType >
+    Integrator;
+
+    //! Constructor.
+    /*!
+     * Constructor, setting up the integrator for a low Earth orbit.
+     */
+    RungeKuttaFehlberg78StepBenchmark( )
+    {
+        StateType initialState( 6 );
+        initialState << 7.0e6, 0.0, 0.0, 0.0, 6.0e3, 4.5e3;
+
+        integrator_ = boost::make_shared< Integrator >(
+                    numerical_integrators::RungeKuttaCoefficients::get(
+                        numerical_integrators::RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                    &computeKeplerianStateDerivative< StateType >, 0.0, initialState,
+                    1.0e-3, 1.0e3, 1.0e-6, 1.0e-6 );
+    }
+
+    //! Perform next integration step.
+    void operator( )( )
+    {
+        doNotOptimizeAway( integrator_->performIntegrationStep( 10.0 )( 0 ) );
+    }
+
+private:
+
+    //! Integrator.
+    boost::shared_ptr< Integrator > integrator_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+//! Execute numerical integrator benchmarks.
+int main( int argc, char* argv[ ] )
+{
+    using namespace tudat::benchmarks;
+
+    // Parse command-line arguments; print usage and exit if these are invalid.
+    BenchmarkSuite benchmarkSuite( "NumericalIntegrators" );
+    try
+    {
+        benchmarkSuite.parseArguments( argc, argv );
+    }
+    catch ( std::runtime_error& error )
+    {
+        std::cerr << error.what( ) << std::endl << std::endl;
+        BenchmarkSuite::printUsage( std::cerr, argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    benchmarkSuite.runBenchmark(
+                "rungeKuttaFehlberg78Step/fixedSizeState",
+                RungeKuttaFehlberg78StepBenchmark< tudat::basic_mathematics::Vector6d >( ),
+                20000 );
+
+    benchmarkSuite.runBenchmark(
+                "rungeKuttaFehlberg78Step/dynamicSizeState",
+                RungeKuttaFehlberg78StepBenchmark< Eigen::VectorXd >( ), 20000 );
+
+    benchmarkSuite.writeResults( );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,354 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Separated parsing of command-line arguments from constructor;
+ *                                  added printing of usage.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/version.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Benchmarks/benchmarkTools.h"
+#include "Tudat/tudatVersion.h"
+
+namespace
+{
+
+//! Number of heap allocations since last reset.
+std::size_t numberOfAllocations = 0;
+
+//! Sink for values that should not be optimized away.
+volatile double valueSink = 0.0;
+
+//! Write string as JSON string literal.
+void writeJsonString( std::ostream& outputStream, const std::string& value )
+{
+    outputStream << '"';
+    for ( std::string::const_iterator character = value.begin( );
+          character != value.end( ); character++ )
+    {
+        if ( *character == '"' || *character == '\\' )
+        {
+            outputStream << '\\';
+        }
+        outputStream << *character;
+    }
+    outputStream << '"';
+}
+
+//! Get compiler identification.
+std::string getCompilerIdentification( )
+{
+#if defined( __clang__ )
+    return __VERSION__;
+#elif defined( __GNUC__ )
+    return std::string( "GCC " ) + __VERSION__;
+#elif defined( _MSC_FULL_VER )
+    return "MSVC " + boost::lexical_cast< std::string >( _MSC_FULL_VER );
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+// Replace the global allocation functions to count heap allocations.
+#if defined( __GLIBC__ )
+
+extern "C"
+{
+
+void* __libc_malloc( std::size_t size );
+void* __libc_calloc( std::size_t numberOfElements, std::size_t elementSize );
+void* __libc_realloc( void* memory, std::size_t size );
+
+void* malloc( std::size_t size ) __THROW
+{
+    numberOfAllocations++;
+    return __libc_malloc( size );
+}
+
+void* calloc( std::size_t numberOfElements, std::size_t elementSize ) __THROW
+{
+    numberOfAllocations++;
+    return __libc_calloc( numberOfElements, elementSize );
+}
+
+void* realloc( void* memory, std::size_t size ) __THROW
+{
+    numberOfAllocations++;
+    return __libc_realloc( memory, size );
+}
+
+} // extern "C"
+
+#else
+
+void* operator new( std::size_t size )
+{
+    numberOfAllocations++;
+    void* memory = std::malloc( size == 0 ? 1 : size );
+    if ( memory == NULL )
+    {
+        throw std::bad_alloc( );
+    }
+    return memory;
+}
+
+void operator delete( void* memory ) throw( )
+{
+    std::free( memory );
+}
+
+#endif
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Get number of heap allocations.
+std::size_t getNumberOfAllocations( )
+{
+    return numberOfAllocations;
+}
+
+//! Reset number of heap allocations.
+void resetNumberOfAllocations( )
+{
+    numberOfAllocations = 0;
+}
+
+//! Prevent the compiler from optimizing away a computed value.
+void doNotOptimizeAway( const double value )
+{
+    valueSink = value;
+}
+
+//! Default constructor.
+BenchmarkSuite::BenchmarkSuite( const std::string& aSuiteName )
+    : suiteName_( aSuiteName ),
+      numberOfRepetitions_( 10 )
+{ }
+
+//! Parse command-line arguments.
+void BenchmarkSuite::parseArguments( const int numberOfArguments, char* arguments[ ] )
+{
+    for ( int argumentIndex = 1; argumentIndex < numberOfArguments; argumentIndex++ )
+    {
+        const std::string argument = arguments[ argumentIndex ];
+
+        if ( argument != "--repetitions" && argument != "--output" && argument != "--filter" )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Unknown argument " + argument ) ) );
+        }
+
+        if ( argumentIndex + 1 >= numberOfArguments )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Missing value for argument " + argument ) ) );
+        }
+
+        const std::string value = arguments[ ++argumentIndex ];
+        if ( argument == "--repetitions" )
+        {
+            try
+            {
+                numberOfRepetitions_ = boost::lexical_cast< unsigned int >( value );
+            }
+            catch ( boost::bad_lexical_cast& )
+            {
+                numberOfRepetitions_ = 0;
+            }
+
+            if ( numberOfRepetitions_ == 0 )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error( "Number of repetitions must be a positive "
+                                                    "integer, not " + value ) ) );
+            }
+        }
+
+        else if ( argument == "--output" )
+        {
+            outputFilePath_ = value;
+        }
+
+        else
+        {
+            filter_ = value;
+        }
+    }
+}
+
+//! Print usage.
+void BenchmarkSuite::printUsage( std::ostream& outputStream, const std::string& programName )
+{
+    outputStream << "Usage: " << programName
+                 << " [--repetitions N] [--output FILE] [--filter TEXT]" << std::endl
+                 << std::endl
+                 << "  --repetitions N   Number of timed repetitions of each benchmark "
+                 << "(default: 10)." << std::endl
+                 << "  --output FILE     Write results to FILE instead of standard output."
+                 << std::endl
+                 << "  --filter TEXT     Only run benchmarks whose name contains TEXT."
+                 << std::endl;
+}
+
+//! Write results.
+void BenchmarkSuite::writeResults( ) const
+{
+    if ( outputFilePath_.empty( ) )
+    {
+        writeResults( std::cout );
+    }
+
+    else
+    {
+        std::ofstream outputFile( outputFilePath_.c_str( ) );
+        if ( !outputFile )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Could not open benchmark output file "
+                                                + outputFilePath_ ) ) );
+        }
+        writeResults( outputFile );
+    }
+}
+
+//! Write results to stream.
+void BenchmarkSuite::writeResults( std::ostream& outputStream ) const
+{
+    outputStream << "{" << std::endl;
+
+    outputStream << "  \"suite\": ";
+    writeJsonString( outputStream, suiteName_ );
+    outputStream << "," << std::endl;
+
+    outputStream << "  \"tudatVersion\": \"" << TUDAT_VERSION_MAJOR << "."
+                 << TUDAT_VERSION_MINOR << "\"," << std::endl;
+    outputStream << "  \"eigenVersion\": \"" << EIGEN_WORLD_VERSION << "."
+                 << EIGEN_MAJOR_VERSION << "." << EIGEN_MINOR_VERSION << "\"," << std::endl;
+    outputStream << "  \"boostVersion\": \"" << BOOST_LIB_VERSION << "\"," << std::endl;
+
+    outputStream << "  \"compiler\": ";
+    writeJsonString( outputStream, getCompilerIdentification( ) );
+    outputStream << "," << std::endl;
+
+#ifdef NDEBUG
+    outputStream << "  \"assertionsEnabled\": false," << std::endl;
+#else
+    outputStream << "  \"assertionsEnabled\": true," << std::endl;
+#endif
+
+    outputStream << "  \"benchmarks\": [";
+    outputStream << std::setprecision( 6 );
+    for ( unsigned int resultIndex = 0; resultIndex < results_.size( ); resultIndex++ )
+    {
+        const BenchmarkResult& result = results_[ resultIndex ];
+
+        outputStream << ( resultIndex == 0 ? "" : "," ) << std::endl;
+        outputStream << "    {" << std::endl;
+        outputStream << "      \"name\": ";
+        writeJsonString( outputStream, result.name );
+        outputStream << "," << std::endl;
+        outputStream << "      \"iterations\": " << result.numberOfIterations << ","
+                     << std::endl;
+        outputStream << "      \"repetitions\": " << result.numberOfRepetitions << ","
+                     << std::endl;
+        outputStream << "      \"minimumTimePerIteration\": "
+                     << result.minimumTimePerIteration << "," << std::endl;
+        outputStream << "      \"medianTimePerIteration\": "
+                     << result.medianTimePerIteration << "," << std::endl;
+        outputStream << "      \"meanTimePerIteration\": "
+                     << result.meanTimePerIteration << "," << std::endl;
+        outputStream << "      \"allocationsPerIteration\": "
+                     << result.allocationsPerIteration << std::endl;
+        outputStream << "    }";
+    }
+    outputStream << std::endl << "  ]" << std::endl;
+    outputStream << "}" << std::endl;
+}
+
+//! Check whether benchmark is selected.
+bool BenchmarkSuite::isBenchmarkSelected( const std::string& benchmarkName ) const
+{
+    return filter_.empty( ) || benchmarkName.find( filter_ ) != std::string::npos;
+}
+
+//! Add result.
+void BenchmarkSuite::addResult( const std::string& benchmarkName,
+                                const unsigned int numberOfIterations,
+                                std::vector< double > repetitionTimes,
+                                const std::size_t numberOfAllocations )
+{
+    const double totalNumberOfIterations
+            = static_cast< double >( numberOfIterations ) * repetitionTimes.size( );
+
+    std::sort( repetitionTimes.begin( ), repetitionTimes.end( ) );
+    const std::size_t middleIndex = repetitionTimes.size( ) / 2;
+    const double medianTime = ( repetitionTimes.size( ) % 2 == 1 )
+            ? repetitionTimes[ middleIndex ]
+            : 0.5 * ( repetitionTimes[ middleIndex - 1 ] + repetitionTimes[ middleIndex ] );
+
+    BenchmarkResult result;
+    result.name = benchmarkName;
+    result.numberOfIterations = numberOfIterations;
+    result.numberOfRepetitions = static_cast< unsigned int >( repetitionTimes.size( ) );
+    result.minimumTimePerIteration = repetitionTimes.front( ) / numberOfIterations;
+    result.medianTimePerIteration = medianTime / numberOfIterations;
+    result.meanTimePerIteration = std::accumulate(
+                repetitionTimes.begin( ), repetitionTimes.end( ), 0.0 ) / totalNumberOfIterations;
+    result.allocationsPerIteration = numberOfAllocations / totalNumberOfIterations;
+
+    results_.push_back( result );
+}
+
+} // namespace benchmarks
+} // namespace tudat
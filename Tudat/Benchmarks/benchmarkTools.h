@@ -0,0 +1,266 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140305    S. Vermeer        File created.
+ *      140415    S. Vermeer        Separated parsing of command-line arguments from constructor;
+ *                                  added printing of usage.
+ *
+ *    References
+ *
+ *    Notes
+ *      The timing of a benchmark is repeated a number of times, after a single warm-up
+ *      repetition, and the minimum, median and mean time per iteration are reported. The minimum
+ *      is the most repeatable of the three and should be used to track regressions; the median
+ *      and mean indicate how much the measurement is disturbed by the system.
+ *
+ *      Heap allocations are counted by replacing the global allocation functions in
+ *      benchmarkTools.cpp. Under the GNU C library, malloc and friends are intercepted, such that
+ *      allocations made by Eigen (which bypasses operator new) are counted as well. On other
+ *      platforms only calls to the global operator new are counted.
+ *
+ */
+
+#ifndef TUDAT_BENCHMARK_TOOLS_H
+#define TUDAT_BENCHMARK_TOOLS_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <boost/chrono.hpp>
+
+namespace tudat
+{
+namespace benchmarks
+{
+
+//! Get number of heap allocations.
+/*!
+ * Returns the number of heap allocations performed by the program since the last call to
+ * resetNumberOfAllocations( ), or since program start-up.
+ * \return Number of heap allocations.
+ */
+std::size_t getNumberOfAllocations( );
+
+//! Reset number of heap allocations.
+/*!
+ * Resets the counter of heap allocations to zero.
+ */
+void resetNumberOfAllocations( );
+
+//! Prevent the compiler from optimizing away a computed value.
+/*!
+ * Stores the value in a volatile variable defined in a separate translation unit. Benchmarked
+ * functions pass (a scalar derived from) their result to this function, such that the compiler
+ * can not discard the computation that is being timed.
+ * \param value Value that is to be kept.
+ */
+void doNotOptimizeAway( const double value );
+
+//! Result of a single benchmark.
+/*!
+ * Timing and allocation statistics of a single benchmark.
+ */
+struct BenchmarkResult
+{
+public:
+
+    //! Name of benchmark.
+    std::string name;
+
+    //! Number of iterations (calls of the benchmarked function) per repetition.
+    unsigned int numberOfIterations;
+
+    //! Number of timed repetitions.
+    unsigned int numberOfRepetitions;
+
+    //! Minimum time per iteration over all repetitions [s].
+    double minimumTimePerIteration;
+
+    //! Median time per iteration over all repetitions [s].
+    double medianTimePerIteration;
+
+    //! Mean time per iteration over all repetitions [s].
+    double meanTimePerIteration;
+
+    //! Mean number of heap allocations per iteration.
+    double allocationsPerIteration;
+};
+
+//! Benchmark suite.
+/*!
+ * Runs a set of benchmarks, collects their timing and allocation statistics and writes these to
+ * a JSON file, such that results can be compared across builds and library upgrades. The
+ * following command-line arguments are recognized:
+ *
+ *   --repetitions N   Number of timed repetitions of each benchmark (default: 10).
+ *   --output FILE     Write results to FILE instead of standard output.
+ *   --filter TEXT     Only run benchmarks whose name contains TEXT.
+ *
+ * The arguments are parsed by parseArguments(), which throws an exception if they are invalid,
+ * such that the calling program can print the usage (printUsage()) and exit.
+ */
+class BenchmarkSuite
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking the suite name. All benchmarks are run with the default number
+     * of repetitions, and results are written to standard output, unless other settings are
+     * given by the command-line arguments passed to parseArguments().
+     * \param aSuiteName Name of benchmark suite.
+     */
+    explicit BenchmarkSuite( const std::string& aSuiteName );
+
+    //! Parse command-line arguments.
+    /*!
+     * Parses the command-line arguments of the program (see class documentation). An exception
+     * is thrown if an argument is unknown, lacks a value, or has an invalid value.
+     * \param numberOfArguments Number of command-line arguments (argc).
+     * \param arguments Command-line arguments (argv).
+     */
+    void parseArguments( const int numberOfArguments, char* arguments[ ] );
+
+    //! Print usage.
+    /*!
+     * Prints the usage of a benchmark program, i.e., the command-line arguments it recognizes.
+     * \param outputStream Stream to which usage is printed.
+     * \param programName Name of program (argv[ 0 ]).
+     */
+    static void printUsage( std::ostream& outputStream, const std::string& programName );
+
+    //! Run benchmark.
+    /*!
+     * Runs a benchmark by calling the provided function numberOfIterations times per repetition.
+     * A single untimed warm-up repetition precedes the timed repetitions. Heap allocations are
+     * counted over all timed repetitions. Benchmarks whose name does not match the filter given
+     * on the command line are skipped.
+     * \param benchmarkName Name of benchmark.
+     * \param benchmarkFunction Function (object) that is benchmarked; called without arguments.
+     * \param numberOfIterations Number of calls of the function per repetition.
+     */
+    template< typename BenchmarkFunction >
+    void runBenchmark( const std::string& benchmarkName, BenchmarkFunction benchmarkFunction,
+                       const unsigned int numberOfIterations )
+    {
+        typedef boost::chrono::high_resolution_clock Clock;
+
+        if ( !isBenchmarkSelected( benchmarkName ) )
+        {
+            return;
+        }
+
+        // Perform warm-up repetition.
+        for ( unsigned int iteration = 0; iteration < numberOfIterations; iteration++ )
+        {
+            benchmarkFunction( );
+        }
+
+        // Perform timed repetitions.
+        std::vector< double > repetitionTimes( numberOfRepetitions_ );
+        resetNumberOfAllocations( );
+        for ( unsigned int repetition = 0; repetition < numberOfRepetitions_; repetition++ )
+        {
+            const Clock::time_point startTime = Clock::now( );
+            for ( unsigned int iteration = 0; iteration < numberOfIterations; iteration++ )
+            {
+                benchmarkFunction( );
+            }
+            repetitionTimes[ repetition ] = boost::chrono::duration< double >(
+                        Clock::now( ) - startTime ).count( );
+        }
+        const std::size_t numberOfAllocations = getNumberOfAllocations( );
+
+        addResult( benchmarkName, numberOfIterations, repetitionTimes, numberOfAllocations );
+    }
+
+    //! Write results.
+    /*!
+     * Writes the results of all benchmarks run so far as a JSON document, to the output file
+     * given on the command line, or to standard output if none was given.
+     */
+    void writeResults( ) const;
+
+    //! Write results to stream.
+    /*!
+     * Writes the results of all benchmarks run so far as a JSON document to a stream.
+     * \param outputStream Stream to which results are written.
+     */
+    void writeResults( std::ostream& outputStream ) const;
+
+    //! Get results.
+    /*!
+     * Returns the results of all benchmarks run so far.
+     * \return Benchmark results.
+     */
+    const std::vector< BenchmarkResult >& getResults( ) const { return results_; }
+
+protected:
+
+private:
+
+    //! Check whether benchmark is selected.
+    /*!
+     * Checks whether a benchmark name matches the filter given on the command line.
+     * \param benchmarkName Name of benchmark.
+     * \return True if benchmark is to be run.
+     */
+    bool isBenchmarkSelected( const std::string& benchmarkName ) const;
+
+    //! Add result.
+    /*!
+     * Computes the statistics of a benchmark from the repetition times and stores them.
+     * \param benchmarkName Name of benchmark.
+     * \param numberOfIterations Number of iterations per repetition.
+     * \param repetitionTimes Wall-clock time of each repetition [s].
+     * \param numberOfAllocations Number of heap allocations over all repetitions.
+     */
+    void addResult( const std::string& benchmarkName, const unsigned int numberOfIterations,
+                    std::vector< double > repetitionTimes,
+                    const std::size_t numberOfAllocations );
+
+    //! Name of benchmark suite.
+    std::string suiteName_;
+
+    //! Number of timed repetitions of each benchmark.
+    unsigned int numberOfRepetitions_;
+
+    //! Path of output file; empty for standard output.
+    std::string outputFilePath_;
+
+    //! Benchmark name filter; empty to run all benchmarks.
+    std::string filter_;
+
+    //! Results of benchmarks run so far.
+    std::vector< BenchmarkResult > results_;
+};
+
+} // namespace benchmarks
+} // namespace tudat
+
+#endif // TUDAT_BENCHMARK_TOOLS_H
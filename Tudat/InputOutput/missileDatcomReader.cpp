@@ -26,6 +26,7 @@
  *      110530    F.M. Engelen      File created.
  *      120326    D. Dirkx          Modified code to be consistent with latest Tudat/TudatCore;
  *                                  moved relevant functionality of (text)FileReader to this class.
+ *      140307    S. Vermeer        Added tracing of file reading.
  *
  *    References
  *      Blake, W.B. Missile Datcom User's Manual - 1997 Fortran 90 Version, AFRL-VA-WP-TR-1998-3009
@@ -44,6 +45,7 @@
 #include <boost/exception/all.hpp>
 #include <boost/throw_exception.hpp>
 
+#include "Tudat/Basics/tracing.h"
 #include "Tudat/InputOutput/missileDatcomReader.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
 
@@ -144,6 +146,8 @@ void MissileDatcomReader::split( const string& dataString, char separator,
 //! Read and store data.
 void MissileDatcomReader::readAndStoreData( const string& skipKeyword )
 {
+    TUDAT_TRACE_SCOPE( "InputOutput", "MissileDatcomReader::readAndStoreData" );
+
     // Local variable for reading a single line
     std::string stringOfData;
 
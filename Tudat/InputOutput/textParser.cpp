@@ -26,6 +26,7 @@
  *      YYMMDD    Author            Comment
  *      111206    S. Billemont      File created.
  *      120326    D. Dirkx          Code checked, minor layout changes.
+ *      140307    S. Vermeer        Added tracing of parsing.
  *
  *    References
  *
@@ -33,6 +34,7 @@
  *
  */
 
+#include "Tudat/Basics/tracing.h"
 #include "Tudat/InputOutput/textParser.h"
 
 namespace tudat
@@ -56,6 +58,8 @@ ParsedDataVectorPtr TextParser::parse( std::string& string )
 // Parse stream.
 ParsedDataVectorPtr TextParser::parse( std::istream& stream )
 {
+    TUDAT_TRACE_SCOPE( "InputOutput", "TextParser::parse" );
+
     // Clear parsedData variable.
     parsedData->clear( );
 
@@ -32,6 +32,7 @@
  *      110810    J. Leloux         Tested new setup and changed descriptions.
  *      110826    J. Leloux         Added functionality for 2-line and 3-line data.
  *      111027    K. Kumar          Modified 2-line and 3-line options using enum.
+ *      140307    S. Vermeer        Added tracing of file reading and parsing.
  *
  *    References
  *      Leloux, J. Filtering Techniques for Orbital Debris Conjunction Analysis
@@ -75,6 +76,7 @@
 #include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/Basics/tracing.h"
 #include <Tudat/InputOutput/basicInputOutput.h>
 #include "Tudat/InputOutput/twoLineElementsTextFileReader.h"
 
@@ -141,6 +143,8 @@ void TwoLineElementsTextFileReader::skipLines( unsigned int numberOfLines )
 //! Read and store data.
 void TwoLineElementsTextFileReader::readAndStoreData( )
 {
+    TUDAT_TRACE_SCOPE( "InputOutput", "TwoLineElementsTextFileReader::readAndStoreData" );
+
     // Reset the datafile.
     containerOfDataFromFile_.clear( );
 
@@ -239,6 +243,8 @@ void TwoLineElementsTextFileReader::stripEndOfLineCharacters(
 //! Convert and store TLE data.
 void TwoLineElementsTextFileReader::storeTwoLineElementData( )
 {
+    TUDAT_TRACE_SCOPE( "InputOutput", "TwoLineElementsTextFileReader::storeTwoLineElementData" );
+
     using boost::algorithm::trim_copy;
 
     // Strip End-Of-Line characters from data container.
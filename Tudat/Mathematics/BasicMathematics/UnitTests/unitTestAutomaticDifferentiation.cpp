@@ -0,0 +1,207 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140221    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+
+#include "Tudat/Mathematics/BasicMathematics/automaticDifferentiation.h"
+#include "Tudat/Mathematics/BasicMathematics/coordinateConversions.h"
+#include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace basic_mathematics;
+
+BOOST_AUTO_TEST_SUITE( test_AutomaticDifferentiation )
+
+//! Test seeding of independent variables and extraction of values and partial derivatives.
+BOOST_AUTO_TEST_CASE( testIndependentVariablesAndPartialDerivatives )
+{
+    using std::sin;
+
+    // Set values of independent variables.
+    const Eigen::Vector3d values( 1.5, -2.0, 0.25 );
+
+    // Create independent variables.
+    const Eigen::Matrix< AutoDiffScalar3d, 3, 1 > independentVariables
+            = createIndependentVariables< Eigen::Vector3d >( values, 3 );
+
+    // Check that values are retrieved unchanged and that partial derivatives are identity.
+    BOOST_CHECK_EQUAL( getValues( independentVariables ), values );
+    BOOST_CHECK_EQUAL( getPartialDerivatives( independentVariables ),
+                       Eigen::Matrix3d::Identity( ) );
+
+    // Evaluate function f( x, y, z ) = ( x * y, sin( z ), x + y * z ).
+    Eigen::Matrix< AutoDiffScalar3d, 3, 1 > functionValues;
+    functionValues( 0 ) = independentVariables( 0 ) * independentVariables( 1 );
+    functionValues( 1 ) = sin( independentVariables( 2 ) );
+    functionValues( 2 ) = independentVariables( 0 )
+            + independentVariables( 1 ) * independentVariables( 2 );
+
+    // Set expected Jacobian of function.
+    Eigen::Matrix3d expectedJacobian = Eigen::Matrix3d::Zero( );
+    expectedJacobian( 0, 0 ) = values( 1 );
+    expectedJacobian( 0, 1 ) = values( 0 );
+    expectedJacobian( 1, 2 ) = std::cos( values( 2 ) );
+    expectedJacobian( 2, 0 ) = 1.0;
+    expectedJacobian( 2, 1 ) = values( 2 );
+    expectedJacobian( 2, 2 ) = values( 1 );
+
+    // Check computed Jacobian.
+    const Eigen::Matrix3d computedJacobian = getPartialDerivatives( functionValues );
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            BOOST_CHECK_SMALL( computedJacobian( i, j ) - expectedJacobian( i, j ),
+                               std::numeric_limits< double >::epsilon( ) );
+        }
+    }
+
+    // Create independent variables with offset in partial derivative index.
+    const Eigen::Matrix< AutoDiffScalar6d, 3, 1 > offsetIndependentVariables
+            = createIndependentVariables< Eigen::Matrix< double, 6, 1 > >( values, 6, 3 );
+
+    // Check that partial derivatives are set in last three columns only.
+    Eigen::Matrix< double, 3, 6 > expectedPartialDerivatives
+            = Eigen::Matrix< double, 3, 6 >::Zero( );
+    expectedPartialDerivatives.rightCols( 3 ) = Eigen::Matrix3d::Identity( );
+    BOOST_CHECK_EQUAL( getPartialDerivatives( offsetIndependentVariables ),
+                       expectedPartialDerivatives );
+}
+
+//! Test partial derivatives of geodesy-normalized Legendre polynomials.
+BOOST_AUTO_TEST_CASE( testGeodesyLegendrePolynomialPartialDerivatives )
+{
+    // Set polynomial parameter and step size for central difference.
+    const double polynomialParameter = 0.3;
+    const double stepSize = 1.0e-6;
+
+    // Loop over degrees and orders.
+    for ( int degree = 0; degree <= 6; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            // Compute polynomial with automatic differentiation.
+            const AutoDiffScalarXd automaticDifferentiationPolynomial
+                    = computeGeodesyLegendrePolynomialTemplate(
+                        degree, order, AutoDiffScalarXd( polynomialParameter, 1, 0 ) );
+
+            // Check that value equals value computed with double-precision function.
+            BOOST_CHECK_EQUAL( automaticDifferentiationPolynomial.value( ),
+                               computeGeodesyLegendrePolynomial(
+                                   degree, order, polynomialParameter ) );
+
+            // Compute derivative using central difference.
+            const double numericalDerivative
+                    = ( computeGeodesyLegendrePolynomial(
+                            degree, order, polynomialParameter + stepSize )
+                        - computeGeodesyLegendrePolynomial(
+                            degree, order, polynomialParameter - stepSize ) )
+                    / ( 2.0 * stepSize );
+
+            // Check derivative.
+            BOOST_CHECK_SMALL( automaticDifferentiationPolynomial.derivatives( )( 0 )
+                               - numericalDerivative, 1.0e-7 );
+        }
+    }
+
+    // Check that polynomial and its derivative are zero if order is greater than degree.
+    const AutoDiffScalarXd zeroPolynomial = computeGeodesyLegendrePolynomialTemplate(
+                2, 3, AutoDiffScalarXd( polynomialParameter, 1, 0 ) );
+    BOOST_CHECK_EQUAL( zeroPolynomial.value( ), 0.0 );
+    BOOST_CHECK_EQUAL( zeroPolynomial.derivatives( )( 0 ), 0.0 );
+}
+
+//! Test conversion of spherical to Cartesian gradient for automatic differentiation scalars.
+BOOST_AUTO_TEST_CASE( testSphericalToCartesianGradientPartialDerivatives )
+{
+    // Set spherical gradient and Cartesian position.
+    const Eigen::Vector3d sphericalGradient( 1.2, -0.4, 0.7 );
+    const Eigen::Vector3d cartesianPosition( 2.5, 0.3, -1.1 );
+
+    // Compute gradient with automatic differentiation w.r.t. Cartesian position.
+    Eigen::Matrix< AutoDiffScalar3d, 3, 1 > automaticDifferentiationGradient
+            = coordinate_conversions::convertSphericalToCartesianGradientTemplate(
+                Eigen::Matrix< AutoDiffScalar3d, 3, 1 >( sphericalGradient.cast<
+                                                         AutoDiffScalar3d >( ) ),
+                createIndependentVariables< Eigen::Vector3d >( cartesianPosition, 3 ) );
+
+    // Check that values equal values computed with double-precision function.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                getValues( automaticDifferentiationGradient ),
+                coordinate_conversions::convertSphericalToCartesianGradient(
+                    sphericalGradient, cartesianPosition ),
+                std::numeric_limits< double >::epsilon( ) );
+
+    // Check partial derivatives against central differences.
+    const double stepSize = 1.0e-6;
+    const Eigen::Matrix3d partialDerivatives
+            = getPartialDerivatives( automaticDifferentiationGradient );
+    for ( int i = 0; i < 3; i++ )
+    {
+        Eigen::Vector3d perturbation = Eigen::Vector3d::Zero( );
+        perturbation( i ) = stepSize;
+
+        const Eigen::Vector3d numericalPartialDerivative
+                = ( coordinate_conversions::convertSphericalToCartesianGradient(
+                        sphericalGradient, Eigen::Vector3d( cartesianPosition + perturbation ) )
+                    - coordinate_conversions::convertSphericalToCartesianGradient(
+                        sphericalGradient, Eigen::Vector3d( cartesianPosition - perturbation ) ) )
+                / ( 2.0 * stepSize );
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            BOOST_CHECK_SMALL( partialDerivatives( j, i ) - numericalPartialDerivative( j ),
+                               1.0e-8 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
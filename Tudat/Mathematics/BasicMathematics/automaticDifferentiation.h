@@ -0,0 +1,184 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140221    S. Vermeer        File created.
+ *      140401    S. Vermeer        Legendre polynomial now overloads scalar-type template, instead
+ *                                  of double-precision function.
+ *
+ *    References
+ *      Griewank, A., Walther, A. Evaluating Derivatives: Principles and Techniques of Algorithmic
+ *          Differentiation, Second Edition, SIAM, 2008.
+ *
+ *    Notes
+ *      The forward-mode automatic differentiation scalar used here is the AutoDiffScalar class
+ *      from the (header-only) unsupported AutoDiff module of Eigen. A scalar of this type carries
+ *      a value and a vector of partial derivatives of this value with respect to a chosen set of
+ *      independent variables. Evaluating a function templated on its scalar type with such
+ *      scalars yields the function value and its exact partial derivatives in a single pass.
+ *
+ */
+
+#ifndef TUDAT_AUTOMATIC_DIFFERENTIATION_H
+#define TUDAT_AUTOMATIC_DIFFERENTIATION_H
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/AutoDiff>
+
+#include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
+
+namespace tudat
+{
+namespace basic_mathematics
+{
+
+//! Typedef for forward-mode automatic differentiation scalar with three partial derivatives.
+typedef Eigen::AutoDiffScalar< Eigen::Vector3d > AutoDiffScalar3d;
+
+//! Typedef for forward-mode automatic differentiation scalar with six partial derivatives.
+typedef Eigen::AutoDiffScalar< Eigen::Matrix< double, 6, 1 > > AutoDiffScalar6d;
+
+//! Typedef for forward-mode automatic differentiation scalar with a run-time number of partial
+//! derivatives.
+typedef Eigen::AutoDiffScalar< Eigen::VectorXd > AutoDiffScalarXd;
+
+//! Create vector of independent variables for forward-mode automatic differentiation.
+/*!
+ * Creates a vector of automatic differentiation scalars from a vector of values, such that each
+ * entry is an independent variable. The partial derivative of entry i with respect to independent
+ * variable firstPartialIndex + i is set to one, all other partial derivatives are set to zero.
+ * \tparam DerivativeType Type used to store partial derivatives (e.g. Eigen::Vector3d).
+ * \tparam NumberOfRows Number of rows of vector of values.
+ * \param values Values of independent variables.
+ * \param numberOfPartials Total number of partial derivatives carried by each scalar.
+ * \param firstPartialIndex Index of partial derivative associated with first entry of values
+ *          (default = 0).
+ * \return Vector of independent variables.
+ */
+template< typename DerivativeType, int NumberOfRows >
+Eigen::Matrix< Eigen::AutoDiffScalar< DerivativeType >, NumberOfRows, 1 >
+createIndependentVariables( const Eigen::Matrix< double, NumberOfRows, 1 >& values,
+                            const int numberOfPartials,
+                            const int firstPartialIndex = 0 )
+{
+    Eigen::Matrix< Eigen::AutoDiffScalar< DerivativeType >, NumberOfRows, 1 > independentVariables(
+                values.rows( ) );
+    for ( int i = 0; i < values.rows( ); i++ )
+    {
+        independentVariables( i ) = Eigen::AutoDiffScalar< DerivativeType >(
+                    values( i ), numberOfPartials, firstPartialIndex + i );
+    }
+    return independentVariables;
+}
+
+//! Get values of vector of automatic differentiation scalars.
+/*!
+ * Returns the values of a vector of automatic differentiation scalars, i.e., discards the partial
+ * derivatives.
+ * \tparam DerivativeType Type used to store partial derivatives.
+ * \tparam NumberOfRows Number of rows of vector.
+ * \param vector Vector of automatic differentiation scalars.
+ * \return Values of vector entries.
+ */
+template< typename DerivativeType, int NumberOfRows >
+Eigen::Matrix< double, NumberOfRows, 1 > getValues(
+        const Eigen::Matrix< Eigen::AutoDiffScalar< DerivativeType >, NumberOfRows, 1 >& vector )
+{
+    Eigen::Matrix< double, NumberOfRows, 1 > values( vector.rows( ) );
+    for ( int i = 0; i < vector.rows( ); i++ )
+    {
+        values( i ) = vector( i ).value( );
+    }
+    return values;
+}
+
+//! Get partial derivatives of vector of automatic differentiation scalars.
+/*!
+ * Returns the matrix of partial derivatives of a vector of automatic differentiation scalars.
+ * Row i contains the partial derivatives of entry i with respect to all independent variables.
+ * \tparam DerivativeType Type used to store partial derivatives.
+ * \tparam NumberOfRows Number of rows of vector.
+ * \param vector Vector of automatic differentiation scalars.
+ * \return Matrix of partial derivatives (Jacobian) of vector entries.
+ */
+template< typename DerivativeType, int NumberOfRows >
+Eigen::Matrix< double, NumberOfRows, DerivativeType::RowsAtCompileTime > getPartialDerivatives(
+        const Eigen::Matrix< Eigen::AutoDiffScalar< DerivativeType >, NumberOfRows, 1 >& vector )
+{
+    Eigen::Matrix< double, NumberOfRows, DerivativeType::RowsAtCompileTime > partialDerivatives(
+                vector.rows( ), vector( 0 ).derivatives( ).rows( ) );
+    for ( int i = 0; i < vector.rows( ); i++ )
+    {
+        partialDerivatives.row( i ) = vector( i ).derivatives( ).transpose( );
+    }
+    return partialDerivatives;
+}
+
+//! Compute geodesy-normalized associated Legendre polynomial and its partial derivatives.
+/*!
+ * Computes the geodesy-normalized associated Legendre polynomial for an automatic differentiation
+ * polynomial parameter. This overload of the computeGeodesyLegendrePolynomialTemplate() function
+ * is selected for automatic differentiation scalars. The value is computed (and cached) using the
+ * double-precision computeGeodesyLegendrePolynomial() function, and the partial derivatives are
+ * obtained using the chain rule with the derivative of the polynomial with respect to its
+ * parameter, as computed by the computeGeodesyLegendrePolynomialDerivative() function. As for
+ * the double-precision function, zero is returned if the order is greater than the degree.
+ * \tparam DerivativeType Type used to store partial derivatives.
+ * \param degree Degree of requested Legendre polynomial.
+ * \param order Order of requested Legendre polynomial.
+ * \param polynomialParameter Free variable of requested Legendre polynomial.
+ * \return Geodesy-normalized Legendre polynomial, with partial derivatives.
+ */
+template< typename DerivativeType >
+Eigen::AutoDiffScalar< DerivativeType > computeGeodesyLegendrePolynomialTemplate(
+        const int degree, const int order,
+        const Eigen::AutoDiffScalar< DerivativeType >& polynomialParameter )
+{
+    // If order is greater than degree, the polynomial, and its derivatives, are zero.
+    if ( order > degree && degree >= 0 )
+    {
+        return Eigen::AutoDiffScalar< DerivativeType >(
+                    0.0, DerivativeType::Zero( polynomialParameter.derivatives( ).rows( ) ) );
+    }
+
+    // Compute polynomial, and polynomial with order of one more, which is needed for the
+    // derivative of the polynomial with respect to its parameter.
+    const double legendrePolynomial = computeGeodesyLegendrePolynomial(
+                degree, order, polynomialParameter.value( ) );
+    const double incrementedLegendrePolynomial = computeGeodesyLegendrePolynomial(
+                degree, order + 1, polynomialParameter.value( ) );
+
+    // Apply chain rule to obtain partial derivatives.
+    return Eigen::AutoDiffScalar< DerivativeType >(
+                legendrePolynomial,
+                computeGeodesyLegendrePolynomialDerivative(
+                    degree, order, polynomialParameter.value( ), legendrePolynomial,
+                    incrementedLegendrePolynomial ) * polynomialParameter.derivatives( ) );
+}
+
+} // namespace basic_mathematics
+} // namespace tudat
+
+#endif // TUDAT_AUTOMATIC_DIFFERENTIATION_H
@@ -50,6 +50,8 @@
  *                                  Added conversion from Cartesian state to spherical state.
  *      140114    E. Brandon        Reorganized includes.
  *                                  Minor changes during code check.
+ *      140221    S. Vermeer        Spherical to Cartesian gradient conversion now uses
+ *                                  scalar-type template.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -244,36 +246,8 @@ Eigen::VectorXd convertCartesianToCylindrical( const Eigen::VectorXd& cartesianS
 Eigen::Vector3d convertSphericalToCartesianGradient( const Eigen::Vector3d& sphericalGradient,
                                                      const Eigen::Vector3d& cartesianCoordinates )
 {
-    // Compute radius.
-    const double radius = std::sqrt( cartesianCoordinates( 0 ) * cartesianCoordinates( 0 )
-                                     + cartesianCoordinates( 1 ) * cartesianCoordinates( 1 )
-                                     + cartesianCoordinates( 2 ) * cartesianCoordinates( 2 ) );
-
-    // Compute square of distance within xy-plane.
-    const double xyDistanceSquared = cartesianCoordinates( 0 ) * cartesianCoordinates( 0 )
-            + cartesianCoordinates( 1 ) * cartesianCoordinates( 1 );
-
-    // Compute distance within xy-plane.
-    const double xyDistance = std::sqrt( xyDistanceSquared );
-
-    // Compute transformation matrix.
-    const Eigen::Matrix3d transformationMatrix = (
-                Eigen::Matrix3d( 3, 3 ) <<
-                cartesianCoordinates( 0 ) / radius,
-                - cartesianCoordinates( 0 ) * cartesianCoordinates( 2 )
-                / ( radius * radius * xyDistance ),
-                - cartesianCoordinates( 1 ) / xyDistanceSquared,
-                cartesianCoordinates( 1 ) / radius,
-                - cartesianCoordinates( 1 ) * cartesianCoordinates( 2 )
-                / ( radius * radius * xyDistance ),
-                + cartesianCoordinates( 0 ) / xyDistanceSquared,
-                cartesianCoordinates( 2 ) / radius,
-                xyDistance / ( radius * radius ),
-                0.0
-                ).finished( );
-
-    // Return Cartesian gradient.
-    return transformationMatrix * sphericalGradient;
+    return convertSphericalToCartesianGradientTemplate< double >( sphericalGradient,
+                                                                  cartesianCoordinates );
 }
 
 //! Convert spherical to Cartesian state.
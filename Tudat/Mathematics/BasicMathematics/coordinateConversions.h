@@ -51,6 +51,10 @@
  *                                  Added enum for spherical coordinates.
  *      140114    E. Brandon        Minor comment changes during code-check.
  *      140123    T. Roegiers       Corrected enum for spherical and cylindrical coordinates.
+ *      140221    S. Vermeer        Added scalar-type template of spherical to Cartesian gradient
+ *                                  conversion.
+ *      140401    S. Vermeer        Renamed scalar-type template of spherical to Cartesian gradient,
+ *                                  so that it does not overload the double-precision function.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -66,6 +70,8 @@
 #ifndef TUDAT_COORDINATE_CONVERSIONS_H
 #define TUDAT_COORDINATE_CONVERSIONS_H
 
+#include <cmath>
+
 #include <Eigen/Core>
 
 namespace tudat
@@ -254,6 +260,57 @@ Eigen::VectorXd convertCartesianToCylindrical( const Eigen::VectorXd& cartesianS
 Eigen::Vector3d convertSphericalToCartesianGradient( const Eigen::Vector3d& sphericalGradient,
                                                      const Eigen::Vector3d& cartesianCoordinates );
 
+//! Convert spherical to Cartesian gradient for arbitrary scalar type.
+/*!
+* Converts a gradient vector with respect to spherical coordinates to a gradient vector with
+* respect to Cartesian coordinates, as described for the double-precision
+* convertSphericalToCartesianGradient() function, for an arbitrary scalar type (for instance an
+* automatic differentiation scalar).
+* \tparam ScalarType Scalar type used for gradient and coordinates.
+* \param sphericalGradient Vector with partial derivatives with respect to spherical coordinates
+*        (radius, elevation, azimuth).
+* \param cartesianCoordinates Vector with Cartesian coordinates (x, y, z).
+* \return Vector with partial derivatives with respect to Cartesian coordinates (x, y, z).
+*/
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > convertSphericalToCartesianGradientTemplate(
+        const Eigen::Matrix< ScalarType, 3, 1 >& sphericalGradient,
+        const Eigen::Matrix< ScalarType, 3, 1 >& cartesianCoordinates )
+{
+    using std::sqrt;
+
+    // Compute radius.
+    const ScalarType radius = sqrt( cartesianCoordinates( 0 ) * cartesianCoordinates( 0 )
+                                    + cartesianCoordinates( 1 ) * cartesianCoordinates( 1 )
+                                    + cartesianCoordinates( 2 ) * cartesianCoordinates( 2 ) );
+
+    // Compute square of distance within xy-plane.
+    const ScalarType xyDistanceSquared = cartesianCoordinates( 0 ) * cartesianCoordinates( 0 )
+            + cartesianCoordinates( 1 ) * cartesianCoordinates( 1 );
+
+    // Compute distance within xy-plane.
+    const ScalarType xyDistance = sqrt( xyDistanceSquared );
+
+    // Compute transformation matrix.
+    const Eigen::Matrix< ScalarType, 3, 3 > transformationMatrix = (
+                Eigen::Matrix< ScalarType, 3, 3 >( ) <<
+                cartesianCoordinates( 0 ) / radius,
+                - cartesianCoordinates( 0 ) * cartesianCoordinates( 2 )
+                / ( radius * radius * xyDistance ),
+                - cartesianCoordinates( 1 ) / xyDistanceSquared,
+                cartesianCoordinates( 1 ) / radius,
+                - cartesianCoordinates( 1 ) * cartesianCoordinates( 2 )
+                / ( radius * radius * xyDistance ),
+                cartesianCoordinates( 0 ) / xyDistanceSquared,
+                cartesianCoordinates( 2 ) / radius,
+                xyDistance / ( radius * radius ),
+                ScalarType( 0.0 )
+                ).finished( );
+
+    // Return Cartesian gradient.
+    return transformationMatrix * sphericalGradient;
+}
+
 //! Convert spherical to Cartesian state.
 /*!
   * Converts a spherical state to a Cartesian state. The transformation matrices are computed
@@ -27,6 +27,8 @@
  *      120926    E. Dekens         File created.
  *      121218    S. Billemont      Added output fuctions to display Legendre polynomial data,
  *                                  for debugging.
+ *      140221    S. Vermeer        Geodesy-normalized Legendre polynomial derivative now uses
+ *                                  scalar-type template.
  *
  *    References
  *
@@ -208,23 +210,9 @@ double computeGeodesyLegendrePolynomialDerivative( const int degree,
                                                    const double currentLegendrePolynomial,
                                                    const double incrementedLegendrePolynomial )
 {
-    // Compute normalization correction factor.
-    double normalizationCorrection = std::sqrt( ( static_cast< double >( degree )
-                                                  + static_cast< double >( order ) + 1.0 )
-                                                * ( static_cast< double >( degree - order ) ) );
-
-    // If order is zero apply multiplication factor.
-    if ( order == 0 )
-    {
-        normalizationCorrection *= std::sqrt( 0.5 );
-    }
-
-    // Return polynomial derivative.
-    return normalizationCorrection * incrementedLegendrePolynomial
-            / std::sqrt( 1.0 - polynomialParameter * polynomialParameter )
-            - static_cast< double >( order ) * polynomialParameter
-            / ( 1.0 - polynomialParameter * polynomialParameter )
-            * currentLegendrePolynomial;
+    return computeGeodesyLegendrePolynomialDerivativeTemplate< double >(
+                degree, order, polynomialParameter, currentLegendrePolynomial,
+                incrementedLegendrePolynomial );
 }
 
 //! Compute low degree/order unnormalized Legendre polynomial explicitly.
@@ -28,6 +28,12 @@
  *      121218    S. Billemont      Added output fuctions to display Legendre polynomial data,
  *                                  for debugging.
  *      130121    K. Kumar          Added shared-ptr typedefs.
+ *      140221    S. Vermeer        Added scalar-type template of geodesy-normalized Legendre
+ *                                  polynomial derivative.
+ *      140401    S. Vermeer        Renamed scalar-type template of Legendre polynomial derivative,
+ *                                  so that it does not overload the double-precision function;
+ *                                  added scalar-type template of geodesy-normalized Legendre
+ *                                  polynomial.
  *
  *    References
  *      Eberly, D. Spherical Harmonics. Help documentation of Geometric Tools, 2008. Available at
@@ -52,6 +58,7 @@
 #ifndef TUDAT_LEGENDRE_POLYNOMIALS_H
 #define TUDAT_LEGENDRE_POLYNOMIALS_H
 
+#include <cmath>
 #include <cstddef>
 #include <iostream>
 
@@ -138,6 +145,26 @@ double computeGeodesyLegendrePolynomial( const int degree,
                                          const int order,
                                          const double polynomialParameter );
 
+//! Compute geodesy-normalized associated Legendre polynomial for arbitrary scalar type.
+/*!
+ * Computes the geodesy-normalized associated Legendre polynomial, as described for the
+ * double-precision computeGeodesyLegendrePolynomial() function, for use in functions that are
+ * templated on their scalar type. This generic version forwards to the double-precision function;
+ * an overload for automatic differentiation scalars is provided in automaticDifferentiation.h.
+ * \tparam ScalarType Scalar type used for polynomial parameter and polynomial.
+ * \param degree Degree of requested Legendre polynomial.
+ * \param order Order of requested Legendre polynomial.
+ * \param polynomialParameter Free variable of requested Legendre polynomial.
+ * \return Geodesy-normalized Legendre polynomial.
+ */
+template< typename ScalarType >
+ScalarType computeGeodesyLegendrePolynomialTemplate( const int degree,
+                                                     const int order,
+                                                     const ScalarType& polynomialParameter )
+{
+    return computeGeodesyLegendrePolynomial( degree, order, polynomialParameter );
+}
+
 //! Compute derivative of unnormalized Legendre polynomial.
 /*!
  * The derivative is computed as:
@@ -189,6 +216,57 @@ double computeGeodesyLegendrePolynomialDerivative( const int degree,
                                                    const double currentLegendrePolynomial,
                                                    const double incrementedLegendrePolynomial );
 
+//! Compute derivative of geodesy-normalized Legendre polynomial for arbitrary scalar type.
+/*!
+ * Computes the derivative of a geodesy-normalized Legendre polynomial, as described for the
+ * double-precision computeGeodesyLegendrePolynomialDerivative() function, for an arbitrary scalar
+ * type (for instance an automatic differentiation scalar).
+ * \tparam ScalarType Scalar type used for polynomial parameter and polynomials.
+ * \param degree Degree of requested Legendre polynomial derivative.
+ * \param order Order of requested Legendre polynomial derivative.
+ * \param polynomialParameter Free variable  of requested Legendre polynomial derivative.
+ * \param currentLegendrePolynomial Geodesy-normalized Legendre polynomial with the same degree,
+ *          order and polynomial parameter as the requested Legendre polynomial derivative.
+ * \param incrementedLegendrePolynomial Geodesy-normalized Legendre polynomial with the same degree
+ *          and polynomial parameter as the requested Legendre polynomial derivative, but with an
+ *          order of one more.
+ * \return Geodesy-normalized Legendre polynomial derivative with respect to the polynomial
+ *          parameter.
+ */
+template< typename ScalarType >
+ScalarType computeGeodesyLegendrePolynomialDerivativeTemplate(
+        const int degree,
+        const int order,
+        const ScalarType& polynomialParameter,
+        const ScalarType& currentLegendrePolynomial,
+        const ScalarType& incrementedLegendrePolynomial )
+{
+    using std::sqrt;
+
+    // Compute normalization correction factor.
+    double normalizationCorrection = std::sqrt( ( static_cast< double >( degree )
+                                                  + static_cast< double >( order ) + 1.0 )
+                                                * ( static_cast< double >( degree - order ) ) );
+
+    // If order is zero apply multiplication factor.
+    if ( order == 0 )
+    {
+        normalizationCorrection *= std::sqrt( 0.5 );
+    }
+
+    // Compute complement of square of polynomial parameter.
+    const ScalarType parameterSquareComplement
+            = 1.0 - polynomialParameter * polynomialParameter;
+
+    // Return polynomial derivative.
+    const ScalarType legendrePolynomialDerivative
+            = normalizationCorrection * incrementedLegendrePolynomial
+            / sqrt( parameterSquareComplement )
+            - static_cast< double >( order ) * polynomialParameter / parameterSquareComplement
+            * currentLegendrePolynomial;
+    return legendrePolynomialDerivative;
+}
+
 //! Compute low degree/order unnormalized Legendre polynomial explicitly.
 /*!
  * The associated Legendre polynomial \f$ P_{ n, m }(u) \f$ with degree \f$ n \f$, order
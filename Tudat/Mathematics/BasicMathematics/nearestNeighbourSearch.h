@@ -41,6 +41,7 @@
  *      120716    D. Dirkx          Updated with new nearest neighbour search algorithms.
  *      130114    D. Dirkx          Added missing include statements; corrected include guard
  *                                  name.
+ *      140415    S. Vermeer        Passed vector to templated binary search by reference.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -101,7 +102,7 @@ int computeNearestLeftNeighborUsingBinarySearch(
  */
 template< typename IndependentVariableType >
 int computeNearestLeftNeighborUsingBinarySearch(
-        const std::vector< IndependentVariableType > vectorOfSortedData,
+        const std::vector< IndependentVariableType >& vectorOfSortedData,
         const IndependentVariableType targetValueInVectorOfSortedData )
 {
     // Declare local variables.
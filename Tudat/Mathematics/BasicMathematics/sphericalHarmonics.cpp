@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      140221    S. Vermeer        Potential gradient now uses scalar-type template.
  *
  *    References
  *
@@ -55,41 +56,10 @@ Eigen::Vector3d computePotentialGradient(
         const double legendrePolynomial,
         const double legendrePolynomialDerivative )
 {
-    // Initialize return variable.
-    Eigen::Vector3d potentialGradient;
-
-    // Compute radius power term.
-    const double radiusPowerTerm = std::pow( referenceRadius / sphericalPosition( radiusIndex ),
-                                             static_cast< double >( degree ) + 1.0 );
-
-    // Calculate derivative with respect to radius.
-    potentialGradient( radiusIndex ) = - preMultiplier / sphericalPosition( radiusIndex )
-            * radiusPowerTerm
-            * ( static_cast< double >( degree ) + 1.0 ) * legendrePolynomial
-            * ( cosineHarmonicCoefficient
-                * std::cos( static_cast< double >( order ) * sphericalPosition( longitudeIndex ) )
-                + sineHarmonicCoefficient
-                * std::sin( static_cast< double >( order )
-                            * sphericalPosition( longitudeIndex ) ) );
-
-    // Calculate derivative with respect to latitude.
-    potentialGradient( latitudeIndex ) = preMultiplier * radiusPowerTerm
-            * legendrePolynomialDerivative
-            * std::cos( sphericalPosition( latitudeIndex ) ) * ( cosineHarmonicCoefficient
-            * std::cos( static_cast< double >( order ) * sphericalPosition ( longitudeIndex ) )
-            + sineHarmonicCoefficient * std::sin( static_cast< double >( order )
-                                                  * sphericalPosition( longitudeIndex ) ) );
-
-    // Calculate derivative with respect to longitude.
-    potentialGradient( longitudeIndex ) = preMultiplier * radiusPowerTerm
-            * static_cast< double >( order ) * legendrePolynomial
-            * ( sineHarmonicCoefficient * std::cos( static_cast< double >( order )
-                                                    * sphericalPosition( longitudeIndex ) )
-            - cosineHarmonicCoefficient * std::sin( static_cast< double >( order )
-                                                    * sphericalPosition( longitudeIndex ) ) );
-
-    // Return result.
-    return potentialGradient;
+    return computePotentialGradientTemplate< double >(
+                sphericalPosition, referenceRadius, preMultiplier, degree, order,
+                cosineHarmonicCoefficient, sineHarmonicCoefficient, legendrePolynomial,
+                legendrePolynomialDerivative );
 }
 
 } // namespace basic_mathematics
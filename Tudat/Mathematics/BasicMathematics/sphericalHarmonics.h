@@ -25,6 +25,9 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      140221    S. Vermeer        Added scalar-type template of potential gradient.
+ *      140401    S. Vermeer        Renamed scalar-type template of potential gradient, so that it
+ *                                  does not overload the double-precision function.
  *
  *    References
  *
@@ -35,6 +38,8 @@
 #ifndef TUDAT_SPHERICAL_HARMONICS_H
 #define TUDAT_SPHERICAL_HARMONICS_H
 
+#include <cmath>
+
 #include <Eigen/Core>
 
 namespace tudat
@@ -110,6 +115,83 @@ Eigen::Vector3d computePotentialGradient( const Eigen::Vector3d& sphericalPositi
                                           const double legendrePolynomial,
                                           const double legendrePolynomialDerivative );
 
+//! Compute the gradient of a single term of a spherical harmonics potential field for arbitrary
+//! scalar type.
+/*!
+ * Computes the gradient of a single term of a spherical harmonics potential field, as described
+ * for the double-precision computePotentialGradient() function, for an arbitrary scalar type of
+ * the position, pre-multiplier and Legendre polynomials (for instance an automatic
+ * differentiation scalar). The reference radius and harmonic coefficients are double-precision.
+ * \tparam ScalarType Scalar type used for position, pre-multiplier and Legendre polynomials.
+ * \param sphericalPosition Vector with spherical coordinates (radius, latitude, longitude).
+ * \param referenceRadius Radius of harmonics reference sphere.
+ * \param preMultiplier Generic multiplication factor.
+ * \param degree Degree of the harmonic for which the gradient is to be computed.
+ * \param order Order of the harmonic for which the gradient is to be computed.
+ * \param cosineHarmonicCoefficient Coefficient which characterizes relative strengh of a harmonic
+ *          term.
+ * \param sineHarmonicCoefficient Coefficient which characterizes relative strengh of a harmonic
+ *          term.
+ * \param legendrePolynomial Value of associated Legendre polynomial with the same degree and order
+ *          as the to be computed harmonic, and with the sine of the latitude coordinate as
+ *          polynomial parameter.
+ * \param legendrePolynomialDerivative Value of the derivative of parameter 'legendrePolynomial'
+ *          with respect to the sine of the latitude angle.
+ * \return Vector with derivatives of potential field with respect to radial distance, latitude
+ *          angle and longitude angle.
+ */
+template< typename ScalarType >
+Eigen::Matrix< ScalarType, 3, 1 > computePotentialGradientTemplate(
+        const Eigen::Matrix< ScalarType, 3, 1 >& sphericalPosition,
+        const double referenceRadius,
+        const ScalarType& preMultiplier,
+        const int degree,
+        const int order,
+        const double cosineHarmonicCoefficient,
+        const double sineHarmonicCoefficient,
+        const ScalarType& legendrePolynomial,
+        const ScalarType& legendrePolynomialDerivative )
+{
+    using std::cos;
+    using std::pow;
+    using std::sin;
+
+    // Initialize return variable.
+    Eigen::Matrix< ScalarType, 3, 1 > potentialGradient;
+
+    // Compute radius power term.
+    const ScalarType radiusPowerTerm = pow( referenceRadius / sphericalPosition( radiusIndex ),
+                                            static_cast< double >( degree ) + 1.0 );
+
+    // Compute sine and cosine of order times longitude.
+    const ScalarType cosineOfOrderLongitude
+            = cos( static_cast< double >( order ) * sphericalPosition( longitudeIndex ) );
+    const ScalarType sineOfOrderLongitude
+            = sin( static_cast< double >( order ) * sphericalPosition( longitudeIndex ) );
+
+    // Calculate derivative with respect to radius.
+    potentialGradient( radiusIndex ) = - preMultiplier / sphericalPosition( radiusIndex )
+            * radiusPowerTerm
+            * ( static_cast< double >( degree ) + 1.0 ) * legendrePolynomial
+            * ( cosineHarmonicCoefficient * cosineOfOrderLongitude
+                + sineHarmonicCoefficient * sineOfOrderLongitude );
+
+    // Calculate derivative with respect to latitude.
+    potentialGradient( latitudeIndex ) = preMultiplier * radiusPowerTerm
+            * legendrePolynomialDerivative * cos( sphericalPosition( latitudeIndex ) )
+            * ( cosineHarmonicCoefficient * cosineOfOrderLongitude
+                + sineHarmonicCoefficient * sineOfOrderLongitude );
+
+    // Calculate derivative with respect to longitude.
+    potentialGradient( longitudeIndex ) = preMultiplier * radiusPowerTerm
+            * static_cast< double >( order ) * legendrePolynomial
+            * ( sineHarmonicCoefficient * cosineOfOrderLongitude
+                - cosineHarmonicCoefficient * sineOfOrderLongitude );
+
+    // Return result.
+    return potentialGradient;
+}
+
 } // namespace basic_mathematics
 } // namespace tudat
 
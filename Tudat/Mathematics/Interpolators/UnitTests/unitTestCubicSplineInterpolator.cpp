@@ -32,6 +32,8 @@
  *      120529    E.A.G. Heeren     Boostified unit test.
  *      120615    T. Secretin       Added check for exception handling.
  *      120716    D. Dirkx          Updated with interpolator architecture.
+ *      140317    S. Vermeer        Added test of precomputed polynomial coefficients,
+ *                                  derivatives and batch interpolation.
  *
  *    References
  *
@@ -43,6 +45,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
 #include <vector>
 
 #include <TudatCore/Basics/testMacros.h>
@@ -237,6 +240,73 @@ BOOST_AUTO_TEST_CASE( test_cubicSplineInterpolator_matlab_compare )
                                        outputData, 1.0e-5 );
 }
 
+// Test cubic spline interpolator with precomputed polynomial coefficients, derivatives and batch
+// interpolation, by comparison to the standard evaluation and to the analytical derivatives of
+// the function through which the spline is fitted.
+BOOST_AUTO_TEST_CASE( test_cubicSplineInterpolator_polynomialCoefficientsAndDerivatives )
+{
+    using namespace interpolators;
+
+    // Sample sine function on non-uniform grid.
+    std::vector< double > independentVariableValues;
+    std::vector< double > dependentVariableValues;
+    for ( int i = 0; i < 400; i++ )
+    {
+        independentVariableValues.push_back( 0.02 * static_cast< double >( i )
+                                             + 1.0E-5 * static_cast< double >( i * i ) );
+        dependentVariableValues.push_back( std::sin( independentVariableValues.back( ) ) );
+    }
+
+    // Create cubic spline interpolators with and without precomputed polynomial coefficients.
+    CubicSplineInterpolatorDouble standardInterpolator(
+                independentVariableValues, dependentVariableValues, huntingAlgorithm );
+    const CubicSplineInterpolatorDouble polynomialInterpolator(
+                independentVariableValues, dependentVariableValues, huntingAlgorithm, true );
+    BOOST_CHECK( !standardInterpolator.arePolynomialCoefficientsPrecomputed( ) );
+    BOOST_CHECK( polynomialInterpolator.arePolynomialCoefficientsPrecomputed( ) );
+
+    // Set target values (away from end points, where natural boundary conditions apply), in a
+    // number that is not a multiple of the batch block size.
+    std::vector< double > targetValues;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        targetValues.push_back( 1.0 + 0.00723 * static_cast< double >( i ) );
+    }
+
+    // Perform batch interpolation with and without precomputed coefficients.
+    std::vector< double > standardBatchValues;
+    std::vector< double > polynomialBatchValues;
+    standardInterpolator.interpolateBatch( targetValues, standardBatchValues );
+    polynomialInterpolator.interpolateBatch( targetValues, polynomialBatchValues );
+    BOOST_REQUIRE_EQUAL( polynomialBatchValues.size( ), targetValues.size( ) );
+
+    LookUpCursor lookUpCursor;
+    for ( unsigned int i = 0; i < targetValues.size( ); i++ )
+    {
+        // Check values against standard evaluation and batch evaluation.
+        const double standardValue = standardInterpolator.interpolate( targetValues[ i ] );
+        BOOST_CHECK_EQUAL( standardBatchValues[ i ], standardValue );
+        BOOST_CHECK_SMALL( polynomialInterpolator.interpolate( targetValues[ i ], lookUpCursor )
+                           - standardValue, 1.0E-14 );
+        BOOST_CHECK_EQUAL( polynomialBatchValues[ i ],
+                           polynomialInterpolator.interpolate( targetValues[ i ],
+                                                               lookUpCursor ) );
+
+        // Check derivatives against each other and against analytical derivatives.
+        const double firstDerivative =
+                standardInterpolator.interpolateFirstDerivative( targetValues[ i ] );
+        BOOST_CHECK_SMALL( polynomialInterpolator.interpolateFirstDerivative(
+                               targetValues[ i ], lookUpCursor ) - firstDerivative, 1.0E-12 );
+        BOOST_CHECK_SMALL( firstDerivative - std::cos( targetValues[ i ] ), 1.0E-6 );
+
+        const double secondDerivative =
+                standardInterpolator.interpolateSecondDerivative( targetValues[ i ] );
+        BOOST_CHECK_EQUAL( polynomialInterpolator.interpolateSecondDerivative(
+                               targetValues[ i ], lookUpCursor ), secondDerivative );
+        BOOST_CHECK_SMALL( secondDerivative + std::sin( targetValues[ i ] ), 1.0E-3 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
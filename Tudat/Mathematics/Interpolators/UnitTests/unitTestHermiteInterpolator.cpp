@@ -0,0 +1,165 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/Interpolators/hermiteInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_hermite_interpolator )
+
+//! Test if polynomial of degree 2n - 1 and its derivative are reproduced on non-uniform grid.
+BOOST_AUTO_TEST_CASE( testHermiteInterpolatorPolynomialReproduction )
+{
+    using namespace interpolators;
+
+    // Create non-uniform grid with values and derivatives of polynomial of degree 7.
+    std::vector< double > independentVariableValues;
+    std::vector< double > dependentVariableValues;
+    std::vector< double > dependentVariableDerivatives;
+    for ( int i = 0; i < 12; i++ )
+    {
+        const double x = -2.0 + 0.4 * static_cast< double >( i )
+                + 0.07 * std::cos( static_cast< double >( i ) );
+        independentVariableValues.push_back( x );
+        dependentVariableValues.push_back(
+                    1.0 + x - 0.3 * std::pow( x, 4 ) + 0.01 * std::pow( x, 7 ) );
+        dependentVariableDerivatives.push_back(
+                    1.0 - 1.2 * std::pow( x, 3 ) + 0.07 * std::pow( x, 6 ) );
+    }
+
+    // Create 4-point Hermite interpolator, which is exact for polynomials up to degree 7.
+    HermiteInterpolatorDouble interpolator( independentVariableValues, dependentVariableValues,
+                                            dependentVariableDerivatives, 4 );
+    BOOST_CHECK_EQUAL( interpolator.getNumberOfPoints( ), 4 );
+
+    LookUpCursor lookUpCursor;
+    for ( int i = 0; i <= 1000; i++ )
+    {
+        const double x = independentVariableValues.front( )
+                + ( independentVariableValues.back( ) - independentVariableValues.front( ) )
+                * static_cast< double >( i ) / 1000.0;
+        BOOST_CHECK_SMALL( interpolator.interpolate( x )
+                           - ( 1.0 + x - 0.3 * std::pow( x, 4 ) + 0.01 * std::pow( x, 7 ) ),
+                           1.0E-12 );
+        BOOST_CHECK_SMALL( interpolator.interpolateFirstDerivative( x, lookUpCursor )
+                           - ( 1.0 - 1.2 * std::pow( x, 3 ) + 0.07 * std::pow( x, 6 ) ),
+                           1.0E-11 );
+    }
+
+    // Check that data points and derivatives are returned exactly, and that the derivative is
+    // continuous close to the data points.
+    for ( unsigned int i = 0; i < independentVariableValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( interpolator.interpolate( independentVariableValues[ i ] ),
+                           dependentVariableValues[ i ] );
+        BOOST_CHECK_EQUAL(
+                    interpolator.interpolateFirstDerivative( independentVariableValues[ i ] ),
+                    dependentVariableDerivatives[ i ] );
+        BOOST_CHECK_SMALL( interpolator.interpolateFirstDerivative(
+                               independentVariableValues[ i ] + 1.0E-12 )
+                           - dependentVariableDerivatives[ i ], 1.0E-10 );
+    }
+}
+
+//! Test cubic Hermite interpolation of circular motion.
+BOOST_AUTO_TEST_CASE( testHermiteInterpolatorCircularMotion )
+{
+    using namespace interpolators;
+
+    // Tabulate position and velocity on circle.
+    std::vector< double > times;
+    std::vector< Eigen::Vector2d > positions;
+    std::vector< Eigen::Vector2d > velocities;
+    for ( int i = 0; i <= 200; i++ )
+    {
+        const double time = 0.05 * static_cast< double >( i );
+        times.push_back( time );
+        positions.push_back( Eigen::Vector2d( std::cos( time ), std::sin( time ) ) );
+        velocities.push_back( Eigen::Vector2d( -std::sin( time ), std::cos( time ) ) );
+    }
+
+    // Compare 2- and 6-point interpolation at mid-points.
+    HermiteInterpolator< double, Eigen::Vector2d > cubicInterpolator(
+                times, positions, velocities, 2, uniformGrid );
+    HermiteInterpolator< double, Eigen::Vector2d > higherOrderInterpolator(
+                times, positions, velocities, 6, uniformGrid );
+    for ( int i = 0; i < 200; i++ )
+    {
+        const double time = 0.05 * static_cast< double >( i ) + 0.025;
+        const Eigen::Vector2d expectedPosition( std::cos( time ), std::sin( time ) );
+
+        // Error of cubic Hermite interpolation is bounded by h^4 / 384 times the fourth
+        // derivative.
+        BOOST_CHECK_SMALL( ( cubicInterpolator.interpolate( time ) - expectedPosition ).norm( ),
+                           std::pow( 0.05, 4 ) / 384.0 );
+        BOOST_CHECK_SMALL(
+                    ( higherOrderInterpolator.interpolate( time ) - expectedPosition ).norm( ),
+                    5.0E-15 );
+        BOOST_CHECK_SMALL(
+                    ( higherOrderInterpolator.interpolateFirstDerivative( time )
+                      - Eigen::Vector2d( -std::sin( time ), std::cos( time ) ) ).norm( ),
+                    1.0E-13 );
+    }
+}
+
+//! Test exceptions for invalid settings.
+BOOST_AUTO_TEST_CASE( testHermiteInterpolatorExceptions )
+{
+    using namespace interpolators;
+
+    const std::vector< double > values( 6, 0.0 );
+
+    BOOST_CHECK_THROW( HermiteInterpolatorDouble( values, values, values, 3 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( HermiteInterpolatorDouble( values, values, std::vector< double >( 4 ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,170 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Evaluate polynomial of degree 7, used to test exact reproduction by Lagrange interpolator.
+double evaluateSeventhDegreePolynomial( const double x )
+{
+    return 2.0 - 0.5 * x + 0.3 * std::pow( x, 2 ) - 0.02 * std::pow( x, 3 )
+            + 1.0E-3 * std::pow( x, 5 ) - 2.0E-5 * std::pow( x, 7 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_lagrange_interpolator )
+
+//! Test if polynomial of degree n - 1 is reproduced exactly on non-uniform grid.
+BOOST_AUTO_TEST_CASE( testLagrangeInterpolatorPolynomialReproduction )
+{
+    using namespace interpolators;
+
+    // Create non-uniform grid with polynomial values.
+    std::vector< double > independentVariableValues;
+    std::vector< double > dependentVariableValues;
+    for ( int i = 0; i < 25; i++ )
+    {
+        const double x = -3.0 + 0.25 * static_cast< double >( i )
+                + 0.05 * std::sin( static_cast< double >( i ) );
+        independentVariableValues.push_back( x );
+        dependentVariableValues.push_back( evaluateSeventhDegreePolynomial( x ) );
+    }
+
+    // Create 8-point interpolators, using different look-up schemes.
+    LagrangeInterpolatorDouble huntingInterpolator(
+                independentVariableValues, dependentVariableValues, 8, huntingAlgorithm );
+    LagrangeInterpolatorDouble binarySearchInterpolator(
+                independentVariableValues, dependentVariableValues, 8, binarySearch );
+    BOOST_CHECK_EQUAL( huntingInterpolator.getNumberOfPoints( ), 8 );
+
+    // Check interpolation over full range, including the windows at the ends and the data points.
+    LookUpCursor lookUpCursor;
+    for ( int i = 0; i <= 1000; i++ )
+    {
+        const double x = independentVariableValues.front( )
+                + ( independentVariableValues.back( ) - independentVariableValues.front( ) )
+                * static_cast< double >( i ) / 1000.0;
+        BOOST_CHECK_CLOSE_FRACTION( huntingInterpolator.interpolate( x ),
+                                    evaluateSeventhDegreePolynomial( x ), 1.0E-12 );
+        BOOST_CHECK_EQUAL( huntingInterpolator.interpolate( x, lookUpCursor ),
+                           binarySearchInterpolator.interpolate( x ) );
+    }
+
+    // Check that data points are returned exactly.
+    for ( unsigned int i = 0; i < independentVariableValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( huntingInterpolator.interpolate( independentVariableValues[ i ] ),
+                           dependentVariableValues[ i ] );
+    }
+}
+
+//! Test interpolation of vector-valued function, and convergence with number of points.
+BOOST_AUTO_TEST_CASE( testLagrangeInterpolatorConvergence )
+{
+    using namespace interpolators;
+
+    // Tabulate sine and cosine at uniform grid.
+    std::map< double, Eigen::Vector2d > dataMap;
+    for ( int i = 0; i <= 100; i++ )
+    {
+        const double x = 0.1 * static_cast< double >( i );
+        dataMap[ x ] = Eigen::Vector2d( std::sin( x ), std::cos( x ) );
+    }
+
+    // Determine maximum error at mid-points for increasing number of points.
+    double previousMaximumError = 1.0;
+    for ( int numberOfPoints = 2; numberOfPoints <= 10; numberOfPoints += 2 )
+    {
+        LagrangeInterpolator< double, Eigen::Vector2d > interpolator(
+                    dataMap, numberOfPoints, uniformGrid );
+
+        double maximumError = 0.0;
+        for ( int i = 0; i < 100; i++ )
+        {
+            const double x = 0.1 * static_cast< double >( i ) + 0.05;
+            maximumError = std::max(
+                        maximumError,
+                        ( interpolator.interpolate( x )
+                          - Eigen::Vector2d( std::sin( x ), std::cos( x ) ) ).norm( ) );
+        }
+
+        // Error of linear interpolation is h^2 / 8, and decreases rapidly with window size.
+        BOOST_CHECK_LT( maximumError, 0.01 * previousMaximumError );
+        previousMaximumError = maximumError;
+    }
+    BOOST_CHECK_LT( previousMaximumError, 2.0E-12 );
+}
+
+//! Test exceptions for invalid settings.
+BOOST_AUTO_TEST_CASE( testLagrangeInterpolatorExceptions )
+{
+    using namespace interpolators;
+
+    const std::vector< double > independentVariableValues( 6, 0.0 );
+    const std::vector< double > dependentVariableValues( 6, 0.0 );
+
+    // Check that odd number of points throws an exception.
+    BOOST_CHECK_THROW( LagrangeInterpolatorDouble( independentVariableValues,
+                                                   dependentVariableValues, 5 ),
+                       std::runtime_error );
+
+    // Check that number of points larger than number of data points throws an exception.
+    BOOST_CHECK_THROW( LagrangeInterpolatorDouble( independentVariableValues,
+                                                   dependentVariableValues, 8 ),
+                       std::runtime_error );
+
+    // Check that inconsistent data sizes throw an exception.
+    BOOST_CHECK_THROW( LagrangeInterpolatorDouble( independentVariableValues,
+                                                   std::vector< double >( 5, 0.0 ), 4 ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
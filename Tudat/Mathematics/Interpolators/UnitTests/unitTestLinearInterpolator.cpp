@@ -42,6 +42,7 @@
  *      120529    E.A.G. Heeren     Boostified unit test.
  *      120615    T. Secretin       Minor layout changes.
  *      120716    D. Dirkx          Updated with interpolator architecture.
+ *      140326    S. Vermeer        Added test of interpolation from shared data.
  *
  *    References
  *
@@ -51,8 +52,14 @@
 
 #define BOOST_TEST_MAIN
 
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <Eigen/Core>
 
 #include <TudatCore/Basics/testMacros.h>
@@ -193,6 +200,77 @@ BOOST_AUTO_TEST_CASE( test_linearInterpolation_matlab_compare )
                                        outputData, 1.0E-13 );
 }
 
+// Test linear interpolation with data shared between interpolators.
+BOOST_AUTO_TEST_CASE( test_linearInterpolation_sharedData )
+{
+    using namespace interpolators;
+
+    // Create shared data vectors.
+    std::vector< double > independentVariableValues;
+    std::vector< double > dependentVariableValues;
+    for ( int i = 0; i < 20; i++ )
+    {
+        independentVariableValues.push_back( 0.5 * static_cast< double >( i * i ) );
+        dependentVariableValues.push_back( std::sin( 0.1 * static_cast< double >( i ) ) );
+    }
+    const boost::shared_ptr< const std::vector< double > > sharedIndependentVariableValues =
+            boost::make_shared< const std::vector< double > >( independentVariableValues );
+    const boost::shared_ptr< const std::vector< double > > sharedDependentVariableValues =
+            boost::make_shared< const std::vector< double > >( dependentVariableValues );
+
+    // Create interpolators from shared data, and from copied data.
+    const LinearInterpolatorDouble firstSharedInterpolator(
+                sharedIndependentVariableValues, sharedDependentVariableValues, huntingAlgorithm );
+    const LinearInterpolatorDouble secondSharedInterpolator(
+                sharedIndependentVariableValues, sharedDependentVariableValues, binarySearch );
+    const LinearInterpolatorDouble copyingInterpolator(
+                independentVariableValues, dependentVariableValues, binarySearch );
+
+    // Check that data is shared by both interpolators and their look-up schemes, and not copied.
+    BOOST_CHECK( firstSharedInterpolator.getSharedIndependentValues( ).getSharedPointer( )
+                 == sharedIndependentVariableValues );
+    BOOST_CHECK( secondSharedInterpolator.getSharedDependentValues( ).getSharedPointer( )
+                 == sharedDependentVariableValues );
+    BOOST_CHECK_EQUAL( &firstSharedInterpolator.getIndependentValues( )[ 0 ],
+                       &( *sharedIndependentVariableValues )[ 0 ] );
+    BOOST_CHECK_EQUAL( sharedIndependentVariableValues.use_count( ), 5 );
+    BOOST_CHECK_EQUAL( sharedDependentVariableValues.use_count( ), 3 );
+
+    // Create interpolator referencing data owned by this function.
+    const LinearInterpolatorDouble nonOwningInterpolator(
+                createNonOwningSharedPointer( independentVariableValues ),
+                createNonOwningSharedPointer( dependentVariableValues ) );
+    BOOST_CHECK_EQUAL( &nonOwningInterpolator.getDependentValues( )[ 0 ],
+                       &dependentVariableValues[ 0 ] );
+
+    // Check that all interpolators give identical results.
+    LookUpCursor firstCursor, secondCursor, thirdCursor, fourthCursor;
+    for ( int i = 0; i < 100; i++ )
+    {
+        const double targetValue = 1.83 * static_cast< double >( i );
+        const double expectedValue = copyingInterpolator.interpolate( targetValue, firstCursor );
+        BOOST_CHECK_EQUAL( firstSharedInterpolator.interpolate( targetValue, secondCursor ),
+                           expectedValue );
+        BOOST_CHECK_EQUAL( secondSharedInterpolator.interpolate( targetValue, thirdCursor ),
+                           expectedValue );
+        BOOST_CHECK_EQUAL( nonOwningInterpolator.interpolate( targetValue, fourthCursor ),
+                           expectedValue );
+    }
+
+    // Check that data is released with the interpolators that share it.
+    {
+        const LinearInterpolatorDouble temporaryInterpolator(
+                    sharedIndependentVariableValues, sharedDependentVariableValues );
+        BOOST_CHECK_EQUAL( sharedIndependentVariableValues.use_count( ), 7 );
+    }
+    BOOST_CHECK_EQUAL( sharedIndependentVariableValues.use_count( ), 5 );
+
+    // Check that interpolator cannot be created from null pointer.
+    BOOST_CHECK_THROW( LinearInterpolatorDouble(
+                           boost::shared_ptr< const std::vector< double > >( ),
+                           sharedDependentVariableValues ), std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
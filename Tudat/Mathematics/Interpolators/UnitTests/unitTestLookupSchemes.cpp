@@ -0,0 +1,367 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140310    S. Vermeer        File created.
+ *      140312    S. Vermeer        Added tests of caller-owned look-up cursors.
+ *
+ *    References
+ *
+ *    Notes
+ *      The uniform grid look-up schemes are tested by comparison to the binary search look-up
+ *      scheme, which is taken as reference.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/multi_array.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/InputOutput/matrixTextFileReader.h>
+
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/lookupScheme.h"
+#include "Tudat/Mathematics/Interpolators/multiLinearInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Generate values at which look-up schemes are tested.
+/*!
+ * Generates values at which look-up schemes are tested: all nodes, values between nodes and
+ * values outside the range of the nodes.
+ * \param independentVariableValues Vector of independent variable values.
+ * \return Values at which look-up schemes are to be tested.
+ */
+std::vector< double > getLookupTestValues( const std::vector< double >& independentVariableValues )
+{
+    std::vector< double > testValues;
+    testValues.push_back( independentVariableValues.front( ) - 1.0E3 );
+    testValues.push_back( independentVariableValues.front( ) - 1.0E-12 );
+    for ( unsigned int i = 0; i < independentVariableValues.size( ) - 1; i++ )
+    {
+        testValues.push_back( independentVariableValues[ i ] );
+        testValues.push_back( 0.3 * independentVariableValues[ i ]
+                              + 0.7 * independentVariableValues[ i + 1 ] );
+    }
+    testValues.push_back( independentVariableValues.back( ) );
+    testValues.push_back( independentVariableValues.back( ) + 1.0E-12 );
+    testValues.push_back( independentVariableValues.back( ) + 1.0E3 );
+    return testValues;
+}
+
+//! Interpolate a sequence of values with a shared interpolator and a thread-local cursor.
+/*!
+ * Interpolates a sequence of values, starting at a given offset in the vector of target values
+ * and wrapping around, with a shared interpolator and a cursor owned by the calling thread.
+ * \param interpolator Interpolator, shared between threads.
+ * \param targetValues Target values of independent variable.
+ * \param offset Index of first target value.
+ * \param interpolatedValues Interpolated values, ordered as targetValues (returned by reference).
+ */
+void interpolateWithLookUpCursor( const interpolators::CubicSplineInterpolatorDouble& interpolator,
+                                  const std::vector< double >& targetValues,
+                                  const unsigned int offset,
+                                  std::vector< double >& interpolatedValues )
+{
+    interpolators::LookUpCursor lookUpCursor;
+    interpolatedValues.resize( targetValues.size( ) );
+    for ( unsigned int repetition = 0; repetition < 20; repetition++ )
+    {
+        for ( unsigned int i = 0; i < targetValues.size( ); i++ )
+        {
+            const unsigned int index = ( i + offset ) % targetValues.size( );
+            interpolatedValues[ index ] = interpolator.interpolate( targetValues[ index ],
+                                                                    lookUpCursor );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_lookup_schemes )
+
+// Test uniform grid look-up scheme against binary search look-up scheme.
+BOOST_AUTO_TEST_CASE( testUniformGridLookupScheme )
+{
+    using namespace interpolators;
+
+    // Create uniform grid of which the nodes are not exactly representable.
+    std::vector< double > independentVariableValues;
+    for ( int i = 0; i < 1001; i++ )
+    {
+        independentVariableValues.push_back( -1.0 + 0.1 * static_cast< double >( i ) );
+    }
+
+    // Create look-up schemes.
+    UniformGridLookupScheme< double > uniformGridLookupScheme( independentVariableValues );
+    BinarySearchLookupScheme< double > binarySearchLookupScheme( independentVariableValues );
+
+    // Check that nearest lower neighbours are identical.
+    const std::vector< double > testValues = getLookupTestValues( independentVariableValues );
+    for ( unsigned int i = 0; i < testValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( uniformGridLookupScheme.findNearestLowerNeighbour( testValues[ i ] ),
+                           binarySearchLookupScheme.findNearestLowerNeighbour( testValues[ i ] ) );
+    }
+
+    // Check that non-uniform and descending grids are detected.
+    std::vector< double > nonUniformValues = independentVariableValues;
+    nonUniformValues[ 500 ] += 0.01;
+    BOOST_CHECK( isGridUniform( independentVariableValues ) );
+    BOOST_CHECK( !isGridUniform( nonUniformValues ) );
+    BOOST_CHECK_THROW( UniformGridLookupScheme< double > invalidLookupScheme( nonUniformValues ),
+                       std::runtime_error );
+
+    std::vector< double > descendingValues( independentVariableValues.rbegin( ),
+                                            independentVariableValues.rend( ) );
+    BOOST_CHECK( !isGridUniform( descendingValues ) );
+    BOOST_CHECK_THROW( UniformGridLookupScheme< double > invalidLookupScheme( descendingValues ),
+                       std::runtime_error );
+}
+
+// Test piecewise uniform grid look-up scheme against binary search look-up scheme, using the
+// altitudes of the tabulated atmosphere, which has 100 m steps up to 100 km and 1 km steps above.
+BOOST_AUTO_TEST_CASE( testPiecewiseUniformGridLookupScheme )
+{
+    using namespace interpolators;
+
+    // Load altitudes of tabulated atmosphere.
+    const Eigen::MatrixXd atmosphereTable = input_output::readMatrixFromFile(
+                input_output::getTudatRootPath( ) + "External/AtmosphereTables/"
+                + "USSA1976Until100kmPer100mUntil1000kmPer1000m.dat", " \t", "%" );
+    std::vector< double > altitudes;
+    for ( int i = 0; i < atmosphereTable.rows( ); i++ )
+    {
+        altitudes.push_back( atmosphereTable( i, 0 ) );
+    }
+
+    // Create look-up schemes and check number of detected segments.
+    PiecewiseUniformGridLookupScheme< double > piecewiseUniformGridLookupScheme( altitudes );
+    BinarySearchLookupScheme< double > binarySearchLookupScheme( altitudes );
+    BOOST_CHECK_EQUAL( piecewiseUniformGridLookupScheme.getNumberOfSegments( ), 2 );
+    BOOST_CHECK_THROW( UniformGridLookupScheme< double > invalidLookupScheme( altitudes ),
+                       std::runtime_error );
+
+    // Check that nearest lower neighbours are identical.
+    const std::vector< double > testValues = getLookupTestValues( altitudes );
+    for ( unsigned int i = 0; i < testValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL(
+                    piecewiseUniformGridLookupScheme.findNearestLowerNeighbour( testValues[ i ] ),
+                    binarySearchLookupScheme.findNearestLowerNeighbour( testValues[ i ] ) );
+    }
+
+    // Check that a grid without uniform parts is handled.
+    std::vector< double > irregularValues;
+    for ( int i = 0; i < 20; i++ )
+    {
+        irregularValues.push_back( static_cast< double >( i * i ) );
+    }
+    PiecewiseUniformGridLookupScheme< double > irregularLookupScheme( irregularValues );
+    BinarySearchLookupScheme< double > irregularBinarySearchLookupScheme( irregularValues );
+    const std::vector< double > irregularTestValues = getLookupTestValues( irregularValues );
+    for ( unsigned int i = 0; i < irregularTestValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL(
+                    irregularLookupScheme.findNearestLowerNeighbour( irregularTestValues[ i ] ),
+                    irregularBinarySearchLookupScheme.findNearestLowerNeighbour(
+                        irregularTestValues[ i ] ) );
+    }
+
+    // Check that non-ascending values are detected.
+    irregularValues[ 10 ] = irregularValues[ 9 ];
+    BOOST_CHECK_THROW( PiecewiseUniformGridLookupScheme< double > invalidLookupScheme(
+                           irregularValues ), std::runtime_error );
+}
+
+// Test interpolators using uniform grid look-up schemes against binary search look-up scheme.
+BOOST_AUTO_TEST_CASE( testInterpolatorsWithUniformGridLookupSchemes )
+{
+    using namespace interpolators;
+
+    // Load uniformly gridded tabulated atmosphere.
+    const Eigen::MatrixXd atmosphereTable = input_output::readMatrixFromFile(
+                input_output::getTudatRootPath( ) + "External/AtmosphereTables/"
+                + "USSA1976Until86kmPer100m.dat", " \t", "%" );
+    std::vector< double > altitudes;
+    std::vector< double > densities;
+    for ( int i = 0; i < atmosphereTable.rows( ); i++ )
+    {
+        altitudes.push_back( atmosphereTable( i, 0 ) );
+        densities.push_back( atmosphereTable( i, 1 ) );
+    }
+
+    // Create cubic spline interpolators.
+    CubicSplineInterpolatorDouble binarySearchSpline( altitudes, densities, binarySearch );
+    CubicSplineInterpolatorDouble uniformGridSpline( altitudes, densities, uniformGrid );
+    CubicSplineInterpolatorDouble piecewiseUniformGridSpline(
+                altitudes, densities, piecewiseUniformGrid );
+
+    // Check that interpolated values are identical.
+    const std::vector< double > testValues = getLookupTestValues( altitudes );
+    for ( unsigned int i = 2; i < testValues.size( ) - 2; i++ )
+    {
+        const double expectedDensity = binarySearchSpline.interpolate( testValues[ i ] );
+        BOOST_CHECK_EQUAL( uniformGridSpline.interpolate( testValues[ i ] ), expectedDensity );
+        BOOST_CHECK_EQUAL( piecewiseUniformGridSpline.interpolate( testValues[ i ] ),
+                           expectedDensity );
+    }
+
+    // Create 3-dimensional grid with a non-uniform dimension, and corresponding data.
+    std::vector< std::vector< double > > independentValues( 3 );
+    for ( int i = 0; i < 11; i++ )
+    {
+        independentValues[ 0 ].push_back( -1.0 + static_cast< double >( i ) * 0.2 );
+        independentValues[ 1 ].push_back( 0.3 * static_cast< double >( i ) );
+        independentValues[ 2 ].push_back( static_cast< double >( i < 6 ? i : 2 * i - 5 ) );
+    }
+
+    boost::multi_array< double, 3 > dependentValues( boost::extents[ 11 ][ 11 ][ 11 ] );
+    for ( int i = 0; i < 11; i++ )
+    {
+        for ( int j = 0; j < 11; j++ )
+        {
+            for ( int k = 0; k < 11; k++ )
+            {
+                dependentValues[ i ][ j ][ k ] = independentValues[ 0 ][ i ]
+                        * std::sin( independentValues[ 1 ][ j ] )
+                        + std::sqrt( independentValues[ 2 ][ k ] );
+            }
+        }
+    }
+
+    // Create multi-linear interpolators; the uniform grid scheme requires uniform dimensions.
+    MultiLinearInterpolator< double, double, 3 > binarySearchInterpolator(
+                independentValues, dependentValues, binarySearch );
+    MultiLinearInterpolator< double, double, 3 > piecewiseUniformGridInterpolator(
+                independentValues, dependentValues, piecewiseUniformGrid );
+    BOOST_CHECK_THROW( ( MultiLinearInterpolator< double, double, 3 >(
+                             independentValues, dependentValues, uniformGrid ) ),
+                       std::runtime_error );
+
+    // Check that interpolated values are identical.
+    std::vector< double > targetValue( 3 );
+    for ( int i = 0; i < 21; i++ )
+    {
+        targetValue[ 0 ] = -1.0 + 0.1 * static_cast< double >( i );
+        targetValue[ 1 ] = 0.15 * static_cast< double >( i );
+        targetValue[ 2 ] = 0.8 * static_cast< double >( i );
+        BOOST_CHECK_EQUAL( piecewiseUniformGridInterpolator.interpolate( targetValue ),
+                           binarySearchInterpolator.interpolate( targetValue ) );
+    }
+}
+
+// Test look-ups and interpolation with caller-owned look-up cursors, including concurrent
+// interpolation with a single shared interpolator.
+BOOST_AUTO_TEST_CASE( testLookUpCursors )
+{
+    using namespace interpolators;
+
+    // Create non-uniform grid and corresponding data.
+    std::vector< double > independentVariableValues;
+    std::vector< double > dependentVariableValues;
+    for ( int i = 0; i < 500; i++ )
+    {
+        independentVariableValues.push_back( 0.01 * static_cast< double >( i * i ) );
+        dependentVariableValues.push_back( std::sin( 0.1 * independentVariableValues.back( ) ) );
+    }
+
+    // Check that hunting algorithm with cursor reproduces hunting algorithm with internal state,
+    // and that a cursor containing an index that is invalid for this grid leads to binary search.
+    const HuntingAlgorithmLookupScheme< double > huntingLookupScheme( independentVariableValues );
+    HuntingAlgorithmLookupScheme< double > statefulHuntingLookupScheme(
+                independentVariableValues );
+    BinarySearchLookupScheme< double > binarySearchLookupScheme( independentVariableValues );
+    LookUpCursor lookUpCursor;
+    LookUpCursor invalidLookUpCursor;
+    const std::vector< double > testValues = getLookupTestValues( independentVariableValues );
+    for ( unsigned int i = 0; i < testValues.size( ); i++ )
+    {
+        const int expectedIndex = statefulHuntingLookupScheme.findNearestLowerNeighbour(
+                    testValues[ i ] );
+        BOOST_CHECK_EQUAL( huntingLookupScheme.findNearestLowerNeighbour(
+                               testValues[ i ], lookUpCursor ), expectedIndex );
+        BOOST_CHECK_EQUAL( lookUpCursor.previousNearestLowerIndex, expectedIndex );
+
+        invalidLookUpCursor.isFirstLookupDone = true;
+        invalidLookUpCursor.previousNearestLowerIndex = 1000 + static_cast< int >( i );
+        BOOST_CHECK_EQUAL( huntingLookupScheme.findNearestLowerNeighbour(
+                               testValues[ i ], invalidLookUpCursor ),
+                           binarySearchLookupScheme.findNearestLowerNeighbour( testValues[ i ] ) );
+    }
+
+    // Create shared interpolator and compute reference values with separate interpolator.
+    const CubicSplineInterpolatorDouble sharedInterpolator(
+                independentVariableValues, dependentVariableValues, huntingAlgorithm );
+    CubicSplineInterpolatorDouble referenceInterpolator(
+                independentVariableValues, dependentVariableValues, binarySearch );
+    std::vector< double > targetValues;
+    std::vector< double > referenceValues;
+    for ( int i = 0; i < 2000; i++ )
+    {
+        targetValues.push_back( 1.24 * static_cast< double >( i ) );
+        referenceValues.push_back( referenceInterpolator.interpolate( targetValues.back( ) ) );
+    }
+
+    // Interpolate concurrently, with each thread starting at a different target value.
+    const unsigned int numberOfThreads = 4;
+    std::vector< std::vector< double > > interpolatedValues( numberOfThreads );
+    boost::thread_group threads;
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.create_thread( boost::bind( &interpolateWithLookUpCursor,
+                                            boost::cref( sharedInterpolator ),
+                                            boost::cref( targetValues ), 500 * i,
+                                            boost::ref( interpolatedValues[ i ] ) ) );
+    }
+    threads.join_all( );
+
+    // Check that all threads obtained the reference values. At nodes, the hunting algorithm
+    // may select the interval below the node, leading to differences at round-off level.
+    for ( unsigned int i = 0; i < numberOfThreads; i++ )
+    {
+        BOOST_REQUIRE_EQUAL( interpolatedValues[ i ].size( ), referenceValues.size( ) );
+        for ( unsigned int j = 0; j < referenceValues.size( ); j++ )
+        {
+            BOOST_CHECK_SMALL( interpolatedValues[ i ][ j ] - referenceValues[ j ], 1.0E-14 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
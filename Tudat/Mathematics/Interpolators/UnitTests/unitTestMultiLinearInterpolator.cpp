@@ -25,6 +25,8 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      122027    A. Ronse          File created.
+ *      140314    S. Vermeer        Added 5-dimensional and batch interpolation test.
+ *      140326    S. Vermeer        Added test of interpolation from shared data.
  *
  *    References
  *
@@ -35,7 +37,9 @@
 #define BOOST_TEST_MAIN
 
 #include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/multi_array.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <limits>
 #include <vector>
@@ -172,6 +176,186 @@ BOOST_AUTO_TEST_CASE( test4Dimensions )
                                 std::numeric_limits< double >::epsilon( ) );
 }
 
+// Test 3: 5-dimensional test, with data stored in column-major order, of function that is linear
+// in each independent variable, and is therefore reproduced exactly by multilinear
+// interpolation. Also tests batch interpolation.
+BOOST_AUTO_TEST_CASE( test5DimensionsAndBatchInterpolation )
+{
+    // Create non-uniform independent variable vectors with different number of points.
+    std::vector< std::vector< double > > independentValues( 5 );
+    for ( int i = 0; i < 5; i++ )
+    {
+        for ( int j = 0; j < 4 + i; j++ )
+        {
+            independentValues[ i ].push_back( -1.0 + static_cast< double >( j * j ) * 0.1
+                                              + static_cast< double >( i ) );
+        }
+    }
+
+    // Create five-dimensional array for dependent values based on analytical function
+    // f = ( 1 + x1 ) * ( 2 - x2 ) * ( 0.5 + x3 ) * ( 3 + x4 ) * ( 1 - 0.2 * x5 ), stored in
+    // column-major (Fortran) order.
+    boost::multi_array< double, 5 > dependentValues(
+                boost::extents[ 4 ][ 5 ][ 6 ][ 7 ][ 8 ], boost::fortran_storage_order( ) );
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int j = 0; j < 5; j++ )
+        {
+            for ( int k = 0; k < 6; k++ )
+            {
+                for ( int l = 0; l < 7; l++ )
+                {
+                    for ( int m = 0; m < 8; m++ )
+                    {
+                        dependentValues[ i ][ j ][ k ][ l ][ m ] =
+                                ( 1.0 + independentValues[ 0 ][ i ] )
+                                * ( 2.0 - independentValues[ 1 ][ j ] )
+                                * ( 0.5 + independentValues[ 2 ][ k ] )
+                                * ( 3.0 + independentValues[ 3 ][ l ] )
+                                * ( 1.0 - 0.2 * independentValues[ 4 ][ m ] );
+                    }
+                }
+            }
+        }
+    }
+
+    // Initialize interpolator.
+    const interpolators::MultiLinearInterpolator< double, double, 5 > fiveDimensionalInterpolator(
+            independentValues, dependentValues, interpolators::binarySearch );
+
+    // Set interpolation target points, including grid points.
+    std::vector< std::vector< double > > targetValues;
+    for ( int i = 0; i < 50; i++ )
+    {
+        std::vector< double > targetValue( 5 );
+        for ( int j = 0; j < 5; j++ )
+        {
+            targetValue[ j ] = independentValues[ j ][ ( i + j ) % ( 4 + j ) ]
+                    + ( i % 3 ) * 0.03 * static_cast< double >( j + 1 );
+        }
+        targetValues.push_back( targetValue );
+    }
+
+    // Perform batch interpolation.
+    std::vector< double > interpolationResults;
+    fiveDimensionalInterpolator.interpolate( targetValues, interpolationResults );
+    BOOST_REQUIRE_EQUAL( interpolationResults.size( ), targetValues.size( ) );
+
+    // Check results against single-point interpolation and analytical function.
+    interpolators::MultiLinearInterpolator< double, double, 5 >::LookUpCursorArray lookUpCursors;
+    for ( unsigned int i = 0; i < targetValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( interpolationResults[ i ],
+                           fiveDimensionalInterpolator.interpolate( targetValues[ i ],
+                                                                    lookUpCursors ) );
+
+        const double expectedResult = ( 1.0 + targetValues[ i ][ 0 ] )
+                * ( 2.0 - targetValues[ i ][ 1 ] )
+                * ( 0.5 + targetValues[ i ][ 2 ] )
+                * ( 3.0 + targetValues[ i ][ 3 ] )
+                * ( 1.0 - 0.2 * targetValues[ i ][ 4 ] );
+        BOOST_CHECK_SMALL( interpolationResults[ i ] - expectedResult, 1.0E-12 );
+    }
+}
+
+// Test interpolation from data shared between interpolators.
+BOOST_AUTO_TEST_CASE( testSharedData )
+{
+    using namespace interpolators;
+    typedef MultiLinearInterpolator< double, double, 3 > ThreeDimensionalInterpolator;
+
+    // Create independent variable vectors and dependent data based on analytical function
+    // f = ( 1 + x1 ) * ( 2 - x2 ) * ( 0.5 + x3 ).
+    std::vector< std::vector< double > > independentValues( 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        for ( int j = 0; j < 5 + i; j++ )
+        {
+            independentValues[ i ].push_back( static_cast< double >( j * ( i + 1 ) ) * 0.3 );
+        }
+    }
+
+    boost::multi_array< double, 3 > dependentValues( boost::extents[ 5 ][ 6 ][ 7 ] );
+    for ( int i = 0; i < 5; i++ )
+    {
+        for ( int j = 0; j < 6; j++ )
+        {
+            for ( int k = 0; k < 7; k++ )
+            {
+                dependentValues[ i ][ j ][ k ] = ( 1.0 + independentValues[ 0 ][ i ] )
+                        * ( 2.0 - independentValues[ 1 ][ j ] )
+                        * ( 0.5 + independentValues[ 2 ][ k ] );
+            }
+        }
+    }
+
+    // Create shared data.
+    std::vector< SharedImmutableVector< double > > sharedIndependentValues;
+    for ( int i = 0; i < 3; i++ )
+    {
+        sharedIndependentValues.push_back( independentValues[ i ] );
+    }
+    const boost::shared_ptr< const ThreeDimensionalInterpolator::DependentDataArray >
+            sharedDependentValues = boost::make_shared<
+            const ThreeDimensionalInterpolator::DependentDataArray >( dependentValues );
+
+    // Create interpolators from shared data, and from copied data.
+    const ThreeDimensionalInterpolator firstSharedInterpolator(
+                sharedIndependentValues, sharedDependentValues, huntingAlgorithm );
+    const ThreeDimensionalInterpolator secondSharedInterpolator(
+                firstSharedInterpolator.getIndependentValues( ),
+                firstSharedInterpolator.getDependentData( ), binarySearch );
+    const ThreeDimensionalInterpolator copyingInterpolator( independentValues, dependentValues );
+
+    // Check that data is shared by both interpolators and their look-up schemes, and not copied.
+    BOOST_CHECK( secondSharedInterpolator.getDependentData( ) == sharedDependentValues );
+    BOOST_CHECK_EQUAL( sharedDependentValues.use_count( ), 3 );
+    for ( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK( secondSharedInterpolator.getIndependentValues( )[ i ].getSharedPointer( )
+                     == sharedIndependentValues[ i ].getSharedPointer( ) );
+
+        // Values are referenced by this function, the returned pointer, both interpolators and
+        // both of their look-up schemes.
+        BOOST_CHECK_EQUAL( sharedIndependentValues[ i ].getSharedPointer( ).use_count( ), 6 );
+    }
+
+    // Create interpolator referencing dependent data owned by this function.
+    const ThreeDimensionalInterpolator nonOwningInterpolator(
+                sharedIndependentValues, createNonOwningSharedPointer( dependentValues ) );
+    BOOST_CHECK_EQUAL( nonOwningInterpolator.getDependentData( )->origin( ),
+                       dependentValues.origin( ) );
+
+    // Check that all interpolators give identical results, and that results are correct.
+    ThreeDimensionalInterpolator::LookUpCursorArray firstCursors, secondCursors, thirdCursors,
+            fourthCursors;
+    std::vector< double > targetValue( 3 );
+    for ( int i = 0; i < 40; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            targetValue[ j ] = std::fmod( 0.37 * static_cast< double >( i * ( j + 1 ) ),
+                                          independentValues[ j ].back( ) );
+        }
+
+        const double expectedValue = copyingInterpolator.interpolate( targetValue, firstCursors );
+        BOOST_CHECK_EQUAL( firstSharedInterpolator.interpolate( targetValue, secondCursors ),
+                           expectedValue );
+        BOOST_CHECK_EQUAL( secondSharedInterpolator.interpolate( targetValue, thirdCursors ),
+                           expectedValue );
+        BOOST_CHECK_EQUAL( nonOwningInterpolator.interpolate( targetValue, fourthCursors ),
+                           expectedValue );
+        BOOST_CHECK_SMALL( expectedValue - ( 1.0 + targetValue[ 0 ] ) * ( 2.0 - targetValue[ 1 ] )
+                           * ( 0.5 + targetValue[ 2 ] ), 1.0E-12 );
+    }
+
+    // Check that interpolator cannot be created from null pointer.
+    BOOST_CHECK_THROW( ThreeDimensionalInterpolator(
+                           sharedIndependentValues,
+                           boost::shared_ptr< const ThreeDimensionalInterpolator::
+                           DependentDataArray >( ) ), std::runtime_error );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -31,12 +31,23 @@
  *                                  Moved (con/de)structors and getter/setters to header.
  *      120716    D. Dirkx          Updated with interpolator architecture.
  *      130114    D. Dirkx          Fixed iterator bug.
+ *      140312    S. Vermeer        Added const interpolation with caller-owned look-up cursor.
+ *      140317    S. Vermeer        Added optional precomputed polynomial coefficients, derivative
+ *                                  evaluation and batch interpolation.
+ *      140326    S. Vermeer        Added construction from shared data.
+ *      140415    S. Vermeer        Added batch interpolation passing values to given writer.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
  *          University Press, February 2002.
  *
  *    Notes
+ *      Optionally, the spline is converted to piecewise-polynomial form at construction, storing
+ *      the coefficients of the cubic polynomial in ( x - x_i ) for each interval. An interpolation
+ *      then requires a single look-up and a Horner evaluation. The coefficients are stored in
+ *      separate vectors (one per power), such that the evaluation loop of the batch
+ *      interpolation, which is done separately from the look-ups, has no branches and can be
+ *      vectorized by the compiler.
  *
  */
 
@@ -45,9 +56,12 @@
 
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <vector>
 
 #include <Eigen/Core>
 
+#include <boost/array.hpp>
 #include <boost/exception/all.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -150,16 +164,21 @@ public:
     //! Cubic spline interpolator constructor.
     /*!
      * Cubic spline interpolator constructor taking separate vectors of dependent and independent
-     * variable values.
+     * variable values. The vectors can be provided as std::vector, which is copied once, or as
+     * shared pointer to an (immutable) std::vector, which is not copied.
      * \param independentVariables Vector with the independent variable values.
      * \param dependentVariables Vector with the dependent variable values.
      * \param selectedLookupScheme Look-up scheme that is to be used when finding interval
      * of requested independent variable value.
+     * \param precomputePolynomialCoefficients Boolean denoting whether the polynomial
+     * coefficients of each interval are to be computed at construction.
      */
-    CubicSplineInterpolator( std::vector< IndependentVariableType > independentVariables,
-                             std::vector< DependentVariableType > dependentVariables,
-                             AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
-
+    CubicSplineInterpolator(
+            const SharedImmutableVector< IndependentVariableType >& independentVariables,
+            const SharedImmutableVector< DependentVariableType >& dependentVariables,
+            AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const bool precomputePolynomialCoefficients = false )
+        : arePolynomialCoefficientsPrecomputed_( false )
     {
         // Verify that the initialization variables are not empty.
         if ( independentVariables.size( ) == 0 || dependentVariables.size( ) == 0 )
@@ -186,6 +205,12 @@ public:
 
         // Calculate second derivatives of curve.
         calculateSecondDerivatives( );
+
+        // Calculate polynomial coefficients, if requested.
+        if ( precomputePolynomialCoefficients )
+        {
+            calculatePolynomialCoefficients( );
+        }
     }
 
     //! Cubic spline interpolator constructor.
@@ -196,10 +221,14 @@ public:
      * dependent variable values as values.
      * \param selectedLookupScheme Lookup scheme that is to be used when finding interval
      * of requested independent variable value.
+     * \param precomputePolynomialCoefficients Boolean denoting whether the polynomial
+     * coefficients of each interval are to be computed at construction.
      */
     CubicSplineInterpolator(
             const std::map< IndependentVariableType, DependentVariableType > dataMap,
-            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const bool precomputePolynomialCoefficients = false )
+        : arePolynomialCoefficientsPrecomputed_( false )
     {
         // Verify that the initialization variables are not empty.
         if ( dataMap.size( ) == 0 )
@@ -209,16 +238,18 @@ public:
         }
 
         // Set data vector member variables from map.
-        independentValues_.resize( dataMap.size( ) );
-        dependentValues_.resize( dataMap.size( ) );
-        int counter = 0;
+        std::vector< IndependentVariableType > independentVariables;
+        std::vector< DependentVariableType > dependentVariables;
+        independentVariables.reserve( dataMap.size( ) );
+        dependentVariables.reserve( dataMap.size( ) );
         for ( typename std::map< IndependentVariableType, DependentVariableType >::const_iterator
               mapIterator = dataMap.begin( ); mapIterator != dataMap.end( ); mapIterator++ )
         {
-            independentValues_[ counter ] = mapIterator->first;
-            dependentValues_[ counter ] = mapIterator->second;
-            counter++;
+            independentVariables.push_back( mapIterator->first );
+            dependentVariables.push_back( mapIterator->second );
         }
+        independentValues_ = independentVariables;
+        dependentValues_ = dependentVariables;
 
         // Create lookup scheme.
         this->makeLookupScheme( selectedLookupScheme );
@@ -228,28 +259,49 @@ public:
 
         // Calculate second derivatives of curve.
         calculateSecondDerivatives( );
+
+        // Calculate polynomial coefficients, if requested.
+        if ( precomputePolynomialCoefficients )
+        {
+            calculatePolynomialCoefficients( );
+        }
     }
 
     // Statement required to prevent hiding of base class functions.
-    using Interpolator< IndependentVariableType, DependentVariableType, 1 >::interpolate;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    interpolate;
 
-    //! Interpolate.
+    //! Interpolate using caller-owned look-up cursor.
     /*!
      * Executes interpolation of data at a given target value of the independent variable, to
-     * yield an interpolated value of the dependent variable.
+     * yield an interpolated value of the dependent variable. This function does not modify the
+     * interpolator, and may be called concurrently from multiple threads with distinct cursors.
      * \param targetIndependentVariableValue Target independent variable value at which point
      * the interpolation is performed.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
      * \return Interpolated dependent variable value.
      */
     DependentVariableType interpolate(
-            const IndependentVariableType targetIndependentVariableValue )
+            const IndependentVariableType targetIndependentVariableValue,
+            LookUpCursor& lookUpCursor ) const
     {
         using std::pow;
 
         // Determine the lower entry in the table corresponding to the target independent variable
         // value.
         int lowerEntry_ = lookUpScheme_->findNearestLowerNeighbour(
-                    targetIndependentVariableValue );
+                    targetIndependentVariableValue, lookUpCursor );
+
+        // Evaluate polynomial of interval, if available.
+        if ( arePolynomialCoefficientsPrecomputed_ )
+        {
+            const IndependentVariableType offset =
+                    targetIndependentVariableValue - independentValues_[ lowerEntry_ ];
+            return constantCoefficients_[ lowerEntry_ ] + offset *
+                    ( linearCoefficients_[ lowerEntry_ ] + offset *
+                      ( quadraticCoefficients_[ lowerEntry_ ] + offset *
+                        cubicCoefficients_[ lowerEntry_ ] ) );
+        }
 
         // Get independent variable values bounding interval in which requested value lies.
         IndependentVariableType lowerValue, upperValue, squareDifference;
@@ -273,10 +325,269 @@ public:
                 coefficientD_ * secondDerivativeOfCurve_[ lowerEntry_ + 1 ];
     }
 
+    //! Interpolate first derivative.
+    /*!
+     * Executes interpolation of the first derivative of the spline w.r.t. the independent
+     * variable, using the look-up cursor owned by this object.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     * the interpolation is performed.
+     * \return Interpolated first derivative of dependent variable.
+     */
+    DependentVariableType interpolateFirstDerivative(
+            const IndependentVariableType targetIndependentVariableValue )
+    {
+        return interpolateFirstDerivative( targetIndependentVariableValue, this->lookUpCursor_ );
+    }
+
+    //! Interpolate first derivative using caller-owned look-up cursor.
+    /*!
+     * Executes interpolation of the first derivative of the spline w.r.t. the independent
+     * variable. This function does not modify the interpolator, and may be called concurrently
+     * from multiple threads with distinct cursors.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     * the interpolation is performed.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Interpolated first derivative of dependent variable.
+     */
+    DependentVariableType interpolateFirstDerivative(
+            const IndependentVariableType targetIndependentVariableValue,
+            LookUpCursor& lookUpCursor ) const
+    {
+        const int lowerEntry = lookUpScheme_->findNearestLowerNeighbour(
+                    targetIndependentVariableValue, lookUpCursor );
+
+        // Evaluate derivative of polynomial of interval, if available.
+        if ( arePolynomialCoefficientsPrecomputed_ )
+        {
+            const IndependentVariableType offset =
+                    targetIndependentVariableValue - independentValues_[ lowerEntry ];
+            return linearCoefficients_[ lowerEntry ] + offset *
+                    ( 2.0 * quadraticCoefficients_[ lowerEntry ] + offset *
+                      3.0 * cubicCoefficients_[ lowerEntry ] );
+        }
+
+        // Differentiate expression of (Press W.H., et al., 2002).
+        const IndependentVariableType intervalWidth =
+                independentValues_[ lowerEntry + 1 ] - independentValues_[ lowerEntry ];
+        const IndependentVariableType coefficientA =
+                ( independentValues_[ lowerEntry + 1 ] - targetIndependentVariableValue )
+                / intervalWidth;
+        const IndependentVariableType coefficientB = 1.0 - coefficientA;
+        return ( dependentValues_[ lowerEntry + 1 ] - dependentValues_[ lowerEntry ] )
+                / intervalWidth
+                - ( 3.0 * coefficientA * coefficientA - 1.0 ) / 6.0 * intervalWidth
+                * secondDerivativeOfCurve_[ lowerEntry ]
+                + ( 3.0 * coefficientB * coefficientB - 1.0 ) / 6.0 * intervalWidth
+                * secondDerivativeOfCurve_[ lowerEntry + 1 ];
+    }
+
+    //! Interpolate second derivative.
+    /*!
+     * Executes interpolation of the second derivative of the spline w.r.t. the independent
+     * variable, using the look-up cursor owned by this object.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     * the interpolation is performed.
+     * \return Interpolated second derivative of dependent variable.
+     */
+    DependentVariableType interpolateSecondDerivative(
+            const IndependentVariableType targetIndependentVariableValue )
+    {
+        return interpolateSecondDerivative( targetIndependentVariableValue, this->lookUpCursor_ );
+    }
+
+    //! Interpolate second derivative using caller-owned look-up cursor.
+    /*!
+     * Executes interpolation of the second derivative of the spline w.r.t. the independent
+     * variable, which is linear in each interval. This function does not modify the
+     * interpolator, and may be called concurrently from multiple threads with distinct cursors.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     * the interpolation is performed.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Interpolated second derivative of dependent variable.
+     */
+    DependentVariableType interpolateSecondDerivative(
+            const IndependentVariableType targetIndependentVariableValue,
+            LookUpCursor& lookUpCursor ) const
+    {
+        const int lowerEntry = lookUpScheme_->findNearestLowerNeighbour(
+                    targetIndependentVariableValue, lookUpCursor );
+
+        const IndependentVariableType coefficientA =
+                ( independentValues_[ lowerEntry + 1 ] - targetIndependentVariableValue )
+                / ( independentValues_[ lowerEntry + 1 ] - independentValues_[ lowerEntry ] );
+        return coefficientA * secondDerivativeOfCurve_[ lowerEntry ]
+                + ( 1.0 - coefficientA ) * secondDerivativeOfCurve_[ lowerEntry + 1 ];
+    }
+
+    //! Interpolate at multiple values of the independent variable.
+    /*!
+     * Executes interpolation at each of a number of target values of the independent variable.
+     * If the polynomial coefficients have been precomputed, the target values are processed in
+     * blocks, for each of which all look-ups are done first, after which the polynomials are
+     * evaluated in a loop without branches. The target values are best ordered, such that
+     * subsequent values are close together. This function does not modify the interpolator, and
+     * may be called concurrently from multiple threads.
+     * \param targetIndependentVariableValues Target independent variable values at which the
+     * interpolation is performed.
+     * \param interpolatedValues Interpolated dependent variable values, one per target value
+     * (returned by reference). No memory is allocated if the vector already has the correct
+     * size.
+     */
+    void interpolateBatch(
+            const std::vector< IndependentVariableType >& targetIndependentVariableValues,
+            std::vector< DependentVariableType >& interpolatedValues ) const
+    {
+        interpolatedValues.resize( targetIndependentVariableValues.size( ) );
+        interpolateBatchAndWrite( targetIndependentVariableValues,
+                                  VectorWriter( &interpolatedValues ) );
+    }
+
+    //! Interpolate at multiple values of the independent variable, passing values to writer.
+    /*!
+     * Executes interpolation at each of a number of target values of the independent variable,
+     * as interpolateBatch( ), and passes each interpolated value to the given writer, instead of
+     * storing it in a vector of dependent variable values. This allows, for instance, the
+     * components of vector-valued dependent variables to be written directly to separate
+     * (preallocated) vectors.
+     * \tparam ValueWriter Type of writer, which must provide an operator( )( const int index,
+     * const DependentVariableType& value ), called once for each target value, in order.
+     * \param targetIndependentVariableValues Target independent variable values at which the
+     * interpolation is performed.
+     * \param writeInterpolatedValue Writer of interpolated value with given index.
+     */
+    template< typename ValueWriter >
+    void interpolateBatchAndWrite(
+            const std::vector< IndependentVariableType >& targetIndependentVariableValues,
+            ValueWriter writeInterpolatedValue ) const
+    {
+        const int numberOfValues = static_cast< int >( targetIndependentVariableValues.size( ) );
+        LookUpCursor lookUpCursor;
+
+        // Interpolate values one by one if polynomial coefficients are not available.
+        if ( !arePolynomialCoefficientsPrecomputed_ )
+        {
+            for ( int i = 0; i < numberOfValues; i++ )
+            {
+                writeInterpolatedValue( i, interpolate( targetIndependentVariableValues[ i ],
+                                                        lookUpCursor ) );
+            }
+            return;
+        }
+
+        // Process target values in blocks.
+        boost::array< int, batchBlockSize > lowerEntries;
+        for ( int blockStart = 0; blockStart < numberOfValues; blockStart += batchBlockSize )
+        {
+            const int blockSize = ( numberOfValues - blockStart < batchBlockSize ) ?
+                        numberOfValues - blockStart : batchBlockSize;
+            const IndependentVariableType* targetValues =
+                    &targetIndependentVariableValues[ blockStart ];
+
+            // Perform look-ups for block.
+            for ( int i = 0; i < blockSize; i++ )
+            {
+                lowerEntries[ i ] = lookUpScheme_->findNearestLowerNeighbour( targetValues[ i ],
+                                                                             lookUpCursor );
+            }
+
+            // Evaluate polynomials for block.
+            for ( int i = 0; i < blockSize; i++ )
+            {
+                const int lowerEntry = lowerEntries[ i ];
+                const IndependentVariableType offset =
+                        targetValues[ i ] - independentValues_[ lowerEntry ];
+                writeInterpolatedValue(
+                            blockStart + i, constantCoefficients_[ lowerEntry ] + offset *
+                            ( linearCoefficients_[ lowerEntry ] + offset *
+                              ( quadraticCoefficients_[ lowerEntry ] + offset *
+                                cubicCoefficients_[ lowerEntry ] ) ) );
+            }
+        }
+    }
+
+    //! Check whether polynomial coefficients have been precomputed.
+    /*!
+     * Returns boolean denoting whether polynomial coefficients have been precomputed.
+     * \return True if polynomial coefficients have been precomputed.
+     */
+    bool arePolynomialCoefficientsPrecomputed( ) const
+    {
+        return arePolynomialCoefficientsPrecomputed_;
+    }
+
 protected:
 
 private:
 
+    //! Number of target values processed at once by batch interpolation.
+    static const int batchBlockSize = 256;
+
+    //! Writer of interpolated values to vector of dependent variable values.
+    /*!
+     * Writer of interpolated values to (correctly sized) vector of dependent variable values,
+     * used by interpolateBatch( ).
+     */
+    class VectorWriter
+    {
+    public:
+
+        //! Constructor.
+        /*!
+         * Constructor taking the vector to which the interpolated values are written.
+         * \param someInterpolatedValues Vector of interpolated values, of correct size.
+         */
+        explicit VectorWriter( std::vector< DependentVariableType >* someInterpolatedValues )
+            : interpolatedValues( someInterpolatedValues )
+        { }
+
+        //! Write interpolated value.
+        /*!
+         * Writes interpolated value to vector, at given index.
+         * \param index Index of interpolated value.
+         * \param value Interpolated value.
+         */
+        void operator( )( const int index, const DependentVariableType& value ) const
+        {
+            ( *interpolatedValues )[ index ] = value;
+        }
+
+    private:
+
+        //! Vector of interpolated values.
+        std::vector< DependentVariableType >* interpolatedValues;
+    };
+
+    //! Calculates the polynomial coefficients of each interval.
+    /*!
+     * This function calculates the coefficients of the cubic polynomial in ( x - x_i ) that is
+     * equivalent to the spline in interval i, from the dependent values and second derivatives
+     * at the nodes.
+     */
+    void calculatePolynomialCoefficients( )
+    {
+        const int numberOfIntervals = static_cast< int >( numberOfDataPoints_ ) - 1;
+        constantCoefficients_.resize( numberOfIntervals );
+        linearCoefficients_.resize( numberOfIntervals );
+        quadraticCoefficients_.resize( numberOfIntervals );
+        cubicCoefficients_.resize( numberOfIntervals );
+
+        for ( int i = 0; i < numberOfIntervals; i++ )
+        {
+            const IndependentVariableType intervalWidth =
+                    independentValues_[ i + 1 ] - independentValues_[ i ];
+            constantCoefficients_[ i ] = dependentValues_[ i ];
+            linearCoefficients_[ i ] = ( dependentValues_[ i + 1 ] - dependentValues_[ i ] )
+                    / intervalWidth - intervalWidth / 6.0
+                    * ( 2.0 * secondDerivativeOfCurve_[ i ] + secondDerivativeOfCurve_[ i + 1 ] );
+            quadraticCoefficients_[ i ] = 0.5 * secondDerivativeOfCurve_[ i ];
+            cubicCoefficients_[ i ] =
+                    ( secondDerivativeOfCurve_[ i + 1 ] - secondDerivativeOfCurve_[ i ] )
+                    / ( 6.0 * intervalWidth );
+        }
+
+        arePolynomialCoefficientsPrecomputed_ = true;
+    }
+
     //! Calculates the second derivatives of the curve.
     /*!
      * This function calculates the second derivatives of the curve at the nodes, assuming
@@ -371,6 +682,36 @@ private:
      *  Zero value of independent variable type, computed by subtracting a value from itself.
      */
     DependentVariableType zeroValue_;
+
+    //! Boolean denoting whether polynomial coefficients have been precomputed.
+    /*!
+     *  Boolean denoting whether polynomial coefficients have been precomputed.
+     */
+    bool arePolynomialCoefficientsPrecomputed_;
+
+    //! Constant coefficients of polynomials of each interval.
+    /*!
+     *  Constant coefficients of polynomials in ( x - x_i ) of each interval i.
+     */
+    std::vector< DependentVariableType > constantCoefficients_;
+
+    //! Linear coefficients of polynomials of each interval.
+    /*!
+     *  Linear coefficients of polynomials in ( x - x_i ) of each interval i.
+     */
+    std::vector< DependentVariableType > linearCoefficients_;
+
+    //! Quadratic coefficients of polynomials of each interval.
+    /*!
+     *  Quadratic coefficients of polynomials in ( x - x_i ) of each interval i.
+     */
+    std::vector< DependentVariableType > quadraticCoefficients_;
+
+    //! Cubic coefficients of polynomials of each interval.
+    /*!
+     *  Cubic coefficients of polynomials in ( x - x_i ) of each interval i.
+     */
+    std::vector< DependentVariableType > cubicCoefficients_;
 };
 
 //! Typedef for cubic spline interpolator with (in)dependent = double.
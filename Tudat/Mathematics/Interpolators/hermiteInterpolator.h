@@ -0,0 +1,387 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *      140326    S. Vermeer        Added construction from shared data.
+ *
+ *    References
+ *      Berrut, J.-P., Trefethen, L.N. Barycentric Lagrange Interpolation, SIAM Review, 46(3),
+ *          501-517, 2004.
+ *      Stoer, J., Bulirsch, R. Introduction to Numerical Analysis, 3rd edition. Springer, 2002.
+ *
+ *    Notes
+ *      The Hermite polynomial through n points, matching both the values y_j and derivatives
+ *      y'_j, is written in terms of the Lagrange basis polynomials l_j of these points (Stoer and
+ *      Bulirsch, 2002):
+ *
+ *          H( x ) = sum_j l_j( x )^2 [ y_j ( 1 - 2 s_j ( x - x_j ) ) + y'_j ( x - x_j ) ],
+ *
+ *      with s_j = l_j'( x_j ) = sum_{m != j} 1 / ( x_j - x_m ). The basis polynomials are
+ *      evaluated using the barycentric weights of the window, l_j( x ) = l( x ) w_j / ( x - x_j ),
+ *      with l( x ) = prod_j ( x - x_j ) (Berrut and Trefethen, 2004). Both the barycentric weights
+ *      and the sums s_j are computed for all windows at construction.
+ *
+ */
+
+#ifndef TUDAT_HERMITE_INTERPOLATOR_H
+#define TUDAT_HERMITE_INTERPOLATOR_H
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+#include "Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h"
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Hermite interpolator.
+/*!
+ * Hermite interpolator, which interpolates the data using the polynomial that matches both the
+ * values and the derivatives of a fixed number of data points surrounding the requested value
+ * (sliding window). For an even number of points n, the polynomial is of degree 2n - 1. For
+ * n = 2, this reduces to piecewise cubic Hermite interpolation. The data need not be equally
+ * spaced. A typical application is the interpolation of position, using velocity as derivative.
+ * \tparam IndependentVariableType Type of independent variables.
+ * \tparam DependentVariableType Type of dependent variables.
+ */
+template< typename IndependentVariableType, typename DependentVariableType >
+class HermiteInterpolator :
+        public OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >
+{
+public:
+
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    dependentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    independentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    lookUpScheme_;
+
+    //! Hermite interpolator constructor.
+    /*!
+     * Hermite interpolator constructor taking separate vectors of independent variable values,
+     * dependent variable values and derivatives of dependent variables. The vectors can be
+     * provided as std::vector, which is copied once, or as shared pointer to an (immutable)
+     * std::vector, which is not copied.
+     * \param independentVariables Vector with the independent variable values, in ascending
+     *          order.
+     * \param dependentVariables Vector with the dependent variable values.
+     * \param dependentVariableDerivatives Vector with the derivatives of the dependent variables
+     *          w.r.t. the independent variable.
+     * \param numberOfPoints Number of points in sliding window, must be even (default 4).
+     * \param selectedLookupScheme Look-up scheme that is to be used when finding interval
+     *          of requested independent variable value.
+     */
+    HermiteInterpolator(
+            const SharedImmutableVector< IndependentVariableType >& independentVariables,
+            const SharedImmutableVector< DependentVariableType >& dependentVariables,
+            const SharedImmutableVector< DependentVariableType >& dependentVariableDerivatives,
+            const int numberOfPoints = 4,
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+        : dependentDerivativeValues_( dependentVariableDerivatives ),
+          numberOfPoints_( numberOfPoints )
+    {
+        if ( independentVariables.size( ) != dependentVariables.size( ) ||
+             independentVariables.size( ) != dependentVariableDerivatives.size( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Independent variables, dependent variables and derivatives of "
+                                "Hermite interpolator are not of same size." ) ) );
+        }
+
+        independentValues_ = independentVariables;
+        dependentValues_ = dependentVariables;
+
+        checkSlidingWindowSettings( static_cast< int >( independentValues_.size( ) ),
+                                    numberOfPoints_ );
+
+        this->makeLookupScheme( selectedLookupScheme );
+
+        zeroValue_ = dependentValues_[ 0 ] - dependentValues_[ 0 ];
+        barycentricWeights_ = computeSlidingWindowBarycentricWeights(
+                    independentValues_.getVector( ), numberOfPoints_ );
+        computeBasisDerivativesAtNodes( );
+    }
+
+    // Statement required to prevent hiding of base class functions.
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    interpolate;
+
+    //! Interpolate using caller-owned look-up cursor.
+    /*!
+     * Executes interpolation of data at a given target value of the independent variable, to
+     * yield an interpolated value of the dependent variable. This function does not modify the
+     * interpolator, and may be called concurrently from multiple threads with distinct cursors.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Interpolated dependent variable value.
+     */
+    DependentVariableType interpolate(
+            const IndependentVariableType targetIndependentVariableValue,
+            LookUpCursor& lookUpCursor ) const
+    {
+        const int startIndex = findWindowStartIndex( targetIndependentVariableValue,
+                                                     lookUpCursor );
+        const IndependentVariableType* windowWeights =
+                &barycentricWeights_[ startIndex * numberOfPoints_ ];
+        const IndependentVariableType* windowBasisDerivatives =
+                &basisDerivativesAtNodes_[ startIndex * numberOfPoints_ ];
+
+        // Compute node polynomial l( x ), returning data point exactly if requested value
+        // coincides with it.
+        IndependentVariableType nodePolynomial = 1.0;
+        for ( int j = 0; j < numberOfPoints_; j++ )
+        {
+            const IndependentVariableType difference =
+                    targetIndependentVariableValue - independentValues_[ startIndex + j ];
+            if ( difference == 0.0 )
+            {
+                return dependentValues_[ startIndex + j ];
+            }
+            nodePolynomial *= difference;
+        }
+
+        // Sum contributions of all points in window.
+        DependentVariableType interpolatedValue = zeroValue_;
+        for ( int j = 0; j < numberOfPoints_; j++ )
+        {
+            const IndependentVariableType difference =
+                    targetIndependentVariableValue - independentValues_[ startIndex + j ];
+            const IndependentVariableType basisPolynomial =
+                    nodePolynomial * windowWeights[ j ] / difference;
+
+            interpolatedValue += ( basisPolynomial * basisPolynomial ) *
+                    ( ( 1.0 - 2.0 * windowBasisDerivatives[ j ] * difference )
+                      * dependentValues_[ startIndex + j ]
+                      + difference * dependentDerivativeValues_[ startIndex + j ] );
+        }
+
+        return interpolatedValue;
+    }
+
+    //! Interpolate first derivative.
+    /*!
+     * Executes interpolation of the first derivative of the Hermite polynomial w.r.t. the
+     * independent variable, using the look-up cursor owned by this object.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \return Interpolated first derivative of dependent variable.
+     */
+    DependentVariableType interpolateFirstDerivative(
+            const IndependentVariableType targetIndependentVariableValue )
+    {
+        return interpolateFirstDerivative( targetIndependentVariableValue, this->lookUpCursor_ );
+    }
+
+    //! Interpolate first derivative using caller-owned look-up cursor.
+    /*!
+     * Executes interpolation of the first derivative of the Hermite polynomial w.r.t. the
+     * independent variable. This function does not modify the interpolator.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Interpolated first derivative of dependent variable.
+     */
+    DependentVariableType interpolateFirstDerivative(
+            const IndependentVariableType targetIndependentVariableValue,
+            LookUpCursor& lookUpCursor ) const
+    {
+        const int startIndex = findWindowStartIndex( targetIndependentVariableValue,
+                                                     lookUpCursor );
+        const IndependentVariableType* windowWeights =
+                &barycentricWeights_[ startIndex * numberOfPoints_ ];
+        const IndependentVariableType* windowBasisDerivatives =
+                &basisDerivativesAtNodes_[ startIndex * numberOfPoints_ ];
+
+        // Compute node polynomial l( x ), returning derivative at data point exactly if requested
+        // value coincides with it.
+        IndependentVariableType nodePolynomial = 1.0;
+        for ( int j = 0; j < numberOfPoints_; j++ )
+        {
+            const IndependentVariableType difference =
+                    targetIndependentVariableValue - independentValues_[ startIndex + j ];
+            if ( difference == 0.0 )
+            {
+                return dependentDerivativeValues_[ startIndex + j ];
+            }
+            nodePolynomial *= difference;
+        }
+
+        // Sum contributions of all points in window. The derivative of the basis polynomial is
+        // computed as l_j'( x ) = l_j( x ) sum_{m != j} 1 / ( x - x_m ), which avoids
+        // cancellation close to the data points.
+        DependentVariableType interpolatedDerivative = zeroValue_;
+        for ( int j = 0; j < numberOfPoints_; j++ )
+        {
+            const IndependentVariableType difference =
+                    targetIndependentVariableValue - independentValues_[ startIndex + j ];
+            const IndependentVariableType basisPolynomial =
+                    nodePolynomial * windowWeights[ j ] / difference;
+
+            IndependentVariableType sumOfInverseDifferences = 0.0;
+            for ( int m = 0; m < numberOfPoints_; m++ )
+            {
+                if ( m != j )
+                {
+                    sumOfInverseDifferences += 1.0 / ( targetIndependentVariableValue
+                                                       - independentValues_[ startIndex + m ] );
+                }
+            }
+            const IndependentVariableType basisPolynomialDerivative =
+                    basisPolynomial * sumOfInverseDifferences;
+
+            interpolatedDerivative +=
+                    ( 2.0 * basisPolynomial * basisPolynomialDerivative ) *
+                    ( ( 1.0 - 2.0 * windowBasisDerivatives[ j ] * difference )
+                      * dependentValues_[ startIndex + j ]
+                      + difference * dependentDerivativeValues_[ startIndex + j ] )
+                    + ( basisPolynomial * basisPolynomial ) *
+                    ( dependentDerivativeValues_[ startIndex + j ]
+                      - 2.0 * windowBasisDerivatives[ j ] * dependentValues_[ startIndex + j ] );
+        }
+
+        return interpolatedDerivative;
+    }
+
+    //! Get derivatives of dependent variables.
+    /*!
+     * Returns vector of derivatives of dependent variables w.r.t. the independent variable.
+     * \return Vector of derivatives of dependent variables.
+     */
+    const std::vector< DependentVariableType >& getDependentDerivativeValues( ) const
+    {
+        return dependentDerivativeValues_.getVector( );
+    }
+
+    //! Get number of points in sliding window.
+    /*!
+     * Returns number of points in sliding window.
+     * \return Number of points in sliding window.
+     */
+    int getNumberOfPoints( ) const { return numberOfPoints_; }
+
+protected:
+
+private:
+
+    //! Find start index of sliding window.
+    /*!
+     * Finds the index of the first data point of the sliding window that is used to interpolate
+     * at the given independent variable value.
+     * \param targetIndependentVariableValue Target independent variable value.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Index of first data point of sliding window.
+     */
+    int findWindowStartIndex( const IndependentVariableType targetIndependentVariableValue,
+                              LookUpCursor& lookUpCursor ) const
+    {
+        return getSlidingWindowStartIndex(
+                    lookUpScheme_->findNearestLowerNeighbour(
+                        targetIndependentVariableValue, lookUpCursor ),
+                    static_cast< int >( independentValues_.size( ) ), numberOfPoints_ );
+    }
+
+    //! Compute derivatives of Lagrange basis polynomials at data points.
+    /*!
+     * Computes the derivatives s_j = sum_{m != j} 1 / ( x_j - x_m ) of the Lagrange basis
+     * polynomials at their own data points, for all sliding windows.
+     */
+    void computeBasisDerivativesAtNodes( )
+    {
+        const int numberOfWindows = static_cast< int >( independentValues_.size( ) )
+                - numberOfPoints_ + 1;
+        basisDerivativesAtNodes_.resize( numberOfWindows * numberOfPoints_ );
+
+        for ( int i = 0; i < numberOfWindows; i++ )
+        {
+            for ( int j = 0; j < numberOfPoints_; j++ )
+            {
+                IndependentVariableType sumOfInverseDifferences = 0.0;
+                for ( int m = 0; m < numberOfPoints_; m++ )
+                {
+                    if ( m != j )
+                    {
+                        sumOfInverseDifferences += 1.0 / ( independentValues_[ i + j ]
+                                                           - independentValues_[ i + m ] );
+                    }
+                }
+                basisDerivativesAtNodes_[ i * numberOfPoints_ + j ] = sumOfInverseDifferences;
+            }
+        }
+    }
+
+    //! Vector with derivatives of dependent variables.
+    /*!
+     * Vector with derivatives of dependent variables w.r.t. the independent variable.
+     */
+    SharedImmutableVector< DependentVariableType > dependentDerivativeValues_;
+
+    //! Number of points in sliding window.
+    /*!
+     * Number of points in sliding window.
+     */
+    int numberOfPoints_;
+
+    //! Barycentric weights of all sliding windows.
+    /*!
+     * Barycentric weights of all sliding windows, where the weight of point j of the window
+     * starting at data point i is stored at index i * numberOfPoints_ + j.
+     */
+    std::vector< IndependentVariableType > barycentricWeights_;
+
+    //! Derivatives of Lagrange basis polynomials at data points for all sliding windows.
+    /*!
+     * Derivatives of Lagrange basis polynomials at their own data points for all sliding
+     * windows, stored in the same way as the barycentric weights.
+     */
+    std::vector< IndependentVariableType > basisDerivativesAtNodes_;
+
+    //! Zero value of dependent variable.
+    /*!
+     * Zero value of dependent variable, used to initialize sums.
+     */
+    DependentVariableType zeroValue_;
+};
+
+//! Typedef for Hermite interpolator with double (in)dependent variables.
+typedef HermiteInterpolator< double, double > HermiteInterpolatorDouble;
+
+//! Typedef for shared-pointer to Hermite interpolator with double (in)dependent variables.
+typedef boost::shared_ptr< HermiteInterpolatorDouble > HermiteInterpolatorDoublePointer;
+
+} // namespace interpolators
+} // namespace tudat
+
+#endif // TUDAT_HERMITE_INTERPOLATOR_H
@@ -0,0 +1,346 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140324    S. Vermeer        File created.
+ *      140326    S. Vermeer        Added construction from shared data.
+ *
+ *    References
+ *      Berrut, J.-P., Trefethen, L.N. Barycentric Lagrange Interpolation, SIAM Review, 46(3),
+ *          501-517, 2004.
+ *
+ *    Notes
+ *      The interpolating polynomial is evaluated in the first (modified Lagrange) form of the
+ *      barycentric formula (Berrut and Trefethen, 2004). The barycentric weights only depend on
+ *      the independent variable values of the window, and are computed for all windows at
+ *      construction, so that an interpolation requires a single look-up and a loop over the
+ *      points in the window.
+ *
+ */
+
+#ifndef TUDAT_LAGRANGE_INTERPOLATOR_H
+#define TUDAT_LAGRANGE_INTERPOLATOR_H
+
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h"
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Check settings of sliding-window interpolation.
+/*!
+ * Checks whether the number of points of a sliding-window interpolation is even and at least 2,
+ * and whether the number of data points is at least the number of points in the window. An
+ * exception is thrown if this is not the case.
+ * \param numberOfDataPoints Number of data points.
+ * \param numberOfPoints Number of points in sliding window.
+ */
+inline void checkSlidingWindowSettings( const int numberOfDataPoints, const int numberOfPoints )
+{
+    if ( numberOfPoints < 2 || numberOfPoints % 2 != 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Number of points of sliding-window interpolator must be even and at "
+                            "least 2." ) ) );
+    }
+
+    if ( numberOfDataPoints < numberOfPoints )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Number of data points of sliding-window interpolator is smaller "
+                            "than number of points in window." ) ) );
+    }
+}
+
+//! Get start index of sliding window.
+/*!
+ * Returns the index of the first data point of the sliding window that is used to interpolate in
+ * the interval starting at the given data point. The window is centered on the interval, and
+ * shifted inwards near the ends of the data.
+ * \param lowerEntry Index of data point at start of interval.
+ * \param numberOfDataPoints Number of data points.
+ * \param numberOfPoints Number of points in sliding window.
+ * \return Index of first data point of sliding window.
+ */
+inline int getSlidingWindowStartIndex( const int lowerEntry, const int numberOfDataPoints,
+                                       const int numberOfPoints )
+{
+    const int startIndex = lowerEntry - numberOfPoints / 2 + 1;
+    if ( startIndex < 0 )
+    {
+        return 0;
+    }
+    else if ( startIndex > numberOfDataPoints - numberOfPoints )
+    {
+        return numberOfDataPoints - numberOfPoints;
+    }
+    return startIndex;
+}
+
+//! Compute barycentric weights of all sliding windows.
+/*!
+ * Computes the barycentric weights w_j = 1 / prod_{m != j} ( x_j - x_m ) of the points of all
+ * sliding windows (Berrut and Trefethen, 2004).
+ * \tparam IndependentVariableType Type of independent variables.
+ * \param independentValues Independent variable values.
+ * \param numberOfPoints Number of points in sliding window.
+ * \return Barycentric weights, where the weight of point j of the window starting at data point
+ *          i is stored at index i * numberOfPoints + j.
+ */
+template< typename IndependentVariableType >
+std::vector< IndependentVariableType > computeSlidingWindowBarycentricWeights(
+        const std::vector< IndependentVariableType >& independentValues,
+        const int numberOfPoints )
+{
+    const int numberOfWindows = static_cast< int >( independentValues.size( ) )
+            - numberOfPoints + 1;
+    std::vector< IndependentVariableType > barycentricWeights(
+                numberOfWindows * numberOfPoints );
+
+    for ( int i = 0; i < numberOfWindows; i++ )
+    {
+        for ( int j = 0; j < numberOfPoints; j++ )
+        {
+            IndependentVariableType productOfDifferences = 1.0;
+            for ( int m = 0; m < numberOfPoints; m++ )
+            {
+                if ( m != j )
+                {
+                    productOfDifferences *= independentValues[ i + j ]
+                            - independentValues[ i + m ];
+                }
+            }
+            barycentricWeights[ i * numberOfPoints + j ] = 1.0 / productOfDifferences;
+        }
+    }
+
+    return barycentricWeights;
+}
+
+//! Lagrange interpolator.
+/*!
+ * Lagrange interpolator, which interpolates the data using the polynomial through a fixed number
+ * of data points surrounding the requested value (sliding window). For an even number of points
+ * n, the polynomial is of degree n - 1 and is determined by the n / 2 data points on either side
+ * of the interval in which the requested value lies (fewer on one side near the ends of the
+ * data). The data need not be equally spaced.
+ * \tparam IndependentVariableType Type of independent variables.
+ * \tparam DependentVariableType Type of dependent variables.
+ */
+template< typename IndependentVariableType, typename DependentVariableType >
+class LagrangeInterpolator :
+        public OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >
+{
+public:
+
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    dependentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    independentValues_;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    lookUpScheme_;
+
+    //! Lagrange interpolator constructor.
+    /*!
+     * Lagrange interpolator constructor taking separate vectors of dependent and independent
+     * variable values. The vectors can be provided as std::vector, which is copied once, or as
+     * shared pointer to an (immutable) std::vector, which is not copied.
+     * \param independentVariables Vector with the independent variable values, in ascending
+     *          order.
+     * \param dependentVariables Vector with the dependent variable values.
+     * \param numberOfPoints Number of points in sliding window, must be even (default 8).
+     * \param selectedLookupScheme Look-up scheme that is to be used when finding interval
+     *          of requested independent variable value.
+     */
+    LagrangeInterpolator(
+            const SharedImmutableVector< IndependentVariableType >& independentVariables,
+            const SharedImmutableVector< DependentVariableType >& dependentVariables,
+            const int numberOfPoints = 8,
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+        : numberOfPoints_( numberOfPoints )
+    {
+        if ( independentVariables.size( ) != dependentVariables.size( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Independent and dependent variables of Lagrange interpolator "
+                                "are not of same size." ) ) );
+        }
+
+        independentValues_ = independentVariables;
+        dependentValues_ = dependentVariables;
+
+        initializeInterpolator( selectedLookupScheme );
+    }
+
+    //! Lagrange interpolator constructor.
+    /*!
+     * Lagrange interpolator constructor taking single map of independent and dependent variable
+     * values.
+     * \param dataMap Map with the independent variable values as keys and corresponding
+     *          dependent variable values as values.
+     * \param numberOfPoints Number of points in sliding window, must be even (default 8).
+     * \param selectedLookupScheme Look-up scheme that is to be used when finding interval
+     *          of requested independent variable value.
+     */
+    LagrangeInterpolator( const std::map< IndependentVariableType, DependentVariableType >& dataMap,
+                          const int numberOfPoints = 8,
+                          const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+        : numberOfPoints_( numberOfPoints )
+    {
+        std::vector< IndependentVariableType > independentVariables;
+        std::vector< DependentVariableType > dependentVariables;
+        independentVariables.reserve( dataMap.size( ) );
+        dependentVariables.reserve( dataMap.size( ) );
+        for ( typename std::map< IndependentVariableType, DependentVariableType >::const_iterator
+              mapIterator = dataMap.begin( ); mapIterator != dataMap.end( ); mapIterator++ )
+        {
+            independentVariables.push_back( mapIterator->first );
+            dependentVariables.push_back( mapIterator->second );
+        }
+        independentValues_ = independentVariables;
+        dependentValues_ = dependentVariables;
+
+        initializeInterpolator( selectedLookupScheme );
+    }
+
+    // Statement required to prevent hiding of base class functions.
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    interpolate;
+
+    //! Interpolate using caller-owned look-up cursor.
+    /*!
+     * Executes interpolation of data at a given target value of the independent variable, to
+     * yield an interpolated value of the dependent variable. This function does not modify the
+     * interpolator, and may be called concurrently from multiple threads with distinct cursors.
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     *          the interpolation is performed.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Interpolated dependent variable value.
+     */
+    DependentVariableType interpolate(
+            const IndependentVariableType targetIndependentVariableValue,
+            LookUpCursor& lookUpCursor ) const
+    {
+        const int startIndex = getSlidingWindowStartIndex(
+                    lookUpScheme_->findNearestLowerNeighbour(
+                        targetIndependentVariableValue, lookUpCursor ),
+                    static_cast< int >( independentValues_.size( ) ), numberOfPoints_ );
+        const IndependentVariableType* windowWeights =
+                &barycentricWeights_[ startIndex * numberOfPoints_ ];
+
+        // Evaluate l( x ) * sum_j w_j / ( x - x_j ) * y_j, with l( x ) = prod_j ( x - x_j ).
+        IndependentVariableType nodePolynomial = 1.0;
+        DependentVariableType weightedSum = zeroValue_;
+        for ( int j = 0; j < numberOfPoints_; j++ )
+        {
+            const IndependentVariableType difference =
+                    targetIndependentVariableValue - independentValues_[ startIndex + j ];
+
+            // Return data point exactly if requested value coincides with it.
+            if ( difference == 0.0 )
+            {
+                return dependentValues_[ startIndex + j ];
+            }
+
+            weightedSum += ( windowWeights[ j ] / difference ) * dependentValues_[ startIndex + j ];
+            nodePolynomial *= difference;
+        }
+
+        return nodePolynomial * weightedSum;
+    }
+
+    //! Get number of points in sliding window.
+    /*!
+     * Returns number of points in sliding window.
+     * \return Number of points in sliding window.
+     */
+    int getNumberOfPoints( ) const { return numberOfPoints_; }
+
+protected:
+
+private:
+
+    //! Initialize interpolator.
+    /*!
+     * Checks the data, creates the look-up scheme and computes the barycentric weights of all
+     * sliding windows.
+     * \param selectedLookupScheme Look-up scheme that is to be used.
+     */
+    void initializeInterpolator( const AvailableLookupScheme selectedLookupScheme )
+    {
+        checkSlidingWindowSettings( static_cast< int >( independentValues_.size( ) ),
+                                    numberOfPoints_ );
+
+        this->makeLookupScheme( selectedLookupScheme );
+
+        zeroValue_ = dependentValues_[ 0 ] - dependentValues_[ 0 ];
+        barycentricWeights_ = computeSlidingWindowBarycentricWeights(
+                    independentValues_.getVector( ), numberOfPoints_ );
+    }
+
+    //! Number of points in sliding window.
+    /*!
+     * Number of points in sliding window.
+     */
+    int numberOfPoints_;
+
+    //! Barycentric weights of all sliding windows.
+    /*!
+     * Barycentric weights of all sliding windows, where the weight of point j of the window
+     * starting at data point i is stored at index i * numberOfPoints_ + j.
+     */
+    std::vector< IndependentVariableType > barycentricWeights_;
+
+    //! Zero value of dependent variable.
+    /*!
+     * Zero value of dependent variable, used to initialize sums.
+     */
+    DependentVariableType zeroValue_;
+};
+
+//! Typedef for Lagrange interpolator with double (in)dependent variables.
+typedef LagrangeInterpolator< double, double > LagrangeInterpolatorDouble;
+
+//! Typedef for shared-pointer to Lagrange interpolator with double (in)dependent variables.
+typedef boost::shared_ptr< LagrangeInterpolatorDouble > LagrangeInterpolatorDoublePointer;
+
+} // namespace interpolators
+} // namespace tudat
+
+#endif // TUDAT_LAGRANGE_INTERPOLATOR_H
@@ -45,6 +45,8 @@
  *      120627    T. Secretin       Removed obsolete function using State objects.
  *      120716    D. Dirkx          Updated with interpolator architecture.
  *      130114    D. Dirkx          Fixed iterator bug.
+ *      140312    S. Vermeer        Added const interpolation with caller-owned look-up cursor.
+ *      140326    S. Vermeer        Added construction from shared data.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing, Cambridge
@@ -95,7 +97,8 @@ public:
     independentValues_;
     using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
     lookUpScheme_;
-    using Interpolator< IndependentVariableType, DependentVariableType, 1 >::interpolate;
+    using OneDimensionalInterpolator< IndependentVariableType, DependentVariableType >::
+    interpolate;
 
     //! Constructor from map of independent/dependent data.
     /*!
@@ -118,20 +121,22 @@ public:
                     "The vectors used in the linear interpolator initialization are empty." ) ) );
         }
 
-        // Resize data vectors of independent/dependent values.
-        independentValues_.resize( dataMap.size( ) );
-        dependentValues_.resize( dataMap.size( ) );
-
         // Fill data vectors with data from map.
-        int counter = 0;
+        std::vector< IndependentVariableType > independentValues;
+        std::vector< DependentVariableType > dependentValues;
+        independentValues.reserve( dataMap.size( ) );
+        dependentValues.reserve( dataMap.size( ) );
         for ( typename std::map< IndependentVariableType, DependentVariableType >::const_iterator
               mapIterator = dataMap.begin( ); mapIterator != dataMap.end( ); mapIterator++ )
         {
-            independentValues_[ counter ] = mapIterator->first;
-            dependentValues_[ counter ] = mapIterator->second;
-            counter++;
+            independentValues.push_back( mapIterator->first );
+            dependentValues.push_back( mapIterator->second );
         }
 
+        // Set data vectors.
+        independentValues_ = independentValues;
+        dependentValues_ = dependentValues;
+
         // Create lookup scheme from independent variable data points.
         this->makeLookupScheme( selectedLookupScheme );
     }
@@ -140,15 +145,16 @@ public:
     /*!
      *  This constructor initializes the interpolator from two vectors containing the independent
      *  variables and dependent variables. A look-up scheme can be provided to
-     *  override the given default.
+     *  override the given default. The vectors can be provided as std::vector, which is copied
+     *  once, or as shared pointer to an (immutable) std::vector, which is not copied.
      *  \param independentValues Vector of values of independent variables that are used.
      *  \param dependentValues Vector of values of dependent variables that are used.
      *  \param selectedLookupScheme Identifier of lookupscheme from enum. This algorithm is used
      *  to find the nearest lower data point in the independent variables when requesting
      *  interpolation.
      */
-    LinearInterpolator( const std::vector< IndependentVariableType > independentValues,
-                        const std::vector< DependentVariableType > dependentValues,
+    LinearInterpolator( const SharedImmutableVector< IndependentVariableType >& independentValues,
+                        const SharedImmutableVector< DependentVariableType >& dependentValues,
                         const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
     {
         // Verify that the initialization variables are not empty.
@@ -168,16 +174,20 @@ public:
 
     //! Function interpolates dependent variable value at given independent variable value.
     /*!
-     * Function interpolates dependent variable value at given independent variable value.
+     * Function interpolates dependent variable value at given independent variable value, using
+     * a caller-owned look-up cursor. This function does not modify the interpolator, and may be
+     * called concurrently from multiple threads with distinct cursors.
      * \param independentVariableValue Value of independent variable at which interpolation
      *          is to take place.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
      * \return Interpolated value of dependent variable.
      */
-    DependentVariableType interpolate( const IndependentVariableType independentVariableValue )
+    DependentVariableType interpolate( const IndependentVariableType independentVariableValue,
+                                       LookUpCursor& lookUpCursor ) const
     {
         // Lookup nearest lower index.
         int newNearestLowerIndex = lookUpScheme_->findNearestLowerNeighbour(
-                    independentVariableValue );
+                    independentVariableValue, lookUpCursor );
 
         // Perform linear interpolation.
         DependentVariableType interpolatedValue = dependentValues_[ newNearestLowerIndex ] +
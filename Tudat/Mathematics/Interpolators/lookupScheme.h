@@ -26,21 +26,43 @@
  *      YYMMDD    Author            Comment
  *      120716    D. Dirkx          File created.
  *      130121    K. Kumar          Added shared-ptr typedefs.
+ *      140310    S. Vermeer        Added uniform and piecewise-uniform grid look-up schemes.
+ *      140312    S. Vermeer        Added caller-owned look-up cursors, made look-ups const.
+ *      140326    S. Vermeer        Stored independent variable values in shared immutable vector.
  *
  *    References
  *
  *    Notes
+ *      The uniform grid look-up schemes compute the interval index arithmetically from the grid
+ *      spacing, after which a single comparison with the neighbouring nodes is done. This
+ *      correction ensures that the returned index is identical to that of the binary search
+ *      when the target value coincides with a node that is not exactly representable as
+ *      x0 + i * h.
+ *      The state of a sequence of look-ups (used as initial guess by the hunting algorithm) is
+ *      stored in a LookUpCursor. Look-ups that take a cursor as argument do not modify the look-up
+ *      scheme, so that a single scheme can be shared between threads, provided that each thread
+ *      uses its own cursor. Look-ups without a cursor use a cursor owned by the scheme, and
+ *      are therefore not thread-safe.
+ *      The independent variable values are stored in a shared immutable vector, so that look-up
+ *      schemes created by an interpolator do not copy the values stored by the interpolator.
  *
  */
 
 #ifndef TUDAT_LOOK_UP_SCHEME_H
 #define TUDAT_LOOK_UP_SCHEME_H
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <vector>
 
+#include <boost/exception/all.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <TudatCore/Basics/utilityMacros.h>
+
 #include "Tudat/Mathematics/BasicMathematics/nearestNeighbourSearch.h"
+#include "Tudat/Mathematics/Interpolators/sharedImmutableVector.h"
 
 namespace tudat
 {
@@ -54,7 +76,87 @@ namespace interpolators
 enum AvailableLookupScheme
 {
     huntingAlgorithm,
-    binarySearch
+    binarySearch,
+    uniformGrid,
+    piecewiseUniformGrid
+};
+
+//! Default relative tolerance for detection of uniformly spaced independent variable values.
+const double defaultUniformGridTolerance = 1.0E-8;
+
+//! Check whether independent variable values are uniformly spaced.
+/*!
+ * Checks whether the independent variable values are sorted in ascending order and uniformly
+ * spaced, i.e., whether each entry deviates from x0 + i * h by no more than the relative
+ * tolerance times h, where h is the mean spacing.
+ * \tparam IndependentVariableType Type of entries of vector that is to be checked.
+ * \param independentVariableValues Vector of independent variable values.
+ * \param relativeTolerance Tolerance on deviation from uniform grid, relative to spacing.
+ * \return True if values are uniformly spaced, false otherwise.
+ */
+template< typename IndependentVariableType >
+bool isGridUniform( const std::vector< IndependentVariableType >& independentVariableValues,
+                    const double relativeTolerance = defaultUniformGridTolerance )
+{
+    // A grid requires at least two values, which must be ascending.
+    const int numberOfValues = static_cast< int >( independentVariableValues.size( ) );
+    if ( numberOfValues < 2 ||
+         !( independentVariableValues.back( ) > independentVariableValues.front( ) ) )
+    {
+        return false;
+    }
+
+    // Compute mean spacing and compare each entry to its uniform grid counterpart.
+    const IndependentVariableType spacing =
+            ( independentVariableValues.back( ) - independentVariableValues.front( ) )
+            / static_cast< IndependentVariableType >( numberOfValues - 1 );
+    for ( int i = 1; i < numberOfValues - 1; i++ )
+    {
+        if ( std::fabs( independentVariableValues[ i ] - independentVariableValues.front( )
+                        - static_cast< IndependentVariableType >( i ) * spacing )
+             > relativeTolerance * spacing )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! Caller-owned state of a sequence of look-ups.
+/*!
+ * Caller-owned state of a sequence of look-ups, storing the result of the previous look-up. This
+ * result is used as initial guess by the hunting algorithm, and ignored by the other look-up
+ * schemes. A cursor may be used with different look-up schemes, but is most effective when used
+ * for a single scheme, or for schemes that share the same independent variable values.
+ */
+struct LookUpCursor
+{
+    //! Constructor.
+    /*!
+     * Constructor, initializing the cursor such that the next look-up is done without initial
+     * guess.
+     */
+    LookUpCursor( )
+        : isFirstLookupDone( false ),
+          previousNearestLowerIndex( 0 )
+    { }
+
+    //! Reset cursor.
+    /*!
+     * Resets the cursor, such that the next look-up is done without initial guess.
+     */
+    void reset( )
+    {
+        isFirstLookupDone = false;
+        previousNearestLowerIndex = 0;
+    }
+
+    //! Boolean to denote whether a lookup has been done with this cursor.
+    bool isFirstLookupDone;
+
+    //! Nearest left index found during previous look-up with this cursor.
+    int previousNearestLowerIndex;
 };
 
 //! Look-up scheme class for nearest left neighbour search.
@@ -70,11 +172,13 @@ public:
 
     //! Constructor, used to set data vector.
     /*!
-     * Constructor, used to set data vector.
+     * Constructor, used to set data vector. The data vector is shared with (not copied from) the
+     * object providing it.
      * \param independentVariableValues vector of independent variable values in which to perform
      * lookup procedure.
      */
-    LookUpScheme( const std::vector< IndependentVariableType >independentVariableValues )
+    LookUpScheme(
+            const SharedImmutableVector< IndependentVariableType >& independentVariableValues )
         : independentVariableValues_( independentVariableValues )
     { }
 
@@ -86,12 +190,51 @@ public:
 
     //! Find nearest left neighbour.
     /*!
-     * Function finds nearest left neighbour of given value in independentVariableValues_.
+     * Function finds nearest left neighbour of given value in independentVariableValues_, using
+     * the cursor owned by this object. This function is not thread-safe.
      * \param valueToLookup Value of which nearest neaighbour is to be determined.
      * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
      * to valueToLookup.
      */
-    virtual int findNearestLowerNeighbour( const IndependentVariableType valueToLookup ) = 0;
+    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup )
+    {
+        return findNearestLowerNeighbour( valueToLookup, lookUpCursor_ );
+    }
+
+    //! Find nearest left neighbour using caller-owned cursor.
+    /*!
+     * Function finds nearest left neighbour of given value in independentVariableValues_, using
+     * and updating the state stored in the given cursor. This function does not modify the
+     * look-up scheme, and may be called concurrently from multiple threads with distinct cursors.
+     * \param valueToLookup Value of which nearest neaighbour is to be determined.
+     * \param cursor State of previous look-ups, updated by this function.
+     * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
+     * to valueToLookup.
+     */
+    virtual int findNearestLowerNeighbour( const IndependentVariableType valueToLookup,
+                                           LookUpCursor& cursor ) const = 0;
+
+    //! Get independent variable values.
+    /*!
+     * Returns vector of independent variable values in which lookup is performed.
+     * \return Vector of independent variable values.
+     */
+    const std::vector< IndependentVariableType >& getIndependentVariableValues( ) const
+    {
+        return independentVariableValues_.getVector( );
+    }
+
+    //! Get shared independent variable values.
+    /*!
+     * Returns shared vector of independent variable values in which lookup is performed, which
+     * can be used to create other objects using the same values without copying them.
+     * \return Shared vector of independent variable values.
+     */
+    const SharedImmutableVector< IndependentVariableType >&
+    getSharedIndependentVariableValues( ) const
+    {
+        return independentVariableValues_;
+    }
 
 protected:
 
@@ -99,7 +242,15 @@ protected:
     /*!
      * Vector of independent variable values in which lookup is to be performed.
      */
-    std::vector< IndependentVariableType > independentVariableValues_;
+    SharedImmutableVector< IndependentVariableType > independentVariableValues_;
+
+private:
+
+    //! Cursor used by look-ups for which no cursor is provided.
+    /*!
+     * Cursor used by look-ups for which no cursor is provided.
+     */
+    LookUpCursor lookUpCursor_;
 };
 
 //! Look-up scheme class for nearest left neighbour search using hunting algorithm.
@@ -113,48 +264,56 @@ class HuntingAlgorithmLookupScheme: public LookUpScheme< IndependentVariableType
 public:
 
     using LookUpScheme< IndependentVariableType >::independentVariableValues_;
+    using LookUpScheme< IndependentVariableType >::findNearestLowerNeighbour;
 
     //! Constructor, used to set data vector.
     /*!
-     *  Constructor, used to set data vector. Initializes guess from 'previous' request to 0.
+     * Constructor, used to set data vector.
      * \param independentVariableValues vector of independent variable values in which to perform
      * lookup procedure.
      */
-    HuntingAlgorithmLookupScheme( const std::vector< IndependentVariableType >
-                                  independentVariableValues )
-        : LookUpScheme< IndependentVariableType >( independentVariableValues ),
-          isFirstLookupDone( 0 ),
-          previousNearestLowerIndex_( 0 )
+    HuntingAlgorithmLookupScheme(
+            const SharedImmutableVector< IndependentVariableType >& independentVariableValues )
+        : LookUpScheme< IndependentVariableType >( independentVariableValues )
     { }
 
-    //! Find nearest left neighbour.
+    //! Find nearest left neighbour using caller-owned cursor.
     /*!
-     * Function finds nearest left neighbour of given value in ndependentVariableValues_. If this
-     * is first call of function, a binary search is used.
+     * Function finds nearest left neighbour of given value in independentVariableValues_, using
+     * the result of the previous look-up stored in the cursor as initial guess. If no look-up has
+     * been done with the cursor, or if its result is not a valid index for this scheme, a binary
+     * search is used.
      * \param valueToLookup Value of which nearest neighbour is to be determined.
+     * \param cursor State of previous look-ups, updated by this function.
      * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
      * to valueToLookup.
      */
-    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup )
+    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup,
+                                   LookUpCursor& cursor ) const
     {
         // Initialize return value.
         int newNearestLowerIndex = 0;
+        const int previousNearestLowerIndex = cursor.previousNearestLowerIndex;
 
-        // If this is first call of function, use binary search.
-        if ( !isFirstLookupDone )
+        // If this is first look-up with cursor, or if cursor is invalid, use binary search.
+        if ( !cursor.isFirstLookupDone || previousNearestLowerIndex < 0 ||
+             previousNearestLowerIndex
+             > static_cast< int >( independentVariableValues_.size( ) ) - 2 )
         {
             newNearestLowerIndex = basic_mathematics::computeNearestLeftNeighborUsingBinarySearch
-                    < IndependentVariableType >( independentVariableValues_, valueToLookup );
-            isFirstLookupDone = 1;
+                    < IndependentVariableType >( independentVariableValues_.getVector( ),
+                                                 valueToLookup );
+            cursor.isFirstLookupDone = true;
         }
 
         else
         {
             // If requested value is in same interval, return same value as previous time.
             if ( basic_mathematics::isIndependentVariableInInterval< IndependentVariableType >
-                 ( previousNearestLowerIndex_,  valueToLookup, independentVariableValues_ ) )
+                 ( previousNearestLowerIndex,  valueToLookup,
+                   independentVariableValues_.getVector( ) ) )
             {
-                newNearestLowerIndex = previousNearestLowerIndex_;
+                newNearestLowerIndex = previousNearestLowerIndex;
             }
 
             // Otherwise, perform hunting algorithm.
@@ -163,66 +322,317 @@ public:
                 newNearestLowerIndex =
                         basic_mathematics::findNearestLeftNeighbourUsingHuntingAlgorithm<
                         IndependentVariableType >
-                        (  valueToLookup, previousNearestLowerIndex_, independentVariableValues_ );
+                        (  valueToLookup, previousNearestLowerIndex,
+                           independentVariableValues_.getVector( ) );
             }
         }
 
         // Set calculated value for use in next call.
-        previousNearestLowerIndex_ = newNearestLowerIndex;
+        cursor.previousNearestLowerIndex = newNearestLowerIndex;
 
         return newNearestLowerIndex;
     }
+};
+
+//! Look-up scheme class for nearest left neighbour search using binary search algorithm.
+/*!
+ * Look-up scheme class for nearest left neighbour search using binary search algorithm.
+ * \tparam IndependentVariableType Type of entries of vector in which lookup is to be performed.
+ */
+template< typename IndependentVariableType >
+class BinarySearchLookupScheme: public LookUpScheme< IndependentVariableType >
+{
+public:
+
+    using LookUpScheme< IndependentVariableType >::independentVariableValues_;
+    using LookUpScheme< IndependentVariableType >::findNearestLowerNeighbour;
+
+    //! Constructor, used to set data vector.
+    /*!
+     * Constructor, used to set data vector.
+     * \param independentVariableValues vector of independent variable values in which to perform
+     * lookup procedure.
+     */
+    BinarySearchLookupScheme(
+            const SharedImmutableVector< IndependentVariableType >& independentVariableValues )
+        : LookUpScheme< IndependentVariableType >( independentVariableValues )
+    { }
+
+    //! Find nearest left neighbour using caller-owned cursor.
+    /*!
+     * Function finds nearest left neighbour of given value in independentVariableValues_. The
+     * cursor is not used by this look-up scheme.
+     * \param valueToLookup Value of which nearest neaighbour is to be determined.
+     * \param cursor State of previous look-ups (unused).
+     * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
+     * to valueToLookup.
+     */
+    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup,
+                                   LookUpCursor& cursor ) const
+    {
+        TUDAT_UNUSED_PARAMETER( cursor );
+        return basic_mathematics::computeNearestLeftNeighborUsingBinarySearch
+                < IndependentVariableType >( independentVariableValues_.getVector( ),
+                                             valueToLookup );
+    }
+};
+
+//! Look-up scheme class for nearest left neighbour search on uniformly spaced values.
+/*!
+ * Look-up scheme class for nearest left neighbour search on uniformly spaced independent
+ * variable values. The nearest left neighbour is computed directly from the grid spacing, such
+ * that the cost of a look-up is independent of the number of values and the location of the
+ * previous look-up. Uniform spacing is checked at construction.
+ * \tparam IndependentVariableType Type of entries of vector in which lookup is to be performed.
+ */
+template< typename IndependentVariableType >
+class UniformGridLookupScheme: public LookUpScheme< IndependentVariableType >
+{
+public:
+
+    using LookUpScheme< IndependentVariableType >::independentVariableValues_;
+    using LookUpScheme< IndependentVariableType >::findNearestLowerNeighbour;
+
+    //! Constructor, used to set data vector.
+    /*!
+     * Constructor, used to set data vector. Throws an exception if the values are not sorted in
+     * ascending order and uniformly spaced (see isGridUniform function).
+     * \param independentVariableValues vector of independent variable values in which to perform
+     * lookup procedure.
+     * \param relativeTolerance Tolerance on deviation from uniform grid, relative to spacing.
+     */
+    UniformGridLookupScheme(
+            const SharedImmutableVector< IndependentVariableType >& independentVariableValues,
+            const double relativeTolerance = defaultUniformGridTolerance )
+        : LookUpScheme< IndependentVariableType >( independentVariableValues ),
+          maximumLowerIndex_( static_cast< int >( independentVariableValues.size( ) ) - 2 )
+    {
+        if ( !isGridUniform( independentVariableValues_.getVector( ), relativeTolerance ) )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                "Error, independent variable values provided to uniform grid look-up scheme "
+                "are not uniformly spaced." ) ) );
+        }
+
+        inverseSpacing_ = static_cast< IndependentVariableType >( maximumLowerIndex_ + 1 )
+                / ( independentVariableValues_.back( ) - independentVariableValues_.front( ) );
+    }
+
+    //! Find nearest left neighbour using caller-owned cursor.
+    /*!
+     * Function finds nearest left neighbour of given value in independentVariableValues_. Values
+     * outside the grid are assigned to the first or last interval. The cursor is not used by
+     * this look-up scheme.
+     * \param valueToLookup Value of which nearest neaighbour is to be determined.
+     * \param cursor State of previous look-ups (unused).
+     * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
+     * to valueToLookup.
+     */
+    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup,
+                                   LookUpCursor& cursor ) const
+    {
+        TUDAT_UNUSED_PARAMETER( cursor );
+
+        // Compute interval index from spacing, limited to range of grid.
+        const IndependentVariableType scaledValue =
+                ( valueToLookup - independentVariableValues_.front( ) ) * inverseSpacing_;
+        if ( !( scaledValue > 0.0 ) )
+        {
+            return 0;
+        }
+
+        int nearestLowerIndex = scaledValue >= maximumLowerIndex_ ?
+                    maximumLowerIndex_ : static_cast< int >( scaledValue );
+
+        // Correct for round-off in the vicinity of nodes.
+        if ( valueToLookup < independentVariableValues_[ nearestLowerIndex ] )
+        {
+            nearestLowerIndex--;
+        }
+        else if ( nearestLowerIndex < maximumLowerIndex_ &&
+                  valueToLookup >= independentVariableValues_[ nearestLowerIndex + 1 ] )
+        {
+            nearestLowerIndex++;
+        }
+
+        return nearestLowerIndex;
+    }
 
 private:
 
-    //! Boolean to denote whether a lookup has been done.
+    //! Inverse of spacing between independent variable values.
     /*!
-     * Boolean to denote whether a lookup has been done.
+     * Inverse of spacing between independent variable values.
      */
-    bool isFirstLookupDone;
+    IndependentVariableType inverseSpacing_;
 
-    //! Nearest left index during previous call.
+    //! Largest index that can be returned as nearest lower neighbour.
     /*!
-     * Nearest left index during previous call
+     * Largest index that can be returned as nearest lower neighbour.
      */
-    int previousNearestLowerIndex_;
+    int maximumLowerIndex_;
 };
 
-//! Look-up scheme class for nearest left neighbour search using binary search algorithm.
+//! Look-up scheme class for nearest left neighbour search on piecewise uniformly spaced values.
 /*!
- * Look-up scheme class for nearest left neighbour search using binary search algorithm.
+ * Look-up scheme class for nearest left neighbour search on independent variable values that
+ * consist of a number of segments, each of which is uniformly spaced (e.g., a table with a finer
+ * resolution in part of its domain). The segments are detected at construction. A look-up
+ * consists of a binary search over the (typically few) segment boundaries, followed by the
+ * computation of the interval index from the spacing of the segment.
  * \tparam IndependentVariableType Type of entries of vector in which lookup is to be performed.
  */
 template< typename IndependentVariableType >
-class BinarySearchLookupScheme: public LookUpScheme< IndependentVariableType >
+class PiecewiseUniformGridLookupScheme: public LookUpScheme< IndependentVariableType >
 {
 public:
 
     using LookUpScheme< IndependentVariableType >::independentVariableValues_;
+    using LookUpScheme< IndependentVariableType >::findNearestLowerNeighbour;
 
     //! Constructor, used to set data vector.
     /*!
-     * Constructor, used to set data vector.
+     * Constructor, used to set data vector, and divide it into uniformly spaced segments. Throws
+     * an exception if the values are not sorted in strictly ascending order.
      * \param independentVariableValues vector of independent variable values in which to perform
      * lookup procedure.
+     * \param relativeTolerance Tolerance on deviation of spacing within a segment, relative to the
+     *          spacing of the first interval of the segment.
      */
-    BinarySearchLookupScheme(
-            const std::vector< IndependentVariableType > independentVariableValues )
+    PiecewiseUniformGridLookupScheme(
+            const SharedImmutableVector< IndependentVariableType >& independentVariableValues,
+            const double relativeTolerance = defaultUniformGridTolerance )
         : LookUpScheme< IndependentVariableType >( independentVariableValues )
-    { }
+    {
+        const int numberOfValues = static_cast< int >( independentVariableValues_.size( ) );
+        if ( numberOfValues < 2 )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                "Error, at least two independent variable values are required by piecewise "
+                "uniform grid look-up scheme." ) ) );
+        }
 
-    //! Find nearest left neighbour.
+        // Divide values into segments of constant spacing, adjacent segments sharing a node.
+        int segmentStartIndex = 0;
+        while ( segmentStartIndex < numberOfValues - 1 )
+        {
+            const IndependentVariableType spacing =
+                    independentVariableValues_[ segmentStartIndex + 1 ]
+                    - independentVariableValues_[ segmentStartIndex ];
+            if ( !( spacing > 0.0 ) )
+            {
+                boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                    "Error, independent variable values provided to piecewise uniform grid "
+                    "look-up scheme are not strictly ascending." ) ) );
+            }
+
+            int segmentEndIndex = segmentStartIndex + 1;
+            while ( segmentEndIndex < numberOfValues - 1 &&
+                    std::fabs( independentVariableValues_[ segmentEndIndex + 1 ]
+                               - independentVariableValues_[ segmentStartIndex ]
+                               - static_cast< IndependentVariableType >(
+                                   segmentEndIndex + 1 - segmentStartIndex ) * spacing )
+                    <= relativeTolerance * spacing )
+            {
+                segmentEndIndex++;
+            }
+
+            segmentStartValues_.push_back( independentVariableValues_[ segmentStartIndex ] );
+            segmentStartIndices_.push_back( segmentStartIndex );
+            segmentInverseSpacings_.push_back(
+                        static_cast< IndependentVariableType >(
+                            segmentEndIndex - segmentStartIndex )
+                        / ( independentVariableValues_[ segmentEndIndex ]
+                            - independentVariableValues_[ segmentStartIndex ] ) );
+            segmentStartIndex = segmentEndIndex;
+        }
+
+        // Add final node as end of last segment.
+        segmentStartIndices_.push_back( numberOfValues - 1 );
+    }
+
+    //! Find nearest left neighbour using caller-owned cursor.
     /*!
-     * Function finds nearest left neighbour of given value in independentVariableValues_.
+     * Function finds nearest left neighbour of given value in independentVariableValues_. Values
+     * outside the grid are assigned to the first or last interval. The cursor is not used by
+     * this look-up scheme.
      * \param valueToLookup Value of which nearest neaighbour is to be determined.
+     * \param cursor State of previous look-ups (unused).
      * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
      * to valueToLookup.
      */
-    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup )
+    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup,
+                                   LookUpCursor& cursor ) const
     {
-        return basic_mathematics::computeNearestLeftNeighborUsingBinarySearch
-                < IndependentVariableType >( independentVariableValues_, valueToLookup );
+        TUDAT_UNUSED_PARAMETER( cursor );
+
+        // Find segment in which value is located.
+        const int segmentIndex = std::max(
+                    static_cast< int >( std::upper_bound( segmentStartValues_.begin( ),
+                                                          segmentStartValues_.end( ),
+                                                          valueToLookup )
+                                        - segmentStartValues_.begin( ) ) - 1, 0 );
+        const int segmentStartIndex = segmentStartIndices_[ segmentIndex ];
+        const int maximumLowerIndex = segmentStartIndices_[ segmentIndex + 1 ] - 1;
+
+        // Compute interval index from spacing of segment, limited to range of segment.
+        const IndependentVariableType scaledValue =
+                ( valueToLookup - segmentStartValues_[ segmentIndex ] )
+                * segmentInverseSpacings_[ segmentIndex ];
+        if ( !( scaledValue > 0.0 ) )
+        {
+            return segmentStartIndex;
+        }
+
+        int nearestLowerIndex = segmentStartIndex + static_cast< int >(
+                    std::min( scaledValue, static_cast< IndependentVariableType >(
+                                  maximumLowerIndex - segmentStartIndex ) ) );
+
+        // Correct for round-off in the vicinity of nodes.
+        if ( valueToLookup < independentVariableValues_[ nearestLowerIndex ] )
+        {
+            nearestLowerIndex--;
+        }
+        else if ( nearestLowerIndex < maximumLowerIndex &&
+                  valueToLookup >= independentVariableValues_[ nearestLowerIndex + 1 ] )
+        {
+            nearestLowerIndex++;
+        }
+
+        return nearestLowerIndex;
+    }
+
+    //! Get number of uniformly spaced segments.
+    /*!
+     * Returns the number of uniformly spaced segments into which the independent variable values
+     * have been divided.
+     * \return Number of uniformly spaced segments.
+     */
+    int getNumberOfSegments( ) const
+    {
+        return static_cast< int >( segmentStartValues_.size( ) );
     }
+
+private:
+
+    //! Independent variable values at start of each segment.
+    /*!
+     * Independent variable values at start of each segment.
+     */
+    std::vector< IndependentVariableType > segmentStartValues_;
+
+    //! Indices of start of each segment, followed by index of final node.
+    /*!
+     * Indices of start of each segment in independentVariableValues_, followed by index of final
+     * node, such that entry i + 1 is the index of the end of segment i.
+     */
+    std::vector< int > segmentStartIndices_;
+
+    //! Inverse of spacing between independent variable values in each segment.
+    /*!
+     * Inverse of spacing between independent variable values in each segment.
+     */
+    std::vector< IndependentVariableType > segmentInverseSpacings_;
 };
 
 //! Typedef for shared-pointer to LookUpScheme object with double-type entries.
@@ -236,6 +646,14 @@ HuntingAlgorithmLookupSchemeDoublePointer;
 typedef boost::shared_ptr< BinarySearchLookupScheme< double > >
 BinarySearchLookupSchemeDoublePointer;
 
+//! Typedef for shared-pointer to UniformGridLookupScheme object with double-type entries.
+typedef boost::shared_ptr< UniformGridLookupScheme< double > >
+UniformGridLookupSchemeDoublePointer;
+
+//! Typedef for shared-pointer to PiecewiseUniformGridLookupScheme object with double-type entries.
+typedef boost::shared_ptr< PiecewiseUniformGridLookupScheme< double > >
+PiecewiseUniformGridLookupSchemeDoublePointer;
+
 } // namespace interpolators
 } // namespace tudat
 
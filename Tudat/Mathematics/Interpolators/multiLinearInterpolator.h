@@ -27,6 +27,14 @@
  *                D. Dirkx          File created.
  *      121027    A. Ronse          Adapted for addition to Tudat.
  *      131227    K. Kumar          Added note about spurious warning in older GCC versions.
+ *      140310    S. Vermeer        Added uniform and piecewise-uniform grid look-up schemes.
+ *      140312    S. Vermeer        Added const interpolation with caller-owned look-up cursors.
+ *      140314    S. Vermeer        Replaced recursive interpolation by allocation-free iterative
+ *                                  reduction over grid corners; added batch interpolation.
+ *      140326    S. Vermeer        Stored data in shared storage; added construction from shared
+ *                                  data.
+ *      140401    S. Vermeer        Corrected class documentation to describe iterative
+ *                                  interpolation.
  *
  *    References
  *     Stackoverflow. C++ GCC4.4 warning: array subscript is above array bounds, 2009,
@@ -45,21 +53,33 @@
  *     been noted when compiling using the MinGW GCC 4.4.0 compiler under MS Windows. For more
  *     information on the nature of this warning, please take a look at Stackoverflow (2009) and
  *     GCC Mailing List (2012).
+ *     The interpolation first computes the interpolation fractions in each dimension, and then
+ *     gathers the dependent variable values at the 2^N corners of the grid hyper-rectangle into a
+ *     fixed-size array. These values are reduced one dimension at a time, starting at the last
+ *     dimension, which requires 2^N - 1 linear interpolations and no dynamic memory allocation.
+ *     All loops have bounds that are known at compile time, allowing them to be unrolled.
+ *     The independent and dependent data are stored through shared pointers, so that neither the
+ *     look-up schemes nor other interpolators created from the same shared data copy them.
  *
  */
 
 #ifndef TUDAT_MULTI_LINEAR_INTERPOLATOR_H
 #define TUDAT_MULTI_LINEAR_INTERPOLATOR_H
 
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 #include <boost/array.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/multi_array.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Mathematics/Interpolators/lookupScheme.h"
 #include "Tudat/Mathematics/Interpolators/interpolator.h"
+#include "Tudat/Mathematics/Interpolators/sharedImmutableVector.h"
 #include "Tudat/Mathematics/BasicMathematics/nearestNeighbourSearch.h"
 
 namespace tudat
@@ -70,8 +90,10 @@ namespace interpolators
 //! Class for performing multi-linear interpolation for arbitrary number of independent variables.
 /*!
  * Class for performing multi-linear interpolation for arbitrary number of independent variables.
- * Interpolation is calculated recursively over all dimensions of independent variables. Note
- * that the types (i.e. double, float) of all independent variables must be the same.
+ * The dependent variable values at the 2^N corners of the grid hyper-rectangle containing the
+ * target point are gathered, and are then reduced iteratively by interpolating linearly in one
+ * dimension at a time, halving the number of values at each step until a single value remains.
+ * Note that the types (i.e. double, float) of all independent variables must be the same.
  * \tparam IndependentVariableType Type for independent variables.
  * \tparam DependentVariableType Type for dependent variable.
  * \tparam numberOfDimensions Number of independent variables.
@@ -83,8 +105,19 @@ class MultiLinearInterpolator: public Interpolator< IndependentVariableType,
 {
 public:
 
+    //! Typedef for array of look-up cursors, one per dimension.
+    typedef boost::array< LookUpCursor, numberOfDimensions > LookUpCursorArray;
+
+    //! Typedef for multi-dimensional array of dependent data.
+    typedef boost::multi_array< DependentVariableType, numberOfDimensions > DependentDataArray;
+
+    //! Number of corners of grid hyper-rectangle, equal to 2^numberOfDimensions.
+    static const int numberOfCorners = 1 << numberOfDimensions;
+
     //! Constructor taking independent and dependent variable data.
     /*!
+     * Constructor taking independent and dependent variable data, which are copied once into
+     * storage that is shared with the look-up schemes of the interpolator.
      * \param independentValues Vector of vectors containing data points of independent variables.
      * \param dependentData Multi-dimensional array of dependent data at each point of
      *          hyper-rectangular grid formed by independent variable points.
@@ -92,32 +125,45 @@ public:
      *          to find the nearest lower data point in the independent variables when requesting
      *          interpolation.
      */
-    MultiLinearInterpolator( const std::vector< std::vector< IndependentVariableType > >
+    MultiLinearInterpolator( const std::vector< std::vector< IndependentVariableType > >&
                              independentValues,
-                             const boost::multi_array< DependentVariableType, numberOfDimensions >
-                             dependentData,
+                             const DependentDataArray& dependentData,
                              const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+        : independentValues_( independentValues.begin( ), independentValues.end( ) ),
+          dependentData_( boost::make_shared< const DependentDataArray >( dependentData ) )
+    {
+        initializeInterpolator( selectedLookupScheme );
+    }
+
+    //! Constructor taking shared independent and dependent variable data.
+    /*!
+     * Constructor taking shared independent and dependent variable data, which are not copied.
+     * This allows a single (large) data set, e.g., an aerodynamic database, to be used by
+     * multiple interpolators, or to be owned by another object (see
+     * createNonOwningSharedPointer). The data may not be modified after construction.
+     * \param independentValues Vector of shared vectors containing data points of independent
+     *          variables.
+     * \param dependentData Shared pointer to multi-dimensional array of dependent data at each
+     *          point of hyper-rectangular grid formed by independent variable points.
+     *  \param selectedLookupScheme Identifier of lookupscheme from enum. This algorithm is used
+     *          to find the nearest lower data point in the independent variables when requesting
+     *          interpolation.
+     */
+    MultiLinearInterpolator(
+            const std::vector< SharedImmutableVector< IndependentVariableType > >&
+            independentValues,
+            const boost::shared_ptr< const DependentDataArray >& dependentData,
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
         : independentValues_( independentValues ),
           dependentData_( dependentData )
     {
-        // Check consistency of template arguments and input variables.
-        if ( independentValues.size( ) != numberOfDimensions )
+        if ( !dependentData_ )
         {
-            std::cerr << "Error: dimension of independent value vector provided to constructor";
-            std::cerr << "incompatible with tenmplate parameter " << std::endl;
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                    "Error, dependent data of multi-linear interpolator is null." ) ) );
         }
 
-        // Check consistency of input data of dependent and independent data.
-        for ( int i = 0; i < numberOfDimensions; i++ )
-        {
-            if ( independentValues[ i ].size( ) != dependentData.shape( )[ i ] )
-            {
-                std::cerr << "Warning: number of data points in dimension" << i
-                          << " of independent and dependent data incompatible" << std::endl;
-            }
-        }
-
-        makeLookupSchemes( selectedLookupScheme );
+        initializeInterpolator( selectedLookupScheme );
     }
 
     //! Function to perform interpolation.
@@ -130,32 +176,163 @@ public:
     DependentVariableType interpolate(
             const std::vector< IndependentVariableType >& independentValuesToInterpolate )
     {
-        // Determine the nearest lower neighbours.
-        std::vector< int > nearestLowerIndices;
-        nearestLowerIndices.resize( numberOfDimensions );
-        for ( unsigned int i = 0; i < numberOfDimensions; i++ )
+        return interpolate( independentValuesToInterpolate, lookUpCursors_ );
+    }
+
+    //! Function to perform interpolation using caller-owned look-up cursors.
+    /*!
+     *  This function performs the multilinear interpolation, using and updating the state of
+     *  previous look-ups stored in the given cursors (one per dimension). This function does not
+     *  modify the interpolator, and may be called concurrently from multiple threads with
+     *  distinct cursors.
+     *  \param independentValuesToInterpolate Vector of values of independent variables at which
+     *  the value of the dependent variable is to be determined.
+     *  \param lookUpCursors State of previous look-ups in each dimension, updated by this
+     *  function.
+     *  \return Interpolated value of dependent variable in all dimensions.
+     */
+    DependentVariableType interpolate(
+            const std::vector< IndependentVariableType >& independentValuesToInterpolate,
+            LookUpCursorArray& lookUpCursors ) const
+    {
+        // Determine the nearest lower neighbours, the fractions of the data points above and below
+        // the independent variable value, and the offset of the lower corner in the data array.
+        boost::array< IndependentVariableType, numberOfDimensions > upperFractions;
+        boost::array< IndependentVariableType, numberOfDimensions > lowerFractions;
+        const typename DependentDataArray::index* dataStrides = dependentData_->strides( );
+        std::ptrdiff_t lowerCornerOffset = 0;
+        for ( int i = 0; i < numberOfDimensions; i++ )
         {
-            nearestLowerIndices[ i ] = lookUpSchemes_[ i ]->findNearestLowerNeighbour(
-                    independentValuesToInterpolate[ i ] );
+            const int nearestLowerIndex = lookUpSchemes_[ i ]->findNearestLowerNeighbour(
+                        independentValuesToInterpolate[ i ], lookUpCursors[ i ] );
+            const IndependentVariableType lowerValue =
+                    independentValues_[ i ][ nearestLowerIndex ];
+            const IndependentVariableType upperValue =
+                    independentValues_[ i ][ nearestLowerIndex + 1 ];
+
+            upperFractions[ i ] = ( independentValuesToInterpolate[ i ] - lowerValue )
+                    / ( upperValue - lowerValue );
+            lowerFractions[ i ] = -( independentValuesToInterpolate[ i ] - upperValue )
+                    / ( upperValue - lowerValue );
+            lowerCornerOffset += nearestLowerIndex * dataStrides[ i ];
         }
 
-        // Initialize function evaluation indices to -1 for debugging purposes.
-        boost::array< int, numberOfDimensions > interpolationIndices;
+        // Compute offsets of all corners of grid hyper-rectangle, where the bit corresponding to
+        // dimension i is set for the upper data point in that dimension. The first dimension
+        // corresponds to the most significant bit.
+        boost::array< std::ptrdiff_t, numberOfCorners > cornerOffsets;
+        cornerOffsets[ 0 ] = lowerCornerOffset;
         for ( int i = 0; i < numberOfDimensions; i++ )
         {
-            interpolationIndices[ i ] = -1;
+            for ( int j = ( 1 << i ) - 1; j >= 0; j-- )
+            {
+                cornerOffsets[ 2 * j + 1 ] = cornerOffsets[ j ] + dataStrides[ i ];
+                cornerOffsets[ 2 * j ] = cornerOffsets[ j ];
+            }
         }
 
-        // Call first step of interpolation, this function calls itself at subsequent independent
-        // variable dimensions to evaluate and properly scale dependent variable table values at
-        // all 2^n grid edges.
-        return performRecursiveInterpolationStep( 0, independentValuesToInterpolate,
-                                                  interpolationIndices, nearestLowerIndices );
+        // Retrieve dependent variable values at corners.
+        const DependentVariableType* dataOrigin = dependentData_->origin( );
+        boost::array< DependentVariableType, numberOfCorners > cornerValues;
+        for ( int j = 0; j < numberOfCorners; j++ )
+        {
+            cornerValues[ j ] = dataOrigin[ cornerOffsets[ j ] ];
+        }
+
+        // Interpolate in one dimension at a time, starting at the last dimension, halving the
+        // number of values at each step.
+        for ( int i = numberOfDimensions - 1; i >= 0; i-- )
+        {
+            for ( int j = 0; j < ( 1 << i ); j++ )
+            {
+                cornerValues[ j ] = upperFractions[ i ] * cornerValues[ 2 * j + 1 ]
+                        + lowerFractions[ i ] * cornerValues[ 2 * j ];
+            }
+        }
+
+        return cornerValues[ 0 ];
+    }
+
+    //! Function to perform interpolation at multiple points.
+    /*!
+     *  This function performs the multilinear interpolation at each of a number of points, using
+     *  a single set of look-up cursors, which are local to this function call. The points are
+     *  best ordered such that subsequent points are close together. This function does not
+     *  modify the interpolator, and may be called concurrently from multiple threads.
+     *  \param independentValuesToInterpolate Vector of points, each of which is a vector of
+     *  values of independent variables at which the value of the dependent variable is to be
+     *  determined.
+     *  \param interpolatedValues Interpolated values of dependent variable, one per point
+     *  (returned by reference). No memory is allocated if the vector already has the correct
+     *  size.
+     */
+    void interpolate(
+            const std::vector< std::vector< IndependentVariableType > >&
+            independentValuesToInterpolate,
+            std::vector< DependentVariableType >& interpolatedValues ) const
+    {
+        LookUpCursorArray lookUpCursors;
+        interpolatedValues.resize( independentValuesToInterpolate.size( ) );
+        for ( unsigned int i = 0; i < independentValuesToInterpolate.size( ); i++ )
+        {
+            interpolatedValues[ i ] = interpolate( independentValuesToInterpolate[ i ],
+                                                   lookUpCursors );
+        }
     }
 
+    //! Get independent variable values.
+    /*!
+     * Returns shared vectors of independent variable values in each dimension, which can be used
+     * to create other interpolators using the same values without copying them.
+     * \return Shared vectors of independent variable values.
+     */
+    const std::vector< SharedImmutableVector< IndependentVariableType > >&
+    getIndependentValues( ) const
+    {
+        return independentValues_;
+    }
+
+    //! Get dependent data.
+    /*!
+     * Returns shared pointer to multi-dimensional array of dependent data, which can be used to
+     * create other interpolators using the same data without copying it.
+     * \return Shared pointer to multi-dimensional array of dependent data.
+     */
+    boost::shared_ptr< const DependentDataArray > getDependentData( ) const
+    {
+        return dependentData_;
+    }
 
 private:
 
+    //! Check consistency of data and make look-up schemes.
+    /*!
+     * Checks consistency of data with template arguments, and makes the look-up schemes, which
+     * share the independent variable values stored by this object.
+     *  \param selectedLookupScheme Type of look-up scheme that is to be used.
+     */
+    void initializeInterpolator( const AvailableLookupScheme selectedLookupScheme )
+    {
+        // Check consistency of template arguments and input variables.
+        if ( independentValues_.size( ) != numberOfDimensions )
+        {
+            std::cerr << "Error: dimension of independent value vector provided to constructor";
+            std::cerr << "incompatible with tenmplate parameter " << std::endl;
+        }
+
+        // Check consistency of input data of dependent and independent data.
+        for ( int i = 0; i < numberOfDimensions; i++ )
+        {
+            if ( independentValues_[ i ].size( ) != dependentData_->shape( )[ i ] )
+            {
+                std::cerr << "Warning: number of data points in dimension" << i
+                          << " of independent and dependent data incompatible" << std::endl;
+            }
+        }
+
+        makeLookupSchemes( selectedLookupScheme );
+    }
+
     //! Make the lookup scheme that is to be used.
     /*!
      * This function creates the look up scheme that is to be used in determining the interval of
@@ -194,6 +371,31 @@ private:
 
             break;
 
+        case uniformGrid:
+
+            for( int i = 0; i < numberOfDimensions; i++ )
+            {
+                // Create uniform grid scheme, which computes the interval from the grid spacing.
+                lookUpSchemes_[ i ] = boost::shared_ptr< LookUpScheme< IndependentVariableType > >
+                        ( new UniformGridLookupScheme< IndependentVariableType >(
+                              independentValues_[ i ] ) );
+            }
+
+            break;
+
+        case piecewiseUniformGrid:
+
+            for( int i = 0; i < numberOfDimensions; i++ )
+            {
+                // Create piecewise uniform grid scheme, which computes the interval from the
+                // spacing of the uniformly spaced segment in which the requested value is located.
+                lookUpSchemes_[ i ] = boost::shared_ptr< LookUpScheme< IndependentVariableType > >
+                        ( new PiecewiseUniformGridLookupScheme< IndependentVariableType >(
+                              independentValues_[ i ] ) );
+            }
+
+            break;
+
         default:
 
             std::cerr << "Warning: lookup scheme not found when making scheme for 1-D interpolator"
@@ -201,81 +403,6 @@ private:
         }
     }
 
-    //! Perform the step in a single dimension of the interpolation process.
-    /*!
-     * Function calculates single dimension of the interpolation process. Function calls itself if
-     * final dimension not yet reached. Calling this function with currentVariable = 0 will result
-     * in 2^{numberOfDimensions} number of calls to the function at currentVariable =
-     * numberOfDimensions -1. As such, the complete series of calls, starting at currentVariable =
-     * 0, retrieves the dependent variable values at all edges of the grid hyper-rectangle and
-     * properly scales them.
-     * \param currentVariable Dimension in which this interpolation step is to be performed.
-     * \param independentValuesToInterpolate Vector of values of independent variables at which
-     *          interpolation is to be performed.
-     * \param currentArrayIndices Array of indices modified at index = currentVariable at each
-     *          call of function. Variable is passed to dependentData in highest step to return
-     *          data for interpolation.
-     * \param nearestLowerIndices Indices in subvectors of independentValues_ vector. That is, the
-     *  n-th entry of nearestLowerIndices represent the nearest lower neighbour in the n-th
-     *  interpolation dimension of the independent variable vectors.
-     * \return Interpolated value in a single dimension
-     */
-    DependentVariableType performRecursiveInterpolationStep(
-            const unsigned int currentVariable,
-            const std::vector< IndependentVariableType >& independentValuesToInterpolate,
-            boost::array< int, numberOfDimensions > currentArrayIndices,
-            const std::vector< int >& nearestLowerIndices )
-    {
-        IndependentVariableType upperFraction, lowerFraction;
-        DependentVariableType upperContribution, lowerContribution;
-
-        // Calculate fractions of data points above and below independent
-        // variable value to be added to interpolated value.
-        upperFraction = ( independentValuesToInterpolate[ currentVariable ] -
-                          independentValues_[ currentVariable ]
-                          [ nearestLowerIndices[ currentVariable ] ] ) /
-                ( independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] + 1 ] -
-                  independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] ] );
-        lowerFraction = -( independentValuesToInterpolate[ currentVariable ] -
-                           independentValues_[ currentVariable ]
-                           [ nearestLowerIndices[ currentVariable ] + 1 ] ) /
-                ( independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] + 1 ] -
-                  independentValues_[ currentVariable ]
-                  [ nearestLowerIndices[ currentVariable ] ] );
-
-        // If at top dimension, call dependent variable data.
-        if ( currentVariable == numberOfDimensions - 1 )
-        {
-            currentArrayIndices[ numberOfDimensions - 1 ] = nearestLowerIndices[ currentVariable ];
-            lowerContribution = dependentData_( currentArrayIndices );
-            currentArrayIndices[ numberOfDimensions - 1 ] = nearestLowerIndices[ currentVariable ]
-                                                            + 1;
-            upperContribution = dependentData_( currentArrayIndices );
-        }
-
-        // If at lower dimension, update currentArrayIndices and call function with
-        // currentVariable++.
-        else
-        {
-            currentArrayIndices[ currentVariable ] = nearestLowerIndices[ currentVariable ];
-            lowerContribution = performRecursiveInterpolationStep(
-                        currentVariable + 1, independentValuesToInterpolate,
-                        currentArrayIndices, nearestLowerIndices );
-            currentArrayIndices[ currentVariable ] = nearestLowerIndices[ currentVariable ] + 1;
-            upperContribution = performRecursiveInterpolationStep(
-                        currentVariable + 1, independentValuesToInterpolate,
-                        currentArrayIndices, nearestLowerIndices );
-        }
-
-        // Return interpolated value.
-        DependentVariableType returnValue = upperFraction * upperContribution +
-                                            lowerFraction * lowerContribution;
-        return returnValue;
-    }
-
     //! Vector with pointers to look-up scheme.
     /*!
      * Pointers to the look-up schemes that is used to determine in which interval the requested
@@ -283,19 +410,27 @@ private:
      */
     std::vector< boost::shared_ptr< LookUpScheme< IndependentVariableType > > > lookUpSchemes_;
 
-    //! Vector of vectors containing independent variables.
+    //! Vector of shared vectors containing independent variables.
+    /*!
+     * Vector of shared vectors containing independent variables, which are also used by the
+     * look-up schemes. The size of the outer vector is equal to the number of dimensions of the
+     * interpolator.
+     */
+    std::vector< SharedImmutableVector< IndependentVariableType > > independentValues_;
+
+    //! Shared pointer to multi-dimensional array of dependent data.
     /*!
-     * Vector of vectors containing independent variables. The size of the outer vector is equal
-     * to the number of dimensions of the interpolator.
+     * Shared pointer to multi-dimensional array of dependent data at each point of
+     * hyper-rectangular grid formed by independent variable points.
      */
-    std::vector< std::vector< IndependentVariableType > > independentValues_;
+    boost::shared_ptr< const DependentDataArray > dependentData_;
 
-    //! Multi-dimensional array of dependent data.
+    //! Look-up cursors used by interpolations for which no cursors are provided.
     /*!
-     * Multi-dimensional array of dependent data at each point of hyper-rectangular grid formed by
-     * independent variable points.
+     * Look-up cursors, one per dimension, used by interpolations for which no cursors are
+     * provided.
      */
-    boost::multi_array< DependentVariableType, numberOfDimensions > dependentData_;
+    LookUpCursorArray lookUpCursors_;
 };
 
 } // namespace interpolators
@@ -25,10 +25,19 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120716    D. Dirkx          Creation of file.
+ *      140310    S. Vermeer        Added uniform and piecewise-uniform grid look-up schemes.
+ *      140312    S. Vermeer        Added const interpolation with caller-owned look-up cursor.
+ *      140317    S. Vermeer        Made look-up cursor accessible to derived classes.
+ *      140326    S. Vermeer        Stored data in shared immutable vectors.
  *
  *    References
  *
  *    Notes
+ *      Interpolation with a caller-owned look-up cursor does not modify the interpolator, so that
+ *      a single interpolator can be shared between threads, each of which uses its own cursor.
+ *      The independent and dependent variable values are stored in shared immutable vectors.
+ *      Interpolators constructed from shared pointers to data reference that data without copying
+ *      it, and the look-up scheme references the values stored by the interpolator.
  *
  */
 
@@ -42,6 +51,7 @@
 
 #include "Tudat/Mathematics/Interpolators/lookupScheme.h"
 #include "Tudat/Mathematics/Interpolators/interpolator.h"
+#include "Tudat/Mathematics/Interpolators/sharedImmutableVector.h"
 
 namespace tudat
 {
@@ -95,13 +105,74 @@ public:
 
     //! Function to perform interpolation.
     /*!
-     * This function performs the interpolation
+     * This function performs the interpolation, using the look-up cursor owned by this object.
+     * This function is therefore not thread-safe; use the function taking a look-up cursor to
+     * share an interpolator between threads.
      * \param independentVariableValue Independent variable value at which the value of the
      *          dependent variable is to be determined.
      * \return Interpolated value of dependent variable.
      */
     virtual DependentVariableType
-            interpolate( const IndependentVariableType independentVariableValue ) = 0;
+            interpolate( const IndependentVariableType independentVariableValue )
+    {
+        return interpolate( independentVariableValue, lookUpCursor_ );
+    }
+
+    //! Function to perform interpolation using caller-owned look-up cursor.
+    /*!
+     * This function performs the interpolation, using and updating the state of previous
+     * look-ups stored in the given cursor. This function does not modify the interpolator, and
+     * may be called concurrently from multiple threads with distinct cursors.
+     * \param independentVariableValue Independent variable value at which the value of the
+     *          dependent variable is to be determined.
+     * \param lookUpCursor State of previous look-ups, updated by this function.
+     * \return Interpolated value of dependent variable.
+     */
+    virtual DependentVariableType
+            interpolate( const IndependentVariableType independentVariableValue,
+                         LookUpCursor& lookUpCursor ) const = 0;
+
+    //! Get independent variable values.
+    /*!
+     * Returns vector of independent variable values of interpolator.
+     * \return Vector of independent variable values.
+     */
+    const std::vector< IndependentVariableType >& getIndependentValues( ) const
+    {
+        return independentValues_.getVector( );
+    }
+
+    //! Get shared independent variable values.
+    /*!
+     * Returns shared vector of independent variable values of interpolator, which can be used to
+     * create other interpolators using the same values without copying them.
+     * \return Shared vector of independent variable values.
+     */
+    const SharedImmutableVector< IndependentVariableType >& getSharedIndependentValues( ) const
+    {
+        return independentValues_;
+    }
+
+    //! Get dependent variable values.
+    /*!
+     * Returns vector of dependent variable values of interpolator.
+     * \return Vector of dependent variable values.
+     */
+    const std::vector< DependentVariableType >& getDependentValues( ) const
+    {
+        return dependentValues_.getVector( );
+    }
+
+    //! Get shared dependent variable values.
+    /*!
+     * Returns shared vector of dependent variable values of interpolator, which can be used to
+     * create other interpolators using the same values without copying them.
+     * \return Shared vector of dependent variable values.
+     */
+    const SharedImmutableVector< DependentVariableType >& getSharedDependentValues( ) const
+    {
+        return dependentValues_;
+    }
 
 protected:
 
@@ -134,6 +205,23 @@ protected:
                       ( independentValues_ ) );
             break;
 
+        case uniformGrid:
+
+            // Create uniform grid scheme, which computes the interval from the grid spacing.
+            lookUpScheme_ = boost::shared_ptr< LookUpScheme< IndependentVariableType > >
+                    ( new UniformGridLookupScheme< IndependentVariableType >
+                      ( independentValues_ ) );
+            break;
+
+        case piecewiseUniformGrid:
+
+            // Create piecewise uniform grid scheme, which computes the interval from the spacing
+            // of the uniformly spaced segment in which the requested value is located.
+            lookUpScheme_ = boost::shared_ptr< LookUpScheme< IndependentVariableType > >
+                    ( new PiecewiseUniformGridLookupScheme< IndependentVariableType >
+                      ( independentValues_ ) );
+            break;
+
         default:
             std::cerr << "Warning: lookup scheme not found when making scheme for 1-D interpolator"
                       << std::endl;
@@ -149,15 +237,22 @@ protected:
 
     //! Vector with dependent variables.
     /*!
-     * Vector with dependent variables.
+     * Vector with dependent variables, shared with any other object created from the same data.
      */
-    std::vector< DependentVariableType > dependentValues_;
+    SharedImmutableVector< DependentVariableType > dependentValues_;
 
     //! Vector with independent variables.
     /*!
-     * Vector with independent variables.
+     * Vector with independent variables, shared with the look-up scheme and any other object
+     * created from the same data.
+     */
+    SharedImmutableVector< IndependentVariableType > independentValues_;
+
+    //! Look-up cursor used by interpolations for which no cursor is provided.
+    /*!
+     * Look-up cursor used by interpolations for which no cursor is provided.
      */
-    std::vector< IndependentVariableType > independentValues_;
+    LookUpCursor lookUpCursor_;
 };
 
 } // namespace interpolators
@@ -0,0 +1,290 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140326    S. Vermeer        File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      Interpolators and look-up schemes store their independent and dependent data in shared
+ *      immutable vectors, so that a single (possibly large) table is stored once, irrespective
+ *      of the number of interpolators and look-up schemes that use it. Constructing such a vector
+ *      from a std::vector copies the data once; constructing it from a shared pointer does not
+ *      copy the data at all.
+ *      A non-owning shared pointer (see createNonOwningSharedPointer) can be used to reference
+ *      data owned elsewhere, e.g., a member of a database object. In that case, the caller is
+ *      responsible for keeping the data alive, and unchanged, for as long as any object using the
+ *      pointer exists.
+ *
+ */
+
+#ifndef TUDAT_SHARED_IMMUTABLE_VECTOR_H
+#define TUDAT_SHARED_IMMUTABLE_VECTOR_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Deleter that does not delete the object it is called on.
+/*!
+ * Deleter that does not delete the object it is called on, used to create shared pointers that
+ * do not own the object they point to.
+ */
+struct NonOwningDeleter
+{
+    //! Function call operator, which does nothing.
+    /*!
+     * Function call operator, which does nothing.
+     * \param object Pointer to object that is not deleted.
+     */
+    void operator( )( const void* object ) const
+    {
+        static_cast< void >( object );
+    }
+};
+
+//! Create shared pointer that does not own the object it points to.
+/*!
+ * Creates a shared pointer to an object that is owned elsewhere. The object is not deleted when
+ * the last copy of the shared pointer is destroyed. The caller is responsible for keeping the
+ * object alive, and unchanged, for as long as the shared pointer (or any object storing a copy
+ * of it) is used.
+ * \param object Object to which a non-owning shared pointer is to be created.
+ * \return Non-owning shared pointer to object.
+ */
+template< typename DataType >
+boost::shared_ptr< const DataType > createNonOwningSharedPointer( const DataType& object )
+{
+    return boost::shared_ptr< const DataType >( &object, NonOwningDeleter( ) );
+}
+
+//! Vector of immutable data, which can be shared between objects without copying.
+/*!
+ * Vector of immutable data, which can be shared between objects (e.g., interpolators and their
+ * look-up schemes) without copying. Copying a SharedImmutableVector only copies a shared pointer
+ * to the data. Since the data cannot be modified through this class, sharing is transparent to
+ * its users.
+ * \tparam DataType Type of entries of vector.
+ */
+template< typename DataType >
+class SharedImmutableVector
+{
+public:
+
+    //! Typedef for iterator over entries of vector.
+    typedef typename std::vector< DataType >::const_iterator const_iterator;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, creates an empty vector.
+     */
+    SharedImmutableVector( )
+        : data_( boost::make_shared< const std::vector< DataType > >( ) )
+    {
+        setDataPointer( );
+    }
+
+    //! Constructor from vector of data, which is copied.
+    /*!
+     * Constructor from vector of data. The data is copied once, after which it is shared by all
+     * copies of this object.
+     * \param data Vector of data.
+     */
+    SharedImmutableVector( const std::vector< DataType >& data )
+        : data_( boost::make_shared< const std::vector< DataType > >( data ) )
+    {
+        setDataPointer( );
+    }
+
+    //! Constructor from shared pointer to vector of data, which is not copied.
+    /*!
+     * Constructor from shared pointer to vector of data. The data is not copied, but referenced
+     * through the shared pointer. The data may not be modified through any other pointer after
+     * construction. Throws an exception if the pointer is null.
+     * \param data Shared pointer to vector of data.
+     */
+    SharedImmutableVector( const boost::shared_ptr< const std::vector< DataType > >& data )
+        : data_( data )
+    {
+        setDataPointer( );
+    }
+
+    //! Constructor from shared pointer to (non-const) vector of data, which is not copied.
+    /*!
+     * Constructor from shared pointer to (non-const) vector of data. The data is not copied, but
+     * referenced through the shared pointer. The data may not be modified through any other
+     * pointer after construction. Throws an exception if the pointer is null.
+     * \param data Shared pointer to vector of data.
+     */
+    SharedImmutableVector( const boost::shared_ptr< std::vector< DataType > >& data )
+        : data_( data )
+    {
+        setDataPointer( );
+    }
+
+    //! Get entry of vector.
+    /*!
+     * Returns entry of vector, without bounds checking.
+     * \param index Index of entry.
+     * \return Entry of vector at given index.
+     */
+    const DataType& operator[ ]( const int index ) const
+    {
+        return dataPointer_[ index ];
+    }
+
+    //! Get number of entries in vector.
+    /*!
+     * Returns number of entries in vector.
+     * \return Number of entries in vector.
+     */
+    std::size_t size( ) const
+    {
+        return size_;
+    }
+
+    //! Check whether vector is empty.
+    /*!
+     * Checks whether vector is empty.
+     * \return True if vector has no entries.
+     */
+    bool empty( ) const
+    {
+        return size_ == 0;
+    }
+
+    //! Get first entry of vector.
+    /*!
+     * Returns first entry of vector.
+     * \return First entry of vector.
+     */
+    const DataType& front( ) const
+    {
+        return dataPointer_[ 0 ];
+    }
+
+    //! Get last entry of vector.
+    /*!
+     * Returns last entry of vector.
+     * \return Last entry of vector.
+     */
+    const DataType& back( ) const
+    {
+        return dataPointer_[ size_ - 1 ];
+    }
+
+    //! Get iterator to first entry of vector.
+    /*!
+     * Returns iterator to first entry of vector.
+     * \return Iterator to first entry of vector.
+     */
+    const_iterator begin( ) const
+    {
+        return data_->begin( );
+    }
+
+    //! Get iterator past last entry of vector.
+    /*!
+     * Returns iterator past last entry of vector.
+     * \return Iterator past last entry of vector.
+     */
+    const_iterator end( ) const
+    {
+        return data_->end( );
+    }
+
+    //! Get vector of data.
+    /*!
+     * Returns (const reference to) vector of data.
+     * \return Vector of data.
+     */
+    const std::vector< DataType >& getVector( ) const
+    {
+        return *data_;
+    }
+
+    //! Get shared pointer to vector of data.
+    /*!
+     * Returns shared pointer to vector of data, which can be used to construct other objects
+     * sharing the same data.
+     * \return Shared pointer to vector of data.
+     */
+    boost::shared_ptr< const std::vector< DataType > > getSharedPointer( ) const
+    {
+        return data_;
+    }
+
+private:
+
+    //! Set pointer to first entry and number of entries.
+    /*!
+     * Sets pointer to first entry and number of entries, which are cached to avoid an additional
+     * indirection on each access. Throws an exception if the pointer to the data is null.
+     */
+    void setDataPointer( )
+    {
+        if ( !data_ )
+        {
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                    "Error, shared immutable vector cannot be created from null pointer." ) ) );
+        }
+
+        size_ = data_->size( );
+        dataPointer_ = size_ > 0 ? &( *data_ )[ 0 ] : NULL;
+    }
+
+    //! Shared pointer to vector of data.
+    /*!
+     * Shared pointer to vector of data.
+     */
+    boost::shared_ptr< const std::vector< DataType > > data_;
+
+    //! Pointer to first entry of vector of data.
+    /*!
+     * Pointer to first entry of vector of data (NULL if vector is empty).
+     */
+    const DataType* dataPointer_;
+
+    //! Number of entries in vector of data.
+    /*!
+     * Number of entries in vector of data.
+     */
+    std::size_t size_;
+};
+
+} // namespace interpolators
+} // namespace tudat
+
+#endif // TUDAT_SHARED_IMMUTABLE_VECTOR_H
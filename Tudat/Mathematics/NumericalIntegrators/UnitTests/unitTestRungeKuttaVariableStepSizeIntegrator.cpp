@@ -35,6 +35,7 @@
  *                                  typedef; modified minimum step size exceeded unit tests to use
  *                                  custom exception object.
  *      120321    D.Dirkx           Added unit test for getCurrentStateDerivatives function.
+ *      140415    S. Vermeer        Used list type of integrator for retrieved state derivatives.
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
@@ -258,7 +259,8 @@ BOOST_AUTO_TEST_CASE( testStateDerivativeRetrievalFunction )
     const double stepSize = currentTime - previousTime;
 
     // Retrieve state derivative values used in previous time step.
-    std::vector< Eigen::VectorXd > stateDerivatives = integrator.getCurrentStateDerivatives( );
+    const RungeKuttaVariableStepSizeIntegratorXd::StateDerivativesList stateDerivatives
+            = integrator.getCurrentStateDerivatives( );
 
     // Check size of state derivative vector. This test is specifically set up to test the for the 
     // number of stages in the RKF45 integrator.
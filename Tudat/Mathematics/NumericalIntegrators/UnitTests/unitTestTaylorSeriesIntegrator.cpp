@@ -0,0 +1,362 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140224    S. Vermeer        File created.
+ *
+ *    References
+ *      Jorba, A., Zou, M. A software package for the numerical integration of ODEs by means of
+ *          high-order Taylor methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/math/special_functions/factorials.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Basics/testMacros.h>
+#include <TudatCore/Basics/utilityMacros.h>
+#include <TudatCore/Mathematics/BasicMathematics/mathematicalConstants.h>
+
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergy.h"
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+#include "Tudat/Mathematics/NumericalIntegrators/taylorSeriesExpressionGraph.h"
+#include "Tudat/Mathematics/NumericalIntegrators/taylorSeriesIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_taylor_series_integrator )
+
+using basic_mathematics::mathematical_constants::PI;
+
+using numerical_integrators::TaylorSeriesExpressionGraph;
+using numerical_integrators::TaylorSeriesIntegrator;
+using numerical_integrators::TaylorSeriesIntegratorXd;
+using numerical_integrators::TaylorSeriesVariable;
+
+//! Typedef for Taylor series integrator of Cartesian state.
+typedef TaylorSeriesIntegrator< double, basic_mathematics::Vector6d > TaylorSeriesIntegrator6d;
+
+//! Compute state derivative of exponential growth model, with Taylor series variables.
+Eigen::Matrix< TaylorSeriesVariable, Eigen::Dynamic, 1 > computeExponentialGrowthStateDerivative(
+        const TaylorSeriesVariable time,
+        const Eigen::Matrix< TaylorSeriesVariable, Eigen::Dynamic, 1 >& state )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+    return state;
+}
+
+//! Compute state derivative of non-autonomous model x' = x - t^2 + 1, with Taylor series
+//! variables.
+Eigen::Matrix< TaylorSeriesVariable, Eigen::Dynamic, 1 > computeNonAutonomousStateDerivative(
+        const TaylorSeriesVariable time,
+        const Eigen::Matrix< TaylorSeriesVariable, Eigen::Dynamic, 1 >& state )
+{
+    Eigen::Matrix< TaylorSeriesVariable, Eigen::Dynamic, 1 > stateDerivative( 1 );
+    stateDerivative( 0 ) = state( 0 ) - time * time + 1.0;
+    return stateDerivative;
+}
+
+//! Compute state derivative of Keplerian orbit, with Taylor series variables.
+Eigen::Matrix< TaylorSeriesVariable, 6, 1 > computeKeplerOrbitStateDerivative(
+        const double gravitationalParameter,
+        const TaylorSeriesVariable time,
+        const Eigen::Matrix< TaylorSeriesVariable, 6, 1 >& cartesianState )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+
+    Eigen::Matrix< TaylorSeriesVariable, 6, 1 > stateDerivative;
+    stateDerivative.segment( 0, 3 ) = cartesianState.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = gravitation::computeGravitationalAccelerationTemplate(
+                Eigen::Matrix< TaylorSeriesVariable, 3, 1 >( cartesianState.segment( 0, 3 ) ),
+                TaylorSeriesVariable( gravitationalParameter ),
+                Eigen::Matrix< TaylorSeriesVariable, 3, 1 >::Zero( ).eval( ) );
+    return stateDerivative;
+}
+
+//! Compute state derivative of CRTBP, with Taylor series variables.
+Eigen::Matrix< TaylorSeriesVariable, 6, 1 > computeCrtbpStateDerivative(
+        const double massParameter,
+        const TaylorSeriesVariable time,
+        const Eigen::Matrix< TaylorSeriesVariable, 6, 1 >& cartesianState )
+{
+    TUDAT_UNUSED_PARAMETER( time );
+    return gravitation::circular_restricted_three_body_problem::
+            computeCircularRestrictedThreeBodyProblemStateDerivative(
+                massParameter, cartesianState );
+}
+
+//! Test Taylor series coefficients computed by expression graph.
+BOOST_AUTO_TEST_CASE( testTaylorSeriesExpressionGraph )
+{
+    // Set order and expansion point of Taylor series.
+    const int order = 20;
+    const double expansionPoint = 0.7;
+
+    // Record expression graph of y1 = sin( x ), y2 = cos( x ), y3 = x^2.5, y4 = 1 / ( 2 + x ),
+    // y5 = sqrt( x ) * x - 3 * x.
+    TaylorSeriesExpressionGraph expressionGraph;
+    const TaylorSeriesVariable x = expressionGraph.createInputVariable( );
+    const TaylorSeriesVariable y1 = sin( x );
+    const TaylorSeriesVariable y2 = cos( x );
+    const TaylorSeriesVariable y3 = pow( x, 2.5 );
+    const TaylorSeriesVariable y4 = 1.0 / ( 2.0 + x );
+    const TaylorSeriesVariable y5 = sqrt( x ) * x - 3.0 * x;
+
+    // Set Taylor series of x = expansionPoint + t, and compute coefficients.
+    expressionGraph.setMaximumOrder( order );
+    expressionGraph.setCoefficient( x.getNodeIndex( ), 0, expansionPoint );
+    expressionGraph.setCoefficient( x.getNodeIndex( ), 1, 1.0 );
+    for ( int k = 0; k <= order; k++ )
+    {
+        expressionGraph.computeCoefficients( k );
+    }
+
+    // Compare coefficients with analytical derivatives divided by factorial.
+    double powerCoefficient = std::pow( expansionPoint, 2.5 );
+    double reciprocalCoefficient = 1.0 / ( 2.0 + expansionPoint );
+    for ( int k = 0; k <= order; k++ )
+    {
+        const double factorial = boost::math::factorial< double >( k );
+
+        BOOST_CHECK_CLOSE_FRACTION(
+                    expressionGraph.getCoefficient( y1.getNodeIndex( ), k ),
+                    std::sin( expansionPoint + k * PI / 2.0 ) / factorial,
+                    1.0e-13 );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    expressionGraph.getCoefficient( y2.getNodeIndex( ), k ),
+                    std::cos( expansionPoint + k * PI / 2.0 ) / factorial,
+                    1.0e-13 );
+        BOOST_CHECK_CLOSE_FRACTION( expressionGraph.getCoefficient( y3.getNodeIndex( ), k ),
+                                    powerCoefficient, 1.0e-13 );
+        BOOST_CHECK_CLOSE_FRACTION( expressionGraph.getCoefficient( y4.getNodeIndex( ), k ),
+                                    reciprocalCoefficient, 1.0e-13 );
+
+        // Update coefficients of power and reciprocal, using generalized binomial coefficients.
+        powerCoefficient *= ( 2.5 - k ) / ( ( k + 1 ) * expansionPoint );
+        reciprocalCoefficient *= -1.0 / ( 2.0 + expansionPoint );
+    }
+
+    BOOST_CHECK_CLOSE_FRACTION( expressionGraph.getCoefficient( y5.getNodeIndex( ), 0 ),
+                                std::pow( expansionPoint, 1.5 ) - 3.0 * expansionPoint,
+                                1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( expressionGraph.getCoefficient( y5.getNodeIndex( ), 1 ),
+                                1.5 * std::sqrt( expansionPoint ) - 3.0, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( expressionGraph.getCoefficient( y5.getNodeIndex( ), 2 ),
+                                0.375 / std::sqrt( expansionPoint ), 1.0e-15 );
+
+    // Check that operations on constants are evaluated directly.
+    const TaylorSeriesVariable constant = 2.0 * TaylorSeriesVariable( 3.0 ) + 1.0;
+    BOOST_CHECK( constant.isConstant( ) );
+    BOOST_CHECK_EQUAL( constant.getConstantValue( ), 7.0 );
+
+    // Check that nodes cannot be added after coefficients have been allocated.
+    bool isExceptionThrown = false;
+    try
+    {
+        sin( y1 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+//! Test Taylor series integrator on scalar models with analytical solutions.
+BOOST_AUTO_TEST_CASE( testTaylorSeriesIntegratorScalarModels )
+{
+    // Test exponential growth model x' = x, with solution x = exp( t ).
+    {
+        TaylorSeriesIntegratorXd integrator(
+                    &computeExponentialGrowthStateDerivative, 0.0,
+                    Eigen::VectorXd::Constant( 1, 1.0 ), 1.0e-15, 1.0e-15 );
+
+        BOOST_CHECK_EQUAL( integrator.getOrder( ), 19 );
+
+        const Eigen::VectorXd finalState = integrator.integrateTo(
+                    2.0, integrator.getNextStepSize( ) );
+        BOOST_CHECK_CLOSE_FRACTION( finalState( 0 ), std::exp( 2.0 ), 1.0e-14 );
+
+        // Integrate backwards to start of interval.
+        const Eigen::VectorXd initialState = integrator.integrateTo(
+                    0.0, -integrator.getNextStepSize( ) );
+        BOOST_CHECK_CLOSE_FRACTION( initialState( 0 ), 1.0, 1.0e-14 );
+    }
+
+    // Test non-autonomous model x' = x - t^2 + 1, with solution
+    // x = ( t + 1 )^2 - 0.5 exp( t ) (Burden and Faires, 2001).
+    {
+        TaylorSeriesIntegratorXd integrator(
+                    &computeNonAutonomousStateDerivative, 0.0,
+                    Eigen::VectorXd::Constant( 1, 0.5 ), 1.0e-15, 1.0e-15, 25 );
+
+        BOOST_CHECK_EQUAL( integrator.getOrder( ), 25 );
+
+        const Eigen::VectorXd finalState = integrator.integrateTo(
+                    2.0, integrator.getNextStepSize( ) );
+        BOOST_CHECK_CLOSE_FRACTION( finalState( 0 ), 9.0 - 0.5 * std::exp( 2.0 ), 1.0e-14 );
+
+        // Check state derivative function of base class.
+        BOOST_CHECK_CLOSE_FRACTION(
+                    integrator.getTaylorSeriesCoefficients( )( 0, 1 ),
+                    finalState( 0 ) - 3.0, 1.0e-14 );
+    }
+}
+
+//! Test Taylor series integrator on circular Keplerian orbit, including dense output.
+BOOST_AUTO_TEST_CASE( testTaylorSeriesIntegratorKeplerOrbit )
+{
+    // Set initial state of circular orbit with unit radius and gravitational parameter, such that
+    // the position is given by ( cos t, sin t, 0 ).
+    basic_mathematics::Vector6d initialState;
+    initialState << 1.0, 0.0, 0.0, 0.0, 1.0, 0.0;
+
+    TaylorSeriesIntegrator6d integrator(
+                boost::bind( &computeKeplerOrbitStateDerivative, 1.0, _1, _2 ),
+                0.0, initialState, 1.0e-15, 1.0e-15 );
+
+    // Integrate ten orbits, checking dense output in each step.
+    const double finalTime = 20.0 * PI;
+    int numberOfSteps = 0;
+    while ( integrator.getCurrentIndependentVariable( ) < finalTime )
+    {
+        const double stepSize = std::min( integrator.getNextStepSize( ),
+                                          finalTime - integrator.getCurrentIndependentVariable( ) );
+        integrator.performIntegrationStep( stepSize );
+        numberOfSteps++;
+
+        const double denseOutputTime = integrator.getCurrentIndependentVariable( )
+                - 0.37 * stepSize;
+        const basic_mathematics::Vector6d denseOutputState
+                = integrator.getDenseOutput( denseOutputTime );
+
+        BOOST_CHECK_SMALL( denseOutputState( 0 ) - std::cos( denseOutputTime ), 1.0e-13 );
+        BOOST_CHECK_SMALL( denseOutputState( 1 ) - std::sin( denseOutputTime ), 1.0e-13 );
+        BOOST_CHECK_SMALL( denseOutputState( 3 ) + std::sin( denseOutputTime ), 1.0e-13 );
+        BOOST_CHECK_SMALL( denseOutputState( 4 ) - std::cos( denseOutputTime ), 1.0e-13 );
+    }
+
+    // Check final state.
+    const basic_mathematics::Vector6d finalState = integrator.getCurrentState( );
+    BOOST_CHECK_SMALL( finalState( 0 ) - 1.0, 1.0e-13 );
+    BOOST_CHECK_SMALL( finalState( 1 ), 1.0e-13 );
+    BOOST_CHECK_SMALL( finalState( 2 ), std::numeric_limits< double >::min( ) );
+    BOOST_CHECK_SMALL( finalState( 3 ), 1.0e-13 );
+    BOOST_CHECK_SMALL( finalState( 4 ) - 1.0, 1.0e-13 );
+    BOOST_CHECK_SMALL( finalState( 5 ), std::numeric_limits< double >::min( ) );
+
+    // Check that large steps are taken: an 8th-order Runge-Kutta method requires several
+    // hundred steps for ten orbits at this tolerance.
+    BOOST_CHECK_LT( numberOfSteps, 100 );
+
+    // Check that dense output outside last step throws an exception.
+    bool isExceptionThrown = false;
+    try
+    {
+        integrator.getDenseOutput( finalTime + 1.0 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Check rollback to previous state.
+    const double lastTime = integrator.getCurrentIndependentVariable( );
+    integrator.performIntegrationStep( integrator.getNextStepSize( ) );
+    BOOST_CHECK( integrator.rollbackToPreviousState( ) );
+    BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), lastTime );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( integrator.getCurrentState( ), finalState, 1.0e-15 );
+    BOOST_CHECK( !integrator.rollbackToPreviousState( ) );
+
+    // Check modification of current state (impulsive manoeuvre to escape velocity).
+    basic_mathematics::Vector6d modifiedState = finalState;
+    modifiedState( 4 ) = std::sqrt( 2.0 );
+    integrator.modifyCurrentState( modifiedState );
+    BOOST_CHECK_CLOSE_FRACTION( integrator.getTaylorSeriesCoefficients( )( 1, 1 ),
+                                std::sqrt( 2.0 ), 1.0e-15 );
+}
+
+//! Test Taylor series integrator on CRTBP.
+BOOST_AUTO_TEST_CASE( testTaylorSeriesIntegratorCircularRestrictedThreeBodyProblem )
+{
+    using namespace gravitation::circular_restricted_three_body_problem;
+
+    // Set mass parameter of Earth-Moon system and initial state of planar orbit about the Moon.
+    const double massParameter = 0.012150581623434;
+    basic_mathematics::Vector6d initialState;
+    initialState << 1.1, 0.0, 0.0, 0.0, -0.3, 0.05;
+
+    // Check that templated state derivative function agrees with state derivative model.
+    StateDerivativeCircularRestrictedThreeBodyProblem stateDerivativeModel( massParameter );
+    TaylorSeriesIntegrator6d integrator(
+                boost::bind( &computeCrtbpStateDerivative, massParameter, _1, _2 ),
+                0.0, initialState, 1.0e-14, 1.0e-14 );
+
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                stateDerivativeModel.computeStateDerivative( 0.0, initialState ),
+                basic_mathematics::Vector6d( integrator.getTaylorSeriesCoefficients( ).col( 1 ) ),
+                1.0e-15 );
+
+    // Integrate and check conservation of Jacobi energy.
+    const double initialJacobiEnergy = computeJacobiEnergy( massParameter, initialState );
+    const basic_mathematics::Vector6d finalState
+            = integrator.integrateTo( 5.0, integrator.getNextStepSize( ) );
+
+    BOOST_CHECK_CLOSE_FRACTION( integrator.getCurrentIndependentVariable( ), 5.0,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( computeJacobiEnergy( massParameter, finalState ),
+                                initialJacobiEnergy, 1.0e-12 );
+
+    // Integrate back to initial time and check initial state is recovered.
+    const basic_mathematics::Vector6d recoveredInitialState
+            = integrator.integrateTo( 0.0, -integrator.getNextStepSize( ) );
+
+    for ( int i = 0; i < 6; i++ )
+    {
+        BOOST_CHECK_SMALL( recoveredInitialState( i ) - initialState( i ), 1.0e-11 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
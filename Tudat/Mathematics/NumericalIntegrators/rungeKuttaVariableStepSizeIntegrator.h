@@ -44,6 +44,12 @@
  *      120614    A. Ronse          Fixed bug in constructor.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      130307    D. Dirkx          Added function to retrieve integration stage evaluations.
+ *      140228    S. Vermeer        Made integrator safe for fixed-size Eigen states; removed
+ *                                  heap-allocating temporaries from integration step and step
+ *                                  size computation.
+ *      140307    S. Vermeer        Added tracing of integration steps.
+ *      140415    S. Vermeer        Returned current state derivatives as list with aligned
+ *                                  allocator.
  *
  *    References
  *      Burden, R.L., Faires, J.D. Numerical Analysis, 7th Edition, Books/Cole, 2001.
@@ -71,6 +77,7 @@
 #include <TudatCore/Basics/utilityMacros.h>
 #include <TudatCore/Mathematics/NumericalIntegrators/reinitializableNumericalIntegrator.h>
 
+#include "Tudat/Basics/tracing.h"
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
 
 namespace tudat
@@ -96,6 +103,9 @@ class RungeKuttaVariableStepSizeIntegrator :
 {
 public:
 
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
     //! Typedef to the function used to compute the new step size.
     /*!
      * Typedef to the function used to compute the new step size. This should be a pointer to a
@@ -123,6 +133,14 @@ public:
     typedef typename ReinitializableNumericalIntegratorBase::NumericalIntegratorBase::
     StateDerivativeFunction StateDerivativeFunction;
 
+    //! Typedef for list of state derivatives.
+    /*!
+     * Typedef for list of state derivatives, using the aligned allocator of Eigen, such that the
+     * entries are correctly aligned for fixed-size vectorizable state derivative types.
+     */
+    typedef std::vector< StateDerivativeType, Eigen::aligned_allocator< StateDerivativeType > >
+    StateDerivativesList;
+
     //! Exception that is thrown if the minimum step size is exceeded.
     /*!
      * Exception thrown by RungeKuttaVariableStepSizeIntegrator<>::
@@ -279,11 +297,11 @@ public:
     //! Get current state derivatives.
     /*!
      * Returns the current state derivatives, i.e., the values of k_{i} (stage evaluations) in
-     * Runge-Kutta scheme.
+     * Runge-Kutta scheme. The returned list is overwritten by the next integration step.
      * \return Current state derivatives evaluated according to stages of Runge-Kutta scheme.
      */
-    std::vector< StateDerivativeType > getCurrentStateDerivatives( ) 
-    { 
+    const StateDerivativesList& getCurrentStateDerivatives( ) const
+    {
         return currentStateDerivatives_;
     }
 
@@ -465,9 +483,11 @@ protected:
 
     //! Vector of state derivatives.
     /*!
-     * Vector of state derivatives, i.e. values of k_{i} in Runge-Kutta scheme.
+     * Vector of state derivatives, i.e. values of k_{i} in Runge-Kutta scheme. The vector is sized
+     * once to the number of stages and overwritten in each step, so that no memory is allocated
+     * per step for fixed-size state types.
      */
-    std::vector< StateDerivativeType > currentStateDerivatives_;
+    StateDerivativesList currentStateDerivatives_;
 };
 
 //! Perform a single integration step.
@@ -476,9 +496,15 @@ StateType
 RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType >
 ::performIntegrationStep( const IndependentVariableType stepSize )
 {
-    // Define and allocated vector for the number of stages.
-    currentStateDerivatives_.clear( );
-    currentStateDerivatives_.reserve( this->coefficients_.cCoefficients.rows( ) );
+    TUDAT_TRACE_SCOPE( "NumericalIntegrators",
+                       "RungeKuttaVariableStepSizeIntegrator::performIntegrationStep" );
+
+    // Allocate vector for the number of stages (only done for first step).
+    if ( static_cast< int >( currentStateDerivatives_.size( ) )
+         != this->coefficients_.cCoefficients.rows( ) )
+    {
+        currentStateDerivatives_.resize( this->coefficients_.cCoefficients.rows( ) );
+    }
 
     // Define lower and higher order estimates.
     StateType lowerOrderEstimate( this->currentState_ ),
@@ -498,11 +524,10 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
         }
 
         // Compute the state derivative.
-        currentStateDerivatives_.push_back(
-                    this->stateDerivativeFunction_(
-                        this->currentIndependentVariable_ +
-                        this->coefficients_.cCoefficients( stage ) * stepSize,
-                        intermediateState ) );
+        currentStateDerivatives_[ stage ] = this->stateDerivativeFunction_(
+                    this->currentIndependentVariable_ +
+                    this->coefficients_.cCoefficients( stage ) * stepSize,
+                    intermediateState );
 
         // Update the estimate.
         lowerOrderEstimate += this->coefficients_.bCoefficients( 0, stage ) * stepSize *
@@ -516,6 +541,8 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
                                                higherOrderEstimate, stepSize ) )
     {
         // Accept the current step.
+        TUDAT_TRACE_COUNTER( "NumericalIntegrators", "stepSize",
+                             static_cast< double >( stepSize ) );
         this->lastIndependentVariable_ = this->currentIndependentVariable_;
         this->lastState_ = this->currentState_;
         this->currentIndependentVariable_ += stepSize;
@@ -618,25 +645,14 @@ RungeKuttaVariableStepSizeIntegrator< IndependentVariableType, StateType, StateD
 {
     TUDAT_UNUSED_PARAMETER( lowerOrder);
 
-    // Compute the truncation error based on the higher and lower order estimates.
-    const StateType truncationError_ =
-            ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( );
-
-    // Compute error tolerance based on relative and absolute error tolerances.
-    const StateType errorTolerance_ =
-            ( higherOrderEstimate.array( ).abs( ) *
-              relativeErrorTolerance.array( ) ).matrix( )
-            + absoluteErrorTolerance;
-
-    // Compute relative truncation error. This will indicate if the current step satisfies the
-    // required tolerances.
-    const StateType relativeTruncationError_ = truncationError_.array( ) /
-            errorTolerance_.array( );
-
     // Compute the maximum error based on the largest coefficient in the relative truncation error
-    // matrix.
+    // matrix, i.e., the truncation error based on the higher and lower order estimates, divided by
+    // the error tolerance based on relative and absolute error tolerances. This is evaluated as a
+    // single expression, such that no temporary states are allocated.
     const typename StateType::Scalar maximumErrorInState_
-            = relativeTruncationError_.array( ).abs( ).maxCoeff( );
+            = ( ( higherOrderEstimate - lowerOrderEstimate ).array( ).abs( )
+                / ( higherOrderEstimate.array( ).abs( ) * relativeErrorTolerance.array( )
+                    + absoluteErrorTolerance.array( ) ) ).maxCoeff( );
 
     // Compute the new step size. This is based off of the equation given in
     // (Montenbruck and Gill, 2005).
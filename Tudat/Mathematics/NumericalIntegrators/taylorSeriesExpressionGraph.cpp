@@ -0,0 +1,525 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140224    S. Vermeer        File created.
+ *
+ *    References
+ *      Jorba, A., Zou, M. A software package for the numerical integration of ODEs by means of
+ *          high-order Taylor methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Mathematics/NumericalIntegrators/taylorSeriesExpressionGraph.h"
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+namespace
+{
+
+//! Get expression graph in which result of binary operation is to be recorded.
+/*!
+ * Returns the expression graph in which the result of a binary operation is to be recorded. At
+ * least one of the variables must be a node of an expression graph. If both variables are nodes,
+ * they must be part of the same expression graph.
+ * \param firstVariable First operand of binary operation.
+ * \param secondVariable Second operand of binary operation.
+ * \return Expression graph in which result is to be recorded.
+ */
+TaylorSeriesExpressionGraph* getCommonExpressionGraph(
+        const TaylorSeriesVariable& firstVariable, const TaylorSeriesVariable& secondVariable )
+{
+    if ( !firstVariable.isConstant( ) && !secondVariable.isConstant( )
+         && firstVariable.getExpressionGraph( ) != secondVariable.getExpressionGraph( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Taylor series variables belong to different expression graphs." ) ) );
+    }
+
+    return firstVariable.isConstant( ) ? secondVariable.getExpressionGraph( )
+                                       : firstVariable.getExpressionGraph( );
+}
+
+//! Add unary node to expression graph of variable.
+/*!
+ * Adds a node with a single operand to the expression graph of a variable.
+ * \param operation Elementary operation of node.
+ * \param variable Operand of node (must not be a constant).
+ * \param parameter Constant parameter of operation.
+ * \return Variable associated with added node.
+ */
+TaylorSeriesVariable addUnaryNode( const TaylorSeriesExpressionGraph::Operation operation,
+                                   const TaylorSeriesVariable& variable, const double parameter )
+{
+    TaylorSeriesExpressionGraph* expressionGraph = variable.getExpressionGraph( );
+    return TaylorSeriesVariable(
+                expressionGraph, expressionGraph->addNode(
+                    operation, variable.getNodeIndex( ), -1, parameter ) );
+}
+
+//! Add binary node to expression graph of variables.
+/*!
+ * Adds a node with two operands to the expression graph of the variables.
+ * \param operation Elementary operation of node.
+ * \param firstVariable First operand of node.
+ * \param secondVariable Second operand of node.
+ * \return Variable associated with added node.
+ */
+TaylorSeriesVariable addBinaryNode( const TaylorSeriesExpressionGraph::Operation operation,
+                                    const TaylorSeriesVariable& firstVariable,
+                                    const TaylorSeriesVariable& secondVariable )
+{
+    TaylorSeriesExpressionGraph* expressionGraph
+            = getCommonExpressionGraph( firstVariable, secondVariable );
+    return TaylorSeriesVariable(
+                expressionGraph, expressionGraph->addNode(
+                    operation, firstVariable.getNodeIndex( expressionGraph ),
+                    secondVariable.getNodeIndex( expressionGraph ), 0.0 ) );
+}
+
+} // namespace
+
+//! Create input variable.
+TaylorSeriesVariable TaylorSeriesExpressionGraph::createInputVariable( )
+{
+    return TaylorSeriesVariable( this, addNode( inputOperation, -1, -1, 0.0 ) );
+}
+
+//! Add node to graph.
+int TaylorSeriesExpressionGraph::addNode( const Operation operation, const int firstOperand,
+                                          const int secondOperand, const double parameter )
+{
+    // Check that no nodes are added once coefficients have been allocated.
+    if ( maximumOrder_ >= 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Cannot add nodes to expression graph after "
+                                            "setting maximum order." ) ) );
+    }
+
+    Node node;
+    node.operation = operation;
+    node.firstOperand = firstOperand;
+    node.secondOperand = secondOperand;
+    node.parameter = parameter;
+    nodes_.push_back( node );
+
+    return static_cast< int >( nodes_.size( ) ) - 1;
+}
+
+//! Set maximum order of Taylor coefficients.
+void TaylorSeriesExpressionGraph::setMaximumOrder( const int maximumOrder )
+{
+    maximumOrder_ = maximumOrder;
+    coefficients_.assign( nodes_.size( ) * ( maximumOrder_ + 1 ), 0.0 );
+}
+
+//! Compute Taylor coefficients of given order.
+void TaylorSeriesExpressionGraph::computeCoefficients( const int order )
+{
+    for ( unsigned int i = 0; i < nodes_.size( ); i++ )
+    {
+        if ( nodes_[ i ].operation != inputOperation )
+        {
+            setCoefficient( i, order, computeCoefficient( i, order ) );
+        }
+    }
+}
+
+//! Compute Taylor coefficient of given order of a single node.
+double TaylorSeriesExpressionGraph::computeCoefficient( const int nodeIndex,
+                                                        const int order ) const
+{
+    // The recurrence relations used in this function are taken from (Jorba and Zou, 2005), in
+    // which a denotes the first operand, b the second operand and c the result of the operation.
+    const Node& node = nodes_[ nodeIndex ];
+    const int a = node.firstOperand;
+    const int b = node.secondOperand;
+    const double k = static_cast< double >( order );
+
+    double coefficient = 0.0;
+
+    switch ( node.operation )
+    {
+    case inputOperation:
+
+        coefficient = getCoefficient( nodeIndex, order );
+        break;
+
+    case constantOperation:
+
+        coefficient = ( order == 0 ) ? node.parameter : 0.0;
+        break;
+
+    case additionOperation:
+
+        coefficient = getCoefficient( a, order ) + getCoefficient( b, order );
+        break;
+
+    case subtractionOperation:
+
+        coefficient = getCoefficient( a, order ) - getCoefficient( b, order );
+        break;
+
+    case multiplicationOperation:
+
+        // c_k = sum_{j=0}^{k} a_j b_{k-j}.
+        for ( int j = 0; j <= order; j++ )
+        {
+            coefficient += getCoefficient( a, j ) * getCoefficient( b, order - j );
+        }
+        break;
+
+    case divisionOperation:
+
+        // c_k = ( a_k - sum_{j=1}^{k} b_j c_{k-j} ) / b_0.
+        coefficient = getCoefficient( a, order );
+        for ( int j = 1; j <= order; j++ )
+        {
+            coefficient -= getCoefficient( b, j ) * getCoefficient( nodeIndex, order - j );
+        }
+        coefficient /= getCoefficient( b, 0 );
+        break;
+
+    case negationOperation:
+
+        coefficient = -getCoefficient( a, order );
+        break;
+
+    case scalarAdditionOperation:
+
+        coefficient = getCoefficient( a, order ) + ( ( order == 0 ) ? node.parameter : 0.0 );
+        break;
+
+    case scalarMultiplicationOperation:
+
+        coefficient = node.parameter * getCoefficient( a, order );
+        break;
+
+    case scalarDivisionOperation:
+
+        // c_k = ( p delta_{k0} - sum_{j=1}^{k} a_j c_{k-j} ) / a_0, for c = p / a.
+        coefficient = ( order == 0 ) ? node.parameter : 0.0;
+        for ( int j = 1; j <= order; j++ )
+        {
+            coefficient -= getCoefficient( a, j ) * getCoefficient( nodeIndex, order - j );
+        }
+        coefficient /= getCoefficient( a, 0 );
+        break;
+
+    case powerOperation:
+
+        // c_0 = a_0^p, c_k = sum_{j=0}^{k-1} ( p ( k - j ) - j ) a_{k-j} c_j / ( k a_0 ).
+        if ( order == 0 )
+        {
+            coefficient = std::pow( getCoefficient( a, 0 ), node.parameter );
+        }
+        else
+        {
+            for ( int j = 0; j < order; j++ )
+            {
+                coefficient += ( node.parameter * ( k - static_cast< double >( j ) )
+                                 - static_cast< double >( j ) )
+                        * getCoefficient( a, order - j ) * getCoefficient( nodeIndex, j );
+            }
+            coefficient /= k * getCoefficient( a, 0 );
+        }
+        break;
+
+    case sineOperation:
+
+        // s_k = sum_{j=1}^{k} j a_j c_{k-j} / k, where c is the associated cosine.
+        if ( order == 0 )
+        {
+            coefficient = std::sin( getCoefficient( a, 0 ) );
+        }
+        else
+        {
+            for ( int j = 1; j <= order; j++ )
+            {
+                coefficient += static_cast< double >( j ) * getCoefficient( a, j )
+                        * getCoefficient( b, order - j );
+            }
+            coefficient /= k;
+        }
+        break;
+
+    case cosineOperation:
+
+        // c_k = -sum_{j=1}^{k} j a_j s_{k-j} / k, where s is the associated sine.
+        if ( order == 0 )
+        {
+            coefficient = std::cos( getCoefficient( a, 0 ) );
+        }
+        else
+        {
+            for ( int j = 1; j <= order; j++ )
+            {
+                coefficient -= static_cast< double >( j ) * getCoefficient( a, j )
+                        * getCoefficient( b, order - j );
+            }
+            coefficient /= k;
+        }
+        break;
+    }
+
+    return coefficient;
+}
+
+//! Get node index of variable, adding a constant node to the graph if required.
+int TaylorSeriesVariable::getNodeIndex( TaylorSeriesExpressionGraph* expressionGraph ) const
+{
+    if ( isConstant( ) )
+    {
+        return expressionGraph->addNode(
+                    TaylorSeriesExpressionGraph::constantOperation, -1, -1, constantValue_ );
+    }
+
+    return nodeIndex_;
+}
+
+//! Add variable to this variable.
+TaylorSeriesVariable& TaylorSeriesVariable::operator+=( const TaylorSeriesVariable& variable )
+{
+    *this = *this + variable;
+    return *this;
+}
+
+//! Subtract variable from this variable.
+TaylorSeriesVariable& TaylorSeriesVariable::operator-=( const TaylorSeriesVariable& variable )
+{
+    *this = *this - variable;
+    return *this;
+}
+
+//! Multiply this variable by variable.
+TaylorSeriesVariable& TaylorSeriesVariable::operator*=( const TaylorSeriesVariable& variable )
+{
+    *this = *this * variable;
+    return *this;
+}
+
+//! Divide this variable by variable.
+TaylorSeriesVariable& TaylorSeriesVariable::operator/=( const TaylorSeriesVariable& variable )
+{
+    *this = *this / variable;
+    return *this;
+}
+
+//! Add two variables.
+TaylorSeriesVariable operator+( const TaylorSeriesVariable& firstVariable,
+                                const TaylorSeriesVariable& secondVariable )
+{
+    if ( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( )
+                                     + secondVariable.getConstantValue( ) );
+    }
+
+    else if ( firstVariable.isConstant( ) )
+    {
+        return firstVariable.getConstantValue( ) == 0.0
+                ? secondVariable
+                : addUnaryNode( TaylorSeriesExpressionGraph::scalarAdditionOperation,
+                                secondVariable, firstVariable.getConstantValue( ) );
+    }
+
+    else if ( secondVariable.isConstant( ) )
+    {
+        return secondVariable.getConstantValue( ) == 0.0
+                ? firstVariable
+                : addUnaryNode( TaylorSeriesExpressionGraph::scalarAdditionOperation,
+                                firstVariable, secondVariable.getConstantValue( ) );
+    }
+
+    return addBinaryNode( TaylorSeriesExpressionGraph::additionOperation,
+                          firstVariable, secondVariable );
+}
+
+//! Subtract two variables.
+TaylorSeriesVariable operator-( const TaylorSeriesVariable& firstVariable,
+                                const TaylorSeriesVariable& secondVariable )
+{
+    if ( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( )
+                                     - secondVariable.getConstantValue( ) );
+    }
+
+    else if ( firstVariable.isConstant( ) )
+    {
+        return firstVariable + ( -secondVariable );
+    }
+
+    else if ( secondVariable.isConstant( ) )
+    {
+        return firstVariable + TaylorSeriesVariable( -secondVariable.getConstantValue( ) );
+    }
+
+    return addBinaryNode( TaylorSeriesExpressionGraph::subtractionOperation,
+                          firstVariable, secondVariable );
+}
+
+//! Multiply two variables.
+TaylorSeriesVariable operator*( const TaylorSeriesVariable& firstVariable,
+                                const TaylorSeriesVariable& secondVariable )
+{
+    if ( firstVariable.isConstant( ) && secondVariable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( firstVariable.getConstantValue( )
+                                     * secondVariable.getConstantValue( ) );
+    }
+
+    else if ( firstVariable.isConstant( ) )
+    {
+        return firstVariable.getConstantValue( ) == 1.0
+                ? secondVariable
+                : addUnaryNode( TaylorSeriesExpressionGraph::scalarMultiplicationOperation,
+                                secondVariable, firstVariable.getConstantValue( ) );
+    }
+
+    else if ( secondVariable.isConstant( ) )
+    {
+        return secondVariable.getConstantValue( ) == 1.0
+                ? firstVariable
+                : addUnaryNode( TaylorSeriesExpressionGraph::scalarMultiplicationOperation,
+                                firstVariable, secondVariable.getConstantValue( ) );
+    }
+
+    return addBinaryNode( TaylorSeriesExpressionGraph::multiplicationOperation,
+                          firstVariable, secondVariable );
+}
+
+//! Divide two variables.
+TaylorSeriesVariable operator/( const TaylorSeriesVariable& numerator,
+                                const TaylorSeriesVariable& denominator )
+{
+    if ( numerator.isConstant( ) && denominator.isConstant( ) )
+    {
+        return TaylorSeriesVariable( numerator.getConstantValue( )
+                                     / denominator.getConstantValue( ) );
+    }
+
+    else if ( numerator.isConstant( ) )
+    {
+        return addUnaryNode( TaylorSeriesExpressionGraph::scalarDivisionOperation,
+                             denominator, numerator.getConstantValue( ) );
+    }
+
+    else if ( denominator.isConstant( ) )
+    {
+        return numerator * TaylorSeriesVariable( 1.0 / denominator.getConstantValue( ) );
+    }
+
+    return addBinaryNode( TaylorSeriesExpressionGraph::divisionOperation,
+                          numerator, denominator );
+}
+
+//! Negate variable.
+TaylorSeriesVariable operator-( const TaylorSeriesVariable& variable )
+{
+    if ( variable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( -variable.getConstantValue( ) );
+    }
+
+    return addUnaryNode( TaylorSeriesExpressionGraph::negationOperation, variable, 0.0 );
+}
+
+//! Return variable unchanged.
+TaylorSeriesVariable operator+( const TaylorSeriesVariable& variable )
+{
+    return variable;
+}
+
+//! Raise variable to real power.
+TaylorSeriesVariable pow( const TaylorSeriesVariable& base, const double exponent )
+{
+    if ( base.isConstant( ) )
+    {
+        return TaylorSeriesVariable( std::pow( base.getConstantValue( ), exponent ) );
+    }
+
+    else if ( exponent == 1.0 )
+    {
+        return base;
+    }
+
+    return addUnaryNode( TaylorSeriesExpressionGraph::powerOperation, base, exponent );
+}
+
+//! Compute square root of variable.
+TaylorSeriesVariable sqrt( const TaylorSeriesVariable& variable )
+{
+    return pow( variable, 0.5 );
+}
+
+//! Compute sine of variable.
+TaylorSeriesVariable sin( const TaylorSeriesVariable& variable )
+{
+    if ( variable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( std::sin( variable.getConstantValue( ) ) );
+    }
+
+    // Add sine node, which refers to the cosine node that is added directly after it.
+    TaylorSeriesExpressionGraph* expressionGraph = variable.getExpressionGraph( );
+    const int sineNodeIndex = expressionGraph->addNode(
+                TaylorSeriesExpressionGraph::sineOperation, variable.getNodeIndex( ),
+                expressionGraph->getNumberOfNodes( ) + 1, 0.0 );
+    expressionGraph->addNode( TaylorSeriesExpressionGraph::cosineOperation,
+                              variable.getNodeIndex( ), sineNodeIndex, 0.0 );
+
+    return TaylorSeriesVariable( expressionGraph, sineNodeIndex );
+}
+
+//! Compute cosine of variable.
+TaylorSeriesVariable cos( const TaylorSeriesVariable& variable )
+{
+    if ( variable.isConstant( ) )
+    {
+        return TaylorSeriesVariable( std::cos( variable.getConstantValue( ) ) );
+    }
+
+    // Add sine and cosine nodes, and return the latter.
+    const TaylorSeriesVariable sine = sin( variable );
+    return TaylorSeriesVariable( sine.getExpressionGraph( ), sine.getNodeIndex( ) + 1 );
+}
+
+} // namespace numerical_integrators
+} // namespace tudat
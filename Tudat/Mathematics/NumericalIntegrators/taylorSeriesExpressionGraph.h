@@ -0,0 +1,492 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140224    S. Vermeer        File created.
+ *
+ *    References
+ *      Jorba, A., Zou, M. A software package for the numerical integration of ODEs by means of
+ *          high-order Taylor methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *      Griewank, A., Walther, A. Evaluating Derivatives: Principles and Techniques of Algorithmic
+ *          Differentiation, Second Edition, SIAM, 2008.
+ *      Eigen. Using custom scalar types,
+ *          http://eigen.tuxfamily.org/dox/TopicCustomizingEigen.html, last accessed: 24th
+ *          February, 2014.
+ *
+ *    Notes
+ *      The expression graph records a function once, by evaluating it with TaylorSeriesVariable
+ *      scalars, after which the Taylor coefficients of all intermediate quantities can be
+ *      computed order by order, using the recurrence relations of automatic differentiation
+ *      (Jorba and Zou, 2005). Computing coefficient k of a node only requires coefficients 0 up to
+ *      k of its operands, so that all coefficients up to order p of a function of the
+ *      independent variable are obtained at a cost of order p^2 operations per node.
+ *
+ *      Only the operations that are required for the gravitational accelerations and circular
+ *      restricted three-body problem are implemented: addition, subtraction, multiplication,
+ *      division, negation, real powers (including the square root), sine and cosine. Branches
+ *      (e.g., if-statements on the value of a variable) cannot be recorded, since the values of
+ *      the variables are not known when the function is recorded.
+ *
+ */
+
+#ifndef TUDAT_TAYLOR_SERIES_EXPRESSION_GRAPH_H
+#define TUDAT_TAYLOR_SERIES_EXPRESSION_GRAPH_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+class TaylorSeriesVariable;
+
+//! Class that records an expression graph for the computation of Taylor series coefficients.
+/*!
+ * Class that records an expression graph, i.e., a sequence of elementary operations, for which
+ * the Taylor series coefficients of all nodes can subsequently be computed order by order, using
+ * the recurrence relations of automatic differentiation (Jorba and Zou, 2005). The graph is
+ * recorded by evaluating a function with TaylorSeriesVariable scalars, which are created with
+ * the createInputVariable( ) function. The Taylor coefficients of the input variables are set
+ * by the user for each order, after which the coefficients of that order are computed for all
+ * other nodes by the computeCoefficients( ) function.
+ */
+class TaylorSeriesExpressionGraph
+{
+public:
+
+    //! Enum of elementary operations that can be recorded.
+    enum Operation
+    {
+        inputOperation,
+        constantOperation,
+        additionOperation,
+        subtractionOperation,
+        multiplicationOperation,
+        divisionOperation,
+        negationOperation,
+        scalarAdditionOperation,
+        scalarMultiplicationOperation,
+        scalarDivisionOperation,
+        powerOperation,
+        sineOperation,
+        cosineOperation
+    };
+
+    //! Default constructor.
+    /*!
+     * Default constructor, creates an empty expression graph.
+     */
+    TaylorSeriesExpressionGraph( ) : maximumOrder_( -1 ) { }
+
+    //! Create input variable.
+    /*!
+     * Creates a new input node in the graph, and returns the variable associated with it. The
+     * Taylor coefficients of input nodes are not computed by the graph, but have to be set using
+     * the setCoefficient( ) function.
+     * \return Input variable.
+     */
+    TaylorSeriesVariable createInputVariable( );
+
+    //! Add node to graph.
+    /*!
+     * Adds a node to the expression graph, and returns its index. Nodes can only refer to nodes
+     * that have been added before, which ensures that the graph is stored in evaluation order. The
+     * only exception is a sine node, which refers to the associated cosine node that is added
+     * directly after it.
+     * This function is used by the operators that are defined for TaylorSeriesVariable scalars,
+     * and will normally not be called directly.
+     * \param operation Elementary operation of node.
+     * \param firstOperand Index of first operand of node (-1 if not used).
+     * \param secondOperand Index of second operand of node (-1 if not used). For sine and cosine
+     *          nodes, this is the index of the associated cosine and sine node, respectively.
+     * \param parameter Constant parameter of operation (e.g., the exponent of a power operation).
+     * \return Index of added node.
+     */
+    int addNode( const Operation operation, const int firstOperand, const int secondOperand,
+                 const double parameter );
+
+    //! Get number of nodes in the graph.
+    /*!
+     * Returns the number of nodes in the graph.
+     * \return Number of nodes.
+     */
+    int getNumberOfNodes( ) const { return static_cast< int >( nodes_.size( ) ); }
+
+    //! Set maximum order of Taylor coefficients.
+    /*!
+     * Sets the maximum order of the Taylor coefficients that are to be computed, and allocates
+     * the storage of the coefficients. This function has to be called after the graph has been
+     * recorded, and before any coefficients are set or computed.
+     * \param maximumOrder Maximum order of Taylor coefficients.
+     */
+    void setMaximumOrder( const int maximumOrder );
+
+    //! Get maximum order of Taylor coefficients.
+    /*!
+     * Returns the maximum order of the Taylor coefficients that can be computed.
+     * \return Maximum order of Taylor coefficients.
+     */
+    int getMaximumOrder( ) const { return maximumOrder_; }
+
+    //! Set Taylor coefficient of node.
+    /*!
+     * Sets a Taylor coefficient of a node, which is required for the input nodes.
+     * \param nodeIndex Index of node.
+     * \param order Order of Taylor coefficient.
+     * \param coefficient Value of Taylor coefficient.
+     */
+    void setCoefficient( const int nodeIndex, const int order, const double coefficient )
+    {
+        coefficients_[ nodeIndex * ( maximumOrder_ + 1 ) + order ] = coefficient;
+    }
+
+    //! Get Taylor coefficient of node.
+    /*!
+     * Returns a Taylor coefficient of a node.
+     * \param nodeIndex Index of node.
+     * \param order Order of Taylor coefficient.
+     * \return Value of Taylor coefficient.
+     */
+    double getCoefficient( const int nodeIndex, const int order ) const
+    {
+        return coefficients_[ nodeIndex * ( maximumOrder_ + 1 ) + order ];
+    }
+
+    //! Compute Taylor coefficients of given order.
+    /*!
+     * Computes the Taylor coefficients of the given order for all nodes, other than the input
+     * nodes, in the graph. The coefficients of the input nodes up to and including this order,
+     * and the coefficients of all other nodes of lower order, must have been set or computed
+     * before this function is called.
+     * \param order Order of Taylor coefficients that are to be computed.
+     */
+    void computeCoefficients( const int order );
+
+private:
+
+    //! Struct that defines a node of the expression graph.
+    struct Node
+    {
+        //! Elementary operation of node.
+        Operation operation;
+
+        //! Index of first operand.
+        int firstOperand;
+
+        //! Index of second operand.
+        int secondOperand;
+
+        //! Constant parameter of operation.
+        double parameter;
+    };
+
+    //! Compute Taylor coefficient of given order of a single node.
+    /*!
+     * Computes Taylor coefficient of the given order of a single node, using the recurrence
+     * relation associated with its operation (Jorba and Zou, 2005).
+     * \param nodeIndex Index of node.
+     * \param order Order of Taylor coefficient that is to be computed.
+     * \return Taylor coefficient of node.
+     */
+    double computeCoefficient( const int nodeIndex, const int order ) const;
+
+    //! Nodes of expression graph.
+    /*!
+     * Nodes of expression graph, stored in evaluation order.
+     */
+    std::vector< Node > nodes_;
+
+    //! Maximum order of Taylor coefficients.
+    /*!
+     * Maximum order of Taylor coefficients, as set by setMaximumOrder( ).
+     */
+    int maximumOrder_;
+
+    //! Taylor coefficients of all nodes.
+    /*!
+     * Taylor coefficients of all nodes, where all maximumOrder_ + 1 coefficients of a node are
+     * stored contiguously.
+     */
+    std::vector< double > coefficients_;
+};
+
+//! Class for scalars that record operations in an expression graph.
+/*!
+ * Class for scalars that record the operations that they are used in, in an expression graph, so
+ * that the Taylor coefficients of the result can subsequently be computed. A scalar is either a
+ * constant, which is not associated with a graph, or a node of a graph. Operations on constants
+ * only are evaluated directly, so that no nodes are added for them. The class can be used as the
+ * scalar type of Eigen matrices, and as the scalar type of the functions that are templated on
+ * their scalar type (e.g., computeGravitationalAccelerationTemplate( )).
+ */
+class TaylorSeriesVariable
+{
+public:
+
+    //! Constructor for a constant.
+    /*!
+     * Constructor for a constant, which is not associated with an expression graph.
+     * \param constantValue Value of constant (default = 0.0).
+     */
+    TaylorSeriesVariable( const double constantValue = 0.0 )
+        : expressionGraph_( NULL ), nodeIndex_( -1 ), constantValue_( constantValue )
+    { }
+
+    //! Constructor for a node of an expression graph.
+    /*!
+     * Constructor for a variable that is associated with a node of an expression graph.
+     * \param expressionGraph Expression graph of which node is part.
+     * \param nodeIndex Index of node in expression graph.
+     */
+    TaylorSeriesVariable( TaylorSeriesExpressionGraph* expressionGraph, const int nodeIndex )
+        : expressionGraph_( expressionGraph ), nodeIndex_( nodeIndex ), constantValue_( 0.0 )
+    { }
+
+    //! Check whether variable is a constant.
+    /*!
+     * Checks whether variable is a constant, i.e., whether it is not associated with an
+     * expression graph.
+     * \return True if variable is a constant.
+     */
+    bool isConstant( ) const { return expressionGraph_ == NULL; }
+
+    //! Get expression graph of variable.
+    /*!
+     * Returns expression graph of which the node of this variable is part (NULL for constants).
+     * \return Expression graph of variable.
+     */
+    TaylorSeriesExpressionGraph* getExpressionGraph( ) const { return expressionGraph_; }
+
+    //! Get node index of variable.
+    /*!
+     * Returns the index of the node of this variable in its expression graph (-1 for constants).
+     * \return Node index of variable.
+     */
+    int getNodeIndex( ) const { return nodeIndex_; }
+
+    //! Get value of constant.
+    /*!
+     * Returns the value of the variable if it is a constant (zero otherwise).
+     * \return Value of constant.
+     */
+    double getConstantValue( ) const { return constantValue_; }
+
+    //! Get node index of variable, adding a constant node to the graph if required.
+    /*!
+     * Returns the index of the node of this variable in the given expression graph. If the
+     * variable is a constant, a constant node is added to the graph.
+     * \param expressionGraph Expression graph in which node index is requested.
+     * \return Node index of variable.
+     */
+    int getNodeIndex( TaylorSeriesExpressionGraph* expressionGraph ) const;
+
+    //! Add variable to this variable.
+    /*!
+     * Adds a variable to this variable.
+     * \param variable Variable that is to be added.
+     * \return This variable, after addition.
+     */
+    TaylorSeriesVariable& operator+=( const TaylorSeriesVariable& variable );
+
+    //! Subtract variable from this variable.
+    /*!
+     * Subtracts a variable from this variable.
+     * \param variable Variable that is to be subtracted.
+     * \return This variable, after subtraction.
+     */
+    TaylorSeriesVariable& operator-=( const TaylorSeriesVariable& variable );
+
+    //! Multiply this variable by variable.
+    /*!
+     * Multiplies this variable by a variable.
+     * \param variable Variable by which this variable is to be multiplied.
+     * \return This variable, after multiplication.
+     */
+    TaylorSeriesVariable& operator*=( const TaylorSeriesVariable& variable );
+
+    //! Divide this variable by variable.
+    /*!
+     * Divides this variable by a variable.
+     * \param variable Variable by which this variable is to be divided.
+     * \return This variable, after division.
+     */
+    TaylorSeriesVariable& operator/=( const TaylorSeriesVariable& variable );
+
+private:
+
+    //! Expression graph of variable.
+    /*!
+     * Expression graph of which the node of this variable is part (NULL for constants).
+     */
+    TaylorSeriesExpressionGraph* expressionGraph_;
+
+    //! Node index of variable.
+    /*!
+     * Index of the node of this variable in its expression graph (-1 for constants).
+     */
+    int nodeIndex_;
+
+    //! Value of constant.
+    /*!
+     * Value of variable if it is a constant.
+     */
+    double constantValue_;
+};
+
+//! Add two variables.
+/*!
+ * Adds two variables. If both variables are constants, the result is evaluated directly.
+ * Otherwise, a node is added to the expression graph of the variables (which must be the same).
+ * \param firstVariable First variable.
+ * \param secondVariable Second variable.
+ * \return Sum of variables.
+ */
+TaylorSeriesVariable operator+( const TaylorSeriesVariable& firstVariable,
+                                const TaylorSeriesVariable& secondVariable );
+
+//! Subtract two variables.
+/*!
+ * Subtracts two variables. If both variables are constants, the result is evaluated directly.
+ * Otherwise, a node is added to the expression graph of the variables (which must be the same).
+ * \param firstVariable Variable from which second variable is subtracted.
+ * \param secondVariable Variable that is subtracted from first variable.
+ * \return Difference of variables.
+ */
+TaylorSeriesVariable operator-( const TaylorSeriesVariable& firstVariable,
+                                const TaylorSeriesVariable& secondVariable );
+
+//! Multiply two variables.
+/*!
+ * Multiplies two variables. If both variables are constants, the result is evaluated directly.
+ * Otherwise, a node is added to the expression graph of the variables (which must be the same).
+ * \param firstVariable First variable.
+ * \param secondVariable Second variable.
+ * \return Product of variables.
+ */
+TaylorSeriesVariable operator*( const TaylorSeriesVariable& firstVariable,
+                                const TaylorSeriesVariable& secondVariable );
+
+//! Divide two variables.
+/*!
+ * Divides two variables. If both variables are constants, the result is evaluated directly.
+ * Otherwise, a node is added to the expression graph of the variables (which must be the same).
+ * The Taylor coefficients of the result can only be computed if the value of the denominator is
+ * non-zero.
+ * \param numerator Numerator of division.
+ * \param denominator Denominator of division.
+ * \return Quotient of variables.
+ */
+TaylorSeriesVariable operator/( const TaylorSeriesVariable& numerator,
+                                const TaylorSeriesVariable& denominator );
+
+//! Negate variable.
+/*!
+ * Negates variable.
+ * \param variable Variable that is to be negated.
+ * \return Negated variable.
+ */
+TaylorSeriesVariable operator-( const TaylorSeriesVariable& variable );
+
+//! Return variable unchanged.
+/*!
+ * Returns variable unchanged (unary plus).
+ * \param variable Variable.
+ * \return Unchanged variable.
+ */
+TaylorSeriesVariable operator+( const TaylorSeriesVariable& variable );
+
+//! Raise variable to real power.
+/*!
+ * Raises variable to a real power. The Taylor coefficients of the result can only be computed if
+ * the value of the variable (i.e., its zeroth order coefficient) is non-zero.
+ * \param base Variable that is to be raised to a power.
+ * \param exponent Exponent of power.
+ * \return Variable raised to power.
+ */
+TaylorSeriesVariable pow( const TaylorSeriesVariable& base, const double exponent );
+
+//! Compute square root of variable.
+/*!
+ * Computes square root of variable, as the variable raised to the power one half.
+ * \param variable Variable of which square root is to be computed.
+ * \return Square root of variable.
+ */
+TaylorSeriesVariable sqrt( const TaylorSeriesVariable& variable );
+
+//! Compute sine of variable.
+/*!
+ * Computes sine of variable. The Taylor coefficients of the sine and cosine of a variable depend
+ * on each other, so that both a sine and a cosine node are added to the expression graph.
+ * \param variable Variable of which sine is to be computed.
+ * \return Sine of variable.
+ */
+TaylorSeriesVariable sin( const TaylorSeriesVariable& variable );
+
+//! Compute cosine of variable.
+/*!
+ * Computes cosine of variable. The Taylor coefficients of the sine and cosine of a variable
+ * depend on each other, so that both a sine and a cosine node are added to the expression graph.
+ * \param variable Variable of which cosine is to be computed.
+ * \return Cosine of variable.
+ */
+TaylorSeriesVariable cos( const TaylorSeriesVariable& variable );
+
+} // namespace numerical_integrators
+} // namespace tudat
+
+namespace Eigen
+{
+
+//! Numerical traits of TaylorSeriesVariable, required to use it as scalar type of Eigen matrices.
+/*!
+ * Numerical traits of TaylorSeriesVariable, which are required to use it as scalar type of Eigen
+ * matrices (Eigen, 2014). The traits are those of a real, non-integer, scalar.
+ */
+template< >
+struct NumTraits< tudat::numerical_integrators::TaylorSeriesVariable > : NumTraits< double >
+{
+    typedef tudat::numerical_integrators::TaylorSeriesVariable Real;
+    typedef tudat::numerical_integrators::TaylorSeriesVariable NonInteger;
+    typedef tudat::numerical_integrators::TaylorSeriesVariable Nested;
+    typedef tudat::numerical_integrators::TaylorSeriesVariable Literal;
+
+    enum
+    {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = 1,
+        AddCost = 3,
+        MulCost = 3
+    };
+};
+
+} // namespace Eigen
+
+#endif // TUDAT_TAYLOR_SERIES_EXPRESSION_GRAPH_H
@@ -0,0 +1,579 @@
+/*    Copyright (c) 2010-2014, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      140224    S. Vermeer        File created.
+ *      140228    S. Vermeer        Added aligned operator new for fixed-size state types.
+ *      140307    S. Vermeer        Added tracing of integration steps.
+ *      140415    S. Vermeer        Made class noncopyable.
+ *
+ *    References
+ *      Jorba, A., Zou, M. A software package for the numerical integration of ODEs by means of
+ *          high-order Taylor methods, Experimental Mathematics, 14(1), 99-117, 2005.
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2005.
+ *
+ *    Notes
+ *      The Taylor series integrator requires the state derivative function to be written in terms
+ *      of TaylorSeriesVariable scalars, so that it can be recorded as an expression graph. This is
+ *      directly possible for the functions that are templated on their scalar type, such as
+ *      computeGravitationalAccelerationTemplate( ),
+ *      computeGravitationalAccelerationDueToJ2Template( ) and
+ *      computeCircularRestrictedThreeBodyProblemStateDerivative( ). Since the Taylor series
+ *      coefficients are computed at the start of each step, the state at any point within the
+ *      last step is obtained at the cost of a polynomial evaluation (dense output).
+ *
+ */
+
+#ifndef TUDAT_TAYLOR_SERIES_INTEGRATOR_H
+#define TUDAT_TAYLOR_SERIES_INTEGRATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include <TudatCore/Mathematics/NumericalIntegrators/reinitializableNumericalIntegrator.h>
+
+#include "Tudat/Basics/tracing.h"
+#include "Tudat/Mathematics/NumericalIntegrators/taylorSeriesExpressionGraph.h"
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+//! Class that implements the Taylor series integrator.
+/*!
+ * Class that implements a variable step size, variable (user-defined or automatic) order, Taylor
+ * series integrator (Jorba and Zou, 2005). The state derivative function is recorded once as an
+ * expression graph, after which the Taylor series coefficients of the solution are computed at
+ * the start of each step by means of automatic differentiation. The step size is chosen such that
+ * the last two terms of the Taylor series are below the error tolerance, which allows very large
+ * steps for high orders. The state at any point within the last step can be retrieved from the
+ * Taylor series at the start of the step (dense output). The class is noncopyable, since the
+ * state derivative function passed to the base class is bound to the object itself, and the
+ * recorded expression graph is a member of the object.
+ * \tparam IndependentVariableType The type of the independent variable. This type should be
+ *          double.
+ * \tparam StateType The type of the state. This type should be an Eigen::Matrix derived column
+ *          vector type, with double scalars.
+ * \tparam StateDerivativeType The type of the state derivative. This type should be an
+ *          Eigen::Matrix derived column vector type, with double scalars.
+ * \sa NumericalIntegrator.
+ */
+template < typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+           typename StateDerivativeType = StateType >
+class TaylorSeriesIntegrator :
+        public ReinitializableNumericalIntegrator<
+        IndependentVariableType, StateType, StateDerivativeType >, private boost::noncopyable
+{
+public:
+
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Typedef of the base class.
+    /*!
+     * Typedef of the base class with all template parameters filled in.
+     */
+    typedef ReinitializableNumericalIntegrator< IndependentVariableType, StateType,
+    StateDerivativeType > ReinitializableNumericalIntegratorBase;
+
+    //! Typedef for the state, with Taylor series variables as scalars.
+    typedef Eigen::Matrix< TaylorSeriesVariable, StateType::RowsAtCompileTime, 1 >
+    TaylorSeriesStateType;
+
+    //! Typedef for the state derivative function, with Taylor series variables as scalars.
+    /*!
+     * Typedef for the state derivative function, with Taylor series variables as scalars. The
+     * function is evaluated once (by the constructor) to record the expression graph of the
+     * state derivative.
+     */
+    typedef boost::function< TaylorSeriesStateType(
+            const TaylorSeriesVariable, const TaylorSeriesStateType& ) >
+    TaylorSeriesStateDerivativeFunction;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking a state derivative function with Taylor series variables as
+     * scalars, initial conditions, relative & absolute error tolerance and order as argument.
+     * \param taylorSeriesStateDerivativeFunction State derivative function, with Taylor series
+     *          variables as scalars.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state.
+     * \param relativeErrorTolerance The relative error tolerance, w.r.t. the infinity norm of the
+     *          state at the start of a step.
+     * \param absoluteErrorTolerance The absolute error tolerance.
+     * \param order Order of the Taylor series. If a value lower than two is given (default), the
+     *          order is determined from the error tolerances (Jorba and Zou, 2005).
+     * \sa NumericalIntegrator::NumericalIntegrator.
+     */
+    TaylorSeriesIntegrator(
+            const TaylorSeriesStateDerivativeFunction& taylorSeriesStateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const double relativeErrorTolerance,
+            const double absoluteErrorTolerance,
+            const int order = 0 ) :
+        ReinitializableNumericalIntegratorBase(
+            boost::bind( &TaylorSeriesIntegrator::computeStateDerivative, this, _1, _2 ) ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        lastState_( initialState ),
+        relativeErrorTolerance_( std::fabs( relativeErrorTolerance ) ),
+        absoluteErrorTolerance_( std::fabs( absoluteErrorTolerance ) ),
+        order_( order )
+    {
+        // Determine order from error tolerance, if required (Jorba and Zou, 2005).
+        if ( order_ < 2 )
+        {
+            const double errorTolerance = std::max(
+                        std::min( relativeErrorTolerance_, absoluteErrorTolerance_ ),
+                        std::numeric_limits< double >::epsilon( ) );
+            order_ = std::max( static_cast< int >(
+                                   std::ceil( -0.5 * std::log( errorTolerance ) + 1.0 ) ), 2 );
+        }
+
+        // Record expression graph of state derivative.
+        timeNodeIndex_ = expressionGraph_.createInputVariable( ).getNodeIndex( );
+
+        TaylorSeriesStateType taylorSeriesState( initialState.rows( ) );
+        for ( int i = 0; i < initialState.rows( ); i++ )
+        {
+            taylorSeriesState( i ) = expressionGraph_.createInputVariable( );
+            stateNodeIndices_.push_back( taylorSeriesState( i ).getNodeIndex( ) );
+        }
+
+        const TaylorSeriesStateType taylorSeriesStateDerivative
+                = taylorSeriesStateDerivativeFunction(
+                    TaylorSeriesVariable( &expressionGraph_, timeNodeIndex_ ),
+                    taylorSeriesState );
+
+        for ( int i = 0; i < initialState.rows( ); i++ )
+        {
+            stateDerivativeNodeIndices_.push_back(
+                        taylorSeriesStateDerivative( i ).getNodeIndex( &expressionGraph_ ) );
+        }
+
+        // Allocate storage of Taylor series coefficients.
+        expressionGraph_.setMaximumOrder( order_ );
+
+        // Compute Taylor series coefficients at start of integration interval.
+        computeTaylorSeriesCoefficients( );
+        lastTaylorSeriesCoefficients_ = taylorSeriesCoefficients_;
+        nextStepSize_ = recommendedStepSize_;
+    }
+
+    //! Get step size of the next step.
+    /*!
+     * Returns the step size of the next step, for which the error tolerance is met, as computed
+     * from the Taylor series coefficients at the current state. The sign of the step size is equal
+     * to that of the last step (positive before the first step).
+     * \return Step size to be used for the next step.
+     */
+    virtual IndependentVariableType getNextStepSize( ) const { return nextStepSize_; }
+
+    //! Get current state.
+    /*!
+     * Returns the current state of the integrator.
+     * \return Current integrated state.
+     */
+    virtual StateType getCurrentState( ) const { return currentState_; }
+
+    //! Get current independent variable.
+    /*!
+     * Returns the current value of the independent variable of the integrator.
+     * \return Current independent variable.
+     */
+    virtual IndependentVariableType getCurrentIndependentVariable( ) const
+    {
+        return currentIndependentVariable_;
+    }
+
+    //! Get order of Taylor series.
+    /*!
+     * Returns the order of the Taylor series, as set by the user or determined from the error
+     * tolerances.
+     * \return Order of Taylor series.
+     */
+    int getOrder( ) const { return order_; }
+
+    //! Get Taylor series coefficients at current state.
+    /*!
+     * Returns the Taylor series coefficients of the solution at the current independent variable,
+     * where column k contains the k-th derivative of the state divided by k factorial.
+     * \return Taylor series coefficients at current state.
+     */
+    Eigen::MatrixXd getTaylorSeriesCoefficients( ) const { return taylorSeriesCoefficients_; }
+
+    //! Perform a single integration step.
+    /*!
+     * Performs a single integration step, by evaluating the Taylor series at the current state,
+     * and computes the Taylor series coefficients at the new state. The requested step size is
+     * always taken; the step size for which the error tolerance is met is given by
+     * getNextStepSize( ), which should be used as the (initial) step size when calling
+     * integrateTo( ).
+     * \param stepSize The step size to take.
+     * \return The state at the end of the step.
+     */
+    virtual StateType performIntegrationStep( const IndependentVariableType stepSize );
+
+    //! Get state within last step (dense output).
+    /*!
+     * Returns the state at an independent variable within the last step, by evaluating the
+     * Taylor series at the start of the last step.
+     * \param independentVariable Independent variable at which state is requested. This value
+     *          must lie within the last step, otherwise an exception is thrown.
+     * \return State at requested independent variable.
+     */
+    StateType getDenseOutput( const IndependentVariableType independentVariable ) const;
+
+    //! Rollback internal state to the last state.
+    /*!
+     * Performs rollback of the internal state to the last state. This function can only be called
+     * once after calling integrateTo( ) or performIntegrationStep( ) unless specified otherwise by
+     * implementations, and can not be called before any of these functions have been called. Will
+     * return true if the rollback was successful, and false otherwise.
+     * \return True if the rollback was successful.
+     */
+    virtual bool rollbackToPreviousState( )
+    {
+        if ( currentIndependentVariable_ == lastIndependentVariable_ )
+        {
+            return false;
+        }
+
+        currentIndependentVariable_ = lastIndependentVariable_;
+        currentState_ = lastState_;
+        taylorSeriesCoefficients_ = lastTaylorSeriesCoefficients_;
+        computeRecommendedStepSize( );
+        nextStepSize_ = recommendedStepSize_;
+        return true;
+    }
+
+    //! Modify the state at the current interval.
+    /*!
+     * Modify the state at the current interval. This allows for discrete jumps in the state, often
+     * used in simulations of discrete events. The Taylor series coefficients are recomputed for
+     * the modified state. The modified state cannot be rolled back.
+     * \param newState The state to set the current state to.
+     */
+    void modifyCurrentState( const StateType& newState )
+    {
+        currentState_ = newState;
+        lastIndependentVariable_ = currentIndependentVariable_;
+        computeTaylorSeriesCoefficients( );
+        nextStepSize_ = recommendedStepSize_;
+    }
+
+protected:
+
+    //! Compute Taylor series coefficients at current state.
+    /*!
+     * Computes the Taylor series coefficients of the solution at the current state, using the
+     * expression graph of the state derivative, and computes the associated recommended step
+     * size.
+     */
+    void computeTaylorSeriesCoefficients( );
+
+    //! Compute recommended step size.
+    /*!
+     * Computes the recommended step size from the current Taylor series coefficients, such that
+     * the contribution of the last two terms of the series is below the error tolerance. The
+     * step size is scaled by a safety factor exp( -0.7 / ( order - 1 ) ) (Jorba and Zou, 2005).
+     */
+    void computeRecommendedStepSize( );
+
+    //! Compute state derivative.
+    /*!
+     * Computes the state derivative from the recorded expression graph. This function is passed
+     * as state derivative function to the base class.
+     * \param independentVariable Independent variable at which state derivative is evaluated.
+     * \param state State at which state derivative is evaluated.
+     * \return State derivative.
+     */
+    StateDerivativeType computeStateDerivative( const IndependentVariableType independentVariable,
+                                                const StateType& state );
+
+    //! Expression graph of state derivative.
+    /*!
+     * Expression graph of state derivative, as recorded by the constructor.
+     */
+    TaylorSeriesExpressionGraph expressionGraph_;
+
+    //! Index of independent variable node in expression graph.
+    int timeNodeIndex_;
+
+    //! Indices of state nodes in expression graph.
+    std::vector< int > stateNodeIndices_;
+
+    //! Indices of state derivative nodes in expression graph.
+    std::vector< int > stateDerivativeNodeIndices_;
+
+    //! Current independent variable.
+    /*!
+     * Current independent variable as computed by performIntegrationStep().
+     */
+    IndependentVariableType currentIndependentVariable_;
+
+    //! Current state.
+    /*!
+     * Current state as computed by performIntegrationStep( ).
+     */
+    StateType currentState_;
+
+    //! Last independent variable.
+    /*!
+     * Last independent variable value as computed by performIntegrationStep().
+     */
+    IndependentVariableType lastIndependentVariable_;
+
+    //! Last state.
+    /*!
+     * Last state as computed by performIntegrationStep( ).
+     */
+    StateType lastState_;
+
+    //! Taylor series coefficients at current state.
+    /*!
+     * Taylor series coefficients at current state, where column k contains the k-th derivative of
+     * the state divided by k factorial.
+     */
+    Eigen::MatrixXd taylorSeriesCoefficients_;
+
+    //! Taylor series coefficients at last state.
+    /*!
+     * Taylor series coefficients at last state, which are used for dense output.
+     */
+    Eigen::MatrixXd lastTaylorSeriesCoefficients_;
+
+    //! Relative error tolerance.
+    double relativeErrorTolerance_;
+
+    //! Absolute error tolerance.
+    double absoluteErrorTolerance_;
+
+    //! Order of Taylor series.
+    int order_;
+
+    //! Recommended step size magnitude at current state.
+    /*!
+     * Recommended step size magnitude at current state, as computed from the Taylor series
+     * coefficients.
+     */
+    IndependentVariableType recommendedStepSize_;
+
+    //! Step size of next step.
+    /*!
+     * Step size of next step, equal to the recommended step size with the sign of the last step.
+     */
+    IndependentVariableType nextStepSize_;
+};
+
+//! Perform a single integration step.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+StateType TaylorSeriesIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::performIntegrationStep( const IndependentVariableType stepSize )
+{
+    TUDAT_TRACE_SCOPE( "NumericalIntegrators", "TaylorSeriesIntegrator::performIntegrationStep" );
+
+    // Store last state and Taylor series coefficients.
+    lastIndependentVariable_ = currentIndependentVariable_;
+    lastState_ = currentState_;
+    lastTaylorSeriesCoefficients_ = taylorSeriesCoefficients_;
+
+    // Evaluate Taylor series using Horner's scheme.
+    currentState_ = taylorSeriesCoefficients_.col( order_ );
+    for ( int k = order_ - 1; k >= 0; k-- )
+    {
+        currentState_ = currentState_ * stepSize + taylorSeriesCoefficients_.col( k );
+    }
+    currentIndependentVariable_ += stepSize;
+
+    // Compute Taylor series coefficients and recommended step size at new state.
+    computeTaylorSeriesCoefficients( );
+    nextStepSize_ = ( stepSize < 0.0 ) ? -recommendedStepSize_ : recommendedStepSize_;
+
+    return currentState_;
+}
+
+//! Get state within last step (dense output).
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+StateType TaylorSeriesIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::getDenseOutput( const IndependentVariableType independentVariable ) const
+{
+    // Check that requested independent variable lies within last step.
+    if ( ( independentVariable - lastIndependentVariable_ )
+         * ( independentVariable - currentIndependentVariable_ ) > 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Requested independent variable is not within last step." ) ) );
+    }
+
+    // Evaluate Taylor series at start of last step using Horner's scheme.
+    const IndependentVariableType stepSize = independentVariable - lastIndependentVariable_;
+    StateType state = lastTaylorSeriesCoefficients_.col( order_ );
+    for ( int k = order_ - 1; k >= 0; k-- )
+    {
+        state = state * stepSize + lastTaylorSeriesCoefficients_.col( k );
+    }
+
+    return state;
+}
+
+//! Compute Taylor series coefficients at current state.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+void TaylorSeriesIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::computeTaylorSeriesCoefficients( )
+{
+    const int numberOfStates = static_cast< int >( stateNodeIndices_.size( ) );
+
+    // Set zeroth and first order coefficients of independent variable; higher order coefficients
+    // are zero.
+    expressionGraph_.setCoefficient( timeNodeIndex_, 0, currentIndependentVariable_ );
+    expressionGraph_.setCoefficient( timeNodeIndex_, 1, 1.0 );
+
+    // Set zeroth order coefficients of state.
+    for ( int i = 0; i < numberOfStates; i++ )
+    {
+        expressionGraph_.setCoefficient( stateNodeIndices_[ i ], 0, currentState_( i ) );
+    }
+
+    // Compute coefficients order by order: the coefficient of order k + 1 of the state is equal
+    // to the coefficient of order k of the state derivative, divided by k + 1.
+    for ( int k = 0; k < order_; k++ )
+    {
+        expressionGraph_.computeCoefficients( k );
+
+        for ( int i = 0; i < numberOfStates; i++ )
+        {
+            expressionGraph_.setCoefficient(
+                        stateNodeIndices_[ i ], k + 1,
+                        expressionGraph_.getCoefficient( stateDerivativeNodeIndices_[ i ], k )
+                        / static_cast< double >( k + 1 ) );
+        }
+    }
+
+    // Store coefficients of state.
+    taylorSeriesCoefficients_.resize( numberOfStates, order_ + 1 );
+    for ( int i = 0; i < numberOfStates; i++ )
+    {
+        for ( int k = 0; k <= order_; k++ )
+        {
+            taylorSeriesCoefficients_( i, k )
+                    = expressionGraph_.getCoefficient( stateNodeIndices_[ i ], k );
+        }
+    }
+
+    computeRecommendedStepSize( );
+}
+
+//! Compute recommended step size.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+void TaylorSeriesIntegrator< IndependentVariableType, StateType, StateDerivativeType >
+::computeRecommendedStepSize( )
+{
+    // Compute error tolerance, which is relative for large states, and absolute for small states.
+    const double errorTolerance = std::max(
+                absoluteErrorTolerance_, relativeErrorTolerance_
+                * taylorSeriesCoefficients_.col( 0 ).cwiseAbs( ).maxCoeff( ) );
+
+    // Compute step size for which the last two terms are equal to the error tolerance.
+    recommendedStepSize_ = std::numeric_limits< IndependentVariableType >::max( );
+    for ( int k = order_ - 1; k <= order_; k++ )
+    {
+        const double coefficientNorm = taylorSeriesCoefficients_.col( k ).cwiseAbs( ).maxCoeff( );
+        if ( coefficientNorm > 0.0 )
+        {
+            recommendedStepSize_ = std::min(
+                        recommendedStepSize_,
+                        std::pow( errorTolerance / coefficientNorm,
+                                  1.0 / static_cast< double >( k ) ) );
+        }
+    }
+
+    // Apply safety factor (Jorba and Zou, 2005).
+    recommendedStepSize_ *= std::exp( -0.7 / static_cast< double >( order_ - 1 ) );
+}
+
+//! Compute state derivative.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType >
+StateDerivativeType TaylorSeriesIntegrator< IndependentVariableType, StateType,
+StateDerivativeType >::computeStateDerivative( const IndependentVariableType independentVariable,
+                                               const StateType& state )
+{
+    // Evaluate zeroth order coefficients of expression graph.
+    expressionGraph_.setCoefficient( timeNodeIndex_, 0, independentVariable );
+    for ( unsigned int i = 0; i < stateNodeIndices_.size( ); i++ )
+    {
+        expressionGraph_.setCoefficient( stateNodeIndices_[ i ], 0, state( i ) );
+    }
+    expressionGraph_.computeCoefficients( 0 );
+
+    StateDerivativeType stateDerivative( state.rows( ) );
+    for ( unsigned int i = 0; i < stateDerivativeNodeIndices_.size( ); i++ )
+    {
+        stateDerivative( i )
+                = expressionGraph_.getCoefficient( stateDerivativeNodeIndices_[ i ], 0 );
+    }
+
+    // Restore zeroth order coefficients at current state, which are overwritten above.
+    expressionGraph_.setCoefficient( timeNodeIndex_, 0, currentIndependentVariable_ );
+    for ( unsigned int i = 0; i < stateNodeIndices_.size( ); i++ )
+    {
+        expressionGraph_.setCoefficient( stateNodeIndices_[ i ], 0, currentState_( i ) );
+    }
+    expressionGraph_.computeCoefficients( 0 );
+
+    return stateDerivative;
+}
+
+//! Typedef of Taylor series integrator (state/state derivative = VectorXd, independent
+//! variable = double).
+/*!
+ * Typedef of a Taylor series integrator with VectorXds as state and state derivative and double
+ * as independent variable.
+ */
+typedef TaylorSeriesIntegrator< > TaylorSeriesIntegratorXd;
+
+//! Typedef for shared-pointer to TaylorSeriesIntegratorXd object.
+typedef boost::shared_ptr< TaylorSeriesIntegratorXd > TaylorSeriesIntegratorXdPointer;
+
+} // namespace numerical_integrators
+} // namespace tudat
+
+#endif // TUDAT_TAYLOR_SERIES_INTEGRATOR_H